@@ -0,0 +1,60 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Benchmark backend which sends the binary dump produced by the Core straight out, one byte at a time, so that the cost
+   of the Core's walk of the registers and memory regions can be measured on its own. */
+#include <Benchmark.h>
+
+
+const char g_benchmarkBackendName[] = "Core";
+const char g_benchmarkCallName[] = "DumpMemory";
+
+
+size_t Benchmark_GetEncodingCount(void)
+{
+    return 1;
+}
+
+const char* Benchmark_SelectEncoding(size_t encodingIndex)
+{
+    (void)encodingIndex;
+    return "binary";
+}
+
+void Benchmark_Dump(const CrashCatcherExceptionRegisters* pExceptionRegisters)
+{
+    CrashCatcher_Entry(pExceptionRegisters);
+}
+
+
+void CrashCatcher_DumpStart(const CrashCatcherInfo* pInfo)
+{
+    (void)pInfo;
+}
+
+void CrashCatcher_DumpMemory(const void* pvMemory, CrashCatcherElementSizes elementSize, size_t elementCount)
+{
+    const uint8_t* pMemory = (const uint8_t*)pvMemory;
+    size_t         byteCount = elementSize * elementCount;
+
+    g_benchmarkCounts.callCount++;
+    g_benchmarkCounts.byteCount += byteCount;
+    while (byteCount--)
+        g_benchmarkSink = *pMemory++;
+}
+
+CrashCatcherReturnCodes CrashCatcher_DumpEnd(void)
+{
+    return CRASH_CATCHER_EXIT;
+}
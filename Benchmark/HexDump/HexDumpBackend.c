@@ -0,0 +1,60 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Benchmark backend which sends the dump through the HexDump module using the same CrashCatcher_getc() and
+   CrashCatcher_putc() thunks as samples/StdIO, except that the characters go to the benchmark's sink rather than to
+   stdout and the key press which starts the dump is supplied straight away. */
+#include <Benchmark.h>
+
+
+/* HexDump settings which the benchmark changes at runtime. */
+extern CrashCatcherReturnCodes g_crashCatcherDumpEndReturn;
+extern int                     g_crashCatcherHexDumpEncoding;
+
+const char g_benchmarkBackendName[] = "HexDump";
+const char g_benchmarkCallName[] = "putc";
+
+static const char* g_encodingNames[] = { "hex", "Base64", "Z85" };
+
+
+size_t Benchmark_GetEncodingCount(void)
+{
+    return sizeof(g_encodingNames) / sizeof(g_encodingNames[0]);
+}
+
+const char* Benchmark_SelectEncoding(size_t encodingIndex)
+{
+    /* The index matches the CRASH_CATCHER_HEX_DUMP_ENCODING_* values. */
+    g_crashCatcherHexDumpEncoding = (int)encodingIndex;
+    return g_encodingNames[encodingIndex];
+}
+
+void Benchmark_Dump(const CrashCatcherExceptionRegisters* pExceptionRegisters)
+{
+    g_crashCatcherDumpEndReturn = CRASH_CATCHER_EXIT;
+    CrashCatcher_Entry(pExceptionRegisters);
+}
+
+
+int CrashCatcher_getc(void)
+{
+    return '\n';
+}
+
+void CrashCatcher_putc(int c)
+{
+    g_benchmarkCounts.callCount++;
+    g_benchmarkCounts.byteCount++;
+    g_benchmarkSink = (uint8_t)c;
+}
@@ -0,0 +1,79 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Benchmark backend which sends the dump through samples/LocalFileSystem.  The mbed semihosting calls that it makes are
+   stubbed out here so that the bytes go to the benchmark's sink rather than to a file. */
+#include <setjmp.h>
+#include <Benchmark.h>
+
+
+/* Low level declarations for LocalFileSystem taken from mbed headers. */
+typedef int FILEHANDLE;
+
+FILEHANDLE semihost_open(const char* name, int openmode);
+int        semihost_close(FILEHANDLE fh);
+int        semihost_write(FILEHANDLE fh, const unsigned char* buffer, unsigned int length, int mode);
+
+
+const char g_benchmarkBackendName[] = "LocalFileSystem";
+const char g_benchmarkCallName[] = "semihost_write";
+
+/* The sample spins forever once the dump file has been closed so semihost_close() jumps back to Benchmark_Dump(). */
+static jmp_buf g_dumpComplete;
+
+
+size_t Benchmark_GetEncodingCount(void)
+{
+    return 1;
+}
+
+const char* Benchmark_SelectEncoding(size_t encodingIndex)
+{
+    (void)encodingIndex;
+    return "binary";
+}
+
+void Benchmark_Dump(const CrashCatcherExceptionRegisters* pExceptionRegisters)
+{
+    if (setjmp(g_dumpComplete) == 0)
+        CrashCatcher_Entry(pExceptionRegisters);
+}
+
+
+FILEHANDLE semihost_open(const char* name, int openmode)
+{
+    (void)name;
+    (void)openmode;
+    return 1;
+}
+
+int semihost_write(FILEHANDLE fh, const unsigned char* buffer, unsigned int length, int mode)
+{
+    unsigned int i;
+
+    (void)fh;
+    (void)mode;
+    g_benchmarkCounts.callCount++;
+    g_benchmarkCounts.byteCount += length;
+    for (i = 0 ; i < length ; i++)
+        g_benchmarkSink = buffer[i];
+    return 0;
+}
+
+int semihost_close(FILEHANDLE fh)
+{
+    (void)fh;
+    longjmp(g_dumpComplete, 1);
+    return 0;
+}
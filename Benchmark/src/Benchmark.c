@@ -0,0 +1,264 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Host benchmark which times the Core and the dump backend that it is linked against while they dump synthetic memory
+   images of 4KB up to 64MB.  Usage: CrashCatcherBenchmark<Backend> [maxImageSize]
+   For each image it reports the throughput of the host build, the number of calls made to the backend's lowest level
+   output routine per image byte, the peak memory used by the process and how long the dump would take to send over a
+   UART at common baud rates. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <Benchmark.h>
+#ifndef _WIN32
+    #include <sys/resource.h>
+#endif
+
+
+#define MIN_IMAGE_SIZE      (4 * 1024)
+#define MAX_IMAGE_SIZE      (64 * 1024 * 1024)
+/* Each image is this many times larger than the one before it, giving 4KB, 16KB, 64KB and so on up to 64MB. */
+#define IMAGE_SIZE_STEP     4
+/* Images are filled in blocks of this size, each holding zeroes, a repeated word or random bytes. */
+#define FILL_BLOCK_SIZE     256
+/* Dumps of each image are repeated until at least this much CPU time has been used so that small images can be timed
+   with clock(). */
+#define MIN_SECONDS         0.25
+/* A UART using 8N1 framing sends 10 bits for each byte. */
+#define BITS_PER_CHAR       10
+
+#define CPUID_CORTEX_M3     0x412FC230
+#define NOP_INSTRUCTION     0xBF00
+#define LR_MSP_THREAD       0xFFFFFFF9
+
+
+/* The Core gets the upper 32-bits of 64-bit pointers from g_crashCatcherTestBaseAddress so the emulated stack,
+   faulting instruction and memory image are all placed in one block which must not straddle a 4GB boundary. */
+typedef struct
+{
+    uint32_t stack[8];
+    uint16_t instruction[2];
+    uint8_t  image[MAX_IMAGE_SIZE];
+} EmulatedMemory;
+
+
+/* Locations in the Core which the benchmark points at emulated registers or changes at runtime. */
+extern uint64_t              g_crashCatcherTestBaseAddress;
+extern uint32_t*             g_pCrashCatcherCpuId;
+extern FaultStatusRegisters* g_pCrashCatcherFaultStatusRegisters;
+extern uint32_t*             g_pCrashCatcherCoprocessorAccessControlRegister;
+extern int                   g_crashCatcherEnableCompression;
+
+BenchmarkCounts  g_benchmarkCounts;
+volatile uint8_t g_benchmarkSink;
+
+static const uint32_t                 g_baudRates[] = { 115200, 460800, 921600, 3000000 };
+static EmulatedMemory                 g_memory;
+static CrashCatcherExceptionRegisters g_exceptionRegisters;
+static CrashCatcherMemoryRegion       g_regions[2];
+static uint32_t                       g_emulatedCpuId;
+static FaultStatusRegisters           g_emulatedFaultStatusRegisters;
+static uint32_t                       g_emulatedCoprocessorAccessControlRegister;
+
+
+static int  parseMaxImageSize(int argc, char** argv, size_t* pMaxImageSize);
+static int  initEmulatedDevice(void);
+static void fillImage(size_t startOffset, size_t endOffset);
+static void printHeader(void);
+static void runBenchmark(size_t imageSize, int isCompressed, size_t encodingIndex);
+static long peakMemoryKB(void);
+
+
+int main(int argc, char** argv)
+{
+    size_t maxImageSize;
+    size_t filledSize = 0;
+    size_t imageSize;
+    size_t encodingIndex;
+    int    isCompressed;
+
+    if (!parseMaxImageSize(argc, argv, &maxImageSize))
+    {
+        fprintf(stderr, "Usage: %s [maxImageSize]\n"
+                        "  maxImageSize must be between %u and %u bytes.\n",
+                argv[0], MIN_IMAGE_SIZE, MAX_IMAGE_SIZE);
+        return 2;
+    }
+    if (!initEmulatedDevice())
+    {
+        fprintf(stderr, "%s: emulated memory straddles a 4GB boundary.\n", argv[0]);
+        return 1;
+    }
+
+    printHeader();
+    for (imageSize = MIN_IMAGE_SIZE ; imageSize <= maxImageSize ; imageSize *= IMAGE_SIZE_STEP)
+    {
+        fillImage(filledSize, imageSize);
+        filledSize = imageSize;
+        for (isCompressed = 0 ; isCompressed <= 1 ; isCompressed++)
+        {
+            for (encodingIndex = 0 ; encodingIndex < Benchmark_GetEncodingCount() ; encodingIndex++)
+                runBenchmark(imageSize, isCompressed, encodingIndex);
+        }
+    }
+    return 0;
+}
+
+static int parseMaxImageSize(int argc, char** argv, size_t* pMaxImageSize)
+{
+    char*         pEnd;
+    unsigned long maxImageSize;
+
+    *pMaxImageSize = MAX_IMAGE_SIZE;
+    if (argc < 2)
+        return 1;
+    if (argc > 2)
+        return 0;
+    maxImageSize = strtoul(argv[1], &pEnd, 0);
+    if (*pEnd != '\0' || maxImageSize < MIN_IMAGE_SIZE || maxImageSize > MAX_IMAGE_SIZE)
+        return 0;
+    *pMaxImageSize = maxImageSize;
+    return 1;
+}
+
+static int initEmulatedDevice(void)
+{
+    uint64_t startAddress = (uint64_t)(unsigned long)&g_memory;
+    uint64_t endAddress = startAddress + sizeof(g_memory) - 1;
+
+    if (sizeof(uint32_t*) == sizeof(uint64_t))
+    {
+        if ((startAddress >> 32) != (endAddress >> 32))
+            return 0;
+        g_crashCatcherTestBaseAddress = startAddress & 0xFFFFFFFF00000000ULL;
+    }
+
+    /* The crash is a fault in thread mode with only the basic 8 words stacked on the MSP. */
+    g_memory.instruction[0] = NOP_INSTRUCTION;
+    g_memory.stack[6] = (uint32_t)(unsigned long)g_memory.instruction;
+    g_exceptionRegisters.msp = (uint32_t)(unsigned long)g_memory.stack;
+    g_exceptionRegisters.exceptionLR = LR_MSP_THREAD;
+
+    g_emulatedCpuId = CPUID_CORTEX_M3;
+    g_pCrashCatcherCpuId = &g_emulatedCpuId;
+    g_pCrashCatcherFaultStatusRegisters = &g_emulatedFaultStatusRegisters;
+    g_pCrashCatcherCoprocessorAccessControlRegister = &g_emulatedCoprocessorAccessControlRegister;
+
+    g_regions[0].startAddress = (uint32_t)(unsigned long)g_memory.image;
+    g_regions[0].elementSize = CRASH_CATCHER_BYTE;
+    g_regions[1].startAddress = 0xFFFFFFFF;
+    return 1;
+}
+
+static void fillImage(size_t startOffset, size_t endOffset)
+{
+    /* A mix of zeroed blocks like .bss, blocks of a repeated word like freshly painted stacks and blocks of random
+       bytes like live data.  The contents only depend on the offset so that each larger image extends the previous
+       one. */
+    size_t offset;
+
+    for (offset = startOffset ; offset < endOffset ; offset += FILL_BLOCK_SIZE)
+    {
+        uint32_t random = (uint32_t)(offset / FILL_BLOCK_SIZE) * 2654435761U;
+        uint8_t* pBlock = &g_memory.image[offset];
+        size_t   i;
+
+        switch (random >> 30)
+        {
+        case 0:
+            memset(pBlock, 0, FILL_BLOCK_SIZE);
+            break;
+        case 1:
+            for (i = 0 ; i < FILL_BLOCK_SIZE ; i += sizeof(random))
+                memcpy(&pBlock[i], &random, sizeof(random));
+            break;
+        default:
+            for (i = 0 ; i < FILL_BLOCK_SIZE ; i++)
+            {
+                random = random * 1664525 + 1013904223;
+                pBlock[i] = (uint8_t)(random >> 24);
+            }
+            break;
+        }
+    }
+}
+
+static void printHeader(void)
+{
+    size_t i;
+
+    printf("Backend: %s  Calls: %s\n", g_benchmarkBackendName, g_benchmarkCallName);
+    printf("%-8s %-4s %10s %10s %9s %10s %9s", "encoding", "lz4", "image", "sent", "MB/s", "calls/byte", "peak KB");
+    for (i = 0 ; i < sizeof(g_baudRates) / sizeof(g_baudRates[0]) ; i++)
+        printf(" %8luB", (unsigned long)g_baudRates[i]);
+    printf("\n");
+}
+
+static void runBenchmark(size_t imageSize, int isCompressed, size_t encodingIndex)
+{
+    const char*   pEncoding = Benchmark_SelectEncoding(encodingIndex);
+    unsigned long iterations = 0;
+    clock_t       startTime;
+    double        seconds;
+    double        sentBytes;
+    size_t        i;
+
+    g_regions[0].endAddress = g_regions[0].startAddress + imageSize;
+    g_crashCatcherEnableCompression = isCompressed;
+    memset(&g_benchmarkCounts, 0, sizeof(g_benchmarkCounts));
+    startTime = clock();
+    do
+    {
+        Benchmark_Dump(&g_exceptionRegisters);
+        iterations++;
+        seconds = (double)(clock() - startTime) / CLOCKS_PER_SEC;
+    }
+    while (seconds < MIN_SECONDS);
+
+    sentBytes = (double)g_benchmarkCounts.byteCount / iterations;
+    printf("%-8s %-4s %10lu %10.0f %9.1f %10.3g %9ld",
+           pEncoding, isCompressed ? "yes" : "no", (unsigned long)imageSize, sentBytes,
+           (double)imageSize * iterations / seconds / (1024.0 * 1024.0),
+           (double)g_benchmarkCounts.callCount / iterations / imageSize,
+           peakMemoryKB());
+    /* The modelled transfer times are in seconds. */
+    for (i = 0 ; i < sizeof(g_baudRates) / sizeof(g_baudRates[0]) ; i++)
+        printf(" %9.2f", sentBytes * BITS_PER_CHAR / g_baudRates[i]);
+    printf("\n");
+    fflush(stdout);
+}
+
+const CrashCatcherMemoryRegion* CrashCatcher_GetMemoryRegions(void)
+{
+    return g_regions;
+}
+
+static long peakMemoryKB(void)
+{
+#ifdef _WIN32
+    return -1;
+#else
+    struct rusage usage;
+
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return -1;
+    #ifdef __APPLE__
+        /* macOS reports the maximum resident set size in bytes rather than KB. */
+        return usage.ru_maxrss / 1024;
+    #else
+        return usage.ru_maxrss;
+    #endif
+#endif
+}
@@ -0,0 +1,53 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Interface between the host benchmark driver and the dump backend that it has been linked against. */
+#ifndef _BENCHMARK_H_
+#define _BENCHMARK_H_
+
+#include <CrashCatcher.h>
+#include <CrashCatcherPriv.h>
+
+
+/* Counts updated by the backend for every dump. */
+typedef struct
+{
+    /* Number of calls made to the lowest level output routine of the backend (named by g_benchmarkCallName). */
+    uint64_t callCount;
+    /* Number of bytes or characters which would have been sent over the transport. */
+    uint64_t byteCount;
+} BenchmarkCounts;
+
+extern BenchmarkCounts  g_benchmarkCounts;
+
+/* The backends write every byte that they would send to this location, like they would to a UART's data register, so
+   that the compiler can't optimize the output away. */
+extern volatile uint8_t g_benchmarkSink;
+
+/* Name of the backend and of the output routine whose calls are counted in g_benchmarkCounts.callCount. */
+extern const char       g_benchmarkBackendName[];
+extern const char       g_benchmarkCallName[];
+
+
+/* Returns the number of output encodings that the backend supports. */
+size_t      Benchmark_GetEncodingCount(void);
+
+/* Selects the output encoding with the given index for the dumps which follow and returns its name. */
+const char* Benchmark_SelectEncoding(size_t encodingIndex);
+
+/* Sends a single dump of the emulated crash described by pExceptionRegisters through the backend. */
+void        Benchmark_Dump(const CrashCatcherExceptionRegisters* pExceptionRegisters);
+
+
+#endif /* _BENCHMARK_H_ */
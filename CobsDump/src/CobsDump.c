@@ -0,0 +1,214 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Binary alternative to the HexDump module for links which can carry 8-bit data.  The dump is split into fixed size
+   frames, each of which holds a sequence number, the dump bytes and a CRC32.  Each frame is COBS encoded so that it
+   contains no zero bytes and is then followed by a zero byte delimiter.  If bytes are dropped, the host only loses the
+   frames they were in and can resynchronise at the next delimiter. */
+#include <CrashCatcher.h>
+#include <string.h>
+#include "Crc32.h"
+
+
+/* Number of dump bytes to place in each frame.  Every frame except the last one of the dump is exactly this size so
+   that the host can tell where the bytes of a lost frame belong. */
+#if !defined(CRASH_CATCHER_COBS_FRAME_SIZE)
+    #define CRASH_CATCHER_COBS_FRAME_SIZE 128
+#endif
+#if CRASH_CATCHER_COBS_FRAME_SIZE <= 0 || CRASH_CATCHER_COBS_FRAME_SIZE > 1024
+    #error CRASH_CATCHER_COBS_FRAME_SIZE must be between 1 and 1024.
+#endif
+
+/* Each frame starts with a 16-bit little endian header containing a 15-bit sequence number, which restarts at 0 for
+   each dump, and a flag which is set in the last frame of the dump.  It ends with the little endian CRC32 of the header
+   and dump bytes. */
+#define FRAME_HEADER_SIZE   2
+#define FRAME_CRC_SIZE      4
+#define FRAME_SEQUENCE_MASK 0x7FFF
+#define FRAME_FINAL_FLAG    0x8000
+
+/* COBS replaces each run of up to 254 non-zero bytes with a code byte giving the offset of the next zero. */
+#define COBS_MAX_RUN        254
+
+
+CRASH_CATCHER_TEST_WRITEABLE CrashCatcherReturnCodes g_crashCatcherDumpEndReturn = CRASH_CATCHER_TRY_AGAIN;
+static                       CrashCatcherInfo        g_info;
+
+static uint8_t  g_frame[FRAME_HEADER_SIZE + CRASH_CATCHER_COBS_FRAME_SIZE + FRAME_CRC_SIZE];
+static size_t   g_payloadLength;
+static uint16_t g_sequence;
+
+/* Implementations only need to provide this routine if they can send more than one character at a time. */
+void CrashCatcher_write(const char* pBuffer, size_t length) __attribute__((weak));
+
+
+static void printString(const char* pString);
+static void writeBytes(const void* pvBuffer, size_t length);
+static void writeByte(uint8_t byte);
+static void waitForUserInput(void);
+static void appendElement(const uint8_t* pElement, CrashCatcherElementSizes elementSize);
+static void appendBytes(const uint8_t* pBytes, size_t byteCount);
+static void sendFrame(uint16_t flags);
+static void writeCobs(const uint8_t* pData, size_t length);
+
+
+void CrashCatcher_DumpStart(const CrashCatcherInfo* pInfo)
+{
+    g_info = *pInfo;
+
+    printString("\r\n\r\n");
+    if (pInfo->isBKPT)
+        printString("BREAKPOINT");
+    else
+        printString("CRASH");
+    printString(" ENCOUNTERED (COBS)\r\n"
+                "Enable logging and then press any key to start dump.\r\n");
+
+    waitForUserInput();
+    printString("\r\n");
+
+    /* Start with a delimiter so that the host doesn't treat the text above as part of the first frame. */
+    writeByte(0);
+    g_payloadLength = 0;
+    g_sequence = 0;
+}
+
+static void printString(const char* pString)
+{
+    writeBytes(pString, strlen(pString));
+}
+
+static void writeBytes(const void* pvBuffer, size_t length)
+{
+    const char* pBuffer = (const char*)pvBuffer;
+
+    if (CrashCatcher_write)
+    {
+        CrashCatcher_write(pBuffer, length);
+        return;
+    }
+    while (length-- > 0)
+        CrashCatcher_putc((uint8_t)*pBuffer++);
+}
+
+static void writeByte(uint8_t byte)
+{
+    writeBytes(&byte, sizeof(byte));
+}
+
+static void waitForUserInput(void)
+{
+    CrashCatcher_getc();
+}
+
+void CrashCatcher_DumpMemory(const void* pvMemory, CrashCatcherElementSizes elementSize, size_t elementCount)
+{
+    const uint8_t* pMemory = (const uint8_t*)pvMemory;
+
+    if (elementSize == CRASH_CATCHER_BYTE)
+    {
+        appendBytes(pMemory, elementCount);
+        return;
+    }
+    while (elementCount-- > 0)
+    {
+        appendElement(pMemory, elementSize);
+        pMemory += elementSize;
+    }
+}
+
+static void appendElement(const uint8_t* pElement, CrashCatcherElementSizes elementSize)
+{
+    /* Read halfwords and words with a single access of that size since they are likely to be peripheral registers. */
+    if (elementSize == CRASH_CATCHER_HALFWORD)
+    {
+        uint16_t val = *(const uint16_t*)pElement;
+        appendBytes((const uint8_t*)&val, sizeof(val));
+    }
+    else
+    {
+        uint32_t val = *(const uint32_t*)pElement;
+        appendBytes((const uint8_t*)&val, sizeof(val));
+    }
+}
+
+static void appendBytes(const uint8_t* pBytes, size_t byteCount)
+{
+    while (byteCount > 0)
+    {
+        size_t bytesLeft = CRASH_CATCHER_COBS_FRAME_SIZE - g_payloadLength;
+        size_t bytesToCopy = byteCount < bytesLeft ? byteCount : bytesLeft;
+
+        memcpy(&g_frame[FRAME_HEADER_SIZE + g_payloadLength], pBytes, bytesToCopy);
+        g_payloadLength += bytesToCopy;
+        pBytes += bytesToCopy;
+        byteCount -= bytesToCopy;
+        if (g_payloadLength == CRASH_CATCHER_COBS_FRAME_SIZE)
+            sendFrame(0);
+    }
+}
+
+static void sendFrame(uint16_t flags)
+{
+    uint16_t header = (g_sequence & FRAME_SEQUENCE_MASK) | flags;
+    size_t   crcOffset = FRAME_HEADER_SIZE + g_payloadLength;
+    uint32_t crc;
+
+    g_frame[0] = header & 0xFF;
+    g_frame[1] = header >> 8;
+    crc = CrashCatcher_Crc32(0, g_frame, crcOffset);
+    g_frame[crcOffset + 0] = crc & 0xFF;
+    g_frame[crcOffset + 1] = (crc >> 8) & 0xFF;
+    g_frame[crcOffset + 2] = (crc >> 16) & 0xFF;
+    g_frame[crcOffset + 3] = crc >> 24;
+
+    writeCobs(g_frame, crcOffset + FRAME_CRC_SIZE);
+    writeByte(0);
+    g_payloadLength = 0;
+    g_sequence++;
+}
+
+static void writeCobs(const uint8_t* pData, size_t length)
+{
+    const uint8_t* pEnd = pData + length;
+
+    /* The frame is encoded by sending each run of non-zero bytes straight from the frame buffer after its code byte. */
+    for (;;)
+    {
+        const uint8_t* pRun = pData;
+        size_t         runLength;
+
+        while (pData < pEnd && *pData != 0 && pData - pRun < COBS_MAX_RUN)
+            pData++;
+        runLength = pData - pRun;
+        writeByte(runLength + 1);
+        writeBytes(pRun, runLength);
+        if (pData == pEnd)
+            return;
+        /* Skip the zero implied by the code byte.  Maximum length runs don't imply a zero. */
+        if (runLength < COBS_MAX_RUN)
+            pData++;
+    }
+}
+
+
+CrashCatcherReturnCodes CrashCatcher_DumpEnd(void)
+{
+    sendFrame(FRAME_FINAL_FLAG);
+    printString("\r\nEnd of dump\r\n");
+    if (g_crashCatcherDumpEndReturn == CRASH_CATCHER_TRY_AGAIN && (g_info.isBKPT || g_info.isRetained))
+        return CRASH_CATCHER_EXIT;
+    else
+        return g_crashCatcherDumpEndReturn;
+}
@@ -0,0 +1,236 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include <stdint.h>
+#include <string.h>
+
+// Include headers from C modules under test.
+extern "C"
+{
+    #include <CrashCatcher.h>
+    #include <DumpMocks.h>
+    #include <Crc32.h>
+
+    // The unit tests can set this to CRASH_CATCHER_EXIT so that CobsDump's CrashCatcher_DumpEnd() will cause the Core
+    // to exit and not infinite loop.
+    extern CrashCatcherReturnCodes g_crashCatcherDumpEndReturn;
+}
+
+// Include C++ headers for test harness.
+#include <CppUTest/TestHarness.h>
+
+
+#define FRAME_SIZE  128
+#define FINAL_FLAG  0x8000
+
+
+static const char g_crashBanner[] = "\r\n\r\nCRASH ENCOUNTERED (COBS)\r\n"
+                                    "Enable logging and then press any key to start dump.\r\n"
+                                    "\r\n";
+
+
+TEST_GROUP(CobsDump)
+{
+    CrashCatcherInfo m_info;
+    uint8_t          m_memory[300];
+    uint8_t          m_frames[8][FRAME_SIZE + 6];
+    size_t           m_frameSizes[8];
+    size_t           m_frameCount;
+
+    void setup()
+    {
+        static const int keyPress = '\n';
+
+        DumpMocks_Init(1024);
+        DumpMocks_SetGetcData(&keyPress);
+        memset(&m_info, 0, sizeof(m_info));
+        for (size_t i = 0 ; i < sizeof(m_memory) ; i++)
+            m_memory[i] = i;
+        m_frameCount = 0;
+        g_crashCatcherDumpEndReturn = CRASH_CATCHER_EXIT;
+    }
+
+    void teardown()
+    {
+        DumpMocks_Uninit();
+    }
+
+    // Splits the output that followed the banner on its zero delimiters and COBS decodes each frame.
+    void decodeFrames()
+    {
+        const uint8_t* pOutput = (const uint8_t*)DumpMocks_GetPutCData();
+        const uint8_t* pCurr = pOutput + sizeof(g_crashBanner) - 1;
+        const uint8_t* pEnd = pOutput + DumpMocks_GetPutCDataSize();
+
+        CHECK_EQUAL(0, memcmp(g_crashBanner, pOutput, sizeof(g_crashBanner) - 1));
+        CHECK_EQUAL(0, *pCurr++);
+        while (pCurr < pEnd && *pCurr != '\r')
+        {
+            uint8_t* pFrame = m_frames[m_frameCount];
+            size_t   size = 0;
+
+            while (*pCurr != 0)
+            {
+                uint8_t code = *pCurr++;
+
+                memcpy(pFrame + size, pCurr, code - 1);
+                size += code - 1;
+                pCurr += code - 1;
+                if (code != 0xFF && *pCurr != 0)
+                    pFrame[size++] = 0;
+            }
+            pCurr++;
+            m_frameSizes[m_frameCount++] = size;
+        }
+        STRCMP_EQUAL("\r\nEnd of dump\r\n", (const char*)pCurr);
+    }
+
+    void validateFrame(size_t index, uint16_t expectedHeader, const uint8_t* pExpectedPayload, size_t expectedSize)
+    {
+        const uint8_t* pFrame = m_frames[index];
+        size_t         crcOffset = m_frameSizes[index] - 4;
+        uint32_t       crc = pFrame[crcOffset] | (pFrame[crcOffset + 1] << 8) |
+                             (pFrame[crcOffset + 2] << 16) | ((uint32_t)pFrame[crcOffset + 3] << 24);
+
+        CHECK_TRUE(index < m_frameCount);
+        CHECK_EQUAL(expectedSize + 6, m_frameSizes[index]);
+        CHECK_EQUAL(expectedHeader, pFrame[0] | (pFrame[1] << 8));
+        MEMCMP_EQUAL(pExpectedPayload, pFrame + 2, expectedSize);
+        CHECK_EQUAL(CrashCatcher_Crc32(0, pFrame, crcOffset), crc);
+    }
+};
+
+
+TEST(CobsDump, DumpStart_ShouldSendBannerFollowedByDelimiter)
+{
+    CrashCatcher_DumpStart(&m_info);
+    CHECK_EQUAL(sizeof(g_crashBanner), DumpMocks_GetPutCDataSize());
+    CHECK_EQUAL(0, memcmp(g_crashBanner, DumpMocks_GetPutCData(), sizeof(g_crashBanner)));
+}
+
+TEST(CobsDump, DumpStartForBreakpoint_ShouldSendBreakpointBanner)
+{
+    m_info.isBKPT = 1;
+    CrashCatcher_DumpStart(&m_info);
+    STRCMP_EQUAL("\r\n\r\nBREAKPOINT ENCOUNTERED (COBS)\r\n"
+                 "Enable logging and then press any key to start dump.\r\n"
+                 "\r\n", DumpMocks_GetPutCData());
+}
+
+TEST(CobsDump, DumpOneByte_ShouldSendSingleCobsEncodedFinalFrame)
+{
+    static const uint8_t memory[] = { 0x11 };
+    static const uint8_t expectedFrame[] = { 0x01, 0x07, 0x80, 0x11, 0xAB, 0x61, 0x72, 0xAE, 0x00 };
+
+    CrashCatcher_DumpStart(&m_info);
+    CrashCatcher_DumpMemory(memory, CRASH_CATCHER_BYTE, sizeof(memory));
+    CHECK_EQUAL(CRASH_CATCHER_EXIT, CrashCatcher_DumpEnd());
+    CHECK_EQUAL(sizeof(g_crashBanner) + sizeof(expectedFrame) + 15, DumpMocks_GetPutCDataSize());
+    MEMCMP_EQUAL(expectedFrame, DumpMocks_GetPutCData() + sizeof(g_crashBanner), sizeof(expectedFrame));
+}
+
+TEST(CobsDump, DumpNothing_ShouldSendEmptyFinalFrame)
+{
+    CrashCatcher_DumpStart(&m_info);
+    CrashCatcher_DumpEnd();
+    decodeFrames();
+    CHECK_EQUAL(1, m_frameCount);
+    validateFrame(0, FINAL_FLAG | 0, NULL, 0);
+}
+
+TEST(CobsDump, DumpExactlyOneFrame_ShouldSendFullFrameAndEmptyFinalFrame)
+{
+    CrashCatcher_DumpStart(&m_info);
+    CrashCatcher_DumpMemory(m_memory, CRASH_CATCHER_BYTE, FRAME_SIZE);
+    CrashCatcher_DumpEnd();
+    decodeFrames();
+    CHECK_EQUAL(2, m_frameCount);
+    validateFrame(0, 0, m_memory, FRAME_SIZE);
+    validateFrame(1, FINAL_FLAG | 1, NULL, 0);
+}
+
+TEST(CobsDump, DumpMemoryAcrossCalls_ShouldPackFramesFullAndIncrementSequence)
+{
+    CrashCatcher_DumpStart(&m_info);
+    CrashCatcher_DumpMemory(m_memory, CRASH_CATCHER_BYTE, 100);
+    CrashCatcher_DumpMemory(m_memory + 100, CRASH_CATCHER_BYTE, 200);
+    CrashCatcher_DumpEnd();
+    decodeFrames();
+    CHECK_EQUAL(3, m_frameCount);
+    validateFrame(0, 0, m_memory, FRAME_SIZE);
+    validateFrame(1, 1, m_memory + FRAME_SIZE, FRAME_SIZE);
+    validateFrame(2, FINAL_FLAG | 2, m_memory + 2 * FRAME_SIZE, 300 - 2 * FRAME_SIZE);
+}
+
+TEST(CobsDump, DumpHalfwordsAndWords_ShouldSendInMemoryByteOrder)
+{
+    static const uint16_t halfwords[] = { 0x0100, 0x0302 };
+    static const uint32_t words[] = { 0x07060504 };
+
+    CrashCatcher_DumpStart(&m_info);
+    CrashCatcher_DumpMemory(halfwords, CRASH_CATCHER_HALFWORD, 2);
+    CrashCatcher_DumpMemory(words, CRASH_CATCHER_WORD, 1);
+    CrashCatcher_DumpEnd();
+    decodeFrames();
+    CHECK_EQUAL(1, m_frameCount);
+    validateFrame(0, FINAL_FLAG | 0, m_memory, 8);
+}
+
+TEST(CobsDump, DumpStartAgain_ShouldRestartSequenceNumbers)
+{
+    static const int keyPress = '\n';
+
+    CrashCatcher_DumpStart(&m_info);
+    CrashCatcher_DumpMemory(m_memory, CRASH_CATCHER_BYTE, FRAME_SIZE);
+    CrashCatcher_DumpEnd();
+    DumpMocks_Uninit();
+    DumpMocks_Init(1024);
+    DumpMocks_SetGetcData(&keyPress);
+
+    CrashCatcher_DumpStart(&m_info);
+    CrashCatcher_DumpMemory(m_memory, CRASH_CATCHER_BYTE, 1);
+    CrashCatcher_DumpEnd();
+    decodeFrames();
+    CHECK_EQUAL(1, m_frameCount);
+    validateFrame(0, FINAL_FLAG | 0, m_memory, 1);
+}
+
+TEST(CobsDump, DumpEndForBreakpointWithTryAgain_ShouldExit)
+{
+    g_crashCatcherDumpEndReturn = CRASH_CATCHER_TRY_AGAIN;
+    m_info.isBKPT = 1;
+    CrashCatcher_DumpStart(&m_info);
+    CHECK_EQUAL(CRASH_CATCHER_EXIT, CrashCatcher_DumpEnd());
+}
+
+TEST(CobsDump, DumpEndForCrashWithTryAgain_ShouldTryAgain)
+{
+    g_crashCatcherDumpEndReturn = CRASH_CATCHER_TRY_AGAIN;
+    CrashCatcher_DumpStart(&m_info);
+    CHECK_EQUAL(CRASH_CATCHER_TRY_AGAIN, CrashCatcher_DumpEnd());
+}
+
+TEST(CobsDump, DumpWithWriteHook_ShouldSendEachCobsRunWithOneWrite)
+{
+    CrashCatcher_DumpStart(&m_info);
+    uint32_t callCount = DumpMocks_GetWriteCallCount();
+    CrashCatcher_DumpMemory(m_memory + 1, CRASH_CATCHER_BYTE, 2);
+    CrashCatcher_DumpEnd();
+
+    // Frame is 00 80 01 02 CRC[4] so it is sent as 2 runs, each with a code byte write and a data write, followed by the
+    // delimiter and the "End of dump" text.
+    CHECK_EQUAL(callCount + 2 * 2 + 1 + 1, DumpMocks_GetWriteCallCount());
+    decodeFrames();
+    validateFrame(0, FINAL_FLAG | 0, m_memory + 1, 2);
+}
@@ -0,0 +1,150 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include <string.h>
+#include <CrashCatcher.h>
+#include "DmaSim.h"
+
+
+#define MAX_DATA_SIZE       4096
+#define MAX_TRANSFER_SIZE   1024
+
+
+static uint8_t        g_data[MAX_DATA_SIZE];
+static uint8_t        g_inFlight[MAX_TRANSFER_SIZE];
+static const uint8_t* g_pTransferBuffer;
+static const void*    g_pCleanedBuffer;
+static size_t         g_cleanedSize;
+static size_t         g_dataSize;
+static size_t         g_transferSize;
+static size_t         g_largestTransferSize;
+static uint32_t       g_microsecondsPerByte;
+static uint32_t       g_microsecondsPerPoll;
+static uint32_t       g_transferCount;
+static uint32_t       g_errorCount;
+static uint32_t       g_busyPollCount;
+static uint64_t       g_transferMicroseconds;
+static uint64_t       g_elapsedMicroseconds;
+static uint64_t       g_transferEndMicroseconds;
+static int            g_isTransferActive;
+
+
+void DmaSim_Init(uint32_t microsecondsPerByte, uint32_t microsecondsPerPoll)
+{
+    g_pTransferBuffer = NULL;
+    g_pCleanedBuffer = NULL;
+    g_cleanedSize = 0;
+    g_dataSize = 0;
+    g_transferSize = 0;
+    g_largestTransferSize = 0;
+    g_microsecondsPerByte = microsecondsPerByte;
+    g_microsecondsPerPoll = microsecondsPerPoll;
+    g_transferCount = 0;
+    g_errorCount = 0;
+    g_busyPollCount = 0;
+    g_transferMicroseconds = 0;
+    g_elapsedMicroseconds = 0;
+    g_transferEndMicroseconds = 0;
+    g_isTransferActive = 0;
+}
+
+
+const uint8_t* DmaSim_GetData(void)
+{
+    return g_data;
+}
+
+size_t DmaSim_GetDataSize(void)
+{
+    return g_dataSize;
+}
+
+uint32_t DmaSim_GetTransferCount(void)
+{
+    return g_transferCount;
+}
+
+size_t DmaSim_GetLargestTransferSize(void)
+{
+    return g_largestTransferSize;
+}
+
+uint32_t DmaSim_GetErrorCount(void)
+{
+    return g_errorCount;
+}
+
+uint32_t DmaSim_GetBusyPollCount(void)
+{
+    return g_busyPollCount;
+}
+
+uint64_t DmaSim_GetTransferMicroseconds(void)
+{
+    return g_transferMicroseconds;
+}
+
+uint64_t DmaSim_GetElapsedMicroseconds(void)
+{
+    return g_elapsedMicroseconds;
+}
+
+
+/* Simulated implementation of the pipeline's transmit routines. */
+void CrashCatcher_CleanDataCache(const void* pvBuffer, size_t size)
+{
+    g_pCleanedBuffer = pvBuffer;
+    g_cleanedSize = size;
+}
+
+
+void CrashCatcher_StartTransfer(const void* pvBuffer, size_t size)
+{
+    if (g_isTransferActive || size == 0 || size > MAX_TRANSFER_SIZE || g_dataSize + size > MAX_DATA_SIZE ||
+        pvBuffer != g_pCleanedBuffer || size > g_cleanedSize)
+    {
+        g_errorCount++;
+        return;
+    }
+    g_pTransferBuffer = (const uint8_t*)pvBuffer;
+    g_transferSize = size;
+    memcpy(g_inFlight, pvBuffer, size);
+    g_pCleanedBuffer = NULL;
+    g_isTransferActive = 1;
+    g_transferCount++;
+    if (size > g_largestTransferSize)
+        g_largestTransferSize = size;
+    g_transferMicroseconds += (uint64_t)size * g_microsecondsPerByte;
+    g_transferEndMicroseconds = g_elapsedMicroseconds + (uint64_t)size * g_microsecondsPerByte;
+}
+
+
+int CrashCatcher_IsTransferComplete(void)
+{
+    g_elapsedMicroseconds += g_microsecondsPerPoll;
+    if (!g_isTransferActive)
+        return 1;
+    if (g_elapsedMicroseconds < g_transferEndMicroseconds)
+    {
+        g_busyPollCount++;
+        return 0;
+    }
+    /* The DMA engine reads the buffer for the whole transfer so the Core mustn't have touched it. */
+    if (memcmp(g_inFlight, g_pTransferBuffer, g_transferSize) != 0)
+        g_errorCount++;
+    memcpy(&g_data[g_dataSize], g_inFlight, g_transferSize);
+    g_dataSize += g_transferSize;
+    g_isTransferActive = 0;
+    return 1;
+}
@@ -0,0 +1,41 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Host simulation of a DMA driven transmitter which provides the CrashCatcher_StartTransfer(),
+   CrashCatcher_IsTransferComplete() and CrashCatcher_CleanDataCache() routines used by the Core's transmit pipeline.
+   Time only moves forward when the Core polls for completion.  The Core polls once for each part of the dump, so each
+   poll stands in for the work the Core does between them, and then keeps polling while it waits for a free buffer.  A
+   transfer completes once enough time has passed for all of its bytes to have been sent.  The sim checks that only one
+   transfer is in flight, that its buffer isn't changed until it completes and that it was cleaned from the data cache
+   first. */
+#ifndef _DMA_SIM_H_
+#define _DMA_SIM_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+void DmaSim_Init(uint32_t microsecondsPerByte, uint32_t microsecondsPerPoll);
+
+const uint8_t* DmaSim_GetData(void);
+size_t         DmaSim_GetDataSize(void);
+uint32_t       DmaSim_GetTransferCount(void);
+size_t         DmaSim_GetLargestTransferSize(void);
+uint32_t       DmaSim_GetErrorCount(void);
+uint32_t       DmaSim_GetBusyPollCount(void);
+uint64_t       DmaSim_GetTransferMicroseconds(void);
+uint64_t       DmaSim_GetElapsedMicroseconds(void);
+
+
+#endif /* _DMA_SIM_H_ */
@@ -14,6 +14,7 @@
 */
 #include <assert.h>
 #include <CrashCatcherPriv.h>
+#include <Crc32.h>
 #include <DumpMocks.h>
 #include <string.h>
 
@@ -26,17 +27,36 @@ typedef struct DumpMemoryItem
 } DumpMemoryItem;
 
 
-static uint32_t                        g_dumpStartCallCount;
-static CrashCatcherInfo                g_dumpInfo;
-static int                             g_dumpStartSimulateStackOverflow;
-static uint32_t                        g_dumpEndCallCount;
-static uint32_t                        g_dumpLoopCount;
-static uint32_t                        g_dumpMemoryItemCount;
-static DumpMemoryItem*                 g_pDumpMemoryItems;
-static const CrashCatcherMemoryRegion* g_pRegions;
+static uint32_t                            g_dumpStartCallCount;
+static CrashCatcherInfo                    g_dumpInfo;
+static int                                 g_dumpStartSimulateStackOverflow;
+static uint32_t                            g_dumpEndCallCount;
+static uint32_t                            g_dumpLoopCount;
+static uint32_t                            g_dumpMemoryItemCount;
+static DumpMemoryItem*                     g_pDumpMemoryItems;
+static const CrashCatcherMemoryRegion*     g_pRegions;
+static uint32_t                            g_threadStackTop;
+static uint32_t                            g_threadStackTopSP;
+static const CrashCatcherMemoryRegionInfo* g_pFreeSpans;
+static const CrashCatcherLoadImageRegion*  g_pLoadImageRegions;
+static uint32_t                            g_hardwareCrc32CallCount;
+static uint32_t*                           g_pHardwareCrc32ChangingWord;
+static uint32_t                            g_dumpMemoryVectorCallCount;
+static size_t                              g_lastDumpMemoryVectorCount;
+static void*                               g_pRetainedBuffer;
+static size_t                              g_retainedBufferSize;
+static uint32_t*                           g_pCycleCounter;
+static uint32_t                            g_dumpStartCycles;
+static uint32_t                            g_cyclesPerByte;
+static uint32_t                            g_dumpEndCycles;
+static uint32_t                            g_dumpStartStackBytes;
+static uint32_t                            g_threadStackTopStackBytes;
+static uint32_t                            g_dumpEndStackBytes;
 
 
 static void freeMemoryItems(void);
+static void advanceCycleCounter(uint32_t cycles);
+static void useStack(uint32_t byteCount);
 
 
 void DumpMocks_Init(void)
@@ -48,7 +68,24 @@ void DumpMocks_Init(void)
     g_dumpMemoryItemCount = 0;
     g_pDumpMemoryItems = NULL;
     g_pRegions = NULL;
+    g_threadStackTop = 0;
+    g_threadStackTopSP = 0;
+    g_pFreeSpans = NULL;
+    g_pLoadImageRegions = NULL;
+    g_hardwareCrc32CallCount = 0;
+    g_pHardwareCrc32ChangingWord = NULL;
+    g_dumpMemoryVectorCallCount = 0;
+    g_lastDumpMemoryVectorCount = 0;
+    g_pRetainedBuffer = NULL;
+    g_retainedBufferSize = 0;
     g_dumpLoopCount = 0;
+    g_pCycleCounter = NULL;
+    g_dumpStartCycles = 0;
+    g_cyclesPerByte = 0;
+    g_dumpEndCycles = 0;
+    g_dumpStartStackBytes = 0;
+    g_threadStackTopStackBytes = 0;
+    g_dumpEndStackBytes = 0;
 }
 
 
@@ -101,6 +138,95 @@ void DumpMocks_SetMemoryRegions(const CrashCatcherMemoryRegion* pRegions)
 }
 
 
+void DumpMocks_SetThreadStackTop(uint32_t threadStackTop)
+{
+    g_threadStackTop = threadStackTop;
+}
+
+uint32_t DumpMocks_GetThreadStackTopSP(void)
+{
+    return g_threadStackTopSP;
+}
+
+
+void DumpMocks_SetFreeHeapSpans(const CrashCatcherMemoryRegionInfo* pFreeSpans)
+{
+    g_pFreeSpans = pFreeSpans;
+}
+
+
+void DumpMocks_SetLoadImageRegions(const CrashCatcherLoadImageRegion* pLoadImageRegions)
+{
+    g_pLoadImageRegions = pLoadImageRegions;
+}
+
+
+uint32_t DumpMocks_GetHardwareCrc32CallCount(void)
+{
+    return g_hardwareCrc32CallCount;
+}
+
+
+void DumpMocks_SetHardwareCrc32ChangingWord(uint32_t* pWord)
+{
+    g_pHardwareCrc32ChangingWord = pWord;
+}
+
+
+uint32_t DumpMocks_GetDumpMemoryVectorCallCount(void)
+{
+    return g_dumpMemoryVectorCallCount;
+}
+
+size_t DumpMocks_GetLastDumpMemoryVectorCount(void)
+{
+    return g_lastDumpMemoryVectorCount;
+}
+
+
+void DumpMocks_SetRetainedBuffer(void* pBuffer, size_t size)
+{
+    g_pRetainedBuffer = pBuffer;
+    g_retainedBufferSize = size;
+}
+
+
+void DumpMocks_SetCycleCounter(uint32_t* pCycleCounter, uint32_t dumpStartCycles, uint32_t cyclesPerByte,
+                               uint32_t dumpEndCycles)
+{
+    g_pCycleCounter = pCycleCounter;
+    g_dumpStartCycles = dumpStartCycles;
+    g_cyclesPerByte = cyclesPerByte;
+    g_dumpEndCycles = dumpEndCycles;
+}
+
+static void advanceCycleCounter(uint32_t cycles)
+{
+    if (g_pCycleCounter)
+        *g_pCycleCounter += cycles;
+}
+
+
+void DumpMocks_SetStackUsage(uint32_t dumpStartBytes, uint32_t dumpEndBytes)
+{
+    g_dumpStartStackBytes = dumpStartBytes;
+    g_dumpEndStackBytes = dumpEndBytes;
+}
+
+void DumpMocks_SetThreadStackTopStackUsage(uint32_t byteCount)
+{
+    g_threadStackTopStackBytes = byteCount;
+}
+
+static void useStack(uint32_t byteCount)
+{
+    size_t wordCount = byteCount / sizeof(uint32_t);
+
+    assert( wordCount <= CRASH_CATCHER_STACK_WORD_COUNT );
+    memset(&g_crashCatcherStack[CRASH_CATCHER_STACK_WORD_COUNT - wordCount], 0, wordCount * sizeof(uint32_t));
+}
+
+
 uint32_t DumpMocks_GetDumpMemoryCallCount(void)
 {
     return g_dumpMemoryItemCount;
@@ -122,11 +248,30 @@ int DumpMocks_VerifyDumpMemoryItem(uint32_t item, const void* pvMemory, CrashCat
     return 1;
 }
 
+size_t DumpMocks_CopyDumpedBytes(uint32_t firstItem, uint8_t* pBuffer, size_t bufferSize)
+{
+    size_t   totalSize = 0;
+    uint32_t i;
+
+    for (i = firstItem ; i < g_dumpMemoryItemCount ; i++)
+    {
+        DumpMemoryItem* pItem = &g_pDumpMemoryItems[i];
+        size_t          itemSize = (size_t)pItem->elementSize * pItem->elementCount;
+
+        assert( totalSize + itemSize <= bufferSize );
+        memcpy(pBuffer + totalSize, pItem->pvMemory, itemSize);
+        totalSize += itemSize;
+    }
+    return totalSize;
+}
+
 
 /* Mock implementation of CrashCatcher_Dump* routines. */
 void CrashCatcher_DumpStart(const CrashCatcherInfo* pInfo)
 {
     g_dumpStartCallCount++;
+    advanceCycleCounter(g_dumpStartCycles);
+    useStack(g_dumpStartStackBytes);
     if (g_dumpStartSimulateStackOverflow)
         g_crashCatcherStack[0] = 0;
     memcpy(&g_dumpInfo, pInfo, sizeof(g_dumpInfo));
@@ -139,6 +284,50 @@ const CrashCatcherMemoryRegion* CrashCatcher_GetMemoryRegions(void)
 }
 
 
+uint32_t CrashCatcher_GetThreadStackTop(uint32_t sp)
+{
+    g_threadStackTopSP = sp;
+    useStack(g_threadStackTopStackBytes);
+    return g_threadStackTop;
+}
+
+
+int CrashCatcher_GetNextFreeHeapSpan(uint32_t startAddress, uint32_t endAddress, CrashCatcherMemoryRegionInfo* pFreeSpan)
+{
+    const CrashCatcherMemoryRegionInfo* pCurr = g_pFreeSpans;
+
+    /* Spans are returned as is, without clipping, so that tests can check how the core handles bad spans. */
+    while (pCurr && pCurr->startAddress != 0xFFFFFFFF)
+    {
+        if (pCurr->startAddress >= startAddress && pCurr->startAddress < endAddress)
+        {
+            *pFreeSpan = *pCurr;
+            return 1;
+        }
+        pCurr++;
+    }
+    return 0;
+}
+
+
+const CrashCatcherLoadImageRegion* CrashCatcher_GetLoadImageRegions(void)
+{
+    return g_pLoadImageRegions;
+}
+
+
+uint32_t CrashCatcher_HardwareCrc32(uint32_t crc, const void* pvData, size_t size)
+{
+    /* Emulate the CRC peripheral with the software version since they must calculate the same value anyway. */
+    uint32_t result = CrashCatcher_Crc32(crc, pvData, size);
+
+    g_hardwareCrc32CallCount++;
+    if (g_pHardwareCrc32ChangingWord)
+        (*g_pHardwareCrc32ChangingWord)++;
+    return result;
+}
+
+
 void CrashCatcher_DumpMemory(const void* pvMemory, CrashCatcherElementSizes elementSize, size_t elementCount)
 {
     g_pDumpMemoryItems = realloc(g_pDumpMemoryItems, sizeof(*g_pDumpMemoryItems) * (g_dumpMemoryItemCount + 1));
@@ -149,12 +338,34 @@ void CrashCatcher_DumpMemory(const void* pvMemory, CrashCatcherElementSizes elem
     g_pDumpMemoryItems[g_dumpMemoryItemCount].elementSize = elementSize;
     g_pDumpMemoryItems[g_dumpMemoryItemCount].elementCount = elementCount;
     g_dumpMemoryItemCount++;
+    advanceCycleCounter(g_cyclesPerByte * (uint32_t)(elementSize * elementCount));
+}
+
+
+void CrashCatcher_DumpMemoryVector(const CrashCatcherMemoryVector* pVectors, size_t vectorCount)
+{
+    size_t i;
+
+    /* Record each vector as its own item so that tests can validate them the same way as CrashCatcher_DumpMemory(). */
+    g_dumpMemoryVectorCallCount++;
+    g_lastDumpMemoryVectorCount = vectorCount;
+    for (i = 0 ; i < vectorCount ; i++)
+        CrashCatcher_DumpMemory(pVectors[i].pvMemory, pVectors[i].elementSize, pVectors[i].elementCount);
+}
+
+
+void* CrashCatcher_GetRetainedBuffer(size_t* pSize)
+{
+    *pSize = g_retainedBufferSize;
+    return g_pRetainedBuffer;
 }
 
 
 CrashCatcherReturnCodes CrashCatcher_DumpEnd(void)
 {
     g_dumpEndCallCount++;
+    advanceCycleCounter(g_dumpEndCycles);
+    useStack(g_dumpEndStackBytes);
     if (g_dumpLoopCount)
     {
         g_dumpLoopCount--;
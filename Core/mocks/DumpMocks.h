@@ -30,12 +30,34 @@ uint32_t DumpMocks_GetDumpEndCallCount(void);
 void     DumpMocks_SetDumpEndLoops(uint32_t timesToReturnTryAgain);
 
 void     DumpMocks_SetMemoryRegions(const CrashCatcherMemoryRegion* pRegions);
+void     DumpMocks_SetThreadStackTop(uint32_t threadStackTop);
+uint32_t DumpMocks_GetThreadStackTopSP(void);
+void     DumpMocks_SetFreeHeapSpans(const CrashCatcherMemoryRegionInfo* pFreeSpans);
+void     DumpMocks_SetLoadImageRegions(const CrashCatcherLoadImageRegion* pLoadImageRegions);
+uint32_t DumpMocks_GetHardwareCrc32CallCount(void);
+/* Increments *pWord after each CrashCatcher_HardwareCrc32() call, like a peripheral register which keeps changing
+   while the dump is being sent. */
+void     DumpMocks_SetHardwareCrc32ChangingWord(uint32_t* pWord);
+uint32_t DumpMocks_GetDumpMemoryVectorCallCount(void);
+size_t   DumpMocks_GetLastDumpMemoryVectorCount(void);
+void     DumpMocks_SetRetainedBuffer(void* pBuffer, size_t size);
+/* Advances *pCycleCounter as if CrashCatcher_DumpStart(), CrashCatcher_DumpMemory() and CrashCatcher_DumpEnd() had
+   taken the given number of cycles. */
+void     DumpMocks_SetCycleCounter(uint32_t* pCycleCounter, uint32_t dumpStartCycles, uint32_t cyclesPerByte,
+                                   uint32_t dumpEndCycles);
+/* Clears the top bytes of g_crashCatcherStack in CrashCatcher_DumpStart() and CrashCatcher_DumpEnd() as if they had
+   used that much of the stack. */
+void     DumpMocks_SetStackUsage(uint32_t dumpStartBytes, uint32_t dumpEndBytes);
+/* Same as DumpMocks_SetStackUsage() but for CrashCatcher_GetThreadStackTop(), which is called from the deepest frame of
+   the backtrace scan while CrashCatcher_Entry() is still initializing. */
+void     DumpMocks_SetThreadStackTopStackUsage(uint32_t byteCount);
 
 uint32_t DumpMocks_GetDumpMemoryCallCount(void);
 int      DumpMocks_VerifyDumpMemoryItem(uint32_t item,
                                         const void* pvMemory,
                                         CrashCatcherElementSizes elementSize,
                                         size_t elementCount);
+size_t   DumpMocks_CopyDumpedBytes(uint32_t firstItem, uint8_t* pBuffer, size_t bufferSize);
 
 
 #endif /* _DUMP_MOCKS_H_ */
@@ -0,0 +1,224 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Small LZ4 block compressor.  Each block is compressed without referencing any earlier block so that host tools can
+   decompress the blocks of a large dump in parallel with any standard LZ4 block decoder. */
+#include <string.h>
+#include "Compress.h"
+
+
+#if CRASH_CATCHER_COMPRESSION_BLOCK_SIZE > 65535
+    #error CRASH_CATCHER_COMPRESSION_BLOCK_SIZE must fit in the 16-bit size fields of the block header.
+#endif
+
+/* Constants from the LZ4 block format specification. */
+#define MIN_MATCH       4
+#define LAST_LITERALS   5
+#define MF_LIMIT        12
+#define MAX_OFFSET      65535
+#define RUN_MASK        15
+
+/* The hash table is indexed by the hash of the next 4 bytes and records the last offset at which they were seen. */
+#define HASH_BITS       7
+#define HASH_ENTRIES    (1 << HASH_BITS)
+
+
+static uint8_t  g_inputBlock[CRASH_CATCHER_COMPRESSION_BLOCK_SIZE];
+static uint8_t  g_outputBlock[CRASH_CATCHER_COMPRESS_BLOCK_HEADER_SIZE +
+                              CRASH_CATCHER_COMPRESS_BOUND(CRASH_CATCHER_COMPRESSION_BLOCK_SIZE)];
+static uint16_t g_hashTable[HASH_ENTRIES];
+static size_t   g_inputSize;
+
+
+static void     appendToInputBlock(const void* pvData, size_t size);
+static void     flushInputBlock(void);
+static void     writeUInt16(uint8_t* pDest, uint32_t value);
+static uint32_t readUInt32(const uint8_t* pSrc);
+static uint32_t hash(uint32_t value);
+static size_t   countMatchingBytes(const uint8_t* p1, const uint8_t* p2, const uint8_t* pLimit);
+static uint8_t* writeSequence(uint8_t* pOut, const uint8_t* pLiterals, size_t literalCount, size_t offset, size_t matchLength);
+static uint8_t* writeLength(uint8_t* pOut, size_t length);
+
+
+void CrashCatcher_CompressStart(void)
+{
+    g_inputSize = 0;
+}
+
+void CrashCatcher_CompressMemory(const void* pvMemory, CrashCatcherElementSizes elementSize, size_t elementCount)
+{
+    size_t i;
+
+    switch (elementSize)
+    {
+    case CRASH_CATCHER_BYTE:
+        appendToInputBlock(pvMemory, elementCount);
+        break;
+    case CRASH_CATCHER_HALFWORD:
+        for (i = 0 ; i < elementCount ; i++)
+        {
+            uint16_t val = ((const uint16_t*)pvMemory)[i];
+            appendToInputBlock(&val, sizeof(val));
+        }
+        break;
+    case CRASH_CATCHER_WORD:
+        for (i = 0 ; i < elementCount ; i++)
+        {
+            uint32_t val = ((const uint32_t*)pvMemory)[i];
+            appendToInputBlock(&val, sizeof(val));
+        }
+        break;
+    }
+}
+
+static void appendToInputBlock(const void* pvData, size_t size)
+{
+    const uint8_t* pData = (const uint8_t*)pvData;
+
+    while (size > 0)
+    {
+        size_t bytesLeft = sizeof(g_inputBlock) - g_inputSize;
+        size_t bytesToCopy = size < bytesLeft ? size : bytesLeft;
+
+        memcpy(&g_inputBlock[g_inputSize], pData, bytesToCopy);
+        g_inputSize += bytesToCopy;
+        pData += bytesToCopy;
+        size -= bytesToCopy;
+        if (g_inputSize == sizeof(g_inputBlock))
+            flushInputBlock();
+    }
+}
+
+static void flushInputBlock(void)
+{
+    size_t compressedSize;
+
+    if (g_inputSize == 0)
+        return;
+    compressedSize = CrashCatcher_CompressBlock(g_inputBlock, g_inputSize,
+                                                &g_outputBlock[CRASH_CATCHER_COMPRESS_BLOCK_HEADER_SIZE]);
+    writeUInt16(&g_outputBlock[0], compressedSize);
+    writeUInt16(&g_outputBlock[2], g_inputSize);
+    CrashCatcher_WriteMemory(g_outputBlock, CRASH_CATCHER_BYTE, CRASH_CATCHER_COMPRESS_BLOCK_HEADER_SIZE + compressedSize);
+    g_inputSize = 0;
+}
+
+static void writeUInt16(uint8_t* pDest, uint32_t value)
+{
+    pDest[0] = value & 0xFF;
+    pDest[1] = (value >> 8) & 0xFF;
+}
+
+void CrashCatcher_CompressEnd(void)
+{
+    flushInputBlock();
+}
+
+
+size_t CrashCatcher_CompressBlock(const uint8_t* pInput, size_t inputSize, uint8_t* pOutput)
+{
+    const uint8_t* pCurr = pInput;
+    const uint8_t* pAnchor = pInput;
+    const uint8_t* pEnd = pInput + inputSize;
+    uint8_t*       pOut = pOutput;
+
+    /* The LZ4 specification requires that blocks shorter than MF_LIMIT + 1 bytes be sent as literals only. */
+    if (inputSize > MF_LIMIT)
+    {
+        /* Matches can't start in the last MF_LIMIT bytes or extend into the last LAST_LITERALS bytes. */
+        const uint8_t* pMatchLimit = pEnd - LAST_LITERALS;
+        const uint8_t* pLastMatchStart = pEnd - MF_LIMIT;
+
+        memset(g_hashTable, 0, sizeof(g_hashTable));
+        while (pCurr <= pLastMatchStart)
+        {
+            uint32_t       value = readUInt32(pCurr);
+            uint32_t       index = hash(value);
+            const uint8_t* pCandidate = pInput + g_hashTable[index];
+
+            g_hashTable[index] = pCurr - pInput;
+            if (pCandidate < pCurr && (size_t)(pCurr - pCandidate) <= MAX_OFFSET && readUInt32(pCandidate) == value)
+            {
+                size_t matchLength = MIN_MATCH + countMatchingBytes(pCandidate + MIN_MATCH, pCurr + MIN_MATCH, pMatchLimit);
+
+                pOut = writeSequence(pOut, pAnchor, pCurr - pAnchor, pCurr - pCandidate, matchLength);
+                pCurr += matchLength;
+                pAnchor = pCurr;
+            }
+            else
+            {
+                pCurr++;
+            }
+        }
+    }
+
+    /* The last sequence only contains literals. */
+    return writeSequence(pOut, pAnchor, pEnd - pAnchor, 0, 0) - pOutput;
+}
+
+static uint32_t readUInt32(const uint8_t* pSrc)
+{
+    /* Read a byte at a time since ARMv6-M devices don't support unaligned accesses. */
+    return (uint32_t)pSrc[0] | ((uint32_t)pSrc[1] << 8) | ((uint32_t)pSrc[2] << 16) | ((uint32_t)pSrc[3] << 24);
+}
+
+static uint32_t hash(uint32_t value)
+{
+    return (value * 2654435761U) >> (32 - HASH_BITS);
+}
+
+static size_t countMatchingBytes(const uint8_t* p1, const uint8_t* p2, const uint8_t* pLimit)
+{
+    const uint8_t* pStart = p2;
+
+    while (p2 < pLimit && *p1 == *p2)
+    {
+        p1++;
+        p2++;
+    }
+    return p2 - pStart;
+}
+
+static uint8_t* writeSequence(uint8_t* pOut, const uint8_t* pLiterals, size_t literalCount, size_t offset, size_t matchLength)
+{
+    size_t   extraMatchLength = matchLength ? matchLength - MIN_MATCH : 0;
+    uint8_t* pToken = pOut++;
+
+    *pToken = (uint8_t)((literalCount < RUN_MASK ? literalCount : RUN_MASK) << 4);
+    if (literalCount >= RUN_MASK)
+        pOut = writeLength(pOut, literalCount - RUN_MASK);
+    memcpy(pOut, pLiterals, literalCount);
+    pOut += literalCount;
+
+    if (matchLength == 0)
+        return pOut;
+    writeUInt16(pOut, offset);
+    pOut += 2;
+    *pToken |= (uint8_t)(extraMatchLength < RUN_MASK ? extraMatchLength : RUN_MASK);
+    if (extraMatchLength >= RUN_MASK)
+        pOut = writeLength(pOut, extraMatchLength - RUN_MASK);
+
+    return pOut;
+}
+
+static uint8_t* writeLength(uint8_t* pOut, size_t length)
+{
+    while (length >= 255)
+    {
+        *pOut++ = 255;
+        length -= 255;
+    }
+    *pOut++ = (uint8_t)length;
+    return pOut;
+}
@@ -0,0 +1,46 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Private header for the block compressor used by the Core when CRASH_CATCHER_FLAGS_COMPRESSED is set. */
+#ifndef _CRASH_CATCHER_COMPRESS_H_
+#define _CRASH_CATCHER_COMPRESS_H_
+
+#include <CrashCatcher.h>
+#include <stdint.h>
+#include "CrashCatcherPriv.h"
+
+
+/* Worst case size of a LZ4 block generated from inputSize bytes of incompressible data. */
+#define CRASH_CATCHER_COMPRESS_BOUND(inputSize) ((inputSize) + (inputSize) / 255 + 16)
+
+/* Size of the header which precedes each compressed block in the dump. */
+#define CRASH_CATCHER_COMPRESS_BLOCK_HEADER_SIZE 4
+
+
+/* Called once the uncompressed header and flags have been dumped to reset the compressor's state. */
+void   CrashCatcher_CompressStart(void);
+
+/* Called instead of CrashCatcher_DumpMemory() for everything after the flags word.  The data is buffered up until a
+   whole block has been collected and then that block is compressed and sent to CrashCatcher_WriteMemory(). */
+void   CrashCatcher_CompressMemory(const void* pvMemory, CrashCatcherElementSizes elementSize, size_t elementCount);
+
+/* Called at the end of the dump to compress and send any partially filled block. */
+void   CrashCatcher_CompressEnd(void);
+
+/* Compresses inputSize bytes from pInput into a LZ4 block at pOutput and returns the number of bytes written.  pOutput
+   must be large enough to hold CRASH_CATCHER_COMPRESS_BOUND(inputSize) bytes. */
+size_t CrashCatcher_CompressBlock(const uint8_t* pInput, size_t inputSize, uint8_t* pOutput);
+
+
+#endif /* _CRASH_CATCHER_COMPRESS_H_ */
@@ -14,6 +14,10 @@
 */
 #include <CrashCatcher.h>
 #include "CrashCatcherPriv.h"
+#include "Compress.h"
+#include "Crc32.h"
+#include "Pipeline.h"
+#include "Retained.h"
 #include <string.h>
 
 
@@ -29,12 +33,139 @@ CRASH_CATCHER_TEST_WRITEABLE FaultStatusRegisters* g_pCrashCatcherFaultStatusReg
 /* The unit tests can point the core to a fake location for the Coprocessor Access Control Register. */
 CRASH_CATCHER_TEST_WRITEABLE uint32_t* g_pCrashCatcherCoprocessorAccessControlRegister = (uint32_t*)0xE000ED88;
 
+#ifndef CRASH_CATCHER_MAIN_STACK_TOP_SYMBOL
+/* The unit tests can point the core to a fake location for the Vector Table Offset Register. */
+CRASH_CATCHER_TEST_WRITEABLE uint32_t* g_pCrashCatcherVectorTableOffsetRegister = (uint32_t*)0xE000ED08;
+#endif
+
+/* The unit tests can disable the features which CRASH_CATCHER_MIN_FOOTPRINT compiles out at runtime. */
+CRASH_CATCHER_TEST_WRITEABLE int g_crashCatcherEnableIsBKPT = CRASH_CATCHER_ISBKPT_SUPPORT;
+CRASH_CATCHER_TEST_WRITEABLE int g_crashCatcherEnableFloatingPoint = CRASH_CATCHER_FLOATING_POINT_SUPPORT;
+CRASH_CATCHER_TEST_WRITEABLE int g_crashCatcherEnableFaultStatus = CRASH_CATCHER_FAULT_STATUS_SUPPORT;
+CRASH_CATCHER_TEST_WRITEABLE int g_crashCatcherEnableFaultCause = CRASH_CATCHER_FAULT_CAUSE_SUPPORT;
+CRASH_CATCHER_TEST_WRITEABLE int g_crashCatcherEnableStackSentinel = CRASH_CATCHER_STACK_SENTINEL_SUPPORT;
+
+/* The unit tests can enable compression of the dump at runtime. */
+CRASH_CATCHER_TEST_WRITEABLE int g_crashCatcherEnableCompression = CRASH_CATCHER_COMPRESSION_SUPPORT;
+
+/* The unit tests can enable elision of repeated word runs in memory regions at runtime. */
+CRASH_CATCHER_TEST_WRITEABLE int g_crashCatcherEnableRunElision = CRASH_CATCHER_RUN_ELISION_SUPPORT;
+
+/* The unit tests can enable skipping of free heap memory at runtime. */
+CRASH_CATCHER_TEST_WRITEABLE int g_crashCatcherEnableHeapWalk = CRASH_CATCHER_HEAP_WALK_SUPPORT;
+
+/* The unit tests can enable skipping of unchanged load image blocks at runtime. */
+CRASH_CATCHER_TEST_WRITEABLE int g_crashCatcherEnableLoadImage = CRASH_CATCHER_LOAD_IMAGE_SUPPORT;
+
+/* The unit tests can enable minidumps at runtime. */
+CRASH_CATCHER_TEST_WRITEABLE int g_crashCatcherEnableMinidump = CRASH_CATCHER_MINIDUMP_SUPPORT;
+
+/* The unit tests can enable the CRC32 trailer at runtime. */
+CRASH_CATCHER_TEST_WRITEABLE int g_crashCatcherEnableCrc32 = CRASH_CATCHER_CRC32_SUPPORT;
+
+/* The unit tests can enable vectored dumping of the registers at runtime. */
+CRASH_CATCHER_TEST_WRITEABLE int g_crashCatcherEnableVectoredDump = CRASH_CATCHER_VECTORED_DUMP_SUPPORT;
+
+/* The unit tests can enable the backtrace record at runtime. */
+CRASH_CATCHER_TEST_WRITEABLE int g_crashCatcherEnableBacktrace = CRASH_CATCHER_BACKTRACE_SUPPORT;
+
+#if defined(CRASH_CATCHER_CODE_START_SYMBOL) && defined(CRASH_CATCHER_CODE_END_SYMBOL)
+/* Linker symbols located at the start and end of the code. */
+extern uint32_t CRASH_CATCHER_CODE_START_SYMBOL;
+extern uint32_t CRASH_CATCHER_CODE_END_SYMBOL;
+#else
+/* The unit tests can change the range of addresses which the backtrace scan treats as code. */
+CRASH_CATCHER_TEST_WRITEABLE uint32_t g_crashCatcherCodeStart = CRASH_CATCHER_BACKTRACE_CODE_START;
+CRASH_CATCHER_TEST_WRITEABLE uint32_t g_crashCatcherCodeEnd = CRASH_CATCHER_BACKTRACE_CODE_END;
+#endif
+
+/* The unit tests can enable the two tier layout and shrink the amount of stack sent in tier 1 at runtime. */
+CRASH_CATCHER_TEST_WRITEABLE int g_crashCatcherEnableTwoTier = CRASH_CATCHER_TWO_TIER_SUPPORT;
+CRASH_CATCHER_TEST_WRITEABLE uint32_t g_crashCatcherTier1StackSize = CRASH_CATCHER_TIER1_STACK_SIZE;
+
+/* The unit tests can enable capturing of the dump into the retained buffer at runtime. */
+CRASH_CATCHER_TEST_WRITEABLE int g_crashCatcherEnableRetained = CRASH_CATCHER_RETAINED_SUPPORT;
+
+/* The unit tests can point the core to a fake location for the Application Interrupt and Reset Control Register and
+   stop it from waiting for the reset to happen. */
+CRASH_CATCHER_TEST_WRITEABLE uint32_t* g_pCrashCatcherApplicationInterruptResetControlRegister = (uint32_t*)0xE000ED0C;
+CRASH_CATCHER_TEST_WRITEABLE int g_crashCatcherWaitForReset = 1;
+
+/* The unit tests can enable the staged transmit pipeline at runtime. */
+CRASH_CATCHER_TEST_WRITEABLE int g_crashCatcherEnablePipeline = CRASH_CATCHER_PIPELINE_SUPPORT;
+
+/* The unit tests can enable the timing record at runtime. */
+CRASH_CATCHER_TEST_WRITEABLE int g_crashCatcherEnableTiming = CRASH_CATCHER_TIMING_SUPPORT;
+
+/* The unit tests can point the core to fake locations for the Debug Exception and Monitor Control Register and the
+   DWT_CTRL and DWT_CYCCNT registers. */
+CRASH_CATCHER_TEST_WRITEABLE uint32_t* g_pCrashCatcherDebugExceptionMonitorControlRegister = (uint32_t*)0xE000EDFC;
+CRASH_CATCHER_TEST_WRITEABLE uint32_t* g_pCrashCatcherDwtControlRegister = (uint32_t*)0xE0001000;
+CRASH_CATCHER_TEST_WRITEABLE uint32_t* g_pCrashCatcherCycleCounter = (uint32_t*)0xE0001004;
+
+/* The unit tests can enable the stack usage record at runtime. */
+CRASH_CATCHER_TEST_WRITEABLE int g_crashCatcherEnableStackUsage = CRASH_CATCHER_STACK_USAGE_SUPPORT;
+
+#ifdef CRASH_CATCHER_MAIN_STACK_TOP_SYMBOL
+/* Linker symbol located at the top of the main stack. */
+extern uint32_t CRASH_CATCHER_MAIN_STACK_TOP_SYMBOL;
+#endif
+
+/* Implementations only need to provide this routine if they want minidumps to include all of a thread's stack. */
+uint32_t CrashCatcher_GetThreadStackTop(uint32_t sp) __attribute__((weak));
+
+/* Implementations only need to provide this routine if they want free heap memory to be skipped. */
+int CrashCatcher_GetNextFreeHeapSpan(uint32_t startAddress, uint32_t endAddress, CrashCatcherMemoryRegionInfo* pFreeSpan)
+    __attribute__((weak));
+
+/* Implementations only need to provide this routine if they want unchanged initialized data to be skipped. */
+const CrashCatcherLoadImageRegion* CrashCatcher_GetLoadImageRegions(void) __attribute__((weak));
+
+/* Implementations only need to provide this routine if they have a hardware CRC peripheral. */
+uint32_t CrashCatcher_HardwareCrc32(uint32_t crc, const void* pvData, size_t size) __attribute__((weak));
+
+/* Implementations only need to provide this routine if they can dump several chunks of memory with a single I/O. */
+void CrashCatcher_DumpMemoryVector(const CrashCatcherMemoryVector* pVectors, size_t vectorCount) __attribute__((weak));
+
 
 /* Fault handler will switch MSP to use this area as the stack while CrashCatcher code is running.
    NOTE: If you change the size of this buffer, it also needs to be changed in the HardFault_Handler (in
          FaultHandler_arm*.S) when initializing the stack pointer. */
 uint32_t g_crashCatcherStack[CRASH_CATCHER_STACK_WORD_COUNT];
 
+/* High water mark of g_crashCatcherStack, in bytes, when CRASH_CATCHER_FLAGS_STACK_USAGE is set. */
+uint32_t g_crashCatcherStackUsed;
+
+/* Number of words below the painting routine's own stack variable which are left alone when painting the stack. */
+#define STACK_PAINT_MARGIN_WORDS 4
+
+/* Running CRC32 values for the dump currently being sent when CRASH_CATCHER_FLAGS_CRC32 is set. */
+static uint32_t g_dumpCrc;
+static uint32_t g_regionCrc;
+static uint32_t g_regionCrcCount;
+static uint32_t g_regionCrcs[CRASH_CATCHER_CRC32_MAX_REGIONS];
+
+/* Header, flags and register chunks waiting to be sent to CrashCatcher_DumpMemoryVector().  There are at most 10 of
+   them: signature, flags, backtrace, R0-R3, R4-R11, R12, SP, LR/PC/PSR, MSP/PSP/exceptionPSR and the floating point
+   registers. */
+#define MAX_PENDING_VECTORS 10
+static CrashCatcherMemoryVector g_pendingVectors[MAX_PENDING_VECTORS];
+static size_t                   g_pendingVectorCount;
+static int                      g_isGatheringVectors;
+
+/* Backtrace record sent when CRASH_CATCHER_FLAGS_BACKTRACE is set.  It is kept off of the small CrashCatcher stack. */
+static CrashCatcherBacktraceRecord g_backtrace;
+
+/* Set while the dump is being captured into the retained buffer rather than sent to CrashCatcher_DumpMemory(). */
+static int g_isRetaining;
+
+/* Set while the dump is being copied into the pipeline's staging buffers rather than sent to CrashCatcher_DumpMemory(). */
+static int g_isPipelining;
+
+/* Record sent when CRASH_CATCHER_FLAGS_TIMING is set and the number of uncompressed bytes sent in this attempt. */
+static CrashCatcherTimingRecord g_timing;
+static uint32_t                 g_dumpedByteCount;
+
 
 typedef struct
 {
@@ -44,7 +175,49 @@ typedef struct
     CrashCatcherInfo                      info;
 } Object;
 
+/* Progress of the stack scan for the backtrace record. */
+typedef struct
+{
+    uint32_t address;
+    uint32_t stackTop;
+    int      isProcessStack;
+} StackScan;
+
+/* CFSR bits checked in order, from the cause closest to the root of the problem, to decode the cause of a fault. */
+typedef struct
+{
+    uint32_t faultBits;
+    uint32_t cause;
+} FaultCause;
+
+static const FaultCause g_faultCauses[] =
+{
+    { CFSR_MUNSTKERR | CFSR_MSTKERR | CFSR_MLSPERR | CFSR_UNSTKERR | CFSR_STKERR | CFSR_LSPERR | CFSR_STKOF,
+      CRASH_CATCHER_FAULT_STACKING },
+    { CFSR_IACCVIOL | CFSR_IBUSERR, CRASH_CATCHER_FAULT_INSTRUCTION_ACCESS },
+    { CFSR_DACCVIOL | CFSR_PRECISERR, CRASH_CATCHER_FAULT_DATA_ACCESS },
+    { CFSR_IMPRECISERR, CRASH_CATCHER_FAULT_IMPRECISE_DATA_ACCESS },
+    { CFSR_UNDEFINSTR, CRASH_CATCHER_FAULT_UNDEFINED_INSTRUCTION },
+    { CFSR_INVSTATE | CFSR_INVPC, CRASH_CATCHER_FAULT_INVALID_STATE },
+    { CFSR_NOCP, CRASH_CATCHER_FAULT_NO_COPROCESSOR },
+    { CFSR_UNALIGNED, CRASH_CATCHER_FAULT_UNALIGNED_ACCESS },
+    { CFSR_DIVBYZERO, CRASH_CATCHER_FAULT_DIVIDE_BY_ZERO }
+};
 
+
+static int captureRetainedDump(const Object* pObject);
+static int isRetainedDumpEnabled(void);
+static void resetDevice(void);
+static void dataSynchronizationBarrier(void);
+static uint32_t startCycleCounter(void);
+static uint32_t readCycleCounter(const Object* pObject);
+static void startDump(const Object* pObject);
+static int endDump(const Object* pObject);
+static void startPipeline(void);
+static int isPipelineEnabled(void);
+static void endPipeline(void);
+static int isPipelining(void);
+static void dumpCrash(const Object* pObject);
 static Object initStackPointers(const CrashCatcherExceptionRegisters* pExceptionRegisters);
 static uint32_t getAddressOfExceptionStack(const CrashCatcherExceptionRegisters* pExceptionRegisters);
 static void* uint32AddressToPointer(uint32_t address);
@@ -52,13 +225,47 @@ static void advanceStackPointerToValueBeforeException(Object* pObject);
 static int areFloatingPointRegistersAutoStacked(const Object* pObject);
 static void initFloatingPointFlag(Object* pObject);
 static int areFloatingPointCoprocessorsEnabled(void);
+static void initCompressionFlag(Object* pObject);
+static void initSegmentedFlag(Object* pObject);
+static int isSegmentedDumpEnabled(void);
+static int isLoadImageEnabled(void);
+static int isHeapWalkEnabled(void);
+static void initMinidumpFlag(Object* pObject);
+static void initCrc32Flag(Object* pObject);
+static void initBacktraceFlag(Object* pObject);
+static void initTwoTierFlag(Object* pObject);
+static int isTwoTier(const Object* pObject);
 static void initIsBKPT(Object* pObject);
 static int isBKPT(uint16_t instruction);
 static uint8_t getBKPTValue(uint16_t instruction);
 static int isBadPC();
+static void initFaultSignature(Object* pObject);
+static void initTimingFlag(Object* pObject, uint32_t entryCycle);
+static int isTimed(const Object* pObject);
+static int isCycleCounterRunning(void);
+static void initStackUsageFlag(Object* pObject);
+static int isStackUsageMeasured(const Object* pObject);
+static void paintStack(void) __attribute__((noinline));
+static void startTiming(void);
 static void setStackSentinel(void);
-static void dumpSignature(void);
+static void startCrc32(void);
+static void startGatheringVectors(void);
+static int isVectoredDumpEnabled(void);
+static int isGatheringVectors(void);
+static void sendGatheredVectors(void);
+static void dumpSignature(const Object* pObject);
 static void dumpFlags(const Object* pObject);
+static void dumpBacktrace(const Object* pObject);
+static void dumpUncompressedMemory(const Object* pObject, const void* pvMemory, CrashCatcherElementSizes elementSize,
+                                   size_t elementCount);
+static void startCompression(const Object* pObject);
+static void writeMemory(const void* pvMemory, CrashCatcherElementSizes elementSize, size_t elementCount);
+static void dumpMemory(const Object* pObject, const void* pvMemory, CrashCatcherElementSizes elementSize, size_t elementCount);
+static void updateCrc32(const Object* pObject, const void* pvMemory, CrashCatcherElementSizes elementSize, size_t elementCount);
+static int isCrc32Sent(const Object* pObject);
+static void updateCrc32Values(const void* pvData, size_t size);
+static void countDumpedBytes(CrashCatcherElementSizes elementSize, size_t elementCount);
+static uint32_t calculateCrc32(uint32_t crc, const void* pvData, size_t size);
 static void dumpR0toR3(const Object* pObject);
 static void dumpR4toR11(const Object* pObject);
 static void dumpR12(const Object* pObject);
@@ -66,50 +273,255 @@ static void dumpSP(const Object* pObject);
 static void dumpLR_PC_PSR(const Object* pObject);
 static void dumpMSPandPSPandExceptionPSR(const Object* pObject);
 static void dumpFloatingPointRegisters(const Object* pObject);
-static void dumpMemoryRegions(const CrashCatcherMemoryRegion* pRegion);
-static void checkStackSentinelForStackOverflow(void);
+static void dumpMemoryRegions(const Object* pObject, const CrashCatcherMemoryRegion* pRegion);
+static int isRetainedBufferOverlapping(const CrashCatcherMemoryRegion* pRegion);
+static void dumpRegionAroundRetainedBuffer(const Object* pObject, const CrashCatcherMemoryRegion* pRegion);
+static void dumpMemoryRegion(const Object* pObject, const CrashCatcherMemoryRegion* pRegion);
+static void saveRegionCrc32(const Object* pObject);
+static void saveRegionTiming(const Object* pObject, uint32_t startCycle, uint32_t startByteCount);
+static void dumpRegionData(const Object* pObject, uint32_t startAddress, uint32_t endAddress, CrashCatcherElementSizes elementSize);
+static void dumpCopiedRegionData(const Object* pObject, uint32_t startAddress, uint32_t endAddress,
+                                 CrashCatcherElementSizes elementSize);
+static void copyElements(void* pvDest, const void* pvSrc, CrashCatcherElementSizes elementSize, size_t elementCount);
+static void dumpRegionSegments(const Object* pObject, const CrashCatcherMemoryRegion* pRegion);
+static const CrashCatcherLoadImageRegion* findLoadImageRegion(uint32_t startAddress, uint32_t endAddress);
+static void dumpChangedMemory(const Object* pObject, const CrashCatcherMemoryRegion* pRegion,
+                              const CrashCatcherLoadImageRegion* pLoadImage,
+                              uint32_t startAddress, uint32_t endAddress);
+static int matchesLoadImage(const CrashCatcherLoadImageRegion* pLoadImage, uint32_t startAddress, uint32_t endAddress);
+static void dumpLoadImageSpan(const Object* pObject, const CrashCatcherMemoryRegion* pRegion,
+                              const CrashCatcherLoadImageRegion* pLoadImage,
+                              uint32_t startAddress, uint32_t endAddress, int isUnchanged);
+static void dumpHeapMemory(const Object* pObject, const CrashCatcherMemoryRegion* pRegion,
+                           uint32_t startAddress, uint32_t endAddress);
+static int getNextFreeHeapSpan(uint32_t startAddress, uint32_t endAddress, CrashCatcherMemoryRegionInfo* pFreeSpan);
+static void dumpUsedMemory(const Object* pObject, const CrashCatcherMemoryRegion* pRegion,
+                           uint32_t startAddress, uint32_t endAddress);
+static uint32_t findEndOfRun(uint32_t startAddress, uint32_t endAddress);
+static void dumpSegments(const Object* pObject, const CrashCatcherMemoryRegion* pRegion,
+                         uint32_t type, uint32_t startAddress, uint32_t endAddress);
+static void dumpLoadImageSegments(const Object* pObject, const CrashCatcherLoadImageRegion* pLoadImage,
+                                  uint32_t startAddress, uint32_t endAddress);
+static uint32_t segmentLength(uint32_t startAddress, uint32_t endAddress);
+static void dumpSegmentHeader(const Object* pObject, uint32_t type, uint32_t length);
+static void dumpTier1(const Object* pObject);
+static void initFaultCauseRecord(const Object* pObject, CrashCatcherFaultCauseRecord* pRecord);
+static void dumpFaultCause(const Object* pObject);
+static void decodeFaultStatusRegisters(CrashCatcherFaultCauseRecord* pRecord);
+static void dumpTopOfActiveStack(const Object* pObject);
+static void dumpTierEnd(const Object* pObject, uint32_t tier);
+static void dumpActiveStack(const Object* pObject);
+static void dumpStackRange(const Object* pObject, uint32_t startOffset, uint32_t endOffset);
+static uint32_t getTopOfActiveStack(const Object* pObject);
+static uint32_t getTopOfStack(uint32_t sp, int isProcessStack);
+static uint32_t getTopOfMainStack(void);
+static void checkStackSentinelForStackOverflow(const Object* pObject);
 static int isARMv6MDevice(void);
-static void dumpFaultStatusRegisters(void);
+static int isFaultStatusDumped(void);
+static void dumpFaultStatusRegisters(const Object* pObject);
+static void dumpTimingRecord(const Object* pObject);
+static void dumpStackUsageRecord(const Object* pObject);
+static uint32_t measureStackUsage(const Object* pObject);
+static void dumpCrc32Trailer(const Object* pObject);
+static void endCompression(const Object* pObject);
+static int isCompressed(const Object* pObject);
 static void advanceProgramCounterPastHardcodedBreakpoint(const Object* pObject);
+static void initBacktrace(const Object* pObject);
+static void scanStackForReturnAddresses(const Object* pObject);
+static void unstackExceptionFrame(const Object* pObject, StackScan* pScan, uint32_t excReturn);
+static int isExceptionReturn(uint32_t value);
+static int isReturnAddress(uint32_t value);
+static int isCodeAddress(uint32_t address);
+static uint32_t readStackWord(uint32_t address);
+static void addBacktraceAddress(uint32_t address);
 
 
 void CrashCatcher_Entry(const CrashCatcherExceptionRegisters* pExceptionRegisters)
 {
+    uint32_t entryCycle = startCycleCounter();
     Object object = initStackPointers(pExceptionRegisters);
+    /* Painted before anything else so that the stack used by the rest of the init steps is measured too. */
+    initStackUsageFlag(&object);
     advanceStackPointerToValueBeforeException(&object);
     initFloatingPointFlag(&object);
+    initCompressionFlag(&object);
+    initSegmentedFlag(&object);
+    initMinidumpFlag(&object);
+    initCrc32Flag(&object);
+    initBacktraceFlag(&object);
+    initTwoTierFlag(&object);
     initIsBKPT(&object);
+    initFaultSignature(&object);
+    initTimingFlag(&object, entryCycle);
 
-    do
+    if (!captureRetainedDump(&object))
     {
-        setStackSentinel();
-        CrashCatcher_DumpStart(&object.info);
-        dumpSignature();
-        dumpFlags(&object);
-        dumpR0toR3(&object);
-        dumpR4toR11(&object);
-        dumpR12(&object);
-        dumpSP(&object);
-        dumpLR_PC_PSR(&object);
-        dumpMSPandPSPandExceptionPSR(&object);
-        if (object.flags & CRASH_CATCHER_FLAGS_FLOATING_POINT)
-            dumpFloatingPointRegisters(&object);
-        dumpMemoryRegions(CrashCatcher_GetMemoryRegions());
-        if (!isARMv6MDevice())
-            dumpFaultStatusRegisters();
-        checkStackSentinelForStackOverflow();
-    }
-    while (CrashCatcher_DumpEnd() == CRASH_CATCHER_TRY_AGAIN);
+        do
+        {
+            setStackSentinel();
+            startDump(&object);
+            startPipeline();
+            dumpCrash(&object);
+            endPipeline();
+        }
+        while (endDump(&object) == CRASH_CATCHER_TRY_AGAIN);
+    }
 
     advanceProgramCounterPastHardcodedBreakpoint(&object);
 }
 
+static int captureRetainedDump(const Object* pObject)
+{
+    if (!isRetainedDumpEnabled() || !CrashCatcher_RetainedStart(&pObject->info))
+        return 0;
+    setStackSentinel();
+    g_isRetaining = 1;
+    dumpCrash(pObject);
+    g_isRetaining = 0;
+    CrashCatcher_RetainedEnd();
+    /* Execution can continue after a hardcoded breakpoint but the device is restarted straight away after a crash. */
+    if (!pObject->info.isBKPT)
+        resetDevice();
+    return 1;
+}
+
+static int isRetainedDumpEnabled(void)
+{
+    return g_crashCatcherEnableRetained && CrashCatcher_GetRetainedBuffer;
+}
+
+static void resetDevice(void)
+{
+    volatile uint32_t* pResetControl = (volatile uint32_t*)g_pCrashCatcherApplicationInterruptResetControlRegister;
+
+    /* Same sequence as CMSIS NVIC_SystemReset(): the retained capture must reach RAM before the reset is requested and
+       the request must complete before waiting.  The priority grouping is preserved as the reset isn't immediate. */
+    dataSynchronizationBarrier();
+    *pResetControl = AIRCR_VECTKEY | (*pResetControl & AIRCR_PRIGROUP) | AIRCR_SYSRESETREQ;
+    dataSynchronizationBarrier();
+    while (g_crashCatcherWaitForReset)
+    {
+    }
+}
+
+static void dataSynchronizationBarrier(void)
+{
+#ifndef RUNNING_HOST_TESTS
+    __asm volatile ("dsb 0xF" : : : "memory");
+#endif
+}
+
+static uint32_t startCycleCounter(void)
+{
+    volatile uint32_t* pDebugControl = (volatile uint32_t*)g_pCrashCatcherDebugExceptionMonitorControlRegister;
+    volatile uint32_t* pDwtControl = (volatile uint32_t*)g_pCrashCatcherDwtControlRegister;
+
+    if (!g_crashCatcherEnableTiming || isARMv6MDevice())
+        return 0;
+    /* The DWT can't be used until trace is enabled.  The count isn't cleared in case the application also uses it. */
+    *pDebugControl |= DEMCR_TRCENA;
+    *pDwtControl |= DWT_CTRL_CYCCNTENA;
+    return *(volatile uint32_t*)g_pCrashCatcherCycleCounter;
+}
+
+static uint32_t readCycleCounter(const Object* pObject)
+{
+    if (!isTimed(pObject))
+        return 0;
+    return *(volatile uint32_t*)g_pCrashCatcherCycleCounter;
+}
+
+static void startDump(const Object* pObject)
+{
+    uint32_t startCycle = readCycleCounter(pObject);
+
+    CrashCatcher_DumpStart(&pObject->info);
+    if (isTimed(pObject))
+        g_timing.dumpStartCycles = readCycleCounter(pObject) - startCycle;
+}
+
+static int endDump(const Object* pObject)
+{
+    uint32_t startCycle = readCycleCounter(pObject);
+    int      result = CrashCatcher_DumpEnd();
+
+    /* This attempt's record has already been sent so the time is reported in the next attempt's record. */
+    if (isTimed(pObject))
+        g_timing.previousDumpEndCycles = readCycleCounter(pObject) - startCycle;
+    measureStackUsage(pObject);
+    return result;
+}
+
+static void startPipeline(void)
+{
+    g_isPipelining = isPipelineEnabled();
+    if (isPipelining())
+        CrashCatcher_PipelineStart();
+}
+
+static int isPipelineEnabled(void)
+{
+    return g_crashCatcherEnablePipeline && CrashCatcher_StartTransfer && CrashCatcher_IsTransferComplete;
+}
+
+static void endPipeline(void)
+{
+    if (isPipelining())
+        CrashCatcher_PipelineEnd();
+    g_isPipelining = 0;
+}
+
+static int isPipelining(void)
+{
+    /* Checking the enable switch first lets the pipeline and its buffers be left out of the link when disabled. */
+    return g_crashCatcherEnablePipeline && g_isPipelining;
+}
+
+static void dumpCrash(const Object* pObject)
+{
+    uint32_t startCycle = readCycleCounter(pObject);
+
+    startCrc32();
+    startTiming();
+    startGatheringVectors();
+    dumpSignature(pObject);
+    dumpFlags(pObject);
+    dumpBacktrace(pObject);
+    startCompression(pObject);
+    dumpR0toR3(pObject);
+    dumpR4toR11(pObject);
+    dumpR12(pObject);
+    dumpSP(pObject);
+    dumpLR_PC_PSR(pObject);
+    dumpMSPandPSPandExceptionPSR(pObject);
+    if (g_crashCatcherEnableFloatingPoint && (pObject->flags & CRASH_CATCHER_FLAGS_FLOATING_POINT))
+        dumpFloatingPointRegisters(pObject);
+    sendGatheredVectors();
+    if (isTimed(pObject))
+        g_timing.registerCycles = readCycleCounter(pObject) - startCycle;
+    if (isTwoTier(pObject))
+        dumpTier1(pObject);
+    if (g_crashCatcherEnableMinidump && (pObject->flags & CRASH_CATCHER_FLAGS_MINIDUMP))
+        dumpActiveStack(pObject);
+    else
+        dumpMemoryRegions(pObject, CrashCatcher_GetMemoryRegions());
+    if (isFaultStatusDumped() && !isTwoTier(pObject))
+        dumpFaultStatusRegisters(pObject);
+    dumpTierEnd(pObject, 2);
+    dumpTimingRecord(pObject);
+    dumpStackUsageRecord(pObject);
+    dumpCrc32Trailer(pObject);
+    checkStackSentinelForStackOverflow(pObject);
+    endCompression(pObject);
+}
+
 static Object initStackPointers(const CrashCatcherExceptionRegisters* pExceptionRegisters)
 {
     Object object;
     object.pExceptionRegisters = pExceptionRegisters;
     object.info.sp = getAddressOfExceptionStack(pExceptionRegisters);
     object.pSP = uint32AddressToPointer(object.info.sp);
+    object.info.isRetained = 0;
     object.flags = 0;
     return object;
 }
@@ -148,7 +560,7 @@ static int areFloatingPointRegistersAutoStacked(const Object* pObject)
 
 static void initFloatingPointFlag(Object* pObject)
 {
-    if (areFloatingPointCoprocessorsEnabled())
+    if (g_crashCatcherEnableFloatingPoint && areFloatingPointCoprocessorsEnabled())
         pObject->flags |= CRASH_CATCHER_FLAGS_FLOATING_POINT;
 }
 
@@ -160,6 +572,65 @@ static int areFloatingPointCoprocessorsEnabled(void)
     return (coprocessorAccessControl & (coProcessor10and11EnabledBits)) == coProcessor10and11EnabledBits;
 }
 
+static void initCompressionFlag(Object* pObject)
+{
+    if (g_crashCatcherEnableCompression)
+        pObject->flags |= CRASH_CATCHER_FLAGS_COMPRESSED;
+}
+
+static void initSegmentedFlag(Object* pObject)
+{
+    if (isSegmentedDumpEnabled())
+        pObject->flags |= CRASH_CATCHER_FLAGS_SEGMENTED;
+}
+
+static int isSegmentedDumpEnabled(void)
+{
+    return g_crashCatcherEnableRunElision || isLoadImageEnabled() || isHeapWalkEnabled();
+}
+
+static int isLoadImageEnabled(void)
+{
+    return g_crashCatcherEnableLoadImage && CrashCatcher_GetLoadImageRegions;
+}
+
+static int isHeapWalkEnabled(void)
+{
+    return g_crashCatcherEnableHeapWalk && CrashCatcher_GetNextFreeHeapSpan;
+}
+
+static void initMinidumpFlag(Object* pObject)
+{
+    if (g_crashCatcherEnableMinidump)
+        pObject->flags |= CRASH_CATCHER_FLAGS_MINIDUMP;
+}
+
+static void initCrc32Flag(Object* pObject)
+{
+    if (g_crashCatcherEnableCrc32)
+        pObject->flags |= CRASH_CATCHER_FLAGS_CRC32;
+}
+
+static void initBacktraceFlag(Object* pObject)
+{
+    if (!g_crashCatcherEnableBacktrace)
+        return;
+    pObject->flags |= CRASH_CATCHER_FLAGS_BACKTRACE;
+    /* Found once up front since the stack doesn't change when the dump is repeated. */
+    initBacktrace(pObject);
+}
+
+static void initTwoTierFlag(Object* pObject)
+{
+    if (g_crashCatcherEnableTwoTier)
+        pObject->flags |= CRASH_CATCHER_FLAGS_TWO_TIER;
+}
+
+static int isTwoTier(const Object* pObject)
+{
+    return g_crashCatcherEnableTwoTier && (pObject->flags & CRASH_CATCHER_FLAGS_TWO_TIER);
+}
+
 static void initIsBKPT(Object* pObject)
 {
     int wasBKPT = 0;
@@ -167,7 +638,7 @@ static void initIsBKPT(Object* pObject)
 
     /* On ARMv7M, can use fault status registers to determine if bad PC was cause of fault before checking to see if
        it points to a BKPT instruction. */
-    if (CRASH_CATCHER_ISBKPT_SUPPORT && (isARMv6MDevice() || !isBadPC()))
+    if (g_crashCatcherEnableIsBKPT && (isARMv6MDevice() || !isBadPC()))
     {
         const uint16_t* pInstruction = uint32AddressToPointer(pObject->pSP->pc);
         uint16_t instruction = *pInstruction;
@@ -198,54 +669,303 @@ static int isBadPC()
     return g_pCrashCatcherFaultStatusRegisters->CFSR & badPCFaultBits;
 }
 
+static void initFaultSignature(Object* pObject)
+{
+    CrashCatcherFaultCauseRecord record;
+
+    pObject->info.pc = pObject->pSP->pc;
+    pObject->info.lr = pObject->pSP->lr;
+    pObject->info.faultCause = pObject->info.isBKPT ? CRASH_CATCHER_FAULT_BREAKPOINT : CRASH_CATCHER_FAULT_UNKNOWN;
+    /* Checking the enable switch first lets the decode and its g_faultCauses table be left out of the link. */
+    if (!g_crashCatcherEnableFaultCause)
+        return;
+    initFaultCauseRecord(pObject, &record);
+    pObject->info.faultCause = record.cause;
+}
+
+static void initTimingFlag(Object* pObject, uint32_t entryCycle)
+{
+    if (!g_crashCatcherEnableTiming)
+        return;
+    memset(&g_timing, 0, sizeof(g_timing));
+    if (!isCycleCounterRunning())
+        return;
+    pObject->flags |= CRASH_CATCHER_FLAGS_TIMING;
+    g_timing.captureCycles = readCycleCounter(pObject) - entryCycle;
+}
+
+static int isTimed(const Object* pObject)
+{
+    /* Checking the enable switch first lets the timing code and record be left out of the link when disabled. */
+    return g_crashCatcherEnableTiming && (pObject->flags & CRASH_CATCHER_FLAGS_TIMING);
+}
+
+static int isCycleCounterRunning(void)
+{
+    uint32_t dwtControl;
+
+    if (!g_crashCatcherEnableTiming || isARMv6MDevice())
+        return 0;
+    dwtControl = *(volatile uint32_t*)g_pCrashCatcherDwtControlRegister;
+    return (dwtControl & (DWT_CTRL_NOCYCCNT | DWT_CTRL_CYCCNTENA)) == DWT_CTRL_CYCCNTENA;
+}
+
+static void initStackUsageFlag(Object* pObject)
+{
+    if (!g_crashCatcherEnableStackUsage)
+        return;
+    g_crashCatcherStackUsed = 0;
+    pObject->flags |= CRASH_CATCHER_FLAGS_STACK_USAGE;
+    paintStack();
+}
+
+static int isStackUsageMeasured(const Object* pObject)
+{
+    return g_crashCatcherEnableStackUsage && (pObject->flags & CRASH_CATCHER_FLAGS_STACK_USAGE);
+}
+
+static void paintStack(void)
+{
+    /* On the device, this code is already running on g_crashCatcherStack so painting stops just short of this
+       routine's own frame.  It mustn't be inlined as the caller's frame could then extend below marker. */
+    uint32_t      marker = 0;
+    unsigned long markerAddress = (unsigned long)&marker;
+    unsigned long stackStart = (unsigned long)g_crashCatcherStack;
+    size_t        paintCount = CRASH_CATCHER_STACK_WORD_COUNT;
+    size_t        i;
+
+    if (markerAddress >= stackStart && markerAddress < stackStart + sizeof(g_crashCatcherStack))
+    {
+        size_t markerIndex = (markerAddress - stackStart) / sizeof(uint32_t);
+        paintCount = markerIndex > STACK_PAINT_MARGIN_WORDS ? markerIndex - STACK_PAINT_MARGIN_WORDS : 0;
+    }
+    for (i = 0 ; i < paintCount ; i++)
+        g_crashCatcherStack[i] = CRASH_CATCHER_STACK_SENTINEL;
+}
+
 static void setStackSentinel(void)
 {
+    if (!g_crashCatcherEnableStackSentinel)
+        return;
     g_crashCatcherStack[0] = CRASH_CATCHER_STACK_SENTINEL;
 }
 
-static void dumpSignature(void)
+static void startCrc32(void)
+{
+    if (!g_crashCatcherEnableCrc32)
+        return;
+    g_dumpCrc = 0;
+    g_regionCrc = 0;
+    g_regionCrcCount = 0;
+}
+
+static void startTiming(void)
+{
+    if (!g_crashCatcherEnableTiming)
+        return;
+    g_timing.attempt++;
+    g_timing.regionCount = 0;
+    memset(g_timing.regions, 0, sizeof(g_timing.regions));
+    g_dumpedByteCount = 0;
+}
+
+static void startGatheringVectors(void)
+{
+    if (!g_crashCatcherEnableVectoredDump)
+        return;
+    g_pendingVectorCount = 0;
+    g_isGatheringVectors = isVectoredDumpEnabled();
+}
+
+static int isVectoredDumpEnabled(void)
+{
+    return g_crashCatcherEnableVectoredDump && CrashCatcher_DumpMemoryVector;
+}
+
+static int isGatheringVectors(void)
+{
+    /* Checking the enable switch first lets the vector list be left out of the link when disabled. */
+    return g_crashCatcherEnableVectoredDump && g_isGatheringVectors;
+}
+
+static void sendGatheredVectors(void)
+{
+    if (!isGatheringVectors())
+        return;
+    if (g_pendingVectorCount > 0)
+        CrashCatcher_DumpMemoryVector(g_pendingVectors, g_pendingVectorCount);
+    g_pendingVectorCount = 0;
+    g_isGatheringVectors = 0;
+}
+
+static void dumpSignature(const Object* pObject)
 {
     static const uint8_t signature[4] = {CRASH_CATCHER_SIGNATURE_BYTE0,
                                          CRASH_CATCHER_SIGNATURE_BYTE1,
                                          CRASH_CATCHER_VERSION_MAJOR,
                                          CRASH_CATCHER_VERSION_MINOR};
 
-    CrashCatcher_DumpMemory(signature, CRASH_CATCHER_BYTE, sizeof(signature));
+    dumpUncompressedMemory(pObject, signature, CRASH_CATCHER_BYTE, sizeof(signature));
 }
 
 static void dumpFlags(const Object* pObject)
 {
-    CrashCatcher_DumpMemory(&pObject->flags, CRASH_CATCHER_BYTE, sizeof(pObject->flags));
+    dumpUncompressedMemory(pObject, &pObject->flags, CRASH_CATCHER_BYTE, sizeof(pObject->flags));
+}
+
+static void dumpBacktrace(const Object* pObject)
+{
+    if (g_crashCatcherEnableBacktrace && (pObject->flags & CRASH_CATCHER_FLAGS_BACKTRACE))
+        dumpUncompressedMemory(pObject, &g_backtrace, CRASH_CATCHER_BYTE, sizeof(g_backtrace));
+}
+
+static void dumpUncompressedMemory(const Object* pObject, const void* pvMemory, CrashCatcherElementSizes elementSize,
+                                   size_t elementCount)
+{
+    updateCrc32(pObject, pvMemory, elementSize, elementCount);
+    countDumpedBytes(elementSize, elementCount);
+    writeMemory(pvMemory, elementSize, elementCount);
+}
+
+static void writeMemory(const void* pvMemory, CrashCatcherElementSizes elementSize, size_t elementCount)
+{
+    CrashCatcherMemoryVector* pVector;
+
+    if (g_crashCatcherEnableRetained && g_isRetaining)
+    {
+        CrashCatcher_RetainedMemory(pvMemory, elementSize, elementCount);
+        return;
+    }
+    if (isPipelining())
+    {
+        CrashCatcher_PipelineMemory(pvMemory, elementSize, elementCount);
+        return;
+    }
+    if (!isGatheringVectors())
+    {
+        CrashCatcher_DumpMemory(pvMemory, elementSize, elementCount);
+        return;
+    }
+    if (g_pendingVectorCount == MAX_PENDING_VECTORS)
+    {
+        /* Shouldn't happen but don't lose any data if it does. */
+        sendGatheredVectors();
+        CrashCatcher_DumpMemory(pvMemory, elementSize, elementCount);
+        return;
+    }
+    pVector = &g_pendingVectors[g_pendingVectorCount++];
+    pVector->pvMemory = pvMemory;
+    pVector->elementSize = elementSize;
+    pVector->elementCount = elementCount;
+}
+
+void CrashCatcher_WriteMemory(const void* pvMemory, CrashCatcherElementSizes elementSize, size_t elementCount)
+{
+    writeMemory(pvMemory, elementSize, elementCount);
+}
+
+static void startCompression(const Object* pObject)
+{
+    if (isCompressed(pObject))
+    {
+        /* The compressor already coalesces the registers into blocks so just send the header and flags together. */
+        sendGatheredVectors();
+        CrashCatcher_CompressStart();
+    }
+}
+
+static void dumpMemory(const Object* pObject, const void* pvMemory, CrashCatcherElementSizes elementSize, size_t elementCount)
+{
+    /* Everything after the flags word is sent through here so that it can be compressed if requested. */
+    updateCrc32(pObject, pvMemory, elementSize, elementCount);
+    countDumpedBytes(elementSize, elementCount);
+    if (isCompressed(pObject))
+        CrashCatcher_CompressMemory(pvMemory, elementSize, elementCount);
+    else
+        writeMemory(pvMemory, elementSize, elementCount);
+}
+
+static void updateCrc32(const Object* pObject, const void* pvMemory, CrashCatcherElementSizes elementSize, size_t elementCount)
+{
+    size_t i;
+
+    /* The CRCs are calculated over the uncompressed bytes so that they also catch bugs in the host's decompressor. */
+    if (!isCrc32Sent(pObject))
+        return;
+    switch (elementSize)
+    {
+    case CRASH_CATCHER_BYTE:
+        updateCrc32Values(pvMemory, elementCount);
+        break;
+    case CRASH_CATCHER_HALFWORD:
+        for (i = 0 ; i < elementCount ; i++)
+        {
+            uint16_t val = ((const uint16_t*)pvMemory)[i];
+            updateCrc32Values(&val, sizeof(val));
+        }
+        break;
+    case CRASH_CATCHER_WORD:
+        for (i = 0 ; i < elementCount ; i++)
+        {
+            uint32_t val = ((const uint32_t*)pvMemory)[i];
+            updateCrc32Values(&val, sizeof(val));
+        }
+        break;
+    }
+}
+
+static int isCrc32Sent(const Object* pObject)
+{
+    return g_crashCatcherEnableCrc32 && (pObject->flags & CRASH_CATCHER_FLAGS_CRC32);
+}
+
+static void updateCrc32Values(const void* pvData, size_t size)
+{
+    g_dumpCrc = calculateCrc32(g_dumpCrc, pvData, size);
+    g_regionCrc = calculateCrc32(g_regionCrc, pvData, size);
+}
+
+static uint32_t calculateCrc32(uint32_t crc, const void* pvData, size_t size)
+{
+    if (CrashCatcher_HardwareCrc32)
+        return CrashCatcher_HardwareCrc32(crc, pvData, size);
+    return CrashCatcher_Crc32(crc, pvData, size);
+}
+
+static void countDumpedBytes(CrashCatcherElementSizes elementSize, size_t elementCount)
+{
+    if (g_crashCatcherEnableTiming)
+        g_dumpedByteCount += (uint32_t)(elementSize * elementCount);
 }
 
 static void dumpR0toR3(const Object* pObject)
 {
-    CrashCatcher_DumpMemory(&pObject->pSP->r0, CRASH_CATCHER_BYTE, 4 * sizeof(uint32_t));
+    dumpMemory(pObject, &pObject->pSP->r0, CRASH_CATCHER_BYTE, 4 * sizeof(uint32_t));
 }
 
 static void dumpR4toR11(const Object* pObject)
 {
-    CrashCatcher_DumpMemory(&pObject->pExceptionRegisters->r4, CRASH_CATCHER_BYTE, (11 - 4 + 1) * sizeof(uint32_t));
+    dumpMemory(pObject, &pObject->pExceptionRegisters->r4, CRASH_CATCHER_BYTE, (11 - 4 + 1) * sizeof(uint32_t));
 }
 
 static void dumpR12(const Object* pObject)
 {
-    CrashCatcher_DumpMemory(&pObject->pSP->r12, CRASH_CATCHER_BYTE, sizeof(uint32_t));
+    dumpMemory(pObject, &pObject->pSP->r12, CRASH_CATCHER_BYTE, sizeof(uint32_t));
 }
 
 static void dumpSP(const Object* pObject)
 {
-    CrashCatcher_DumpMemory(&pObject->info.sp, CRASH_CATCHER_BYTE, sizeof(uint32_t));
+    dumpMemory(pObject, &pObject->info.sp, CRASH_CATCHER_BYTE, sizeof(uint32_t));
 }
 
 static void dumpLR_PC_PSR(const Object* pObject)
 {
-    CrashCatcher_DumpMemory(&pObject->pSP->lr, CRASH_CATCHER_BYTE, 3 * sizeof(uint32_t));
+    dumpMemory(pObject, &pObject->pSP->lr, CRASH_CATCHER_BYTE, 3 * sizeof(uint32_t));
 }
 
 static void dumpMSPandPSPandExceptionPSR(const Object* pObject)
 {
-    CrashCatcher_DumpMemory(&pObject->pExceptionRegisters->msp, CRASH_CATCHER_BYTE, 3 * sizeof(uint32_t));
+    dumpMemory(pObject, &pObject->pExceptionRegisters->msp, CRASH_CATCHER_BYTE, 3 * sizeof(uint32_t));
 }
 
 static void dumpFloatingPointRegisters(const Object* pObject)
@@ -262,28 +982,486 @@ static void dumpFloatingPointRegisters(const Object* pObject)
     {
         CrashCatcher_CopyAllFloatingPointRegisters(allFloatingPointRegisters);
     }
-    CrashCatcher_DumpMemory(allFloatingPointRegisters, CRASH_CATCHER_BYTE, sizeof(allFloatingPointRegisters));
+    dumpMemory(pObject, allFloatingPointRegisters, CRASH_CATCHER_BYTE, sizeof(allFloatingPointRegisters));
+    /* Must be sent before allFloatingPointRegisters goes out of scope. */
+    sendGatheredVectors();
 }
 
-static void dumpMemoryRegions(const CrashCatcherMemoryRegion* pRegion)
+static void dumpMemoryRegions(const Object* pObject, const CrashCatcherMemoryRegion* pRegion)
 {
     while (pRegion && pRegion->startAddress != 0xFFFFFFFF)
     {
-        /* Just dump the two addresses in pRegion.  The element size isn't required. */
-        CrashCatcher_DumpMemory(pRegion, CRASH_CATCHER_BYTE, 2 * sizeof(uint32_t));
-        CrashCatcher_DumpMemory(uint32AddressToPointer(pRegion->startAddress),
-                                pRegion->elementSize,
-                                (pRegion->endAddress - pRegion->startAddress) / pRegion->elementSize);
+        if (isRetainedBufferOverlapping(pRegion))
+            dumpRegionAroundRetainedBuffer(pObject, pRegion);
+        else
+            dumpMemoryRegion(pObject, pRegion);
         pRegion++;
     }
 }
 
-static void checkStackSentinelForStackOverflow(void)
+static int isRetainedBufferOverlapping(const CrashCatcherMemoryRegion* pRegion)
+{
+    uint32_t bufferStart;
+    uint32_t bufferEnd;
+
+    if (!g_crashCatcherEnableRetained || !g_isRetaining)
+        return 0;
+    CrashCatcher_RetainedBufferRange(&bufferStart, &bufferEnd);
+    return pRegion->startAddress < bufferEnd && bufferStart < pRegion->endAddress;
+}
+
+static void dumpRegionAroundRetainedBuffer(const Object* pObject, const CrashCatcherMemoryRegion* pRegion)
+{
+    /* Capturing the retained buffer into itself would overwrite the memory being read so only the parts of the region
+       on either side of it are dumped, each as a region of its own. */
+    CrashCatcherMemoryRegion part = *pRegion;
+    uint32_t                 elementSize = pRegion->elementSize;
+    uint32_t                 bufferStart;
+    uint32_t                 bufferEnd;
+
+    CrashCatcher_RetainedBufferRange(&bufferStart, &bufferEnd);
+    if (bufferStart > pRegion->startAddress)
+    {
+        part.endAddress = pRegion->startAddress + (bufferStart - pRegion->startAddress) / elementSize * elementSize;
+        if (part.endAddress > part.startAddress)
+            dumpMemoryRegion(pObject, &part);
+    }
+    if (bufferEnd < pRegion->endAddress)
+    {
+        part.startAddress = pRegion->endAddress - (pRegion->endAddress - bufferEnd) / elementSize * elementSize;
+        part.endAddress = pRegion->endAddress;
+        if (part.endAddress > part.startAddress)
+            dumpMemoryRegion(pObject, &part);
+    }
+}
+
+static void dumpMemoryRegion(const Object* pObject, const CrashCatcherMemoryRegion* pRegion)
+{
+    uint32_t startCycle = readCycleCounter(pObject);
+    uint32_t startByteCount = g_dumpedByteCount;
+
+    if (isCrc32Sent(pObject))
+        g_regionCrc = 0;
+    /* Just dump the two addresses in pRegion.  The element size isn't required. */
+    dumpMemory(pObject, pRegion, CRASH_CATCHER_BYTE, 2 * sizeof(uint32_t));
+    if (isSegmentedDumpEnabled() && (pObject->flags & CRASH_CATCHER_FLAGS_SEGMENTED))
+        dumpRegionSegments(pObject, pRegion);
+    else
+        dumpRegionData(pObject, pRegion->startAddress, pRegion->endAddress, pRegion->elementSize);
+    saveRegionCrc32(pObject);
+    saveRegionTiming(pObject, startCycle, startByteCount);
+}
+
+static void saveRegionCrc32(const Object* pObject)
+{
+    if (isCrc32Sent(pObject) && g_regionCrcCount < CRASH_CATCHER_CRC32_MAX_REGIONS)
+        g_regionCrcs[g_regionCrcCount++] = g_regionCrc;
+}
+
+static void saveRegionTiming(const Object* pObject, uint32_t startCycle, uint32_t startByteCount)
+{
+    CrashCatcherRegionTiming* pRegionTiming;
+
+    if (!isTimed(pObject) || g_timing.regionCount >= CRASH_CATCHER_TIMING_MAX_REGIONS)
+        return;
+    pRegionTiming = &g_timing.regions[g_timing.regionCount++];
+    pRegionTiming->cycles = readCycleCounter(pObject) - startCycle;
+    pRegionTiming->byteCount = g_dumpedByteCount - startByteCount;
+}
+
+static void dumpRegionData(const Object* pObject, uint32_t startAddress, uint32_t endAddress, CrashCatcherElementSizes elementSize)
+{
+    if (isCrc32Sent(pObject))
+    {
+        dumpCopiedRegionData(pObject, startAddress, endAddress, elementSize);
+        return;
+    }
+    dumpMemory(pObject, uint32AddressToPointer(startAddress), elementSize, (endAddress - startAddress) / elementSize);
+}
+
+static void dumpCopiedRegionData(const Object* pObject, uint32_t startAddress, uint32_t endAddress,
+                                 CrashCatcherElementSizes elementSize)
+{
+    uint32_t copy[CRASH_CATCHER_CRC32_COPY_SIZE / sizeof(uint32_t)];
+
+    /* Each element is read just once, into copy, and both the CRCs and the dump are fed from there.  Otherwise
+       registers with read side effects would be read twice and memory which changed between the two reads would
+       leave the CRCs not matching what was actually sent. */
+    do
+    {
+        uint32_t size = endAddress - startAddress;
+
+        if (size > sizeof(copy))
+            size = sizeof(copy);
+        copyElements(copy, uint32AddressToPointer(startAddress), elementSize, size / elementSize);
+        dumpMemory(pObject, copy, elementSize, size / elementSize);
+        startAddress += size;
+    } while (startAddress < endAddress);
+}
+
+static void copyElements(void* pvDest, const void* pvSrc, CrashCatcherElementSizes elementSize, size_t elementCount)
+{
+    size_t i;
+
+    switch (elementSize)
+    {
+    case CRASH_CATCHER_BYTE:
+        for (i = 0 ; i < elementCount ; i++)
+            ((uint8_t*)pvDest)[i] = ((const volatile uint8_t*)pvSrc)[i];
+        break;
+    case CRASH_CATCHER_HALFWORD:
+        for (i = 0 ; i < elementCount ; i++)
+            ((uint16_t*)pvDest)[i] = ((const volatile uint16_t*)pvSrc)[i];
+        break;
+    case CRASH_CATCHER_WORD:
+        for (i = 0 ; i < elementCount ; i++)
+            ((uint32_t*)pvDest)[i] = ((const volatile uint32_t*)pvSrc)[i];
+        break;
+    }
+}
+
+static void dumpRegionSegments(const Object* pObject, const CrashCatcherMemoryRegion* pRegion)
+{
+    const CrashCatcherLoadImageRegion* pLoadImage;
+    uint32_t                           address = pRegion->startAddress;
+
+    /* Only scan regions which allow byte reads since reads of peripheral registers can have side effects. */
+    if (pRegion->elementSize != CRASH_CATCHER_BYTE)
+    {
+        dumpSegments(pObject, pRegion, CRASH_CATCHER_SEGMENT_RAW, pRegion->startAddress, pRegion->endAddress);
+        return;
+    }
+
+    while ((pLoadImage = findLoadImageRegion(address, pRegion->endAddress)) != NULL)
+    {
+        uint32_t loadImageStart = pLoadImage->startAddress > address ? pLoadImage->startAddress : address;
+        uint32_t loadImageEnd = pLoadImage->endAddress < pRegion->endAddress ? pLoadImage->endAddress :
+                                                                                 pRegion->endAddress;
+
+        dumpHeapMemory(pObject, pRegion, address, loadImageStart);
+        dumpChangedMemory(pObject, pRegion, pLoadImage, loadImageStart, loadImageEnd);
+        address = loadImageEnd;
+    }
+    dumpHeapMemory(pObject, pRegion, address, pRegion->endAddress);
+}
+
+static const CrashCatcherLoadImageRegion* findLoadImageRegion(uint32_t startAddress, uint32_t endAddress)
+{
+    const CrashCatcherLoadImageRegion* pCurr;
+    const CrashCatcherLoadImageRegion* pFound = NULL;
+
+    if (!isLoadImageEnabled())
+        return NULL;
+    /* The lowest addressed one is picked so that the segments are still sent in address order. */
+    for (pCurr = CrashCatcher_GetLoadImageRegions() ; pCurr && pCurr->startAddress != 0xFFFFFFFF ; pCurr++)
+    {
+        if (pCurr->startAddress < endAddress && pCurr->endAddress > startAddress &&
+            (!pFound || pCurr->startAddress < pFound->startAddress))
+        {
+            pFound = pCurr;
+        }
+    }
+    return pFound;
+}
+
+static void dumpChangedMemory(const Object* pObject, const CrashCatcherMemoryRegion* pRegion,
+                              const CrashCatcherLoadImageRegion* pLoadImage,
+                              uint32_t startAddress, uint32_t endAddress)
+{
+    uint32_t spanStart = startAddress;
+    uint32_t address = startAddress;
+    int      isSpanUnchanged = 0;
+
+    /* Neighbouring blocks which have all changed (or are all unchanged) are merged into a single span. */
+    while (address < endAddress)
+    {
+        uint32_t blockEnd = endAddress;
+        int      isBlockUnchanged;
+
+        if (blockEnd - address > CRASH_CATCHER_LOAD_IMAGE_BLOCK_SIZE)
+            blockEnd = address + CRASH_CATCHER_LOAD_IMAGE_BLOCK_SIZE;
+        isBlockUnchanged = matchesLoadImage(pLoadImage, address, blockEnd);
+        if (address != spanStart && isBlockUnchanged != isSpanUnchanged)
+        {
+            dumpLoadImageSpan(pObject, pRegion, pLoadImage, spanStart, address, isSpanUnchanged);
+            spanStart = address;
+        }
+        isSpanUnchanged = isBlockUnchanged;
+        address = blockEnd;
+    }
+    dumpLoadImageSpan(pObject, pRegion, pLoadImage, spanStart, address, isSpanUnchanged);
+}
+
+static int matchesLoadImage(const CrashCatcherLoadImageRegion* pLoadImage, uint32_t startAddress, uint32_t endAddress)
+{
+    uint32_t loadAddress = pLoadImage->loadAddress + (startAddress - pLoadImage->startAddress);
+
+    return 0 == memcmp(uint32AddressToPointer(startAddress), uint32AddressToPointer(loadAddress), endAddress - startAddress);
+}
+
+static void dumpLoadImageSpan(const Object* pObject, const CrashCatcherMemoryRegion* pRegion,
+                              const CrashCatcherLoadImageRegion* pLoadImage,
+                              uint32_t startAddress, uint32_t endAddress, int isUnchanged)
+{
+    if (isUnchanged)
+        dumpLoadImageSegments(pObject, pLoadImage, startAddress, endAddress);
+    else
+        dumpUsedMemory(pObject, pRegion, startAddress, endAddress);
+}
+
+static void dumpHeapMemory(const Object* pObject, const CrashCatcherMemoryRegion* pRegion,
+                           uint32_t startAddress, uint32_t endAddress)
+{
+    CrashCatcherMemoryRegionInfo freeSpan;
+
+    while (getNextFreeHeapSpan(startAddress, endAddress, &freeSpan))
+    {
+        dumpUsedMemory(pObject, pRegion, startAddress, freeSpan.startAddress);
+        dumpSegments(pObject, pRegion, CRASH_CATCHER_SEGMENT_HOLE, freeSpan.startAddress, freeSpan.endAddress);
+        startAddress = freeSpan.endAddress;
+    }
+    dumpUsedMemory(pObject, pRegion, startAddress, endAddress);
+}
+
+static int getNextFreeHeapSpan(uint32_t startAddress, uint32_t endAddress, CrashCatcherMemoryRegionInfo* pFreeSpan)
+{
+    if (!isHeapWalkEnabled() || startAddress >= endAddress)
+        return 0;
+    if (!CrashCatcher_GetNextFreeHeapSpan(startAddress, endAddress, pFreeSpan))
+        return 0;
+    /* The heap might be the reason for the crash so ignore free spans which don't make sense. */
+    return pFreeSpan->startAddress >= startAddress &&
+           pFreeSpan->endAddress > pFreeSpan->startAddress &&
+           pFreeSpan->endAddress <= endAddress;
+}
+
+static void dumpUsedMemory(const Object* pObject, const CrashCatcherMemoryRegion* pRegion,
+                           uint32_t startAddress, uint32_t endAddress)
+{
+    uint32_t rawStart = startAddress;
+    uint32_t address = (startAddress + 3) & ~3;
+
+    while (g_crashCatcherEnableRunElision &&
+           address < endAddress &&
+           endAddress - address >= sizeof(uint32_t))
+    {
+        uint32_t runEnd = findEndOfRun(address, endAddress);
+
+        if (runEnd - address >= CRASH_CATCHER_RUN_ELISION_MIN_WORDS * sizeof(uint32_t))
+        {
+            dumpSegments(pObject, pRegion, CRASH_CATCHER_SEGMENT_RAW, rawStart, address);
+            dumpSegments(pObject, pRegion, CRASH_CATCHER_SEGMENT_FILL, address, runEnd);
+            rawStart = runEnd;
+        }
+        address = runEnd;
+    }
+    dumpSegments(pObject, pRegion, CRASH_CATCHER_SEGMENT_RAW, rawStart, endAddress);
+}
+
+static uint32_t findEndOfRun(uint32_t startAddress, uint32_t endAddress)
 {
-    if (g_crashCatcherStack[0] != CRASH_CATCHER_STACK_SENTINEL)
+    const uint32_t* pCurr = uint32AddressToPointer(startAddress);
+    uint32_t        fillWord = *pCurr++;
+    uint32_t        address = startAddress + sizeof(uint32_t);
+
+    while (endAddress - address >= sizeof(uint32_t) && *pCurr == fillWord)
+    {
+        pCurr++;
+        address += sizeof(uint32_t);
+    }
+    return address;
+}
+
+static void dumpSegments(const Object* pObject, const CrashCatcherMemoryRegion* pRegion,
+                         uint32_t type, uint32_t startAddress, uint32_t endAddress)
+{
+    while (startAddress < endAddress)
+    {
+        uint32_t length = segmentLength(startAddress, endAddress);
+
+        dumpSegmentHeader(pObject, type, length);
+        if (type == CRASH_CATCHER_SEGMENT_RAW)
+            dumpRegionData(pObject, startAddress, startAddress + length, pRegion->elementSize);
+        else if (type == CRASH_CATCHER_SEGMENT_FILL)
+            dumpRegionData(pObject, startAddress, startAddress + sizeof(uint32_t), CRASH_CATCHER_BYTE);
+        startAddress += length;
+    }
+}
+
+static void dumpLoadImageSegments(const Object* pObject, const CrashCatcherLoadImageRegion* pLoadImage,
+                                  uint32_t startAddress, uint32_t endAddress)
+{
+    while (startAddress < endAddress)
+    {
+        uint32_t length = segmentLength(startAddress, endAddress);
+        uint32_t loadAddress = pLoadImage->loadAddress + (startAddress - pLoadImage->startAddress);
+
+        dumpSegmentHeader(pObject, CRASH_CATCHER_SEGMENT_LOAD_IMAGE, length);
+        dumpMemory(pObject, &loadAddress, CRASH_CATCHER_BYTE, sizeof(loadAddress));
+        startAddress += length;
+    }
+}
+
+static uint32_t segmentLength(uint32_t startAddress, uint32_t endAddress)
+{
+    static const uint32_t maxLength = CRASH_CATCHER_SEGMENT_LENGTH_MASK & ~3;
+    uint32_t              length = endAddress - startAddress;
+
+    /* Very large spans are split across multiple segments since the length field is only 28 bits. */
+    return length > maxLength ? maxLength : length;
+}
+
+static void dumpSegmentHeader(const Object* pObject, uint32_t type, uint32_t length)
+{
+    uint32_t header = (type << CRASH_CATCHER_SEGMENT_TYPE_SHIFT) | length;
+
+    dumpMemory(pObject, &header, CRASH_CATCHER_BYTE, sizeof(header));
+}
+
+static void dumpTier1(const Object* pObject)
+{
+    if (isFaultStatusDumped())
+        dumpFaultStatusRegisters(pObject);
+    if (g_crashCatcherEnableFaultCause)
+        dumpFaultCause(pObject);
+    dumpTopOfActiveStack(pObject);
+    dumpTierEnd(pObject, 1);
+}
+
+static void dumpFaultCause(const Object* pObject)
+{
+    CrashCatcherFaultCauseRecord record;
+
+    initFaultCauseRecord(pObject, &record);
+    dumpMemory(pObject, &record, CRASH_CATCHER_BYTE, sizeof(record));
+}
+
+static void initFaultCauseRecord(const Object* pObject, CrashCatcherFaultCauseRecord* pRecord)
+{
+    pRecord->tag = CRASH_CATCHER_RECORD_TAG(CRASH_CATCHER_RECORD_FAULT_CAUSE);
+    pRecord->payloadSize = sizeof(*pRecord) - 2 * sizeof(uint32_t);
+    pRecord->cause = CRASH_CATCHER_FAULT_UNKNOWN;
+    pRecord->isAddressValid = 0;
+    pRecord->address = 0;
+    if (!isARMv6MDevice())
+        decodeFaultStatusRegisters(pRecord);
+    if (pObject->info.isBKPT)
+        pRecord->cause = CRASH_CATCHER_FAULT_BREAKPOINT;
+}
+
+static void decodeFaultStatusRegisters(CrashCatcherFaultCauseRecord* pRecord)
+{
+    uint32_t CFSR = g_pCrashCatcherFaultStatusRegisters->CFSR;
+    uint32_t HFSR = g_pCrashCatcherFaultStatusRegisters->HFSR;
+    size_t   i;
+
+    if (CFSR & CFSR_MMARVALID)
+    {
+        pRecord->isAddressValid = 1;
+        pRecord->address = g_pCrashCatcherFaultStatusRegisters->MMFAR;
+    }
+    else if (CFSR & CFSR_BFARVALID)
+    {
+        pRecord->isAddressValid = 1;
+        pRecord->address = g_pCrashCatcherFaultStatusRegisters->BFAR;
+    }
+
+    if (HFSR & HFSR_DEBUGEVT)
+    {
+        pRecord->cause = CRASH_CATCHER_FAULT_BREAKPOINT;
+        return;
+    }
+    if (HFSR & HFSR_VECTTBL)
+    {
+        pRecord->cause = CRASH_CATCHER_FAULT_VECTOR_TABLE_READ;
+        return;
+    }
+    for (i = 0 ; i < sizeof(g_faultCauses) / sizeof(g_faultCauses[0]) ; i++)
+    {
+        if (CFSR & g_faultCauses[i].faultBits)
+        {
+            pRecord->cause = g_faultCauses[i].cause;
+            return;
+        }
+    }
+}
+
+static void dumpTopOfActiveStack(const Object* pObject)
+{
+    dumpStackRange(pObject, 0, g_crashCatcherTier1StackSize);
+}
+
+static void dumpTierEnd(const Object* pObject, uint32_t tier)
+{
+    uint32_t record[4];
+
+    if (!isTwoTier(pObject))
+        return;
+    record[0] = CRASH_CATCHER_RECORD_TAG(CRASH_CATCHER_RECORD_TIER_END);
+    record[1] = 2 * sizeof(uint32_t);
+    record[2] = tier;
+    record[3] = isCrc32Sent(pObject) ? g_dumpCrc : 0;
+    dumpMemory(pObject, record, CRASH_CATCHER_BYTE, sizeof(record));
+}
+
+static void dumpActiveStack(const Object* pObject)
+{
+    /* Tier 1 already contains the top of the stack. */
+    uint32_t startOffset = isTwoTier(pObject) ? g_crashCatcherTier1StackSize : 0;
+
+    dumpStackRange(pObject, startOffset, CRASH_CATCHER_MINIDUMP_MAX_STACK_SIZE);
+}
+
+static void dumpStackRange(const Object* pObject, uint32_t startOffset, uint32_t endOffset)
+{
+    uint32_t                 stackPointer = pObject->info.sp;
+    uint32_t                 stackTop = getTopOfActiveStack(pObject);
+    CrashCatcherMemoryRegion stackRegion[] = { {stackPointer + startOffset, stackTop, CRASH_CATCHER_BYTE},
+                                               {0xFFFFFFFF, 0xFFFFFFFF, CRASH_CATCHER_BYTE} };
+
+    /* A corrupted SP can be above the top of the stack so just dump the registers in that case. */
+    if (stackTop <= stackPointer || stackTop - stackPointer <= startOffset || endOffset <= startOffset)
+        return;
+    if (stackTop - stackPointer > endOffset)
+        stackRegion[0].endAddress = stackPointer + endOffset;
+    dumpMemoryRegions(pObject, stackRegion);
+}
+
+static uint32_t getTopOfActiveStack(const Object* pObject)
+{
+    return getTopOfStack(pObject->info.sp, pObject->pExceptionRegisters->exceptionLR & LR_PSP);
+}
+
+static uint32_t getTopOfStack(uint32_t sp, int isProcessStack)
+{
+    uint32_t threadStackTop = 0;
+
+    if (isProcessStack && CrashCatcher_GetThreadStackTop)
+        threadStackTop = CrashCatcher_GetThreadStackTop(sp);
+    if (threadStackTop != 0)
+        return threadStackTop;
+    /* Thread stacks are normally located in RAM below the main stack so it makes a safe upper limit when the actual top
+       of the thread's stack isn't known. */
+    return getTopOfMainStack();
+}
+
+static uint32_t getTopOfMainStack(void)
+{
+#ifdef CRASH_CATCHER_MAIN_STACK_TOP_SYMBOL
+    return (uint32_t)(unsigned long)&CRASH_CATCHER_MAIN_STACK_TOP_SYMBOL;
+#else
+    /* The first entry in the vector table is the initial value of MSP. */
+    const uint32_t* pVectorTable = uint32AddressToPointer(*g_pCrashCatcherVectorTableOffsetRegister);
+    return pVectorTable[0];
+#endif
+}
+
+static void checkStackSentinelForStackOverflow(const Object* pObject)
+{
+    if (g_crashCatcherEnableStackSentinel && g_crashCatcherStack[0] != CRASH_CATCHER_STACK_SENTINEL)
     {
         uint8_t value[4] = {0xAC, 0xCE, 0x55, 0xED};
-        CrashCatcher_DumpMemory(value, CRASH_CATCHER_BYTE, sizeof(value));
+        dumpMemory(pObject, value, CRASH_CATCHER_BYTE, sizeof(value));
     }
 }
 
@@ -296,14 +1474,90 @@ static int isARMv6MDevice(void)
     return (architecture == armv6mArchitecture);
 }
 
-static void dumpFaultStatusRegisters(void)
+static int isFaultStatusDumped(void)
+{
+    /* ARMv6-M devices don't have the fault status registers. */
+    return g_crashCatcherEnableFaultStatus && !isARMv6MDevice();
+}
+
+static void dumpFaultStatusRegisters(const Object* pObject)
 {
     uint32_t                 faultStatusRegistersAddress = (uint32_t)(unsigned long)g_pCrashCatcherFaultStatusRegisters;
     CrashCatcherMemoryRegion faultStatusRegion[] = { {faultStatusRegistersAddress,
                                                       faultStatusRegistersAddress + sizeof(FaultStatusRegisters),
                                                       CRASH_CATCHER_WORD},
                                                      {0xFFFFFFFF, 0xFFFFFFFF, CRASH_CATCHER_BYTE} };
-    dumpMemoryRegions(faultStatusRegion);
+    dumpMemoryRegions(pObject, faultStatusRegion);
+}
+
+static void dumpTimingRecord(const Object* pObject)
+{
+    if (!isTimed(pObject))
+        return;
+    g_timing.tag = CRASH_CATCHER_RECORD_TAG(CRASH_CATCHER_RECORD_TIMING);
+    g_timing.payloadSize = sizeof(g_timing) - 2 * sizeof(uint32_t);
+    g_timing.byteCount = g_dumpedByteCount;
+    dumpMemory(pObject, &g_timing, CRASH_CATCHER_BYTE, sizeof(g_timing));
+}
+
+static void dumpStackUsageRecord(const Object* pObject)
+{
+    CrashCatcherStackUsageRecord record;
+
+    if (!isStackUsageMeasured(pObject))
+        return;
+    record.tag = CRASH_CATCHER_RECORD_TAG(CRASH_CATCHER_RECORD_STACK_USAGE);
+    record.payloadSize = sizeof(record) - 2 * sizeof(uint32_t);
+    record.stackSize = sizeof(g_crashCatcherStack);
+    record.usedSize = measureStackUsage(pObject);
+    dumpMemory(pObject, &record, CRASH_CATCHER_BYTE, sizeof(record));
+}
+
+static uint32_t measureStackUsage(const Object* pObject)
+{
+    /* The stack grows down so the lowest word which no longer holds the paint marks the high water. */
+    uint32_t usedSize;
+    size_t   i;
+
+    if (!isStackUsageMeasured(pObject))
+        return 0;
+    for (i = 0 ; i < CRASH_CATCHER_STACK_WORD_COUNT && g_crashCatcherStack[i] == CRASH_CATCHER_STACK_SENTINEL ; i++)
+    {
+    }
+    usedSize = (CRASH_CATCHER_STACK_WORD_COUNT - i) * sizeof(uint32_t);
+    if (usedSize > g_crashCatcherStackUsed)
+        g_crashCatcherStackUsed = usedSize;
+    return g_crashCatcherStackUsed;
+}
+
+static void dumpCrc32Trailer(const Object* pObject)
+{
+    uint32_t header[2];
+    uint32_t dumpCrc;
+
+    if (!isCrc32Sent(pObject))
+        return;
+    header[0] = CRASH_CATCHER_RECORD_TAG(CRASH_CATCHER_RECORD_CRC32);
+    header[1] = (g_regionCrcCount + 2) * sizeof(uint32_t);
+    dumpMemory(pObject, header, CRASH_CATCHER_BYTE, sizeof(header));
+    if (g_regionCrcCount > 0)
+        dumpMemory(pObject, g_regionCrcs, CRASH_CATCHER_BYTE, g_regionCrcCount * sizeof(uint32_t));
+    dumpMemory(pObject, &g_regionCrcCount, CRASH_CATCHER_BYTE, sizeof(g_regionCrcCount));
+    /* Take a copy since dumping the CRC will update g_dumpCrc. */
+    dumpCrc = g_dumpCrc;
+    dumpMemory(pObject, &dumpCrc, CRASH_CATCHER_BYTE, sizeof(dumpCrc));
+}
+
+static void endCompression(const Object* pObject)
+{
+    if (isCompressed(pObject))
+        CrashCatcher_CompressEnd();
+}
+
+static int isCompressed(const Object* pObject)
+{
+    /* Checking the enable switch first lets the compressor and its buffers be left out of the link when disabled. */
+    return g_crashCatcherEnableCompression && (pObject->flags & CRASH_CATCHER_FLAGS_COMPRESSED);
 }
 
 static void advanceProgramCounterPastHardcodedBreakpoint(const Object* pObject)
@@ -311,3 +1565,124 @@ static void advanceProgramCounterPastHardcodedBreakpoint(const Object* pObject)
     if (pObject->info.isBKPT)
         pObject->pSP->pc += 2;
 }
+
+static void initBacktrace(const Object* pObject)
+{
+    memset(&g_backtrace, 0, sizeof(g_backtrace));
+    g_backtrace.tag = CRASH_CATCHER_RECORD_TAG(CRASH_CATCHER_RECORD_BACKTRACE);
+    g_backtrace.payloadSize = sizeof(g_backtrace) - 2 * sizeof(uint32_t);
+    g_backtrace.excReturn = pObject->pExceptionRegisters->exceptionLR;
+    if (!isARMv6MDevice())
+    {
+        g_backtrace.CFSR = g_pCrashCatcherFaultStatusRegisters->CFSR;
+        g_backtrace.HFSR = g_pCrashCatcherFaultStatusRegisters->HFSR;
+        g_backtrace.MMFAR = g_pCrashCatcherFaultStatusRegisters->MMFAR;
+        g_backtrace.BFAR = g_pCrashCatcherFaultStatusRegisters->BFAR;
+    }
+    g_backtrace.pc = pObject->pSP->pc;
+    g_backtrace.lr = pObject->pSP->lr;
+    g_backtrace.sp = pObject->info.sp;
+    scanStackForReturnAddresses(pObject);
+}
+
+static void scanStackForReturnAddresses(const Object* pObject)
+{
+    StackScan scan;
+    uint32_t  wordsLeft = CRASH_CATCHER_BACKTRACE_MAX_SCAN_SIZE / sizeof(uint32_t);
+
+    scan.address = pObject->info.sp;
+    scan.stackTop = getTopOfActiveStack(pObject);
+    scan.isProcessStack = pObject->pExceptionRegisters->exceptionLR & LR_PSP;
+    /* A handler which faulted before pushing anything still has EXC_RETURN in LR with its exception frame at SP. */
+    if (isExceptionReturn(g_backtrace.lr))
+        unstackExceptionFrame(pObject, &scan, g_backtrace.lr);
+    /* A corrupted SP can be above the top of the stack, in which case nothing is scanned. */
+    while (wordsLeft-- > 0 && scan.address < scan.stackTop && scan.stackTop - scan.address >= sizeof(uint32_t) &&
+           g_backtrace.addressCount < CRASH_CATCHER_BACKTRACE_MAX_ADDRESSES)
+    {
+        uint32_t value = readStackWord(scan.address);
+
+        scan.address += sizeof(uint32_t);
+        if (isReturnAddress(value))
+            addBacktraceAddress(value);
+        else if (isExceptionReturn(value))
+            unstackExceptionFrame(pObject, &scan, value);
+    }
+}
+
+static void unstackExceptionFrame(const Object* pObject, StackScan* pScan, uint32_t excReturn)
+{
+    uint32_t frameAddress = pScan->address;
+    uint32_t stackTop = pScan->stackTop;
+    uint32_t frameSize = 8 * sizeof(uint32_t);
+    uint32_t pc;
+    uint32_t lr;
+    uint32_t psr;
+
+    /* A handler pushes EXC_RETURN along with the other registers it saves so its exception frame follows, unless the
+       handler interrupted a thread, in which case the frame and the rest of the backtrace are on the thread's stack. */
+    if (excReturn & LR_PSP)
+    {
+        if (pScan->isProcessStack)
+            return;
+        frameAddress = pObject->pExceptionRegisters->psp;
+        stackTop = getTopOfStack(frameAddress, 1);
+    }
+    if (frameAddress >= stackTop || stackTop - frameAddress < frameSize)
+        return;
+    lr = readStackWord(frameAddress + 5 * sizeof(uint32_t));
+    pc = readStackWord(frameAddress + 6 * sizeof(uint32_t));
+    psr = readStackWord(frameAddress + 7 * sizeof(uint32_t));
+    /* Words which just happen to look like EXC_RETURN won't be followed by a stacked Thumb state bit and a PC in the
+       code, in which case the scan carries on as if they were any other word. */
+    if ((psr & PSR_THUMB) == 0 || (pc & 1) || !isCodeAddress(pc))
+        return;
+
+    addBacktraceAddress(pc);
+    /* LR is added too since leaf functions don't push it, even though that means it can appear twice. */
+    if (isReturnAddress(lr))
+        addBacktraceAddress(lr);
+    if ((excReturn & LR_FLOAT) == 0)
+        frameSize += (16 + 1 + 1) * sizeof(uint32_t);
+    if (psr & PSR_STACK_ALIGN)
+        frameSize += sizeof(uint32_t);
+    pScan->address = frameAddress + frameSize;
+    pScan->stackTop = stackTop;
+    pScan->isProcessStack = pScan->isProcessStack || (excReturn & LR_PSP);
+}
+
+static int isExceptionReturn(uint32_t value)
+{
+    /* Bits 31:5 are all set and, since handlers always return to Thumb code, bit 0 is too. */
+    return (value & 0xFFFFFFE1) == 0xFFFFFFE1;
+}
+
+static int isReturnAddress(uint32_t value)
+{
+    return (value & 1) && isCodeAddress(value);
+}
+
+static int isCodeAddress(uint32_t address)
+{
+#if defined(CRASH_CATCHER_CODE_START_SYMBOL) && defined(CRASH_CATCHER_CODE_END_SYMBOL)
+    uint32_t codeStart = (uint32_t)(unsigned long)&CRASH_CATCHER_CODE_START_SYMBOL;
+    uint32_t codeEnd = (uint32_t)(unsigned long)&CRASH_CATCHER_CODE_END_SYMBOL;
+#else
+    uint32_t codeStart = g_crashCatcherCodeStart;
+    uint32_t codeEnd = g_crashCatcherCodeEnd;
+#endif
+
+    return address >= codeStart && address < codeEnd;
+}
+
+static uint32_t readStackWord(uint32_t address)
+{
+    const uint32_t* pWord = uint32AddressToPointer(address);
+    return *pWord;
+}
+
+static void addBacktraceAddress(uint32_t address)
+{
+    if (g_backtrace.addressCount < CRASH_CATCHER_BACKTRACE_MAX_ADDRESSES)
+        g_backtrace.addresses[g_backtrace.addressCount++] = address;
+}
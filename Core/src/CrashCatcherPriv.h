@@ -29,18 +29,212 @@
 #define CRASH_CATCHER_WITH_FPU 0
 #endif
 
+/* Set to 1 for the smallest build, where the features which are normally always included (isBKPT detection, floating
+   point register capture, fault status register dumping, fault cause decoding and the stack sentinel check) default to
+   being compiled out.
+   Each of them can still be turned back on with its own CRASH_CATCHER_*_SUPPORT setting. */
+#if !defined(CRASH_CATCHER_MIN_FOOTPRINT)
+    #define CRASH_CATCHER_MIN_FOOTPRINT 0
+#endif
+
 /* Set to 1 to enable support for CrashCatcherInfo::isBKPT. Defaults to being disabled on Cortex-M0 as checking PC for
    hardcoded breakpoints when the PC being corrupted might be the reason for fault isn't safe. */
 #if !defined(CRASH_CATCHER_ISBKPT_SUPPORT) && defined(__ARM_ARCH) && (__ARM_ARCH == 6)
     #define CRASH_CATCHER_ISBKPT_SUPPORT 0
-#elif !defined(CRASH_CATCHER_ISBKPT_SUPPORT) && (!defined(__ARM_ARCH) || (__ARM_ARCH != 6))
-    #define CRASH_CATCHER_ISBKPT_SUPPORT 1
+#elif !defined(CRASH_CATCHER_ISBKPT_SUPPORT)
+    #define CRASH_CATCHER_ISBKPT_SUPPORT (!CRASH_CATCHER_MIN_FOOTPRINT)
+#endif
+
+/* Set to 0 to never dump the floating point registers, even when the FPU is enabled.  This also leaves out the
+   CrashCatcher_Copy*FloatingPointRegisters() routines and the 132 byte buffer they fill on g_crashCatcherStack. */
+#if !defined(CRASH_CATCHER_FLOATING_POINT_SUPPORT)
+    #define CRASH_CATCHER_FLOATING_POINT_SUPPORT (!CRASH_CATCHER_MIN_FOOTPRINT)
+#endif
+
+/* Set to 0 to stop the fault status registers (CFSR, HFSR, DFSR, MMFAR and BFAR) from being appended to the dump as an
+   extra memory region on ARMv7-M devices.  The fault cause and backtrace records still read them. */
+#if !defined(CRASH_CATCHER_FAULT_STATUS_SUPPORT)
+    #define CRASH_CATCHER_FAULT_STATUS_SUPPORT (!CRASH_CATCHER_MIN_FOOTPRINT)
+#endif
+
+/* Set to 0 to stop the fault status registers from being decoded into CrashCatcherInfo::faultCause and the fault cause
+   record of two tier dumps.  The faultCause is then only set for hardcoded breakpoints and the record isn't sent. */
+#if !defined(CRASH_CATCHER_FAULT_CAUSE_SUPPORT)
+    #define CRASH_CATCHER_FAULT_CAUSE_SUPPORT (!CRASH_CATCHER_MIN_FOOTPRINT)
+#endif
+
+/* Set to 0 to stop the sentinel at the bottom of g_crashCatcherStack from being set and checked, so that ACCE55ED is
+   never appended to a dump whose stack overflowed. */
+#if !defined(CRASH_CATCHER_STACK_SENTINEL_SUPPORT)
+    #define CRASH_CATCHER_STACK_SENTINEL_SUPPORT (!CRASH_CATCHER_MIN_FOOTPRINT)
+#endif
+
+/* Set to 1 to have everything after the flags word compressed into independently decodable LZ4 blocks. Defaults to
+   being disabled since it requires an extra ~800 bytes of RAM for the compressor's work buffers. */
+#if !defined(CRASH_CATCHER_COMPRESSION_SUPPORT)
+    #define CRASH_CATCHER_COMPRESSION_SUPPORT 0
+#endif
+
+/* Number of uncompressed bytes to be placed in each compressed block.  Larger blocks compress better but require more
+   RAM for the work buffers.  Must not be larger than 65535. */
+#if !defined(CRASH_CATCHER_COMPRESSION_BLOCK_SIZE)
+    #define CRASH_CATCHER_COMPRESSION_BLOCK_SIZE 256
+#endif
+
+/* Set to 1 to have long runs of a repeated 32-bit word within memory regions (zeroed .bss, unused heap, painted stack,
+   etc.) replaced by a compact fill segment instead of being dumped byte for byte. */
+#if !defined(CRASH_CATCHER_RUN_ELISION_SUPPORT)
+    #define CRASH_CATCHER_RUN_ELISION_SUPPORT 0
+#endif
+
+/* Minimum number of repeated 32-bit words required before a run is elided.  Each elided run costs 12 bytes of segment
+   overhead so small values can make the dump larger. */
+#if !defined(CRASH_CATCHER_RUN_ELISION_MIN_WORDS)
+    #define CRASH_CATCHER_RUN_ELISION_MIN_WORDS 8
+#endif
+
+/* Set to 1 to have free heap memory reported by CrashCatcher_GetNextFreeHeapSpan() replaced with hole segments instead
+   of being dumped. */
+#if !defined(CRASH_CATCHER_HEAP_WALK_SUPPORT)
+    #define CRASH_CATCHER_HEAP_WALK_SUPPORT 0
+#endif
+
+/* Set to 1 to have the parts of memory regions which overlap the areas returned from CrashCatcher_GetLoadImageRegions()
+   only dump the blocks which differ from their load image in flash. */
+#if !defined(CRASH_CATCHER_LOAD_IMAGE_SUPPORT)
+    #define CRASH_CATCHER_LOAD_IMAGE_SUPPORT 0
+#endif
+
+/* Number of bytes in each block compared against the load image.  Smaller blocks skip more unchanged bytes but every
+   switch between changed and unchanged blocks costs 8 bytes of segment overhead. */
+#if !defined(CRASH_CATCHER_LOAD_IMAGE_BLOCK_SIZE)
+    #define CRASH_CATCHER_LOAD_IMAGE_BLOCK_SIZE 32
+#endif
+
+/* Set to 1 to have the dump only include the active stack, [SP, top of stack), instead of the memory regions returned
+   from CrashCatcher_GetMemoryRegions().  The top of the main stack is the initial MSP found in the vector table unless
+   CRASH_CATCHER_MAIN_STACK_TOP_SYMBOL is defined to the name of a linker symbol (ie. __StackTop) located at the top of
+   the main stack. */
+#if !defined(CRASH_CATCHER_MINIDUMP_SUPPORT)
+    #define CRASH_CATCHER_MINIDUMP_SUPPORT 0
+#endif
+
+/* Maximum number of stack bytes to be included in a minidump.  The frames closest to SP are kept. */
+#if !defined(CRASH_CATCHER_MINIDUMP_MAX_STACK_SIZE)
+    #define CRASH_CATCHER_MINIDUMP_MAX_STACK_SIZE 3584
+#endif
+
+/* Set to 1 to have a CRC32 of each memory region and of the whole dump appended to the end of the dump. */
+#if !defined(CRASH_CATCHER_CRC32_SUPPORT)
+    #define CRASH_CATCHER_CRC32_SUPPORT 0
+#endif
+
+/* Maximum number of memory regions which will have their own CRC32 in the trailer.  Each one costs 4 bytes of RAM. */
+#if !defined(CRASH_CATCHER_CRC32_MAX_REGIONS)
+    #define CRASH_CATCHER_CRC32_MAX_REGIONS 16
+#endif
+
+/* Number of bytes of a memory region copied onto the stack at a time when calculating CRC32s, so that each element is
+   only read once.  Each copy is sent with its own CrashCatcher_DumpMemory() call.  Must be a multiple of 4. */
+#if !defined(CRASH_CATCHER_CRC32_COPY_SIZE)
+    #define CRASH_CATCHER_CRC32_COPY_SIZE 48
+#endif
+
+/* Set to 1 to have the header, flags and registers sent to CrashCatcher_DumpMemoryVector() in a single call, when the
+   implementation provides it, instead of making a separate CrashCatcher_DumpMemory() call for each of them. */
+#if !defined(CRASH_CATCHER_VECTORED_DUMP_SUPPORT)
+    #define CRASH_CATCHER_VECTORED_DUMP_SUPPORT 0
+#endif
+
+/* Set to 1 to have a small CRASH_CATCHER_RECORD_BACKTRACE record, holding the fault registers and the return addresses
+   found by scanning the stack, sent right after the flags word. */
+#if !defined(CRASH_CATCHER_BACKTRACE_SUPPORT)
+    #define CRASH_CATCHER_BACKTRACE_SUPPORT 0
+#endif
+
+/* Number of address slots in the backtrace record.  Each one costs 4 bytes of RAM and 4 bytes in every dump. */
+#if !defined(CRASH_CATCHER_BACKTRACE_MAX_ADDRESSES)
+    #define CRASH_CATCHER_BACKTRACE_MAX_ADDRESSES 8
+#endif
+
+/* Maximum number of stack bytes scanned for return addresses, which bounds the time the scan can take. */
+#if !defined(CRASH_CATCHER_BACKTRACE_MAX_SCAN_SIZE)
+    #define CRASH_CATCHER_BACKTRACE_MAX_SCAN_SIZE 1024
+#endif
+
+/* Range of addresses which the backtrace scan treats as code.  Defaults to the whole Cortex-M code region.  Fewer stale
+   pointers are mistaken for return addresses when CRASH_CATCHER_CODE_START_SYMBOL and CRASH_CATCHER_CODE_END_SYMBOL are
+   defined to the names of linker symbols located at the start and end of .text instead. */
+#if !defined(CRASH_CATCHER_BACKTRACE_CODE_START)
+    #define CRASH_CATCHER_BACKTRACE_CODE_START 0x00000000
+#endif
+#if !defined(CRASH_CATCHER_BACKTRACE_CODE_END)
+    #define CRASH_CATCHER_BACKTRACE_CODE_END 0x20000000
+#endif
+
+/* Set to 1 to split the dump into two tiers so that the registers, fault status and top of the active stack are all
+   sent before the rest of the memory regions. */
+#if !defined(CRASH_CATCHER_TWO_TIER_SUPPORT)
+    #define CRASH_CATCHER_TWO_TIER_SUPPORT 0
+#endif
+
+/* Maximum number of bytes from the top of the active stack, starting at SP, to be sent in tier 1.  When the stack is
+   also included in a tier 2 region, up to this many bytes of it are sent twice. */
+#if !defined(CRASH_CATCHER_TIER1_STACK_SIZE)
+    #define CRASH_CATCHER_TIER1_STACK_SIZE 512
+#endif
+
+/* Set to 1 to capture the dump into the RAM buffer returned from CrashCatcher_GetRetainedBuffer() and then reset the
+   device straight away.  The application sends the captured dump through CrashCatcher_EmitRetainedDump() once it has
+   restarted. */
+#if !defined(CRASH_CATCHER_RETAINED_SUPPORT)
+    #define CRASH_CATCHER_RETAINED_SUPPORT 0
+#endif
+
+/* Set to 1 to copy the dump into staging buffers which are sent with CrashCatcher_StartTransfer(), when the
+   implementation provides it, so that the next buffer can be filled while the previous one is still being sent. */
+#if !defined(CRASH_CATCHER_PIPELINE_SUPPORT)
+    #define CRASH_CATCHER_PIPELINE_SUPPORT 0
+#endif
+
+/* Size and number of the staging buffers used when CRASH_CATCHER_PIPELINE_SUPPORT is set.  They cost
+   CRASH_CATCHER_PIPELINE_BUFFER_SIZE * CRASH_CATCHER_PIPELINE_BUFFER_COUNT bytes of RAM. */
+#if !defined(CRASH_CATCHER_PIPELINE_BUFFER_SIZE)
+    #define CRASH_CATCHER_PIPELINE_BUFFER_SIZE 256
+#endif
+#if !defined(CRASH_CATCHER_PIPELINE_BUFFER_COUNT)
+    #define CRASH_CATCHER_PIPELINE_BUFFER_COUNT 2
+#endif
+
+/* Each staging buffer is aligned to, and padded out to a multiple of, this many bytes so that cleaning the data cache
+   for one buffer can't write back part of another.  It should match the largest cache line size of the part. */
+#if !defined(CRASH_CATCHER_PIPELINE_CACHE_LINE_SIZE)
+    #define CRASH_CATCHER_PIPELINE_CACHE_LINE_SIZE 32
+#endif
+
+/* Set to 1 to have a CRASH_CATCHER_RECORD_TIMING record, holding the number of DWT cycles spent in each phase of the
+   dump, sent after the memory regions.  ARMv6-M devices don't have the cycle counter so they never send it. */
+#if !defined(CRASH_CATCHER_TIMING_SUPPORT)
+    #define CRASH_CATCHER_TIMING_SUPPORT 0
+#endif
+
+/* Number of memory regions which will have their own slot in the timing record.  Each one costs 8 bytes of RAM and 8
+   bytes in every dump. */
+#if !defined(CRASH_CATCHER_TIMING_MAX_REGIONS)
+    #define CRASH_CATCHER_TIMING_MAX_REGIONS 8
+#endif
+
+/* Set to 1 to paint all of g_crashCatcherStack on entry and send a CRASH_CATCHER_RECORD_STACK_USAGE record, holding
+   its high water mark, after the memory regions. */
+#if !defined(CRASH_CATCHER_STACK_USAGE_SUPPORT)
+    #define CRASH_CATCHER_STACK_USAGE_SUPPORT 0
 #endif
 
 
 /* Definitions only required from C code. */
 #if !defined(__ASSEMBLER__) || (!__ASSEMBLER__)
 
+#include <CrashCatcher.h>
 #include <stdint.h>
 
 
@@ -54,6 +248,44 @@
 /* Bit in auto stacked xPSR which indicates whether stack was force 8-byte aligned. */
 #define PSR_STACK_ALIGN (1 << 9)
 
+/* Bit in auto stacked xPSR which is always set since Cortex-M processors only execute Thumb code. */
+#define PSR_THUMB (1 << 24)
+
+
+/* Bits in HFSR and CFSR used to decode the cause of a fault. */
+#define HFSR_VECTTBL     (1 << 1)
+#define HFSR_DEBUGEVT    (1U << 31)
+#define CFSR_IACCVIOL    (1 << 0)
+#define CFSR_DACCVIOL    (1 << 1)
+#define CFSR_MUNSTKERR   (1 << 3)
+#define CFSR_MSTKERR     (1 << 4)
+#define CFSR_MLSPERR     (1 << 5)
+#define CFSR_MMARVALID   (1 << 7)
+#define CFSR_IBUSERR     (1 << 8)
+#define CFSR_PRECISERR   (1 << 9)
+#define CFSR_IMPRECISERR (1 << 10)
+#define CFSR_UNSTKERR    (1 << 11)
+#define CFSR_STKERR      (1 << 12)
+#define CFSR_LSPERR      (1 << 13)
+#define CFSR_BFARVALID   (1 << 15)
+#define CFSR_UNDEFINSTR  (1 << 16)
+#define CFSR_INVSTATE    (1 << 17)
+#define CFSR_INVPC       (1 << 18)
+#define CFSR_NOCP        (1 << 19)
+#define CFSR_STKOF       (1 << 20)
+#define CFSR_UNALIGNED   (1 << 24)
+#define CFSR_DIVBYZERO   (1 << 25)
+
+/* Writing this value to the Application Interrupt and Reset Control Register requests a reset of the device. */
+#define AIRCR_VECTKEY       (0x05FA << 16)
+#define AIRCR_PRIGROUP      (7 << 8)
+#define AIRCR_SYSRESETREQ   (1 << 2)
+
+/* Bits in the Debug Exception and Monitor Control Register and DWT_CTRL used to start the cycle counter. */
+#define DEMCR_TRCENA        (1 << 24)
+#define DWT_CTRL_CYCCNTENA  (1 << 0)
+#define DWT_CTRL_NOCYCCNT   (1 << 25)
+
 
 /* This structure contains the integer registers that are automatically stacked by Cortex-M processor when it enters
    an exception handler. */
@@ -103,14 +335,96 @@ typedef struct
 } FaultStatusRegisters;
 
 
+/* Layout of the CRASH_CATCHER_RECORD_BACKTRACE record, including its two word record header. */
+typedef struct
+{
+    uint32_t tag;
+    uint32_t payloadSize;
+    uint32_t excReturn;
+    uint32_t CFSR;
+    uint32_t HFSR;
+    uint32_t MMFAR;
+    uint32_t BFAR;
+    uint32_t pc;
+    uint32_t lr;
+    uint32_t sp;
+    uint32_t addressCount;
+    uint32_t addresses[CRASH_CATCHER_BACKTRACE_MAX_ADDRESSES];
+} CrashCatcherBacktraceRecord;
+
+/* Layout of the CRASH_CATCHER_RECORD_FAULT_CAUSE record, including its two word record header. */
+typedef struct
+{
+    uint32_t tag;
+    uint32_t payloadSize;
+    uint32_t cause;
+    uint32_t isAddressValid;
+    uint32_t address;
+} CrashCatcherFaultCauseRecord;
+
+/* Cycles spent on one memory region and the number of uncompressed bytes sent for it. */
+typedef struct
+{
+    uint32_t cycles;
+    uint32_t byteCount;
+} CrashCatcherRegionTiming;
+
+/* Layout of the CRASH_CATCHER_RECORD_TIMING record, including its two word record header. */
+typedef struct
+{
+    uint32_t                 tag;
+    uint32_t                 payloadSize;
+    uint32_t                 attempt;
+    uint32_t                 captureCycles;
+    uint32_t                 dumpStartCycles;
+    uint32_t                 previousDumpEndCycles;
+    uint32_t                 registerCycles;
+    uint32_t                 byteCount;
+    uint32_t                 regionCount;
+    CrashCatcherRegionTiming regions[CRASH_CATCHER_TIMING_MAX_REGIONS];
+} CrashCatcherTimingRecord;
+
+/* Layout of the CRASH_CATCHER_RECORD_STACK_USAGE record, including its two word record header. */
+typedef struct
+{
+    uint32_t tag;
+    uint32_t payloadSize;
+    uint32_t stackSize;
+    uint32_t usedSize;
+} CrashCatcherStackUsageRecord;
+
+/* Placed at the start of the buffer returned from CrashCatcher_GetRetainedBuffer() and followed by the size bytes of
+   the captured dump.  The signature is only written once the rest of the capture is complete.  The CRC32 covers
+   everything after the crc field, including the dump bytes, so that a buffer which was lost or only partly written
+   before the reset isn't mistaken for a dump. */
+#define CRASH_CATCHER_RETAINED_SIGNATURE 0x44526343 /* "CcRD" */
+
+typedef struct
+{
+    uint32_t         signature;
+    uint32_t         crc;
+    uint32_t         size;
+    uint32_t         droppedSize;
+    CrashCatcherInfo info;
+} CrashCatcherRetainedHeader;
+
+
 /* This is the area of memory that would normally be used for the stack when running on an actual Cortex-M
    processor.  Unit tests can write to this buffer to simulate stack overflow. */
 extern uint32_t g_crashCatcherStack[CRASH_CATCHER_STACK_WORD_COUNT];
 
+/* Most bytes of g_crashCatcherStack used since the last fault.  It is updated each time CrashCatcher_DumpEnd() returns
+   when stack usage is enabled so that a debugger or test harness can read it once CrashCatcher_Entry() is done. */
+extern uint32_t g_crashCatcherStackUsed;
+
 
 /* The main entry point into CrashCatcher.  Is called from the HardFault exception handler and unit tests. */
 void CrashCatcher_Entry(const CrashCatcherExceptionRegisters* pExceptionRegisters);
 
+/* Called by the compressor to send each compressed block to CrashCatcher_DumpMemory(), or to the retained buffer while
+   the dump is being captured into RAM. */
+void CrashCatcher_WriteMemory(const void* pvMemory, CrashCatcherElementSizes elementSize, size_t elementCount);
+
 /* Called from CrashCatcher core to copy all floating point registers to supplied buffer. The supplied buffer must be
    large enough to contain 33 32-bit values (S0-S31 & FPCSR). */
 void CrashCatcher_CopyAllFloatingPointRegisters(uint32_t* pBuffer);
@@ -0,0 +1,40 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Reflected CRC32 (polynomial 0xEDB88320) which processes a nibble at a time.  The 16 entry table only costs 64 bytes
+   of flash, compared to 1k for the more common byte at a time table, and is still fast enough to keep up with the
+   slowest part of the dump which is sending the data to the host. */
+#include "Crc32.h"
+
+
+static const uint32_t g_crc32Table[16] =
+{
+    0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+    0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+};
+
+
+uint32_t CrashCatcher_Crc32(uint32_t crc, const void* pvData, size_t size)
+{
+    const uint8_t* pData = (const uint8_t*)pvData;
+
+    crc = ~crc;
+    while (size-- > 0)
+    {
+        crc ^= *pData++;
+        crc = (crc >> 4) ^ g_crc32Table[crc & 0xF];
+        crc = (crc >> 4) ^ g_crc32Table[crc & 0xF];
+    }
+    return ~crc;
+}
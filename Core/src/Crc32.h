@@ -0,0 +1,28 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Private header for the software CRC32 used by the Core when CRASH_CATCHER_FLAGS_CRC32 is set. */
+#ifndef _CRASH_CATCHER_CRC32_H_
+#define _CRASH_CATCHER_CRC32_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+/* Returns the CRC32 of size bytes at pvData, continuing on from a crc previously returned by this function.  Pass in 0
+   for the first call.  Calculates the same value as zlib's crc32(). */
+uint32_t CrashCatcher_Crc32(uint32_t crc, const void* pvData, size_t size);
+
+
+#endif /* _CRASH_CATCHER_CRC32_H_ */
@@ -0,0 +1,156 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Copies the dump into a ring of staging buffers which are handed to CrashCatcher_StartTransfer() as each one fills.
+   Only one transfer is in flight at a time, and the Core carries on filling the other buffers while it is, so a DMA
+   capable transport is kept busy rather than the CPU sitting idle while each CrashCatcher_DumpMemory() call drains. */
+#include <string.h>
+#include "Pipeline.h"
+
+
+#if CRASH_CATCHER_PIPELINE_BUFFER_COUNT < 2
+    #error CRASH_CATCHER_PIPELINE_BUFFER_COUNT must be at least 2 for the buffers to be filled and sent in parallel.
+#endif
+#if (CRASH_CATCHER_PIPELINE_CACHE_LINE_SIZE & (CRASH_CATCHER_PIPELINE_CACHE_LINE_SIZE - 1)) != 0
+    #error CRASH_CATCHER_PIPELINE_CACHE_LINE_SIZE must be a power of 2.
+#endif
+
+/* Align each buffer to a cache line so that cleaning one buffer can't write back part of another. */
+#define CACHE_LINE_SIZE CRASH_CATCHER_PIPELINE_CACHE_LINE_SIZE
+#define BUFFER_SIZE     (((CRASH_CATCHER_PIPELINE_BUFFER_SIZE + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE) * \
+                         CACHE_LINE_SIZE)
+
+
+static uint8_t g_buffers[CRASH_CATCHER_PIPELINE_BUFFER_COUNT][BUFFER_SIZE] __attribute__((aligned(CACHE_LINE_SIZE)));
+static size_t  g_lengths[CRASH_CATCHER_PIPELINE_BUFFER_COUNT];
+/* Buffers from g_sendIndex up to, but not including, g_fillIndex are full and waiting to be sent, with the first of
+   them in flight when g_isTransferActive is set. */
+static size_t  g_sendIndex;
+static size_t  g_fillIndex;
+static size_t  g_queuedCount;
+static int     g_isTransferActive;
+
+
+static void   appendElement(const uint8_t* pElement, CrashCatcherElementSizes elementSize);
+static void   appendBytes(const void* pvBytes, size_t byteCount);
+static void   queueFilledBuffer(void);
+static void   pumpTransfers(void);
+static size_t nextIndex(size_t index);
+
+
+void CrashCatcher_PipelineStart(void)
+{
+    g_sendIndex = 0;
+    g_fillIndex = 0;
+    g_queuedCount = 0;
+    g_isTransferActive = 0;
+    g_lengths[0] = 0;
+}
+
+
+void CrashCatcher_PipelineMemory(const void* pvMemory, CrashCatcherElementSizes elementSize, size_t elementCount)
+{
+    const uint8_t* pMemory = (const uint8_t*)pvMemory;
+
+    /* Check on the transfer in flight each time so that the next buffer is started as soon as possible. */
+    pumpTransfers();
+    if (elementSize == CRASH_CATCHER_BYTE)
+    {
+        appendBytes(pMemory, elementCount);
+        return;
+    }
+    while (elementCount-- > 0)
+    {
+        appendElement(pMemory, elementSize);
+        pMemory += elementSize;
+    }
+}
+
+static void appendElement(const uint8_t* pElement, CrashCatcherElementSizes elementSize)
+{
+    /* Read halfwords and words with a single access of that size since they are likely to be peripheral registers. */
+    if (elementSize == CRASH_CATCHER_HALFWORD)
+    {
+        uint16_t val = *(const uint16_t*)pElement;
+        appendBytes(&val, sizeof(val));
+    }
+    else
+    {
+        uint32_t val = *(const uint32_t*)pElement;
+        appendBytes(&val, sizeof(val));
+    }
+}
+
+static void appendBytes(const void* pvBytes, size_t byteCount)
+{
+    const uint8_t* pBytes = (const uint8_t*)pvBytes;
+
+    while (byteCount > 0)
+    {
+        size_t length = g_lengths[g_fillIndex];
+        size_t bytesLeft = CRASH_CATCHER_PIPELINE_BUFFER_SIZE - length;
+        size_t bytesToCopy = byteCount < bytesLeft ? byteCount : bytesLeft;
+
+        memcpy(&g_buffers[g_fillIndex][length], pBytes, bytesToCopy);
+        g_lengths[g_fillIndex] = length + bytesToCopy;
+        pBytes += bytesToCopy;
+        byteCount -= bytesToCopy;
+        if (g_lengths[g_fillIndex] == CRASH_CATCHER_PIPELINE_BUFFER_SIZE)
+            queueFilledBuffer();
+    }
+}
+
+static void queueFilledBuffer(void)
+{
+    g_queuedCount++;
+    g_fillIndex = nextIndex(g_fillIndex);
+    pumpTransfers();
+    /* Only wait when every buffer is full or in flight. */
+    while (g_queuedCount == CRASH_CATCHER_PIPELINE_BUFFER_COUNT)
+        pumpTransfers();
+    g_lengths[g_fillIndex] = 0;
+}
+
+static void pumpTransfers(void)
+{
+    int isComplete = CrashCatcher_IsTransferComplete();
+
+    if (g_isTransferActive && isComplete)
+    {
+        g_isTransferActive = 0;
+        g_sendIndex = nextIndex(g_sendIndex);
+        g_queuedCount--;
+    }
+    if (!g_isTransferActive && g_queuedCount > 0)
+    {
+        if (CrashCatcher_CleanDataCache)
+            CrashCatcher_CleanDataCache(g_buffers[g_sendIndex], g_lengths[g_sendIndex]);
+        CrashCatcher_StartTransfer(g_buffers[g_sendIndex], g_lengths[g_sendIndex]);
+        g_isTransferActive = 1;
+    }
+}
+
+static size_t nextIndex(size_t index)
+{
+    return (index + 1) % CRASH_CATCHER_PIPELINE_BUFFER_COUNT;
+}
+
+
+void CrashCatcher_PipelineEnd(void)
+{
+    if (g_lengths[g_fillIndex] > 0)
+        queueFilledBuffer();
+    while (g_queuedCount > 0)
+        pumpTransfers();
+}
@@ -0,0 +1,38 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Private header for the staged transmit pipeline used when CRASH_CATCHER_PIPELINE_SUPPORT is set. */
+#ifndef _CRASH_CATCHER_PIPELINE_H_
+#define _CRASH_CATCHER_PIPELINE_H_
+
+#include <CrashCatcher.h>
+#include "CrashCatcherPriv.h"
+
+
+/* Implementations only need to provide these routines if they can send the dump in the background. */
+void CrashCatcher_StartTransfer(const void* pvBuffer, size_t size) __attribute__((weak));
+int  CrashCatcher_IsTransferComplete(void) __attribute__((weak));
+void CrashCatcher_CleanDataCache(const void* pvBuffer, size_t size) __attribute__((weak));
+
+/* Called after CrashCatcher_DumpStart() to empty the staging buffers. */
+void CrashCatcher_PipelineStart(void);
+
+/* Called instead of CrashCatcher_DumpMemory() for every part of the dump while the pipeline is in use. */
+void CrashCatcher_PipelineMemory(const void* pvMemory, CrashCatcherElementSizes elementSize, size_t elementCount);
+
+/* Called before CrashCatcher_DumpEnd() to send the last partly filled buffer and wait for every transfer to complete. */
+void CrashCatcher_PipelineEnd(void);
+
+
+#endif /* _CRASH_CATCHER_PIPELINE_H_ */
@@ -0,0 +1,175 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Captures the dump into a RAM buffer which survives a reset so that the device can be restarted within milliseconds
+   of a fault.  The application sends the captured dump through its usual dump routines once it is running again. */
+#include <stddef.h>
+#include <string.h>
+#include "Retained.h"
+#include "Crc32.h"
+
+
+static CrashCatcherRetainedHeader* g_pHeader;
+static size_t                      g_capacity;
+
+
+static CrashCatcherRetainedHeader* getRetainedHeader(size_t* pCapacity);
+static void                        appendElement(const uint8_t* pElement, CrashCatcherElementSizes elementSize);
+static void                        appendBytes(const void* pvBytes, size_t byteCount);
+static uint32_t                    calculateCrc32(const CrashCatcherRetainedHeader* pHeader);
+static int                         isRetainedDumpValid(const CrashCatcherRetainedHeader* pHeader, size_t capacity);
+
+
+int CrashCatcher_RetainedStart(const CrashCatcherInfo* pInfo)
+{
+    g_pHeader = getRetainedHeader(&g_capacity);
+    if (!g_pHeader)
+        return 0;
+    /* Clear the signature first so that a reset part way through the capture can't leave an earlier dump marked as
+       valid. */
+    g_pHeader->signature = 0;
+    g_pHeader->crc = 0;
+    g_pHeader->size = 0;
+    g_pHeader->droppedSize = 0;
+    g_pHeader->info = *pInfo;
+    return 1;
+}
+
+static CrashCatcherRetainedHeader* getRetainedHeader(size_t* pCapacity)
+{
+    CrashCatcherRetainedHeader* pHeader;
+    size_t                      size = 0;
+
+    if (!CrashCatcher_GetRetainedBuffer)
+        return NULL;
+    pHeader = (CrashCatcherRetainedHeader*)CrashCatcher_GetRetainedBuffer(&size);
+    if (!pHeader || size <= sizeof(*pHeader))
+        return NULL;
+    *pCapacity = size - sizeof(*pHeader);
+    return pHeader;
+}
+
+
+void CrashCatcher_RetainedBufferRange(uint32_t* pStartAddress, uint32_t* pEndAddress)
+{
+    uint32_t startAddress = (uint32_t)(unsigned long)g_pHeader;
+
+    *pStartAddress = startAddress;
+    *pEndAddress = startAddress + sizeof(*g_pHeader) + g_capacity;
+}
+
+
+void CrashCatcher_RetainedMemory(const void* pvMemory, CrashCatcherElementSizes elementSize, size_t elementCount)
+{
+    const uint8_t* pMemory = (const uint8_t*)pvMemory;
+
+    if (elementSize == CRASH_CATCHER_BYTE)
+    {
+        appendBytes(pMemory, elementCount);
+        return;
+    }
+    while (elementCount-- > 0)
+    {
+        appendElement(pMemory, elementSize);
+        pMemory += elementSize;
+    }
+}
+
+static void appendElement(const uint8_t* pElement, CrashCatcherElementSizes elementSize)
+{
+    /* Read halfwords and words with a single access of that size since they are likely to be peripheral registers. */
+    if (elementSize == CRASH_CATCHER_HALFWORD)
+    {
+        uint16_t val = *(const uint16_t*)pElement;
+        appendBytes(&val, sizeof(val));
+    }
+    else
+    {
+        uint32_t val = *(const uint32_t*)pElement;
+        appendBytes(&val, sizeof(val));
+    }
+}
+
+static void appendBytes(const void* pvBytes, size_t byteCount)
+{
+    size_t bytesLeft = g_capacity - g_pHeader->size;
+    size_t bytesToCopy = byteCount < bytesLeft ? byteCount : bytesLeft;
+
+    memcpy((uint8_t*)(g_pHeader + 1) + g_pHeader->size, pvBytes, bytesToCopy);
+    g_pHeader->size += bytesToCopy;
+    g_pHeader->droppedSize += byteCount - bytesToCopy;
+}
+
+
+void CrashCatcher_RetainedEnd(void)
+{
+    g_pHeader->crc = calculateCrc32(g_pHeader);
+    g_pHeader->signature = CRASH_CATCHER_RETAINED_SIGNATURE;
+}
+
+static uint32_t calculateCrc32(const CrashCatcherRetainedHeader* pHeader)
+{
+    size_t   offset = offsetof(CrashCatcherRetainedHeader, size);
+    uint32_t crc;
+
+    crc = CrashCatcher_Crc32(0, (const uint8_t*)pHeader + offset, sizeof(*pHeader) - offset);
+    return CrashCatcher_Crc32(crc, pHeader + 1, pHeader->size);
+}
+
+
+int CrashCatcher_HasRetainedDump(void)
+{
+    const CrashCatcherRetainedHeader* pHeader;
+    size_t                            capacity = 0;
+
+    pHeader = getRetainedHeader(&capacity);
+    return isRetainedDumpValid(pHeader, capacity);
+}
+
+static int isRetainedDumpValid(const CrashCatcherRetainedHeader* pHeader, size_t capacity)
+{
+    return pHeader &&
+           pHeader->signature == CRASH_CATCHER_RETAINED_SIGNATURE &&
+           pHeader->size <= capacity &&
+           pHeader->crc == calculateCrc32(pHeader);
+}
+
+int CrashCatcher_EmitRetainedDump(void)
+{
+    const CrashCatcherRetainedHeader* pHeader;
+    CrashCatcherInfo                  info;
+    size_t                            capacity = 0;
+
+    pHeader = getRetainedHeader(&capacity);
+    if (!isRetainedDumpValid(pHeader, capacity))
+        return 0;
+    info = pHeader->info;
+    info.isRetained = 1;
+    do
+    {
+        CrashCatcher_DumpStart(&info);
+        CrashCatcher_DumpMemory(pHeader + 1, CRASH_CATCHER_BYTE, pHeader->size);
+    }
+    while (CrashCatcher_DumpEnd() == CRASH_CATCHER_TRY_AGAIN);
+    return 1;
+}
+
+void CrashCatcher_DiscardRetainedDump(void)
+{
+    size_t                      capacity;
+    CrashCatcherRetainedHeader* pHeader = getRetainedHeader(&capacity);
+
+    if (pHeader)
+        pHeader->signature = 0;
+}
@@ -0,0 +1,42 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Private header for capturing the dump into the retained RAM buffer when CRASH_CATCHER_RETAINED_SUPPORT is set. */
+#ifndef _CRASH_CATCHER_RETAINED_H_
+#define _CRASH_CATCHER_RETAINED_H_
+
+#include <CrashCatcher.h>
+#include <stdint.h>
+#include "CrashCatcherPriv.h"
+
+
+/* Implementations only need to provide this routine if they want dumps to be captured into RAM. */
+void* CrashCatcher_GetRetainedBuffer(size_t* pSize) __attribute__((weak));
+
+/* Called before the dump is started to invalidate any earlier capture and record pInfo in the retained buffer's
+   header.  Returns 0 if the implementation doesn't provide a large enough buffer. */
+int  CrashCatcher_RetainedStart(const CrashCatcherInfo* pInfo);
+
+/* Fills in the start and end addresses of the retained buffer being captured into, in the same form as the addresses
+   of a CrashCatcherMemoryRegion, so that the Core can avoid dumping memory which the capture itself overwrites. */
+void CrashCatcher_RetainedBufferRange(uint32_t* pStartAddress, uint32_t* pEndAddress);
+
+/* Called instead of CrashCatcher_DumpMemory() for every part of the dump while it is being captured. */
+void CrashCatcher_RetainedMemory(const void* pvMemory, CrashCatcherElementSizes elementSize, size_t elementCount);
+
+/* Called at the end of the dump to fill in the CRC32 and signature which mark the capture as complete. */
+void CrashCatcher_RetainedEnd(void);
+
+
+#endif /* _CRASH_CATCHER_RETAINED_H_ */
@@ -0,0 +1,191 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include <stdint.h>
+#include <string.h>
+
+// Include headers from C modules under test.
+extern "C"
+{
+    #include <Compress.h>
+    #include <DumpMocks.h>
+    #include <Lz4Decoder.h>
+}
+
+// Include C++ headers for test harness.
+#include <CppUTest/TestHarness.h>
+
+
+TEST_GROUP(Compress)
+{
+    uint8_t m_input[1024];
+    uint8_t m_compressed[CRASH_CATCHER_COMPRESS_BOUND(1024)];
+    uint8_t m_decompressed[1024];
+    size_t  m_compressedSize;
+
+    void setup()
+    {
+        DumpMocks_Init();
+        memset(m_input, 0, sizeof(m_input));
+        memset(m_decompressed, 0xFF, sizeof(m_decompressed));
+        m_compressedSize = 0;
+    }
+
+    void teardown()
+    {
+        DumpMocks_Uninit();
+    }
+
+    void fillInputWithPseudoRandomBytes(size_t size)
+    {
+        uint32_t seed = 0x12345678;
+        for (size_t i = 0 ; i < size ; i++)
+        {
+            seed = seed * 1103515245 + 12345;
+            m_input[i] = seed >> 24;
+        }
+    }
+
+    void compressAndValidateRoundTrip(size_t size)
+    {
+        m_compressedSize = CrashCatcher_CompressBlock(m_input, size, m_compressed);
+        CHECK_TRUE(m_compressedSize <= CRASH_CATCHER_COMPRESS_BOUND(size));
+        CHECK_EQUAL((long)size, Lz4Decoder_DecodeBlock(m_compressed, m_compressedSize, m_decompressed, size));
+        CHECK_TRUE(0 == memcmp(m_input, m_decompressed, size));
+    }
+
+    size_t decompressDumpedBlocks()
+    {
+        uint8_t dumped[2048];
+        size_t  dumpedSize = DumpMocks_CopyDumpedBytes(0, dumped, sizeof(dumped));
+        long    decompressedSize = Lz4Decoder_DecodeStream(dumped, dumpedSize, m_decompressed, sizeof(m_decompressed));
+        CHECK_TRUE(decompressedSize >= 0);
+        return decompressedSize;
+    }
+};
+
+
+TEST(Compress, CompressBlock_Empty_ShouldBeSingleEmptyToken)
+{
+    compressAndValidateRoundTrip(0);
+    CHECK_EQUAL(1, m_compressedSize);
+    CHECK_EQUAL(0x00, m_compressed[0]);
+}
+
+TEST(Compress, CompressBlock_12Zeroes_TooShortForMatches_ShouldOnlyContainLiterals)
+{
+    compressAndValidateRoundTrip(12);
+    CHECK_EQUAL(1 + 12, m_compressedSize);
+    CHECK_EQUAL(0xC0, m_compressed[0]);
+}
+
+TEST(Compress, CompressBlock_13Zeroes_ShouldUseOneMatch)
+{
+    compressAndValidateRoundTrip(13);
+    CHECK_TRUE(m_compressedSize < 13);
+}
+
+TEST(Compress, CompressBlock_256Zeroes_ShouldCompressWell)
+{
+    compressAndValidateRoundTrip(256);
+    CHECK_TRUE(m_compressedSize <= 16);
+}
+
+TEST(Compress, CompressBlock_1024Zeroes_ShouldUseExtendedMatchLength)
+{
+    compressAndValidateRoundTrip(1024);
+    CHECK_TRUE(m_compressedSize <= 20);
+}
+
+TEST(Compress, CompressBlock_RepeatingFillWord_ShouldCompressWell)
+{
+    for (size_t i = 0 ; i < 256 ; i += 4)
+    {
+        m_input[i + 0] = 0xEF;
+        m_input[i + 1] = 0xBE;
+        m_input[i + 2] = 0xAD;
+        m_input[i + 3] = 0xDE;
+    }
+    compressAndValidateRoundTrip(256);
+    CHECK_TRUE(m_compressedSize <= 20);
+}
+
+TEST(Compress, CompressBlock_Incompressible_ShouldUseExtendedLiteralLengthAndStayWithinBound)
+{
+    fillInputWithPseudoRandomBytes(1024);
+    compressAndValidateRoundTrip(1024);
+}
+
+TEST(Compress, CompressBlock_MixOfRandomAndZeroes_ShouldRoundTrip)
+{
+    fillInputWithPseudoRandomBytes(100);
+    memset(&m_input[100], 0, 300);
+    compressAndValidateRoundTrip(512);
+    CHECK_TRUE(m_compressedSize < 250);
+}
+
+TEST(Compress, CompressMemory_LessThanOneBlock_ShouldNotDumpUntilEnd)
+{
+    CrashCatcher_CompressStart();
+    CrashCatcher_CompressMemory(m_input, CRASH_CATCHER_BYTE, 16);
+    CHECK_EQUAL(0, DumpMocks_GetDumpMemoryCallCount());
+    CrashCatcher_CompressEnd();
+    CHECK_EQUAL(1, DumpMocks_GetDumpMemoryCallCount());
+    CHECK_EQUAL(16, decompressDumpedBlocks());
+    CHECK_TRUE(0 == memcmp(m_input, m_decompressed, 16));
+}
+
+TEST(Compress, CompressMemory_NothingWritten_ShouldNotDumpAnything)
+{
+    CrashCatcher_CompressStart();
+    CrashCatcher_CompressEnd();
+    CHECK_EQUAL(0, DumpMocks_GetDumpMemoryCallCount());
+}
+
+TEST(Compress, CompressMemory_SpanMultipleBlocks_ShouldDumpIndependentBlocks)
+{
+    fillInputWithPseudoRandomBytes(600);
+    CrashCatcher_CompressStart();
+    CrashCatcher_CompressMemory(m_input, CRASH_CATCHER_BYTE, 100);
+    CrashCatcher_CompressMemory(&m_input[100], CRASH_CATCHER_BYTE, 500);
+    CHECK_EQUAL(600 / CRASH_CATCHER_COMPRESSION_BLOCK_SIZE, DumpMocks_GetDumpMemoryCallCount());
+    CrashCatcher_CompressEnd();
+    CHECK_EQUAL(600 / CRASH_CATCHER_COMPRESSION_BLOCK_SIZE + 1, DumpMocks_GetDumpMemoryCallCount());
+    CHECK_EQUAL(600, decompressDumpedBlocks());
+    CHECK_TRUE(0 == memcmp(m_input, m_decompressed, 600));
+}
+
+TEST(Compress, CompressMemory_HalfwordsAndWords_ShouldReadEachElementAndRoundTrip)
+{
+    const uint16_t halfwords[3] = {0x1122, 0x3344, 0x5566};
+    const uint32_t words[2] = {0x778899AA, 0xBBCCDDEE};
+    CrashCatcher_CompressStart();
+    CrashCatcher_CompressMemory(halfwords, CRASH_CATCHER_HALFWORD, 3);
+    CrashCatcher_CompressMemory(words, CRASH_CATCHER_WORD, 2);
+    CrashCatcher_CompressEnd();
+    CHECK_EQUAL(sizeof(halfwords) + sizeof(words), decompressDumpedBlocks());
+    CHECK_TRUE(0 == memcmp(halfwords, m_decompressed, sizeof(halfwords)));
+    CHECK_TRUE(0 == memcmp(words, &m_decompressed[sizeof(halfwords)], sizeof(words)));
+}
+
+TEST(Compress, CompressMemory_BlockHeader_ShouldContainCompressedAndUncompressedSizes)
+{
+    uint8_t dumped[64];
+    CrashCatcher_CompressStart();
+    CrashCatcher_CompressMemory(m_input, CRASH_CATCHER_BYTE, 20);
+    CrashCatcher_CompressEnd();
+    size_t dumpedSize = DumpMocks_CopyDumpedBytes(0, dumped, sizeof(dumped));
+    CHECK_EQUAL(dumpedSize - CRASH_CATCHER_COMPRESS_BLOCK_HEADER_SIZE, (size_t)(dumped[0] | (dumped[1] << 8)));
+    CHECK_EQUAL(20, dumped[2] | (dumped[3] << 8));
+}
@@ -13,6 +13,7 @@
    limitations under the License.
 */
 #include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 
 // Include headers from C modules under test.
@@ -21,7 +22,10 @@ extern "C"
     #include <CrashCatcher.h>
     #include <CrashCatcherPriv.h>
     #include <DumpMocks.h>
+    #include <DmaSim.h>
     #include <FloatMocks.h>
+    #include <Crc32.h>
+    #include <Lz4Decoder.h>
 
     // Provides the upper 32-bits of 64-bit pointer addresses.
     // When running unit tests on 64-bit machines, the 32-bit emulated PSP an MSP stack pointer addresses don't
@@ -36,6 +40,71 @@ extern "C"
 
     // The unit tests can point the core to a fake location for the Coprocessor Access Control Register.
     extern uint32_t* g_pCrashCatcherCoprocessorAccessControlRegister;
+
+    // The unit tests can disable the features which CRASH_CATCHER_MIN_FOOTPRINT compiles out at runtime.
+    extern int g_crashCatcherEnableIsBKPT;
+    extern int g_crashCatcherEnableFloatingPoint;
+    extern int g_crashCatcherEnableFaultStatus;
+    extern int g_crashCatcherEnableFaultCause;
+    extern int g_crashCatcherEnableStackSentinel;
+
+    // The unit tests can enable compression of the dump at runtime.
+    extern int g_crashCatcherEnableCompression;
+
+    // The unit tests can enable elision of repeated word runs in memory regions at runtime.
+    extern int g_crashCatcherEnableRunElision;
+
+    // The unit tests can enable skipping of free heap memory at runtime.
+    extern int g_crashCatcherEnableHeapWalk;
+
+    // The unit tests can enable skipping of unchanged load image blocks at runtime.
+    extern int g_crashCatcherEnableLoadImage;
+
+    // The unit tests can point the core to a fake location for the Vector Table Offset Register.
+    extern uint32_t* g_pCrashCatcherVectorTableOffsetRegister;
+
+    // The unit tests can enable minidumps at runtime.
+    extern int g_crashCatcherEnableMinidump;
+
+    // The unit tests can enable the CRC32 trailer at runtime.
+    extern int g_crashCatcherEnableCrc32;
+
+    // The unit tests can enable vectored dumping of the registers at runtime.
+    extern int g_crashCatcherEnableVectoredDump;
+
+    // The unit tests can enable the backtrace record at runtime.
+    extern int g_crashCatcherEnableBacktrace;
+
+    // The unit tests can change the range of addresses which the backtrace scan treats as code.
+    extern uint32_t g_crashCatcherCodeStart;
+    extern uint32_t g_crashCatcherCodeEnd;
+
+    // The unit tests can enable the two tier layout and shrink the amount of stack sent in tier 1 at runtime.
+    extern int g_crashCatcherEnableTwoTier;
+    extern uint32_t g_crashCatcherTier1StackSize;
+
+    // The unit tests can enable capturing of the dump into the retained buffer at runtime.
+    extern int g_crashCatcherEnableRetained;
+
+    // The unit tests can point the core to a fake location for the Application Interrupt and Reset Control Register and
+    // stop it from waiting for the reset to happen.
+    extern uint32_t* g_pCrashCatcherApplicationInterruptResetControlRegister;
+    extern int g_crashCatcherWaitForReset;
+
+    // The unit tests can enable the staged transmit pipeline at runtime.
+    extern int g_crashCatcherEnablePipeline;
+
+    // The unit tests can enable the timing record at runtime.
+    extern int g_crashCatcherEnableTiming;
+
+    // The unit tests can point the core to fake locations for the Debug Exception and Monitor Control Register and the
+    // DWT_CTRL and DWT_CYCCNT registers.
+    extern uint32_t* g_pCrashCatcherDebugExceptionMonitorControlRegister;
+    extern uint32_t* g_pCrashCatcherDwtControlRegister;
+    extern uint32_t* g_pCrashCatcherCycleCounter;
+
+    // The unit tests can enable the stack usage record at runtime.
+    extern int g_crashCatcherEnableStackUsage;
 }
 
 
@@ -51,6 +120,19 @@ static const uint32_t cpuIdCortexM3 = 0x410FC230;
 #define NOP_INSTRUCTION     0xBF00
 #define BKPT_INSTRUCTION    0xBE00
 
+#define CODE_START          0x08000000
+#define CODE_END            0x08100000
+#define EXC_RETURN_MSP      0xFFFFFFF9
+#define EXC_RETURN_PSP      0xFFFFFFFD
+#define STACKED_PSR         0x01000000
+
+// Signature, flags and the integer registers.
+#define REGISTER_DUMP_SIZE  (4 + 4 + 20 * 4)
+// Cycles charged by the dump mocks when timing is enabled.
+#define DUMP_START_CYCLES   100
+#define CYCLES_PER_BYTE     3
+#define DUMP_END_CYCLES     50
+
 // Include C++ headers for test harness.
 #include <CppUTest/TestHarness.h>
 
@@ -59,8 +141,10 @@ TEST_GROUP(CrashCatcher)
 {
     CrashCatcherExceptionRegisters m_exceptionRegisters;
     uint32_t                       m_expectedFlags;
-    uint32_t                       m_emulatedPSP[8];
+    uint32_t                       m_emulatedPSP[8 + 4];
     uint32_t                       m_emulatedMSP[8 + 16 + 1];
+    uint32_t                       m_emulatedVectorTable[2];
+    uint32_t                       m_emulatedVectorTableOffsetRegister;
     uint32_t                       m_emulatedCpuId;
     FaultStatusRegisters           m_emulatedFaultStatusRegisters;
     uint32_t                       m_emulatedCoprocessorAccessControlRegister;
@@ -72,6 +156,18 @@ TEST_GROUP(CrashCatcher)
     uint16_t                       m_emulatedInstruction;
     uint8_t                        m_expectedBkptValue;
     uint8_t                        m_memory[16];
+    uint32_t                       m_fillMemory[32];
+    uint32_t                       m_fillMemoryStart;
+    uint32_t                       m_loadImage[32];
+    uint32_t                       m_loadImageStart;
+    uint32_t                       m_retainedBuffer[128];
+    uint32_t                       m_emulatedResetControlRegister;
+    int                            m_expectedIsRetained;
+    bool                           m_isDumpStartExpected;
+    uint8_t                        m_pipelineMemory[1024];
+    uint32_t                       m_emulatedDebugExceptionMonitorControlRegister;
+    uint32_t                       m_emulatedDwtControlRegister;
+    uint32_t                       m_emulatedCycleCounter;
 
     void setup()
     {
@@ -84,6 +180,36 @@ TEST_GROUP(CrashCatcher)
         initCpuId();
         initFaultStatusRegisters();
         initFloatingPoint();
+        initVectorTable();
+        g_crashCatcherEnableIsBKPT = 1;
+        g_crashCatcherEnableFloatingPoint = 1;
+        g_crashCatcherEnableFaultStatus = 1;
+        g_crashCatcherEnableFaultCause = 1;
+        g_crashCatcherEnableStackSentinel = 1;
+        g_crashCatcherEnableCompression = 0;
+        g_crashCatcherEnableRunElision = 0;
+        g_crashCatcherEnableHeapWalk = 0;
+        g_crashCatcherEnableLoadImage = 0;
+        g_crashCatcherEnableMinidump = 0;
+        g_crashCatcherEnableCrc32 = 0;
+        g_crashCatcherEnableVectoredDump = 0;
+        g_crashCatcherEnableBacktrace = 0;
+        g_crashCatcherCodeStart = CODE_START;
+        g_crashCatcherCodeEnd = CODE_END;
+        g_crashCatcherEnableTwoTier = 0;
+        g_crashCatcherTier1StackSize = CRASH_CATCHER_TIER1_STACK_SIZE;
+        g_crashCatcherEnableRetained = 0;
+        memset(m_retainedBuffer, 0, sizeof(m_retainedBuffer));
+        m_emulatedResetControlRegister = 0;
+        m_expectedIsRetained = 0;
+        m_isDumpStartExpected = true;
+        g_pCrashCatcherApplicationInterruptResetControlRegister = &m_emulatedResetControlRegister;
+        g_crashCatcherWaitForReset = 0;
+        g_crashCatcherEnablePipeline = 0;
+        DmaSim_Init(0, 0);
+        initCycleCounter();
+        g_crashCatcherEnableStackUsage = 0;
+        memset(g_crashCatcherStack, 0, sizeof(g_crashCatcherStack));
         if (sizeof(int*) == sizeof(uint64_t))
             g_crashCatcherTestBaseAddress = (uint64_t)&m_emulatedPSP & 0xFFFFFFFF00000000ULL;
     }
@@ -149,6 +275,22 @@ TEST_GROUP(CrashCatcher)
         for (size_t i = 0 ; i < sizeof(m_memory) ; i++)
             m_memory[i]= i;
         m_memoryStart = (uint32_t)(unsigned long)m_memory;
+        for (size_t i = 0 ; i < sizeof(m_fillMemory)/sizeof(m_fillMemory[0]) ; i++)
+            m_fillMemory[i] = 0x11111111 * (i & 0xF);
+        m_fillMemoryStart = (uint32_t)(unsigned long)m_fillMemory;
+        memcpy(m_loadImage, m_fillMemory, sizeof(m_loadImage));
+        m_loadImageStart = (uint32_t)(unsigned long)m_loadImage;
+    }
+
+    void fillWords(size_t startIndex, size_t count, uint32_t fillWord)
+    {
+        for (size_t i = startIndex ; i < startIndex + count ; i++)
+            m_fillMemory[i] = fillWord;
+    }
+
+    static uint32_t segmentHeader(uint32_t type, uint32_t length)
+    {
+        return (type << CRASH_CATCHER_SEGMENT_TYPE_SHIFT) | length;
     }
 
     void initCpuId()
@@ -175,9 +317,31 @@ TEST_GROUP(CrashCatcher)
         m_expectedFloatingPointRegisters[32] = 0x12345678;
     }
 
+    void initVectorTable()
+    {
+        m_emulatedVectorTable[0] = (uint32_t)(unsigned long)&m_emulatedMSP[8 + 16 + 1];
+        m_emulatedVectorTable[1] = 0x00000101;
+        m_emulatedVectorTableOffsetRegister = (uint32_t)(unsigned long)m_emulatedVectorTable;
+        g_pCrashCatcherVectorTableOffsetRegister = &m_emulatedVectorTableOffsetRegister;
+    }
+
+    void initCycleCounter()
+    {
+        g_crashCatcherEnableTiming = 0;
+        m_emulatedDebugExceptionMonitorControlRegister = 0;
+        m_emulatedDwtControlRegister = 0;
+        // Start close to the top so that the core has to handle the count wrapping around.
+        m_emulatedCycleCounter = 0xFFFFFF00;
+        g_pCrashCatcherDebugExceptionMonitorControlRegister = &m_emulatedDebugExceptionMonitorControlRegister;
+        g_pCrashCatcherDwtControlRegister = &m_emulatedDwtControlRegister;
+        g_pCrashCatcherCycleCounter = &m_emulatedCycleCounter;
+        DumpMocks_SetCycleCounter(&m_emulatedCycleCounter, DUMP_START_CYCLES, CYCLES_PER_BYTE, DUMP_END_CYCLES);
+    }
+
     void teardown()
     {
-        validateDumpStartInfo();
+        if (m_isDumpStartExpected)
+            validateDumpStartInfo();
         DumpMocks_Uninit();
     }
 
@@ -213,17 +377,160 @@ TEST_GROUP(CrashCatcher)
         // Need to handle the fact that the PC on stack might have been advanced past a hardcoded breakpoint but the
         // dump would contain the original value at the time of the crash.
         uint32_t  registersLR_PC_XPSR[3] = { pSP[5], (uint32_t)(unsigned long)&m_emulatedInstruction, pSP[7] };
+        // The backtrace record goes between the flags and the registers.
+        uint32_t  i = (m_expectedFlags & CRASH_CATCHER_FLAGS_BACKTRACE) ? 3 : 2;
 
         CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(0, g_expectedSignature, CRASH_CATCHER_BYTE, sizeof(g_expectedSignature)));
         CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(1, &m_expectedFlags, CRASH_CATCHER_BYTE, sizeof(m_expectedFlags)));
-        CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(2, &pSP[0], CRASH_CATCHER_BYTE, 4 * sizeof(uint32_t)));
-        CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(3, &m_exceptionRegisters.r4, CRASH_CATCHER_BYTE, (11 - 4 + 1) * sizeof(uint32_t)));
-        CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(4, &pSP[4], CRASH_CATCHER_BYTE, sizeof(uint32_t)));
-        CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(5, &m_expectedSP, CRASH_CATCHER_BYTE, sizeof(uint32_t)));
-        CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(6, &registersLR_PC_XPSR[0], CRASH_CATCHER_BYTE, 3 * sizeof(uint32_t)));
-        CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(7, &m_exceptionRegisters.msp, CRASH_CATCHER_BYTE, 3 * sizeof(uint32_t)));
+        CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(i, &pSP[0], CRASH_CATCHER_BYTE, 4 * sizeof(uint32_t)));
+        CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(i + 1, &m_exceptionRegisters.r4, CRASH_CATCHER_BYTE, (11 - 4 + 1) * sizeof(uint32_t)));
+        CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(i + 2, &pSP[4], CRASH_CATCHER_BYTE, sizeof(uint32_t)));
+        CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(i + 3, &m_expectedSP, CRASH_CATCHER_BYTE, sizeof(uint32_t)));
+        CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(i + 4, &registersLR_PC_XPSR[0], CRASH_CATCHER_BYTE, 3 * sizeof(uint32_t)));
+        CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(i + 5, &m_exceptionRegisters.msp, CRASH_CATCHER_BYTE, 3 * sizeof(uint32_t)));
         if (m_expectedFlags & CRASH_CATCHER_FLAGS_FLOATING_POINT)
-            CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(8, m_expectedFloatingPointRegisters, CRASH_CATCHER_BYTE, sizeof(m_expectedFloatingPointRegisters)));
+            CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(i + 6, m_expectedFloatingPointRegisters, CRASH_CATCHER_BYTE, sizeof(m_expectedFloatingPointRegisters)));
+    }
+
+    // Copies words onto the emulated MSP just above the exception frame stacked for the fault.
+    void setMSPWords(const uint32_t* pWords, size_t count)
+    {
+        memset(&m_emulatedMSP[8], 0, (16 + 1) * sizeof(uint32_t));
+        memcpy(&m_emulatedMSP[8], pWords, count * sizeof(uint32_t));
+    }
+
+    void initExpectedBacktrace(CrashCatcherBacktraceRecord* pRecord, const uint32_t* pAddresses, uint32_t addressCount)
+    {
+        memset(pRecord, 0, sizeof(*pRecord));
+        pRecord->tag = CRASH_CATCHER_RECORD_TAG(CRASH_CATCHER_RECORD_BACKTRACE);
+        pRecord->payloadSize = sizeof(*pRecord) - 2 * sizeof(uint32_t);
+        pRecord->excReturn = m_exceptionRegisters.exceptionLR;
+        pRecord->pc = (uint32_t)(unsigned long)&m_emulatedInstruction;
+        pRecord->lr = m_emulatedMSP[5];
+        pRecord->sp = m_expectedSP;
+        pRecord->addressCount = addressCount;
+        memcpy(pRecord->addresses, pAddresses, addressCount * sizeof(uint32_t));
+    }
+
+    void validateBacktrace(const uint32_t* pAddresses, uint32_t addressCount, uint32_t item = 2)
+    {
+        CrashCatcherBacktraceRecord expectedRecord;
+
+        initExpectedBacktrace(&expectedRecord, pAddresses, addressCount);
+        m_expectedFlags |= CRASH_CATCHER_FLAGS_BACKTRACE;
+        CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(item, &expectedRecord, CRASH_CATCHER_BYTE, sizeof(expectedRecord)));
+    }
+
+    void validateCrc32Trailer(uint32_t firstItem, const uint32_t* pRegionCrcs, uint32_t regionCrcCount)
+    {
+        uint8_t  dumpedBytes[512];
+        size_t   dumpedSize = DumpMocks_CopyDumpedBytes(0, dumpedBytes, sizeof(dumpedBytes));
+        uint32_t recordHeader[2] = { CRASH_CATCHER_RECORD_TAG(CRASH_CATCHER_RECORD_CRC32),
+                                     (regionCrcCount + 2) * (uint32_t)sizeof(uint32_t) };
+        uint32_t dumpCrc = CrashCatcher_Crc32(0, dumpedBytes, dumpedSize - sizeof(uint32_t));
+
+        CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(firstItem, recordHeader, CRASH_CATCHER_BYTE, sizeof(recordHeader)));
+        CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(firstItem + 1, pRegionCrcs, CRASH_CATCHER_BYTE,
+                                                  regionCrcCount * sizeof(uint32_t)));
+        CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(firstItem + 2, &regionCrcCount, CRASH_CATCHER_BYTE, sizeof(regionCrcCount)));
+        CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(firstItem + 3, &dumpCrc, CRASH_CATCHER_BYTE, sizeof(dumpCrc)));
+    }
+
+    void validateFaultCause(uint32_t item, uint32_t cause, uint32_t isAddressValid, uint32_t address)
+    {
+        CrashCatcherFaultCauseRecord expectedRecord = { CRASH_CATCHER_RECORD_TAG(CRASH_CATCHER_RECORD_FAULT_CAUSE),
+                                                        3 * sizeof(uint32_t), cause, isAddressValid, address };
+
+        CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(item, &expectedRecord, CRASH_CATCHER_BYTE, sizeof(expectedRecord)));
+    }
+
+    void enableTiming()
+    {
+        m_emulatedCpuId = cpuIdCortexM3;
+        g_crashCatcherEnableTiming = 1;
+        m_expectedFlags |= CRASH_CATCHER_FLAGS_TIMING;
+    }
+
+    // Fills in the record expected for a dump of just the registers and the given regions.  The fault status registers
+    // are the last region on a Cortex-M3.
+    static void initExpectedTiming(CrashCatcherTimingRecord* pRecord, uint32_t attempt,
+                                   const uint32_t* pRegionSizes, uint32_t regionCount)
+    {
+        memset(pRecord, 0, sizeof(*pRecord));
+        pRecord->tag = CRASH_CATCHER_RECORD_TAG(CRASH_CATCHER_RECORD_TIMING);
+        pRecord->payloadSize = sizeof(*pRecord) - 2 * sizeof(uint32_t);
+        pRecord->attempt = attempt;
+        pRecord->dumpStartCycles = DUMP_START_CYCLES;
+        pRecord->previousDumpEndCycles = attempt > 1 ? DUMP_END_CYCLES : 0;
+        pRecord->registerCycles = REGISTER_DUMP_SIZE * CYCLES_PER_BYTE;
+        pRecord->byteCount = REGISTER_DUMP_SIZE;
+        for (uint32_t i = 0 ; i < regionCount ; i++)
+        {
+            uint32_t byteCount = 2 * sizeof(uint32_t) + pRegionSizes[i];
+
+            if (i < CRASH_CATCHER_TIMING_MAX_REGIONS)
+            {
+                pRecord->regions[i].cycles = byteCount * CYCLES_PER_BYTE;
+                pRecord->regions[i].byteCount = byteCount;
+                pRecord->regionCount++;
+            }
+            pRecord->byteCount += byteCount;
+        }
+    }
+
+    void validateTiming(uint32_t item, const CrashCatcherTimingRecord* pExpectedRecord)
+    {
+        CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(item, pExpectedRecord, CRASH_CATCHER_BYTE, sizeof(*pExpectedRecord)));
+    }
+
+    void enableStackUsage()
+    {
+        g_crashCatcherEnableStackUsage = 1;
+        m_expectedFlags |= CRASH_CATCHER_FLAGS_STACK_USAGE;
+    }
+
+    void validateStackUsage(uint32_t item, uint32_t usedSize)
+    {
+        CrashCatcherStackUsageRecord expectedRecord = { CRASH_CATCHER_RECORD_TAG(CRASH_CATCHER_RECORD_STACK_USAGE),
+                                                        2 * sizeof(uint32_t), sizeof(g_crashCatcherStack), usedSize };
+        CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(item, &expectedRecord, CRASH_CATCHER_BYTE, sizeof(expectedRecord)));
+    }
+
+    void validateTierEnd(uint32_t item, uint32_t tier, uint32_t dumpCrc)
+    {
+        uint32_t expectedRecord[4] = { CRASH_CATCHER_RECORD_TAG(CRASH_CATCHER_RECORD_TIER_END), 2 * sizeof(uint32_t),
+                                       tier, dumpCrc };
+
+        CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(item, expectedRecord, CRASH_CATCHER_BYTE, sizeof(expectedRecord)));
+    }
+
+    void validateStackRegion(uint32_t item, const uint32_t* pStart, const uint32_t* pEnd)
+    {
+        CrashCatcherMemoryRegion stackRegion = { (uint32_t)(unsigned long)pStart, (uint32_t)(unsigned long)pEnd,
+                                                 CRASH_CATCHER_BYTE };
+
+        CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(item, &stackRegion, CRASH_CATCHER_BYTE, 2 * sizeof(uint32_t)));
+        CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(item + 1, pStart, CRASH_CATCHER_BYTE,
+                                                  (pEnd - pStart) * sizeof(uint32_t)));
+    }
+
+    // Dumps with two tiers on a Cortex-M3 with no memory regions so that the fault cause record is always item 10.
+    void emulateCortexM3TwoTierFault(uint32_t CFSR, uint32_t HFSR)
+    {
+        m_emulatedCpuId = cpuIdCortexM3;
+        m_emulatedFaultStatusRegisters.CFSR = CFSR;
+        m_emulatedFaultStatusRegisters.HFSR = HFSR;
+        m_emulatedFaultStatusRegisters.MMFAR = 0x33333333;
+        m_emulatedFaultStatusRegisters.BFAR = 0x44444444;
+        g_crashCatcherEnableTwoTier = 1;
+        CrashCatcher_Entry(&m_exceptionRegisters);
+        CHECK_EQUAL(15, DumpMocks_GetDumpMemoryCallCount());
+    }
+
+    static uint32_t regionCrc32(const CrashCatcherMemoryRegion* pRegion, const void* pvData)
+    {
+        uint32_t crc = CrashCatcher_Crc32(0, pRegion, 2 * sizeof(uint32_t));
+        return CrashCatcher_Crc32(crc, pvData, pRegion->endAddress - pRegion->startAddress);
     }
 
     void validateDumpStartInfo()
@@ -233,6 +540,79 @@ TEST_GROUP(CrashCatcher)
         CHECK_EQUAL(m_expectedSP, pInfo->sp);
         CHECK_EQUAL(m_expectedIsBKPT, pInfo->isBKPT);
         CHECK_EQUAL(m_expectedBkptValue, pInfo->bkptNumber);
+        CHECK_EQUAL(m_expectedIsRetained, pInfo->isRetained);
+    }
+
+    void captureRetainedDump(size_t bufferSize = sizeof(m_retainedBuffer))
+    {
+        DumpMocks_SetRetainedBuffer(m_retainedBuffer, bufferSize);
+        g_crashCatcherEnableRetained = 1;
+        CrashCatcher_Entry(&m_exceptionRegisters);
+        g_crashCatcherEnableRetained = 0;
+        m_isDumpStartExpected = false;
+    }
+
+    void emitRetainedDump()
+    {
+        CHECK_TRUE(CrashCatcher_EmitRetainedDump());
+        m_expectedIsRetained = 1;
+        m_isDumpStartExpected = true;
+    }
+
+    CrashCatcherRetainedHeader* retainedHeader()
+    {
+        return (CrashCatcherRetainedHeader*)m_retainedBuffer;
+    }
+
+    void setPipelineMemoryRegions(CrashCatcherMemoryRegion* pRegions, size_t regionCount)
+    {
+        uint32_t start = (uint32_t)(unsigned long)m_pipelineMemory;
+        uint32_t regionSize = sizeof(m_pipelineMemory) / regionCount;
+
+        for (size_t i = 0 ; i < sizeof(m_pipelineMemory) ; i++)
+            m_pipelineMemory[i] = i * 13 + (i >> 8);
+        for (size_t i = 0 ; i < regionCount ; i++)
+        {
+            pRegions[i].startAddress = start + i * regionSize;
+            pRegions[i].endAddress = start + (i + 1) * regionSize;
+            pRegions[i].elementSize = CRASH_CATCHER_BYTE;
+        }
+        pRegions[regionCount].startAddress = 0xFFFFFFFF;
+        pRegions[regionCount].endAddress = 0xFFFFFFFF;
+        DumpMocks_SetMemoryRegions(pRegions);
+    }
+
+    // Sends the same crash through the regular dump routines and checks that the pipelined dump matched it.  Returns
+    // the number of CrashCatcher_DumpMemory() calls made by the regular dump.
+    uint32_t validatePipelinedDumpMatchesRegularDump()
+    {
+        uint8_t  regular[2048];
+        uint32_t firstItem = DumpMocks_GetDumpMemoryCallCount();
+        size_t   regularSize;
+
+        g_crashCatcherEnablePipeline = 0;
+        CrashCatcher_Entry(&m_exceptionRegisters);
+        regularSize = DumpMocks_CopyDumpedBytes(firstItem, regular, sizeof(regular));
+        CHECK_EQUAL(regularSize, DmaSim_GetDataSize());
+        MEMCMP_EQUAL(regular, DmaSim_GetData(), regularSize);
+        return DumpMocks_GetDumpMemoryCallCount() - firstItem;
+    }
+
+    // Sends the same crash through the regular dump routines and checks that the emitted retained dump matched it.
+    void validateEmittedDumpMatchesRegularDump(size_t emittedSize)
+    {
+        uint8_t  emitted[512];
+        uint8_t  regular[512];
+        uint32_t firstItem;
+        size_t   regularSize;
+
+        CHECK_EQUAL(emittedSize, DumpMocks_CopyDumpedBytes(0, emitted, sizeof(emitted)));
+        firstItem = DumpMocks_GetDumpMemoryCallCount();
+        m_expectedIsRetained = 0;
+        CrashCatcher_Entry(&m_exceptionRegisters);
+        regularSize = DumpMocks_CopyDumpedBytes(firstItem, regular, sizeof(regular));
+        CHECK_TRUE(emittedSize <= regularSize);
+        MEMCMP_EQUAL(regular, emitted, emittedSize);
     }
 };
 
@@ -301,6 +681,40 @@ TEST(CrashCatcher, DumpEndReturnTryAgainOnce_ShouldDumpTwice)
     CHECK_EQUAL(2, DumpMocks_GetDumpEndCallCount());
 }
 
+TEST(CrashCatcher, DumpRegistersOnly_ShouldPassFaultSignatureToDumpStart)
+{
+    uint32_t expectedPC = m_emulatedMSP[6];
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    CHECK_EQUAL(expectedPC, DumpMocks_GetDumpStartInfo()->pc);
+    CHECK_EQUAL(0x5555FFFF, DumpMocks_GetDumpStartInfo()->lr);
+    CHECK_EQUAL(CRASH_CATCHER_FAULT_UNKNOWN, DumpMocks_GetDumpStartInfo()->faultCause);
+}
+
+TEST(CrashCatcher, DumpRegistersOnly_PSP_ShouldPassFaultSignatureFromProcessStack)
+{
+    emulatePSPEntry();
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    CHECK_EQUAL(m_emulatedPSP[6], DumpMocks_GetDumpStartInfo()->pc);
+    CHECK_EQUAL(0xFFFF5555, DumpMocks_GetDumpStartInfo()->lr);
+}
+
+TEST(CrashCatcher, DumpRegistersOnly_EmulateBKPT_ShouldPassBreakpointFaultCauseAndOriginalPC)
+{
+    uint32_t expectedPC = m_emulatedMSP[6];
+    emulateBKPT(0);
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    CHECK_EQUAL(expectedPC, DumpMocks_GetDumpStartInfo()->pc);
+    CHECK_EQUAL(CRASH_CATCHER_FAULT_BREAKPOINT, DumpMocks_GetDumpStartInfo()->faultCause);
+}
+
+TEST(CrashCatcher, DumpRegistersOnly_EmulateCortexM3DivideByZero_ShouldPassDecodedFaultCause)
+{
+    m_emulatedCpuId = cpuIdCortexM3;
+    m_emulatedFaultStatusRegisters.CFSR = CFSR_DIVBYZERO;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    CHECK_EQUAL(CRASH_CATCHER_FAULT_DIVIDE_BY_ZERO, DumpMocks_GetDumpStartInfo()->faultCause);
+}
+
 TEST(CrashCatcher, DumpOneDoubleByteRegion)
 {
     static const CrashCatcherMemoryRegion regions[] = { {m_memoryStart, m_memoryStart + 2, CRASH_CATCHER_BYTE},
@@ -396,7 +810,8 @@ TEST(CrashCatcher, DumpOneWordRegion_EmulateCortexM3_ShouldAppendFaultStatusRegi
     CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(9, m_memory, CRASH_CATCHER_WORD, 1));
 
     CrashCatcherMemoryRegion faultStatusRegisters = {m_faultStatusRegistersStart,
-                                                     m_faultStatusRegistersStart + sizeof(FaultStatusRegisters),
+                                                     m_faultStatusRegistersStart +
+                                                         (uint32_t)sizeof(FaultStatusRegisters),
                                                      CRASH_CATCHER_BYTE};
     CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(10, &faultStatusRegisters, CRASH_CATCHER_BYTE, 2 * sizeof(uint32_t)));
     CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(11, &m_emulatedFaultStatusRegisters, CRASH_CATCHER_WORD, 5));
@@ -489,3 +904,1634 @@ TEST(CrashCatcher, SimulatePCMemManageError_NoAdvanceProgramCounterPastBKPT)
     CHECK_EQUAL(1, DumpMocks_GetDumpEndCallCount());
     CHECK_EQUAL(expectedPC, m_emulatedMSP[6]);
 }
+
+TEST(CrashCatcher, DumpOneDoubleByteRegion_Compressed_ShouldDecompressToSameBytesAsUncompressed)
+{
+    static const CrashCatcherMemoryRegion regions[] = { {m_memoryStart, m_memoryStart + 2, CRASH_CATCHER_BYTE},
+                                                        {   0xFFFFFFFF,        0xFFFFFFFF, CRASH_CATCHER_BYTE} };
+    uint8_t uncompressed[256];
+    uint8_t compressed[256];
+    uint8_t decompressed[256];
+
+    DumpMocks_SetMemoryRegions(regions);
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    size_t uncompressedSize = DumpMocks_CopyDumpedBytes(2, uncompressed, sizeof(uncompressed));
+    DumpMocks_Uninit();
+
+    DumpMocks_Init();
+    DumpMocks_SetMemoryRegions(regions);
+    g_crashCatcherEnableCompression = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    m_expectedFlags |= CRASH_CATCHER_FLAGS_COMPRESSED;
+    CHECK_EQUAL(1, DumpMocks_GetDumpStartCallCount());
+    CHECK_EQUAL(3, DumpMocks_GetDumpMemoryCallCount());
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(0, g_expectedSignature, CRASH_CATCHER_BYTE, sizeof(g_expectedSignature)));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(1, &m_expectedFlags, CRASH_CATCHER_BYTE, sizeof(m_expectedFlags)));
+    size_t compressedSize = DumpMocks_CopyDumpedBytes(2, compressed, sizeof(compressed));
+    CHECK_EQUAL((long)uncompressedSize, Lz4Decoder_DecodeStream(compressed, compressedSize, decompressed, sizeof(decompressed)));
+    CHECK_TRUE(0 == memcmp(uncompressed, decompressed, uncompressedSize));
+    CHECK_EQUAL(1, DumpMocks_GetDumpEndCallCount());
+}
+
+TEST(CrashCatcher, DumpEndReturnTryAgainOnce_Compressed_ShouldRestartCompressionForEachDump)
+{
+    g_crashCatcherEnableCompression = 1;
+    DumpMocks_SetDumpEndLoops(1);
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    m_expectedFlags |= CRASH_CATCHER_FLAGS_COMPRESSED;
+    CHECK_EQUAL(2, DumpMocks_GetDumpStartCallCount());
+    CHECK_EQUAL(6, DumpMocks_GetDumpMemoryCallCount());
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(1, &m_expectedFlags, CRASH_CATCHER_BYTE, sizeof(m_expectedFlags)));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(4, &m_expectedFlags, CRASH_CATCHER_BYTE, sizeof(m_expectedFlags)));
+    CHECK_EQUAL(2, DumpMocks_GetDumpEndCallCount());
+}
+
+TEST(CrashCatcher, DumpOneDoubleByteRegion_Segmented_ShouldSendSingleRawSegment)
+{
+    static const CrashCatcherMemoryRegion regions[] = { {m_memoryStart, m_memoryStart + 2, CRASH_CATCHER_BYTE},
+                                                        {   0xFFFFFFFF,        0xFFFFFFFF, CRASH_CATCHER_BYTE} };
+    uint32_t rawHeader = segmentHeader(CRASH_CATCHER_SEGMENT_RAW, 2);
+
+    DumpMocks_SetMemoryRegions(regions);
+    g_crashCatcherEnableRunElision = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    m_expectedFlags |= CRASH_CATCHER_FLAGS_SEGMENTED;
+    CHECK_EQUAL(1, DumpMocks_GetDumpStartCallCount());
+    CHECK_EQUAL(11, DumpMocks_GetDumpMemoryCallCount());
+    validateHeaderAndDumpedRegisters(USING_MSP);
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(8, &regions[0], CRASH_CATCHER_BYTE, 2 * sizeof(uint32_t)));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(9, &rawHeader, CRASH_CATCHER_BYTE, sizeof(rawHeader)));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(10, m_memory, CRASH_CATCHER_BYTE, 2));
+    CHECK_EQUAL(1, DumpMocks_GetDumpEndCallCount());
+}
+
+TEST(CrashCatcher, DumpOneWordRegion_Segmented_ShouldSendRawSegmentWithoutScanningForRuns)
+{
+    fillWords(0, 32, 0x00000000);
+    static const CrashCatcherMemoryRegion regions[] = { {m_fillMemoryStart, m_fillMemoryStart + 128, CRASH_CATCHER_WORD},
+                                                        {       0xFFFFFFFF,              0xFFFFFFFF, CRASH_CATCHER_BYTE} };
+    uint32_t rawHeader = segmentHeader(CRASH_CATCHER_SEGMENT_RAW, 128);
+
+    DumpMocks_SetMemoryRegions(regions);
+    g_crashCatcherEnableRunElision = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    m_expectedFlags |= CRASH_CATCHER_FLAGS_SEGMENTED;
+    CHECK_EQUAL(11, DumpMocks_GetDumpMemoryCallCount());
+    validateHeaderAndDumpedRegisters(USING_MSP);
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(9, &rawHeader, CRASH_CATCHER_BYTE, sizeof(rawHeader)));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(10, m_fillMemory, CRASH_CATCHER_WORD, 32));
+}
+
+TEST(CrashCatcher, DumpZeroedByteRegion_Segmented_ShouldSendSingleFillSegment)
+{
+    fillWords(0, 32, 0x00000000);
+    static const CrashCatcherMemoryRegion regions[] = { {m_fillMemoryStart, m_fillMemoryStart + 128, CRASH_CATCHER_BYTE},
+                                                        {       0xFFFFFFFF,              0xFFFFFFFF, CRASH_CATCHER_BYTE} };
+    uint32_t fillHeader = segmentHeader(CRASH_CATCHER_SEGMENT_FILL, 128);
+    uint32_t fillWord = 0x00000000;
+
+    DumpMocks_SetMemoryRegions(regions);
+    g_crashCatcherEnableRunElision = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    m_expectedFlags |= CRASH_CATCHER_FLAGS_SEGMENTED;
+    CHECK_EQUAL(11, DumpMocks_GetDumpMemoryCallCount());
+    validateHeaderAndDumpedRegisters(USING_MSP);
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(8, &regions[0], CRASH_CATCHER_BYTE, 2 * sizeof(uint32_t)));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(9, &fillHeader, CRASH_CATCHER_BYTE, sizeof(fillHeader)));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(10, &fillWord, CRASH_CATCHER_BYTE, sizeof(fillWord)));
+}
+
+TEST(CrashCatcher, DumpUnalignedByteRegionWithFillRunInMiddle_Segmented_ShouldSendRawFillRawSegments)
+{
+    fillWords(2, 16, 0xDEADBEEF);
+    static const CrashCatcherMemoryRegion regions[] = { {m_fillMemoryStart + 2, m_fillMemoryStart + 127, CRASH_CATCHER_BYTE},
+                                                        {           0xFFFFFFFF,               0xFFFFFFFF, CRASH_CATCHER_BYTE} };
+    uint32_t leadingRawHeader = segmentHeader(CRASH_CATCHER_SEGMENT_RAW, 6);
+    uint32_t fillHeader = segmentHeader(CRASH_CATCHER_SEGMENT_FILL, 16 * sizeof(uint32_t));
+    uint32_t fillWord = 0xDEADBEEF;
+    uint32_t trailingRawHeader = segmentHeader(CRASH_CATCHER_SEGMENT_RAW, 127 - 18 * sizeof(uint32_t));
+
+    DumpMocks_SetMemoryRegions(regions);
+    g_crashCatcherEnableRunElision = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    m_expectedFlags |= CRASH_CATCHER_FLAGS_SEGMENTED;
+    CHECK_EQUAL(15, DumpMocks_GetDumpMemoryCallCount());
+    validateHeaderAndDumpedRegisters(USING_MSP);
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(9, &leadingRawHeader, CRASH_CATCHER_BYTE, sizeof(leadingRawHeader)));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(10, (uint8_t*)m_fillMemory + 2, CRASH_CATCHER_BYTE, 6));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(11, &fillHeader, CRASH_CATCHER_BYTE, sizeof(fillHeader)));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(12, &fillWord, CRASH_CATCHER_BYTE, sizeof(fillWord)));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(13, &trailingRawHeader, CRASH_CATCHER_BYTE, sizeof(trailingRawHeader)));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(14, &m_fillMemory[18], CRASH_CATCHER_BYTE, 127 - 18 * sizeof(uint32_t)));
+}
+
+TEST(CrashCatcher, DumpByteRegionWithRunShorterThanMinimum_Segmented_ShouldSendSingleRawSegment)
+{
+    fillWords(4, CRASH_CATCHER_RUN_ELISION_MIN_WORDS - 1, 0x00000000);
+    static const CrashCatcherMemoryRegion regions[] = { {m_fillMemoryStart, m_fillMemoryStart + 128, CRASH_CATCHER_BYTE},
+                                                        {       0xFFFFFFFF,              0xFFFFFFFF, CRASH_CATCHER_BYTE} };
+    uint32_t rawHeader = segmentHeader(CRASH_CATCHER_SEGMENT_RAW, 128);
+
+    DumpMocks_SetMemoryRegions(regions);
+    g_crashCatcherEnableRunElision = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    m_expectedFlags |= CRASH_CATCHER_FLAGS_SEGMENTED;
+    CHECK_EQUAL(11, DumpMocks_GetDumpMemoryCallCount());
+    validateHeaderAndDumpedRegisters(USING_MSP);
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(9, &rawHeader, CRASH_CATCHER_BYTE, sizeof(rawHeader)));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(10, m_fillMemory, CRASH_CATCHER_BYTE, 128));
+}
+
+TEST(CrashCatcher, DumpByteRegionWithRunAtEnd_Segmented_ShouldSendRawThenFillSegment)
+{
+    fillWords(32 - CRASH_CATCHER_RUN_ELISION_MIN_WORDS, CRASH_CATCHER_RUN_ELISION_MIN_WORDS, 0x00000000);
+    static const CrashCatcherMemoryRegion regions[] = { {m_fillMemoryStart, m_fillMemoryStart + 128, CRASH_CATCHER_BYTE},
+                                                        {       0xFFFFFFFF,              0xFFFFFFFF, CRASH_CATCHER_BYTE} };
+    uint32_t rawLength = (32 - CRASH_CATCHER_RUN_ELISION_MIN_WORDS) * sizeof(uint32_t);
+    uint32_t rawHeader = segmentHeader(CRASH_CATCHER_SEGMENT_RAW, rawLength);
+    uint32_t fillHeader = segmentHeader(CRASH_CATCHER_SEGMENT_FILL, CRASH_CATCHER_RUN_ELISION_MIN_WORDS * sizeof(uint32_t));
+    uint32_t fillWord = 0x00000000;
+
+    DumpMocks_SetMemoryRegions(regions);
+    g_crashCatcherEnableRunElision = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    m_expectedFlags |= CRASH_CATCHER_FLAGS_SEGMENTED;
+    CHECK_EQUAL(13, DumpMocks_GetDumpMemoryCallCount());
+    validateHeaderAndDumpedRegisters(USING_MSP);
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(9, &rawHeader, CRASH_CATCHER_BYTE, sizeof(rawHeader)));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(10, m_fillMemory, CRASH_CATCHER_BYTE, rawLength));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(11, &fillHeader, CRASH_CATCHER_BYTE, sizeof(fillHeader)));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(12, &fillWord, CRASH_CATCHER_BYTE, sizeof(fillWord)));
+}
+
+TEST(CrashCatcher, Minidump_MSP_ShouldOnlyDumpFromSPToInitialMSPInVectorTable)
+{
+    static const CrashCatcherMemoryRegion regions[] = { {m_memoryStart, m_memoryStart + 2, CRASH_CATCHER_BYTE},
+                                                        {   0xFFFFFFFF,        0xFFFFFFFF, CRASH_CATCHER_BYTE} };
+    CrashCatcherMemoryRegion stackRegion = { m_expectedSP, m_emulatedVectorTable[0], CRASH_CATCHER_BYTE };
+
+    DumpMocks_SetMemoryRegions(regions);
+    g_crashCatcherEnableMinidump = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    m_expectedFlags |= CRASH_CATCHER_FLAGS_MINIDUMP;
+    CHECK_EQUAL(1, DumpMocks_GetDumpStartCallCount());
+    CHECK_EQUAL(10, DumpMocks_GetDumpMemoryCallCount());
+    validateHeaderAndDumpedRegisters(USING_MSP);
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(8, &stackRegion, CRASH_CATCHER_BYTE, 2 * sizeof(uint32_t)));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(9, &m_emulatedMSP[8], CRASH_CATCHER_BYTE, (16 + 1) * sizeof(uint32_t)));
+    CHECK_EQUAL(0, DumpMocks_GetThreadStackTopSP());
+    CHECK_EQUAL(1, DumpMocks_GetDumpEndCallCount());
+}
+
+TEST(CrashCatcher, Minidump_PSP_ShouldDumpFromSPToTopOfThreadStack)
+{
+    emulatePSPEntry();
+    uint32_t                 threadStackTop = (uint32_t)(unsigned long)&m_emulatedPSP[8 + 4];
+    CrashCatcherMemoryRegion stackRegion = { m_expectedSP, threadStackTop, CRASH_CATCHER_BYTE };
+
+    memset(&m_emulatedPSP[8], 0x5A, 4 * sizeof(uint32_t));
+    DumpMocks_SetThreadStackTop(threadStackTop);
+    g_crashCatcherEnableMinidump = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    m_expectedFlags |= CRASH_CATCHER_FLAGS_MINIDUMP;
+    CHECK_EQUAL(10, DumpMocks_GetDumpMemoryCallCount());
+    validateHeaderAndDumpedRegisters(USING_PSP);
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(8, &stackRegion, CRASH_CATCHER_BYTE, 2 * sizeof(uint32_t)));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(9, &m_emulatedPSP[8], CRASH_CATCHER_BYTE, 4 * sizeof(uint32_t)));
+    CHECK_EQUAL(m_expectedSP, DumpMocks_GetThreadStackTopSP());
+}
+
+TEST(CrashCatcher, Minidump_PSP_UnknownThreadStackTop_ShouldStopAtTopOfMainStack)
+{
+    emulatePSPEntry();
+    m_emulatedVectorTable[0] = (uint32_t)(unsigned long)&m_emulatedPSP[8 + 2];
+    CrashCatcherMemoryRegion stackRegion = { m_expectedSP, m_emulatedVectorTable[0], CRASH_CATCHER_BYTE };
+
+    g_crashCatcherEnableMinidump = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    m_expectedFlags |= CRASH_CATCHER_FLAGS_MINIDUMP;
+    CHECK_EQUAL(10, DumpMocks_GetDumpMemoryCallCount());
+    validateHeaderAndDumpedRegisters(USING_PSP);
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(8, &stackRegion, CRASH_CATCHER_BYTE, 2 * sizeof(uint32_t)));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(9, &m_emulatedPSP[8], CRASH_CATCHER_BYTE, 2 * sizeof(uint32_t)));
+}
+
+TEST(CrashCatcher, Minidump_SPAtOrAboveTopOfStack_ShouldOnlyDumpRegisters)
+{
+    m_emulatedVectorTable[0] = m_expectedSP;
+    g_crashCatcherEnableMinidump = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    m_expectedFlags |= CRASH_CATCHER_FLAGS_MINIDUMP;
+    CHECK_EQUAL(8, DumpMocks_GetDumpMemoryCallCount());
+    validateHeaderAndDumpedRegisters(USING_MSP);
+}
+
+TEST(CrashCatcher, DumpByteRegionWithFreeHeapSpan_HeapWalk_ShouldSendHoleSegmentForFreeSpan)
+{
+    static const CrashCatcherMemoryRegion regions[] = { {m_fillMemoryStart, m_fillMemoryStart + 128, CRASH_CATCHER_BYTE},
+                                                        {       0xFFFFFFFF,              0xFFFFFFFF, CRASH_CATCHER_BYTE} };
+    static const CrashCatcherMemoryRegionInfo freeSpans[] = { {m_fillMemoryStart + 16, m_fillMemoryStart + 96},
+                                                              {            0xFFFFFFFF,             0xFFFFFFFF} };
+    uint32_t leadingRawHeader = segmentHeader(CRASH_CATCHER_SEGMENT_RAW, 16);
+    uint32_t holeHeader = segmentHeader(CRASH_CATCHER_SEGMENT_HOLE, 80);
+    uint32_t trailingRawHeader = segmentHeader(CRASH_CATCHER_SEGMENT_RAW, 32);
+
+    DumpMocks_SetMemoryRegions(regions);
+    DumpMocks_SetFreeHeapSpans(freeSpans);
+    g_crashCatcherEnableHeapWalk = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    m_expectedFlags |= CRASH_CATCHER_FLAGS_SEGMENTED;
+    CHECK_EQUAL(14, DumpMocks_GetDumpMemoryCallCount());
+    validateHeaderAndDumpedRegisters(USING_MSP);
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(8, &regions[0], CRASH_CATCHER_BYTE, 2 * sizeof(uint32_t)));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(9, &leadingRawHeader, CRASH_CATCHER_BYTE, sizeof(leadingRawHeader)));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(10, m_fillMemory, CRASH_CATCHER_BYTE, 16));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(11, &holeHeader, CRASH_CATCHER_BYTE, sizeof(holeHeader)));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(12, &trailingRawHeader, CRASH_CATCHER_BYTE, sizeof(trailingRawHeader)));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(13, &m_fillMemory[24], CRASH_CATCHER_BYTE, 32));
+}
+
+TEST(CrashCatcher, DumpByteRegionWithFreeHeapSpanAndFillRun_HeapWalkAndRunElision_ShouldSendHoleAndFillSegments)
+{
+    fillWords(8, 24, 0x00000000);
+    static const CrashCatcherMemoryRegion regions[] = { {m_fillMemoryStart, m_fillMemoryStart + 128, CRASH_CATCHER_BYTE},
+                                                        {       0xFFFFFFFF,              0xFFFFFFFF, CRASH_CATCHER_BYTE} };
+    static const CrashCatcherMemoryRegionInfo freeSpans[] = { {m_fillMemoryStart + 16, m_fillMemoryStart + 32},
+                                                              {            0xFFFFFFFF,             0xFFFFFFFF} };
+    uint32_t rawHeader = segmentHeader(CRASH_CATCHER_SEGMENT_RAW, 16);
+    uint32_t holeHeader = segmentHeader(CRASH_CATCHER_SEGMENT_HOLE, 16);
+    uint32_t fillHeader = segmentHeader(CRASH_CATCHER_SEGMENT_FILL, 96);
+    uint32_t fillWord = 0x00000000;
+
+    DumpMocks_SetMemoryRegions(regions);
+    DumpMocks_SetFreeHeapSpans(freeSpans);
+    g_crashCatcherEnableHeapWalk = 1;
+    g_crashCatcherEnableRunElision = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    m_expectedFlags |= CRASH_CATCHER_FLAGS_SEGMENTED;
+    CHECK_EQUAL(14, DumpMocks_GetDumpMemoryCallCount());
+    validateHeaderAndDumpedRegisters(USING_MSP);
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(9, &rawHeader, CRASH_CATCHER_BYTE, sizeof(rawHeader)));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(10, m_fillMemory, CRASH_CATCHER_BYTE, 16));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(11, &holeHeader, CRASH_CATCHER_BYTE, sizeof(holeHeader)));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(12, &fillHeader, CRASH_CATCHER_BYTE, sizeof(fillHeader)));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(13, &fillWord, CRASH_CATCHER_BYTE, sizeof(fillWord)));
+}
+
+TEST(CrashCatcher, DumpByteRegionWithFreeHeapSpanPastEndOfRegion_HeapWalk_ShouldIgnoreBadSpan)
+{
+    static const CrashCatcherMemoryRegion regions[] = { {m_fillMemoryStart, m_fillMemoryStart + 128, CRASH_CATCHER_BYTE},
+                                                        {       0xFFFFFFFF,              0xFFFFFFFF, CRASH_CATCHER_BYTE} };
+    static const CrashCatcherMemoryRegionInfo freeSpans[] = { {m_fillMemoryStart + 16, m_fillMemoryStart + 132},
+                                                              {            0xFFFFFFFF,             0xFFFFFFFF} };
+    uint32_t rawHeader = segmentHeader(CRASH_CATCHER_SEGMENT_RAW, 128);
+
+    DumpMocks_SetMemoryRegions(regions);
+    DumpMocks_SetFreeHeapSpans(freeSpans);
+    g_crashCatcherEnableHeapWalk = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    m_expectedFlags |= CRASH_CATCHER_FLAGS_SEGMENTED;
+    CHECK_EQUAL(11, DumpMocks_GetDumpMemoryCallCount());
+    validateHeaderAndDumpedRegisters(USING_MSP);
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(9, &rawHeader, CRASH_CATCHER_BYTE, sizeof(rawHeader)));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(10, m_fillMemory, CRASH_CATCHER_BYTE, 128));
+}
+
+TEST(CrashCatcher, DumpWordRegionWithFreeHeapSpan_HeapWalk_ShouldNotSkipFreeSpanInPeripheralRegion)
+{
+    static const CrashCatcherMemoryRegion regions[] = { {m_fillMemoryStart, m_fillMemoryStart + 128, CRASH_CATCHER_WORD},
+                                                        {       0xFFFFFFFF,              0xFFFFFFFF, CRASH_CATCHER_BYTE} };
+    static const CrashCatcherMemoryRegionInfo freeSpans[] = { {m_fillMemoryStart + 16, m_fillMemoryStart + 96},
+                                                              {            0xFFFFFFFF,             0xFFFFFFFF} };
+    uint32_t rawHeader = segmentHeader(CRASH_CATCHER_SEGMENT_RAW, 128);
+
+    DumpMocks_SetMemoryRegions(regions);
+    DumpMocks_SetFreeHeapSpans(freeSpans);
+    g_crashCatcherEnableHeapWalk = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    m_expectedFlags |= CRASH_CATCHER_FLAGS_SEGMENTED;
+    CHECK_EQUAL(11, DumpMocks_GetDumpMemoryCallCount());
+    validateHeaderAndDumpedRegisters(USING_MSP);
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(9, &rawHeader, CRASH_CATCHER_BYTE, sizeof(rawHeader)));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(10, m_fillMemory, CRASH_CATCHER_WORD, 32));
+}
+
+TEST(CrashCatcher, DumpUnchangedLoadImageRegion_LoadImage_ShouldSendSingleLoadImageSegment)
+{
+    const CrashCatcherMemoryRegion    regions[] = { {m_fillMemoryStart, m_fillMemoryStart + 128, CRASH_CATCHER_BYTE},
+                                                    {       0xFFFFFFFF,              0xFFFFFFFF, CRASH_CATCHER_BYTE} };
+    const CrashCatcherLoadImageRegion loadImages[] = { {m_fillMemoryStart, m_fillMemoryStart + 128, m_loadImageStart},
+                                                       {       0xFFFFFFFF,              0xFFFFFFFF,       0xFFFFFFFF} };
+    uint32_t loadImageHeader = segmentHeader(CRASH_CATCHER_SEGMENT_LOAD_IMAGE, 128);
+
+    DumpMocks_SetMemoryRegions(regions);
+    DumpMocks_SetLoadImageRegions(loadImages);
+    g_crashCatcherEnableLoadImage = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    m_expectedFlags |= CRASH_CATCHER_FLAGS_SEGMENTED;
+    CHECK_EQUAL(11, DumpMocks_GetDumpMemoryCallCount());
+    validateHeaderAndDumpedRegisters(USING_MSP);
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(8, &regions[0], CRASH_CATCHER_BYTE, 2 * sizeof(uint32_t)));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(9, &loadImageHeader, CRASH_CATCHER_BYTE, sizeof(loadImageHeader)));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(10, &m_loadImageStart, CRASH_CATCHER_BYTE, sizeof(m_loadImageStart)));
+}
+
+TEST(CrashCatcher, DumpLoadImageRegionWithOneChangedBlock_LoadImage_ShouldOnlySendChangedBlock)
+{
+    m_fillMemory[CRASH_CATCHER_LOAD_IMAGE_BLOCK_SIZE / sizeof(uint32_t) + 1] ^= 0x80;
+    const CrashCatcherMemoryRegion    regions[] = { {m_fillMemoryStart, m_fillMemoryStart + 128, CRASH_CATCHER_BYTE},
+                                                    {       0xFFFFFFFF,              0xFFFFFFFF, CRASH_CATCHER_BYTE} };
+    const CrashCatcherLoadImageRegion loadImages[] = { {m_fillMemoryStart, m_fillMemoryStart + 128, m_loadImageStart},
+                                                       {       0xFFFFFFFF,              0xFFFFFFFF,       0xFFFFFFFF} };
+    const uint32_t blockSize = CRASH_CATCHER_LOAD_IMAGE_BLOCK_SIZE;
+    uint32_t       leadingHeader = segmentHeader(CRASH_CATCHER_SEGMENT_LOAD_IMAGE, blockSize);
+    uint32_t       rawHeader = segmentHeader(CRASH_CATCHER_SEGMENT_RAW, blockSize);
+    uint32_t       trailingHeader = segmentHeader(CRASH_CATCHER_SEGMENT_LOAD_IMAGE, 128 - 2 * blockSize);
+    uint32_t       trailingLoadAddress = m_loadImageStart + 2 * blockSize;
+
+    DumpMocks_SetMemoryRegions(regions);
+    DumpMocks_SetLoadImageRegions(loadImages);
+    g_crashCatcherEnableLoadImage = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    m_expectedFlags |= CRASH_CATCHER_FLAGS_SEGMENTED;
+    CHECK_EQUAL(15, DumpMocks_GetDumpMemoryCallCount());
+    validateHeaderAndDumpedRegisters(USING_MSP);
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(9, &leadingHeader, CRASH_CATCHER_BYTE, sizeof(leadingHeader)));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(10, &m_loadImageStart, CRASH_CATCHER_BYTE, sizeof(m_loadImageStart)));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(11, &rawHeader, CRASH_CATCHER_BYTE, sizeof(rawHeader)));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(12, (uint8_t*)m_fillMemory + blockSize, CRASH_CATCHER_BYTE, blockSize));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(13, &trailingHeader, CRASH_CATCHER_BYTE, sizeof(trailingHeader)));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(14, &trailingLoadAddress, CRASH_CATCHER_BYTE, sizeof(trailingLoadAddress)));
+}
+
+TEST(CrashCatcher, DumpLoadImageRegionWithChangedPartialLastBlock_LoadImage_ShouldSendPartialBlockAsRaw)
+{
+    const uint32_t regionSize = 128 - 2;
+    const uint32_t lastBlockStart = (regionSize / CRASH_CATCHER_LOAD_IMAGE_BLOCK_SIZE) * CRASH_CATCHER_LOAD_IMAGE_BLOCK_SIZE;
+    ((uint8_t*)m_fillMemory)[regionSize - 1] ^= 0x80;
+    const uint32_t regionEnd = m_fillMemoryStart + regionSize;
+    const CrashCatcherMemoryRegion    regions[] = { {m_fillMemoryStart,  regionEnd, CRASH_CATCHER_BYTE},
+                                                    {       0xFFFFFFFF, 0xFFFFFFFF, CRASH_CATCHER_BYTE} };
+    const CrashCatcherLoadImageRegion loadImages[] = { {m_fillMemoryStart,  regionEnd, m_loadImageStart},
+                                                       {       0xFFFFFFFF, 0xFFFFFFFF,       0xFFFFFFFF} };
+    uint32_t loadImageHeader = segmentHeader(CRASH_CATCHER_SEGMENT_LOAD_IMAGE, lastBlockStart);
+    uint32_t rawHeader = segmentHeader(CRASH_CATCHER_SEGMENT_RAW, regionSize - lastBlockStart);
+
+    DumpMocks_SetMemoryRegions(regions);
+    DumpMocks_SetLoadImageRegions(loadImages);
+    g_crashCatcherEnableLoadImage = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    m_expectedFlags |= CRASH_CATCHER_FLAGS_SEGMENTED;
+    CHECK_EQUAL(13, DumpMocks_GetDumpMemoryCallCount());
+    validateHeaderAndDumpedRegisters(USING_MSP);
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(9, &loadImageHeader, CRASH_CATCHER_BYTE, sizeof(loadImageHeader)));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(10, &m_loadImageStart, CRASH_CATCHER_BYTE, sizeof(m_loadImageStart)));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(11, &rawHeader, CRASH_CATCHER_BYTE, sizeof(rawHeader)));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(12, (uint8_t*)m_fillMemory + lastBlockStart, CRASH_CATCHER_BYTE,
+                                              regionSize - lastBlockStart));
+}
+
+TEST(CrashCatcher, DumpLoadImageRegion_LoadImageNotEnabled_ShouldDumpWholeRegion)
+{
+    const CrashCatcherMemoryRegion    regions[] = { {m_fillMemoryStart, m_fillMemoryStart + 128, CRASH_CATCHER_BYTE},
+                                                    {       0xFFFFFFFF,              0xFFFFFFFF, CRASH_CATCHER_BYTE} };
+    const CrashCatcherLoadImageRegion loadImages[] = { {m_fillMemoryStart, m_fillMemoryStart + 128, m_loadImageStart},
+                                                       {       0xFFFFFFFF,              0xFFFFFFFF,       0xFFFFFFFF} };
+
+    DumpMocks_SetMemoryRegions(regions);
+    DumpMocks_SetLoadImageRegions(loadImages);
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    CHECK_EQUAL(10, DumpMocks_GetDumpMemoryCallCount());
+    validateHeaderAndDumpedRegisters(USING_MSP);
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(9, m_fillMemory, CRASH_CATCHER_BYTE, 128));
+}
+
+TEST(CrashCatcher, DumpRegionContainingLoadImage_LoadImage_ShouldOnlyCompareOverlappingPart)
+{
+    const uint32_t                    dataStart = m_fillMemoryStart + 32;
+    const uint32_t                    loadAddress = m_loadImageStart + 32;
+    const CrashCatcherMemoryRegion    regions[] = { {m_fillMemoryStart, m_fillMemoryStart + 128, CRASH_CATCHER_BYTE},
+                                                    {       0xFFFFFFFF,              0xFFFFFFFF, CRASH_CATCHER_BYTE} };
+    const CrashCatcherLoadImageRegion loadImages[] = { { dataStart, dataStart + 64, loadAddress},
+                                                       {0xFFFFFFFF,     0xFFFFFFFF,  0xFFFFFFFF} };
+    uint32_t                          rawHeader = segmentHeader(CRASH_CATCHER_SEGMENT_RAW, 32);
+    uint32_t                          loadImageHeader = segmentHeader(CRASH_CATCHER_SEGMENT_LOAD_IMAGE, 64);
+
+    DumpMocks_SetMemoryRegions(regions);
+    DumpMocks_SetLoadImageRegions(loadImages);
+    g_crashCatcherEnableLoadImage = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    m_expectedFlags |= CRASH_CATCHER_FLAGS_SEGMENTED;
+    CHECK_EQUAL(15, DumpMocks_GetDumpMemoryCallCount());
+    validateHeaderAndDumpedRegisters(USING_MSP);
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(8, &regions[0], CRASH_CATCHER_BYTE, 2 * sizeof(uint32_t)));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(9, &rawHeader, CRASH_CATCHER_BYTE, sizeof(rawHeader)));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(10, m_fillMemory, CRASH_CATCHER_BYTE, 32));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(11, &loadImageHeader, CRASH_CATCHER_BYTE, sizeof(loadImageHeader)));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(12, &loadAddress, CRASH_CATCHER_BYTE, sizeof(loadAddress)));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(13, &rawHeader, CRASH_CATCHER_BYTE, sizeof(rawHeader)));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(14, (uint8_t*)m_fillMemory + 96, CRASH_CATCHER_BYTE, 32));
+}
+
+TEST(CrashCatcher, DumpRegistersOnly_Crc32_ShouldAppendTrailerWithOnlyDumpCrc)
+{
+    g_crashCatcherEnableCrc32 = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    m_expectedFlags |= CRASH_CATCHER_FLAGS_CRC32;
+    CHECK_EQUAL(11, DumpMocks_GetDumpMemoryCallCount());
+    validateHeaderAndDumpedRegisters(USING_MSP);
+
+    uint8_t  dumpedBytes[128];
+    size_t   dumpedSize = DumpMocks_CopyDumpedBytes(0, dumpedBytes, sizeof(dumpedBytes));
+    uint32_t recordHeader[2] = { CRASH_CATCHER_RECORD_TAG(CRASH_CATCHER_RECORD_CRC32), 2 * sizeof(uint32_t) };
+    uint32_t regionCrcCount = 0;
+    uint32_t dumpCrc = CrashCatcher_Crc32(0, dumpedBytes, dumpedSize - sizeof(uint32_t));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(8, recordHeader, CRASH_CATCHER_BYTE, sizeof(recordHeader)));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(9, &regionCrcCount, CRASH_CATCHER_BYTE, sizeof(regionCrcCount)));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(10, &dumpCrc, CRASH_CATCHER_BYTE, sizeof(dumpCrc)));
+}
+
+TEST(CrashCatcher, DumpOneDoubleByteRegion_Crc32_ShouldAppendTrailerWithRegionAndDumpCrcs)
+{
+    const CrashCatcherMemoryRegion regions[] = { {m_memoryStart, m_memoryStart + 2, CRASH_CATCHER_BYTE},
+                                                 {   0xFFFFFFFF,        0xFFFFFFFF, CRASH_CATCHER_BYTE} };
+    uint32_t regionCrcs[1] = { regionCrc32(&regions[0], m_memory) };
+
+    DumpMocks_SetMemoryRegions(regions);
+    g_crashCatcherEnableCrc32 = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    m_expectedFlags |= CRASH_CATCHER_FLAGS_CRC32;
+    CHECK_EQUAL(14, DumpMocks_GetDumpMemoryCallCount());
+    validateHeaderAndDumpedRegisters(USING_MSP);
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(8, &regions[0], CRASH_CATCHER_BYTE, 2 * sizeof(uint32_t)));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(9, m_memory, CRASH_CATCHER_BYTE, 2));
+    validateCrc32Trailer(10, regionCrcs, 1);
+}
+
+TEST(CrashCatcher, DumpHalfwordRegion_EmulateCortexM3_Crc32_ShouldIncludeFaultStatusRegistersInTrailer)
+{
+    const CrashCatcherMemoryRegion regions[] = { {m_memoryStart, m_memoryStart + 4, CRASH_CATCHER_HALFWORD},
+                                                 {   0xFFFFFFFF,        0xFFFFFFFF, CRASH_CATCHER_BYTE} };
+    m_emulatedCpuId = cpuIdCortexM3;
+    m_emulatedFaultStatusRegisters.CFSR = 0x12345678;
+    CrashCatcherMemoryRegion faultStatusRegion = {m_faultStatusRegistersStart,
+                                                  m_faultStatusRegistersStart + (uint32_t)sizeof(FaultStatusRegisters),
+                                                  CRASH_CATCHER_WORD};
+    uint32_t regionCrcs[2] = { regionCrc32(&regions[0], m_memory),
+                               regionCrc32(&faultStatusRegion, &m_emulatedFaultStatusRegisters) };
+
+    DumpMocks_SetMemoryRegions(regions);
+    g_crashCatcherEnableCrc32 = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    m_expectedFlags |= CRASH_CATCHER_FLAGS_CRC32;
+    CHECK_EQUAL(16, DumpMocks_GetDumpMemoryCallCount());
+    validateHeaderAndDumpedRegisters(USING_MSP);
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(9, m_memory, CRASH_CATCHER_HALFWORD, 2));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(11, &m_emulatedFaultStatusRegisters, CRASH_CATCHER_WORD, 5));
+    validateCrc32Trailer(12, regionCrcs, 2);
+}
+
+TEST(CrashCatcher, DumpMoreRegionsThanCrcSlots_Crc32_ShouldOnlyIncludeCrcsForFirstRegions)
+{
+    CrashCatcherMemoryRegion regions[CRASH_CATCHER_CRC32_MAX_REGIONS + 2];
+    uint32_t                 regionCrcs[CRASH_CATCHER_CRC32_MAX_REGIONS];
+
+    for (int i = 0 ; i < CRASH_CATCHER_CRC32_MAX_REGIONS + 1 ; i++)
+    {
+        CrashCatcherMemoryRegion region = {m_memoryStart + (i & 7), m_memoryStart + (i & 7) + 1, CRASH_CATCHER_BYTE};
+        regions[i] = region;
+        if (i < CRASH_CATCHER_CRC32_MAX_REGIONS)
+            regionCrcs[i] = regionCrc32(&regions[i], &m_memory[i & 7]);
+    }
+    regions[CRASH_CATCHER_CRC32_MAX_REGIONS + 1].startAddress = 0xFFFFFFFF;
+
+    DumpMocks_SetMemoryRegions(regions);
+    g_crashCatcherEnableCrc32 = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    validateCrc32Trailer(8 + 2 * (CRASH_CATCHER_CRC32_MAX_REGIONS + 1), regionCrcs, CRASH_CATCHER_CRC32_MAX_REGIONS);
+}
+
+TEST(CrashCatcher, DumpEndReturnTryAgainOnce_Crc32_ShouldRestartCrcsForEachDump)
+{
+    const CrashCatcherMemoryRegion regions[] = { {m_memoryStart, m_memoryStart + 2, CRASH_CATCHER_BYTE},
+                                                 {   0xFFFFFFFF,        0xFFFFFFFF, CRASH_CATCHER_BYTE} };
+    uint8_t firstDump[256];
+    uint8_t secondDump[256];
+
+    DumpMocks_SetMemoryRegions(regions);
+    DumpMocks_SetDumpEndLoops(1);
+    g_crashCatcherEnableCrc32 = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    CHECK_EQUAL(2, DumpMocks_GetDumpStartCallCount());
+    CHECK_EQUAL(28, DumpMocks_GetDumpMemoryCallCount());
+    size_t bothSize = DumpMocks_CopyDumpedBytes(0, firstDump, sizeof(firstDump));
+    size_t secondSize = DumpMocks_CopyDumpedBytes(14, secondDump, sizeof(secondDump));
+    CHECK_EQUAL(bothSize, 2 * secondSize);
+    CHECK_TRUE(0 == memcmp(firstDump, secondDump, secondSize));
+}
+
+TEST(CrashCatcher, DumpOneDoubleByteRegion_CompressedAndCrc32_ShouldCalculateCrcsOverUncompressedBytes)
+{
+    const CrashCatcherMemoryRegion regions[] = { {m_memoryStart, m_memoryStart + 2, CRASH_CATCHER_BYTE},
+                                                 {   0xFFFFFFFF,        0xFFFFFFFF, CRASH_CATCHER_BYTE} };
+    uint8_t  dumped[256];
+    uint8_t  uncompressed[256];
+    uint32_t dumpCrc;
+
+    DumpMocks_SetMemoryRegions(regions);
+    g_crashCatcherEnableCompression = 1;
+    g_crashCatcherEnableCrc32 = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    memcpy(dumped, g_expectedSignature, sizeof(g_expectedSignature));
+    m_expectedFlags |= CRASH_CATCHER_FLAGS_COMPRESSED | CRASH_CATCHER_FLAGS_CRC32;
+    memcpy(&dumped[4], &m_expectedFlags, sizeof(m_expectedFlags));
+    size_t compressedSize = DumpMocks_CopyDumpedBytes(2, dumped + 8, sizeof(dumped) - 8);
+    long   uncompressedSize = Lz4Decoder_DecodeStream(dumped + 8, compressedSize, uncompressed, sizeof(uncompressed));
+    CHECK_TRUE(uncompressedSize > (long)sizeof(dumpCrc));
+
+    memmove(dumped + 8, uncompressed, uncompressedSize);
+    memcpy(&dumpCrc, &uncompressed[uncompressedSize - sizeof(dumpCrc)], sizeof(dumpCrc));
+    CHECK_EQUAL(CrashCatcher_Crc32(0, dumped, 8 + uncompressedSize - sizeof(dumpCrc)), dumpCrc);
+}
+
+TEST(CrashCatcher, DumpOneDoubleByteRegion_CompressedCrc32AndBacktrace_HostExpansionShouldMatchUncompressedDump)
+{
+    static const uint32_t          stack[] = { 0x08000101 };
+    const CrashCatcherMemoryRegion regions[] = { {m_memoryStart, m_memoryStart + 2, CRASH_CATCHER_BYTE},
+                                                 {   0xFFFFFFFF,        0xFFFFFFFF, CRASH_CATCHER_BYTE} };
+    uint8_t                        uncompressed[512];
+    uint8_t                        compressed[512];
+    uint8_t*                       pExpanded = NULL;
+    size_t                         expandedSize = 0;
+    uint32_t                       dumpCrc;
+
+    setMSPWords(stack, sizeof(stack) / sizeof(stack[0]));
+    DumpMocks_SetMemoryRegions(regions);
+    g_crashCatcherEnableCrc32 = 1;
+    g_crashCatcherEnableBacktrace = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    size_t uncompressedSize = DumpMocks_CopyDumpedBytes(0, uncompressed, sizeof(uncompressed));
+    DumpMocks_Uninit();
+
+    DumpMocks_Init();
+    setMSPWords(stack, sizeof(stack) / sizeof(stack[0]));
+    DumpMocks_SetMemoryRegions(regions);
+    g_crashCatcherEnableCompression = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    size_t compressedSize = DumpMocks_CopyDumpedBytes(0, compressed, sizeof(compressed));
+    CHECK_EQUAL(LZ4_DECODER_OK, Lz4Decoder_ExpandDump(compressed, compressedSize, &pExpanded, &expandedSize));
+
+    // Only the flags and the dump CRC at the very end of the trailer should differ.
+    CHECK_EQUAL(uncompressedSize, expandedSize);
+    MEMCMP_EQUAL(uncompressed, pExpanded, sizeof(uint32_t));
+    CHECK_EQUAL(uncompressed[4] | CRASH_CATCHER_FLAGS_COMPRESSED, pExpanded[4]);
+    MEMCMP_EQUAL(uncompressed + 5, pExpanded + 5, expandedSize - 5 - sizeof(dumpCrc));
+    memcpy(&dumpCrc, &pExpanded[expandedSize - sizeof(dumpCrc)], sizeof(dumpCrc));
+    CHECK_EQUAL(CrashCatcher_Crc32(0, pExpanded, expandedSize - sizeof(dumpCrc)), dumpCrc);
+    free(pExpanded);
+}
+
+TEST(CrashCatcher, DumpOneDoubleByteRegion_Crc32_ShouldUseHardwareCrcWhenProvided)
+{
+    const CrashCatcherMemoryRegion regions[] = { {m_memoryStart, m_memoryStart + 2, CRASH_CATCHER_BYTE},
+                                                 {   0xFFFFFFFF,        0xFFFFFFFF, CRASH_CATCHER_BYTE} };
+
+    DumpMocks_SetMemoryRegions(regions);
+    g_crashCatcherEnableCrc32 = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    CHECK_TRUE(DumpMocks_GetHardwareCrc32CallCount() > 0);
+}
+
+TEST(CrashCatcher, DumpWordRegionWhichChangesDuringDump_Crc32_ShouldCalculateRegionCrcOverSentValue)
+{
+    const CrashCatcherMemoryRegion regions[] = { {m_fillMemoryStart, m_fillMemoryStart + 4, CRASH_CATCHER_WORD},
+                                                 {       0xFFFFFFFF,        0xFFFFFFFF, CRASH_CATCHER_BYTE} };
+    uint8_t                        dumpedBytes[64];
+    uint32_t                       sentWord;
+    uint32_t                       regionCrcs[1];
+
+    DumpMocks_SetMemoryRegions(regions);
+    m_fillMemory[0] = 0x12345678;
+    DumpMocks_SetHardwareCrc32ChangingWord(&m_fillMemory[0]);
+    g_crashCatcherEnableCrc32 = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    m_expectedFlags |= CRASH_CATCHER_FLAGS_CRC32;
+    CHECK_EQUAL(14, DumpMocks_GetDumpMemoryCallCount());
+    validateHeaderAndDumpedRegisters(USING_MSP);
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(8, &regions[0], CRASH_CATCHER_BYTE, 2 * sizeof(uint32_t)));
+    DumpMocks_CopyDumpedBytes(9, dumpedBytes, sizeof(dumpedBytes));
+    memcpy(&sentWord, dumpedBytes, sizeof(sentWord));
+    CHECK_TRUE(sentWord != 0x12345678);
+    CHECK_TRUE(m_fillMemory[0] != sentWord);
+    regionCrcs[0] = regionCrc32(&regions[0], &sentWord);
+    validateCrc32Trailer(10, regionCrcs, 1);
+}
+
+TEST(CrashCatcher, DumpOneDoubleByteRegion_Crc32NotEnabled_ShouldNotCalculateCrcs)
+{
+    const CrashCatcherMemoryRegion regions[] = { {m_memoryStart, m_memoryStart + 2, CRASH_CATCHER_BYTE},
+                                                 {   0xFFFFFFFF,        0xFFFFFFFF, CRASH_CATCHER_BYTE} };
+
+    DumpMocks_SetMemoryRegions(regions);
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    CHECK_EQUAL(10, DumpMocks_GetDumpMemoryCallCount());
+    CHECK_EQUAL(0, DumpMocks_GetHardwareCrc32CallCount());
+}
+
+TEST(CrashCatcher, DumpRegistersOnly_VectoredDump_ShouldSendHeaderAndRegistersInOneCall)
+{
+    g_crashCatcherEnableVectoredDump = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    CHECK_EQUAL(1, DumpMocks_GetDumpMemoryVectorCallCount());
+    CHECK_EQUAL(8, DumpMocks_GetLastDumpMemoryVectorCount());
+    CHECK_EQUAL(8, DumpMocks_GetDumpMemoryCallCount());
+    validateHeaderAndDumpedRegisters(USING_MSP);
+}
+
+TEST(CrashCatcher, DumpRegistersOnly_EnableCp10AndCp11_VectoredDump_ShouldIncludeFloatingPointRegistersInSameCall)
+{
+    m_emulatedCoprocessorAccessControlRegister = (3 << 20) | (3 << 22);
+    FloatMocks_SetAllFloatingPointRegisters(m_expectedFloatingPointRegisters);
+    g_crashCatcherEnableVectoredDump = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    m_expectedFlags |= CRASH_CATCHER_FLAGS_FLOATING_POINT;
+    CHECK_EQUAL(1, DumpMocks_GetDumpMemoryVectorCallCount());
+    CHECK_EQUAL(9, DumpMocks_GetLastDumpMemoryVectorCount());
+    CHECK_EQUAL(9, DumpMocks_GetDumpMemoryCallCount());
+    validateHeaderAndDumpedRegisters(USING_MSP);
+}
+
+TEST(CrashCatcher, DumpOneDoubleByteRegion_VectoredDump_ShouldSendRegionThroughDumpMemory)
+{
+    const CrashCatcherMemoryRegion regions[] = { {m_memoryStart, m_memoryStart + 2, CRASH_CATCHER_BYTE},
+                                                 {   0xFFFFFFFF,        0xFFFFFFFF, CRASH_CATCHER_BYTE} };
+
+    DumpMocks_SetMemoryRegions(regions);
+    g_crashCatcherEnableVectoredDump = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    CHECK_EQUAL(1, DumpMocks_GetDumpMemoryVectorCallCount());
+    CHECK_EQUAL(8, DumpMocks_GetLastDumpMemoryVectorCount());
+    CHECK_EQUAL(10, DumpMocks_GetDumpMemoryCallCount());
+    validateHeaderAndDumpedRegisters(USING_MSP);
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(8, &regions[0], CRASH_CATCHER_BYTE, 2 * sizeof(uint32_t)));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(9, m_memory, CRASH_CATCHER_BYTE, 2));
+}
+
+TEST(CrashCatcher, DumpRegistersOnly_CompressedAndVectoredDump_ShouldOnlyVectorHeaderAndFlags)
+{
+    g_crashCatcherEnableCompression = 1;
+    g_crashCatcherEnableVectoredDump = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    m_expectedFlags |= CRASH_CATCHER_FLAGS_COMPRESSED;
+    CHECK_EQUAL(1, DumpMocks_GetDumpMemoryVectorCallCount());
+    CHECK_EQUAL(2, DumpMocks_GetLastDumpMemoryVectorCount());
+    CHECK_EQUAL(3, DumpMocks_GetDumpMemoryCallCount());
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(0, g_expectedSignature, CRASH_CATCHER_BYTE, sizeof(g_expectedSignature)));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(1, &m_expectedFlags, CRASH_CATCHER_BYTE, sizeof(m_expectedFlags)));
+}
+
+TEST(CrashCatcher, DumpEndReturnTryAgainOnce_VectoredDump_ShouldSendVectorForEachDump)
+{
+    DumpMocks_SetDumpEndLoops(1);
+    g_crashCatcherEnableVectoredDump = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    CHECK_EQUAL(2, DumpMocks_GetDumpMemoryVectorCallCount());
+    CHECK_EQUAL(16, DumpMocks_GetDumpMemoryCallCount());
+}
+
+TEST(CrashCatcher, DumpRegistersOnly_VectoredDumpNotEnabled_ShouldOnlyUseDumpMemory)
+{
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    CHECK_EQUAL(0, DumpMocks_GetDumpMemoryVectorCallCount());
+    CHECK_EQUAL(8, DumpMocks_GetDumpMemoryCallCount());
+}
+
+TEST(CrashCatcher, DumpRegistersOnly_Backtrace_ShouldSendRecordWithOddCodeAddressesBeforeRegisters)
+{
+    static const uint32_t stack[] = { 0x08000101, 0x20000001, 0x08000200, 0x07FFFFFF, 0x08100001, 0x08000305 };
+    static const uint32_t returnAddresses[] = { 0x08000101, 0x08000305 };
+
+    setMSPWords(stack, sizeof(stack) / sizeof(stack[0]));
+    g_crashCatcherEnableBacktrace = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    CHECK_EQUAL(9, DumpMocks_GetDumpMemoryCallCount());
+    validateBacktrace(returnAddresses, 2);
+    validateHeaderAndDumpedRegisters(USING_MSP);
+}
+
+TEST(CrashCatcher, DumpRegistersOnly_EmulateCortexM3_Backtrace_ShouldIncludeFaultStatusRegistersInRecord)
+{
+    CrashCatcherBacktraceRecord expectedRecord;
+
+    setMSPWords(NULL, 0);
+    m_emulatedCpuId = cpuIdCortexM3;
+    m_emulatedFaultStatusRegisters.CFSR = 0x12345678;
+    m_emulatedFaultStatusRegisters.HFSR = 0x11111111;
+    m_emulatedFaultStatusRegisters.MMFAR = 0x33333333;
+    m_emulatedFaultStatusRegisters.BFAR = 0x44444444;
+    g_crashCatcherEnableBacktrace = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    m_expectedFlags |= CRASH_CATCHER_FLAGS_BACKTRACE;
+    initExpectedBacktrace(&expectedRecord, NULL, 0);
+    expectedRecord.CFSR = 0x12345678;
+    expectedRecord.HFSR = 0x11111111;
+    expectedRecord.MMFAR = 0x33333333;
+    expectedRecord.BFAR = 0x44444444;
+    CHECK_EQUAL(11, DumpMocks_GetDumpMemoryCallCount());
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(2, &expectedRecord, CRASH_CATCHER_BYTE, sizeof(expectedRecord)));
+    validateHeaderAndDumpedRegisters(USING_MSP);
+}
+
+TEST(CrashCatcher, DumpRegistersOnly_BacktraceWithMoreReturnAddressesThanSlots_ShouldKeepThoseClosestToSP)
+{
+    uint32_t stack[16 + 1];
+
+    for (size_t i = 0 ; i < sizeof(stack) / sizeof(stack[0]) ; i++)
+        stack[i] = CODE_START + 0x101 + 0x10 * i;
+    setMSPWords(stack, sizeof(stack) / sizeof(stack[0]));
+    g_crashCatcherEnableBacktrace = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    validateBacktrace(stack, CRASH_CATCHER_BACKTRACE_MAX_ADDRESSES);
+}
+
+TEST(CrashCatcher, DumpRegistersOnly_BacktraceWithSPAtTopOfStack_ShouldSendRecordWithoutAddresses)
+{
+    m_emulatedVectorTable[0] = m_expectedSP;
+    setMSPWords(NULL, 0);
+    m_emulatedMSP[8] = 0x08000101;
+    g_crashCatcherEnableBacktrace = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    validateBacktrace(NULL, 0);
+}
+
+TEST(CrashCatcher, DumpRegistersOnly_BacktraceOfFaultInNestedHandler_ShouldAddInterruptedPCAndLR)
+{
+    // The handler pushed r4 and EXC_RETURN before the exception frame of the code which it interrupted.
+    static const uint32_t stack[] = { 0x44444444, EXC_RETURN_MSP,
+                                      0, 1, 2, 3, 12, 0x08000401, 0x08000500, STACKED_PSR,
+                                      0x08000601 };
+    static const uint32_t returnAddresses[] = { 0x08000500, 0x08000401, 0x08000601 };
+
+    setMSPWords(stack, sizeof(stack) / sizeof(stack[0]));
+    g_crashCatcherEnableBacktrace = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    validateBacktrace(returnAddresses, 3);
+}
+
+TEST(CrashCatcher, DumpRegistersOnly_BacktraceOfFaultInLeafHandler_ShouldFindExceptionFrameAtSPFromLR)
+{
+    static const uint32_t stack[] = { 0, 1, 2, 3, 12, 0x08000401, 0x08000500, STACKED_PSR | PSR_STACK_ALIGN,
+                                      0xBAADF00D, 0x08000601 };
+    static const uint32_t returnAddresses[] = { 0x08000500, 0x08000401, 0x08000601 };
+
+    m_emulatedMSP[5] = EXC_RETURN_MSP;
+    setMSPWords(stack, sizeof(stack) / sizeof(stack[0]));
+    g_crashCatcherEnableBacktrace = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    validateBacktrace(returnAddresses, 3);
+}
+
+TEST(CrashCatcher, DumpRegistersOnly_BacktraceOfHandlerWhichInterruptedThread_ShouldContinueOnThreadStack)
+{
+    static const uint32_t stack[] = { EXC_RETURN_PSP, 0x08000701 };
+    static const uint32_t returnAddresses[] = { 0x08000500, 0x08000401, 0x08000601 };
+
+    m_emulatedPSP[5] = 0x08000401;
+    m_emulatedPSP[6] = 0x08000500;
+    m_emulatedPSP[7] = STACKED_PSR;
+    m_emulatedPSP[8] = 0x08000601;
+    memset(&m_emulatedPSP[9], 0, 3 * sizeof(uint32_t));
+    DumpMocks_SetThreadStackTop((uint32_t)(unsigned long)&m_emulatedPSP[8 + 4]);
+    setMSPWords(stack, sizeof(stack) / sizeof(stack[0]));
+    g_crashCatcherEnableBacktrace = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    validateBacktrace(returnAddresses, 3);
+}
+
+TEST(CrashCatcher, DumpRegistersOnly_BacktraceWithWordWhichOnlyLooksLikeExcReturn_ShouldKeepScanning)
+{
+    // The PSR which would be stacked after this fake EXC_RETURN doesn't have the Thumb bit set.
+    static const uint32_t stack[] = { EXC_RETURN_MSP, 0x08000101 };
+    static const uint32_t returnAddresses[] = { 0x08000101 };
+
+    setMSPWords(stack, sizeof(stack) / sizeof(stack[0]));
+    g_crashCatcherEnableBacktrace = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    validateBacktrace(returnAddresses, 1);
+}
+
+TEST(CrashCatcher, DumpRegistersOnly_CompressedAndBacktrace_ShouldSendRecordUncompressed)
+{
+    static const uint32_t stack[] = { 0x08000101 };
+
+    setMSPWords(stack, sizeof(stack) / sizeof(stack[0]));
+    g_crashCatcherEnableCompression = 1;
+    g_crashCatcherEnableBacktrace = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    m_expectedFlags |= CRASH_CATCHER_FLAGS_COMPRESSED;
+    CHECK_EQUAL(4, DumpMocks_GetDumpMemoryCallCount());
+    validateBacktrace(stack, 1);
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(1, &m_expectedFlags, CRASH_CATCHER_BYTE, sizeof(m_expectedFlags)));
+}
+
+TEST(CrashCatcher, DumpEndReturnTryAgainOnce_BacktraceAndVectoredDump_ShouldSendSameRecordInEachVector)
+{
+    static const uint32_t stack[] = { 0x08000101 };
+
+    setMSPWords(stack, sizeof(stack) / sizeof(stack[0]));
+    DumpMocks_SetDumpEndLoops(1);
+    g_crashCatcherEnableBacktrace = 1;
+    g_crashCatcherEnableVectoredDump = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    CHECK_EQUAL(2, DumpMocks_GetDumpMemoryVectorCallCount());
+    CHECK_EQUAL(9, DumpMocks_GetLastDumpMemoryVectorCount());
+    CHECK_EQUAL(18, DumpMocks_GetDumpMemoryCallCount());
+    validateBacktrace(stack, 1);
+    validateBacktrace(stack, 1, 9 + 2);
+}
+
+TEST(CrashCatcher, DumpRegistersOnly_TwoTier_ShouldSendFaultCauseAndTopOfStackInTier1)
+{
+    setMSPWords(NULL, 0);
+    g_crashCatcherEnableTwoTier = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    m_expectedFlags |= CRASH_CATCHER_FLAGS_TWO_TIER;
+    CHECK_EQUAL(13, DumpMocks_GetDumpMemoryCallCount());
+    validateHeaderAndDumpedRegisters(USING_MSP);
+    validateFaultCause(8, CRASH_CATCHER_FAULT_UNKNOWN, 0, 0);
+    validateStackRegion(9, &m_emulatedMSP[8], &m_emulatedMSP[8 + 16 + 1]);
+    validateTierEnd(11, 1, 0);
+    validateTierEnd(12, 2, 0);
+}
+
+TEST(CrashCatcher, DumpOneWordRegion_EmulateCortexM3_TwoTier_ShouldMoveFaultStatusRegistersToTier1)
+{
+    static const CrashCatcherMemoryRegion regions[] = { {m_memoryStart, m_memoryStart + 4, CRASH_CATCHER_WORD},
+                                                        {   0xFFFFFFFF,        0xFFFFFFFF, CRASH_CATCHER_BYTE} };
+    CrashCatcherMemoryRegion faultStatusRegion = {m_faultStatusRegistersStart,
+                                                  m_faultStatusRegistersStart + (uint32_t)sizeof(FaultStatusRegisters),
+                                                  CRASH_CATCHER_WORD};
+
+    setMSPWords(NULL, 0);
+    DumpMocks_SetMemoryRegions(regions);
+    m_emulatedCpuId = cpuIdCortexM3;
+    m_emulatedFaultStatusRegisters.CFSR = CFSR_DACCVIOL | CFSR_MMARVALID;
+    m_emulatedFaultStatusRegisters.MMFAR = 0x33333333;
+    g_crashCatcherEnableTwoTier = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    m_expectedFlags |= CRASH_CATCHER_FLAGS_TWO_TIER;
+    CHECK_EQUAL(17, DumpMocks_GetDumpMemoryCallCount());
+    validateHeaderAndDumpedRegisters(USING_MSP);
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(8, &faultStatusRegion, CRASH_CATCHER_BYTE, 2 * sizeof(uint32_t)));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(9, &m_emulatedFaultStatusRegisters, CRASH_CATCHER_WORD, 5));
+    validateFaultCause(10, CRASH_CATCHER_FAULT_DATA_ACCESS, 1, 0x33333333);
+    validateStackRegion(11, &m_emulatedMSP[8], &m_emulatedMSP[8 + 16 + 1]);
+    validateTierEnd(13, 1, 0);
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(14, &regions[0], CRASH_CATCHER_BYTE, 2 * sizeof(uint32_t)));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(15, m_memory, CRASH_CATCHER_WORD, 1));
+    validateTierEnd(16, 2, 0);
+}
+
+TEST(CrashCatcher, DumpRegistersOnly_TwoTierWithSmallTier1Stack_ShouldOnlySendThatMuchOfStack)
+{
+    setMSPWords(NULL, 0);
+    g_crashCatcherEnableTwoTier = 1;
+    g_crashCatcherTier1StackSize = 4 * sizeof(uint32_t);
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    CHECK_EQUAL(13, DumpMocks_GetDumpMemoryCallCount());
+    validateStackRegion(9, &m_emulatedMSP[8], &m_emulatedMSP[8 + 4]);
+}
+
+TEST(CrashCatcher, DumpRegistersOnly_TwoTierWithSPAtTopOfStack_ShouldSendNoStackInTier1)
+{
+    m_emulatedVectorTable[0] = m_expectedSP;
+    g_crashCatcherEnableTwoTier = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    CHECK_EQUAL(11, DumpMocks_GetDumpMemoryCallCount());
+    validateTierEnd(9, 1, 0);
+    validateTierEnd(10, 2, 0);
+}
+
+TEST(CrashCatcher, Minidump_TwoTier_ShouldSendRestOfStackInTier2)
+{
+    setMSPWords(NULL, 0);
+    g_crashCatcherEnableMinidump = 1;
+    g_crashCatcherEnableTwoTier = 1;
+    g_crashCatcherTier1StackSize = 4 * sizeof(uint32_t);
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    m_expectedFlags |= CRASH_CATCHER_FLAGS_MINIDUMP | CRASH_CATCHER_FLAGS_TWO_TIER;
+    CHECK_EQUAL(15, DumpMocks_GetDumpMemoryCallCount());
+    validateHeaderAndDumpedRegisters(USING_MSP);
+    validateStackRegion(9, &m_emulatedMSP[8], &m_emulatedMSP[8 + 4]);
+    validateTierEnd(11, 1, 0);
+    validateStackRegion(12, &m_emulatedMSP[8 + 4], &m_emulatedMSP[8 + 16 + 1]);
+    validateTierEnd(14, 2, 0);
+}
+
+TEST(CrashCatcher, Minidump_TwoTierWithWholeStackInTier1_ShouldSendNoStackInTier2)
+{
+    setMSPWords(NULL, 0);
+    g_crashCatcherEnableMinidump = 1;
+    g_crashCatcherEnableTwoTier = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    CHECK_EQUAL(13, DumpMocks_GetDumpMemoryCallCount());
+    validateStackRegion(9, &m_emulatedMSP[8], &m_emulatedMSP[8 + 16 + 1]);
+    validateTierEnd(11, 1, 0);
+    validateTierEnd(12, 2, 0);
+}
+
+TEST(CrashCatcher, DumpRegistersOnly_TwoTierAndCrc32_ShouldSendCrcOfEverythingBeforeEachTierEnd)
+{
+    uint8_t  dumpedBytes[512];
+    uint8_t  tailBytes[512];
+    size_t   dumpedSize;
+    size_t   tier1Size;
+    size_t   tier2Size;
+    uint32_t regionCrcs[1];
+
+    setMSPWords(NULL, 0);
+    g_crashCatcherEnableTwoTier = 1;
+    g_crashCatcherEnableCrc32 = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    m_expectedFlags |= CRASH_CATCHER_FLAGS_TWO_TIER | CRASH_CATCHER_FLAGS_CRC32;
+    // The stack is larger than CRASH_CATCHER_CRC32_COPY_SIZE so it is copied and sent in two pieces.
+    CHECK_EQUAL(18, DumpMocks_GetDumpMemoryCallCount());
+    validateHeaderAndDumpedRegisters(USING_MSP);
+    // Each tier end covers the bytes from the start of the dump up to the items which follow it.
+    dumpedSize = DumpMocks_CopyDumpedBytes(0, dumpedBytes, sizeof(dumpedBytes));
+    tier1Size = dumpedSize - DumpMocks_CopyDumpedBytes(12, tailBytes, sizeof(tailBytes));
+    tier2Size = dumpedSize - DumpMocks_CopyDumpedBytes(13, tailBytes, sizeof(tailBytes));
+    validateTierEnd(12, 1, CrashCatcher_Crc32(0, dumpedBytes, tier1Size));
+    validateTierEnd(13, 2, CrashCatcher_Crc32(0, dumpedBytes, tier2Size));
+    CrashCatcherMemoryRegion stackRegion = { m_expectedSP, m_emulatedVectorTable[0], CRASH_CATCHER_BYTE };
+    regionCrcs[0] = regionCrc32(&stackRegion, &m_emulatedMSP[8]);
+    validateCrc32Trailer(14, regionCrcs, 1);
+}
+
+TEST(CrashCatcher, DumpRegistersOnly_TwoTierAndBKPT_ShouldReportBreakpointCause)
+{
+    emulateBKPT(0);
+    g_crashCatcherEnableTwoTier = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    validateFaultCause(8, CRASH_CATCHER_FAULT_BREAKPOINT, 0, 0);
+}
+
+TEST(CrashCatcher, FaultCause_DebugEvent_ShouldReportBreakpoint)
+{
+    emulateCortexM3TwoTierFault(0, HFSR_DEBUGEVT);
+    validateFaultCause(10, CRASH_CATCHER_FAULT_BREAKPOINT, 0, 0);
+}
+
+TEST(CrashCatcher, FaultCause_VectorTableRead_ShouldBeReportedBeforeCfsrBits)
+{
+    emulateCortexM3TwoTierFault(CFSR_UNDEFINSTR, HFSR_VECTTBL);
+    validateFaultCause(10, CRASH_CATCHER_FAULT_VECTOR_TABLE_READ, 0, 0);
+}
+
+TEST(CrashCatcher, FaultCause_StackingAndPreciseBusFault_ShouldReportStackingWithBusFaultAddress)
+{
+    emulateCortexM3TwoTierFault(CFSR_STKERR | CFSR_PRECISERR | CFSR_BFARVALID, 0);
+    validateFaultCause(10, CRASH_CATCHER_FAULT_STACKING, 1, 0x44444444);
+}
+
+TEST(CrashCatcher, FaultCause_StackOverflowOnARMv8M_ShouldReportStacking)
+{
+    emulateCortexM3TwoTierFault(CFSR_STKOF, 0);
+    validateFaultCause(10, CRASH_CATCHER_FAULT_STACKING, 0, 0);
+}
+
+TEST(CrashCatcher, FaultCause_InstructionBusError_ShouldReportInstructionAccess)
+{
+    emulateCortexM3TwoTierFault(CFSR_IBUSERR, 0);
+    validateFaultCause(10, CRASH_CATCHER_FAULT_INSTRUCTION_ACCESS, 0, 0);
+}
+
+TEST(CrashCatcher, FaultCause_PreciseBusFaultWithoutValidAddress_ShouldReportDataAccessWithoutAddress)
+{
+    emulateCortexM3TwoTierFault(CFSR_PRECISERR, 0);
+    validateFaultCause(10, CRASH_CATCHER_FAULT_DATA_ACCESS, 0, 0);
+}
+
+TEST(CrashCatcher, FaultCause_ImpreciseBusFault_ShouldReportImpreciseDataAccess)
+{
+    emulateCortexM3TwoTierFault(CFSR_IMPRECISERR, 1U << 30);
+    validateFaultCause(10, CRASH_CATCHER_FAULT_IMPRECISE_DATA_ACCESS, 0, 0);
+}
+
+TEST(CrashCatcher, FaultCause_UndefinedInstruction_ShouldReportUndefinedInstruction)
+{
+    emulateCortexM3TwoTierFault(CFSR_UNDEFINSTR, 0);
+    validateFaultCause(10, CRASH_CATCHER_FAULT_UNDEFINED_INSTRUCTION, 0, 0);
+}
+
+TEST(CrashCatcher, FaultCause_InvalidPC_ShouldReportInvalidState)
+{
+    emulateCortexM3TwoTierFault(CFSR_INVPC, 0);
+    validateFaultCause(10, CRASH_CATCHER_FAULT_INVALID_STATE, 0, 0);
+}
+
+TEST(CrashCatcher, FaultCause_NoCoprocessor_ShouldReportNoCoprocessor)
+{
+    emulateCortexM3TwoTierFault(CFSR_NOCP, 0);
+    validateFaultCause(10, CRASH_CATCHER_FAULT_NO_COPROCESSOR, 0, 0);
+}
+
+TEST(CrashCatcher, FaultCause_UnalignedAndDivideByZero_ShouldReportUnalignedAccess)
+{
+    emulateCortexM3TwoTierFault(CFSR_UNALIGNED | CFSR_DIVBYZERO, 0);
+    validateFaultCause(10, CRASH_CATCHER_FAULT_UNALIGNED_ACCESS, 0, 0);
+}
+
+TEST(CrashCatcher, FaultCause_DivideByZero_ShouldReportDivideByZero)
+{
+    emulateCortexM3TwoTierFault(CFSR_DIVBYZERO, 0);
+    validateFaultCause(10, CRASH_CATCHER_FAULT_DIVIDE_BY_ZERO, 0, 0);
+}
+
+TEST(CrashCatcher, FaultCause_NoFaultBits_ShouldReportUnknown)
+{
+    emulateCortexM3TwoTierFault(0, 0);
+    validateFaultCause(10, CRASH_CATCHER_FAULT_UNKNOWN, 0, 0);
+}
+
+
+TEST(CrashCatcher, DumpOneDoubleByteRegion_Retained_ShouldCaptureIntoBufferAndResetWithoutCallingDumpRoutines)
+{
+    const CrashCatcherMemoryRegion regions[] = { {m_memoryStart, m_memoryStart + 2, CRASH_CATCHER_BYTE},
+                                                 {   0xFFFFFFFF,        0xFFFFFFFF, CRASH_CATCHER_BYTE} };
+
+    DumpMocks_SetMemoryRegions(regions);
+    captureRetainedDump();
+    CHECK_EQUAL(0, DumpMocks_GetDumpStartCallCount());
+    CHECK_EQUAL(0, DumpMocks_GetDumpMemoryCallCount());
+    CHECK_EQUAL(0, DumpMocks_GetDumpEndCallCount());
+    CHECK_EQUAL(AIRCR_VECTKEY | AIRCR_SYSRESETREQ, m_emulatedResetControlRegister);
+    CHECK_EQUAL(CRASH_CATCHER_RETAINED_SIGNATURE, retainedHeader()->signature);
+    CHECK_EQUAL(0, retainedHeader()->droppedSize);
+    CHECK_TRUE(CrashCatcher_HasRetainedDump());
+}
+
+TEST(CrashCatcher, DumpOneDoubleByteRegion_Retained_ShouldPreservePriorityGroupingWhenRequestingReset)
+{
+    const CrashCatcherMemoryRegion regions[] = { {m_memoryStart, m_memoryStart + 2, CRASH_CATCHER_BYTE},
+                                                 {   0xFFFFFFFF,        0xFFFFFFFF, CRASH_CATCHER_BYTE} };
+
+    // Reads of the AIRCR return VECTKEYSTAT (0xFA05) in the key field.
+    m_emulatedResetControlRegister = 0xFA050000 | (5 << 8);
+    DumpMocks_SetMemoryRegions(regions);
+    captureRetainedDump();
+    CHECK_EQUAL(AIRCR_VECTKEY | (5 << 8) | AIRCR_SYSRESETREQ, m_emulatedResetControlRegister);
+}
+
+TEST(CrashCatcher, DumpOneDoubleByteRegion_Retained_EmitShouldSendSameBytesAsRegularDump)
+{
+    const CrashCatcherMemoryRegion regions[] = { {m_memoryStart, m_memoryStart + 2, CRASH_CATCHER_BYTE},
+                                                 {   0xFFFFFFFF,        0xFFFFFFFF, CRASH_CATCHER_BYTE} };
+
+    DumpMocks_SetMemoryRegions(regions);
+    g_crashCatcherEnableCrc32 = 1;
+    captureRetainedDump();
+    emitRetainedDump();
+    CHECK_EQUAL(1, DumpMocks_GetDumpStartCallCount());
+    CHECK_EQUAL(1, DumpMocks_GetDumpMemoryCallCount());
+    CHECK_EQUAL(1, DumpMocks_GetDumpEndCallCount());
+    validateDumpStartInfo();
+    validateEmittedDumpMatchesRegularDump(retainedHeader()->size);
+    CHECK_TRUE(CrashCatcher_HasRetainedDump());
+}
+
+TEST(CrashCatcher, DumpOneDoubleByteRegion_RetainedAndCompressed_EmitShouldSendSameCompressedBlocksAsRegularDump)
+{
+    const CrashCatcherMemoryRegion regions[] = { {m_memoryStart, m_memoryStart + 2, CRASH_CATCHER_BYTE},
+                                                 {   0xFFFFFFFF,        0xFFFFFFFF, CRASH_CATCHER_BYTE} };
+
+    DumpMocks_SetMemoryRegions(regions);
+    g_crashCatcherEnableCompression = 1;
+    captureRetainedDump();
+    emitRetainedDump();
+    validateEmittedDumpMatchesRegularDump(retainedHeader()->size);
+}
+
+TEST(CrashCatcher, DumpRegionContainingRetainedBuffer_Retained_ShouldOnlyCaptureMemoryOnEitherSideOfBuffer)
+{
+    uint8_t*       pMemory = (uint8_t*)m_retainedBuffer;
+    const uint32_t start = (uint32_t)(unsigned long)pMemory;
+    const uint32_t end = start + (uint32_t)sizeof(m_retainedBuffer);
+    const uint32_t lowerSize = 32;
+    const uint32_t bufferSize = (uint32_t)sizeof(CrashCatcherRetainedHeader) + 320;
+    const uint32_t upperStart = lowerSize + bufferSize;
+    const uint32_t upperSize = (uint32_t)sizeof(m_retainedBuffer) - upperStart;
+    const CrashCatcherMemoryRegion regions[] = { {     start,        end, CRASH_CATCHER_BYTE},
+                                                 {0xFFFFFFFF, 0xFFFFFFFF, CRASH_CATCHER_BYTE} };
+    const uint32_t lowerRegion[2] = { start, start + lowerSize };
+    const uint32_t upperRegion[2] = { start + upperStart, end };
+    uint8_t        expected[sizeof(m_retainedBuffer)];
+    uint8_t        emitted[1024];
+    size_t         emittedSize;
+    uint8_t*       pCurr;
+
+    for (size_t i = 0 ; i < sizeof(m_retainedBuffer) ; i++)
+        pMemory[i] = i * 7;
+    memcpy(expected, pMemory, sizeof(expected));
+    DumpMocks_SetMemoryRegions(regions);
+    DumpMocks_SetRetainedBuffer(pMemory + lowerSize, bufferSize);
+    g_crashCatcherEnableRetained = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    g_crashCatcherEnableRetained = 0;
+    m_isDumpStartExpected = false;
+
+    CHECK_EQUAL(0, ((CrashCatcherRetainedHeader*)(pMemory + lowerSize))->droppedSize);
+    emitRetainedDump();
+    emittedSize = DumpMocks_CopyDumpedBytes(0, emitted, sizeof(emitted));
+    CHECK_TRUE(emittedSize > 2 * sizeof(lowerRegion) + lowerSize + upperSize);
+    // The registers are followed by the two parts of the region and nothing else on this Cortex-M0.
+    pCurr = emitted + emittedSize - (2 * sizeof(lowerRegion) + lowerSize + upperSize);
+    MEMCMP_EQUAL(lowerRegion, pCurr, sizeof(lowerRegion));
+    pCurr += sizeof(lowerRegion);
+    MEMCMP_EQUAL(expected, pCurr, lowerSize);
+    pCurr += lowerSize;
+    MEMCMP_EQUAL(upperRegion, pCurr, sizeof(upperRegion));
+    pCurr += sizeof(upperRegion);
+    MEMCMP_EQUAL(expected + upperStart, pCurr, upperSize);
+}
+
+TEST(CrashCatcher, DumpRegistersOnly_RetainedAndVectoredDump_ShouldNotCallDumpMemoryVector)
+{
+    g_crashCatcherEnableVectoredDump = 1;
+    captureRetainedDump();
+    CHECK_EQUAL(0, DumpMocks_GetDumpMemoryVectorCallCount());
+    emitRetainedDump();
+    validateEmittedDumpMatchesRegularDump(retainedHeader()->size);
+}
+
+TEST(CrashCatcher, DumpRegistersOnly_RetainedBKPT_ShouldCaptureAndContinueWithoutReset)
+{
+    uint32_t expectedPC = m_emulatedMSP[6] + 2;
+
+    emulateBKPT(3);
+    captureRetainedDump();
+    CHECK_EQUAL(0, m_emulatedResetControlRegister);
+    CHECK_EQUAL(expectedPC, m_emulatedMSP[6]);
+    emitRetainedDump();
+    validateDumpStartInfo();
+}
+
+TEST(CrashCatcher, DumpRegistersOnly_RetainedIntoSmallBuffer_ShouldKeepStartOfDumpAndCountDroppedBytes)
+{
+    captureRetainedDump(sizeof(CrashCatcherRetainedHeader) + 16);
+    CHECK_EQUAL(16, retainedHeader()->size);
+    CHECK_TRUE(retainedHeader()->droppedSize > 0);
+    emitRetainedDump();
+    validateEmittedDumpMatchesRegularDump(16);
+}
+
+TEST(CrashCatcher, DumpRegistersOnly_RetainedWithoutBuffer_ShouldSendRegularDump)
+{
+    captureRetainedDump(sizeof(CrashCatcherRetainedHeader));
+    m_isDumpStartExpected = true;
+    CHECK_EQUAL(1, DumpMocks_GetDumpStartCallCount());
+    CHECK_EQUAL(8, DumpMocks_GetDumpMemoryCallCount());
+    CHECK_EQUAL(0, m_emulatedResetControlRegister);
+    CHECK_FALSE(CrashCatcher_HasRetainedDump());
+}
+
+TEST(CrashCatcher, DumpRegistersOnly_RetainedNotEnabled_ShouldLeaveBufferEmpty)
+{
+    DumpMocks_SetRetainedBuffer(m_retainedBuffer, sizeof(m_retainedBuffer));
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    CHECK_EQUAL(1, DumpMocks_GetDumpStartCallCount());
+    CHECK_FALSE(CrashCatcher_HasRetainedDump());
+    CHECK_FALSE(CrashCatcher_EmitRetainedDump());
+    CHECK_EQUAL(1, DumpMocks_GetDumpStartCallCount());
+}
+
+TEST(CrashCatcher, DumpRegistersOnly_RetainedThenCorrupted_ShouldNotBeEmitted)
+{
+    captureRetainedDump();
+    ((uint8_t*)(retainedHeader() + 1))[10] ^= 1;
+    CHECK_FALSE(CrashCatcher_HasRetainedDump());
+    CHECK_FALSE(CrashCatcher_EmitRetainedDump());
+    CHECK_EQUAL(0, DumpMocks_GetDumpStartCallCount());
+
+    ((uint8_t*)(retainedHeader() + 1))[10] ^= 1;
+    retainedHeader()->size = sizeof(m_retainedBuffer);
+    CHECK_FALSE(CrashCatcher_HasRetainedDump());
+}
+
+TEST(CrashCatcher, DumpRegistersOnly_RetainedThenDiscarded_ShouldNotBeEmitted)
+{
+    captureRetainedDump();
+    CrashCatcher_DiscardRetainedDump();
+    CHECK_FALSE(CrashCatcher_HasRetainedDump());
+    CHECK_FALSE(CrashCatcher_EmitRetainedDump());
+}
+
+TEST(CrashCatcher, DumpRegistersOnly_RetainedAndEmitWithDumpEndReturnTryAgainOnce_ShouldSendTwice)
+{
+    captureRetainedDump();
+    DumpMocks_SetDumpEndLoops(1);
+    emitRetainedDump();
+    CHECK_EQUAL(2, DumpMocks_GetDumpStartCallCount());
+    CHECK_EQUAL(2, DumpMocks_GetDumpMemoryCallCount());
+    CHECK_EQUAL(2, DumpMocks_GetDumpEndCallCount());
+}
+
+TEST(CrashCatcher, DumpRegistersOnly_Pipelined_ShouldSendSameBytesThroughOneTransferInsteadOfDumpMemory)
+{
+    g_crashCatcherEnablePipeline = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    CHECK_EQUAL(1, DumpMocks_GetDumpStartCallCount());
+    CHECK_EQUAL(0, DumpMocks_GetDumpMemoryCallCount());
+    CHECK_EQUAL(1, DumpMocks_GetDumpEndCallCount());
+    CHECK_EQUAL(1, DmaSim_GetTransferCount());
+    CHECK_EQUAL(0, DmaSim_GetErrorCount());
+    validatePipelinedDumpMatchesRegularDump();
+}
+
+TEST(CrashCatcher, DumpLargeRegion_Pipelined_ShouldSendFullStagingBuffersWithoutTouchingThemInFlight)
+{
+    CrashCatcherMemoryRegion regions[1 + 1];
+
+    setPipelineMemoryRegions(regions, 1);
+    DmaSim_Init(10, 100);
+    g_crashCatcherEnablePipeline = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    CHECK_EQUAL(0, DumpMocks_GetDumpMemoryCallCount());
+    CHECK_EQUAL(CRASH_CATCHER_PIPELINE_BUFFER_SIZE, DmaSim_GetLargestTransferSize());
+    CHECK_EQUAL((DmaSim_GetDataSize() + CRASH_CATCHER_PIPELINE_BUFFER_SIZE - 1) / CRASH_CATCHER_PIPELINE_BUFFER_SIZE,
+                DmaSim_GetTransferCount());
+    CHECK_EQUAL(0, DmaSim_GetErrorCount());
+    validatePipelinedDumpMatchesRegularDump();
+}
+
+TEST(CrashCatcher, DumpManyRegions_PipelinedWithSlowTransport_ShouldOverlapFillingWithTransfers)
+{
+    static const uint32_t    microsecondsPerByte = 4;
+    static const uint32_t    microsecondsPerPoll = 50;
+    CrashCatcherMemoryRegion regions[16 + 1];
+    uint32_t                 dumpMemoryCalls;
+    uint64_t                 serialMicroseconds;
+
+    setPipelineMemoryRegions(regions, 16);
+    DmaSim_Init(microsecondsPerByte, microsecondsPerPoll);
+    g_crashCatcherEnablePipeline = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    CHECK_EQUAL(0, DmaSim_GetErrorCount());
+    CHECK_TRUE(DmaSim_GetBusyPollCount() > 0);
+    // Sending each part of the dump with a blocking CrashCatcher_DumpMemory() call would take the time to do the work
+    // for every part plus the time to send every byte.
+    dumpMemoryCalls = validatePipelinedDumpMatchesRegularDump();
+    serialMicroseconds = dumpMemoryCalls * microsecondsPerPoll + DmaSim_GetTransferMicroseconds();
+    CHECK_TRUE(DmaSim_GetElapsedMicroseconds() < serialMicroseconds);
+    CHECK_TRUE(DmaSim_GetElapsedMicroseconds() >= DmaSim_GetTransferMicroseconds());
+}
+
+TEST(CrashCatcher, DumpFourRegions_PipelinedAndCompressed_ShouldSendSameCompressedBlocks)
+{
+    CrashCatcherMemoryRegion regions[4 + 1];
+
+    setPipelineMemoryRegions(regions, 4);
+    g_crashCatcherEnableCompression = 1;
+    g_crashCatcherEnablePipeline = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    CHECK_EQUAL(0, DumpMocks_GetDumpMemoryCallCount());
+    CHECK_EQUAL(0, DmaSim_GetErrorCount());
+    validatePipelinedDumpMatchesRegularDump();
+}
+
+TEST(CrashCatcher, DumpRegistersOnly_PipelinedWithDumpEndReturnTryAgainOnce_ShouldSendTwice)
+{
+    size_t singleSize;
+
+    g_crashCatcherEnablePipeline = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    singleSize = DmaSim_GetDataSize();
+    DmaSim_Init(0, 0);
+    DumpMocks_SetDumpEndLoops(1);
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    CHECK_EQUAL(2, DmaSim_GetTransferCount());
+    CHECK_EQUAL(2 * singleSize, DmaSim_GetDataSize());
+    MEMCMP_EQUAL(DmaSim_GetData(), DmaSim_GetData() + singleSize, singleSize);
+}
+
+TEST(CrashCatcher, DumpRegistersOnly_RetainedAndPipelined_ShouldCaptureIntoRetainedBufferInstead)
+{
+    g_crashCatcherEnablePipeline = 1;
+    captureRetainedDump();
+    CHECK_EQUAL(0, DmaSim_GetTransferCount());
+    CHECK_TRUE(CrashCatcher_HasRetainedDump());
+}
+
+TEST(CrashCatcher, DumpOneDoubleByteRegion_Timing_ShouldAppendRecordWithCyclesForEachPhaseAndRegion)
+{
+    const CrashCatcherMemoryRegion regions[] = { {m_memoryStart, m_memoryStart + 2, CRASH_CATCHER_BYTE},
+                                                 {   0xFFFFFFFF,        0xFFFFFFFF, CRASH_CATCHER_BYTE} };
+    const uint32_t           regionSizes[] = { 2, sizeof(FaultStatusRegisters) };
+    CrashCatcherTimingRecord expectedRecord;
+
+    DumpMocks_SetMemoryRegions(regions);
+    enableTiming();
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    CHECK_EQUAL(13, DumpMocks_GetDumpMemoryCallCount());
+    validateHeaderAndDumpedRegisters(USING_MSP);
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(9, m_memory, CRASH_CATCHER_BYTE, 2));
+    initExpectedTiming(&expectedRecord, 1, regionSizes, 2);
+    validateTiming(12, &expectedRecord);
+    CHECK_EQUAL(DEMCR_TRCENA, m_emulatedDebugExceptionMonitorControlRegister);
+    CHECK_EQUAL(DWT_CTRL_CYCCNTENA, m_emulatedDwtControlRegister);
+}
+
+TEST(CrashCatcher, DumpEndReturnTryAgainOnce_Timing_ShouldReportPreviousDumpEndInSecondRecord)
+{
+    const uint32_t           regionSizes[] = { sizeof(FaultStatusRegisters) };
+    CrashCatcherTimingRecord expectedRecord;
+
+    DumpMocks_SetDumpEndLoops(1);
+    enableTiming();
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    CHECK_EQUAL(2, DumpMocks_GetDumpStartCallCount());
+    CHECK_EQUAL(22, DumpMocks_GetDumpMemoryCallCount());
+    initExpectedTiming(&expectedRecord, 1, regionSizes, 1);
+    validateTiming(10, &expectedRecord);
+    initExpectedTiming(&expectedRecord, 2, regionSizes, 1);
+    validateTiming(21, &expectedRecord);
+}
+
+TEST(CrashCatcher, DumpMoreRegionsThanTimingSlots_Timing_ShouldOnlyTimeFirstRegionsButCountAllBytes)
+{
+    CrashCatcherMemoryRegion regions[CRASH_CATCHER_TIMING_MAX_REGIONS + 1];
+    uint32_t                 regionSizes[CRASH_CATCHER_TIMING_MAX_REGIONS + 1];
+    CrashCatcherTimingRecord expectedRecord;
+
+    for (int i = 0 ; i < CRASH_CATCHER_TIMING_MAX_REGIONS ; i++)
+    {
+        CrashCatcherMemoryRegion region = {m_memoryStart, m_memoryStart + (i & 7) + 1, CRASH_CATCHER_BYTE};
+        regions[i] = region;
+        regionSizes[i] = (i & 7) + 1;
+    }
+    regions[CRASH_CATCHER_TIMING_MAX_REGIONS].startAddress = 0xFFFFFFFF;
+    regionSizes[CRASH_CATCHER_TIMING_MAX_REGIONS] = sizeof(FaultStatusRegisters);
+
+    DumpMocks_SetMemoryRegions(regions);
+    enableTiming();
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    initExpectedTiming(&expectedRecord, 1, regionSizes, CRASH_CATCHER_TIMING_MAX_REGIONS + 1);
+    CHECK_EQUAL(CRASH_CATCHER_TIMING_MAX_REGIONS, expectedRecord.regionCount);
+    validateTiming(8 + 2 * (CRASH_CATCHER_TIMING_MAX_REGIONS + 1), &expectedRecord);
+}
+
+TEST(CrashCatcher, DumpRegistersOnly_TimingAndCrc32_ShouldSendRecordBeforeCrc32Trailer)
+{
+    CrashCatcherMemoryRegion faultStatusRegion = {m_faultStatusRegistersStart,
+                                                  m_faultStatusRegistersStart + (uint32_t)sizeof(FaultStatusRegisters),
+                                                  CRASH_CATCHER_WORD};
+    uint32_t                 regionCrcs[1] = { regionCrc32(&faultStatusRegion, &m_emulatedFaultStatusRegisters) };
+    const uint32_t           regionSizes[] = { sizeof(FaultStatusRegisters) };
+    CrashCatcherTimingRecord expectedRecord;
+
+    g_crashCatcherEnableCrc32 = 1;
+    enableTiming();
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    m_expectedFlags |= CRASH_CATCHER_FLAGS_CRC32;
+    CHECK_EQUAL(15, DumpMocks_GetDumpMemoryCallCount());
+    validateHeaderAndDumpedRegisters(USING_MSP);
+    initExpectedTiming(&expectedRecord, 1, regionSizes, 1);
+    validateTiming(10, &expectedRecord);
+    validateCrc32Trailer(11, regionCrcs, 1);
+}
+
+TEST(CrashCatcher, DumpRegistersOnly_CompressedAndTiming_ShouldCountUncompressedBytes)
+{
+    const uint32_t           regionSizes[] = { sizeof(FaultStatusRegisters) };
+    CrashCatcherTimingRecord expectedRecord;
+    CrashCatcherTimingRecord record;
+    uint8_t                  dumped[512];
+    uint8_t                  uncompressed[512];
+    size_t                   dumpedSize;
+    long                     uncompressedSize;
+
+    g_crashCatcherEnableCompression = 1;
+    enableTiming();
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    dumpedSize = DumpMocks_CopyDumpedBytes(0, dumped, sizeof(dumped));
+    uncompressedSize = Lz4Decoder_DecodeStream(dumped + 8, dumpedSize - 8, uncompressed, sizeof(uncompressed));
+    initExpectedTiming(&expectedRecord, 1, regionSizes, 1);
+    CHECK_EQUAL((long)(REGISTER_DUMP_SIZE - 8 + 2 * sizeof(uint32_t) + sizeof(FaultStatusRegisters) + sizeof(record)),
+                uncompressedSize);
+    // The compressor sends whole blocks so only the byte counts can be checked, not the cycles.
+    memcpy(&record, &uncompressed[uncompressedSize - sizeof(record)], sizeof(record));
+    CHECK_EQUAL(expectedRecord.tag, record.tag);
+    CHECK_EQUAL(expectedRecord.byteCount, record.byteCount);
+    CHECK_EQUAL(expectedRecord.regions[0].byteCount, record.regions[0].byteCount);
+}
+
+TEST(CrashCatcher, DumpRegistersOnly_TimingOnCortexM0_ShouldNotTouchDwtOrSendRecord)
+{
+    g_crashCatcherEnableTiming = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    CHECK_EQUAL(8, DumpMocks_GetDumpMemoryCallCount());
+    validateHeaderAndDumpedRegisters(USING_MSP);
+    CHECK_EQUAL(0, m_emulatedDebugExceptionMonitorControlRegister);
+    CHECK_EQUAL(0, m_emulatedDwtControlRegister);
+}
+
+TEST(CrashCatcher, DumpRegistersOnly_TimingWithoutCycleCounter_ShouldNotSendRecord)
+{
+    enableTiming();
+    m_expectedFlags &= ~CRASH_CATCHER_FLAGS_TIMING;
+    m_emulatedDwtControlRegister = DWT_CTRL_NOCYCCNT;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    CHECK_EQUAL(10, DumpMocks_GetDumpMemoryCallCount());
+    validateHeaderAndDumpedRegisters(USING_MSP);
+}
+
+TEST(CrashCatcher, DumpRegistersOnly_EmulateCortexM3_TimingNotEnabled_ShouldNotTouchDwtOrSendRecord)
+{
+    m_emulatedCpuId = cpuIdCortexM3;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    CHECK_EQUAL(10, DumpMocks_GetDumpMemoryCallCount());
+    validateHeaderAndDumpedRegisters(USING_MSP);
+    CHECK_EQUAL(0, m_emulatedDebugExceptionMonitorControlRegister);
+    CHECK_EQUAL(0, m_emulatedDwtControlRegister);
+}
+
+TEST(CrashCatcher, DumpRegistersOnly_StackUsage_ShouldPaintStackAndAppendRecordWithHighWaterMark)
+{
+    DumpMocks_SetStackUsage(40, 0);
+    enableStackUsage();
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    CHECK_EQUAL(9, DumpMocks_GetDumpMemoryCallCount());
+    validateHeaderAndDumpedRegisters(USING_MSP);
+    validateStackUsage(8, 40);
+    CHECK_EQUAL(40, g_crashCatcherStackUsed);
+    CHECK_EQUAL(CRASH_CATCHER_STACK_SENTINEL, g_crashCatcherStack[1]);
+    CHECK_EQUAL(CRASH_CATCHER_STACK_SENTINEL, g_crashCatcherStack[CRASH_CATCHER_STACK_WORD_COUNT - 11]);
+    CHECK_EQUAL(0, g_crashCatcherStack[CRASH_CATCHER_STACK_WORD_COUNT - 10]);
+}
+
+TEST(CrashCatcher, DumpEndReturnTryAgainOnce_StackUsage_ShouldIncludeFirstDumpEndInSecondRecord)
+{
+    DumpMocks_SetStackUsage(40, 100);
+    DumpMocks_SetDumpEndLoops(1);
+    enableStackUsage();
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    CHECK_EQUAL(2, DumpMocks_GetDumpStartCallCount());
+    CHECK_EQUAL(18, DumpMocks_GetDumpMemoryCallCount());
+    validateStackUsage(8, 40);
+    validateStackUsage(17, 100);
+    CHECK_EQUAL(100, g_crashCatcherStackUsed);
+}
+
+TEST(CrashCatcher, DumpRegistersOnly_StackUsageAndBacktraceOnThreadStack_ShouldCountStackUsedByDeepestInitFrame)
+{
+    static const uint32_t stack[] = { EXC_RETURN_PSP, 0x08000701 };
+
+    m_emulatedPSP[7] = STACKED_PSR;
+    memset(&m_emulatedPSP[8], 0, 4 * sizeof(uint32_t));
+    DumpMocks_SetThreadStackTop((uint32_t)(unsigned long)&m_emulatedPSP[8 + 4]);
+    DumpMocks_SetThreadStackTopStackUsage(64);
+    DumpMocks_SetStackUsage(40, 0);
+    setMSPWords(stack, sizeof(stack) / sizeof(stack[0]));
+    g_crashCatcherEnableBacktrace = 1;
+    enableStackUsage();
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    CHECK_TRUE(DumpMocks_GetThreadStackTopSP() != 0);
+    validateStackUsage(DumpMocks_GetDumpMemoryCallCount() - 1, 64);
+    CHECK_EQUAL(64, g_crashCatcherStackUsed);
+}
+
+TEST(CrashCatcher, DumpRegistersOnly_StackUsageWithStackOverflow_ShouldReportWholeStackAsUsed)
+{
+    uint8_t expectedSentinel[4] = {0xAC, 0xCE, 0x55, 0xED};
+
+    DumpMocks_EnableDumpStartStackOverflowSimulation();
+    enableStackUsage();
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    CHECK_EQUAL(10, DumpMocks_GetDumpMemoryCallCount());
+    validateStackUsage(8, sizeof(g_crashCatcherStack));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(9, expectedSentinel, CRASH_CATCHER_BYTE, sizeof(expectedSentinel)));
+}
+
+TEST(CrashCatcher, DumpRegistersOnly_StackUsageAndCrc32_ShouldSendRecordBeforeCrc32Trailer)
+{
+    g_crashCatcherEnableCrc32 = 1;
+    enableStackUsage();
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    m_expectedFlags |= CRASH_CATCHER_FLAGS_CRC32;
+    CHECK_EQUAL(12, DumpMocks_GetDumpMemoryCallCount());
+    validateHeaderAndDumpedRegisters(USING_MSP);
+    validateStackUsage(8, 0);
+
+    uint8_t  dumpedBytes[128];
+    size_t   dumpedSize = DumpMocks_CopyDumpedBytes(0, dumpedBytes, sizeof(dumpedBytes));
+    uint32_t recordHeader[2] = { CRASH_CATCHER_RECORD_TAG(CRASH_CATCHER_RECORD_CRC32), 2 * sizeof(uint32_t) };
+    uint32_t regionCrcCount = 0;
+    uint32_t dumpCrc = CrashCatcher_Crc32(0, dumpedBytes, dumpedSize - sizeof(uint32_t));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(9, recordHeader, CRASH_CATCHER_BYTE, sizeof(recordHeader)));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(10, &regionCrcCount, CRASH_CATCHER_BYTE, sizeof(regionCrcCount)));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(11, &dumpCrc, CRASH_CATCHER_BYTE, sizeof(dumpCrc)));
+}
+
+TEST(CrashCatcher, DumpRegistersOnly_StackUsageNotEnabled_ShouldNotPaintStackOrSendRecord)
+{
+    DumpMocks_SetStackUsage(40, 0);
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    CHECK_EQUAL(8, DumpMocks_GetDumpMemoryCallCount());
+    validateHeaderAndDumpedRegisters(USING_MSP);
+    CHECK_EQUAL(0, g_crashCatcherStack[1]);
+    CHECK_EQUAL(0, g_crashCatcherStackUsed);
+}
+
+TEST(CrashCatcher, DumpRegistersOnly_IsBKPTDisabled_EmulateBKPT_ShouldNotDetectOrAdvancePastBKPT)
+{
+    uint32_t expectedPC = m_emulatedMSP[6];
+    g_crashCatcherEnableIsBKPT = 0;
+    emulateBKPT(0);
+    m_expectedIsBKPT = 0;
+    m_expectedBkptValue = 0;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    CHECK_EQUAL(8, DumpMocks_GetDumpMemoryCallCount());
+    validateHeaderAndDumpedRegisters(USING_MSP);
+    validateDumpStartInfo();
+    CHECK_EQUAL(expectedPC, m_emulatedMSP[6]);
+}
+
+TEST(CrashCatcher, DumpRegistersOnly_FloatingPointDisabled_EnableCp10AndCp11_AutoStack_ShouldOnlyDumpIntegerRegisters)
+{
+    g_crashCatcherEnableFloatingPoint = 0;
+    m_emulatedCoprocessorAccessControlRegister = (3 << 20) | (3 << 22);
+    emulateFloatingPointStacking();
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    CHECK_EQUAL(8, DumpMocks_GetDumpMemoryCallCount());
+    // The SP must still skip over the floating point registers which the processor stacked.
+    validateHeaderAndDumpedRegisters(USING_MSP);
+    CHECK_EQUAL(1, DumpMocks_GetDumpEndCallCount());
+}
+
+TEST(CrashCatcher, DumpOneWordRegion_FaultStatusDisabled_EmulateCortexM3_ShouldNotAppendFaultStatusRegisters)
+{
+    static const CrashCatcherMemoryRegion regions[] = { {m_memoryStart, m_memoryStart + 4, CRASH_CATCHER_WORD},
+                                                        {   0xFFFFFFFF,        0xFFFFFFFF, CRASH_CATCHER_BYTE} };
+    DumpMocks_SetMemoryRegions(regions);
+    g_crashCatcherEnableFaultStatus = 0;
+    m_emulatedCpuId = cpuIdCortexM3;
+    m_emulatedFaultStatusRegisters.CFSR = 0x12345678;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    CHECK_EQUAL(10, DumpMocks_GetDumpMemoryCallCount());
+    validateHeaderAndDumpedRegisters(USING_MSP);
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(8, &regions[0], CRASH_CATCHER_BYTE, 2 * sizeof(uint32_t)));
+    CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(9, m_memory, CRASH_CATCHER_WORD, 1));
+}
+
+TEST(CrashCatcher, DumpOneWordRegion_FaultStatusDisabled_EmulateCortexM3_TwoTier_ShouldStillDecodeFaultCause)
+{
+    g_crashCatcherEnableFaultStatus = 0;
+    m_emulatedCpuId = cpuIdCortexM3;
+    m_emulatedFaultStatusRegisters.CFSR = CFSR_UNDEFINSTR;
+    g_crashCatcherEnableTwoTier = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    m_expectedFlags |= CRASH_CATCHER_FLAGS_TWO_TIER;
+    validateHeaderAndDumpedRegisters(USING_MSP);
+    validateFaultCause(8, CRASH_CATCHER_FAULT_UNDEFINED_INSTRUCTION, 0, 0);
+}
+
+TEST(CrashCatcher, DumpRegistersOnly_FaultCauseDisabled_EmulateCortexM3DivideByZero_ShouldPassUnknownFaultCause)
+{
+    g_crashCatcherEnableFaultCause = 0;
+    m_emulatedCpuId = cpuIdCortexM3;
+    m_emulatedFaultStatusRegisters.CFSR = CFSR_DIVBYZERO;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    CHECK_EQUAL(CRASH_CATCHER_FAULT_UNKNOWN, DumpMocks_GetDumpStartInfo()->faultCause);
+}
+
+TEST(CrashCatcher, DumpRegistersOnly_FaultCauseDisabled_EmulateBKPT_ShouldStillPassBreakpointFaultCause)
+{
+    g_crashCatcherEnableFaultCause = 0;
+    emulateBKPT(0);
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    CHECK_EQUAL(CRASH_CATCHER_FAULT_BREAKPOINT, DumpMocks_GetDumpStartInfo()->faultCause);
+}
+
+TEST(CrashCatcher, DumpRegistersOnly_FaultCauseDisabled_TwoTier_ShouldNotSendFaultCauseRecord)
+{
+    setMSPWords(NULL, 0);
+    g_crashCatcherEnableFaultCause = 0;
+    g_crashCatcherEnableTwoTier = 1;
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    m_expectedFlags |= CRASH_CATCHER_FLAGS_TWO_TIER;
+    CHECK_EQUAL(12, DumpMocks_GetDumpMemoryCallCount());
+    validateHeaderAndDumpedRegisters(USING_MSP);
+    validateStackRegion(8, &m_emulatedMSP[8], &m_emulatedMSP[8 + 16 + 1]);
+    validateTierEnd(10, 1, 0);
+    validateTierEnd(11, 2, 0);
+}
+
+TEST(CrashCatcher, StackSentinelDisabled_SimulateStackOverflow_ShouldNotAppendMagicWord)
+{
+    g_crashCatcherEnableStackSentinel = 0;
+    DumpMocks_EnableDumpStartStackOverflowSimulation();
+    CrashCatcher_Entry(&m_exceptionRegisters);
+    CHECK_EQUAL(8, DumpMocks_GetDumpMemoryCallCount());
+    validateHeaderAndDumpedRegisters(USING_MSP);
+    CHECK_EQUAL(1, DumpMocks_GetDumpEndCallCount());
+}
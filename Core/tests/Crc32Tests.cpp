@@ -0,0 +1,83 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include <stdint.h>
+#include <string.h>
+
+// Include headers from C modules under test.
+extern "C"
+{
+    #include <Crc32.h>
+}
+
+// Include C++ headers for test harness.
+#include <CppUTest/TestHarness.h>
+
+
+TEST_GROUP(Crc32)
+{
+    uint8_t m_data[256];
+
+    void setup()
+    {
+        for (size_t i = 0 ; i < sizeof(m_data) ; i++)
+            m_data[i] = (uint8_t)i;
+    }
+
+    void teardown()
+    {
+    }
+
+    static uint32_t bitwiseCrc32(const uint8_t* pData, size_t size)
+    {
+        uint32_t crc = 0xFFFFFFFF;
+
+        while (size-- > 0)
+        {
+            crc ^= *pData++;
+            for (int bit = 0 ; bit < 8 ; bit++)
+                crc = (crc >> 1) ^ ((crc & 1) ? 0xEDB88320 : 0);
+        }
+        return ~crc;
+    }
+};
+
+
+TEST(Crc32, EmptyBuffer_ShouldReturnStartingCrc)
+{
+    CHECK_EQUAL(0x00000000, CrashCatcher_Crc32(0, m_data, 0));
+    CHECK_EQUAL(0x12345678, CrashCatcher_Crc32(0x12345678, m_data, 0));
+}
+
+TEST(Crc32, CheckString_ShouldMatchStandardCheckValue)
+{
+    static const char checkString[] = "123456789";
+
+    CHECK_EQUAL(0xCBF43926, CrashCatcher_Crc32(0, checkString, strlen(checkString)));
+}
+
+TEST(Crc32, AllByteValues_ShouldMatchBitwiseImplementation)
+{
+    CHECK_EQUAL(bitwiseCrc32(m_data, sizeof(m_data)), CrashCatcher_Crc32(0, m_data, sizeof(m_data)));
+}
+
+TEST(Crc32, SplitIntoUnevenPieces_ShouldMatchSingleCall)
+{
+    uint32_t crc = 0;
+
+    crc = CrashCatcher_Crc32(crc, &m_data[0], 1);
+    crc = CrashCatcher_Crc32(crc, &m_data[1], 6);
+    crc = CrashCatcher_Crc32(crc, &m_data[7], sizeof(m_data) - 7);
+    CHECK_EQUAL(CrashCatcher_Crc32(0, m_data, sizeof(m_data)), crc);
+}
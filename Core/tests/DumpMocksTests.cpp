@@ -203,6 +203,34 @@ TEST(DumpMocks, VerifyDumpMemory_Issue3WritesOfVaryingSizes_ShouldReturnTrue)
     CHECK_TRUE(DumpMocks_VerifyDumpMemoryItem(2, &word, CRASH_CATCHER_WORD, 1));
 }
 
+TEST(DumpMocks, CopyDumpedBytes_Issue3WritesOfVaryingSizes_ShouldConcatenate)
+{
+    const uint8_t  bytes[2] = {0x11, 0x22};
+    const uint16_t halfWord = 0x5a5a;
+    const uint32_t word = 0xaabbccdd;
+    uint8_t        expected[2 + 2 + 4];
+    uint8_t        actual[sizeof(expected)];
+    memcpy(&expected[0], bytes, sizeof(bytes));
+    memcpy(&expected[2], &halfWord, sizeof(halfWord));
+    memcpy(&expected[4], &word, sizeof(word));
+    CrashCatcher_DumpMemory(&bytes, CRASH_CATCHER_BYTE, 2);
+    CrashCatcher_DumpMemory(&halfWord, CRASH_CATCHER_HALFWORD, 1);
+    CrashCatcher_DumpMemory(&word, CRASH_CATCHER_WORD, 1);
+    CHECK_EQUAL(sizeof(expected), DumpMocks_CopyDumpedBytes(0, actual, sizeof(actual)));
+    CHECK_TRUE(0 == memcmp(expected, actual, sizeof(expected)));
+}
+
+TEST(DumpMocks, CopyDumpedBytes_SkipFirstItem_ShouldOnlyCopyLaterItems)
+{
+    const uint8_t  bytes[2] = {0x11, 0x22};
+    const uint32_t word = 0xaabbccdd;
+    uint8_t        actual[4];
+    CrashCatcher_DumpMemory(&bytes, CRASH_CATCHER_BYTE, 2);
+    CrashCatcher_DumpMemory(&word, CRASH_CATCHER_WORD, 1);
+    CHECK_EQUAL(sizeof(word), DumpMocks_CopyDumpedBytes(1, actual, sizeof(actual)));
+    CHECK_TRUE(0 == memcmp(&word, actual, sizeof(word)));
+}
+
 TEST(DumpMocks, GetRamRegions_ShouldReturnNullByDefault)
 {
     const CrashCatcherMemoryRegion* pRegions = CrashCatcher_GetMemoryRegions();
@@ -231,3 +259,30 @@ TEST(DumpMocks, EnableDumpStartStackOverflowSimulation_ValidateDefaultsToNoModif
     CrashCatcher_DumpStart(&m_dummyInfo);
     CHECK_EQUAL(CRASH_CATCHER_STACK_SENTINEL, g_crashCatcherStack[0]);
 }
+
+TEST(DumpMocks, SetStackUsage_ValidateTopOfStackClearedByDumpStartAndDumpEnd)
+{
+    const size_t top = CRASH_CATCHER_STACK_WORD_COUNT - 1;
+
+    for (size_t i = 0 ; i < CRASH_CATCHER_STACK_WORD_COUNT ; i++)
+        g_crashCatcherStack[i] = CRASH_CATCHER_STACK_SENTINEL;
+    DumpMocks_SetStackUsage(8, 12);
+    CrashCatcher_DumpStart(&m_dummyInfo);
+    CHECK_EQUAL(0x00000000, g_crashCatcherStack[top - 1]);
+    CHECK_EQUAL(CRASH_CATCHER_STACK_SENTINEL, g_crashCatcherStack[top - 2]);
+    CrashCatcher_DumpEnd();
+    CHECK_EQUAL(0x00000000, g_crashCatcherStack[top - 2]);
+    CHECK_EQUAL(CRASH_CATCHER_STACK_SENTINEL, g_crashCatcherStack[top - 3]);
+}
+
+TEST(DumpMocks, SetThreadStackTopStackUsage_ValidateTopOfStackClearedByGetThreadStackTop)
+{
+    const size_t top = CRASH_CATCHER_STACK_WORD_COUNT - 1;
+
+    for (size_t i = 0 ; i < CRASH_CATCHER_STACK_WORD_COUNT ; i++)
+        g_crashCatcherStack[i] = CRASH_CATCHER_STACK_SENTINEL;
+    DumpMocks_SetThreadStackTopStackUsage(8);
+    CrashCatcher_GetThreadStackTop(0x10000000);
+    CHECK_EQUAL(0x00000000, g_crashCatcherStack[top - 1]);
+    CHECK_EQUAL(CRASH_CATCHER_STACK_SENTINEL, g_crashCatcherStack[top - 2]);
+}
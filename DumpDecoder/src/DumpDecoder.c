@@ -0,0 +1,1033 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Decodes the hex, Base64 or Z85 lines sent by the HexDump module.  The HexDump module encodes each line on its own so
+   every line is decoded on its own too, using lookup tables to map each character back to its digit value.  Lines
+   which were sent with a line number and checksum are collected by line number so that copies resent later in the log
+   can fill in damaged lines.  Also decodes the binary frames sent by the CobsDump module.
+
+   Most dumps are sent as hex so hex lines are decoded 8 digits at a time with SWAR (SIMD within a register) arithmetic
+   on 64-bit words rather than a table lookup per digit. */
+#include <stdlib.h>
+#include <string.h>
+#include <DumpVerifier.h>
+#include "DumpDecoder.h"
+
+
+#define INVALID_DIGIT       0xFF
+
+/* Number of hex digits decoded by each pass of the SWAR hex kernel and the constants it uses to work on every byte of
+   a 64-bit word at once. */
+#define SWAR_HEX_DIGITS     8
+#define SWAR_ONES           0x0101010101010101ULL
+#define SWAR_HIGH_BITS      (0x80 * SWAR_ONES)
+
+/* Layout of the frames sent by the CobsDump module. */
+#define COBS_HEADER_SIZE    2
+#define COBS_CRC_SIZE       4
+#define COBS_MAX_PAYLOAD    1024
+#define COBS_SEQUENCE_MASK  0x7FFF
+#define COBS_FINAL_FLAG     0x8000
+
+/* Layout of the "NNNNNN data CCCC" lines sent by HexDump when CRASH_CATCHER_HEX_DUMP_LINE_CHECKSUMS is set. */
+#define LINE_NUMBER_DIGITS      6
+#define LINE_CHECKSUM_DIGITS    4
+#define LINE_CHECKSUM_MASK      0xFFFF
+#define MIN_NUMBERED_LINE       (LINE_NUMBER_DIGITS + 1 + 1 + LINE_CHECKSUM_DIGITS)
+
+
+typedef struct
+{
+    const char* pCurr;
+    const char* pEnd;
+    size_t      lineNumber;
+} Log;
+
+typedef struct
+{
+    const char* pStart;
+    size_t      length;
+} Line;
+
+typedef struct
+{
+    Line   data;
+    size_t logLineNumber;
+} NumberedLine;
+
+typedef struct
+{
+    /* First copy of each line which had a valid checksum, indexed by line number.  data.pStart is NULL for lines which
+       haven't been found. */
+    NumberedLine* pLines;
+    size_t        allocatedLines;
+    size_t        lineCount;
+    int           isLineCountKnown;
+    /* Checksums are calculated over the decoded bytes so each line is decoded into here first. */
+    uint8_t*      pScratch;
+    size_t        scratchSize;
+} NumberedLines;
+
+typedef struct
+{
+    const uint8_t* pCurr;
+    const uint8_t* pEnd;
+} Capture;
+
+typedef struct
+{
+    uint8_t        buffer[COBS_HEADER_SIZE + COBS_MAX_PAYLOAD + COBS_CRC_SIZE];
+    const uint8_t* pPayload;
+    size_t         payloadSize;
+    size_t         sequence;
+    int            isFinal;
+} Frame;
+
+
+/* Value of each ASCII character as a digit, or INVALID_DIGIT.  These are initialized arrays rather than being built at
+   runtime so that the decoder can be used from several threads at once. */
+/* Hexadecimal digits, in either case. */
+static const uint8_t g_hexValues[256] =
+{
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+};
+/* RFC 4648 Base64 digits. */
+static const uint8_t g_base64Values[256] =
+{
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x3E, 0xFF, 0xFF, 0xFF, 0x3F,
+    0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
+    0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+    0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x31, 0x32, 0x33, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+};
+/* ZeroMQ Z85 digits. */
+static const uint8_t g_z85Values[256] =
+{
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x44, 0xFF, 0x54, 0x53, 0x52, 0x48, 0xFF, 0x4B, 0x4C, 0x46, 0x41, 0xFF, 0x3F, 0x3E, 0x45,
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x40, 0xFF, 0x49, 0x42, 0x4A, 0x47,
+    0x51, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x31, 0x32,
+    0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0x4D, 0xFF, 0x4E, 0x43, 0xFF,
+    0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18,
+    0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x4F, 0xFF, 0x50, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+};
+
+
+static DumpDecoderResult   decodeText(const char* pLog, size_t logSize, DumpDecoderEncoding encoding,
+                                      uint8_t* pOutput, size_t outputSize, DumpDecoderDetails* pDetails,
+                                      int skipBadLines);
+static DumpDecoderResult   decode(Log* pLog, DumpDecoderEncoding encoding,
+                                  uint8_t* pOutput, size_t outputSize, DumpDecoderDetails* pDetails, int skipBadLines);
+static int                 nextLine(Log* pLog, Line* pLine);
+static int                 containsString(const Line* pLine, const char* pString);
+static DumpDecoderEncoding parseBanner(const Line* pLine);
+static DumpDecoderEncoding findSignature(const Line* pLine, DumpDecoderEncoding encoding);
+static int                 isSignature(const Line* pLine, DumpDecoderEncoding encoding);
+static DumpDecoderEncoding findNumberedSignature(const Line* pLine, DumpDecoderEncoding encoding);
+static int                 splitNumberedLine(const Line* pLine, uint32_t* pNumber, Line* pData, uint32_t* pChecksum);
+static int                 parseHexDigits(const char* pDigits, size_t digitCount, uint32_t* pValue);
+static uint32_t            lineChecksum(uint32_t number, const uint8_t* pData, size_t size);
+static DumpDecoderResult   decodeNumbered(Log* pLog, const Line* pFirstLine,
+                                          uint8_t* pOutput, size_t outputSize, DumpDecoderDetails* pDetails);
+static DumpDecoderResult   collectNumberedLines(Log* pLog, const Line* pFirstLine, DumpDecoderEncoding encoding,
+                                                NumberedLines* pLines);
+static int                 parseLineCount(const Line* pLine, size_t* pLineCount);
+static DumpDecoderResult   validateNumberedLine(NumberedLines* pLines, const Line* pLine, DumpDecoderEncoding encoding,
+                                                uint32_t* pNumber, Line* pData);
+static int                 recordNumberedLine(NumberedLines* pLines, uint32_t number, const Line* pData,
+                                              size_t logLineNumber);
+static int                 isLineMissing(const NumberedLines* pLines, size_t number);
+static void                freeNumberedLines(NumberedLines* pLines);
+static DumpDecoderResult   decodeLine(const Line* pLine, DumpDecoderEncoding encoding,
+                                      uint8_t* pOutput, size_t outputSize, size_t* pDecodedSize);
+static int                 decodedLength(const Line* pLine, DumpDecoderEncoding encoding, size_t* pLength);
+static int                 decodeHex(const Line* pLine, uint8_t* pOutput);
+static int                 decodeHexWord(const uint8_t* pDigits, uint8_t* pOutput);
+static int                 isLittleEndian(void);
+static uint64_t            swapBytes64(uint64_t value);
+static uint64_t            inRange(uint64_t chars, uint8_t min, uint8_t max);
+static int                 decodeBase64(const Line* pLine, uint8_t* pOutput);
+static int                 decodeZ85(const Line* pLine, uint8_t* pOutput);
+static DumpDecoderResult   decodeCobs(const char* pLog, size_t logSize,
+                                      uint8_t* pOutput, size_t outputSize, DumpDecoderDetails* pDetails);
+static size_t              findFrameSize(Capture capture);
+static int                 nextFrame(Capture* pCapture, Frame* pFrame);
+static int                 decodeFrame(const uint8_t* pChunk, size_t chunkSize, Frame* pFrame);
+static int                 isSignatureFrame(const Frame* pFrame);
+
+
+size_t DumpDecoder_MaxDecodedSize(size_t logSize)
+{
+    /* None of the encodings, not even COBS, ever decode to more bytes than they take up in the log. */
+    return logSize;
+}
+
+DumpDecoderResult DumpDecoder_Decode(const char* pLog, size_t logSize, DumpDecoderEncoding encoding,
+                                     uint8_t* pOutput, size_t outputSize, DumpDecoderDetails* pDetails)
+{
+    return decodeText(pLog, logSize, encoding, pOutput, outputSize, pDetails, 0);
+}
+
+DumpDecoderResult DumpDecoder_DecodeEmbedded(const char* pLog, size_t logSize, DumpDecoderEncoding encoding,
+                                             uint8_t* pOutput, size_t outputSize, DumpDecoderDetails* pDetails)
+{
+    return decodeText(pLog, logSize, encoding, pOutput, outputSize, pDetails, 1);
+}
+
+static DumpDecoderResult decodeText(const char* pLog, size_t logSize, DumpDecoderEncoding encoding,
+                                    uint8_t* pOutput, size_t outputSize, DumpDecoderDetails* pDetails,
+                                    int skipBadLines)
+{
+    DumpDecoderDetails details;
+    Log                log;
+
+    if (!pDetails)
+        pDetails = &details;
+    memset(pDetails, 0, sizeof(*pDetails));
+
+    /* Text logs never contain zero bytes but COBS captures have one after every frame. */
+    if (encoding == DUMP_DECODER_COBS || (encoding == DUMP_DECODER_AUTO && memchr(pLog, 0, logSize)))
+        return decodeCobs(pLog, logSize, pOutput, outputSize, pDetails);
+    log.pCurr = pLog;
+    log.pEnd = pLog + logSize;
+    log.lineNumber = 0;
+    return decode(&log, encoding, pOutput, outputSize, pDetails, skipBadLines);
+}
+
+static DumpDecoderResult decode(Log* pLog, DumpDecoderEncoding encoding,
+                                uint8_t* pOutput, size_t outputSize, DumpDecoderDetails* pDetails, int skipBadLines)
+{
+    DumpDecoderEncoding bannerEncoding = DUMP_DECODER_AUTO;
+    DumpDecoderResult   result;
+    Line                line;
+    size_t              lineSize;
+
+    /* Skip over anything which was logged before the signature line that starts the dump. */
+    do
+    {
+        if (!nextLine(pLog, &line))
+            return DUMP_DECODER_NO_DUMP;
+        if (encoding == DUMP_DECODER_AUTO && containsString(&line, " ENCOUNTERED"))
+        {
+            bannerEncoding = parseBanner(&line);
+            continue;
+        }
+        pDetails->encoding = findNumberedSignature(&line, encoding != DUMP_DECODER_AUTO ? encoding : bannerEncoding);
+        if (pDetails->encoding != DUMP_DECODER_AUTO)
+            return decodeNumbered(pLog, &line, pOutput, outputSize, pDetails);
+        pDetails->encoding = findSignature(&line, encoding != DUMP_DECODER_AUTO ? encoding : bannerEncoding);
+    } while (pDetails->encoding == DUMP_DECODER_AUTO);
+
+    do
+    {
+        if (line.length == 0)
+            continue;
+        if (line.length == 11 && memcmp(line.pStart, "End of dump", 11) == 0)
+            return DUMP_DECODER_OK;
+        result = decodeLine(&line, pDetails->encoding, pOutput + pDetails->decodedSize,
+                            outputSize - pDetails->decodedSize, &lineSize);
+        if (result == DUMP_DECODER_BAD_LINE && skipBadLines)
+        {
+            pDetails->skippedLineCount++;
+            continue;
+        }
+        if (result != DUMP_DECODER_OK)
+        {
+            pDetails->lineNumber = pLog->lineNumber;
+            return result;
+        }
+        pDetails->decodedSize += lineSize;
+    } while (nextLine(pLog, &line));
+
+    return DUMP_DECODER_TRUNCATED;
+}
+
+static int nextLine(Log* pLog, Line* pLine)
+{
+    const char* pNewline;
+
+    if (pLog->pCurr >= pLog->pEnd)
+        return 0;
+    pNewline = memchr(pLog->pCurr, '\n', pLog->pEnd - pLog->pCurr);
+    if (!pNewline)
+        pNewline = pLog->pEnd;
+    pLine->pStart = pLog->pCurr;
+    pLine->length = pNewline - pLog->pCurr;
+    /* Serial terminals can add stray carriage returns to either end of a line. */
+    while (pLine->length > 0 && pLine->pStart[pLine->length - 1] == '\r')
+        pLine->length--;
+    while (pLine->length > 0 && pLine->pStart[0] == '\r')
+    {
+        pLine->pStart++;
+        pLine->length--;
+    }
+    pLog->pCurr = pNewline + 1;
+    pLog->lineNumber++;
+    return 1;
+}
+
+static int containsString(const Line* pLine, const char* pString)
+{
+    size_t stringLength = strlen(pString);
+    size_t i;
+
+    for (i = 0 ; i + stringLength <= pLine->length ; i++)
+    {
+        if (memcmp(&pLine->pStart[i], pString, stringLength) == 0)
+            return 1;
+    }
+    return 0;
+}
+
+static DumpDecoderEncoding parseBanner(const Line* pLine)
+{
+    if (containsString(pLine, "(Base64)"))
+        return DUMP_DECODER_BASE64;
+    if (containsString(pLine, "(Z85)"))
+        return DUMP_DECODER_Z85;
+    return DUMP_DECODER_HEX;
+}
+
+static DumpDecoderEncoding findSignature(const Line* pLine, DumpDecoderEncoding encoding)
+{
+    int i;
+
+    if (encoding != DUMP_DECODER_AUTO)
+        return isSignature(pLine, encoding) ? encoding : DUMP_DECODER_AUTO;
+    for (i = DUMP_DECODER_HEX ; i <= DUMP_DECODER_Z85 ; i++)
+    {
+        if (isSignature(pLine, (DumpDecoderEncoding)i))
+            return (DumpDecoderEncoding)i;
+    }
+    return DUMP_DECODER_AUTO;
+}
+
+static int isSignature(const Line* pLine, DumpDecoderEncoding encoding)
+{
+    uint8_t signature[4];
+    size_t  size;
+
+    /* The Core sends the 4 byte signature on its own so it always ends up on a line by itself. */
+    if (!decodedLength(pLine, encoding, &size) || size != sizeof(signature))
+        return 0;
+    if (decodeLine(pLine, encoding, signature, sizeof(signature), &size) != DUMP_DECODER_OK)
+        return 0;
+    return signature[0] == 'c' && signature[1] == 'C';
+}
+
+static DumpDecoderEncoding findNumberedSignature(const Line* pLine, DumpDecoderEncoding encoding)
+{
+    uint8_t  signature[4];
+    uint32_t number;
+    uint32_t checksum;
+    Line     data;
+    size_t   size;
+
+    if (!splitNumberedLine(pLine, &number, &data, &checksum) || number != 0)
+        return DUMP_DECODER_AUTO;
+    encoding = findSignature(&data, encoding);
+    if (encoding == DUMP_DECODER_AUTO)
+        return DUMP_DECODER_AUTO;
+    decodeLine(&data, encoding, signature, sizeof(signature), &size);
+    if (lineChecksum(number, signature, size) != checksum)
+        return DUMP_DECODER_AUTO;
+    return encoding;
+}
+
+static int splitNumberedLine(const Line* pLine, uint32_t* pNumber, Line* pData, uint32_t* pChecksum)
+{
+    const char* pChecksumDigits = pLine->pStart + pLine->length - LINE_CHECKSUM_DIGITS;
+
+    if (pLine->length < MIN_NUMBERED_LINE ||
+        pLine->pStart[LINE_NUMBER_DIGITS] != ' ' || pChecksumDigits[-1] != ' ' ||
+        !parseHexDigits(pLine->pStart, LINE_NUMBER_DIGITS, pNumber) ||
+        !parseHexDigits(pChecksumDigits, LINE_CHECKSUM_DIGITS, pChecksum))
+    {
+        return 0;
+    }
+    pData->pStart = pLine->pStart + LINE_NUMBER_DIGITS + 1;
+    pData->length = pLine->length - MIN_NUMBERED_LINE;
+    return 1;
+}
+
+static int parseHexDigits(const char* pDigits, size_t digitCount, uint32_t* pValue)
+{
+    uint32_t value = 0;
+
+    while (digitCount-- > 0)
+    {
+        uint8_t digit = g_hexValues[(uint8_t)*pDigits++];
+
+        if (digit == INVALID_DIGIT)
+            return 0;
+        value = (value << 4) | digit;
+    }
+    *pValue = value;
+    return 1;
+}
+
+static uint32_t lineChecksum(uint32_t number, const uint8_t* pData, size_t size)
+{
+    uint8_t  numberBytes[4];
+    uint32_t crc;
+
+    numberBytes[0] = number & 0xFF;
+    numberBytes[1] = (number >> 8) & 0xFF;
+    numberBytes[2] = (number >> 16) & 0xFF;
+    numberBytes[3] = number >> 24;
+    crc = DumpVerifier_Crc32(0, numberBytes, sizeof(numberBytes));
+    return DumpVerifier_Crc32(crc, pData, size) & LINE_CHECKSUM_MASK;
+}
+
+static DumpDecoderResult decodeNumbered(Log* pLog, const Line* pFirstLine,
+                                        uint8_t* pOutput, size_t outputSize, DumpDecoderDetails* pDetails)
+{
+    NumberedLines     lines;
+    DumpDecoderResult result;
+    size_t            i;
+
+    memset(&lines, 0, sizeof(lines));
+    result = collectNumberedLines(pLog, pFirstLine, pDetails->encoding, &lines);
+    for (i = 0 ; result == DUMP_DECODER_OK && i < lines.lineCount ; i++)
+    {
+        size_t lineSize;
+
+        if (isLineMissing(&lines, i))
+        {
+            if (pDetails->missingLineCount++ == 0)
+                pDetails->firstMissingLine = i;
+            continue;
+        }
+        /* Lines vary in length so nothing after a missing line can be placed at the correct offset. */
+        if (pDetails->missingLineCount > 0)
+            continue;
+        result = decodeLine(&lines.pLines[i].data, pDetails->encoding, pOutput + pDetails->decodedSize,
+                            outputSize - pDetails->decodedSize, &lineSize);
+        if (result != DUMP_DECODER_OK)
+            pDetails->lineNumber = lines.pLines[i].logLineNumber;
+        else
+            pDetails->decodedSize += lineSize;
+    }
+    freeNumberedLines(&lines);
+
+    if (result != DUMP_DECODER_OK)
+        return result;
+    if (pDetails->missingLineCount > 0)
+        return DUMP_DECODER_MISSING_LINES;
+    if (!lines.isLineCountKnown)
+        return DUMP_DECODER_TRUNCATED;
+    return DUMP_DECODER_OK;
+}
+
+static DumpDecoderResult collectNumberedLines(Log* pLog, const Line* pFirstLine, DumpDecoderEncoding encoding,
+                                              NumberedLines* pLines)
+{
+    Line line = *pFirstLine;
+
+    /* Scan to the end of this dump, which takes in any lines resent after the "End of dump" line, keeping the first
+       valid copy of each line. */
+    do
+    {
+        DumpDecoderResult result;
+        uint32_t          number;
+        size_t            lineCount;
+        Line              data;
+
+        if (containsString(&line, " ENCOUNTERED"))
+            break;
+        if (parseLineCount(&line, &lineCount))
+        {
+            pLines->lineCount = lineCount;
+            pLines->isLineCountKnown = 1;
+            continue;
+        }
+        result = validateNumberedLine(pLines, &line, encoding, &number, &data);
+        if (result == DUMP_DECODER_BUFFER_TOO_SMALL)
+            return result;
+        if (result != DUMP_DECODER_OK)
+            continue;
+        if (!recordNumberedLine(pLines, number, &data, pLog->lineNumber))
+            return DUMP_DECODER_BUFFER_TOO_SMALL;
+    } while (nextLine(pLog, &line));
+    return DUMP_DECODER_OK;
+}
+
+static int parseLineCount(const Line* pLine, size_t* pLineCount)
+{
+    static const char prefix[] = "Line count: ";
+    const size_t      prefixLength = sizeof(prefix) - 1;
+    uint32_t          lineCount;
+
+    if (pLine->length != prefixLength + LINE_NUMBER_DIGITS || memcmp(pLine->pStart, prefix, prefixLength) != 0)
+        return 0;
+    if (!parseHexDigits(pLine->pStart + prefixLength, LINE_NUMBER_DIGITS, &lineCount))
+        return 0;
+    *pLineCount = lineCount;
+    return 1;
+}
+
+static DumpDecoderResult validateNumberedLine(NumberedLines* pLines, const Line* pLine, DumpDecoderEncoding encoding,
+                                              uint32_t* pNumber, Line* pData)
+{
+    uint32_t checksum;
+    size_t   size;
+
+    if (!splitNumberedLine(pLine, pNumber, pData, &checksum))
+        return DUMP_DECODER_BAD_LINE;
+    /* No encoding decodes to more bytes than its text so the scratch buffer only needs to be as long as the line. */
+    if (pData->length > pLines->scratchSize)
+    {
+        uint8_t* pScratch = realloc(pLines->pScratch, pData->length);
+
+        if (!pScratch)
+            return DUMP_DECODER_BUFFER_TOO_SMALL;
+        pLines->pScratch = pScratch;
+        pLines->scratchSize = pData->length;
+    }
+    if (decodeLine(pData, encoding, pLines->pScratch, pLines->scratchSize, &size) != DUMP_DECODER_OK)
+        return DUMP_DECODER_BAD_LINE;
+    if (lineChecksum(*pNumber, pLines->pScratch, size) != checksum)
+        return DUMP_DECODER_BAD_LINE;
+    return DUMP_DECODER_OK;
+}
+
+static int recordNumberedLine(NumberedLines* pLines, uint32_t number, const Line* pData, size_t logLineNumber)
+{
+    if (number >= pLines->allocatedLines)
+    {
+        size_t        allocatedLines = pLines->allocatedLines ? pLines->allocatedLines * 2 : 256;
+        NumberedLine* pNewLines;
+
+        while (allocatedLines <= number)
+            allocatedLines *= 2;
+        pNewLines = realloc(pLines->pLines, allocatedLines * sizeof(*pNewLines));
+        if (!pNewLines)
+            return 0;
+        memset(&pNewLines[pLines->allocatedLines], 0,
+               (allocatedLines - pLines->allocatedLines) * sizeof(*pNewLines));
+        pLines->pLines = pNewLines;
+        pLines->allocatedLines = allocatedLines;
+    }
+    if (!pLines->pLines[number].data.pStart)
+    {
+        pLines->pLines[number].data = *pData;
+        pLines->pLines[number].logLineNumber = logLineNumber;
+    }
+    /* The "Line count" line is more accurate than this guess since it includes lines missing from the end. */
+    if (!pLines->isLineCountKnown && number >= pLines->lineCount)
+        pLines->lineCount = number + 1;
+    return 1;
+}
+
+static int isLineMissing(const NumberedLines* pLines, size_t number)
+{
+    return number >= pLines->allocatedLines || pLines->pLines[number].data.pStart == NULL;
+}
+
+static void freeNumberedLines(NumberedLines* pLines)
+{
+    free(pLines->pLines);
+    free(pLines->pScratch);
+    pLines->pLines = NULL;
+    pLines->pScratch = NULL;
+}
+
+static DumpDecoderResult decodeLine(const Line* pLine, DumpDecoderEncoding encoding,
+                                    uint8_t* pOutput, size_t outputSize, size_t* pDecodedSize)
+{
+    int isValid;
+
+    if (!decodedLength(pLine, encoding, pDecodedSize))
+        return DUMP_DECODER_BAD_LINE;
+    if (*pDecodedSize > outputSize)
+        return DUMP_DECODER_BUFFER_TOO_SMALL;
+
+    switch (encoding)
+    {
+    case DUMP_DECODER_BASE64:
+        isValid = decodeBase64(pLine, pOutput);
+        break;
+    case DUMP_DECODER_Z85:
+        isValid = decodeZ85(pLine, pOutput);
+        break;
+    default:
+        isValid = decodeHex(pLine, pOutput);
+        break;
+    }
+    return isValid ? DUMP_DECODER_OK : DUMP_DECODER_BAD_LINE;
+}
+
+static int decodedLength(const Line* pLine, DumpDecoderEncoding encoding, size_t* pLength)
+{
+    size_t length = pLine->length;
+    size_t padding = 0;
+
+    switch (encoding)
+    {
+    case DUMP_DECODER_BASE64:
+        if (length % 4 != 0)
+            return 0;
+        while (padding < 2 && padding < length && pLine->pStart[length - 1 - padding] == '=')
+            padding++;
+        *pLength = length / 4 * 3 - padding;
+        return 1;
+    case DUMP_DECODER_Z85:
+        /* A partial group of N bytes is sent as N+1 digits so a lone digit can never be valid. */
+        if (length % 5 == 1)
+            return 0;
+        *pLength = length / 5 * 4 + (length % 5 ? length % 5 - 1 : 0);
+        return 1;
+    default:
+        if (length % 2 != 0)
+            return 0;
+        *pLength = length / 2;
+        return 1;
+    }
+}
+
+static int decodeHex(const Line* pLine, uint8_t* pOutput)
+{
+    const uint8_t* pCurr = (const uint8_t*)pLine->pStart;
+    const uint8_t* pEnd = pCurr + pLine->length;
+
+    while (pEnd - pCurr >= SWAR_HEX_DIGITS)
+    {
+        if (!decodeHexWord(pCurr, pOutput))
+            return 0;
+        pCurr += SWAR_HEX_DIGITS;
+        pOutput += SWAR_HEX_DIGITS / 2;
+    }
+    while (pCurr < pEnd)
+    {
+        uint8_t high = g_hexValues[pCurr[0]];
+        uint8_t low = g_hexValues[pCurr[1]];
+
+        if (high == INVALID_DIGIT || low == INVALID_DIGIT)
+            return 0;
+        *pOutput++ = (high << 4) | low;
+        pCurr += 2;
+    }
+    return 1;
+}
+
+static int decodeHexWord(const uint8_t* pDigits, uint8_t* pOutput)
+{
+    uint64_t chars;
+    uint64_t letters;
+    uint64_t values;
+    uint32_t bytes;
+
+    /* Byte i of the word must hold digit i so swap the bytes around on big endian hosts. */
+    memcpy(&chars, pDigits, sizeof(chars));
+    if (!isLittleEndian())
+        chars = swapBytes64(chars);
+    if (chars & SWAR_HIGH_BITS)
+        return 0;
+    /* Setting bit 5 folds upper case letters into lower case without moving any other character into 'a' to 'f'. */
+    letters = inRange(chars | (0x20 * SWAR_ONES), 'a', 'f');
+    if ((inRange(chars, '0', '9') | letters) != SWAR_HIGH_BITS)
+        return 0;
+
+    /* The low nibble of each digit character is its value, once 9 is added for the letters. */
+    values = (chars & (0x0F * SWAR_ONES)) + (letters >> 4) + (letters >> 7);
+    /* Pack each pair of digit values into the low byte of its 16-bit lane and then squeeze the 4 lanes together. */
+    values = ((values & 0x000F000F000F000FULL) << 4) | ((values >> 8) & 0x000F000F000F000FULL);
+    values = (values | (values >> 8)) & 0x0000FFFF0000FFFFULL;
+    bytes = (uint32_t)(values | (values >> 16));
+    if (!isLittleEndian())
+        bytes = (uint32_t)(swapBytes64(bytes) >> 32);
+    memcpy(pOutput, &bytes, sizeof(bytes));
+    return 1;
+}
+
+static int isLittleEndian(void)
+{
+    static const uint16_t value = 1;
+
+    return *(const uint8_t*)&value == 1;
+}
+
+static uint64_t swapBytes64(uint64_t value)
+{
+    uint64_t swapped = 0;
+    int      i;
+
+    for (i = 0 ; i < 8 ; i++)
+    {
+        swapped = (swapped << 8) | (value & 0xFF);
+        value >>= 8;
+    }
+    return swapped;
+}
+
+static uint64_t inRange(uint64_t chars, uint8_t min, uint8_t max)
+{
+    /* Sets the high bit of each byte which is between min and max.  Every byte is known to be less than 0x80 so none
+       of the additions can carry into the next byte. */
+    uint64_t atLeastMin = chars + (0x80 - min) * SWAR_ONES;
+    uint64_t aboveMax = chars + (0x7F - max) * SWAR_ONES;
+
+    return atLeastMin & ~aboveMax & SWAR_HIGH_BITS;
+}
+
+static int decodeBase64(const Line* pLine, uint8_t* pOutput)
+{
+    const uint8_t* pCurr = (const uint8_t*)pLine->pStart;
+    const uint8_t* pEnd = pCurr + pLine->length;
+
+    while (pCurr < pEnd)
+    {
+        uint32_t value = 0;
+        size_t   digitCount;
+        size_t   i;
+
+        /* Padding is only valid in the last group of the line and decodedLength() has already checked its length. */
+        for (digitCount = 0 ; digitCount < 4 ; digitCount++)
+        {
+            uint8_t digit;
+
+            if (pCurr[digitCount] == '=' && pCurr + 4 == pEnd && digitCount >= 2)
+                break;
+            digit = g_base64Values[pCurr[digitCount]];
+            if (digit == INVALID_DIGIT)
+                return 0;
+            value |= (uint32_t)digit << (18 - 6 * digitCount);
+        }
+        for (i = digitCount ; i < 4 ; i++)
+        {
+            if (pCurr[i] != '=')
+                return 0;
+        }
+        for (i = 0 ; i < digitCount - 1 ; i++)
+            *pOutput++ = (value >> (16 - 8 * i)) & 0xFF;
+        pCurr += 4;
+    }
+    return 1;
+}
+
+static int decodeZ85(const Line* pLine, uint8_t* pOutput)
+{
+    const uint8_t* pCurr = (const uint8_t*)pLine->pStart;
+    const uint8_t* pEnd = pCurr + pLine->length;
+
+    while (pCurr < pEnd)
+    {
+        size_t   digitCount = pEnd - pCurr < 5 ? (size_t)(pEnd - pCurr) : 5;
+        uint64_t value = 0;
+        size_t   i;
+
+        /* Partial groups were truncated by the encoder so pad them back out with the highest digit. */
+        for (i = 0 ; i < 5 ; i++)
+        {
+            uint8_t digit = i < digitCount ? g_z85Values[pCurr[i]] : 84;
+
+            if (digit == INVALID_DIGIT)
+                return 0;
+            value = value * 85 + digit;
+        }
+        if (value > 0xFFFFFFFF)
+            return 0;
+        for (i = 0 ; i < digitCount - 1 ; i++)
+            *pOutput++ = (value >> (24 - 8 * i)) & 0xFF;
+        pCurr += digitCount;
+    }
+    return 1;
+}
+
+
+static DumpDecoderResult decodeCobs(const char* pLog, size_t logSize,
+                                    uint8_t* pOutput, size_t outputSize, DumpDecoderDetails* pDetails)
+{
+    static Frame      frame;
+    DumpDecoderResult result = DUMP_DECODER_OK;
+    Capture           capture;
+    uint8_t*          pReceived;
+    size_t            frameSize;
+    size_t            maxFrames;
+    size_t            frameCount = 0;
+    size_t            index = 0;
+    size_t            i;
+    int               isFinalKnown = 0;
+    int               isNewCopy = 1;
+
+    capture.pCurr = (const uint8_t*)pLog;
+    capture.pEnd = capture.pCurr + logSize;
+    pDetails->encoding = DUMP_DECODER_COBS;
+
+    /* Every frame except the last is the same size so use it to work out where the bytes of each frame belong. */
+    frameSize = findFrameSize(capture);
+    if (frameSize == 0)
+        frameSize = COBS_MAX_PAYLOAD;
+    maxFrames = outputSize / frameSize + 1;
+    pReceived = calloc(maxFrames, sizeof(*pReceived));
+    if (!pReceived)
+        return DUMP_DECODER_BUFFER_TOO_SMALL;
+
+    while (nextFrame(&capture, &frame))
+    {
+        size_t offset;
+
+        /* The sequence number restarts at 0 for each copy of the dump and otherwise only wraps around every 32768
+           frames.  Assume that fewer frames than that are lost in a row when unwrapping it. */
+        if (isNewCopy || (frame.sequence == 0 && isSignatureFrame(&frame) &&
+                          (index & COBS_SEQUENCE_MASK) != COBS_SEQUENCE_MASK))
+        {
+            index = frame.sequence;
+        }
+        else
+        {
+            index += (frame.sequence - index) & COBS_SEQUENCE_MASK;
+        }
+        isNewCopy = frame.isFinal;
+
+        if (frame.payloadSize > frameSize || (!frame.isFinal && frame.payloadSize != frameSize))
+            continue;
+        offset = index * frameSize;
+        if (index >= maxFrames || offset + frame.payloadSize > outputSize)
+        {
+            result = DUMP_DECODER_BUFFER_TOO_SMALL;
+            break;
+        }
+        memcpy(pOutput + offset, frame.pPayload, frame.payloadSize);
+        pReceived[index] = 1;
+        if (frame.isFinal)
+        {
+            isFinalKnown = 1;
+            frameCount = index + 1;
+            pDetails->decodedSize = offset + frame.payloadSize;
+        }
+        else if (!isFinalKnown && index + 1 > frameCount)
+        {
+            frameCount = index + 1;
+            pDetails->decodedSize = offset + frame.payloadSize;
+        }
+    }
+
+    /* Zero fill the frames which weren't found in any copy of the dump so that later frames stay at the right offset. */
+    for (i = 0 ; i < frameCount ; i++)
+    {
+        if (pReceived[i])
+            continue;
+        if (pDetails->lostFrameCount++ == 0)
+            pDetails->firstLostFrame = i;
+        memset(pOutput + i * frameSize, 0, frameSize);
+    }
+    free(pReceived);
+
+    if (result != DUMP_DECODER_OK)
+        return result;
+    if (frameCount == 0)
+        return DUMP_DECODER_NO_DUMP;
+    if (!isFinalKnown)
+        return DUMP_DECODER_TRUNCATED;
+    if (pDetails->lostFrameCount > 0)
+        return DUMP_DECODER_LOST_FRAMES;
+    return DUMP_DECODER_OK;
+}
+
+static size_t findFrameSize(Capture capture)
+{
+    static Frame frame;
+
+    while (nextFrame(&capture, &frame))
+    {
+        if (!frame.isFinal)
+            return frame.payloadSize;
+    }
+    return 0;
+}
+
+static int nextFrame(Capture* pCapture, Frame* pFrame)
+{
+    /* Anything between two zero delimiters which doesn't decode to a frame with a valid CRC is skipped.  This includes
+       the text that CobsDump sends before and after each copy of the dump as well as frames with dropped bytes. */
+    while (pCapture->pCurr < pCapture->pEnd)
+    {
+        const uint8_t* pChunk = pCapture->pCurr;
+        const uint8_t* pDelimiter = memchr(pChunk, 0, pCapture->pEnd - pChunk);
+
+        if (!pDelimiter)
+            pDelimiter = pCapture->pEnd;
+        pCapture->pCurr = pDelimiter + 1;
+        if (decodeFrame(pChunk, pDelimiter - pChunk, pFrame))
+            return 1;
+    }
+    return 0;
+}
+
+static int decodeFrame(const uint8_t* pChunk, size_t chunkSize, Frame* pFrame)
+{
+    const uint8_t* pEnd = pChunk + chunkSize;
+    size_t         size = 0;
+    uint32_t       header;
+    uint32_t       crc;
+
+    while (pChunk < pEnd)
+    {
+        size_t code = *pChunk++;
+        size_t runLength = code - 1;
+
+        if ((size_t)(pEnd - pChunk) < runLength || size + runLength > sizeof(pFrame->buffer))
+            return 0;
+        memcpy(&pFrame->buffer[size], pChunk, runLength);
+        size += runLength;
+        pChunk += runLength;
+        /* Each code byte implies a zero after its run except for maximum length runs and the last run. */
+        if (code != 0xFF && pChunk < pEnd)
+        {
+            if (size == sizeof(pFrame->buffer))
+                return 0;
+            pFrame->buffer[size++] = 0;
+        }
+    }
+    if (size < COBS_HEADER_SIZE + COBS_CRC_SIZE)
+        return 0;
+
+    size -= COBS_CRC_SIZE;
+    crc = (uint32_t)pFrame->buffer[size] | ((uint32_t)pFrame->buffer[size + 1] << 8) |
+          ((uint32_t)pFrame->buffer[size + 2] << 16) | ((uint32_t)pFrame->buffer[size + 3] << 24);
+    if (crc != DumpVerifier_Crc32(0, pFrame->buffer, size))
+        return 0;
+    header = (uint32_t)pFrame->buffer[0] | ((uint32_t)pFrame->buffer[1] << 8);
+    pFrame->sequence = header & COBS_SEQUENCE_MASK;
+    pFrame->isFinal = (header & COBS_FINAL_FLAG) != 0;
+    pFrame->pPayload = &pFrame->buffer[COBS_HEADER_SIZE];
+    pFrame->payloadSize = size - COBS_HEADER_SIZE;
+    return 1;
+}
+
+static int isSignatureFrame(const Frame* pFrame)
+{
+    return pFrame->payloadSize >= 2 && pFrame->pPayload[0] == 'c' && pFrame->pPayload[1] == 'C';
+}
+
+
+size_t DumpDecoder_FindMissingLines(const char* pLog, size_t logSize, DumpDecoderLineRange* pRanges, size_t maxRanges)
+{
+    DumpDecoderEncoding bannerEncoding = DUMP_DECODER_AUTO;
+    DumpDecoderEncoding encoding = DUMP_DECODER_AUTO;
+    NumberedLines       lines;
+    Line                line;
+    Log                 log;
+    size_t              rangeCount = 0;
+    size_t              i;
+
+    log.pCurr = pLog;
+    log.pEnd = pLog + logSize;
+    log.lineNumber = 0;
+    while (encoding == DUMP_DECODER_AUTO)
+    {
+        if (!nextLine(&log, &line))
+            return 0;
+        if (containsString(&line, " ENCOUNTERED"))
+            bannerEncoding = parseBanner(&line);
+        else
+            encoding = findNumberedSignature(&line, bannerEncoding);
+    }
+
+    memset(&lines, 0, sizeof(lines));
+    if (collectNumberedLines(&log, &line, encoding, &lines) == DUMP_DECODER_OK)
+    {
+        for (i = 0 ; i < lines.lineCount ; i++)
+        {
+            if (!isLineMissing(&lines, i))
+                continue;
+            if (i == 0 || !isLineMissing(&lines, i - 1))
+            {
+                if (rangeCount < maxRanges)
+                    pRanges[rangeCount].first = i;
+                rangeCount++;
+            }
+            if (rangeCount <= maxRanges)
+                pRanges[rangeCount - 1].last = i;
+        }
+    }
+    freeNumberedLines(&lines);
+    return rangeCount;
+}
+
+const char* DumpDecoder_ResultString(DumpDecoderResult result)
+{
+    switch (result)
+    {
+    case DUMP_DECODER_OK:
+        return "OK";
+    case DUMP_DECODER_NO_DUMP:
+        return "no dump signature found";
+    case DUMP_DECODER_TRUNCATED:
+        return "log ended before end of dump";
+    case DUMP_DECODER_BAD_LINE:
+        return "invalid line in dump";
+    case DUMP_DECODER_BUFFER_TOO_SMALL:
+        return "output buffer too small";
+    case DUMP_DECODER_LOST_FRAMES:
+        return "frames lost from every copy of dump";
+    case DUMP_DECODER_MISSING_LINES:
+        return "lines missing from every copy of dump";
+    }
+    return "unknown result";
+}
+
+const char* DumpDecoder_EncodingString(DumpDecoderEncoding encoding)
+{
+    switch (encoding)
+    {
+    case DUMP_DECODER_AUTO:
+        return "auto";
+    case DUMP_DECODER_HEX:
+        return "hex";
+    case DUMP_DECODER_BASE64:
+        return "Base64";
+    case DUMP_DECODER_Z85:
+        return "Z85";
+    case DUMP_DECODER_COBS:
+        return "COBS";
+    }
+    return "unknown";
+}
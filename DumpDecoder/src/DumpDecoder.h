@@ -0,0 +1,115 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Host side decoder which converts the text logged from the HexDump module back into a binary dump. */
+#ifndef _DUMP_DECODER_H_
+#define _DUMP_DECODER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+typedef enum
+{
+    /* Detect the encoding from the "ENCOUNTERED" banner or, if it wasn't logged, from the signature line. */
+    DUMP_DECODER_AUTO = 0,
+    DUMP_DECODER_HEX,
+    DUMP_DECODER_BASE64,
+    DUMP_DECODER_Z85,
+    /* Binary frames sent by the CobsDump module. */
+    DUMP_DECODER_COBS
+} DumpDecoderEncoding;
+
+typedef enum
+{
+    /* The whole dump, up to and including the "End of dump" line, was decoded. */
+    DUMP_DECODER_OK = 0,
+    /* The "cC" signature line which starts every dump couldn't be found in the log. */
+    DUMP_DECODER_NO_DUMP,
+    /* The log ended before the "End of dump" line.  Everything up to that point was still decoded. */
+    DUMP_DECODER_TRUNCATED,
+    /* A line in the middle of the dump contains characters or has a length which isn't valid for the encoding. */
+    DUMP_DECODER_BAD_LINE,
+    /* The decoded dump doesn't fit in the output buffer. */
+    DUMP_DECODER_BUFFER_TOO_SMALL,
+    /* Some COBS frames were missing or corrupted in every copy of the dump found in the log.  Their bytes were left
+       zero filled so that the rest of the dump is still at the correct offsets. */
+    DUMP_DECODER_LOST_FRAMES,
+    /* Some numbered lines, sent when CRASH_CATCHER_HEX_DUMP_LINE_CHECKSUMS is set, were missing or had a bad checksum
+       in every copy found in the log.  Only the lines before the first missing one were decoded. */
+    DUMP_DECODER_MISSING_LINES
+} DumpDecoderResult;
+
+typedef struct
+{
+    /* Encoding which was used to decode the dump. */
+    DumpDecoderEncoding encoding;
+    /* Number of bytes written to the output buffer. */
+    size_t              decodedSize;
+    /* 1-based line number of the offending line for DUMP_DECODER_BAD_LINE and DUMP_DECODER_BUFFER_TOO_SMALL. */
+    size_t              lineNumber;
+    /* Number of COBS frames which couldn't be recovered from any copy of the dump for DUMP_DECODER_LOST_FRAMES and
+       the index of the first one. */
+    size_t              lostFrameCount;
+    size_t              firstLostFrame;
+    /* Number of numbered lines which couldn't be found in the log for DUMP_DECODER_MISSING_LINES and the line number
+       of the first one. */
+    size_t              missingLineCount;
+    size_t              firstMissingLine;
+    /* Number of lines in the middle of the dump which DumpDecoder_DecodeEmbedded() skipped because they weren't valid
+       for the encoding. */
+    size_t              skippedLineCount;
+} DumpDecoderDetails;
+
+/* Inclusive range of numbered lines which can be requested again from the HexDump module by sending "Rfirst-last". */
+typedef struct
+{
+    uint32_t first;
+    uint32_t last;
+} DumpDecoderLineRange;
+
+
+/* Returns an output buffer size which is large enough for DumpDecoder_Decode() to decode any logSize byte log. */
+size_t            DumpDecoder_MaxDecodedSize(size_t logSize);
+
+/* Decodes the first dump found in the logSize bytes of text at pLog into pOutput.  Any text logged before the dump is
+   skipped.  Pass in DUMP_DECODER_AUTO for encoding to detect it from the banner or the signature line.  Logs which
+   contain zero bytes are detected as COBS captures.  For those, every copy of the dump in the log is merged so that
+   frames lost from one copy can be recovered from another.  Numbered lines are taken from the first copy with a valid
+   checksum, including copies resent later in the log.  pDetails can be NULL if the caller only cares about the
+   result. */
+DumpDecoderResult DumpDecoder_Decode(const char* pLog, size_t logSize, DumpDecoderEncoding encoding,
+                                     uint8_t* pOutput, size_t outputSize, DumpDecoderDetails* pDetails);
+
+/* Same as DumpDecoder_Decode() except that lines in the middle of a text dump which aren't valid for the encoding are
+   skipped rather than failing with DUMP_DECODER_BAD_LINE.  Use this for console logs where other output can end up
+   interleaved with the dump.  Noise which happens to be valid for the encoding can't be told apart from the dump
+   though. */
+DumpDecoderResult DumpDecoder_DecodeEmbedded(const char* pLog, size_t logSize, DumpDecoderEncoding encoding,
+                                             uint8_t* pOutput, size_t outputSize, DumpDecoderDetails* pDetails);
+
+/* Finds the numbered lines of the first dump in the log which are missing or had a bad checksum in every copy sent so
+   far.  Up to maxRanges ranges of them are stored in pRanges.  Returns the total number of ranges found, which can be
+   larger than maxRanges.  Returns 0 if the dump wasn't sent with numbered lines. */
+size_t            DumpDecoder_FindMissingLines(const char* pLog, size_t logSize,
+                                               DumpDecoderLineRange* pRanges, size_t maxRanges);
+
+/* Returns a short description of result. */
+const char*       DumpDecoder_ResultString(DumpDecoderResult result);
+
+/* Returns the name of encoding as used in the HexDump banner. */
+const char*       DumpDecoder_EncodingString(DumpDecoderEncoding encoding);
+
+
+#endif /* _DUMP_DECODER_H_ */
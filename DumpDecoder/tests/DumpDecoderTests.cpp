@@ -0,0 +1,748 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Include headers from C modules under test.
+extern "C"
+{
+    #include <DumpDecoder.h>
+    #include <DumpVerifier.h>
+}
+
+// Include C++ headers for test harness.
+#include <CppUTest/TestHarness.h>
+
+
+// Each of the test logs below decodes to these bytes: the signature, the flags and then 17 bytes of memory.
+static const uint8_t g_expectedDump[] = { 0x63, 0x43, 0x03, 0x00,
+                                          0x01, 0x00, 0x00, 0x00,
+                                          0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+                                          0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+                                          0x10 };
+
+static const char g_hexLog[] = "\r\n\r\nCRASH ENCOUNTERED\r\n"
+                               "Enable logging and then press any key to start dump.\r\n"
+                               "\r\n"
+                               "63430300\r\n"
+                               "01000000\r\n"
+                               "000102030405060708090A0B0C0D0E0F\r\n"
+                               "10\r\n"
+                               "\r\n"
+                               "End of dump\r\n";
+
+static const char g_base64Log[] = "\r\n\r\nCRASH ENCOUNTERED (Base64)\r\n"
+                                  "Enable logging and then press any key to start dump.\r\n"
+                                  "\r\n"
+                                  "Y0MDAA==\r\n"
+                                  "AQAAAA==\r\n"
+                                  "AAECAwQFBgcICQoLDA0ODxA=\r\n"
+                                  "\r\n"
+                                  "End of dump\r\n";
+
+static const char g_z85Log[] = "\r\n\r\nBREAKPOINT ENCOUNTERED (Z85)\r\n"
+                               "Enable logging and then press any key to start dump.\r\n"
+                               "\r\n"
+                               "v)Zs#\r\n"
+                               "0rr91\r\n"
+                               "009c61o!#m2NH?C3>iWS5c\r\n"
+                               "\r\n"
+                               "End of dump\r\n";
+
+
+TEST_GROUP(DumpDecoder)
+{
+    uint8_t            m_dump[256];
+    char               m_log[512];
+    DumpDecoderDetails m_details;
+
+    void setup()
+    {
+        memset(m_dump, 0xFF, sizeof(m_dump));
+        memset(&m_details, 0xFF, sizeof(m_details));
+    }
+
+    void teardown()
+    {
+    }
+
+    DumpDecoderResult decode(const char* pLog, DumpDecoderEncoding encoding = DUMP_DECODER_AUTO)
+    {
+        return DumpDecoder_Decode(pLog, strlen(pLog), encoding, m_dump, sizeof(m_dump), &m_details);
+    }
+
+    void validateExpectedDump(DumpDecoderEncoding expectedEncoding)
+    {
+        CHECK_EQUAL(expectedEncoding, m_details.encoding);
+        CHECK_EQUAL(sizeof(g_expectedDump), m_details.decodedSize);
+        MEMCMP_EQUAL(g_expectedDump, m_dump, sizeof(g_expectedDump));
+    }
+
+    // Returns the portion of a test log which starts with its signature line, as captured when logging is enabled late.
+    const char* skipBanner(const char* pLog)
+    {
+        return strstr(pLog, "dump.\r\n\r\n") + 9;
+    }
+};
+
+
+TEST(DumpDecoder, HexLog_ShouldDecode)
+{
+    CHECK_EQUAL(DUMP_DECODER_OK, decode(g_hexLog));
+    validateExpectedDump(DUMP_DECODER_HEX);
+}
+
+TEST(DumpDecoder, Base64Log_ShouldDetectEncodingFromBannerAndDecode)
+{
+    CHECK_EQUAL(DUMP_DECODER_OK, decode(g_base64Log));
+    validateExpectedDump(DUMP_DECODER_BASE64);
+}
+
+TEST(DumpDecoder, Z85Log_ShouldDetectEncodingFromBannerAndDecode)
+{
+    CHECK_EQUAL(DUMP_DECODER_OK, decode(g_z85Log));
+    validateExpectedDump(DUMP_DECODER_Z85);
+}
+
+TEST(DumpDecoder, HexLogWithoutBanner_ShouldDetectEncodingFromSignature)
+{
+    CHECK_EQUAL(DUMP_DECODER_OK, decode(skipBanner(g_hexLog)));
+    validateExpectedDump(DUMP_DECODER_HEX);
+}
+
+TEST(DumpDecoder, Base64LogWithoutBanner_ShouldDetectEncodingFromSignature)
+{
+    CHECK_EQUAL(DUMP_DECODER_OK, decode(skipBanner(g_base64Log)));
+    validateExpectedDump(DUMP_DECODER_BASE64);
+}
+
+TEST(DumpDecoder, Z85LogWithoutBanner_ShouldDetectEncodingFromSignature)
+{
+    CHECK_EQUAL(DUMP_DECODER_OK, decode(skipBanner(g_z85Log)));
+    validateExpectedDump(DUMP_DECODER_Z85);
+}
+
+TEST(DumpDecoder, Z85LogWithExplicitEncoding_ShouldDecode)
+{
+    CHECK_EQUAL(DUMP_DECODER_OK, decode(skipBanner(g_z85Log), DUMP_DECODER_Z85));
+    validateExpectedDump(DUMP_DECODER_Z85);
+}
+
+TEST(DumpDecoder, Base64LogWithWrongExplicitEncoding_ShouldFailToFindSignature)
+{
+    CHECK_EQUAL(DUMP_DECODER_NO_DUMP, decode(g_base64Log, DUMP_DECODER_Z85));
+}
+
+TEST(DumpDecoder, LogWithTextBeforeDump_ShouldSkipIt)
+{
+    strcpy(m_log, "Booting...\r\nAssert failed: main.c:42\r\nCAFE\r\n");
+    strcat(m_log, g_hexLog);
+    CHECK_EQUAL(DUMP_DECODER_OK, decode(m_log));
+    validateExpectedDump(DUMP_DECODER_HEX);
+}
+
+TEST(DumpDecoder, LogWithTwoDumps_ShouldOnlyDecodeFirst)
+{
+    strcpy(m_log, g_hexLog);
+    strcat(m_log, g_base64Log);
+    CHECK_EQUAL(DUMP_DECODER_OK, decode(m_log));
+    validateExpectedDump(DUMP_DECODER_HEX);
+}
+
+TEST(DumpDecoder, LowercaseHexWithUnixLineEndings_ShouldDecode)
+{
+    CHECK_EQUAL(DUMP_DECODER_OK, decode("63430300\n01000000\n000102030405060708090a0b0c0d0e0f\n10\n\nEnd of dump\n"));
+    validateExpectedDump(DUMP_DECODER_HEX);
+}
+
+TEST(DumpDecoder, LogEndingBeforeEndOfDump_ShouldReturnTruncatedButStillDecode)
+{
+    CHECK_EQUAL(DUMP_DECODER_TRUNCATED, decode("Y0MDAA==\r\nAQAAAA==\r\nAAECAwQFBgcICQoLDA0ODxA="));
+    validateExpectedDump(DUMP_DECODER_BASE64);
+}
+
+TEST(DumpDecoder, EmptyLog_ShouldReturnNoDump)
+{
+    CHECK_EQUAL(DUMP_DECODER_NO_DUMP, decode(""));
+    CHECK_EQUAL(0, m_details.decodedSize);
+}
+
+TEST(DumpDecoder, LogWithoutSignature_ShouldReturnNoDump)
+{
+    CHECK_EQUAL(DUMP_DECODER_NO_DUMP, decode("\r\n\r\nCRASH ENCOUNTERED\r\n01000000\r\nEnd of dump\r\n"));
+}
+
+TEST(DumpDecoder, HexLineWithInvalidCharacter_ShouldReturnBadLineWithLineNumber)
+{
+    CHECK_EQUAL(DUMP_DECODER_BAD_LINE, decode("63430300\r\n0100G000\r\nEnd of dump\r\n"));
+    CHECK_EQUAL(2, m_details.lineNumber);
+    CHECK_EQUAL(4, m_details.decodedSize);
+}
+
+TEST(DumpDecoder, HexLineWithOddLength_ShouldReturnBadLine)
+{
+    CHECK_EQUAL(DUMP_DECODER_BAD_LINE, decode("63430300\r\n0100000\r\nEnd of dump\r\n"));
+    CHECK_EQUAL(2, m_details.lineNumber);
+}
+
+TEST(DumpDecoder, Base64LineWithPaddingInMiddle_ShouldReturnBadLine)
+{
+    CHECK_EQUAL(DUMP_DECODER_BAD_LINE, decode("Y0MDAA==\r\nAQ==AAAA\r\nEnd of dump\r\n"));
+    CHECK_EQUAL(2, m_details.lineNumber);
+}
+
+TEST(DumpDecoder, Base64LineWithDigitAfterPadding_ShouldReturnBadLine)
+{
+    CHECK_EQUAL(DUMP_DECODER_BAD_LINE, decode("Y0MDAA==\r\nAQ=A\r\nEnd of dump\r\n"));
+}
+
+TEST(DumpDecoder, Base64LineWithInvalidLength_ShouldReturnBadLine)
+{
+    CHECK_EQUAL(DUMP_DECODER_BAD_LINE, decode("Y0MDAA==\r\nAQAAA\r\nEnd of dump\r\n"));
+}
+
+TEST(DumpDecoder, Z85LineWithSingleTrailingDigit_ShouldReturnBadLine)
+{
+    CHECK_EQUAL(DUMP_DECODER_BAD_LINE, decode("v)Zs#\r\n0rr910\r\nEnd of dump\r\n"));
+}
+
+TEST(DumpDecoder, Z85GroupLargerThan32Bits_ShouldReturnBadLine)
+{
+    CHECK_EQUAL(DUMP_DECODER_BAD_LINE, decode("v)Zs#\r\n#####\r\nEnd of dump\r\n"));
+}
+
+TEST(DumpDecoder, Z85LineWithInvalidCharacter_ShouldReturnBadLine)
+{
+    CHECK_EQUAL(DUMP_DECODER_BAD_LINE, decode("v)Zs#\r\n0rr\"1\r\nEnd of dump\r\n"));
+}
+
+TEST(DumpDecoder, OutputBufferTooSmall_ShouldReturnBufferTooSmallWithLineNumber)
+{
+    const char* pLog = skipBanner(g_hexLog);
+
+    CHECK_EQUAL(DUMP_DECODER_BUFFER_TOO_SMALL, DumpDecoder_Decode(pLog, strlen(pLog), DUMP_DECODER_AUTO,
+                                                                  m_dump, 16, &m_details));
+    CHECK_EQUAL(3, m_details.lineNumber);
+    CHECK_EQUAL(8, m_details.decodedSize);
+}
+
+TEST(DumpDecoder, NullDetails_ShouldStillDecode)
+{
+    CHECK_EQUAL(DUMP_DECODER_OK, DumpDecoder_Decode(g_z85Log, strlen(g_z85Log), DUMP_DECODER_AUTO,
+                                                    m_dump, sizeof(m_dump), NULL));
+    MEMCMP_EQUAL(g_expectedDump, m_dump, sizeof(g_expectedDump));
+}
+
+TEST(DumpDecoder, MaxDecodedSize_ShouldBeLargeEnoughForDensestEncoding)
+{
+    CHECK_TRUE(DumpDecoder_MaxDecodedSize(strlen(g_z85Log)) >= sizeof(g_expectedDump));
+    CHECK_TRUE(DumpDecoder_MaxDecodedSize(5) >= 4);
+    CHECK_TRUE(DumpDecoder_MaxDecodedSize(4) >= 3);
+}
+
+TEST(DumpDecoder, ResultString_ShouldReturnStringForEachResult)
+{
+    STRCMP_EQUAL("OK", DumpDecoder_ResultString(DUMP_DECODER_OK));
+    STRCMP_EQUAL("no dump signature found", DumpDecoder_ResultString(DUMP_DECODER_NO_DUMP));
+    STRCMP_EQUAL("log ended before end of dump", DumpDecoder_ResultString(DUMP_DECODER_TRUNCATED));
+    STRCMP_EQUAL("invalid line in dump", DumpDecoder_ResultString(DUMP_DECODER_BAD_LINE));
+    STRCMP_EQUAL("output buffer too small", DumpDecoder_ResultString(DUMP_DECODER_BUFFER_TOO_SMALL));
+    STRCMP_EQUAL("unknown result", DumpDecoder_ResultString((DumpDecoderResult)-1));
+}
+
+TEST(DumpDecoder, EncodingString_ShouldReturnStringForEachEncoding)
+{
+    STRCMP_EQUAL("auto", DumpDecoder_EncodingString(DUMP_DECODER_AUTO));
+    STRCMP_EQUAL("hex", DumpDecoder_EncodingString(DUMP_DECODER_HEX));
+    STRCMP_EQUAL("Base64", DumpDecoder_EncodingString(DUMP_DECODER_BASE64));
+    STRCMP_EQUAL("Z85", DumpDecoder_EncodingString(DUMP_DECODER_Z85));
+    STRCMP_EQUAL("unknown", DumpDecoder_EncodingString((DumpDecoderEncoding)-1));
+}
+
+TEST(DumpDecoder, HexLineWithEveryByteValue_ShouldDecodeWithMixedCaseDigits)
+{
+    static const char hexDigits[] = "0123456789ABCDEF0123456789abcdef";
+    char              log[9 + 512 + 1 + 13 + 1];
+    uint8_t           dump[4 + 256];
+    char*             pCurr = log;
+
+    // Alternate upper and lower case digits on every byte so that each word decoded at once mixes them.
+    pCurr += sprintf(pCurr, "63430300\n");
+    for (int i = 0 ; i < 256 ; i++)
+    {
+        const char* pDigits = hexDigits + (i & 1) * 16;
+
+        *pCurr++ = pDigits[i >> 4];
+        *pCurr++ = pDigits[i & 0xF];
+    }
+    strcpy(pCurr, "\nEnd of dump\n");
+    CHECK_EQUAL(DUMP_DECODER_OK, DumpDecoder_Decode(log, strlen(log), DUMP_DECODER_AUTO,
+                                                    dump, sizeof(dump), &m_details));
+    CHECK_EQUAL(sizeof(dump), m_details.decodedSize);
+    for (int i = 0 ; i < 256 ; i++)
+        CHECK_EQUAL(i, dump[4 + i]);
+}
+
+TEST(DumpDecoder, HexLineWithInvalidCharacterAnywhereInWord_ShouldReturnBadLine)
+{
+    // Characters just outside each of the digit ranges, a space and one with the high bit set.
+    static const char invalidChars[] = "/:@G`g \x80";
+
+    for (size_t i = 0 ; i < sizeof(invalidChars) - 1 ; i++)
+    {
+        for (int position = 0 ; position < 16 ; position++)
+        {
+            strcpy(m_log, "63430300\r\n0001020304050607\r\nEnd of dump\r\n");
+            m_log[10 + position] = invalidChars[i];
+            CHECK_EQUAL(DUMP_DECODER_BAD_LINE, decode(m_log));
+            CHECK_EQUAL(2, m_details.lineNumber);
+        }
+    }
+}
+
+TEST(DumpDecoder, LinesWithStrayCarriageReturns_ShouldDecode)
+{
+    CHECK_EQUAL(DUMP_DECODER_OK, decode("\r63430300\r\r\n\r01000000\r\n\r\r\n000102030405060708090A0B0C0D0E0F\r\n"
+                                        "\r10\r\n\rEnd of dump\r\n"));
+    validateExpectedDump(DUMP_DECODER_HEX);
+}
+
+TEST(DumpDecoder, DecodeEmbedded_ShouldSkipInterleavedLogLines)
+{
+    static const char log[] = "63430300\r\n"
+                              "[  12.345] wifi: reconnecting\r\n"
+                              "01000000\r\n"
+                              "000102030405060708090A0B0C0D0E0F\r\n"
+                              "Watchdog fed\r\n"
+                              "10\r\n"
+                              "End of dump\r\n";
+
+    CHECK_EQUAL(DUMP_DECODER_OK, DumpDecoder_DecodeEmbedded(log, strlen(log), DUMP_DECODER_AUTO,
+                                                            m_dump, sizeof(m_dump), &m_details));
+    validateExpectedDump(DUMP_DECODER_HEX);
+    CHECK_EQUAL(2, m_details.skippedLineCount);
+}
+
+TEST(DumpDecoder, DecodeEmbeddedWithoutInterleavedLines_ShouldMatchDecode)
+{
+    CHECK_EQUAL(DUMP_DECODER_OK, DumpDecoder_DecodeEmbedded(g_base64Log, strlen(g_base64Log), DUMP_DECODER_AUTO,
+                                                            m_dump, sizeof(m_dump), &m_details));
+    validateExpectedDump(DUMP_DECODER_BASE64);
+    CHECK_EQUAL(0, m_details.skippedLineCount);
+}
+
+TEST(DumpDecoder, DecodeEmbeddedWithOutputBufferTooSmall_ShouldStillFail)
+{
+    const char* pLog = skipBanner(g_hexLog);
+
+    CHECK_EQUAL(DUMP_DECODER_BUFFER_TOO_SMALL, DumpDecoder_DecodeEmbedded(pLog, strlen(pLog), DUMP_DECODER_AUTO,
+                                                                          m_dump, 16, &m_details));
+    CHECK_EQUAL(3, m_details.lineNumber);
+}
+
+
+TEST_GROUP(DumpDecoderCobs)
+{
+    uint8_t            m_dump[64];
+    uint8_t            m_capture[2048];
+    size_t             m_captureSize;
+    DumpDecoderDetails m_details;
+
+    void setup()
+    {
+        memset(m_dump, 0xFF, sizeof(m_dump));
+        memset(&m_details, 0xFF, sizeof(m_details));
+        m_captureSize = 0;
+    }
+
+    void teardown()
+    {
+    }
+
+    // Appends the text and leading delimiter which CobsDump sends before the frames of each copy of the dump.
+    void appendBanner()
+    {
+        static const char banner[] = "\r\n\r\nCRASH ENCOUNTERED (COBS)\r\n"
+                                     "Enable logging and then press any key to start dump.\r\n"
+                                     "\r\n";
+
+        memcpy(&m_capture[m_captureSize], banner, sizeof(banner));
+        m_captureSize += sizeof(banner);
+    }
+
+    void appendEndOfDump()
+    {
+        memcpy(&m_capture[m_captureSize], "\r\nEnd of dump\r\n", 15);
+        m_captureSize += 15;
+    }
+
+    // Appends a frame in the same format as CobsDump: 16-bit header, payload, CRC32, COBS encoded and zero delimited.
+    void appendFrame(uint16_t sequence, int isFinal, const uint8_t* pPayload, size_t payloadSize)
+    {
+        uint8_t  frame[512];
+        size_t   frameSize = 0;
+        uint16_t header = sequence | (isFinal ? 0x8000 : 0);
+        uint32_t crc;
+
+        frame[frameSize++] = header & 0xFF;
+        frame[frameSize++] = header >> 8;
+        memcpy(&frame[frameSize], pPayload, payloadSize);
+        frameSize += payloadSize;
+        crc = DumpVerifier_Crc32(0, frame, frameSize);
+        for (int i = 0 ; i < 4 ; i++)
+            frame[frameSize++] = crc >> (8 * i);
+
+        size_t codeOffset = m_captureSize++;
+        for (size_t i = 0 ; i < frameSize ; i++)
+        {
+            if (frame[i] != 0)
+                m_capture[m_captureSize++] = frame[i];
+            if (frame[i] == 0 || m_captureSize - codeOffset == 0xFF)
+            {
+                m_capture[codeOffset] = m_captureSize - codeOffset;
+                codeOffset = m_captureSize++;
+            }
+        }
+        m_capture[codeOffset] = m_captureSize - codeOffset;
+        m_capture[m_captureSize++] = 0;
+    }
+
+    // Appends a copy of the dump built from 8 byte frames of g_expectedDump, skipping the frame at skipFrame.
+    void appendCopy(int skipFrame = -1)
+    {
+        size_t frameCount = (sizeof(g_expectedDump) + 7) / 8;
+
+        appendBanner();
+        for (size_t i = 0 ; i < frameCount ; i++)
+        {
+            size_t size = i == frameCount - 1 ? sizeof(g_expectedDump) - 8 * i : 8;
+
+            if ((int)i != skipFrame)
+                appendFrame(i, i == frameCount - 1, &g_expectedDump[8 * i], size);
+        }
+        appendEndOfDump();
+    }
+
+    DumpDecoderResult decode(DumpDecoderEncoding encoding = DUMP_DECODER_AUTO)
+    {
+        return DumpDecoder_Decode((const char*)m_capture, m_captureSize, encoding, m_dump, sizeof(m_dump), &m_details);
+    }
+
+    void validateExpectedDump()
+    {
+        CHECK_EQUAL(DUMP_DECODER_COBS, m_details.encoding);
+        CHECK_EQUAL(sizeof(g_expectedDump), m_details.decodedSize);
+        MEMCMP_EQUAL(g_expectedDump, m_dump, sizeof(g_expectedDump));
+    }
+};
+
+
+TEST(DumpDecoderCobs, SingleCopy_ShouldDetectEncodingFromZeroBytesAndDecode)
+{
+    appendCopy();
+    CHECK_EQUAL(DUMP_DECODER_OK, decode());
+    validateExpectedDump();
+    CHECK_EQUAL(0, m_details.lostFrameCount);
+}
+
+TEST(DumpDecoderCobs, SingleCopyWithExplicitEncoding_ShouldDecode)
+{
+    appendCopy();
+    CHECK_EQUAL(DUMP_DECODER_OK, decode(DUMP_DECODER_COBS));
+    validateExpectedDump();
+}
+
+TEST(DumpDecoderCobs, CopyMissingFrame_ShouldZeroFillItAndReturnLostFrames)
+{
+    uint8_t expectedDump[sizeof(g_expectedDump)];
+
+    memcpy(expectedDump, g_expectedDump, sizeof(expectedDump));
+    memset(&expectedDump[8], 0, 8);
+    appendCopy(1);
+    CHECK_EQUAL(DUMP_DECODER_LOST_FRAMES, decode());
+    CHECK_EQUAL(1, m_details.lostFrameCount);
+    CHECK_EQUAL(1, m_details.firstLostFrame);
+    CHECK_EQUAL(sizeof(g_expectedDump), m_details.decodedSize);
+    MEMCMP_EQUAL(expectedDump, m_dump, sizeof(expectedDump));
+}
+
+TEST(DumpDecoderCobs, FrameMissingFromFirstCopy_ShouldBeRecoveredFromSecondCopy)
+{
+    appendCopy(2);
+    appendCopy();
+    CHECK_EQUAL(DUMP_DECODER_OK, decode());
+    validateExpectedDump();
+}
+
+TEST(DumpDecoderCobs, FrameWithDroppedByte_ShouldResynchroniseAtNextDelimiter)
+{
+    uint8_t* pSecondFrame;
+
+    appendCopy();
+    // Drop the middle byte of the second frame from the capture.
+    pSecondFrame = (uint8_t*)memchr(m_capture, 0, m_captureSize) + 1;
+    pSecondFrame = (uint8_t*)memchr(pSecondFrame, 0, m_captureSize) + 1;
+    memmove(pSecondFrame + 5, pSecondFrame + 6, m_captureSize - (pSecondFrame + 6 - m_capture));
+    m_captureSize--;
+    appendCopy(0);
+
+    CHECK_EQUAL(DUMP_DECODER_OK, decode());
+    validateExpectedDump();
+}
+
+TEST(DumpDecoderCobs, FrameWithCorruptedByte_ShouldBeRejectedByCrc)
+{
+    appendCopy();
+    m_capture[m_captureSize - 20] ^= 0x01;
+    CHECK_EQUAL(DUMP_DECODER_TRUNCATED, decode());
+    CHECK_EQUAL(3 * 8, m_details.decodedSize);
+}
+
+TEST(DumpDecoderCobs, NoFinalFrame_ShouldReturnTruncated)
+{
+    appendCopy(3);
+    CHECK_EQUAL(DUMP_DECODER_TRUNCATED, decode());
+    CHECK_EQUAL(3 * 8, m_details.decodedSize);
+    MEMCMP_EQUAL(g_expectedDump, m_dump, 3 * 8);
+}
+
+TEST(DumpDecoderCobs, NoValidFrames_ShouldReturnNoDump)
+{
+    appendBanner();
+    appendEndOfDump();
+    CHECK_EQUAL(DUMP_DECODER_NO_DUMP, decode());
+}
+
+TEST(DumpDecoderCobs, DumpLargerThanOutputBuffer_ShouldReturnBufferTooSmall)
+{
+    appendCopy();
+    CHECK_EQUAL(DUMP_DECODER_BUFFER_TOO_SMALL, DumpDecoder_Decode((const char*)m_capture, m_captureSize,
+                                                                  DUMP_DECODER_AUTO, m_dump, 16, &m_details));
+}
+
+TEST(DumpDecoderCobs, FrameWithLongNonZeroRun_ShouldDecodeMaximumLengthCobsRuns)
+{
+    uint8_t payload[300];
+
+    for (size_t i = 0 ; i < sizeof(payload) ; i++)
+        payload[i] = 1 + i % 255;
+    appendFrame(0, 1, payload, sizeof(payload));
+    CHECK_EQUAL(DUMP_DECODER_OK, DumpDecoder_Decode((const char*)m_capture, m_captureSize, DUMP_DECODER_AUTO,
+                                                    m_capture + 1024, 1024, &m_details));
+    CHECK_EQUAL(sizeof(payload), m_details.decodedSize);
+    MEMCMP_EQUAL(payload, m_capture + 1024, sizeof(payload));
+}
+
+TEST(DumpDecoderCobs, SequenceNumberWrap_ShouldContinueAtNextFrameIndex)
+{
+    static const uint8_t payload[] = { 0x11, 0x22 };
+    size_t               outputSize = 0x8001 * 2;
+    uint8_t*             pOutput = (uint8_t*)malloc(outputSize);
+
+    appendFrame(0x7FFF, 0, &payload[0], 1);
+    appendFrame(0x0000, 1, &payload[1], 1);
+    CHECK_EQUAL(DUMP_DECODER_LOST_FRAMES, DumpDecoder_Decode((const char*)m_capture, m_captureSize, DUMP_DECODER_AUTO,
+                                                             pOutput, outputSize, &m_details));
+    CHECK_EQUAL(0x8001, m_details.decodedSize);
+    CHECK_EQUAL(0x7FFF, m_details.lostFrameCount);
+    CHECK_EQUAL(0x11, pOutput[0x7FFF]);
+    CHECK_EQUAL(0x22, pOutput[0x8000]);
+    free(pOutput);
+}
+
+TEST(DumpDecoderCobs, ResultString_ShouldDescribeLostFrames)
+{
+    STRCMP_EQUAL("frames lost from every copy of dump", DumpDecoder_ResultString(DUMP_DECODER_LOST_FRAMES));
+    STRCMP_EQUAL("COBS", DumpDecoder_EncodingString(DUMP_DECODER_COBS));
+}
+
+
+// Lines of g_hexLog as sent with CRASH_CATCHER_HEX_DUMP_LINE_CHECKSUMS set.
+static const char* const g_numberedLines[] = { "000000 63430300 E7DE\r\n",
+                                               "000001 01000000 B892\r\n",
+                                               "000002 000102030405060708090A0B0C0D0E0F 44DC\r\n",
+                                               "000003 10 9DA9\r\n" };
+
+static const char g_numberedBanner[] = "\r\n\r\nCRASH ENCOUNTERED\r\n"
+                                       "Enable logging and then press any key to start dump.\r\n"
+                                       "\r\n";
+
+static const char g_numberedEnd[] = "\r\n"
+                                    "End of dump\r\n"
+                                    "Line count: 000004\r\n"
+                                    "Send Rfirst-last to resend lines or just press Enter to finish.\r\n";
+
+
+TEST_GROUP(DumpDecoderNumbered)
+{
+    uint8_t              m_dump[256];
+    char                 m_log[1024];
+    DumpDecoderDetails   m_details;
+    DumpDecoderLineRange m_ranges[4];
+
+    void setup()
+    {
+        memset(m_dump, 0xFF, sizeof(m_dump));
+        memset(&m_details, 0xFF, sizeof(m_details));
+        memset(m_ranges, 0xFF, sizeof(m_ranges));
+        m_log[0] = '\0';
+    }
+
+    void teardown()
+    {
+    }
+
+    // Appends each of the numbered lines whose bit is set in lineMask to the log.
+    void appendLines(unsigned int lineMask)
+    {
+        for (size_t i = 0 ; i < sizeof(g_numberedLines) / sizeof(g_numberedLines[0]) ; i++)
+        {
+            if (lineMask & (1 << i))
+                strcat(m_log, g_numberedLines[i]);
+        }
+    }
+
+    DumpDecoderResult decode()
+    {
+        return DumpDecoder_Decode(m_log, strlen(m_log), DUMP_DECODER_AUTO, m_dump, sizeof(m_dump), &m_details);
+    }
+
+    size_t findMissingLines(size_t maxRanges)
+    {
+        return DumpDecoder_FindMissingLines(m_log, strlen(m_log), m_ranges, maxRanges);
+    }
+};
+
+
+TEST(DumpDecoderNumbered, CompleteLog_ShouldDecode)
+{
+    strcpy(m_log, g_numberedBanner);
+    appendLines(0xF);
+    strcat(m_log, g_numberedEnd);
+    CHECK_EQUAL(DUMP_DECODER_OK, decode());
+    CHECK_EQUAL(DUMP_DECODER_HEX, m_details.encoding);
+    CHECK_EQUAL(sizeof(g_expectedDump), m_details.decodedSize);
+    MEMCMP_EQUAL(g_expectedDump, m_dump, sizeof(g_expectedDump));
+    CHECK_EQUAL(0, m_details.missingLineCount);
+    CHECK_EQUAL(0, findMissingLines(4));
+}
+
+TEST(DumpDecoderNumbered, Base64Log_ShouldDecode)
+{
+    strcpy(m_log, "\r\n\r\nCRASH ENCOUNTERED (Base64)\r\n"
+                  "000000 Y0MDAA== E7DE\r\n"
+                  "000001 AQAAAA== B892\r\n"
+                  "000002 AAECAwQFBgcICQoLDA0ODw== 44DC\r\n"
+                  "000003 EA== 9DA9\r\n");
+    strcat(m_log, g_numberedEnd);
+    CHECK_EQUAL(DUMP_DECODER_OK, decode());
+    CHECK_EQUAL(DUMP_DECODER_BASE64, m_details.encoding);
+    CHECK_EQUAL(sizeof(g_expectedDump), m_details.decodedSize);
+    MEMCMP_EQUAL(g_expectedDump, m_dump, sizeof(g_expectedDump));
+}
+
+TEST(DumpDecoderNumbered, LineWithBadChecksum_ShouldReturnMissingLinesAndDecodeUpToIt)
+{
+    strcpy(m_log, g_numberedBanner);
+    appendLines(0x3);
+    strcat(m_log, "000002 000102030405060708090A0B0C0D0E0E 44DC\r\n");
+    appendLines(0x8);
+    strcat(m_log, g_numberedEnd);
+    CHECK_EQUAL(DUMP_DECODER_MISSING_LINES, decode());
+    CHECK_EQUAL(1, m_details.missingLineCount);
+    CHECK_EQUAL(2, m_details.firstMissingLine);
+    CHECK_EQUAL(8, m_details.decodedSize);
+    MEMCMP_EQUAL(g_expectedDump, m_dump, 8);
+}
+
+TEST(DumpDecoderNumbered, DamagedLineResentLater_ShouldBeFilledInFromResentCopy)
+{
+    strcpy(m_log, g_numberedBanner);
+    appendLines(0x3);
+    strcat(m_log, "000002 00010203040506070809\r\n");
+    appendLines(0x8);
+    strcat(m_log, g_numberedEnd);
+    strcat(m_log, "R2-2\r\nOK\r\n\r\n"
+                  "\r\nResending lines\r\n");
+    appendLines(0x4);
+    strcat(m_log, g_numberedEnd);
+    CHECK_EQUAL(DUMP_DECODER_OK, decode());
+    CHECK_EQUAL(sizeof(g_expectedDump), m_details.decodedSize);
+    MEMCMP_EQUAL(g_expectedDump, m_dump, sizeof(g_expectedDump));
+}
+
+TEST(DumpDecoderNumbered, LastLineMissing_ShouldUseLineCountToDetectIt)
+{
+    strcpy(m_log, g_numberedBanner);
+    appendLines(0x7);
+    strcat(m_log, g_numberedEnd);
+    CHECK_EQUAL(DUMP_DECODER_MISSING_LINES, decode());
+    CHECK_EQUAL(1, m_details.missingLineCount);
+    CHECK_EQUAL(3, m_details.firstMissingLine);
+    CHECK_EQUAL(sizeof(g_expectedDump) - 1, m_details.decodedSize);
+}
+
+TEST(DumpDecoderNumbered, LogWithoutLineCount_ShouldReturnTruncated)
+{
+    strcpy(m_log, g_numberedBanner);
+    appendLines(0xF);
+    CHECK_EQUAL(DUMP_DECODER_TRUNCATED, decode());
+    CHECK_EQUAL(sizeof(g_expectedDump), m_details.decodedSize);
+}
+
+TEST(DumpDecoderNumbered, OutputBufferTooSmall_ShouldReturnBufferTooSmallWithLineNumber)
+{
+    strcpy(m_log, g_numberedBanner);
+    appendLines(0xF);
+    strcat(m_log, g_numberedEnd);
+    CHECK_EQUAL(DUMP_DECODER_BUFFER_TOO_SMALL,
+                DumpDecoder_Decode(m_log, strlen(m_log), DUMP_DECODER_AUTO, m_dump, 10, &m_details));
+    CHECK_EQUAL(8, m_details.lineNumber);
+    CHECK_EQUAL(8, m_details.decodedSize);
+}
+
+TEST(DumpDecoderNumbered, FindMissingLines_ShouldMergeAdjacentLinesIntoOneRange)
+{
+    strcpy(m_log, g_numberedBanner);
+    appendLines(0x9);
+    strcat(m_log, g_numberedEnd);
+    CHECK_EQUAL(1, findMissingLines(4));
+    CHECK_EQUAL(1, m_ranges[0].first);
+    CHECK_EQUAL(2, m_ranges[0].last);
+}
+
+TEST(DumpDecoderNumbered, FindMissingLines_ShouldCountRangesWhichDontFit)
+{
+    strcpy(m_log, g_numberedBanner);
+    appendLines(0x5);
+    strcat(m_log, g_numberedEnd);
+    CHECK_EQUAL(2, findMissingLines(1));
+    CHECK_EQUAL(1, m_ranges[0].first);
+    CHECK_EQUAL(1, m_ranges[0].last);
+    CHECK_EQUAL(0xFFFFFFFF, m_ranges[1].first);
+}
+
+TEST(DumpDecoderNumbered, FindMissingLinesInLogWithoutNumberedLines_ShouldReturnZero)
+{
+    strcpy(m_log, g_hexLog);
+    CHECK_EQUAL(0, findMissingLines(4));
+}
+
+TEST(DumpDecoderNumbered, ResultString_ShouldDescribeMissingLines)
+{
+    STRCMP_EQUAL("lines missing from every copy of dump", DumpDecoder_ResultString(DUMP_DECODER_MISSING_LINES));
+}
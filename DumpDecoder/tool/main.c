@@ -0,0 +1,200 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Command line front end for DumpDecoder.  Usage: CrashCatcherDecode [--hex|--base64|--z85|--cobs] logFile dumpFile */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <CrashCatcher.h>
+#include <DumpDecoder.h>
+#include <DumpVerifier.h>
+#include <Lz4Decoder.h>
+
+
+/* The HexDump module only queues up this many resend requests at a time. */
+#define MAX_RESEND_RANGES 8
+
+
+static char* readFile(const char* pFilename, size_t* pSize);
+static int   writeFile(const char* pFilename, const uint8_t* pData, size_t size);
+static void  printResendRequests(const char* pLog, size_t logSize);
+static void  expandCompressedDump(uint8_t** ppDump, size_t* pDumpSize);
+
+
+int main(int argc, char** argv)
+{
+    DumpDecoderEncoding encoding = DUMP_DECODER_AUTO;
+    DumpDecoderDetails  details;
+    DumpDecoderResult   result;
+    uint8_t*            pDump;
+    char*               pLog;
+    size_t              logSize;
+    size_t              dumpSize;
+    int                 argIndex = 1;
+    int                 exitCode;
+
+    if (argc == 4)
+    {
+        if (strcmp(argv[1], "--hex") == 0)
+            encoding = DUMP_DECODER_HEX;
+        else if (strcmp(argv[1], "--base64") == 0)
+            encoding = DUMP_DECODER_BASE64;
+        else if (strcmp(argv[1], "--z85") == 0)
+            encoding = DUMP_DECODER_Z85;
+        else if (strcmp(argv[1], "--cobs") == 0)
+            encoding = DUMP_DECODER_COBS;
+        argIndex = 2;
+    }
+    if (argc - argIndex != 2 || (argc == 4 && encoding == DUMP_DECODER_AUTO))
+    {
+        fprintf(stderr, "Usage: %s [--hex|--base64|--z85|--cobs] logFile dumpFile\n", argv[0]);
+        return 2;
+    }
+
+    pLog = readFile(argv[argIndex], &logSize);
+    if (!pLog)
+        return 1;
+    dumpSize = DumpDecoder_MaxDecodedSize(logSize);
+    pDump = malloc(dumpSize);
+    if (!pDump)
+    {
+        perror(argv[argIndex]);
+        free(pLog);
+        return 1;
+    }
+    result = DumpDecoder_Decode(pLog, logSize, encoding, pDump, dumpSize, &details);
+
+    printf("%s: %s", argv[argIndex], DumpDecoder_ResultString(result));
+    if (result == DUMP_DECODER_BAD_LINE || result == DUMP_DECODER_BUFFER_TOO_SMALL)
+        printf(" on line %u", (unsigned)details.lineNumber);
+    else if (result == DUMP_DECODER_LOST_FRAMES)
+        printf(" (%u frames starting at frame %u)", (unsigned)details.lostFrameCount, (unsigned)details.firstLostFrame);
+    else if (result == DUMP_DECODER_MISSING_LINES)
+        printf(" (%u lines starting at line %u)",
+               (unsigned)details.missingLineCount, (unsigned)details.firstMissingLine);
+    if (result != DUMP_DECODER_NO_DUMP)
+        printf(" (%s, %u bytes)", DumpDecoder_EncodingString(details.encoding), (unsigned)details.decodedSize);
+    printf("\n");
+    if (result == DUMP_DECODER_MISSING_LINES)
+        printResendRequests(pLog, logSize);
+    free(pLog);
+    if (result != DUMP_DECODER_NO_DUMP)
+        expandCompressedDump(&pDump, &details.decodedSize);
+
+    /* Still write out truncated dumps and those with lost frames or lines since the registers and the rest of the
+       regions are often enough to debug the crash. */
+    exitCode = result == DUMP_DECODER_OK ? 0 : 1;
+    if ((result == DUMP_DECODER_OK || result == DUMP_DECODER_TRUNCATED || result == DUMP_DECODER_LOST_FRAMES ||
+         result == DUMP_DECODER_MISSING_LINES) &&
+        writeFile(argv[argIndex + 1], pDump, details.decodedSize) != 0)
+    {
+        exitCode = 1;
+    }
+    free(pDump);
+    return exitCode;
+}
+
+static char* readFile(const char* pFilename, size_t* pSize)
+{
+    FILE* pFile = fopen(pFilename, "rb");
+    char* pData = NULL;
+    long  size;
+
+    if (!pFile || fseek(pFile, 0, SEEK_END) != 0 || (size = ftell(pFile)) < 0 || fseek(pFile, 0, SEEK_SET) != 0)
+    {
+        perror(pFilename);
+        if (pFile)
+            fclose(pFile);
+        return NULL;
+    }
+    pData = malloc(size ? size : 1);
+    if (!pData || fread(pData, 1, size, pFile) != (size_t)size)
+    {
+        perror(pFilename);
+        free(pData);
+        fclose(pFile);
+        return NULL;
+    }
+    fclose(pFile);
+    *pSize = size;
+    return pData;
+}
+
+static int writeFile(const char* pFilename, const uint8_t* pData, size_t size)
+{
+    FILE* pFile = fopen(pFilename, "wb");
+    int   isWritten;
+
+    if (!pFile)
+    {
+        perror(pFilename);
+        return 1;
+    }
+    isWritten = fwrite(pData, 1, size, pFile) == size;
+    if (fclose(pFile) != 0 || !isWritten)
+    {
+        perror(pFilename);
+        return 1;
+    }
+    return 0;
+}
+
+/* GDB and CrashDebug don't know about CRASH_CATCHER_FLAGS_COMPRESSED so expand the blocks and clear the flag before
+   the dump is written out.  Clearing the flag means that the dump CRC no longer matches, so the CRCs are checked first.
+   The dump is written out as decoded if the blocks can't be expanded. */
+static void expandCompressedDump(uint8_t** ppDump, size_t* pDumpSize)
+{
+    Lz4DecoderResult result;
+    uint8_t*         pExpanded = NULL;
+    size_t           expandedSize = 0;
+    uint32_t         flags;
+
+    if (*pDumpSize < 2 * sizeof(uint32_t))
+        return;
+    memcpy(&flags, *ppDump + sizeof(uint32_t), sizeof(flags));
+    if ((flags & CRASH_CATCHER_FLAGS_COMPRESSED) == 0)
+        return;
+    if (flags & CRASH_CATCHER_FLAGS_CRC32)
+        printf("CRC32: %s\n", DumpVerifier_ResultString(DumpVerifier_Verify(*ppDump, *pDumpSize, NULL)));
+
+    result = Lz4Decoder_ExpandDump(*ppDump, *pDumpSize, &pExpanded, &expandedSize);
+    if (result != LZ4_DECODER_OK && result != LZ4_DECODER_TRUNCATED)
+    {
+        printf("Compressed blocks couldn't be expanded (%s) so the dump is written out compressed.\n",
+               result == LZ4_DECODER_MALFORMED ? "malformed block" : "out of memory");
+        free(pExpanded);
+        return;
+    }
+    printf("Expanded %u compressed bytes to %u bytes%s.\n", (unsigned)*pDumpSize, (unsigned)expandedSize,
+           result == LZ4_DECODER_TRUNCATED ? ", dropping the partial last block" : "");
+    flags &= ~CRASH_CATCHER_FLAGS_COMPRESSED;
+    memcpy(pExpanded + sizeof(uint32_t), &flags, sizeof(flags));
+    free(*ppDump);
+    *ppDump = pExpanded;
+    *pDumpSize = expandedSize;
+}
+
+static void printResendRequests(const char* pLog, size_t logSize)
+{
+    DumpDecoderLineRange ranges[MAX_RESEND_RANGES];
+    size_t               rangeCount;
+    size_t               i;
+
+    rangeCount = DumpDecoder_FindMissingLines(pLog, logSize, ranges, MAX_RESEND_RANGES);
+    if (rangeCount > MAX_RESEND_RANGES)
+        rangeCount = MAX_RESEND_RANGES;
+    printf("Send these requests at the device's resend prompt and then append the log of the resent lines:\n");
+    for (i = 0 ; i < rangeCount ; i++)
+        printf("R%06X-%06X\n", (unsigned)ranges[i].first, (unsigned)ranges[i].last);
+}
@@ -0,0 +1,345 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Extracts every dump from a console log in two parallel passes.  The first pass splits the log into fixed size chunks
+   and searches each of them for "ENCOUNTERED" banners.  The second pass decodes the text between each pair of banners
+   as a separate dump.  In both passes, each thread claims the next chunk or dump from a shared counter until there are
+   none left.  Builds without POSIX threads do all of the work on the calling thread. */
+#include <stdlib.h>
+#include <string.h>
+#ifndef _WIN32
+    #include <pthread.h>
+#endif
+#include "DumpExtractor.h"
+
+
+/* Upper limit on the number of threads used for each pass. */
+#define MAX_THREADS             64
+
+/* Banners are found by searching for the 'U' in this string since that letter never shows up in hex dumps and only
+   rarely in the other encodings. */
+#define BANNER_STRING           " ENCOUNTERED"
+#define BANNER_ANCHOR_OFFSET    5
+
+
+typedef struct
+{
+    size_t* pOffsets;
+    size_t  count;
+    size_t  allocated;
+} OffsetList;
+
+typedef struct Job Job;
+typedef void (*ProcessItemFunc)(Job* pJob, size_t item);
+
+struct Job
+{
+    const char*        pLog;
+    size_t             logSize;
+    /* Line offsets of the banners found in each chunk of the log by the first pass. */
+    OffsetList*        pChunkBanners;
+    size_t             chunkCount;
+    /* The text between banners which is decoded by the second pass. */
+    DumpExtractorDump* pDumps;
+    size_t             dumpCount;
+    /* The chunks or dumps of the current pass which are claimed by the threads one at a time. */
+    ProcessItemFunc    processItem;
+    size_t             itemCount;
+    size_t             nextItem;
+    int                isOutOfMemory;
+#ifndef _WIN32
+    pthread_mutex_t    mutex;
+#endif
+};
+
+
+/* The unit tests shrink this to check banners which straddle two chunks. */
+size_t g_dumpExtractorChunkSize = 1024 * 1024;
+
+
+static void   runPass(Job* pJob, ProcessItemFunc processItem, size_t itemCount, unsigned int threadCount);
+static void*  threadMain(void* pvJob);
+static void   processItems(Job* pJob);
+static size_t claimItem(Job* pJob);
+static void   setOutOfMemory(Job* pJob);
+static void   lockJob(Job* pJob);
+static void   unlockJob(Job* pJob);
+static void   scanChunk(Job* pJob, size_t chunk);
+static int    isBannerAt(const Job* pJob, size_t anchorOffset);
+static size_t findLineStart(const char* pLog, size_t offset);
+static int    appendOffset(OffsetList* pList, size_t offset);
+static int    createDumps(Job* pJob);
+static void   freeChunkBanners(Job* pJob);
+static void   decodeDump(Job* pJob, size_t index);
+static void   removeEmptyDumps(DumpExtractorDumps* pDumps);
+
+
+int DumpExtractor_Extract(const char* pLog, size_t logSize, unsigned int threadCount, DumpExtractorDumps* pDumps)
+{
+    Job job;
+
+    memset(pDumps, 0, sizeof(*pDumps));
+    memset(&job, 0, sizeof(job));
+    job.pLog = pLog;
+    job.logSize = logSize;
+    job.chunkCount = (logSize + g_dumpExtractorChunkSize - 1) / g_dumpExtractorChunkSize;
+    job.pChunkBanners = calloc(job.chunkCount ? job.chunkCount : 1, sizeof(*job.pChunkBanners));
+    if (!job.pChunkBanners)
+        return -1;
+
+    runPass(&job, scanChunk, job.chunkCount, threadCount);
+    if (!job.isOutOfMemory && !createDumps(&job))
+        job.isOutOfMemory = 1;
+    freeChunkBanners(&job);
+    if (!job.isOutOfMemory)
+        runPass(&job, decodeDump, job.dumpCount, threadCount);
+
+    pDumps->pDumps = job.pDumps;
+    pDumps->dumpCount = job.dumpCount;
+    if (job.isOutOfMemory)
+        return -1;
+    removeEmptyDumps(pDumps);
+    return 0;
+}
+
+static void runPass(Job* pJob, ProcessItemFunc processItem, size_t itemCount, unsigned int threadCount)
+{
+#ifndef _WIN32
+    pthread_t    threads[MAX_THREADS - 1];
+    unsigned int startedCount = 0;
+#endif
+
+    pJob->processItem = processItem;
+    pJob->itemCount = itemCount;
+    pJob->nextItem = 0;
+#ifndef _WIN32
+    if (threadCount > itemCount)
+        threadCount = itemCount;
+    if (threadCount > MAX_THREADS)
+        threadCount = MAX_THREADS;
+    pthread_mutex_init(&pJob->mutex, NULL);
+    /* The calling thread is one of the threadCount threads.  If any of the others fail to start, the ones which did
+       start just end up claiming more of the items. */
+    while (startedCount + 1 < threadCount && pthread_create(&threads[startedCount], NULL, threadMain, pJob) == 0)
+        startedCount++;
+    processItems(pJob);
+    while (startedCount > 0)
+        pthread_join(threads[--startedCount], NULL);
+    pthread_mutex_destroy(&pJob->mutex);
+#else
+    processItems(pJob);
+#endif
+}
+
+static void* threadMain(void* pvJob)
+{
+    processItems((Job*)pvJob);
+    return NULL;
+}
+
+static void processItems(Job* pJob)
+{
+    size_t item;
+
+    while ((item = claimItem(pJob)) < pJob->itemCount)
+        pJob->processItem(pJob, item);
+}
+
+static size_t claimItem(Job* pJob)
+{
+    size_t item;
+
+    lockJob(pJob);
+    item = pJob->isOutOfMemory ? pJob->itemCount : pJob->nextItem++;
+    unlockJob(pJob);
+    return item;
+}
+
+static void setOutOfMemory(Job* pJob)
+{
+    lockJob(pJob);
+    pJob->isOutOfMemory = 1;
+    unlockJob(pJob);
+}
+
+static void lockJob(Job* pJob)
+{
+#ifndef _WIN32
+    pthread_mutex_lock(&pJob->mutex);
+#endif
+}
+
+static void unlockJob(Job* pJob)
+{
+#ifndef _WIN32
+    pthread_mutex_unlock(&pJob->mutex);
+#endif
+}
+
+static void scanChunk(Job* pJob, size_t chunk)
+{
+    OffsetList* pBanners = &pJob->pChunkBanners[chunk];
+    const char* pLog = pJob->pLog;
+    size_t      startOffset = chunk * g_dumpExtractorChunkSize;
+    const char* pCurr = pLog + startOffset;
+    const char* pEnd = pLog + (pJob->logSize - startOffset < g_dumpExtractorChunkSize ?
+                               pJob->logSize : startOffset + g_dumpExtractorChunkSize);
+
+    /* A banner belongs to the chunk which holds its anchor character, even if the rest of it is in the next chunk. */
+    while (pCurr < pEnd && (pCurr = memchr(pCurr, BANNER_STRING[BANNER_ANCHOR_OFFSET], pEnd - pCurr)) != NULL)
+    {
+        size_t anchorOffset = pCurr - pLog;
+
+        if (isBannerAt(pJob, anchorOffset) &&
+            !appendOffset(pBanners, findLineStart(pLog, anchorOffset - BANNER_ANCHOR_OFFSET)))
+        {
+            setOutOfMemory(pJob);
+            return;
+        }
+        pCurr++;
+    }
+}
+
+static int isBannerAt(const Job* pJob, size_t anchorOffset)
+{
+    size_t bannerLength = sizeof(BANNER_STRING) - 1;
+    size_t startOffset = anchorOffset - BANNER_ANCHOR_OFFSET;
+
+    if (anchorOffset < BANNER_ANCHOR_OFFSET || pJob->logSize - startOffset < bannerLength)
+        return 0;
+    return memcmp(pJob->pLog + startOffset, BANNER_STRING, bannerLength) == 0;
+}
+
+static size_t findLineStart(const char* pLog, size_t offset)
+{
+    while (offset > 0 && pLog[offset - 1] != '\n')
+        offset--;
+    return offset;
+}
+
+static int appendOffset(OffsetList* pList, size_t offset)
+{
+    /* Banners which mention "ENCOUNTERED" more than once only start one dump. */
+    if (pList->count > 0 && pList->pOffsets[pList->count - 1] == offset)
+        return 1;
+    if (pList->count == pList->allocated)
+    {
+        size_t  newAllocated = pList->allocated ? pList->allocated * 2 : 16;
+        size_t* pNewOffsets = realloc(pList->pOffsets, newAllocated * sizeof(*pNewOffsets));
+
+        if (!pNewOffsets)
+            return 0;
+        pList->pOffsets = pNewOffsets;
+        pList->allocated = newAllocated;
+    }
+    pList->pOffsets[pList->count++] = offset;
+    return 1;
+}
+
+static int createDumps(Job* pJob)
+{
+    size_t bannerCount = 0;
+    size_t startOffset = 0;
+    size_t chunk;
+    size_t i;
+
+    for (chunk = 0 ; chunk < pJob->chunkCount ; chunk++)
+        bannerCount += pJob->pChunkBanners[chunk].count;
+    pJob->pDumps = calloc(bannerCount + 1, sizeof(*pJob->pDumps));
+    if (!pJob->pDumps)
+        return 0;
+
+    /* The banners were found in log order so each one ends the text which started at the previous one. */
+    for (chunk = 0 ; chunk < pJob->chunkCount ; chunk++)
+    {
+        const OffsetList* pBanners = &pJob->pChunkBanners[chunk];
+
+        for (i = 0 ; i < pBanners->count ; i++)
+        {
+            size_t offset = pBanners->pOffsets[i];
+
+            if (offset == startOffset)
+                continue;
+            pJob->pDumps[pJob->dumpCount].logOffset = startOffset;
+            pJob->pDumps[pJob->dumpCount].logSize = offset - startOffset;
+            pJob->dumpCount++;
+            startOffset = offset;
+        }
+    }
+    if (startOffset < pJob->logSize)
+    {
+        pJob->pDumps[pJob->dumpCount].logOffset = startOffset;
+        pJob->pDumps[pJob->dumpCount].logSize = pJob->logSize - startOffset;
+        pJob->dumpCount++;
+    }
+    return 1;
+}
+
+static void freeChunkBanners(Job* pJob)
+{
+    size_t chunk;
+
+    for (chunk = 0 ; chunk < pJob->chunkCount ; chunk++)
+        free(pJob->pChunkBanners[chunk].pOffsets);
+    free(pJob->pChunkBanners);
+    pJob->pChunkBanners = NULL;
+}
+
+static void decodeDump(Job* pJob, size_t index)
+{
+    DumpExtractorDump* pDump = &pJob->pDumps[index];
+    size_t             maxSize = DumpDecoder_MaxDecodedSize(pDump->logSize);
+    uint8_t*           pShrunkDump;
+
+    pDump->pDump = malloc(maxSize);
+    if (!pDump->pDump)
+    {
+        setOutOfMemory(pJob);
+        return;
+    }
+    pDump->result = DumpDecoder_DecodeEmbedded(pJob->pLog + pDump->logOffset, pDump->logSize, DUMP_DECODER_AUTO,
+                                               pDump->pDump, maxSize, &pDump->details);
+
+    /* Give back the space which the dump didn't need since the whole log can end up decoded at the same time. */
+    pShrunkDump = realloc(pDump->pDump, pDump->details.decodedSize ? pDump->details.decodedSize : 1);
+    if (pShrunkDump)
+        pDump->pDump = pShrunkDump;
+}
+
+static void removeEmptyDumps(DumpExtractorDumps* pDumps)
+{
+    size_t dumpCount = 0;
+    size_t i;
+
+    for (i = 0 ; i < pDumps->dumpCount ; i++)
+    {
+        if (pDumps->pDumps[i].result == DUMP_DECODER_NO_DUMP)
+            free(pDumps->pDumps[i].pDump);
+        else
+            pDumps->pDumps[dumpCount++] = pDumps->pDumps[i];
+    }
+    pDumps->dumpCount = dumpCount;
+}
+
+
+void DumpExtractor_Free(DumpExtractorDumps* pDumps)
+{
+    size_t i;
+
+    for (i = 0 ; i < pDumps->dumpCount ; i++)
+        free(pDumps->pDumps[i].pDump);
+    free(pDumps->pDumps);
+    pDumps->pDumps = NULL;
+    pDumps->dumpCount = 0;
+}
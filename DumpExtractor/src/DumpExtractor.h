@@ -0,0 +1,54 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Host side extractor which finds every dump embedded in a large console log and decodes them on multiple threads. */
+#ifndef _DUMP_EXTRACTOR_H_
+#define _DUMP_EXTRACTOR_H_
+
+#include <DumpDecoder.h>
+
+
+typedef struct
+{
+    /* Offset and size of the text in the log which was decoded to get this dump.  It starts with the dump's
+       "ENCOUNTERED" banner line and runs up to the next banner or the end of the log. */
+    size_t             logOffset;
+    size_t             logSize;
+    /* Result of decoding the text with DumpDecoder_DecodeEmbedded(). */
+    DumpDecoderResult  result;
+    DumpDecoderDetails details;
+    /* The details.decodedSize bytes of the decoded dump. */
+    uint8_t*           pDump;
+} DumpExtractorDump;
+
+typedef struct
+{
+    /* Every dump found in the log, in the order they were logged. */
+    DumpExtractorDump* pDumps;
+    size_t             dumpCount;
+} DumpExtractorDumps;
+
+
+/* Finds and decodes every dump in the logSize bytes of text at pLog, using up to threadCount threads.  The log is split
+   at each "ENCOUNTERED" banner and the text between banners is decoded with DumpDecoder_DecodeEmbedded() so that other
+   console output interleaved with a dump is skipped.  Any text logged before the first banner is decoded too so that a
+   dump whose banner wasn't logged is still found.  Text which doesn't contain a dump signature is ignored.  Returns 0
+   on success or -1 if memory ran out.  DumpExtractor_Free() must be called to free pDumps either way. */
+int  DumpExtractor_Extract(const char* pLog, size_t logSize, unsigned int threadCount, DumpExtractorDumps* pDumps);
+
+/* Frees the dumps returned by DumpExtractor_Extract(). */
+void DumpExtractor_Free(DumpExtractorDumps* pDumps);
+
+
+#endif /* _DUMP_EXTRACTOR_H_ */
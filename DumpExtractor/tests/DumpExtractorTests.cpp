@@ -0,0 +1,257 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Include headers from C modules under test.
+extern "C"
+{
+    #include <DumpExtractor.h>
+
+    // The unit tests can shrink this to have banners straddle the chunks which are scanned by each thread.
+    extern size_t g_dumpExtractorChunkSize;
+}
+
+// Include C++ headers for test harness.
+#include <CppUTest/TestHarness.h>
+
+
+// Each of the test dumps below decodes to these bytes: the signature, the flags and then 17 bytes of memory.
+static const uint8_t g_expectedDump[] = { 0x63, 0x43, 0x03, 0x00,
+                                          0x01, 0x00, 0x00, 0x00,
+                                          0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+                                          0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+                                          0x10 };
+
+static const char g_hexLog[] = "\r\n\r\nCRASH ENCOUNTERED\r\n"
+                               "Enable logging and then press any key to start dump.\r\n"
+                               "\r\n"
+                               "63430300\r\n"
+                               "01000000\r\n"
+                               "000102030405060708090A0B0C0D0E0F\r\n"
+                               "10\r\n"
+                               "\r\n"
+                               "End of dump\r\n";
+
+static const char g_base64Log[] = "\r\n\r\nBREAKPOINT ENCOUNTERED (Base64)\r\n"
+                                  "Enable logging and then press any key to start dump.\r\n"
+                                  "\r\n"
+                                  "Y0MDAA==\r\n"
+                                  "AQAAAA==\r\n"
+                                  "AAECAwQFBgcICQoLDA0ODxA=\r\n"
+                                  "\r\n"
+                                  "End of dump\r\n";
+
+static const char g_appLog[] = "[   1.000] Booting...\r\n"
+                               "[   1.250] Sensors online\r\n";
+
+static const size_t g_defaultChunkSize = 1024 * 1024;
+
+
+TEST_GROUP(DumpExtractor)
+{
+    DumpExtractorDumps m_dumps;
+    char               m_log[4096];
+
+    void setup()
+    {
+        memset(&m_dumps, 0xFF, sizeof(m_dumps));
+        m_log[0] = '\0';
+        g_dumpExtractorChunkSize = g_defaultChunkSize;
+    }
+
+    void teardown()
+    {
+        DumpExtractor_Free(&m_dumps);
+        g_dumpExtractorChunkSize = g_defaultChunkSize;
+    }
+
+    void extract(unsigned int threadCount = 4)
+    {
+        CHECK_EQUAL(0, DumpExtractor_Extract(m_log, strlen(m_log), threadCount, &m_dumps));
+    }
+
+    void validateDump(size_t index, DumpDecoderResult expectedResult, DumpDecoderEncoding expectedEncoding,
+                      const char* pExpectedText)
+    {
+        const DumpExtractorDump* pDump = &m_dumps.pDumps[index];
+
+        CHECK_TRUE(index < m_dumps.dumpCount);
+        CHECK_EQUAL(expectedResult, pDump->result);
+        CHECK_EQUAL(expectedEncoding, pDump->details.encoding);
+        CHECK_EQUAL(sizeof(g_expectedDump), pDump->details.decodedSize);
+        MEMCMP_EQUAL(g_expectedDump, pDump->pDump, sizeof(g_expectedDump));
+        CHECK_EQUAL((size_t)(strstr(m_log, pExpectedText) - m_log), pDump->logOffset);
+    }
+
+    void appendDumps(size_t count)
+    {
+        for (size_t i = 0 ; i < count ; i++)
+        {
+            strcat(m_log, g_appLog);
+            strcat(m_log, i & 1 ? g_base64Log : g_hexLog);
+        }
+    }
+};
+
+
+TEST(DumpExtractor, EmptyLog_ShouldFindNoDumps)
+{
+    extract();
+    CHECK_EQUAL(0, m_dumps.dumpCount);
+}
+
+TEST(DumpExtractor, LogWithoutDumps_ShouldFindNoDumps)
+{
+    strcpy(m_log, g_appLog);
+    strcat(m_log, "\r\n\r\nCRASH ENCOUNTERED\r\nEnable logging and then press any key to start dump.\r\n");
+    extract();
+    CHECK_EQUAL(0, m_dumps.dumpCount);
+}
+
+TEST(DumpExtractor, OneDumpBetweenLogLines_ShouldExtractItStartingAtBannerLine)
+{
+    strcpy(m_log, g_appLog);
+    strcat(m_log, g_hexLog);
+    strcat(m_log, g_appLog);
+    extract();
+    CHECK_EQUAL(1, m_dumps.dumpCount);
+    validateDump(0, DUMP_DECODER_OK, DUMP_DECODER_HEX, "CRASH");
+    CHECK_EQUAL(strlen(m_log) - m_dumps.pDumps[0].logOffset, m_dumps.pDumps[0].logSize);
+}
+
+TEST(DumpExtractor, TwoDumpsWithDifferentEncodings_ShouldExtractBothInLogOrder)
+{
+    strcpy(m_log, g_hexLog);
+    strcat(m_log, g_appLog);
+    strcat(m_log, g_base64Log);
+    extract();
+    CHECK_EQUAL(2, m_dumps.dumpCount);
+    validateDump(0, DUMP_DECODER_OK, DUMP_DECODER_HEX, "CRASH");
+    validateDump(1, DUMP_DECODER_OK, DUMP_DECODER_BASE64, "BREAKPOINT");
+    CHECK_EQUAL(m_dumps.pDumps[1].logOffset, m_dumps.pDumps[0].logOffset + m_dumps.pDumps[0].logSize);
+}
+
+TEST(DumpExtractor, DumpWithInterleavedLogLinesAndCarriageReturns_ShouldSkipThem)
+{
+    strcpy(m_log, "\r\n\r\nCRASH ENCOUNTERED\r\n"
+                  "Enable logging and then press any key to start dump.\r\n"
+                  "\r\n"
+                  "63430300\r\r\n"
+                  "[   2.000] wifi: link down\r\n"
+                  "\r01000000\r\n"
+                  "\r\r\n"
+                  "000102030405060708090A0B0C0D0E0F\r\n"
+                  "[   2.001] wifi: retrying\r\n"
+                  "10\r\n"
+                  "End of dump\r\n");
+    extract();
+    CHECK_EQUAL(1, m_dumps.dumpCount);
+    validateDump(0, DUMP_DECODER_OK, DUMP_DECODER_HEX, "CRASH");
+    CHECK_EQUAL(2, m_dumps.pDumps[0].details.skippedLineCount);
+}
+
+TEST(DumpExtractor, DumpWithoutBannerAtStartOfLog_ShouldStillBeExtracted)
+{
+    strcpy(m_log, strstr(g_hexLog, "63430300"));
+    strcat(m_log, g_base64Log);
+    extract();
+    CHECK_EQUAL(2, m_dumps.dumpCount);
+    validateDump(0, DUMP_DECODER_OK, DUMP_DECODER_HEX, "63430300");
+    validateDump(1, DUMP_DECODER_OK, DUMP_DECODER_BASE64, "BREAKPOINT");
+}
+
+TEST(DumpExtractor, DumpCutOffByNextBanner_ShouldReturnTruncatedAndStillExtractNextDump)
+{
+    strcpy(m_log, g_hexLog);
+    strstr(m_log, "\r\nEnd of dump")[0] = '\0';
+    strcat(m_log, g_base64Log);
+    extract();
+    CHECK_EQUAL(2, m_dumps.dumpCount);
+    validateDump(0, DUMP_DECODER_TRUNCATED, DUMP_DECODER_HEX, "CRASH");
+    validateDump(1, DUMP_DECODER_OK, DUMP_DECODER_BASE64, "BREAKPOINT");
+}
+
+TEST(DumpExtractor, ManyDumpsWithTinyChunks_ShouldFindBannersWhichStraddleChunks)
+{
+    appendDumps(8);
+    for (size_t chunkSize = 1 ; chunkSize <= 13 ; chunkSize++)
+    {
+        g_dumpExtractorChunkSize = chunkSize;
+        extract();
+        CHECK_EQUAL(8, m_dumps.dumpCount);
+        for (size_t i = 0 ; i < m_dumps.dumpCount ; i++)
+        {
+            CHECK_EQUAL(DUMP_DECODER_OK, m_dumps.pDumps[i].result);
+            CHECK_EQUAL(i & 1 ? DUMP_DECODER_BASE64 : DUMP_DECODER_HEX, m_dumps.pDumps[i].details.encoding);
+            MEMCMP_EQUAL(g_expectedDump, m_dumps.pDumps[i].pDump, sizeof(g_expectedDump));
+        }
+        DumpExtractor_Free(&m_dumps);
+    }
+}
+
+TEST(DumpExtractor, DifferentThreadCounts_ShouldExtractSameDumps)
+{
+    DumpExtractorDumps singleThreaded;
+
+    appendDumps(10);
+    g_dumpExtractorChunkSize = 64;
+    CHECK_EQUAL(0, DumpExtractor_Extract(m_log, strlen(m_log), 1, &singleThreaded));
+    for (unsigned int threadCount = 0 ; threadCount <= 100 ; threadCount += 5)
+    {
+        extract(threadCount);
+        CHECK_EQUAL(singleThreaded.dumpCount, m_dumps.dumpCount);
+        for (size_t i = 0 ; i < m_dumps.dumpCount ; i++)
+        {
+            CHECK_EQUAL(singleThreaded.pDumps[i].logOffset, m_dumps.pDumps[i].logOffset);
+            CHECK_EQUAL(singleThreaded.pDumps[i].logSize, m_dumps.pDumps[i].logSize);
+            CHECK_EQUAL(singleThreaded.pDumps[i].details.decodedSize, m_dumps.pDumps[i].details.decodedSize);
+            MEMCMP_EQUAL(singleThreaded.pDumps[i].pDump, m_dumps.pDumps[i].pDump,
+                         m_dumps.pDumps[i].details.decodedSize);
+        }
+        DumpExtractor_Free(&m_dumps);
+    }
+    DumpExtractor_Free(&singleThreaded);
+}
+
+TEST(DumpExtractor, ManyDumpsOnManyThreads_ShouldDecodeEachDumpConcurrently)
+{
+    // Every thread decodes its dumps at the same time, sharing the decoder's digit tables.
+    appendDumps(12);
+    g_dumpExtractorChunkSize = 16;
+    for (int iteration = 0 ; iteration < 10 ; iteration++)
+    {
+        extract(12);
+        CHECK_EQUAL(12, m_dumps.dumpCount);
+        for (size_t i = 0 ; i < m_dumps.dumpCount ; i++)
+        {
+            CHECK_EQUAL(DUMP_DECODER_OK, m_dumps.pDumps[i].result);
+            CHECK_EQUAL(i & 1 ? DUMP_DECODER_BASE64 : DUMP_DECODER_HEX, m_dumps.pDumps[i].details.encoding);
+            CHECK_EQUAL(sizeof(g_expectedDump), m_dumps.pDumps[i].details.decodedSize);
+            MEMCMP_EQUAL(g_expectedDump, m_dumps.pDumps[i].pDump, sizeof(g_expectedDump));
+        }
+        DumpExtractor_Free(&m_dumps);
+    }
+}
+
+TEST(DumpExtractor, Free_ShouldLeaveEmptyDumps)
+{
+    strcpy(m_log, g_hexLog);
+    extract();
+    DumpExtractor_Free(&m_dumps);
+    CHECK_EQUAL(0, m_dumps.dumpCount);
+    POINTERS_EQUAL(NULL, m_dumps.pDumps);
+}
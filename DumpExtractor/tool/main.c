@@ -0,0 +1,226 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Command line front end for DumpExtractor.  Usage: CrashCatcherExtract [-j threads] logFile outputPrefix
+   Each dump found in logFile is written to outputPrefixNNN.dmp. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <DumpExtractor.h>
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+
+static unsigned int defaultThreadCount(void);
+static const char*  mapFile(const char* pFilename, size_t* pSize);
+static void         unmapFile(const char* pLog, size_t logSize);
+static int          writeDumps(const DumpExtractorDumps* pDumps, const char* pPrefix);
+static int          writeFile(const char* pFilename, const uint8_t* pData, size_t size);
+
+
+int main(int argc, char** argv)
+{
+    DumpExtractorDumps dumps;
+    unsigned int       threadCount = defaultThreadCount();
+    const char*        pLog;
+    size_t             logSize;
+    int                argIndex = 1;
+    int                exitCode;
+
+    if (argc == 5 && strcmp(argv[1], "-j") == 0)
+    {
+        threadCount = strtoul(argv[2], NULL, 10);
+        argIndex = 3;
+    }
+    if (argc - argIndex != 2 || threadCount == 0)
+    {
+        fprintf(stderr, "Usage: %s [-j threads] logFile outputPrefix\n", argv[0]);
+        return 2;
+    }
+
+    pLog = mapFile(argv[argIndex], &logSize);
+    if (!pLog)
+        return 1;
+    if (DumpExtractor_Extract(pLog, logSize, threadCount, &dumps) != 0)
+    {
+        fprintf(stderr, "%s: out of memory\n", argv[argIndex]);
+        exitCode = 1;
+    }
+    else
+    {
+        exitCode = writeDumps(&dumps, argv[argIndex + 1]);
+        if (dumps.dumpCount == 0)
+        {
+            printf("%s: %s\n", argv[argIndex], DumpDecoder_ResultString(DUMP_DECODER_NO_DUMP));
+            exitCode = 1;
+        }
+    }
+    DumpExtractor_Free(&dumps);
+    unmapFile(pLog, logSize);
+    return exitCode;
+}
+
+#ifdef _WIN32
+static unsigned int defaultThreadCount(void)
+{
+    return 1;
+}
+
+static const char* mapFile(const char* pFilename, size_t* pSize)
+{
+    FILE* pFile = fopen(pFilename, "rb");
+    char* pData = NULL;
+    long  size;
+
+    if (!pFile || fseek(pFile, 0, SEEK_END) != 0 || (size = ftell(pFile)) < 0 || fseek(pFile, 0, SEEK_SET) != 0)
+    {
+        perror(pFilename);
+        if (pFile)
+            fclose(pFile);
+        return NULL;
+    }
+    pData = malloc(size ? size : 1);
+    if (!pData || fread(pData, 1, size, pFile) != (size_t)size)
+    {
+        perror(pFilename);
+        free(pData);
+        fclose(pFile);
+        return NULL;
+    }
+    fclose(pFile);
+    *pSize = size;
+    return pData;
+}
+
+static void unmapFile(const char* pLog, size_t logSize)
+{
+    free((char*)pLog);
+}
+#else
+static unsigned int defaultThreadCount(void)
+{
+    long processorCount = sysconf(_SC_NPROCESSORS_ONLN);
+
+    return processorCount > 0 ? processorCount : 1;
+}
+
+static const char* mapFile(const char* pFilename, size_t* pSize)
+{
+    static const char emptyLog[1] = { 0 };
+    struct stat       fileStat;
+    void*             pvLog;
+    int               file;
+
+    /* Map the log rather than reading it so that the threads can start scanning it straight from the page cache. */
+    file = open(pFilename, O_RDONLY);
+    if (file < 0 || fstat(file, &fileStat) != 0)
+    {
+        perror(pFilename);
+        if (file >= 0)
+            close(file);
+        return NULL;
+    }
+    *pSize = fileStat.st_size;
+    if (fileStat.st_size == 0)
+    {
+        close(file);
+        return emptyLog;
+    }
+    pvLog = mmap(NULL, fileStat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+    if (pvLog == MAP_FAILED)
+    {
+        perror(pFilename);
+        return NULL;
+    }
+    return pvLog;
+}
+
+static void unmapFile(const char* pLog, size_t logSize)
+{
+    if (logSize > 0)
+        munmap((void*)pLog, logSize);
+}
+#endif
+
+static int writeDumps(const DumpExtractorDumps* pDumps, const char* pPrefix)
+{
+    size_t filenameSize = strlen(pPrefix) + 32;
+    char*  pFilename = malloc(filenameSize);
+    int    exitCode = 0;
+    size_t i;
+
+    if (!pFilename)
+    {
+        perror(pPrefix);
+        return 1;
+    }
+    for (i = 0 ; i < pDumps->dumpCount ; i++)
+    {
+        const DumpExtractorDump* pDump = &pDumps->pDumps[i];
+
+        snprintf(pFilename, filenameSize, "%s%03u.dmp", pPrefix, (unsigned)i);
+        printf("%s: %s", pFilename, DumpDecoder_ResultString(pDump->result));
+        if (pDump->result == DUMP_DECODER_BUFFER_TOO_SMALL)
+            printf(" on line %u", (unsigned)pDump->details.lineNumber);
+        else if (pDump->result == DUMP_DECODER_LOST_FRAMES)
+            printf(" (%u frames starting at frame %u)",
+                   (unsigned)pDump->details.lostFrameCount, (unsigned)pDump->details.firstLostFrame);
+        else if (pDump->result == DUMP_DECODER_MISSING_LINES)
+            printf(" (%u lines starting at line %u)",
+                   (unsigned)pDump->details.missingLineCount, (unsigned)pDump->details.firstMissingLine);
+        printf(" (%s, %u bytes from log offset %lu",
+               DumpDecoder_EncodingString(pDump->details.encoding), (unsigned)pDump->details.decodedSize,
+               (unsigned long)pDump->logOffset);
+        if (pDump->details.skippedLineCount)
+            printf(", %u log lines skipped", (unsigned)pDump->details.skippedLineCount);
+        printf(")\n");
+
+        /* Still write out truncated dumps and those with lost frames or lines since the registers and the rest of the
+           regions are often enough to debug the crash. */
+        if (pDump->result != DUMP_DECODER_OK)
+            exitCode = 1;
+        if ((pDump->result == DUMP_DECODER_OK || pDump->result == DUMP_DECODER_TRUNCATED ||
+             pDump->result == DUMP_DECODER_LOST_FRAMES || pDump->result == DUMP_DECODER_MISSING_LINES) &&
+            writeFile(pFilename, pDump->pDump, pDump->details.decodedSize) != 0)
+        {
+            exitCode = 1;
+        }
+    }
+    free(pFilename);
+    return exitCode;
+}
+
+static int writeFile(const char* pFilename, const uint8_t* pData, size_t size)
+{
+    FILE* pFile = fopen(pFilename, "wb");
+    int   isWritten;
+
+    if (!pFile)
+    {
+        perror(pFilename);
+        return 1;
+    }
+    isWritten = fwrite(pData, 1, size, pFile) == size;
+    if (fclose(pFile) != 0 || !isWritten)
+    {
+        perror(pFilename);
+        return 1;
+    }
+    return 0;
+}
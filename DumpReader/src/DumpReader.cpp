@@ -0,0 +1,709 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Walks the registers, memory regions and records of a dump once to build a table of spans sorted by address.  An
+   uncompressed dump is only ever read in place so every lookup returns pointers straight into the memory mapped file.
+   The blocks of a compressed dump are expanded into a heap buffer once and the lookups then point into that. */
+#include <stdlib.h>
+#include <string.h>
+#ifdef _WIN32
+    #include <stdio.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+extern "C"
+{
+    #include <CrashCatcher.h>
+    #include <Lz4Decoder.h>
+}
+#include "DumpReader.h"
+
+
+/* Integer registers: R0-R12, SP, LR, PC, XPSR, MSP, PSP and exception PSR. */
+#define INTEGER_REGISTERS_SIZE  (DumpReader::INTEGER_REGISTER_COUNT * sizeof(uint32_t))
+/* Floating point registers: S0-S31 and FPSCR. */
+#define FLOAT_REGISTERS_SIZE    (DumpReader::FLOAT_REGISTER_COUNT * sizeof(uint32_t))
+#define RECORD_TAG_MASK         0xFFFFFF00
+/* Backtrace fields and then the address count.  The number of address slots which follow depends on how the target
+   was configured so it is found from the payload size. */
+#define BACKTRACE_HEADER_SIZE   ((DumpReader::BACKTRACE_FIELD_COUNT + 1) * sizeof(uint32_t))
+/* Fault cause, address valid flag and fault address. */
+#define FAULT_CAUSE_SIZE        (3 * sizeof(uint32_t))
+/* Timing fields and then the region count.  Like the backtrace, the number of region slots which follow is found from
+   the payload size.  Each slot holds a cycle count and a byte count. */
+#define TIMING_HEADER_SIZE      ((DumpReader::TIMING_FIELD_COUNT + 1) * sizeof(uint32_t))
+#define TIMING_SLOT_SIZE        (2 * sizeof(uint32_t))
+/* Stack size and high water mark. */
+#define STACK_USAGE_SIZE        (2 * sizeof(uint32_t))
+
+
+static const uint8_t g_stackSentinel[4] = {0xAC, 0xCE, 0x55, 0xED};
+
+
+static uint32_t readUInt32(const uint8_t* pSrc);
+static int      compareSpans(const void* pv1, const void* pv2);
+
+
+DumpReader::DumpReader()
+{
+    m_pMapping = NULL;
+    m_mappingSize = 0;
+    m_pExpanded = NULL;
+    m_pSpans = NULL;
+    m_allocatedSpans = 0;
+    reset(NULL, 0);
+}
+
+DumpReader::~DumpReader()
+{
+    close();
+}
+
+#ifdef _WIN32
+DumpReader::Result DumpReader::open(const char* pFilename)
+{
+    FILE* pFile;
+    long  size;
+
+    close();
+    pFile = fopen(pFilename, "rb");
+    if (!pFile || fseek(pFile, 0, SEEK_END) != 0 || (size = ftell(pFile)) < 0 || fseek(pFile, 0, SEEK_SET) != 0)
+    {
+        if (pFile)
+            fclose(pFile);
+        return OPEN_FAILED;
+    }
+    m_pMapping = malloc(size ? size : 1);
+    if (!m_pMapping || fread(m_pMapping, 1, size, pFile) != (size_t)size)
+    {
+        fclose(pFile);
+        close();
+        return OPEN_FAILED;
+    }
+    fclose(pFile);
+    m_mappingSize = size;
+    return parse((const uint8_t*)m_pMapping, m_mappingSize);
+}
+#else
+DumpReader::Result DumpReader::open(const char* pFilename)
+{
+    struct stat fileStat;
+    int         file;
+
+    close();
+    file = ::open(pFilename, O_RDONLY);
+    if (file < 0 || fstat(file, &fileStat) != 0)
+    {
+        if (file >= 0)
+            ::close(file);
+        return OPEN_FAILED;
+    }
+    /* mmap() fails for empty files so leave them unmapped and let parse() report them as truncated. */
+    if (fileStat.st_size > 0)
+    {
+        void* pMapping = mmap(NULL, fileStat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+
+        if (pMapping == MAP_FAILED)
+        {
+            ::close(file);
+            return OPEN_FAILED;
+        }
+        m_pMapping = pMapping;
+        m_mappingSize = fileStat.st_size;
+    }
+    ::close(file);
+    return parse((const uint8_t*)m_pMapping, m_mappingSize);
+}
+#endif
+
+DumpReader::Result DumpReader::parse(const uint8_t* pDump, size_t dumpSize)
+{
+    Result result;
+
+    free(m_pExpanded);
+    m_pExpanded = NULL;
+    reset(pDump, dumpSize);
+    result = parseRegisters();
+    if (result != OK)
+        return result;
+    result = parseItems();
+    if (result == OK && m_isExpansionTruncated)
+        result = TRUNCATED;
+    /* Regions are usually dumped in address order already but nothing guarantees it. */
+    qsort(m_pSpans, m_spanCount, sizeof(*m_pSpans), compareSpans);
+    return result;
+}
+
+void DumpReader::close()
+{
+#ifdef _WIN32
+    free(m_pMapping);
+#else
+    if (m_pMapping)
+        munmap(m_pMapping, m_mappingSize);
+#endif
+    free(m_pExpanded);
+    free(m_pSpans);
+    m_pMapping = NULL;
+    m_mappingSize = 0;
+    m_pExpanded = NULL;
+    m_pSpans = NULL;
+    m_allocatedSpans = 0;
+    reset(NULL, 0);
+}
+
+void DumpReader::reset(const uint8_t* pDump, size_t dumpSize)
+{
+    m_pDump = pDump;
+    m_dumpSize = dumpSize;
+    m_pCurr = pDump;
+    m_isExpansionTruncated = false;
+    m_pIntegerRegisters = NULL;
+    m_pFloatRegisters = NULL;
+    m_pBacktrace = NULL;
+    m_backtraceAddressCount = 0;
+    m_pFaultCause = NULL;
+    m_completedTiers = 0;
+    m_pTiming = NULL;
+    m_timingRegionCount = 0;
+    m_pStackUsage = NULL;
+    m_flags = 0;
+    m_regionCount = 0;
+    m_hasStackOverflowed = false;
+    m_spanCount = 0;
+}
+
+DumpReader::Result DumpReader::parseRegisters()
+{
+    const uint8_t* pHeader = m_pCurr;
+
+    if (!skipBytes(2 * sizeof(uint32_t)))
+        return TRUNCATED;
+    if (pHeader[0] != CRASH_CATCHER_SIGNATURE_BYTE0 ||
+        pHeader[1] != CRASH_CATCHER_SIGNATURE_BYTE1 ||
+        pHeader[2] != CRASH_CATCHER_VERSION_MAJOR)
+    {
+        return BAD_SIGNATURE;
+    }
+    m_flags = readUInt32(&pHeader[4]);
+    if (m_flags & CRASH_CATCHER_FLAGS_BACKTRACE)
+    {
+        Result result = parseBacktrace();
+        if (result != OK)
+            return result;
+    }
+    if (m_flags & CRASH_CATCHER_FLAGS_COMPRESSED)
+    {
+        Result result = expand();
+        if (result != OK)
+            return result;
+    }
+
+    m_pIntegerRegisters = m_pCurr;
+    if (!skipBytes(INTEGER_REGISTERS_SIZE))
+    {
+        m_pIntegerRegisters = NULL;
+        return TRUNCATED;
+    }
+    if (m_flags & CRASH_CATCHER_FLAGS_FLOATING_POINT)
+    {
+        m_pFloatRegisters = m_pCurr;
+        if (!skipBytes(FLOAT_REGISTERS_SIZE))
+        {
+            m_pFloatRegisters = NULL;
+            return TRUNCATED;
+        }
+    }
+    return OK;
+}
+
+DumpReader::Result DumpReader::parseBacktrace()
+{
+    const uint8_t* pRecord = m_pCurr;
+    uint32_t       payloadSize;
+    uint32_t       slotCount;
+
+    if (!skipBytes(2 * sizeof(uint32_t)))
+        return TRUNCATED;
+    payloadSize = readUInt32(pRecord + sizeof(uint32_t));
+    if (readUInt32(pRecord) != CRASH_CATCHER_RECORD_TAG(CRASH_CATCHER_RECORD_BACKTRACE) ||
+        payloadSize < BACKTRACE_HEADER_SIZE || (payloadSize & 3) != 0)
+    {
+        return MALFORMED;
+    }
+    if (!skipBytes(payloadSize))
+        return TRUNCATED;
+
+    slotCount = (payloadSize - BACKTRACE_HEADER_SIZE) / sizeof(uint32_t);
+    m_pBacktrace = pRecord + 2 * sizeof(uint32_t);
+    m_backtraceAddressCount = readUInt32(m_pBacktrace + BACKTRACE_FIELD_COUNT * sizeof(uint32_t));
+    if (m_backtraceAddressCount > slotCount)
+        m_backtraceAddressCount = slotCount;
+    return OK;
+}
+
+DumpReader::Result DumpReader::expand()
+{
+    size_t           headerSize = m_pCurr - m_pDump;
+    size_t           expandedSize;
+    Lz4DecoderResult result;
+
+    /* The signature, flags and backtrace record were sent uncompressed so parsing carries on from the same offset. */
+    result = Lz4Decoder_ExpandDump(m_pDump, m_dumpSize, &m_pExpanded, &expandedSize);
+    if (result == LZ4_DECODER_OUT_OF_MEMORY)
+        return OUT_OF_MEMORY;
+    if (result == LZ4_DECODER_MALFORMED)
+        return MALFORMED;
+    m_isExpansionTruncated = result == LZ4_DECODER_TRUNCATED;
+    m_pDump = m_pExpanded;
+    m_dumpSize = expandedSize;
+    m_pCurr = m_pExpanded + headerSize;
+    return OK;
+}
+
+DumpReader::Result DumpReader::parseItems()
+{
+    while (bytesLeft() > 0)
+    {
+        uint32_t       startAddress;
+        uint32_t       endAddress;
+        uint32_t       size;
+        const uint8_t* pData;
+        Result         result;
+
+        /* Only the stack overflow sentinel is shorter than a region or record header. */
+        if (bytesLeft() < 2 * sizeof(uint32_t))
+        {
+            if (bytesLeft() != sizeof(g_stackSentinel) ||
+                memcmp(m_pCurr, g_stackSentinel, sizeof(g_stackSentinel)) != 0)
+            {
+                return TRUNCATED;
+            }
+            m_hasStackOverflowed = true;
+            return OK;
+        }
+        startAddress = readUInt32(m_pCurr);
+        endAddress = readUInt32(m_pCurr + sizeof(uint32_t));
+        skipBytes(2 * sizeof(uint32_t));
+
+        /* The first word of a record header is always larger than the second, which is never true for a memory region.
+           Records, such as the CRC32 trailer, don't hold any memory so they aren't indexed. */
+        if ((startAddress & RECORD_TAG_MASK) == RECORD_TAG_MASK && startAddress > endAddress)
+        {
+            result = parseRecord(startAddress & ~RECORD_TAG_MASK, endAddress);
+            if (result != OK)
+                return result;
+            continue;
+        }
+        if (endAddress < startAddress)
+            return MALFORMED;
+
+        size = endAddress - startAddress;
+        if (m_flags & CRASH_CATCHER_FLAGS_SEGMENTED)
+        {
+            result = parseSegments(startAddress, size);
+        }
+        else
+        {
+            pData = m_pCurr;
+            if (!skipBytes(size))
+                return TRUNCATED;
+            result = size > 0 ? addSpan(startAddress, size, SPAN_DATA, pData) : OK;
+        }
+        if (result != OK)
+            return result;
+        m_regionCount++;
+    }
+    return OK;
+}
+
+DumpReader::Result DumpReader::parseRecord(uint32_t type, uint32_t payloadSize)
+{
+    const uint8_t* pPayload = m_pCurr;
+
+    if (!skipBytes(payloadSize))
+        return TRUNCATED;
+    /* Unknown records are skipped so that new record types don't break older readers. */
+    switch (type)
+    {
+    case CRASH_CATCHER_RECORD_FAULT_CAUSE:
+        if (payloadSize < FAULT_CAUSE_SIZE)
+            return MALFORMED;
+        m_pFaultCause = pPayload;
+        break;
+    case CRASH_CATCHER_RECORD_TIER_END:
+        if (payloadSize < sizeof(uint32_t))
+            return MALFORMED;
+        m_completedTiers = readUInt32(pPayload);
+        break;
+    case CRASH_CATCHER_RECORD_TIMING:
+        if (payloadSize < TIMING_HEADER_SIZE)
+            return MALFORMED;
+        m_pTiming = pPayload;
+        m_timingRegionCount = readUInt32(pPayload + TIMING_FIELD_COUNT * sizeof(uint32_t));
+        if (m_timingRegionCount > (payloadSize - TIMING_HEADER_SIZE) / TIMING_SLOT_SIZE)
+            m_timingRegionCount = (payloadSize - TIMING_HEADER_SIZE) / TIMING_SLOT_SIZE;
+        break;
+    case CRASH_CATCHER_RECORD_STACK_USAGE:
+        if (payloadSize < STACK_USAGE_SIZE)
+            return MALFORMED;
+        m_pStackUsage = pPayload;
+        break;
+    }
+    return OK;
+}
+
+DumpReader::Result DumpReader::parseSegments(uint32_t startAddress, uint32_t size)
+{
+    uint32_t offset = 0;
+
+    while (offset < size)
+    {
+        const uint8_t* pPayload;
+        uint32_t       header;
+        uint32_t       length;
+        SpanType       type;
+        Result         result;
+
+        if (bytesLeft() < sizeof(header))
+            return TRUNCATED;
+        header = readUInt32(m_pCurr);
+        length = header & CRASH_CATCHER_SEGMENT_LENGTH_MASK;
+        skipBytes(sizeof(header));
+        if (length == 0 || length > size - offset)
+            return MALFORMED;
+
+        pPayload = m_pCurr;
+        switch (header >> CRASH_CATCHER_SEGMENT_TYPE_SHIFT)
+        {
+        case CRASH_CATCHER_SEGMENT_RAW:
+            if (!skipBytes(length))
+                return TRUNCATED;
+            type = SPAN_DATA;
+            break;
+        case CRASH_CATCHER_SEGMENT_FILL:
+            if (!skipBytes(sizeof(uint32_t)))
+                return TRUNCATED;
+            type = SPAN_FILL;
+            break;
+        case CRASH_CATCHER_SEGMENT_LOAD_IMAGE:
+            if (!skipBytes(sizeof(uint32_t)))
+                return TRUNCATED;
+            type = SPAN_LOAD_IMAGE;
+            break;
+        case CRASH_CATCHER_SEGMENT_HOLE:
+            /* Free heap wasn't dumped so leave it out of the index. */
+            offset += length;
+            continue;
+        default:
+            return MALFORMED;
+        }
+        result = addSpan(startAddress + offset, length, type, pPayload);
+        if (result != OK)
+            return result;
+        offset += length;
+    }
+    return OK;
+}
+
+DumpReader::Result DumpReader::addSpan(uint32_t startAddress, uint32_t size, SpanType type, const uint8_t* pData)
+{
+    Span* pSpan;
+
+    if (m_spanCount == m_allocatedSpans)
+    {
+        size_t allocatedSpans = m_allocatedSpans ? m_allocatedSpans * 2 : 16;
+        Span*  pSpans = (Span*)realloc(m_pSpans, allocatedSpans * sizeof(*pSpans));
+
+        if (!pSpans)
+            return OUT_OF_MEMORY;
+        m_pSpans = pSpans;
+        m_allocatedSpans = allocatedSpans;
+    }
+    pSpan = &m_pSpans[m_spanCount++];
+    pSpan->startAddress = startAddress;
+    pSpan->size = size;
+    pSpan->type = type;
+    pSpan->pData = pData;
+    pSpan->regionIndex = m_regionCount;
+    return OK;
+}
+
+bool DumpReader::skipBytes(size_t size)
+{
+    if (bytesLeft() < size)
+    {
+        m_pCurr = m_pDump + m_dumpSize;
+        return false;
+    }
+    m_pCurr += size;
+    return true;
+}
+
+size_t DumpReader::bytesLeft() const
+{
+    return m_dumpSize - (m_pCurr - m_pDump);
+}
+
+
+uint32_t DumpReader::flags() const
+{
+    return m_flags;
+}
+
+bool DumpReader::hasFloatingPoint() const
+{
+    return m_pFloatRegisters != NULL;
+}
+
+bool DumpReader::hasStackOverflowed() const
+{
+    return m_hasStackOverflowed;
+}
+
+bool DumpReader::hasIntegerRegisters() const
+{
+    return m_pIntegerRegisters != NULL;
+}
+
+uint32_t DumpReader::integerRegister(size_t index) const
+{
+    if (!m_pIntegerRegisters || index >= INTEGER_REGISTER_COUNT)
+        return 0;
+    return readUInt32(m_pIntegerRegisters + index * sizeof(uint32_t));
+}
+
+uint32_t DumpReader::floatRegister(size_t index) const
+{
+    if (!m_pFloatRegisters || index >= FLOAT_REGISTER_COUNT)
+        return 0;
+    return readUInt32(m_pFloatRegisters + index * sizeof(uint32_t));
+}
+
+bool DumpReader::hasBacktrace() const
+{
+    return m_pBacktrace != NULL;
+}
+
+uint32_t DumpReader::backtraceField(size_t index) const
+{
+    if (!m_pBacktrace || index >= BACKTRACE_FIELD_COUNT)
+        return 0;
+    return readUInt32(m_pBacktrace + index * sizeof(uint32_t));
+}
+
+uint32_t DumpReader::backtraceAddressCount() const
+{
+    return m_backtraceAddressCount;
+}
+
+uint32_t DumpReader::backtraceAddress(size_t index) const
+{
+    if (index >= m_backtraceAddressCount)
+        return 0;
+    return readUInt32(m_pBacktrace + BACKTRACE_HEADER_SIZE + index * sizeof(uint32_t));
+}
+
+bool DumpReader::hasFaultCause() const
+{
+    return m_pFaultCause != NULL;
+}
+
+uint32_t DumpReader::faultCause() const
+{
+    if (!m_pFaultCause)
+        return CRASH_CATCHER_FAULT_UNKNOWN;
+    return readUInt32(m_pFaultCause);
+}
+
+bool DumpReader::hasFaultAddress() const
+{
+    return m_pFaultCause && readUInt32(m_pFaultCause + sizeof(uint32_t)) != 0;
+}
+
+uint32_t DumpReader::faultAddress() const
+{
+    if (!hasFaultAddress())
+        return 0;
+    return readUInt32(m_pFaultCause + 2 * sizeof(uint32_t));
+}
+
+uint32_t DumpReader::completedTiers() const
+{
+    return m_completedTiers;
+}
+
+bool DumpReader::hasTiming() const
+{
+    return m_pTiming != NULL;
+}
+
+uint32_t DumpReader::timingField(size_t index) const
+{
+    if (!m_pTiming || index >= TIMING_FIELD_COUNT)
+        return 0;
+    return readUInt32(m_pTiming + index * sizeof(uint32_t));
+}
+
+uint32_t DumpReader::timingRegionCount() const
+{
+    return m_timingRegionCount;
+}
+
+uint32_t DumpReader::timingRegionCycles(size_t index) const
+{
+    if (index >= m_timingRegionCount)
+        return 0;
+    return readUInt32(m_pTiming + TIMING_HEADER_SIZE + index * TIMING_SLOT_SIZE);
+}
+
+uint32_t DumpReader::timingRegionByteCount(size_t index) const
+{
+    if (index >= m_timingRegionCount)
+        return 0;
+    return readUInt32(m_pTiming + TIMING_HEADER_SIZE + index * TIMING_SLOT_SIZE + sizeof(uint32_t));
+}
+
+bool DumpReader::hasStackUsage() const
+{
+    return m_pStackUsage != NULL;
+}
+
+uint32_t DumpReader::stackSize() const
+{
+    if (!m_pStackUsage)
+        return 0;
+    return readUInt32(m_pStackUsage);
+}
+
+uint32_t DumpReader::stackUsed() const
+{
+    if (!m_pStackUsage)
+        return 0;
+    return readUInt32(m_pStackUsage + sizeof(uint32_t));
+}
+
+uint32_t DumpReader::regionCount() const
+{
+    return m_regionCount;
+}
+
+size_t DumpReader::spanCount() const
+{
+    return m_spanCount;
+}
+
+const DumpReader::Span& DumpReader::span(size_t index) const
+{
+    return m_pSpans[index];
+}
+
+const DumpReader::Span* DumpReader::findSpan(uint32_t address) const
+{
+    const Span* pSpan = findLastSpanAtOrBelow(address);
+
+    if (!pSpan || address - pSpan->startAddress >= pSpan->size)
+        return NULL;
+    return pSpan;
+}
+
+const DumpReader::Span* DumpReader::findLastSpanAtOrBelow(uint32_t address) const
+{
+    size_t low = 0;
+    size_t high = m_spanCount;
+
+    while (low < high)
+    {
+        size_t middle = low + (high - low) / 2;
+
+        if (m_pSpans[middle].startAddress <= address)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    return low > 0 ? &m_pSpans[low - 1] : NULL;
+}
+
+const uint8_t* DumpReader::findBytes(uint32_t address, uint32_t size) const
+{
+    const Span* pSpan = findSpan(address);
+    uint32_t    offset;
+
+    if (!pSpan || pSpan->type != SPAN_DATA)
+        return NULL;
+    offset = address - pSpan->startAddress;
+    if (size > pSpan->size - offset)
+        return NULL;
+    return pSpan->pData + offset;
+}
+
+size_t DumpReader::readBytes(uint32_t address, void* pDest, size_t size) const
+{
+    uint8_t* pDest8 = (uint8_t*)pDest;
+    size_t   bytesCopied = 0;
+
+    while (bytesCopied < size)
+    {
+        const Span* pSpan = findSpan(address);
+        uint32_t    offset;
+        size_t      count;
+        size_t      i;
+
+        /* Load image spans can only be filled in from the ELF so they end the read like any other missing memory. */
+        if (!pSpan || pSpan->type == SPAN_LOAD_IMAGE)
+            break;
+        offset = address - pSpan->startAddress;
+        count = pSpan->size - offset;
+        if (count > size - bytesCopied)
+            count = size - bytesCopied;
+        if (pSpan->type == SPAN_DATA)
+        {
+            memcpy(pDest8 + bytesCopied, pSpan->pData + offset, count);
+        }
+        else
+        {
+            for (i = 0 ; i < count ; i++)
+                pDest8[bytesCopied + i] = pSpan->pData[(offset + i) & 3];
+        }
+        bytesCopied += count;
+        address += count;
+        /* Don't wrap around from the top of the address space back to 0. */
+        if (address == 0)
+            break;
+    }
+    return bytesCopied;
+}
+
+
+static uint32_t readUInt32(const uint8_t* pSrc)
+{
+    /* Dumps are always little endian no matter what the host is. */
+    return (uint32_t)pSrc[0] | ((uint32_t)pSrc[1] << 8) | ((uint32_t)pSrc[2] << 16) | ((uint32_t)pSrc[3] << 24);
+}
+
+static int compareSpans(const void* pv1, const void* pv2)
+{
+    const DumpReader::Span* pSpan1 = (const DumpReader::Span*)pv1;
+    const DumpReader::Span* pSpan2 = (const DumpReader::Span*)pv2;
+
+    /* qsort() isn't stable so fall back on the region index to keep overlapping regions in dump order. */
+    if (pSpan1->startAddress != pSpan2->startAddress)
+        return pSpan1->startAddress < pSpan2->startAddress ? -1 : 1;
+    if (pSpan1->regionIndex != pSpan2->regionIndex)
+        return pSpan1->regionIndex < pSpan2->regionIndex ? -1 : 1;
+    return 0;
+}
@@ -0,0 +1,196 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Host side reader which memory maps a dump and indexes its memory regions so that the bytes at any address can be
+   found with a binary search instead of re-parsing the dump.  Compressed dumps are expanded into a heap buffer
+   first. */
+#ifndef _DUMP_READER_H_
+#define _DUMP_READER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+class DumpReader
+{
+public:
+    enum Result
+    {
+        OK = 0,
+        /* The dump file couldn't be opened or mapped. */
+        OPEN_FAILED,
+        /* The dump doesn't start with the "cC" signature or has an unsupported major version. */
+        BAD_SIGNATURE,
+        /* The dump ended in the middle of the registers or a region.  Earlier regions are still indexed. */
+        TRUNCATED,
+        /* A region, segment, record header or compressed block doesn't make sense. */
+        MALFORMED,
+        /* The region index or the expanded copy of a compressed dump couldn't be allocated. */
+        OUT_OF_MEMORY
+    };
+
+    /* Indices for integerRegister() in the order that they are found in the dump. */
+    enum
+    {
+        R0 = 0, R1, R2, R3, R4, R5, R6, R7, R8, R9, R10, R11, R12, SP, LR, PC, XPSR, MSP, PSP, EXCEPTION_PSR,
+        INTEGER_REGISTER_COUNT
+    };
+    /* S0-S31 and then FPSCR for floatRegister(). */
+    enum
+    {
+        FPSCR = 32,
+        FLOAT_REGISTER_COUNT
+    };
+    /* Indices for backtraceField() in the order that they are found in the CRASH_CATCHER_RECORD_BACKTRACE payload. */
+    enum
+    {
+        BACKTRACE_EXC_RETURN = 0, BACKTRACE_CFSR, BACKTRACE_HFSR, BACKTRACE_MMFAR, BACKTRACE_BFAR, BACKTRACE_PC,
+        BACKTRACE_LR, BACKTRACE_SP, BACKTRACE_FIELD_COUNT
+    };
+    /* Indices for timingField() in the order that they are found in the CRASH_CATCHER_RECORD_TIMING payload. */
+    enum
+    {
+        TIMING_ATTEMPT = 0, TIMING_CAPTURE_CYCLES, TIMING_DUMP_START_CYCLES, TIMING_PREVIOUS_DUMP_END_CYCLES,
+        TIMING_REGISTER_CYCLES, TIMING_BYTE_COUNT, TIMING_FIELD_COUNT
+    };
+
+    enum SpanType
+    {
+        /* Bytes which were dumped.  pData points to them in the mapped dump, or in its expanded copy if compressed. */
+        SPAN_DATA,
+        /* Memory which holds the same 32-bit word throughout.  pData points to the little endian fill word. */
+        SPAN_FILL,
+        /* Memory which still matches its load image in flash.  pData points to the little endian flash address. */
+        SPAN_LOAD_IMAGE
+    };
+
+    /* A contiguous range of memory from one region of the dump.  Regions which weren't segmented are a single data
+       span.  Segmented regions have a span for each segment other than holes. */
+    struct Span
+    {
+        uint32_t       startAddress;
+        uint32_t       size;
+        SpanType       type;
+        const uint8_t* pData;
+        uint32_t       regionIndex;
+    };
+
+    DumpReader();
+    ~DumpReader();
+
+    /* Memory maps the dump file and indexes it.  Any previously opened dump is closed first. */
+    Result open(const char* pFilename);
+    /* Indexes the dumpSize byte dump at pDump, which must remain valid until close() is called. */
+    Result parse(const uint8_t* pDump, size_t dumpSize);
+    void   close();
+
+    uint32_t flags() const;
+    bool     hasFloatingPoint() const;
+    bool     hasStackOverflowed() const;
+    /* False if the dump ended before its integer registers, in which case integerRegister() always returns 0. */
+    bool     hasIntegerRegisters() const;
+    uint32_t integerRegister(size_t index) const;
+    uint32_t floatRegister(size_t index) const;
+
+    /* The backtrace record is parsed even from dumps which end before their registers or have a corrupt compressed
+       block. */
+    bool     hasBacktrace() const;
+    uint32_t backtraceField(size_t index) const;
+    uint32_t backtraceAddressCount() const;
+    uint32_t backtraceAddress(size_t index) const;
+
+    /* The fault cause is one of the CRASH_CATCHER_FAULT_* values from the CRASH_CATCHER_RECORD_FAULT_CAUSE record sent
+       in tier 1 of dumps with CRASH_CATCHER_FLAGS_TWO_TIER set.  faultAddress() returns 0 when hasFaultAddress() is
+       false. */
+    bool     hasFaultCause() const;
+    uint32_t faultCause() const;
+    bool     hasFaultAddress() const;
+    uint32_t faultAddress() const;
+    /* Last tier whose CRASH_CATCHER_RECORD_TIER_END record was found.  A dump which was cut short after tier 1 returns
+       TRUNCATED from parse() but still has its registers, fault status and the top of its active stack. */
+    uint32_t completedTiers() const;
+
+    /* Cycle counts and byte counts from the CRASH_CATCHER_RECORD_TIMING record sent in dumps with
+       CRASH_CATCHER_FLAGS_TIMING set.  Region timings are in dump order and include the fault status registers. */
+    bool     hasTiming() const;
+    uint32_t timingField(size_t index) const;
+    uint32_t timingRegionCount() const;
+    uint32_t timingRegionCycles(size_t index) const;
+    uint32_t timingRegionByteCount(size_t index) const;
+
+    /* Size of g_crashCatcherStack and its high water mark, in bytes, from the CRASH_CATCHER_RECORD_STACK_USAGE record
+       sent in dumps with CRASH_CATCHER_FLAGS_STACK_USAGE set.  Both return 0 if there was no record. */
+    bool     hasStackUsage() const;
+    uint32_t stackSize() const;
+    uint32_t stackUsed() const;
+
+    /* Number of memory regions found in the dump, including empty ones, and the number of spans in the index. */
+    uint32_t    regionCount() const;
+    size_t      spanCount() const;
+    /* Spans are sorted by start address.  Overlapping regions keep their dump order for spans with the same start. */
+    const Span& span(size_t index) const;
+
+    /* Returns the span which contains address, or NULL if it wasn't dumped.  When spans overlap, the one with the
+       highest start address at or below address is returned. */
+    const Span*    findSpan(uint32_t address) const;
+    /* Returns a pointer straight into the mapped (or expanded) dump for the size bytes at address, or NULL if they
+       aren't all held in a single data span. */
+    const uint8_t* findBytes(uint32_t address, uint32_t size) const;
+    /* Copies up to size bytes starting at address into pDest, expanding fill spans as it goes.  Stops at the first byte
+       which isn't available in the dump and returns the number of bytes copied. */
+    size_t         readBytes(uint32_t address, void* pDest, size_t size) const;
+
+private:
+    /* Copying would leave two readers owning the same mapping. */
+    DumpReader(const DumpReader& other);
+    DumpReader& operator=(const DumpReader& other);
+
+    void        reset(const uint8_t* pDump, size_t dumpSize);
+    Result      parseRegisters();
+    Result      parseBacktrace();
+    Result      expand();
+    Result      parseItems();
+    Result      parseRecord(uint32_t type, uint32_t payloadSize);
+    Result      parseSegments(uint32_t startAddress, uint32_t size);
+    Result      addSpan(uint32_t startAddress, uint32_t size, SpanType type, const uint8_t* pData);
+    const Span* findLastSpanAtOrBelow(uint32_t address) const;
+    bool        skipBytes(size_t size);
+    size_t      bytesLeft() const;
+
+    const uint8_t* m_pDump;
+    size_t         m_dumpSize;
+    const uint8_t* m_pCurr;
+    void*          m_pMapping;
+    size_t         m_mappingSize;
+    uint8_t*       m_pExpanded;
+    bool           m_isExpansionTruncated;
+    const uint8_t* m_pIntegerRegisters;
+    const uint8_t* m_pFloatRegisters;
+    const uint8_t* m_pBacktrace;
+    uint32_t       m_backtraceAddressCount;
+    const uint8_t* m_pFaultCause;
+    uint32_t       m_completedTiers;
+    const uint8_t* m_pTiming;
+    uint32_t       m_timingRegionCount;
+    const uint8_t* m_pStackUsage;
+    uint32_t       m_flags;
+    uint32_t       m_regionCount;
+    bool           m_hasStackOverflowed;
+    Span*          m_pSpans;
+    size_t         m_spanCount;
+    size_t         m_allocatedSpans;
+};
+
+
+#endif /* _DUMP_READER_H_ */
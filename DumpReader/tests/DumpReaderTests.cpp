@@ -0,0 +1,778 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+// Include headers from modules under test.
+extern "C"
+{
+    #include <CrashCatcher.h>
+}
+#include <DumpReader.h>
+
+// Include C++ headers for test harness.
+#include <CppUTest/TestHarness.h>
+
+
+static const char g_tempFilename[] = "DumpReaderTests.dmp";
+
+
+TEST_GROUP(DumpReader)
+{
+    // Dumps are built up in this buffer by the tests, in the same format as generated by the Core.
+    uint8_t    m_dump[16384];
+    size_t     m_size;
+    DumpReader m_reader;
+
+    void setup()
+    {
+        memset(m_dump, 0, sizeof(m_dump));
+        m_size = 0;
+    }
+
+    void teardown()
+    {
+        m_reader.close();
+        remove(g_tempFilename);
+    }
+
+    void appendByte(uint8_t byte)
+    {
+        CHECK_TRUE(m_size < sizeof(m_dump));
+        m_dump[m_size++] = byte;
+    }
+
+    void appendWord(uint32_t word)
+    {
+        appendByte(word & 0xFF);
+        appendByte((word >> 8) & 0xFF);
+        appendByte((word >> 16) & 0xFF);
+        appendByte(word >> 24);
+    }
+
+    void appendHeaderAndRegisters(uint32_t flags)
+    {
+        appendHeader(flags);
+        appendRegisters(flags);
+    }
+
+    void appendHeader(uint32_t flags)
+    {
+        appendByte(CRASH_CATCHER_SIGNATURE_BYTE0);
+        appendByte(CRASH_CATCHER_SIGNATURE_BYTE1);
+        appendByte(CRASH_CATCHER_VERSION_MAJOR);
+        appendByte(CRASH_CATCHER_VERSION_MINOR);
+        appendWord(flags);
+    }
+
+    // Appends a backtrace record with slotCount address slots, the first addressCount of which are used.
+    void appendBacktrace(uint32_t addressCount, uint32_t slotCount)
+    {
+        appendWord(CRASH_CATCHER_RECORD_TAG(CRASH_CATCHER_RECORD_BACKTRACE));
+        appendWord((DumpReader::BACKTRACE_FIELD_COUNT + 1 + slotCount) * sizeof(uint32_t));
+        for (uint32_t i = 0 ; i < DumpReader::BACKTRACE_FIELD_COUNT ; i++)
+            appendWord(0xB0000000 + i);
+        appendWord(addressCount);
+        for (uint32_t i = 0 ; i < slotCount ; i++)
+            appendWord(i < addressCount ? 0x08000001 + 0x100 * i : 0);
+    }
+
+    void appendFaultCause(uint32_t cause, uint32_t isAddressValid, uint32_t address)
+    {
+        appendWord(CRASH_CATCHER_RECORD_TAG(CRASH_CATCHER_RECORD_FAULT_CAUSE));
+        appendWord(3 * sizeof(uint32_t));
+        appendWord(cause);
+        appendWord(isAddressValid);
+        appendWord(address);
+    }
+
+    void appendTierEnd(uint32_t tier)
+    {
+        appendWord(CRASH_CATCHER_RECORD_TAG(CRASH_CATCHER_RECORD_TIER_END));
+        appendWord(2 * sizeof(uint32_t));
+        appendWord(tier);
+        appendWord(0);
+    }
+
+    // Appends a timing record with slotCount region slots, the first regionCount of which are used.
+    void appendTiming(uint32_t regionCount, uint32_t slotCount)
+    {
+        appendWord(CRASH_CATCHER_RECORD_TAG(CRASH_CATCHER_RECORD_TIMING));
+        appendWord((DumpReader::TIMING_FIELD_COUNT + 1 + 2 * slotCount) * sizeof(uint32_t));
+        for (uint32_t i = 0 ; i < DumpReader::TIMING_FIELD_COUNT ; i++)
+            appendWord(0x7000 + i);
+        appendWord(regionCount);
+        for (uint32_t i = 0 ; i < slotCount ; i++)
+        {
+            appendWord(i < regionCount ? 1000 * (i + 1) : 0);
+            appendWord(i < regionCount ? 8 + i : 0);
+        }
+    }
+
+    void appendStackUsage(uint32_t stackSize, uint32_t stackUsed)
+    {
+        appendWord(CRASH_CATCHER_RECORD_TAG(CRASH_CATCHER_RECORD_STACK_USAGE));
+        appendWord(2 * sizeof(uint32_t));
+        appendWord(stackSize);
+        appendWord(stackUsed);
+    }
+
+    void appendRegisters(uint32_t flags)
+    {
+        for (uint32_t i = 0 ; i < DumpReader::INTEGER_REGISTER_COUNT ; i++)
+            appendWord(0x11111111 * (i & 0xF));
+        if (flags & CRASH_CATCHER_FLAGS_FLOATING_POINT)
+        {
+            for (uint32_t i = 0 ; i < DumpReader::FLOAT_REGISTER_COUNT ; i++)
+                appendWord(0x3F800000 + i);
+        }
+    }
+
+    // Appends a region filled with the low byte of each address and returns the offset of its data in the dump.
+    size_t appendRegion(uint32_t startAddress, uint32_t size)
+    {
+        size_t dataOffset;
+
+        appendWord(startAddress);
+        appendWord(startAddress + size);
+        dataOffset = m_size;
+        for (uint32_t i = 0 ; i < size ; i++)
+            appendByte((uint8_t)(startAddress + i));
+        return dataOffset;
+    }
+
+    void appendSegmentHeader(uint32_t type, uint32_t length)
+    {
+        appendWord((type << CRASH_CATCHER_SEGMENT_TYPE_SHIFT) | length);
+    }
+
+    // Replaces everything after the first headerSize bytes with LZ4 blocks which only hold literals, the way that the
+    // Core sends dumps with CRASH_CATCHER_FLAGS_COMPRESSED set.
+    void compress(size_t headerSize)
+    {
+        uint8_t uncompressed[sizeof(m_dump)];
+        size_t  uncompressedSize = m_size - headerSize;
+
+        memcpy(uncompressed, &m_dump[headerSize], uncompressedSize);
+        m_size = headerSize;
+        for (size_t offset = 0 ; offset < uncompressedSize ; offset += 256)
+        {
+            size_t blockSize = uncompressedSize - offset < 256 ? uncompressedSize - offset : 256;
+            size_t compressedSize = blockSize >= 15 ? blockSize + 2 : blockSize + 1;
+
+            appendByte(compressedSize & 0xFF);
+            appendByte(compressedSize >> 8);
+            appendByte(blockSize & 0xFF);
+            appendByte(blockSize >> 8);
+            appendByte(blockSize >= 15 ? 0xF0 : blockSize << 4);
+            if (blockSize >= 15)
+                appendByte(blockSize - 15);
+            for (size_t i = 0 ; i < blockSize ; i++)
+                appendByte(uncompressed[offset + i]);
+        }
+    }
+
+    DumpReader::Result parse()
+    {
+        return m_reader.parse(m_dump, m_size);
+    }
+
+    void validateSpan(size_t index, uint32_t startAddress, uint32_t size, DumpReader::SpanType type)
+    {
+        const DumpReader::Span& span = m_reader.span(index);
+
+        CHECK_EQUAL(startAddress, span.startAddress);
+        CHECK_EQUAL(size, span.size);
+        CHECK_EQUAL(type, span.type);
+    }
+};
+
+
+TEST(DumpReader, EmptyDump_ShouldReturnTruncated)
+{
+    CHECK_EQUAL(DumpReader::TRUNCATED, parse());
+    CHECK_EQUAL(0, m_reader.spanCount());
+    CHECK_EQUAL(0, m_reader.integerRegister(DumpReader::PC));
+}
+
+TEST(DumpReader, BadSignature_ShouldReturnBadSignature)
+{
+    appendHeaderAndRegisters(0);
+    m_dump[1] = 'c';
+    CHECK_EQUAL(DumpReader::BAD_SIGNATURE, parse());
+}
+
+TEST(DumpReader, UnsupportedMajorVersion_ShouldReturnBadSignature)
+{
+    appendHeaderAndRegisters(0);
+    m_dump[2] = CRASH_CATCHER_VERSION_MAJOR + 1;
+    CHECK_EQUAL(DumpReader::BAD_SIGNATURE, parse());
+}
+
+TEST(DumpReader, CompressedDump_ShouldExpandBlocksAndIndexRegions)
+{
+    uint8_t expected[600];
+    uint8_t actual[600];
+
+    appendHeaderAndRegisters(CRASH_CATCHER_FLAGS_COMPRESSED);
+    size_t dataOffset = appendRegion(0x20000000, sizeof(expected));
+    memcpy(expected, &m_dump[dataOffset], sizeof(expected));
+    compress(8);
+    CHECK_EQUAL(DumpReader::OK, parse());
+    CHECK_EQUAL(CRASH_CATCHER_FLAGS_COMPRESSED, m_reader.flags());
+    CHECK_EQUAL(0xFFFFFFFF, m_reader.integerRegister(DumpReader::PC));
+    CHECK_EQUAL(1, m_reader.spanCount());
+    validateSpan(0, 0x20000000, sizeof(expected), DumpReader::SPAN_DATA);
+    CHECK_EQUAL(sizeof(actual), m_reader.readBytes(0x20000000, actual, sizeof(actual)));
+    MEMCMP_EQUAL(expected, actual, sizeof(expected));
+}
+
+TEST(DumpReader, CompressedDumpCutOffInLastBlock_ShouldReturnTruncatedButKeepRegisters)
+{
+    appendHeaderAndRegisters(CRASH_CATCHER_FLAGS_COMPRESSED);
+    appendRegion(0x20000000, 600);
+    compress(8);
+    m_size--;
+    CHECK_EQUAL(DumpReader::TRUNCATED, parse());
+    CHECK_TRUE(m_reader.hasIntegerRegisters());
+    CHECK_EQUAL(0, m_reader.spanCount());
+}
+
+TEST(DumpReader, CompressedDumpWithCorruptBlock_ShouldReturnMalformed)
+{
+    appendHeaderAndRegisters(CRASH_CATCHER_FLAGS_COMPRESSED);
+    compress(8);
+    // Claim that the block decodes to one byte more than it does.
+    m_dump[8 + 2]++;
+    CHECK_EQUAL(DumpReader::MALFORMED, parse());
+    CHECK_FALSE(m_reader.hasIntegerRegisters());
+}
+
+TEST(DumpReader, TruncatedRegisters_ShouldReturnTruncated)
+{
+    appendHeaderAndRegisters(0);
+    m_size -= 1;
+    CHECK_EQUAL(DumpReader::TRUNCATED, parse());
+    CHECK_FALSE(m_reader.hasIntegerRegisters());
+    CHECK_EQUAL(0, m_reader.integerRegister(DumpReader::R1));
+}
+
+TEST(DumpReader, TruncatedFloatingPointRegisters_ShouldStillReturnIntegerRegisters)
+{
+    appendHeaderAndRegisters(CRASH_CATCHER_FLAGS_FLOATING_POINT);
+    m_size -= 1;
+    CHECK_EQUAL(DumpReader::TRUNCATED, parse());
+    CHECK_TRUE(m_reader.hasIntegerRegisters());
+    CHECK_EQUAL(0xFFFFFFFF, m_reader.integerRegister(DumpReader::PC));
+}
+
+TEST(DumpReader, RegistersOnly_ShouldReturnRegistersAndNoRegions)
+{
+    appendHeaderAndRegisters(0);
+    CHECK_EQUAL(DumpReader::OK, parse());
+    CHECK_TRUE(m_reader.hasIntegerRegisters());
+    CHECK_EQUAL(0, m_reader.regionCount());
+    CHECK_EQUAL(0, m_reader.spanCount());
+    CHECK_FALSE(m_reader.hasFloatingPoint());
+    CHECK_FALSE(m_reader.hasStackOverflowed());
+    CHECK_EQUAL(0x00000000, m_reader.integerRegister(DumpReader::R0));
+    CHECK_EQUAL(0xFFFFFFFF, m_reader.integerRegister(DumpReader::PC));
+    CHECK_EQUAL(0x33333333, m_reader.integerRegister(DumpReader::EXCEPTION_PSR));
+    CHECK_EQUAL(0, m_reader.integerRegister(DumpReader::INTEGER_REGISTER_COUNT));
+    CHECK_EQUAL(0, m_reader.floatRegister(0));
+    CHECK_TRUE(m_reader.findSpan(0x00000000) == NULL);
+}
+
+TEST(DumpReader, FloatingPointRegisters_ShouldBeReturned)
+{
+    appendHeaderAndRegisters(CRASH_CATCHER_FLAGS_FLOATING_POINT);
+    appendRegion(0x10000000, 4);
+    CHECK_EQUAL(DumpReader::OK, parse());
+    CHECK_TRUE(m_reader.hasFloatingPoint());
+    CHECK_EQUAL(0x3F800000, m_reader.floatRegister(0));
+    CHECK_EQUAL(0x3F800000 + 32, m_reader.floatRegister(DumpReader::FPSCR));
+    CHECK_EQUAL(0, m_reader.floatRegister(DumpReader::FLOAT_REGISTER_COUNT));
+    CHECK_EQUAL(1, m_reader.spanCount());
+}
+
+TEST(DumpReader, RegionsOutOfOrder_ShouldBeSortedByAddress)
+{
+    appendHeaderAndRegisters(0);
+    appendRegion(0x20000000, 16);
+    appendRegion(0x10000000, 8);
+    appendRegion(0xE000ED28, 20);
+    CHECK_EQUAL(DumpReader::OK, parse());
+    CHECK_EQUAL(3, m_reader.regionCount());
+    CHECK_EQUAL(3, m_reader.spanCount());
+    validateSpan(0, 0x10000000, 8, DumpReader::SPAN_DATA);
+    validateSpan(1, 0x20000000, 16, DumpReader::SPAN_DATA);
+    validateSpan(2, 0xE000ED28, 20, DumpReader::SPAN_DATA);
+    CHECK_EQUAL(1, m_reader.span(0).regionIndex);
+}
+
+TEST(DumpReader, FindSpan_ShouldOnlyMatchAddressesInsideRegions)
+{
+    appendHeaderAndRegisters(0);
+    appendRegion(0x10000000, 8);
+    appendRegion(0x20000000, 16);
+    CHECK_EQUAL(DumpReader::OK, parse());
+    CHECK_TRUE(m_reader.findSpan(0x0FFFFFFF) == NULL);
+    CHECK_TRUE(m_reader.findSpan(0x10000000) == &m_reader.span(0));
+    CHECK_TRUE(m_reader.findSpan(0x10000007) == &m_reader.span(0));
+    CHECK_TRUE(m_reader.findSpan(0x10000008) == NULL);
+    CHECK_TRUE(m_reader.findSpan(0x20000000) == &m_reader.span(1));
+    CHECK_TRUE(m_reader.findSpan(0x2000000F) == &m_reader.span(1));
+    CHECK_TRUE(m_reader.findSpan(0x20000010) == NULL);
+    CHECK_TRUE(m_reader.findSpan(0xFFFFFFFF) == NULL);
+}
+
+TEST(DumpReader, FindBytes_ShouldPointStraightIntoDump)
+{
+    size_t dataOffset;
+
+    appendHeaderAndRegisters(0);
+    dataOffset = appendRegion(0x10000000, 16);
+    CHECK_EQUAL(DumpReader::OK, parse());
+    CHECK_TRUE(m_reader.findBytes(0x10000004, 4) == &m_dump[dataOffset + 4]);
+    CHECK_TRUE(m_reader.findBytes(0x10000000, 16) == &m_dump[dataOffset]);
+    CHECK_TRUE(m_reader.findBytes(0x10000001, 16) == NULL);
+    CHECK_TRUE(m_reader.findBytes(0x10000010, 1) == NULL);
+}
+
+TEST(DumpReader, ReadBytes_ShouldCopyAcrossAdjacentRegionsAndStopAtGap)
+{
+    uint8_t buffer[32];
+
+    appendHeaderAndRegisters(0);
+    appendRegion(0x10000000, 8);
+    appendRegion(0x10000008, 8);
+    CHECK_EQUAL(DumpReader::OK, parse());
+    memset(buffer, 0xFF, sizeof(buffer));
+    CHECK_EQUAL(12, m_reader.readBytes(0x10000004, buffer, sizeof(buffer)));
+    for (int i = 0 ; i < 12 ; i++)
+        CHECK_EQUAL(4 + i, buffer[i]);
+    CHECK_EQUAL(0xFF, buffer[12]);
+    CHECK_EQUAL(0, m_reader.readBytes(0x10000010, buffer, sizeof(buffer)));
+}
+
+TEST(DumpReader, EmptyRegion_ShouldBeCountedButNotIndexed)
+{
+    appendHeaderAndRegisters(0);
+    appendRegion(0x10000000, 0);
+    appendRegion(0x20000000, 4);
+    CHECK_EQUAL(DumpReader::OK, parse());
+    CHECK_EQUAL(2, m_reader.regionCount());
+    CHECK_EQUAL(1, m_reader.spanCount());
+    CHECK_EQUAL(1, m_reader.span(0).regionIndex);
+}
+
+TEST(DumpReader, CrcTrailerAndStackSentinel_ShouldBeSkipped)
+{
+    appendHeaderAndRegisters(CRASH_CATCHER_FLAGS_CRC32);
+    appendRegion(0x10000000, 4);
+    appendWord(CRASH_CATCHER_RECORD_TAG(CRASH_CATCHER_RECORD_CRC32));
+    appendWord(3 * sizeof(uint32_t));
+    appendWord(0x12345678);
+    appendWord(1);
+    appendWord(0x9ABCDEF0);
+    appendWord(0xED55CEAC);
+    CHECK_EQUAL(DumpReader::OK, parse());
+    CHECK_EQUAL(1, m_reader.regionCount());
+    CHECK_EQUAL(1, m_reader.spanCount());
+    CHECK_TRUE(m_reader.hasStackOverflowed());
+}
+
+TEST(DumpReader, TruncatedRegion_ShouldReturnTruncatedButKeepEarlierRegions)
+{
+    appendHeaderAndRegisters(0);
+    appendRegion(0x10000000, 4);
+    appendRegion(0x20000000, 16);
+    m_size -= 1;
+    CHECK_EQUAL(DumpReader::TRUNCATED, parse());
+    CHECK_EQUAL(1, m_reader.regionCount());
+    CHECK_EQUAL(1, m_reader.spanCount());
+    CHECK_TRUE(m_reader.findSpan(0x10000000) != NULL);
+}
+
+TEST(DumpReader, PartialRegionHeader_ShouldReturnTruncated)
+{
+    appendHeaderAndRegisters(0);
+    appendWord(0x10000000);
+    appendByte(0x00);
+    CHECK_EQUAL(DumpReader::TRUNCATED, parse());
+}
+
+TEST(DumpReader, RegionEndingBeforeItStarts_ShouldReturnMalformed)
+{
+    appendHeaderAndRegisters(0);
+    appendWord(0x20000000);
+    appendWord(0x10000000);
+    CHECK_EQUAL(DumpReader::MALFORMED, parse());
+}
+
+TEST(DumpReader, SegmentedRegion_ShouldIndexEachSegmentExceptHoles)
+{
+    uint8_t buffer[16];
+
+    appendHeaderAndRegisters(CRASH_CATCHER_FLAGS_SEGMENTED);
+    appendWord(0x20000000);
+    appendWord(0x20000040);
+    appendSegmentHeader(CRASH_CATCHER_SEGMENT_RAW, 4);
+    appendWord(0x03020100);
+    appendSegmentHeader(CRASH_CATCHER_SEGMENT_FILL, 32);
+    appendWord(0xDEADBEEF);
+    appendSegmentHeader(CRASH_CATCHER_SEGMENT_HOLE, 12);
+    appendSegmentHeader(CRASH_CATCHER_SEGMENT_LOAD_IMAGE, 16);
+    appendWord(0x00004000);
+    CHECK_EQUAL(DumpReader::OK, parse());
+    CHECK_EQUAL(1, m_reader.regionCount());
+    CHECK_EQUAL(3, m_reader.spanCount());
+    validateSpan(0, 0x20000000, 4, DumpReader::SPAN_DATA);
+    validateSpan(1, 0x20000004, 32, DumpReader::SPAN_FILL);
+    validateSpan(2, 0x20000030, 16, DumpReader::SPAN_LOAD_IMAGE);
+    CHECK_TRUE(m_reader.findSpan(0x20000024) == NULL);
+    CHECK_TRUE(m_reader.findBytes(0x20000004, 4) == NULL);
+    CHECK_EQUAL(0x00, m_reader.span(2).pData[0]);
+    CHECK_EQUAL(0x40, m_reader.span(2).pData[1]);
+
+    CHECK_EQUAL(10, m_reader.readBytes(0x20000002, buffer, 10));
+    CHECK_EQUAL(0x02, buffer[0]);
+    CHECK_EQUAL(0x03, buffer[1]);
+    CHECK_EQUAL(0xEF, buffer[2]);
+    CHECK_EQUAL(0xBE, buffer[3]);
+    CHECK_EQUAL(0xAD, buffer[4]);
+    CHECK_EQUAL(0xDE, buffer[5]);
+    CHECK_EQUAL(0xEF, buffer[6]);
+    CHECK_EQUAL(0, m_reader.readBytes(0x20000030, buffer, sizeof(buffer)));
+}
+
+TEST(DumpReader, SegmentWithUnknownType_ShouldReturnMalformed)
+{
+    appendHeaderAndRegisters(CRASH_CATCHER_FLAGS_SEGMENTED);
+    appendWord(0x20000000);
+    appendWord(0x20000004);
+    appendSegmentHeader(0xF, 4);
+    CHECK_EQUAL(DumpReader::MALFORMED, parse());
+}
+
+TEST(DumpReader, SegmentLongerThanRegion_ShouldReturnMalformed)
+{
+    appendHeaderAndRegisters(CRASH_CATCHER_FLAGS_SEGMENTED);
+    appendWord(0x20000000);
+    appendWord(0x20000004);
+    appendSegmentHeader(CRASH_CATCHER_SEGMENT_RAW, 8);
+    CHECK_EQUAL(DumpReader::MALFORMED, parse());
+}
+
+TEST(DumpReader, OverlappingRegions_ShouldFindRegionWithHighestStartAddress)
+{
+    appendHeaderAndRegisters(0);
+    appendRegion(0x10000000, 16);
+    appendRegion(0x10000004, 4);
+    CHECK_EQUAL(DumpReader::OK, parse());
+    CHECK_TRUE(m_reader.findSpan(0x10000002) == &m_reader.span(0));
+    CHECK_TRUE(m_reader.findSpan(0x10000006) == &m_reader.span(1));
+    CHECK_TRUE(m_reader.findSpan(0x1000000C) == NULL);
+}
+
+TEST(DumpReader, ManyRegions_ShouldFindEachOneWithBinarySearch)
+{
+    appendHeaderAndRegisters(0);
+    for (uint32_t i = 0 ; i < 1000 ; i++)
+        appendRegion(0x10000000 + ((i * 7919) % 1000) * 16, 4);
+    CHECK_EQUAL(DumpReader::OK, parse());
+    CHECK_EQUAL(1000, m_reader.spanCount());
+    for (uint32_t i = 0 ; i < 1000 ; i++)
+    {
+        uint32_t                address = 0x10000000 + i * 16;
+        const DumpReader::Span* pSpan = m_reader.findSpan(address + 3);
+
+        CHECK_TRUE(pSpan != NULL);
+        CHECK_EQUAL(address, pSpan->startAddress);
+        CHECK_TRUE(m_reader.findSpan(address + 4) == NULL);
+    }
+}
+
+TEST(DumpReader, OpenFile_ShouldMapAndIndexIt)
+{
+    FILE* pFile;
+
+    appendHeaderAndRegisters(0);
+    appendRegion(0x10000000, 16);
+    pFile = fopen(g_tempFilename, "wb");
+    CHECK_TRUE(pFile != NULL);
+    CHECK_EQUAL(m_size, fwrite(m_dump, 1, m_size, pFile));
+    fclose(pFile);
+
+    CHECK_EQUAL(DumpReader::OK, m_reader.open(g_tempFilename));
+    CHECK_EQUAL(1, m_reader.spanCount());
+    CHECK_EQUAL(0x0C, m_reader.findBytes(0x1000000C, 1)[0]);
+    m_reader.close();
+    CHECK_EQUAL(0, m_reader.spanCount());
+    CHECK_TRUE(m_reader.findSpan(0x10000000) == NULL);
+}
+
+TEST(DumpReader, OpenEmptyFile_ShouldReturnTruncated)
+{
+    FILE* pFile = fopen(g_tempFilename, "wb");
+
+    CHECK_TRUE(pFile != NULL);
+    fclose(pFile);
+    CHECK_EQUAL(DumpReader::TRUNCATED, m_reader.open(g_tempFilename));
+}
+
+TEST(DumpReader, OpenMissingFile_ShouldReturnOpenFailed)
+{
+    CHECK_EQUAL(DumpReader::OPEN_FAILED, m_reader.open("DumpReaderTests.missing"));
+}
+
+TEST(DumpReader, DumpWithoutBacktrace_ShouldReturnNoBacktrace)
+{
+    appendHeaderAndRegisters(0);
+    CHECK_EQUAL(DumpReader::OK, parse());
+    CHECK_FALSE(m_reader.hasBacktrace());
+    CHECK_EQUAL(0, m_reader.backtraceAddressCount());
+    CHECK_EQUAL(0, m_reader.backtraceField(DumpReader::BACKTRACE_PC));
+    CHECK_EQUAL(0, m_reader.backtraceAddress(0));
+}
+
+TEST(DumpReader, Backtrace_ShouldReturnFieldsAndUsedAddressesThenRegisters)
+{
+    appendHeader(CRASH_CATCHER_FLAGS_BACKTRACE);
+    appendBacktrace(2, 8);
+    appendRegisters(0);
+    appendRegion(0x10000000, 4);
+    CHECK_EQUAL(DumpReader::OK, parse());
+    CHECK_TRUE(m_reader.hasBacktrace());
+    CHECK_EQUAL(0xB0000000, m_reader.backtraceField(DumpReader::BACKTRACE_EXC_RETURN));
+    CHECK_EQUAL(0xB0000007, m_reader.backtraceField(DumpReader::BACKTRACE_SP));
+    CHECK_EQUAL(0, m_reader.backtraceField(DumpReader::BACKTRACE_FIELD_COUNT));
+    CHECK_EQUAL(2, m_reader.backtraceAddressCount());
+    CHECK_EQUAL(0x08000001, m_reader.backtraceAddress(0));
+    CHECK_EQUAL(0x08000101, m_reader.backtraceAddress(1));
+    CHECK_EQUAL(0, m_reader.backtraceAddress(2));
+    CHECK_EQUAL(0xFFFFFFFF, m_reader.integerRegister(DumpReader::PC));
+    CHECK_EQUAL(1, m_reader.spanCount());
+}
+
+TEST(DumpReader, BacktraceWithMoreAddressesThanSlots_ShouldLimitCountToSlots)
+{
+    appendHeader(CRASH_CATCHER_FLAGS_BACKTRACE);
+    appendBacktrace(2, 1);
+    appendRegisters(0);
+    CHECK_EQUAL(DumpReader::OK, parse());
+    CHECK_EQUAL(1, m_reader.backtraceAddressCount());
+}
+
+TEST(DumpReader, CompressedDumpWithBacktrace_ShouldExpandBlocksAfterBacktrace)
+{
+    appendHeader(CRASH_CATCHER_FLAGS_COMPRESSED | CRASH_CATCHER_FLAGS_BACKTRACE);
+    appendBacktrace(1, 4);
+    size_t headerSize = m_size;
+    appendRegisters(0);
+    appendRegion(0x20000000, 4);
+    compress(headerSize);
+    CHECK_EQUAL(DumpReader::OK, parse());
+    CHECK_TRUE(m_reader.hasBacktrace());
+    CHECK_EQUAL(0x08000001, m_reader.backtraceAddress(0));
+    CHECK_EQUAL(0xFFFFFFFF, m_reader.integerRegister(DumpReader::PC));
+    CHECK_EQUAL(1, m_reader.spanCount());
+}
+
+TEST(DumpReader, CompressedDumpWithBacktraceAndCorruptBlock_ShouldStillReturnBacktrace)
+{
+    appendHeader(CRASH_CATCHER_FLAGS_COMPRESSED | CRASH_CATCHER_FLAGS_BACKTRACE);
+    appendBacktrace(1, 4);
+    size_t headerSize = m_size;
+    appendRegisters(0);
+    compress(headerSize);
+    m_dump[headerSize + 2]++;
+    CHECK_EQUAL(DumpReader::MALFORMED, parse());
+    CHECK_TRUE(m_reader.hasBacktrace());
+    CHECK_EQUAL(0x08000001, m_reader.backtraceAddress(0));
+}
+
+TEST(DumpReader, DumpCutShortAfterBacktrace_ShouldReturnTruncatedButKeepBacktrace)
+{
+    appendHeader(CRASH_CATCHER_FLAGS_BACKTRACE);
+    appendBacktrace(1, 4);
+    appendWord(0);
+    CHECK_EQUAL(DumpReader::TRUNCATED, parse());
+    CHECK_TRUE(m_reader.hasBacktrace());
+    CHECK_FALSE(m_reader.hasIntegerRegisters());
+}
+
+TEST(DumpReader, TruncatedBacktrace_ShouldReturnTruncated)
+{
+    appendHeader(CRASH_CATCHER_FLAGS_BACKTRACE);
+    appendBacktrace(1, 4);
+    m_size -= 1;
+    CHECK_EQUAL(DumpReader::TRUNCATED, parse());
+    CHECK_FALSE(m_reader.hasBacktrace());
+}
+
+TEST(DumpReader, BacktraceWithWrongTagOrSize_ShouldReturnMalformed)
+{
+    appendHeader(CRASH_CATCHER_FLAGS_BACKTRACE);
+    appendBacktrace(1, 4);
+    m_dump[8] = CRASH_CATCHER_RECORD_CRC32;
+    CHECK_EQUAL(DumpReader::MALFORMED, parse());
+    m_dump[8] = CRASH_CATCHER_RECORD_BACKTRACE;
+    m_dump[12] = 4;
+    CHECK_EQUAL(DumpReader::MALFORMED, parse());
+    CHECK_FALSE(m_reader.hasBacktrace());
+}
+
+TEST(DumpReader, DumpWithoutTiers_ShouldReturnNoFaultCauseOrCompletedTiers)
+{
+    appendHeaderAndRegisters(0);
+    CHECK_EQUAL(DumpReader::OK, parse());
+    CHECK_FALSE(m_reader.hasFaultCause());
+    CHECK_EQUAL(CRASH_CATCHER_FAULT_UNKNOWN, m_reader.faultCause());
+    CHECK_FALSE(m_reader.hasFaultAddress());
+    CHECK_EQUAL(0, m_reader.faultAddress());
+    CHECK_EQUAL(0, m_reader.completedTiers());
+}
+
+TEST(DumpReader, TwoTierDump_ShouldReturnFaultCauseAndIndexRegionsFromBothTiers)
+{
+    appendHeaderAndRegisters(CRASH_CATCHER_FLAGS_TWO_TIER);
+    appendFaultCause(CRASH_CATCHER_FAULT_DATA_ACCESS, 1, 0x33333333);
+    appendRegion(0x20001000, 8);
+    appendTierEnd(1);
+    appendRegion(0x20000000, 0x1000);
+    appendTierEnd(2);
+    CHECK_EQUAL(DumpReader::OK, parse());
+    CHECK_TRUE(m_reader.hasFaultCause());
+    CHECK_EQUAL(CRASH_CATCHER_FAULT_DATA_ACCESS, m_reader.faultCause());
+    CHECK_TRUE(m_reader.hasFaultAddress());
+    CHECK_EQUAL(0x33333333, m_reader.faultAddress());
+    CHECK_EQUAL(2, m_reader.completedTiers());
+    CHECK_EQUAL(2, m_reader.regionCount());
+    CHECK_EQUAL(2, m_reader.spanCount());
+}
+
+TEST(DumpReader, TwoTierDumpCutShortInTier2_ShouldReturnTruncatedButKeepTier1)
+{
+    appendHeaderAndRegisters(CRASH_CATCHER_FLAGS_TWO_TIER);
+    appendFaultCause(CRASH_CATCHER_FAULT_UNDEFINED_INSTRUCTION, 0, 0);
+    appendRegion(0x20001000, 8);
+    appendTierEnd(1);
+    appendRegion(0x20000000, 0x1000);
+    m_size -= 0x800;
+    CHECK_EQUAL(DumpReader::TRUNCATED, parse());
+    CHECK_EQUAL(1, m_reader.completedTiers());
+    CHECK_TRUE(m_reader.hasIntegerRegisters());
+    CHECK_EQUAL(CRASH_CATCHER_FAULT_UNDEFINED_INSTRUCTION, m_reader.faultCause());
+    CHECK_FALSE(m_reader.hasFaultAddress());
+    CHECK_EQUAL(0, m_reader.faultAddress());
+    CHECK_TRUE(m_reader.findBytes(0x20001000, 8) != NULL);
+}
+
+TEST(DumpReader, FaultCauseWithShortPayload_ShouldReturnMalformed)
+{
+    appendHeaderAndRegisters(CRASH_CATCHER_FLAGS_TWO_TIER);
+    appendWord(CRASH_CATCHER_RECORD_TAG(CRASH_CATCHER_RECORD_FAULT_CAUSE));
+    appendWord(sizeof(uint32_t));
+    appendWord(CRASH_CATCHER_FAULT_DATA_ACCESS);
+    CHECK_EQUAL(DumpReader::MALFORMED, parse());
+    CHECK_FALSE(m_reader.hasFaultCause());
+}
+
+TEST(DumpReader, DumpWithTiming_ShouldReturnPhaseAndRegionTimings)
+{
+    appendHeaderAndRegisters(CRASH_CATCHER_FLAGS_TIMING);
+    appendRegion(0x20000000, 0x100);
+    appendTiming(2, 4);
+    CHECK_EQUAL(DumpReader::OK, parse());
+    CHECK_TRUE(m_reader.hasTiming());
+    CHECK_EQUAL(0x7000, m_reader.timingField(DumpReader::TIMING_ATTEMPT));
+    CHECK_EQUAL(0x7005, m_reader.timingField(DumpReader::TIMING_BYTE_COUNT));
+    CHECK_EQUAL(0, m_reader.timingField(DumpReader::TIMING_FIELD_COUNT));
+    CHECK_EQUAL(2, m_reader.timingRegionCount());
+    CHECK_EQUAL(1000, m_reader.timingRegionCycles(0));
+    CHECK_EQUAL(9, m_reader.timingRegionByteCount(1));
+    CHECK_EQUAL(0, m_reader.timingRegionCycles(2));
+    CHECK_EQUAL(1, m_reader.regionCount());
+}
+
+TEST(DumpReader, TimingWithMoreRegionsThanSlots_ShouldClampRegionCount)
+{
+    appendHeaderAndRegisters(CRASH_CATCHER_FLAGS_TIMING);
+    appendTiming(5, 3);
+    CHECK_EQUAL(DumpReader::OK, parse());
+    CHECK_EQUAL(3, m_reader.timingRegionCount());
+    CHECK_EQUAL(3000, m_reader.timingRegionCycles(2));
+}
+
+TEST(DumpReader, DumpWithoutTiming_ShouldReturnNoTiming)
+{
+    appendHeaderAndRegisters(0);
+    CHECK_EQUAL(DumpReader::OK, parse());
+    CHECK_FALSE(m_reader.hasTiming());
+    CHECK_EQUAL(0, m_reader.timingField(DumpReader::TIMING_ATTEMPT));
+    CHECK_EQUAL(0, m_reader.timingRegionCount());
+}
+
+TEST(DumpReader, TimingWithShortPayload_ShouldReturnMalformed)
+{
+    appendHeaderAndRegisters(CRASH_CATCHER_FLAGS_TIMING);
+    appendWord(CRASH_CATCHER_RECORD_TAG(CRASH_CATCHER_RECORD_TIMING));
+    appendWord(sizeof(uint32_t));
+    appendWord(1);
+    CHECK_EQUAL(DumpReader::MALFORMED, parse());
+    CHECK_FALSE(m_reader.hasTiming());
+}
+
+TEST(DumpReader, DumpWithStackUsage_ShouldReturnStackSizeAndHighWaterMark)
+{
+    appendHeaderAndRegisters(CRASH_CATCHER_FLAGS_STACK_USAGE);
+    appendRegion(0x20000000, 0x100);
+    appendStackUsage(500, 312);
+    CHECK_EQUAL(DumpReader::OK, parse());
+    CHECK_TRUE(m_reader.hasStackUsage());
+    CHECK_EQUAL(500, m_reader.stackSize());
+    CHECK_EQUAL(312, m_reader.stackUsed());
+    CHECK_EQUAL(1, m_reader.regionCount());
+}
+
+TEST(DumpReader, DumpWithoutStackUsage_ShouldReturnNoStackUsage)
+{
+    appendHeaderAndRegisters(0);
+    CHECK_EQUAL(DumpReader::OK, parse());
+    CHECK_FALSE(m_reader.hasStackUsage());
+    CHECK_EQUAL(0, m_reader.stackSize());
+    CHECK_EQUAL(0, m_reader.stackUsed());
+}
+
+TEST(DumpReader, StackUsageWithShortPayload_ShouldReturnMalformed)
+{
+    appendHeaderAndRegisters(CRASH_CATCHER_FLAGS_STACK_USAGE);
+    appendWord(CRASH_CATCHER_RECORD_TAG(CRASH_CATCHER_RECORD_STACK_USAGE));
+    appendWord(sizeof(uint32_t));
+    appendWord(500);
+    CHECK_EQUAL(DumpReader::MALFORMED, parse());
+    CHECK_FALSE(m_reader.hasStackUsage());
+}
+
+TEST(DumpReader, TruncatedTierEnd_ShouldReturnTruncated)
+{
+    appendHeaderAndRegisters(CRASH_CATCHER_FLAGS_TWO_TIER);
+    appendTierEnd(1);
+    m_size -= 1;
+    CHECK_EQUAL(DumpReader::TRUNCATED, parse());
+    CHECK_EQUAL(0, m_reader.completedTiers());
+}
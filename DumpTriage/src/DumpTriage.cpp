@@ -0,0 +1,298 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Each dump is parsed with DumpReader on one of the WorkStealingPool threads.  Once they have all been read, a sort key
+   is built for each readable dump and the keys are sorted so that dumps with the same signature end up next to each
+   other, where they are counted into buckets. */
+#include <stdlib.h>
+#include <string.h>
+#include "DumpTriage.h"
+#include "WorkStealingPool.h"
+
+
+/* The CrashCatcher Core dumps CFSR, HFSR, DFSR, MMFAR and BFAR as a region at this address. */
+#define FAULT_STATUS_ADDRESS    0xE000ED28
+#define FAULT_STATUS_WORDS      5
+#define CFSR_INDEX              0
+#define HFSR_INDEX              1
+#define MMFAR_INDEX             3
+#define BFAR_INDEX              4
+
+/* Number of bytes of stack above the SP which are scanned for return addresses. */
+#define STACK_SCAN_SIZE         4096
+
+
+/* The parts of a signature which are compared when bucketing, with the return addresses past the bucket depth zeroed
+   out. */
+struct SortKey
+{
+    uint32_t pc;
+    uint32_t lr;
+    uint32_t cfsr;
+    uint32_t hfsr;
+    size_t   returnAddressCount;
+    uint32_t returnAddresses[CrashSignature::MAX_RETURN_ADDRESSES];
+    size_t   entryIndex;
+};
+
+
+static uint32_t readUInt32(const uint8_t* pSrc);
+static void     initSortKey(SortKey* pKey, const CrashSignature* pSignature, size_t bucketDepth, size_t entryIndex);
+static int      compareSignatures(const SortKey* pKey1, const SortKey* pKey2);
+static int      compareValues(size_t value1, size_t value2);
+static int      compareSortKeys(const void* pv1, const void* pv2);
+static int      compareBuckets(const void* pv1, const void* pv2);
+
+
+DumpTriage::DumpTriage(uint32_t codeStart, uint32_t codeEnd, size_t bucketDepth)
+{
+    m_codeStart = codeStart;
+    m_codeEnd = codeEnd;
+    m_bucketDepth = bucketDepth < CrashSignature::MAX_RETURN_ADDRESSES ?
+                    bucketDepth : (size_t)CrashSignature::MAX_RETURN_ADDRESSES;
+    m_pEntries = NULL;
+    m_entryCount = 0;
+    m_allocatedEntries = 0;
+    m_unreadableCount = 0;
+    m_pBuckets = NULL;
+    m_bucketCount = 0;
+}
+
+DumpTriage::~DumpTriage()
+{
+    size_t i;
+
+    for (i = 0 ; i < m_entryCount ; i++)
+        free(m_pEntries[i].pFilename);
+    free(m_pEntries);
+    free(m_pBuckets);
+}
+
+bool DumpTriage::addFile(const char* pFilename)
+{
+    Entry* pEntry;
+
+    if (m_entryCount == m_allocatedEntries)
+    {
+        size_t newAllocated = m_allocatedEntries ? m_allocatedEntries * 2 : 64;
+        Entry* pNewEntries = (Entry*)realloc(m_pEntries, newAllocated * sizeof(*pNewEntries));
+
+        if (!pNewEntries)
+            return false;
+        m_pEntries = pNewEntries;
+        m_allocatedEntries = newAllocated;
+    }
+    pEntry = &m_pEntries[m_entryCount];
+    memset(pEntry, 0, sizeof(*pEntry));
+    pEntry->pFilename = (char*)malloc(strlen(pFilename) + 1);
+    if (!pEntry->pFilename)
+        return false;
+    strcpy(pEntry->pFilename, pFilename);
+    m_entryCount++;
+    return true;
+}
+
+bool DumpTriage::run(unsigned int threadCount)
+{
+    size_t i;
+
+    WorkStealingPool::run(m_entryCount, threadCount, readEntry, this);
+    m_unreadableCount = 0;
+    for (i = 0 ; i < m_entryCount ; i++)
+    {
+        if (!m_pEntries[i].isReadable)
+            m_unreadableCount++;
+    }
+    return createBuckets();
+}
+
+void DumpTriage::readEntry(void* pvTriage, size_t index)
+{
+    DumpTriage* pTriage = (DumpTriage*)pvTriage;
+    Entry*      pEntry = &pTriage->m_pEntries[index];
+    DumpReader  reader;
+
+    pEntry->result = reader.open(pEntry->pFilename);
+    pEntry->isReadable = reader.hasIntegerRegisters();
+    if (pEntry->isReadable)
+        extractSignature(reader, pTriage->m_codeStart, pTriage->m_codeEnd, &pEntry->signature);
+}
+
+void DumpTriage::extractSignature(const DumpReader& reader, uint32_t codeStart, uint32_t codeEnd,
+                                  CrashSignature* pSignature)
+{
+    uint8_t  faultStatus[FAULT_STATUS_WORDS * sizeof(uint32_t)];
+    uint8_t  stack[STACK_SCAN_SIZE];
+    uint32_t sp = reader.integerRegister(DumpReader::SP) & ~3;
+    size_t   stackSize;
+    size_t   offset;
+
+    memset(pSignature, 0, sizeof(*pSignature));
+    pSignature->pc = reader.integerRegister(DumpReader::PC);
+    pSignature->lr = reader.integerRegister(DumpReader::LR);
+    if (reader.readBytes(FAULT_STATUS_ADDRESS, faultStatus, sizeof(faultStatus)) == sizeof(faultStatus))
+    {
+        pSignature->hasFaultStatus = true;
+        pSignature->cfsr = readUInt32(&faultStatus[CFSR_INDEX * sizeof(uint32_t)]);
+        pSignature->hfsr = readUInt32(&faultStatus[HFSR_INDEX * sizeof(uint32_t)]);
+        pSignature->mmfar = readUInt32(&faultStatus[MMFAR_INDEX * sizeof(uint32_t)]);
+        pSignature->bfar = readUInt32(&faultStatus[BFAR_INDEX * sizeof(uint32_t)]);
+    }
+
+    /* Without the ELF to unwind with, any odd word pointing into the code is taken to be a stacked return address. */
+    stackSize = reader.readBytes(sp, stack, sizeof(stack));
+    for (offset = 0 ; offset + sizeof(uint32_t) <= stackSize ; offset += sizeof(uint32_t))
+    {
+        uint32_t word = readUInt32(&stack[offset]);
+
+        if ((word & 1) && word - 1 >= codeStart && word - 1 < codeEnd)
+            pSignature->returnAddresses[pSignature->returnAddressCount++] = word;
+        if (pSignature->returnAddressCount == CrashSignature::MAX_RETURN_ADDRESSES)
+            break;
+    }
+}
+
+static uint32_t readUInt32(const uint8_t* pSrc)
+{
+    return pSrc[0] | (pSrc[1] << 8) | (pSrc[2] << 16) | ((uint32_t)pSrc[3] << 24);
+}
+
+bool DumpTriage::createBuckets()
+{
+    SortKey* pKeys;
+    size_t   keyCount = 0;
+    size_t   i;
+
+    free(m_pBuckets);
+    m_pBuckets = NULL;
+    m_bucketCount = 0;
+    pKeys = (SortKey*)malloc((m_entryCount ? m_entryCount : 1) * sizeof(*pKeys));
+    m_pBuckets = (Bucket*)malloc((m_entryCount ? m_entryCount : 1) * sizeof(*m_pBuckets));
+    if (!pKeys || !m_pBuckets)
+    {
+        free(pKeys);
+        return false;
+    }
+
+    for (i = 0 ; i < m_entryCount ; i++)
+    {
+        if (m_pEntries[i].isReadable)
+            initSortKey(&pKeys[keyCount++], &m_pEntries[i].signature, m_bucketDepth, i);
+    }
+    /* Entry indices break ties so the first key of each run of matching signatures is the first dump added. */
+    qsort(pKeys, keyCount, sizeof(*pKeys), compareSortKeys);
+    for (i = 0 ; i < keyCount ; i++)
+    {
+        if (i == 0 || compareSignatures(&pKeys[i - 1], &pKeys[i]) != 0)
+        {
+            m_pBuckets[m_bucketCount].firstEntry = pKeys[i].entryIndex;
+            m_pBuckets[m_bucketCount].dumpCount = 0;
+            m_bucketCount++;
+        }
+        m_pBuckets[m_bucketCount - 1].dumpCount++;
+    }
+    qsort(m_pBuckets, m_bucketCount, sizeof(*m_pBuckets), compareBuckets);
+    free(pKeys);
+    return true;
+}
+
+static void initSortKey(SortKey* pKey, const CrashSignature* pSignature, size_t bucketDepth, size_t entryIndex)
+{
+    size_t i;
+
+    memset(pKey, 0, sizeof(*pKey));
+    pKey->pc = pSignature->pc;
+    pKey->lr = pSignature->lr;
+    pKey->cfsr = pSignature->cfsr;
+    pKey->hfsr = pSignature->hfsr;
+    pKey->returnAddressCount = pSignature->returnAddressCount < bucketDepth ?
+                               pSignature->returnAddressCount : bucketDepth;
+    for (i = 0 ; i < pKey->returnAddressCount ; i++)
+        pKey->returnAddresses[i] = pSignature->returnAddresses[i];
+    pKey->entryIndex = entryIndex;
+}
+
+static int compareSignatures(const SortKey* pKey1, const SortKey* pKey2)
+{
+    int    result;
+    size_t i;
+
+    if ((result = compareValues(pKey1->pc, pKey2->pc)) != 0 ||
+        (result = compareValues(pKey1->lr, pKey2->lr)) != 0 ||
+        (result = compareValues(pKey1->cfsr, pKey2->cfsr)) != 0 ||
+        (result = compareValues(pKey1->hfsr, pKey2->hfsr)) != 0 ||
+        (result = compareValues(pKey1->returnAddressCount, pKey2->returnAddressCount)) != 0)
+    {
+        return result;
+    }
+    for (i = 0 ; i < pKey1->returnAddressCount ; i++)
+    {
+        if ((result = compareValues(pKey1->returnAddresses[i], pKey2->returnAddresses[i])) != 0)
+            return result;
+    }
+    return 0;
+}
+
+static int compareValues(size_t value1, size_t value2)
+{
+    if (value1 == value2)
+        return 0;
+    return value1 < value2 ? -1 : 1;
+}
+
+static int compareSortKeys(const void* pv1, const void* pv2)
+{
+    const SortKey* pKey1 = (const SortKey*)pv1;
+    const SortKey* pKey2 = (const SortKey*)pv2;
+    int            result = compareSignatures(pKey1, pKey2);
+
+    return result != 0 ? result : compareValues(pKey1->entryIndex, pKey2->entryIndex);
+}
+
+static int compareBuckets(const void* pv1, const void* pv2)
+{
+    const DumpTriage::Bucket* pBucket1 = (const DumpTriage::Bucket*)pv1;
+    const DumpTriage::Bucket* pBucket2 = (const DumpTriage::Bucket*)pv2;
+
+    /* Most dumps first. */
+    if (pBucket1->dumpCount != pBucket2->dumpCount)
+        return compareValues(pBucket2->dumpCount, pBucket1->dumpCount);
+    return compareValues(pBucket1->firstEntry, pBucket2->firstEntry);
+}
+
+
+size_t DumpTriage::entryCount() const
+{
+    return m_entryCount;
+}
+
+const DumpTriage::Entry& DumpTriage::entry(size_t index) const
+{
+    return m_pEntries[index];
+}
+
+size_t DumpTriage::unreadableCount() const
+{
+    return m_unreadableCount;
+}
+
+size_t DumpTriage::bucketCount() const
+{
+    return m_bucketCount;
+}
+
+const DumpTriage::Bucket& DumpTriage::bucket(size_t index) const
+{
+    return m_pBuckets[index];
+}
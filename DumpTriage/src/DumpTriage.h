@@ -0,0 +1,108 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Host side triage which reads a batch of dumps on a pool of threads, pulls a crash signature out of each one and
+   groups the dumps with matching signatures into buckets ranked by how often they occurred. */
+#ifndef _DUMP_TRIAGE_H_
+#define _DUMP_TRIAGE_H_
+
+#include <DumpReader.h>
+
+
+/* Registers and stacked return addresses which identify where and why a dump crashed. */
+struct CrashSignature
+{
+    enum { MAX_RETURN_ADDRESSES = 8 };
+
+    uint32_t pc;
+    uint32_t lr;
+    /* The FaultStatusRegisters block which the Core dumps at 0xE000ED28 on ARMv7-M.  They are all 0 when
+       hasFaultStatus is false. */
+    bool     hasFaultStatus;
+    uint32_t cfsr;
+    uint32_t hfsr;
+    uint32_t mmfar;
+    uint32_t bfar;
+    /* Words found on the stack, scanning up from the SP at the time of the crash, which look like Thumb return
+       addresses into the code range. */
+    uint32_t returnAddresses[MAX_RETURN_ADDRESSES];
+    size_t   returnAddressCount;
+};
+
+
+class DumpTriage
+{
+public:
+    struct Entry
+    {
+        char*              pFilename;
+        /* Result of parsing the dump.  Dumps which ended after their integer registers still have a signature. */
+        DumpReader::Result result;
+        bool               isReadable;
+        CrashSignature     signature;
+    };
+
+    struct Bucket
+    {
+        /* The first dump added to the bucket, whose signature is used to describe it. */
+        size_t firstEntry;
+        size_t dumpCount;
+    };
+
+    /* Return addresses are only taken from words which point into the code range from codeStart up to, but not
+       including, codeEnd.  Dumps are bucketed on their PC, LR, CFSR, HFSR and their first bucketDepth return
+       addresses.  MMFAR and BFAR are left out since the faulting data address often differs between occurrences. */
+    DumpTriage(uint32_t codeStart, uint32_t codeEnd, size_t bucketDepth);
+    ~DumpTriage();
+
+    /* Queues up a dump file to be read by run().  Returns false if memory ran out. */
+    bool          addFile(const char* pFilename);
+    /* Reads all of the queued dumps on up to threadCount threads and then buckets them.  Returns false if memory ran
+       out. */
+    bool          run(unsigned int threadCount);
+
+    /* Dumps in the order they were added. */
+    size_t        entryCount() const;
+    const Entry&  entry(size_t index) const;
+    /* Number of dumps which couldn't be read well enough to place them in a bucket. */
+    size_t        unreadableCount() const;
+    /* Buckets sorted from the most to the fewest dumps.  Ties are kept in the order of their first dump. */
+    size_t        bucketCount() const;
+    const Bucket& bucket(size_t index) const;
+
+    /* Fills in pSignature from a dump which has already been parsed by reader. */
+    static void   extractSignature(const DumpReader& reader, uint32_t codeStart, uint32_t codeEnd,
+                                   CrashSignature* pSignature);
+
+private:
+    /* Copying would free the filenames twice. */
+    DumpTriage(const DumpTriage& other);
+    DumpTriage& operator=(const DumpTriage& other);
+
+    static void readEntry(void* pvTriage, size_t index);
+    bool        createBuckets();
+
+    uint32_t m_codeStart;
+    uint32_t m_codeEnd;
+    size_t   m_bucketDepth;
+    Entry*   m_pEntries;
+    size_t   m_entryCount;
+    size_t   m_allocatedEntries;
+    size_t   m_unreadableCount;
+    Bucket*  m_pBuckets;
+    size_t   m_bucketCount;
+};
+
+
+#endif /* _DUMP_TRIAGE_H_ */
@@ -0,0 +1,186 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Each thread owns a queue holding a contiguous range of item indices.  The owner takes items from the front of its
+   range and thieves take from the back so a steal only needs to move the end of the range. */
+#ifndef _WIN32
+    #include <pthread.h>
+#endif
+#include "WorkStealingPool.h"
+
+
+#ifdef _WIN32
+void WorkStealingPool::run(size_t itemCount, unsigned int threadCount, WorkFunc work, void* pContext)
+{
+    size_t i;
+
+    for (i = 0 ; i < itemCount ; i++)
+        work(pContext, i);
+}
+#else
+struct Queue
+{
+    pthread_mutex_t mutex;
+    size_t          next;
+    size_t          end;
+};
+
+struct Pool
+{
+    Queue                      queues[WorkStealingPool::MAX_THREADS];
+    unsigned int               threadCount;
+    WorkStealingPool::WorkFunc work;
+    void*                      pContext;
+};
+
+struct Worker
+{
+    Pool*        pPool;
+    unsigned int index;
+};
+
+
+static void*  threadMain(void* pvWorker);
+static void   runWorker(Pool* pPool, unsigned int index);
+static bool   takeItem(Queue* pQueue, size_t* pItem);
+static bool   stealItems(Pool* pPool, unsigned int thiefIndex);
+static size_t itemsLeft(Queue* pQueue);
+
+
+void WorkStealingPool::run(size_t itemCount, unsigned int threadCount, WorkFunc work, void* pContext)
+{
+    Pool         pool;
+    Worker       workers[MAX_THREADS];
+    pthread_t    threads[MAX_THREADS];
+    unsigned int startedCount;
+    unsigned int i;
+
+    if (threadCount > itemCount)
+        threadCount = itemCount;
+    if (threadCount > MAX_THREADS)
+        threadCount = MAX_THREADS;
+    if (threadCount == 0)
+        threadCount = 1;
+    pool.threadCount = threadCount;
+    pool.work = work;
+    pool.pContext = pContext;
+    for (i = 0 ; i < threadCount ; i++)
+    {
+        pthread_mutex_init(&pool.queues[i].mutex, NULL);
+        pool.queues[i].next = itemCount * i / threadCount;
+        pool.queues[i].end = itemCount * (i + 1) / threadCount;
+    }
+
+    /* The items of any threads which fail to start are left in their queues for the others to steal. */
+    for (startedCount = 1 ; startedCount < threadCount ; startedCount++)
+    {
+        workers[startedCount].pPool = &pool;
+        workers[startedCount].index = startedCount;
+        if (pthread_create(&threads[startedCount], NULL, threadMain, &workers[startedCount]) != 0)
+            break;
+    }
+    runWorker(&pool, 0);
+    for (i = 1 ; i < startedCount ; i++)
+        pthread_join(threads[i], NULL);
+    for (i = 0 ; i < threadCount ; i++)
+        pthread_mutex_destroy(&pool.queues[i].mutex);
+}
+
+static void* threadMain(void* pvWorker)
+{
+    Worker* pWorker = (Worker*)pvWorker;
+
+    runWorker(pWorker->pPool, pWorker->index);
+    return NULL;
+}
+
+static void runWorker(Pool* pPool, unsigned int index)
+{
+    Queue* pQueue = &pPool->queues[index];
+    size_t item;
+
+    do
+    {
+        while (takeItem(pQueue, &item))
+            pPool->work(pPool->pContext, item);
+    } while (stealItems(pPool, index));
+}
+
+static bool takeItem(Queue* pQueue, size_t* pItem)
+{
+    bool isTaken = false;
+
+    pthread_mutex_lock(&pQueue->mutex);
+    if (pQueue->next < pQueue->end)
+    {
+        *pItem = pQueue->next++;
+        isTaken = true;
+    }
+    pthread_mutex_unlock(&pQueue->mutex);
+    return isTaken;
+}
+
+static bool stealItems(Pool* pPool, unsigned int thiefIndex)
+{
+    Queue* pThief = &pPool->queues[thiefIndex];
+
+    /* Items are never added to the queues so once they are all empty, the only items left are already running. */
+    for (;;)
+    {
+        Queue*       pVictim = NULL;
+        size_t       mostItems = 0;
+        size_t       stealCount;
+        size_t       stealStart;
+        unsigned int i;
+
+        for (i = 0 ; i < pPool->threadCount ; i++)
+        {
+            size_t count = i == thiefIndex ? 0 : itemsLeft(&pPool->queues[i]);
+
+            if (count > mostItems)
+            {
+                mostItems = count;
+                pVictim = &pPool->queues[i];
+            }
+        }
+        if (!pVictim)
+            return false;
+
+        pthread_mutex_lock(&pVictim->mutex);
+        stealCount = (pVictim->end - pVictim->next + 1) / 2;
+        pVictim->end -= stealCount;
+        stealStart = pVictim->end;
+        pthread_mutex_unlock(&pVictim->mutex);
+
+        /* The victim may have emptied its queue since it was picked so look for another one. */
+        if (stealCount == 0)
+            continue;
+        pthread_mutex_lock(&pThief->mutex);
+        pThief->next = stealStart;
+        pThief->end = stealStart + stealCount;
+        pthread_mutex_unlock(&pThief->mutex);
+        return true;
+    }
+}
+
+static size_t itemsLeft(Queue* pQueue)
+{
+    size_t count;
+
+    pthread_mutex_lock(&pQueue->mutex);
+    count = pQueue->end - pQueue->next;
+    pthread_mutex_unlock(&pQueue->mutex);
+    return count;
+}
+#endif
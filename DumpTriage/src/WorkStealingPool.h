@@ -0,0 +1,39 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Small pool of threads which run a work function over a range of item indices and steal from each other to balance
+   the load when some items take much longer than others. */
+#ifndef _WORK_STEALING_POOL_H_
+#define _WORK_STEALING_POOL_H_
+
+#include <stddef.h>
+
+
+class WorkStealingPool
+{
+public:
+    typedef void (*WorkFunc)(void* pContext, size_t item);
+
+    /* Upper limit on the number of threads which run() will use. */
+    enum { MAX_THREADS = 64 };
+
+    /* Calls work(pContext, item) once for each item from 0 to itemCount - 1, spread across up to threadCount threads,
+       and returns once they have all completed.  The calling thread is one of the threads.  Each thread starts with an
+       equal share of the items, works through them in order and, once it runs out, steals the back half of the items
+       left to the thread with the most of them.  Builds without POSIX threads run every item on the calling thread. */
+    static void run(size_t itemCount, unsigned int threadCount, WorkFunc work, void* pContext);
+};
+
+
+#endif /* _WORK_STEALING_POOL_H_ */
@@ -0,0 +1,303 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+// Include headers from modules under test.
+extern "C"
+{
+    #include <CrashCatcher.h>
+}
+#include <DumpTriage.h>
+
+// Include C++ headers for test harness.
+#include <CppUTest/TestHarness.h>
+
+
+#define CODE_START          0x08000000
+#define CODE_END            0x08100000
+#define STACK_ADDRESS       0x20001000
+#define FAULT_STATUS        0xE000ED28
+#define MAX_TEMP_FILES      8
+
+
+TEST_GROUP(DumpTriage)
+{
+    // Dumps are built up in this buffer by the tests, in the same format as generated by the Core.
+    uint8_t    m_dump[8192];
+    size_t     m_size;
+    DumpReader m_reader;
+    char       m_filenames[MAX_TEMP_FILES][32];
+    size_t     m_fileCount;
+
+    void setup()
+    {
+        m_size = 0;
+        m_fileCount = 0;
+    }
+
+    void teardown()
+    {
+        m_reader.close();
+        for (size_t i = 0 ; i < m_fileCount ; i++)
+            remove(m_filenames[i]);
+    }
+
+    void appendByte(uint8_t byte)
+    {
+        CHECK_TRUE(m_size < sizeof(m_dump));
+        m_dump[m_size++] = byte;
+    }
+
+    void appendWord(uint32_t word)
+    {
+        appendByte(word & 0xFF);
+        appendByte((word >> 8) & 0xFF);
+        appendByte((word >> 16) & 0xFF);
+        appendByte(word >> 24);
+    }
+
+    void startDump(uint32_t pc, uint32_t lr)
+    {
+        m_size = 0;
+        appendByte(CRASH_CATCHER_SIGNATURE_BYTE0);
+        appendByte(CRASH_CATCHER_SIGNATURE_BYTE1);
+        appendByte(CRASH_CATCHER_VERSION_MAJOR);
+        appendByte(CRASH_CATCHER_VERSION_MINOR);
+        appendWord(0);
+        for (uint32_t i = 0 ; i < DumpReader::INTEGER_REGISTER_COUNT ; i++)
+        {
+            if (i == DumpReader::SP)
+                appendWord(STACK_ADDRESS);
+            else if (i == DumpReader::LR)
+                appendWord(lr);
+            else if (i == DumpReader::PC)
+                appendWord(pc);
+            else
+                appendWord(i);
+        }
+    }
+
+    void appendStack(const uint32_t* pWords, size_t wordCount)
+    {
+        appendWord(STACK_ADDRESS);
+        appendWord(STACK_ADDRESS + wordCount * sizeof(uint32_t));
+        for (size_t i = 0 ; i < wordCount ; i++)
+            appendWord(pWords[i]);
+    }
+
+    void appendFaultStatus(uint32_t cfsr, uint32_t hfsr, uint32_t mmfar, uint32_t bfar)
+    {
+        appendWord(FAULT_STATUS);
+        appendWord(FAULT_STATUS + 5 * sizeof(uint32_t));
+        appendWord(cfsr);
+        appendWord(hfsr);
+        appendWord(0);
+        appendWord(mmfar);
+        appendWord(bfar);
+    }
+
+    void extract(CrashSignature* pSignature)
+    {
+        CHECK_EQUAL(DumpReader::OK, m_reader.parse(m_dump, m_size));
+        DumpTriage::extractSignature(m_reader, CODE_START, CODE_END, pSignature);
+    }
+
+    // Writes out a dump which faulted at pc with the given CFSR and the given return address at the top of the stack.
+    const char* writeDump(uint32_t pc, uint32_t cfsr, uint32_t returnAddress, uint32_t bfar = 0)
+    {
+        uint32_t stack[] = { 0x20000100, returnAddress, 0x00000000 };
+
+        startDump(pc, 0x08000101);
+        appendStack(stack, sizeof(stack) / sizeof(stack[0]));
+        appendFaultStatus(cfsr, 0x40000000, 0, bfar);
+        return writeFile(m_dump, m_size);
+    }
+
+    const char* writeFile(const void* pData, size_t size)
+    {
+        char* pFilename = m_filenames[m_fileCount];
+        FILE* pFile;
+
+        CHECK_TRUE(m_fileCount < MAX_TEMP_FILES);
+        sprintf(pFilename, "DumpTriageTests%u.dmp", (unsigned)m_fileCount++);
+        pFile = fopen(pFilename, "wb");
+        CHECK_TRUE(pFile != NULL);
+        CHECK_EQUAL(size, fwrite(pData, 1, size, pFile));
+        fclose(pFile);
+        return pFilename;
+    }
+
+    void validateBucket(const DumpTriage& triage, size_t index, size_t expectedDumpCount, size_t expectedFirstEntry)
+    {
+        CHECK_TRUE(index < triage.bucketCount());
+        CHECK_EQUAL(expectedDumpCount, triage.bucket(index).dumpCount);
+        CHECK_EQUAL(expectedFirstEntry, triage.bucket(index).firstEntry);
+    }
+};
+
+
+TEST(DumpTriage, ExtractFromRegistersOnly_ShouldReturnPcAndLrWithoutFaultStatus)
+{
+    CrashSignature signature;
+
+    startDump(0x08001234, 0x08000101);
+    extract(&signature);
+    CHECK_EQUAL(0x08001234, signature.pc);
+    CHECK_EQUAL(0x08000101, signature.lr);
+    CHECK_FALSE(signature.hasFaultStatus);
+    CHECK_EQUAL(0, signature.cfsr);
+    CHECK_EQUAL(0, signature.returnAddressCount);
+}
+
+TEST(DumpTriage, ExtractWithFaultStatusRegisters_ShouldReturnThem)
+{
+    CrashSignature signature;
+
+    startDump(0x08001234, 0x08000101);
+    appendFaultStatus(0x00008200, 0x40000000, 0x11111111, 0x22222222);
+    extract(&signature);
+    CHECK_TRUE(signature.hasFaultStatus);
+    CHECK_EQUAL(0x00008200, signature.cfsr);
+    CHECK_EQUAL(0x40000000, signature.hfsr);
+    CHECK_EQUAL(0x11111111, signature.mmfar);
+    CHECK_EQUAL(0x22222222, signature.bfar);
+}
+
+TEST(DumpTriage, ExtractFromStack_ShouldOnlyKeepOddWordsInCodeRange)
+{
+    static const uint32_t stack[] = { 0x08000200, 0x08000201, 0x20000101, 0x07FFFFFF, 0x080FFFFF, 0x08100001,
+                                      0xFFFFFFF9, 0x08000301 };
+    CrashSignature        signature;
+
+    startDump(0x08001234, 0x08000101);
+    appendStack(stack, sizeof(stack) / sizeof(stack[0]));
+    extract(&signature);
+    CHECK_EQUAL(3, signature.returnAddressCount);
+    CHECK_EQUAL(0x08000201, signature.returnAddresses[0]);
+    CHECK_EQUAL(0x080FFFFF, signature.returnAddresses[1]);
+    CHECK_EQUAL(0x08000301, signature.returnAddresses[2]);
+}
+
+TEST(DumpTriage, ExtractFromDeepStack_ShouldStopAtMaxReturnAddresses)
+{
+    uint32_t       stack[CrashSignature::MAX_RETURN_ADDRESSES + 4];
+    CrashSignature signature;
+
+    for (size_t i = 0 ; i < sizeof(stack) / sizeof(stack[0]) ; i++)
+        stack[i] = CODE_START + 0x100 * i + 1;
+    startDump(0x08001234, 0x08000101);
+    appendStack(stack, sizeof(stack) / sizeof(stack[0]));
+    extract(&signature);
+    CHECK_EQUAL(CrashSignature::MAX_RETURN_ADDRESSES, signature.returnAddressCount);
+    CHECK_EQUAL(stack[CrashSignature::MAX_RETURN_ADDRESSES - 1],
+                signature.returnAddresses[CrashSignature::MAX_RETURN_ADDRESSES - 1]);
+}
+
+TEST(DumpTriage, NoFiles_ShouldHaveNoBuckets)
+{
+    DumpTriage triage(CODE_START, CODE_END, 1);
+
+    CHECK_TRUE(triage.run(4));
+    CHECK_EQUAL(0, triage.entryCount());
+    CHECK_EQUAL(0, triage.unreadableCount());
+    CHECK_EQUAL(0, triage.bucketCount());
+}
+
+TEST(DumpTriage, DumpsWithMatchingSignatures_ShouldBeBucketedByFrequency)
+{
+    DumpTriage triage(CODE_START, CODE_END, 1);
+
+    CHECK_TRUE(triage.addFile(writeDump(0x08002000, 0x00000400, 0x08000401)));
+    CHECK_TRUE(triage.addFile(writeDump(0x08001000, 0x00008200, 0x08000501, 0x20000004)));
+    CHECK_TRUE(triage.addFile(writeDump(0x08001000, 0x00008200, 0x08000501, 0x20000008)));
+    CHECK_TRUE(triage.addFile(writeDump(0x08001000, 0x00000001, 0x08000501)));
+    CHECK_TRUE(triage.addFile(writeDump(0x08001000, 0x00008200, 0x08000501, 0x2000000C)));
+    CHECK_TRUE(triage.run(4));
+
+    CHECK_EQUAL(5, triage.entryCount());
+    CHECK_EQUAL(0, triage.unreadableCount());
+    CHECK_EQUAL(3, triage.bucketCount());
+    validateBucket(triage, 0, 3, 1);
+    validateBucket(triage, 1, 1, 0);
+    validateBucket(triage, 2, 1, 3);
+    CHECK_EQUAL(0x20000004, triage.entry(1).signature.bfar);
+    STRCMP_EQUAL("DumpTriageTests1.dmp", triage.entry(1).pFilename);
+}
+
+TEST(DumpTriage, DifferentReturnAddresses_ShouldOnlySplitBucketsWhenWithinDepth)
+{
+    DumpTriage shallowTriage(CODE_START, CODE_END, 0);
+    DumpTriage deepTriage(CODE_START, CODE_END, 1);
+    const char* pDump1 = writeDump(0x08001000, 0x00008200, 0x08000501);
+    const char* pDump2 = writeDump(0x08001000, 0x00008200, 0x08000601);
+
+    CHECK_TRUE(shallowTriage.addFile(pDump1));
+    CHECK_TRUE(shallowTriage.addFile(pDump2));
+    CHECK_TRUE(shallowTriage.run(2));
+    CHECK_EQUAL(1, shallowTriage.bucketCount());
+    validateBucket(shallowTriage, 0, 2, 0);
+
+    CHECK_TRUE(deepTriage.addFile(pDump1));
+    CHECK_TRUE(deepTriage.addFile(pDump2));
+    CHECK_TRUE(deepTriage.run(2));
+    CHECK_EQUAL(2, deepTriage.bucketCount());
+}
+
+TEST(DumpTriage, UnreadableDumps_ShouldBeCountedButNotBucketed)
+{
+    static const char notADump[] = "Not a dump";
+    DumpTriage        triage(CODE_START, CODE_END, 1);
+
+    CHECK_TRUE(triage.addFile(writeFile(notADump, sizeof(notADump))));
+    CHECK_TRUE(triage.addFile("DumpTriageTestsMissing.dmp"));
+    CHECK_TRUE(triage.addFile(writeDump(0x08001000, 0x00008200, 0x08000501)));
+    CHECK_TRUE(triage.run(3));
+
+    CHECK_EQUAL(3, triage.entryCount());
+    CHECK_EQUAL(2, triage.unreadableCount());
+    CHECK_FALSE(triage.entry(0).isReadable);
+    CHECK_EQUAL(DumpReader::BAD_SIGNATURE, triage.entry(0).result);
+    CHECK_EQUAL(DumpReader::OPEN_FAILED, triage.entry(1).result);
+    CHECK_EQUAL(1, triage.bucketCount());
+    validateBucket(triage, 0, 1, 2);
+}
+
+TEST(DumpTriage, DumpTruncatedAfterRegisters_ShouldStillBeBucketed)
+{
+    DumpTriage triage(CODE_START, CODE_END, 1);
+
+    startDump(0x08001000, 0x08000101);
+    appendWord(STACK_ADDRESS);
+    CHECK_TRUE(triage.addFile(writeFile(m_dump, m_size)));
+    CHECK_TRUE(triage.run(1));
+    CHECK_EQUAL(DumpReader::TRUNCATED, triage.entry(0).result);
+    CHECK_EQUAL(0, triage.unreadableCount());
+    CHECK_EQUAL(1, triage.bucketCount());
+}
+
+TEST(DumpTriage, RunTwice_ShouldRebuildSameBuckets)
+{
+    DumpTriage triage(CODE_START, CODE_END, 1);
+
+    CHECK_TRUE(triage.addFile(writeDump(0x08001000, 0x00008200, 0x08000501)));
+    CHECK_TRUE(triage.addFile(writeDump(0x08002000, 0x00008200, 0x08000501)));
+    CHECK_TRUE(triage.run(1));
+    CHECK_TRUE(triage.run(8));
+    CHECK_EQUAL(2, triage.bucketCount());
+    validateBucket(triage, 0, 1, 0);
+    validateBucket(triage, 1, 1, 1);
+}
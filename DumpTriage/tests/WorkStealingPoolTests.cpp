@@ -0,0 +1,123 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+
+// Include headers from modules under test.
+#include <WorkStealingPool.h>
+
+// Include C++ headers for test harness.
+#include <CppUTest/TestHarness.h>
+
+
+#define MAX_ITEMS 1000
+
+
+// Each item only ever writes to its own slot so the threads don't need to synchronise to record their work.
+struct Work
+{
+    uint8_t   callCounts[MAX_ITEMS];
+    pthread_t threads[MAX_ITEMS];
+    size_t    slowItemCount;
+};
+
+
+static void recordItem(void* pvWork, size_t item)
+{
+    Work* pWork = (Work*)pvWork;
+
+    if (item < pWork->slowItemCount)
+        usleep(2000);
+    pWork->callCounts[item]++;
+    pWork->threads[item] = pthread_self();
+}
+
+
+TEST_GROUP(WorkStealingPool)
+{
+    Work m_work;
+
+    void setup()
+    {
+        memset(&m_work, 0, sizeof(m_work));
+    }
+
+    void teardown()
+    {
+    }
+
+    void validateEachItemCalledOnce(size_t itemCount)
+    {
+        for (size_t i = 0 ; i < MAX_ITEMS ; i++)
+            CHECK_EQUAL(i < itemCount ? 1 : 0, m_work.callCounts[i]);
+    }
+};
+
+
+TEST(WorkStealingPool, NoItems_ShouldNeverCallWork)
+{
+    WorkStealingPool::run(0, 4, recordItem, &m_work);
+    validateEachItemCalledOnce(0);
+}
+
+TEST(WorkStealingPool, SingleThread_ShouldRunEveryItemInOrderOnCallingThread)
+{
+    WorkStealingPool::run(10, 1, recordItem, &m_work);
+    validateEachItemCalledOnce(10);
+    for (size_t i = 0 ; i < 10 ; i++)
+        CHECK_TRUE(pthread_equal(pthread_self(), m_work.threads[i]));
+}
+
+TEST(WorkStealingPool, ZeroThreads_ShouldStillRunEveryItemOnCallingThread)
+{
+    WorkStealingPool::run(3, 0, recordItem, &m_work);
+    validateEachItemCalledOnce(3);
+}
+
+TEST(WorkStealingPool, VariousItemAndThreadCounts_ShouldRunEveryItemExactlyOnce)
+{
+    static const size_t       itemCounts[] = { 1, 2, 7, 64, 999, MAX_ITEMS };
+    static const unsigned int threadCounts[] = { 2, 3, 8, WorkStealingPool::MAX_THREADS, 1000 };
+
+    for (size_t i = 0 ; i < sizeof(itemCounts) / sizeof(itemCounts[0]) ; i++)
+    {
+        for (size_t j = 0 ; j < sizeof(threadCounts) / sizeof(threadCounts[0]) ; j++)
+        {
+            memset(&m_work, 0, sizeof(m_work));
+            WorkStealingPool::run(itemCounts[i], threadCounts[j], recordItem, &m_work);
+            validateEachItemCalledOnce(itemCounts[i]);
+        }
+    }
+}
+
+TEST(WorkStealingPool, SlowItemsAtStart_ShouldBeStolenFromCallingThread)
+{
+    size_t stolenCount = 0;
+
+    // The calling thread starts out with the first quarter of the items, which are the only slow ones, so the other
+    // threads run out of work long before it does and steal some of them.
+    m_work.slowItemCount = 25;
+    WorkStealingPool::run(100, 4, recordItem, &m_work);
+    validateEachItemCalledOnce(100);
+    for (size_t i = 0 ; i < m_work.slowItemCount ; i++)
+    {
+        if (!pthread_equal(pthread_self(), m_work.threads[i]))
+            stolenCount++;
+    }
+    CHECK_TRUE(stolenCount > 0);
+    CHECK_TRUE(pthread_equal(pthread_self(), m_work.threads[0]));
+}
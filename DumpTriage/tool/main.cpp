@@ -0,0 +1,308 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Command line front end for DumpTriage.
+   Usage: CrashCatcherTriage [-j threads] [-d depth] [-n buckets] [-c codeStart-codeEnd] dumpFileOrDirectory...
+   Every file found in the listed directories is read as a dump and the buckets of matching crash signatures are
+   printed from the most to the least common. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <DumpTriage.h>
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <dirent.h>
+    #include <unistd.h>
+#endif
+
+
+/* Cortex-M code region which holds the flash of most parts. */
+#define DEFAULT_CODE_START      0x00000000
+#define DEFAULT_CODE_END        0x20000000
+#define DEFAULT_BUCKET_DEPTH    2
+
+
+struct FileList
+{
+    char** ppFilenames;
+    size_t count;
+    size_t allocated;
+};
+
+
+static unsigned int defaultThreadCount();
+static bool         parseCodeRange(const char* pRange, uint32_t* pStart, uint32_t* pEnd);
+static bool         addPath(FileList* pList, const char* pPath);
+static bool         addDirectory(FileList* pList, const char* pDirectory);
+static bool         addFilename(FileList* pList, const char* pDirectory, const char* pFilename);
+static int          compareFilenames(const void* pv1, const void* pv2);
+static void         freeFileList(FileList* pList);
+static void         printUnreadableDumps(const DumpTriage& triage);
+static const char*  resultString(DumpReader::Result result);
+static void         printBuckets(const DumpTriage& triage, size_t maxBuckets, size_t bucketDepth);
+
+
+int main(int argc, char** argv)
+{
+    FileList     files = { NULL, 0, 0 };
+    unsigned int threadCount = defaultThreadCount();
+    size_t       bucketDepth = DEFAULT_BUCKET_DEPTH;
+    size_t       maxBuckets = ~(size_t)0;
+    uint32_t     codeStart = DEFAULT_CODE_START;
+    uint32_t     codeEnd = DEFAULT_CODE_END;
+    bool         isValid = true;
+    int          argIndex = 1;
+    size_t       i;
+
+    while (argIndex + 1 < argc && argv[argIndex][0] == '-')
+    {
+        const char* pOption = argv[argIndex];
+        const char* pValue = argv[argIndex + 1];
+
+        if (strcmp(pOption, "-j") == 0)
+            threadCount = strtoul(pValue, NULL, 10);
+        else if (strcmp(pOption, "-d") == 0)
+            bucketDepth = strtoul(pValue, NULL, 10);
+        else if (strcmp(pOption, "-n") == 0)
+            maxBuckets = strtoul(pValue, NULL, 10);
+        else if (strcmp(pOption, "-c") == 0)
+            isValid = parseCodeRange(pValue, &codeStart, &codeEnd);
+        else
+            isValid = false;
+        argIndex += 2;
+    }
+    if (argIndex >= argc || !isValid || threadCount == 0 || bucketDepth > CrashSignature::MAX_RETURN_ADDRESSES)
+    {
+        fprintf(stderr, "Usage: %s [-j threads] [-d depth] [-n buckets] [-c codeStart-codeEnd] "
+                        "dumpFileOrDirectory...\n", argv[0]);
+        return 2;
+    }
+
+    for ( ; argIndex < argc ; argIndex++)
+    {
+        if (!addPath(&files, argv[argIndex]))
+        {
+            freeFileList(&files);
+            return 1;
+        }
+    }
+    /* Directory listings come back in no particular order so sort them to keep the output stable between runs. */
+    qsort(files.ppFilenames, files.count, sizeof(*files.ppFilenames), compareFilenames);
+
+    DumpTriage triage(codeStart, codeEnd, bucketDepth);
+    for (i = 0 ; i < files.count && isValid ; i++)
+        isValid = triage.addFile(files.ppFilenames[i]);
+    freeFileList(&files);
+    if (!isValid || !triage.run(threadCount))
+    {
+        fprintf(stderr, "%s: out of memory\n", argv[0]);
+        return 1;
+    }
+
+    printUnreadableDumps(triage);
+    printf("%u dumps, %u unreadable, %u buckets\n\n",
+           (unsigned)triage.entryCount(), (unsigned)triage.unreadableCount(), (unsigned)triage.bucketCount());
+    printBuckets(triage, maxBuckets, bucketDepth);
+    return triage.bucketCount() > 0 ? 0 : 1;
+}
+
+static bool parseCodeRange(const char* pRange, uint32_t* pStart, uint32_t* pEnd)
+{
+    char* pDash;
+    char* pEndOfRange;
+
+    *pStart = strtoul(pRange, &pDash, 16);
+    if (pDash == pRange || *pDash != '-')
+        return false;
+    *pEnd = strtoul(pDash + 1, &pEndOfRange, 16);
+    return pEndOfRange != pDash + 1 && *pEndOfRange == '\0' && *pStart < *pEnd;
+}
+
+static bool addPath(FileList* pList, const char* pPath)
+{
+    struct stat pathStat;
+
+    if (stat(pPath, &pathStat) != 0)
+    {
+        perror(pPath);
+        return false;
+    }
+    if (S_ISDIR(pathStat.st_mode))
+        return addDirectory(pList, pPath);
+    return addFilename(pList, NULL, pPath);
+}
+
+#ifdef _WIN32
+static unsigned int defaultThreadCount()
+{
+    return 1;
+}
+
+static bool addDirectory(FileList* pList, const char* pDirectory)
+{
+    WIN32_FIND_DATAA findData;
+    HANDLE           findHandle;
+    char*            pPattern = (char*)malloc(strlen(pDirectory) + 3);
+    bool             isOk = true;
+
+    if (!pPattern)
+        return false;
+    sprintf(pPattern, "%s\\*", pDirectory);
+    findHandle = FindFirstFileA(pPattern, &findData);
+    free(pPattern);
+    if (findHandle == INVALID_HANDLE_VALUE)
+        return true;
+    do
+    {
+        if (!(findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
+            isOk = addFilename(pList, pDirectory, findData.cFileName);
+    } while (isOk && FindNextFileA(findHandle, &findData));
+    FindClose(findHandle);
+    return isOk;
+}
+#else
+static unsigned int defaultThreadCount()
+{
+    long processorCount = sysconf(_SC_NPROCESSORS_ONLN);
+
+    return processorCount > 0 ? processorCount : 1;
+}
+
+static bool addDirectory(FileList* pList, const char* pDirectory)
+{
+    DIR*           pDir = opendir(pDirectory);
+    struct dirent* pEntry;
+    bool           isOk = true;
+
+    if (!pDir)
+    {
+        perror(pDirectory);
+        return false;
+    }
+    /* Subdirectories and other hidden files are skipped. */
+    while (isOk && (pEntry = readdir(pDir)) != NULL)
+    {
+        if (pEntry->d_name[0] != '.' && pEntry->d_type != DT_DIR)
+            isOk = addFilename(pList, pDirectory, pEntry->d_name);
+    }
+    closedir(pDir);
+    return isOk;
+}
+#endif
+
+static bool addFilename(FileList* pList, const char* pDirectory, const char* pFilename)
+{
+    size_t size = (pDirectory ? strlen(pDirectory) + 1 : 0) + strlen(pFilename) + 1;
+    char*  pPath;
+
+    if (pList->count == pList->allocated)
+    {
+        size_t newAllocated = pList->allocated ? pList->allocated * 2 : 256;
+        char** ppNew = (char**)realloc(pList->ppFilenames, newAllocated * sizeof(*ppNew));
+
+        if (!ppNew)
+            return false;
+        pList->ppFilenames = ppNew;
+        pList->allocated = newAllocated;
+    }
+    pPath = (char*)malloc(size);
+    if (!pPath)
+        return false;
+    if (pDirectory)
+        sprintf(pPath, "%s/%s", pDirectory, pFilename);
+    else
+        strcpy(pPath, pFilename);
+    pList->ppFilenames[pList->count++] = pPath;
+    return true;
+}
+
+static int compareFilenames(const void* pv1, const void* pv2)
+{
+    return strcmp(*(char* const*)pv1, *(char* const*)pv2);
+}
+
+static void freeFileList(FileList* pList)
+{
+    size_t i;
+
+    for (i = 0 ; i < pList->count ; i++)
+        free(pList->ppFilenames[i]);
+    free(pList->ppFilenames);
+    pList->ppFilenames = NULL;
+    pList->count = 0;
+}
+
+static void printUnreadableDumps(const DumpTriage& triage)
+{
+    size_t i;
+
+    for (i = 0 ; i < triage.entryCount() ; i++)
+    {
+        const DumpTriage::Entry& entry = triage.entry(i);
+
+        if (!entry.isReadable)
+            fprintf(stderr, "%s: %s\n", entry.pFilename, resultString(entry.result));
+    }
+}
+
+static const char* resultString(DumpReader::Result result)
+{
+    switch (result)
+    {
+    case DumpReader::OK:
+        return "OK";
+    case DumpReader::OPEN_FAILED:
+        return "couldn't open dump";
+    case DumpReader::BAD_SIGNATURE:
+        return "not a CrashCatcher dump";
+    case DumpReader::TRUNCATED:
+        return "dump ended before its registers";
+    case DumpReader::MALFORMED:
+        return "malformed dump";
+    case DumpReader::OUT_OF_MEMORY:
+        return "out of memory";
+    }
+    return "unknown result";
+}
+
+static void printBuckets(const DumpTriage& triage, size_t maxBuckets, size_t bucketDepth)
+{
+    size_t readableCount = triage.entryCount() - triage.unreadableCount();
+    size_t i;
+    size_t j;
+
+    printf("  Count      %%  PC          LR          CFSR        HFSR        MMFAR       BFAR        "
+           "Return addresses / example dump\n");
+    for (i = 0 ; i < triage.bucketCount() && i < maxBuckets ; i++)
+    {
+        const DumpTriage::Bucket& bucket = triage.bucket(i);
+        const DumpTriage::Entry&  entry = triage.entry(bucket.firstEntry);
+        const CrashSignature&     signature = entry.signature;
+
+        printf("%7u %5.1f%%  0x%08X  0x%08X  ", (unsigned)bucket.dumpCount, 100.0 * bucket.dumpCount / readableCount,
+               signature.pc, signature.lr);
+        if (signature.hasFaultStatus)
+            printf("0x%08X  0x%08X  0x%08X  0x%08X  ",
+                   signature.cfsr, signature.hfsr, signature.mmfar, signature.bfar);
+        else
+            printf("%-10s  %-10s  %-10s  %-10s  ", "-", "-", "-", "-");
+        /* MMFAR and BFAR come from the example dump and can differ for the other dumps in the bucket.  Only the return
+           addresses which were used for bucketing are shown since they match for every dump in it. */
+        for (j = 0 ; j < signature.returnAddressCount && j < bucketDepth ; j++)
+            printf("0x%08X ", signature.returnAddresses[j]);
+        printf("%s\n", entry.pFilename);
+    }
+}
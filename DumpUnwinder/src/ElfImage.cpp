@@ -0,0 +1,332 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Only the ELF header and section headers are parsed.  Everything else is read in place from the mapped file. */
+#include <stdlib.h>
+#include <string.h>
+#ifdef _WIN32
+    #include <stdio.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+#include "ElfImage.h"
+
+
+/* Offsets of the ELF header fields which are used. */
+#define ELF_HEADER_SIZE         52
+#define EI_CLASS                4
+#define EI_DATA                 5
+#define E_MACHINE               18
+#define E_ENTRY                 24
+#define E_SHOFF                 32
+#define E_SHENTSIZE             46
+#define E_SHNUM                 48
+#define E_SHSTRNDX              50
+#define ELFCLASS32              1
+#define ELFDATA2LSB             1
+#define EM_ARM                  40
+
+/* Offsets of the section header fields which are used. */
+#define SECTION_HEADER_SIZE     40
+#define SH_NAME                 0
+#define SH_TYPE                 4
+#define SH_FLAGS                8
+#define SH_ADDR                 12
+#define SH_OFFSET               16
+#define SH_SIZE                 20
+#define SH_LINK                 24
+
+#define FNV_OFFSET_BASIS        0xCBF29CE484222325ULL
+#define FNV_PRIME               0x00000100000001B3ULL
+
+
+static uint16_t readUInt16(const uint8_t* pSrc);
+static uint32_t readUInt32(const uint8_t* pSrc);
+static uint64_t calculateFingerprint(const uint8_t* pData, size_t size);
+static bool     isRangeInFile(uint32_t offset, uint32_t size, size_t fileSize);
+
+
+ElfImage::ElfImage()
+{
+    m_pMapping = NULL;
+    m_mappingSize = 0;
+    m_pSections = NULL;
+    m_sectionCount = 0;
+    m_entryPoint = 0;
+    m_fingerprint = 0;
+}
+
+ElfImage::~ElfImage()
+{
+    close();
+}
+
+#ifdef _WIN32
+ElfImage::Result ElfImage::open(const char* pFilename)
+{
+    FILE* pFile;
+    long  size;
+
+    close();
+    pFile = fopen(pFilename, "rb");
+    if (!pFile || fseek(pFile, 0, SEEK_END) != 0 || (size = ftell(pFile)) < 0 || fseek(pFile, 0, SEEK_SET) != 0)
+    {
+        if (pFile)
+            fclose(pFile);
+        return OPEN_FAILED;
+    }
+    m_pMapping = malloc(size ? size : 1);
+    if (!m_pMapping || fread(m_pMapping, 1, size, pFile) != (size_t)size)
+    {
+        fclose(pFile);
+        close();
+        return OPEN_FAILED;
+    }
+    fclose(pFile);
+    m_mappingSize = size;
+    return parse((const uint8_t*)m_pMapping, m_mappingSize);
+}
+#else
+ElfImage::Result ElfImage::open(const char* pFilename)
+{
+    struct stat fileStat;
+    int         file;
+
+    close();
+    file = ::open(pFilename, O_RDONLY);
+    if (file < 0 || fstat(file, &fileStat) != 0)
+    {
+        if (file >= 0)
+            ::close(file);
+        return OPEN_FAILED;
+    }
+    /* mmap() fails for empty files so leave them unmapped and let parse() reject them. */
+    if (fileStat.st_size > 0)
+    {
+        void* pMapping = mmap(NULL, fileStat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+
+        if (pMapping == MAP_FAILED)
+        {
+            ::close(file);
+            return OPEN_FAILED;
+        }
+        m_pMapping = pMapping;
+        m_mappingSize = fileStat.st_size;
+    }
+    ::close(file);
+    return parse((const uint8_t*)m_pMapping, m_mappingSize);
+}
+#endif
+
+ElfImage::Result ElfImage::parse(const uint8_t* pElf, size_t elfSize)
+{
+    free(m_pSections);
+    m_pSections = NULL;
+    m_sectionCount = 0;
+    m_entryPoint = 0;
+    m_fingerprint = 0;
+
+    if (elfSize < ELF_HEADER_SIZE || memcmp(pElf, "\x7F" "ELF", 4) != 0 ||
+        pElf[EI_CLASS] != ELFCLASS32 || pElf[EI_DATA] != ELFDATA2LSB || readUInt16(&pElf[E_MACHINE]) != EM_ARM)
+    {
+        return BAD_HEADER;
+    }
+    m_entryPoint = readUInt32(&pElf[E_ENTRY]);
+    m_fingerprint = calculateFingerprint(pElf, elfSize);
+    return parseSections(pElf, elfSize);
+}
+
+ElfImage::Result ElfImage::parseSections(const uint8_t* pElf, size_t elfSize)
+{
+    uint32_t       sectionHeadersOffset = readUInt32(&pElf[E_SHOFF]);
+    uint16_t       sectionHeaderSize = readUInt16(&pElf[E_SHENTSIZE]);
+    uint16_t       sectionCount = readUInt16(&pElf[E_SHNUM]);
+    uint16_t       namesIndex = readUInt16(&pElf[E_SHSTRNDX]);
+    const uint8_t* pNamesHeader;
+    uint32_t       namesOffset;
+    uint32_t       namesSize;
+    size_t         i;
+
+    if (sectionCount == 0)
+        return OK;
+    if (sectionHeaderSize < SECTION_HEADER_SIZE || namesIndex >= sectionCount ||
+        !isRangeInFile(sectionHeadersOffset, (uint32_t)sectionCount * sectionHeaderSize, elfSize))
+    {
+        return MALFORMED;
+    }
+    pNamesHeader = pElf + sectionHeadersOffset + namesIndex * sectionHeaderSize;
+    namesOffset = readUInt32(&pNamesHeader[SH_OFFSET]);
+    namesSize = readUInt32(&pNamesHeader[SH_SIZE]);
+    /* Requiring the name table to end in a NUL means that no name can run off the end of it. */
+    if (namesSize == 0 || !isRangeInFile(namesOffset, namesSize, elfSize) || pElf[namesOffset + namesSize - 1] != '\0')
+        return MALFORMED;
+
+    m_pSections = (Section*)malloc(sectionCount * sizeof(*m_pSections));
+    if (!m_pSections)
+        return OUT_OF_MEMORY;
+    for (i = 0 ; i < sectionCount ; i++)
+    {
+        const uint8_t* pHeader = pElf + sectionHeadersOffset + i * sectionHeaderSize;
+        Section*       pSection = &m_pSections[i];
+        uint32_t       nameOffset = readUInt32(&pHeader[SH_NAME]);
+        uint32_t       offset = readUInt32(&pHeader[SH_OFFSET]);
+
+        pSection->type = readUInt32(&pHeader[SH_TYPE]);
+        pSection->flags = readUInt32(&pHeader[SH_FLAGS]);
+        pSection->address = readUInt32(&pHeader[SH_ADDR]);
+        pSection->size = readUInt32(&pHeader[SH_SIZE]);
+        pSection->link = readUInt32(&pHeader[SH_LINK]);
+        pSection->pData = NULL;
+        if (nameOffset >= namesSize)
+            return MALFORMED;
+        pSection->pName = (const char*)pElf + namesOffset + nameOffset;
+        if (pSection->type != SHT_NOBITS && i != 0)
+        {
+            if (!isRangeInFile(offset, pSection->size, elfSize))
+                return MALFORMED;
+            pSection->pData = pElf + offset;
+        }
+        m_sectionCount++;
+    }
+    return OK;
+}
+
+static uint16_t readUInt16(const uint8_t* pSrc)
+{
+    return pSrc[0] | (pSrc[1] << 8);
+}
+
+static uint32_t readUInt32(const uint8_t* pSrc)
+{
+    return pSrc[0] | (pSrc[1] << 8) | (pSrc[2] << 16) | ((uint32_t)pSrc[3] << 24);
+}
+
+static uint64_t calculateFingerprint(const uint8_t* pData, size_t size)
+{
+    uint64_t hash = FNV_OFFSET_BASIS;
+    size_t   i;
+
+    for (i = 0 ; i < size ; i++)
+    {
+        hash ^= pData[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+static bool isRangeInFile(uint32_t offset, uint32_t size, size_t fileSize)
+{
+    return offset <= fileSize && size <= fileSize - offset;
+}
+
+void ElfImage::close()
+{
+#ifdef _WIN32
+    free(m_pMapping);
+#else
+    if (m_pMapping)
+        munmap(m_pMapping, m_mappingSize);
+#endif
+    m_pMapping = NULL;
+    m_mappingSize = 0;
+    free(m_pSections);
+    m_pSections = NULL;
+    m_sectionCount = 0;
+    m_entryPoint = 0;
+    m_fingerprint = 0;
+}
+
+
+size_t ElfImage::sectionCount() const
+{
+    return m_sectionCount;
+}
+
+const ElfImage::Section& ElfImage::section(size_t index) const
+{
+    return m_pSections[index];
+}
+
+const ElfImage::Section* ElfImage::findSection(const char* pName) const
+{
+    size_t i;
+
+    for (i = 0 ; i < m_sectionCount ; i++)
+    {
+        if (strcmp(m_pSections[i].pName, pName) == 0)
+            return &m_pSections[i];
+    }
+    return NULL;
+}
+
+const ElfImage::Section* ElfImage::findSectionOfType(uint32_t type) const
+{
+    size_t i;
+
+    for (i = 0 ; i < m_sectionCount ; i++)
+    {
+        if (m_pSections[i].type == type)
+            return &m_pSections[i];
+    }
+    return NULL;
+}
+
+const uint8_t* ElfImage::findBytes(uint32_t address, uint32_t size) const
+{
+    size_t i;
+
+    /* Firmware images only have a handful of sections so a linear search is quick enough. */
+    for (i = 0 ; i < m_sectionCount ; i++)
+    {
+        const Section* pSection = &m_pSections[i];
+
+        if ((pSection->flags & SHF_ALLOC) && pSection->pData &&
+            address >= pSection->address && address - pSection->address <= pSection->size &&
+            size <= pSection->size - (address - pSection->address))
+        {
+            return pSection->pData + (address - pSection->address);
+        }
+    }
+    return NULL;
+}
+
+bool ElfImage::isCodeAddress(uint32_t address) const
+{
+    size_t i;
+
+    for (i = 0 ; i < m_sectionCount ; i++)
+    {
+        const Section* pSection = &m_pSections[i];
+
+        if ((pSection->flags & (SHF_ALLOC | SHF_EXECINSTR)) == (SHF_ALLOC | SHF_EXECINSTR) &&
+            address >= pSection->address && address - pSection->address < pSection->size)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint32_t ElfImage::entryPoint() const
+{
+    return m_entryPoint;
+}
+
+uint64_t ElfImage::fingerprint() const
+{
+    return m_fingerprint;
+}
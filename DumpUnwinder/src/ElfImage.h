@@ -0,0 +1,107 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Host side reader which memory maps the 32-bit little endian ARM ELF file of a firmware image so that its sections and
+   the code bytes at any address can be read in place. */
+#ifndef _ELF_IMAGE_H_
+#define _ELF_IMAGE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+class ElfImage
+{
+public:
+    enum Result
+    {
+        OK = 0,
+        /* The ELF file couldn't be opened or mapped. */
+        OPEN_FAILED,
+        /* The file isn't a 32-bit little endian ARM ELF file. */
+        BAD_HEADER,
+        /* A section header or section name points outside of the file. */
+        MALFORMED,
+        /* The section table couldn't be allocated. */
+        OUT_OF_MEMORY
+    };
+
+    /* Section types and flags used by the unwinder. */
+    enum
+    {
+        SHT_PROGBITS = 1,
+        SHT_SYMTAB = 2,
+        SHT_NOBITS = 8,
+        SHT_ARM_EXIDX = 0x70000001
+    };
+    enum
+    {
+        SHF_ALLOC = 0x2,
+        SHF_EXECINSTR = 0x4
+    };
+
+    struct Section
+    {
+        const char*    pName;
+        uint32_t       type;
+        uint32_t       flags;
+        uint32_t       address;
+        uint32_t       size;
+        uint32_t       link;
+        /* Points to the section's bytes in the mapped file.  NULL for SHT_NOBITS sections such as .bss. */
+        const uint8_t* pData;
+    };
+
+    ElfImage();
+    ~ElfImage();
+
+    /* Memory maps the ELF file and reads its section headers.  Any previously opened file is closed first. */
+    Result open(const char* pFilename);
+    /* Reads the section headers of the elfSize byte ELF file at pElf, which must remain valid until close() is
+       called. */
+    Result parse(const uint8_t* pElf, size_t elfSize);
+    void   close();
+
+    size_t         sectionCount() const;
+    const Section& section(size_t index) const;
+    /* Returns the first section with the given name or type, or NULL if there isn't one. */
+    const Section* findSection(const char* pName) const;
+    const Section* findSectionOfType(uint32_t type) const;
+    /* Returns a pointer straight into the mapped file for the size bytes at address, or NULL if they aren't all held
+       in a single allocated section with data, such as .text, .rodata or .ARM.extab. */
+    const uint8_t* findBytes(uint32_t address, uint32_t size) const;
+    /* Returns true if address is in an allocated section of executable code. */
+    bool           isCodeAddress(uint32_t address) const;
+    /* Address that the ELF file says execution starts at, which is normally the reset handler. */
+    uint32_t       entryPoint() const;
+    /* 64-bit FNV-1a hash of the whole file, which is used to tell whether a cached SymbolIndex was built from it. */
+    uint64_t       fingerprint() const;
+
+private:
+    /* Copying would leave two images owning the same mapping. */
+    ElfImage(const ElfImage& other);
+    ElfImage& operator=(const ElfImage& other);
+
+    Result parseSections(const uint8_t* pElf, size_t elfSize);
+
+    void*    m_pMapping;
+    size_t   m_mappingSize;
+    Section* m_pSections;
+    size_t   m_sectionCount;
+    uint32_t m_entryPoint;
+    uint64_t m_fingerprint;
+};
+
+
+#endif /* _ELF_IMAGE_H_ */
@@ -0,0 +1,766 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Each step of the unwind recovers the caller's SP, PC and callee saved registers from the current frame:
+   - If the code from the start of the function up to the PC only touches the stack through pushes and SP adjustments,
+     as is the case when the crash happened in the prologue or a leaf function, simulating those instructions is exact.
+   - Otherwise the function's .ARM.exidx entry is used, running its unwind instructions as described in the ARM
+     "Exception Handling ABI for the ARM Architecture" (EHABI).
+   - Functions without unwind tables fall back to the stack adjustments found in their prologue.
+   Return addresses which are EXC_RETURN values continue the unwind from the exception frame stacked by the
+   processor. */
+#include <string.h>
+#include "StackUnwinder.h"
+
+
+#define EXIDX_ENTRY_SIZE            8
+#define EXIDX_CANTUNWIND            1
+#define EHABI_COMPACT_MODEL         0x80000000
+/* Personality routine 0 has 3 instruction bytes and routines 1 and 2 can have up to 255 extra words of them. */
+#define MAX_OPCODE_BYTES            (3 + 255 * 4)
+
+/* Upper limit on the number of instructions simulated from the start of a function. */
+#define MAX_PROLOGUE_INSTRUCTIONS   32
+
+#define REGISTER_COUNT              16
+#define SP                          DumpReader::SP
+#define LR                          DumpReader::LR
+#define PC                          DumpReader::PC
+#define ALL_REGISTERS               0xFFFF
+/* R0-R3, R12 and LR aren't preserved across calls so their values in the caller can't be recovered. */
+#define CALLER_SAVED_REGISTERS      ((1 << 0) | (1 << 1) | (1 << 2) | (1 << 3) | (1 << 12) | (1 << LR))
+
+/* Cortex-M exception return values and the frame stacked on exception entry. */
+#define EXC_RETURN_MASK             0xFFFFFF00
+#define EXC_RETURN_PSP              (1 << 2)
+#define EXC_RETURN_BASIC_FRAME      (1 << 4)
+#define PSR_STACK_ALIGN             (1 << 9)
+#define BASIC_FRAME_WORDS           8
+#define EXTENDED_FRAME_EXTRA_WORDS  18
+#define STACKED_R12                 4
+#define STACKED_LR                  5
+#define STACKED_PC                  6
+#define STACKED_PSR                 7
+
+
+struct StackUnwinder::State
+{
+    uint32_t r[REGISTER_COUNT];
+    /* Bit for each register in r which holds a known value. */
+    uint32_t validMask;
+    /* The PC came from a return address, so the call instruction is just before it. */
+    bool     isReturnAddress;
+    /* The unwind has already switched from the main stack to the process stack. */
+    bool     isOnProcessStack;
+    uint32_t psp;
+};
+
+struct StackUnwinder::Prologue
+{
+    /* Bytes pushed onto the stack or subtracted from the SP by the instructions before the PC. */
+    uint32_t stackSize;
+    /* Registers pushed by those instructions and how far below the caller's SP each one was stored. */
+    uint32_t savedMask;
+    uint32_t savedOffsets[REGISTER_COUNT];
+    /* Every instruction before the PC was simulated without running into any branches or epilogue. */
+    bool     hasReachedPc;
+};
+
+
+static uint32_t readUInt32(const uint8_t* pSrc);
+static bool     readStackWord(const DumpReader& dump, uint32_t address, uint32_t* pValue);
+static uint32_t decodePrel31(uint32_t value, uint32_t place);
+static uint32_t countBits(uint32_t value);
+static bool     is32BitInstruction(uint16_t halfWord);
+static bool     endsPrologue16(uint16_t instruction);
+static bool     endsPrologue32(uint16_t halfWord1, uint16_t halfWord2);
+static uint32_t thumbExpandImmediate(uint32_t imm12);
+
+
+StackUnwinder::StackUnwinder(const ElfImage& elf, const SymbolIndex& symbols) : m_elf(elf), m_symbols(symbols)
+{
+    m_pExidx = elf.findSectionOfType(ElfImage::SHT_ARM_EXIDX);
+    m_exidxCount = m_pExidx && m_pExidx->pData ? m_pExidx->size / EXIDX_ENTRY_SIZE : 0;
+}
+
+size_t StackUnwinder::unwind(const DumpReader& dump, Frame* pFrames, size_t maxFrames, StopReason* pStopReason) const
+{
+    State     state;
+    FrameType type = FRAME_CRASH;
+    size_t    frameCount = 0;
+    size_t    i;
+
+    if (!dump.hasIntegerRegisters())
+    {
+        *pStopReason = STOP_NO_REGISTERS;
+        return 0;
+    }
+    memset(&state, 0, sizeof(state));
+    for (i = 0 ; i < REGISTER_COUNT ; i++)
+        state.r[i] = dump.integerRegister(i);
+    state.validMask = ALL_REGISTERS;
+    state.psp = dump.integerRegister(DumpReader::PSP);
+
+    for (;;)
+    {
+        if (frameCount == maxFrames)
+        {
+            *pStopReason = STOP_MAX_FRAMES;
+            break;
+        }
+        pFrames[frameCount].pc = state.r[PC] & ~1;
+        pFrames[frameCount].sp = state.r[SP];
+        pFrames[frameCount].type = type;
+        frameCount++;
+        if (!step(dump, &state, &type, pStopReason))
+            break;
+    }
+    return frameCount;
+}
+
+bool StackUnwinder::step(const DumpReader& dump, State* pState, FrameType* pType, StopReason* pStopReason) const
+{
+    uint32_t            pc = pState->r[PC] & ~1;
+    uint32_t            sp = pState->r[SP];
+    /* Return addresses point just past the call, which can be the very last instruction of a function. */
+    uint32_t            lookupAddress = pState->isReturnAddress ? pc - 2 : pc;
+    SymbolIndex::Symbol symbol;
+    Prologue            prologue;
+    size_t              exidxIndex = 0;
+    bool                hasExidx = findExidxEntry(lookupAddress, &exidxIndex);
+    bool                hasUnwindInstructions = hasExidx && exidxData(exidxIndex) != EXIDX_CANTUNWIND;
+    bool                hasFunction = true;
+    uint32_t            functionAddress = 0;
+    uint32_t            returnAddress;
+    bool                isUnwound;
+
+    /* The symbols give the most precise function start but stripped images still have the start of each function's
+       unwind table entry. */
+    if (m_symbols.findSymbol(lookupAddress, &symbol))
+        functionAddress = symbol.address;
+    else if (hasExidx)
+        functionAddress = exidxFunctionAddress(exidxIndex);
+    else
+        hasFunction = false;
+    if (hasFunction && functionAddress == (m_elf.entryPoint() & ~1))
+    {
+        *pStopReason = STOP_END_OF_STACK;
+        return false;
+    }
+
+    memset(&prologue, 0, sizeof(prologue));
+    if (hasFunction)
+        analysePrologue(dump, functionAddress, pc, &prologue);
+    if (hasFunction && (prologue.hasReachedPc || !hasUnwindInstructions))
+    {
+        isUnwound = unwindWithPrologue(dump, pState, &prologue, pStopReason);
+        *pType = FRAME_PROLOGUE;
+    }
+    else if (hasUnwindInstructions)
+    {
+        isUnwound = unwindWithExidx(dump, pState, exidxIndex, pStopReason);
+        *pType = FRAME_EXIDX;
+    }
+    else if (!pState->isReturnAddress && (pState->validMask & (1 << LR)))
+    {
+        pState->r[PC] = pState->r[LR];
+        isUnwound = true;
+        *pType = FRAME_LINK_REGISTER;
+    }
+    else
+    {
+        *pStopReason = STOP_NO_UNWIND_INFO;
+        return false;
+    }
+    if (!isUnwound)
+        return false;
+
+    returnAddress = pState->r[PC];
+    pState->validMask &= ~CALLER_SAVED_REGISTERS;
+    pState->isReturnAddress = true;
+    if ((returnAddress & EXC_RETURN_MASK) == EXC_RETURN_MASK)
+    {
+        *pType = FRAME_EXCEPTION;
+        return unstackException(dump, pState, returnAddress, pStopReason);
+    }
+    if (returnAddress == 0 || returnAddress == 0xFFFFFFFF)
+    {
+        *pStopReason = STOP_END_OF_STACK;
+        return false;
+    }
+    /* Calls always leave the Thumb bit set in LR.  A caller with the same SP and PC would unwind forever. */
+    if (!(returnAddress & 1) || !m_elf.isCodeAddress(returnAddress & ~1) ||
+        pState->r[SP] < sp || (pState->r[SP] == sp && (returnAddress & ~1) == pc))
+    {
+        *pStopReason = STOP_BAD_FRAME;
+        return false;
+    }
+    return true;
+}
+
+bool StackUnwinder::findExidxEntry(uint32_t address, size_t* pIndex) const
+{
+    size_t low = 0;
+    size_t high = m_exidxCount;
+
+    /* The linker sorts the entries by function address and each one covers everything up to the next. */
+    while (low < high)
+    {
+        size_t middle = low + (high - low) / 2;
+
+        if (exidxFunctionAddress(middle) <= address)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    if (low == 0)
+        return false;
+    *pIndex = low - 1;
+    return true;
+}
+
+uint32_t StackUnwinder::exidxFunctionAddress(size_t index) const
+{
+    uint32_t offset = index * EXIDX_ENTRY_SIZE;
+
+    return decodePrel31(readUInt32(m_pExidx->pData + offset), m_pExidx->address + offset);
+}
+
+uint32_t StackUnwinder::exidxData(size_t index) const
+{
+    return readUInt32(m_pExidx->pData + index * EXIDX_ENTRY_SIZE + sizeof(uint32_t));
+}
+
+bool StackUnwinder::unwindWithExidx(const DumpReader& dump, State* pState, size_t index,
+                                    StopReason* pStopReason) const
+{
+    uint8_t  opcodes[MAX_OPCODE_BYTES];
+    size_t   opcodeCount = 0;
+    size_t   i = 0;
+    uint32_t vsp = pState->r[SP];
+    bool     isPcPopped = false;
+
+    if (!fetchOpcodes(index, opcodes, &opcodeCount))
+    {
+        *pStopReason = STOP_BAD_UNWIND_INFO;
+        return false;
+    }
+    while (i < opcodeCount)
+    {
+        uint8_t  opcode = opcodes[i++];
+        uint8_t  operand = i < opcodeCount ? opcodes[i] : 0;
+        uint32_t registerMask = 0;
+        bool     isValid = true;
+
+        if ((opcode & 0xC0) == 0x00)
+        {
+            vsp += ((opcode & 0x3F) << 2) + 4;
+        }
+        else if ((opcode & 0xC0) == 0x40)
+        {
+            vsp -= ((opcode & 0x3F) << 2) + 4;
+        }
+        else if ((opcode & 0xF0) == 0x80)
+        {
+            /* Pop R4-R15 under mask.  An empty mask means the function refuses to be unwound. */
+            registerMask = (((opcode & 0x0F) << 8) | operand) << 4;
+            isValid = i++ < opcodeCount && registerMask != 0;
+        }
+        else if ((opcode & 0xF0) == 0x90)
+        {
+            /* vsp = r[nnnn], with 13 and 15 reserved. */
+            uint32_t reg = opcode & 0x0F;
+
+            isValid = reg != 13 && reg != 15 && (pState->validMask & (1 << reg));
+            vsp = pState->r[reg];
+        }
+        else if ((opcode & 0xF0) == 0xA0)
+        {
+            /* Pop R4-R[4+nnn] and optionally LR. */
+            registerMask = ((1 << ((opcode & 0x07) + 1)) - 1) << 4;
+            if (opcode & 0x08)
+                registerMask |= 1 << LR;
+        }
+        else if (opcode == 0xB0)
+        {
+            break;
+        }
+        else if (opcode == 0xB1)
+        {
+            /* Pop R0-R3 under mask. */
+            registerMask = operand;
+            isValid = i++ < opcodeCount && operand != 0 && (operand & 0xF0) == 0;
+        }
+        else if (opcode == 0xB2)
+        {
+            /* vsp += 0x204 + (uleb128 << 2) */
+            uint32_t value = 0;
+            uint32_t shift = 0;
+
+            do
+            {
+                isValid = i < opcodeCount && shift < 32;
+                if (!isValid)
+                    break;
+                value |= (opcodes[i] & 0x7F) << shift;
+                shift += 7;
+            } while (opcodes[i++] & 0x80);
+            vsp += 0x204 + (value << 2);
+        }
+        else if (opcode == 0xB3 || opcode == 0xC8 || opcode == 0xC9 || opcode == 0xC6)
+        {
+            /* Pop a run of VFP or iWMMXt double registers.  FSTMFDX (0xB3) also stacked a format word. */
+            vsp += ((operand & 0x0F) + 1) * 8 + (opcode == 0xB3 ? 4 : 0);
+            isValid = i++ < opcodeCount;
+        }
+        else if (opcode == 0xC7)
+        {
+            /* Pop iWMMXt WCGR0-WCGR3 under mask. */
+            vsp += countBits(operand) * 4;
+            isValid = i++ < opcodeCount && operand != 0 && (operand & 0xF0) == 0;
+        }
+        else if ((opcode & 0xF8) == 0xB8 || (opcode & 0xF8) == 0xD0 || (opcode & 0xF8) == 0xC0)
+        {
+            /* Pop D8-D[8+nnn], using FSTMFDX for 0xB8, or iWMMXt WR10-WR[10+nnn]. */
+            vsp += ((opcode & 0x07) + 1) * 8 + ((opcode & 0xF8) == 0xB8 ? 4 : 0);
+        }
+        else
+        {
+            isValid = false;
+        }
+        if (!isValid)
+        {
+            *pStopReason = STOP_BAD_UNWIND_INFO;
+            return false;
+        }
+        if (registerMask && !popRegisters(dump, pState, &vsp, registerMask, pStopReason))
+            return false;
+        if (registerMask & (1 << PC))
+            isPcPopped = true;
+    }
+
+    pState->r[SP] = vsp;
+    if (!isPcPopped)
+    {
+        if (!(pState->validMask & (1 << LR)))
+        {
+            *pStopReason = STOP_BAD_FRAME;
+            return false;
+        }
+        pState->r[PC] = pState->r[LR];
+    }
+    return true;
+}
+
+bool StackUnwinder::fetchOpcodes(size_t index, uint8_t* pOpcodes, size_t* pOpcodeCount) const
+{
+    uint32_t       entryAddress = m_pExidx->address + index * EXIDX_ENTRY_SIZE;
+    uint32_t       data = exidxData(index);
+    uint32_t       extabAddress;
+    uint32_t       word;
+    uint32_t       extraWordCount;
+    size_t         byteCount;
+    const uint8_t* pWord;
+    const uint8_t* pExtraWords;
+    size_t         i;
+
+    /* Personality routine 0 with the 3 instruction bytes inlined in the exidx entry itself. */
+    if (data & EHABI_COMPACT_MODEL)
+    {
+        if ((data & 0xFF000000) != EHABI_COMPACT_MODEL)
+            return false;
+        pOpcodes[0] = data >> 16;
+        pOpcodes[1] = data >> 8;
+        pOpcodes[2] = data;
+        *pOpcodeCount = 3;
+        return true;
+    }
+
+    extabAddress = decodePrel31(data, entryAddress + sizeof(uint32_t));
+    pWord = m_elf.findBytes(extabAddress, sizeof(uint32_t));
+    if (!pWord)
+        return false;
+    word = readUInt32(pWord);
+    if (word & EHABI_COMPACT_MODEL)
+    {
+        uint32_t personality = (word >> 24) & 0x7F;
+
+        if (personality == 0)
+        {
+            pOpcodes[0] = word >> 16;
+            pOpcodes[1] = word >> 8;
+            pOpcodes[2] = word;
+            *pOpcodeCount = 3;
+            return true;
+        }
+        if (personality > 2)
+            return false;
+        extraWordCount = (word >> 16) & 0xFF;
+        pOpcodes[0] = word >> 8;
+        pOpcodes[1] = word;
+        byteCount = 2;
+        extabAddress += sizeof(uint32_t);
+    }
+    else
+    {
+        /* A generic personality routine, as used for C++ code.  GCC's routines follow the pointer to themselves with a
+           word holding the count of extra words and 3 instruction bytes, in the same format as personality 1. */
+        pWord = m_elf.findBytes(extabAddress + sizeof(uint32_t), sizeof(uint32_t));
+        if (!pWord)
+            return false;
+        word = readUInt32(pWord);
+        extraWordCount = word >> 24;
+        pOpcodes[0] = word >> 16;
+        pOpcodes[1] = word >> 8;
+        pOpcodes[2] = word;
+        byteCount = 3;
+        extabAddress += 2 * sizeof(uint32_t);
+    }
+
+    pExtraWords = m_elf.findBytes(extabAddress, extraWordCount * sizeof(uint32_t));
+    if (!pExtraWords)
+        return false;
+    for (i = 0 ; i < extraWordCount ; i++)
+    {
+        word = readUInt32(&pExtraWords[i * sizeof(uint32_t)]);
+        pOpcodes[byteCount++] = word >> 24;
+        pOpcodes[byteCount++] = word >> 16;
+        pOpcodes[byteCount++] = word >> 8;
+        pOpcodes[byteCount++] = word;
+    }
+    *pOpcodeCount = byteCount;
+    return true;
+}
+
+bool StackUnwinder::popRegisters(const DumpReader& dump, State* pState, uint32_t* pVsp, uint32_t registerMask,
+                                 StopReason* pStopReason)
+{
+    uint32_t vsp = *pVsp;
+    uint32_t poppedSp = 0;
+    uint32_t reg;
+
+    /* The lowest numbered register is at the lowest address. */
+    for (reg = 0 ; reg < REGISTER_COUNT ; reg++)
+    {
+        uint32_t value;
+
+        if (!(registerMask & (1 << reg)))
+            continue;
+        if (!readStackWord(dump, vsp, &value))
+        {
+            *pStopReason = STOP_MISSING_STACK;
+            return false;
+        }
+        if (reg == SP)
+            poppedSp = value;
+        else
+            pState->r[reg] = value;
+        vsp += sizeof(uint32_t);
+    }
+    pState->validMask |= registerMask & ~(1 << SP);
+    /* Popping SP replaces the vsp rather than just moving past its slot. */
+    *pVsp = (registerMask & (1 << SP)) ? poppedSp : vsp;
+    return true;
+}
+
+void StackUnwinder::analysePrologue(const DumpReader& dump, uint32_t functionAddress, uint32_t pc,
+                                    Prologue* pPrologue) const
+{
+    uint32_t address = functionAddress;
+    size_t   instructionCount;
+
+    memset(pPrologue, 0, sizeof(*pPrologue));
+    for (instructionCount = 0 ; instructionCount < MAX_PROLOGUE_INSTRUCTIONS && address < pc ; instructionCount++)
+    {
+        uint16_t halfWord1;
+        uint16_t halfWord2;
+        uint32_t registerMask = 0;
+
+        if (!readCode(dump, address, &halfWord1))
+            return;
+        if (is32BitInstruction(halfWord1))
+        {
+            if (!readCode(dump, address + 2, &halfWord2) || endsPrologue32(halfWord1, halfWord2))
+                return;
+            if (halfWord1 == 0xE92D)
+            {
+                /* PUSH.W {registers} */
+                registerMask = halfWord2 & 0x5FFF;
+            }
+            else if (halfWord1 == 0xF84D && (halfWord2 & 0x0FFF) == 0x0D04)
+            {
+                /* PUSH.W {Rt} encoded as STR Rt, [SP, #-4]! */
+                registerMask = 1 << (halfWord2 >> 12);
+            }
+            else if ((halfWord1 & 0xFBEF) == 0xF1AD && (halfWord2 & 0x8F00) == 0x0D00)
+            {
+                /* SUB.W SP, SP, #const */
+                pPrologue->stackSize += thumbExpandImmediate(((halfWord1 & 0x0400) << 1) | ((halfWord2 & 0x7000) >> 4) |
+                                                             (halfWord2 & 0xFF));
+            }
+            else if ((halfWord1 & 0xFBFF) == 0xF2AD && (halfWord2 & 0x8F00) == 0x0D00)
+            {
+                /* SUBW SP, SP, #imm12 */
+                pPrologue->stackSize += ((halfWord1 & 0x0400) << 1) | ((halfWord2 & 0x7000) >> 4) | (halfWord2 & 0xFF);
+            }
+            else if ((halfWord1 & 0xFFBF) == 0xED2D && (halfWord2 & 0x0E00) == 0x0A00)
+            {
+                /* VPUSH {registers}, which the imm8 field gives the size of in words. */
+                pPrologue->stackSize += (halfWord2 & 0xFF) * sizeof(uint32_t);
+            }
+            address += 4;
+        }
+        else
+        {
+            if (endsPrologue16(halfWord1))
+                return;
+            if ((halfWord1 & 0xFE00) == 0xB400)
+            {
+                /* PUSH {registers}, with bit 8 adding LR. */
+                registerMask = (halfWord1 & 0xFF) | ((halfWord1 & 0x0100) << 6);
+            }
+            else if ((halfWord1 & 0xFF80) == 0xB080)
+            {
+                /* SUB SP, SP, #imm7 */
+                pPrologue->stackSize += (halfWord1 & 0x7F) << 2;
+            }
+            address += 2;
+        }
+
+        if (registerMask)
+        {
+            uint32_t offset;
+            uint32_t reg;
+
+            pPrologue->stackSize += countBits(registerMask) * sizeof(uint32_t);
+            offset = pPrologue->stackSize;
+            for (reg = 0 ; reg < REGISTER_COUNT ; reg++)
+            {
+                if (!(registerMask & (1 << reg)))
+                    continue;
+                /* Only the first push of a register holds the caller's value. */
+                if (!(pPrologue->savedMask & (1 << reg)))
+                {
+                    pPrologue->savedMask |= 1 << reg;
+                    pPrologue->savedOffsets[reg] = offset;
+                }
+                offset -= sizeof(uint32_t);
+            }
+        }
+    }
+    pPrologue->hasReachedPc = address >= pc;
+}
+
+bool StackUnwinder::unwindWithPrologue(const DumpReader& dump, State* pState, const Prologue* pPrologue,
+                                       StopReason* pStopReason) const
+{
+    uint32_t callerSp = pState->r[SP] + pPrologue->stackSize;
+    uint32_t reg;
+
+    for (reg = 0 ; reg < REGISTER_COUNT ; reg++)
+    {
+        if (!(pPrologue->savedMask & (1 << reg)))
+            continue;
+        if (!readStackWord(dump, callerSp - pPrologue->savedOffsets[reg], &pState->r[reg]))
+        {
+            *pStopReason = STOP_MISSING_STACK;
+            return false;
+        }
+        pState->validMask |= 1 << reg;
+    }
+    /* Functions which don't push LR return with the value it still holds. */
+    if (!(pState->validMask & (1 << LR)))
+    {
+        *pStopReason = STOP_BAD_FRAME;
+        return false;
+    }
+    pState->r[SP] = callerSp;
+    pState->r[PC] = pState->r[LR];
+    return true;
+}
+
+bool StackUnwinder::unstackException(const DumpReader& dump, State* pState, uint32_t excReturn,
+                                     StopReason* pStopReason) const
+{
+    uint32_t frameAddress = pState->r[SP];
+    uint32_t frame[BASIC_FRAME_WORDS];
+    uint32_t frameSize;
+    size_t   i;
+
+    /* Handlers always run on the main stack so the code they interrupted can only switch to the process stack once. */
+    if (excReturn & EXC_RETURN_PSP)
+    {
+        if (pState->isOnProcessStack)
+        {
+            *pStopReason = STOP_BAD_FRAME;
+            return false;
+        }
+        pState->isOnProcessStack = true;
+        frameAddress = pState->psp;
+    }
+    for (i = 0 ; i < BASIC_FRAME_WORDS ; i++)
+    {
+        if (!readStackWord(dump, frameAddress + i * sizeof(uint32_t), &frame[i]))
+        {
+            *pStopReason = STOP_MISSING_STACK;
+            return false;
+        }
+    }
+
+    frameSize = BASIC_FRAME_WORDS * sizeof(uint32_t);
+    if (!(excReturn & EXC_RETURN_BASIC_FRAME))
+        frameSize += EXTENDED_FRAME_EXTRA_WORDS * sizeof(uint32_t);
+    if (frame[STACKED_PSR] & PSR_STACK_ALIGN)
+        frameSize += sizeof(uint32_t);
+    memcpy(pState->r, frame, 4 * sizeof(uint32_t));
+    pState->r[12] = frame[STACKED_R12];
+    pState->r[LR] = frame[STACKED_LR];
+    pState->r[PC] = frame[STACKED_PC];
+    pState->r[SP] = frameAddress + frameSize;
+    pState->validMask |= CALLER_SAVED_REGISTERS;
+    /* The stacked PC is the instruction which was interrupted rather than a return address. */
+    pState->isReturnAddress = false;
+    if (!m_elf.isCodeAddress(pState->r[PC] & ~1))
+    {
+        *pStopReason = STOP_BAD_FRAME;
+        return false;
+    }
+    return true;
+}
+
+bool StackUnwinder::readCode(const DumpReader& dump, uint32_t address, uint16_t* pHalfWord) const
+{
+    const uint8_t* pCode = m_elf.findBytes(address, sizeof(*pHalfWord));
+    uint8_t        bytes[2];
+
+    /* Fall back to the dump for code which only exists at runtime, such as functions copied into RAM. */
+    if (!pCode)
+    {
+        if (dump.readBytes(address, bytes, sizeof(bytes)) != sizeof(bytes))
+            return false;
+        pCode = bytes;
+    }
+    *pHalfWord = pCode[0] | (pCode[1] << 8);
+    return true;
+}
+
+static uint32_t readUInt32(const uint8_t* pSrc)
+{
+    return pSrc[0] | (pSrc[1] << 8) | (pSrc[2] << 16) | ((uint32_t)pSrc[3] << 24);
+}
+
+static bool readStackWord(const DumpReader& dump, uint32_t address, uint32_t* pValue)
+{
+    uint8_t bytes[4];
+
+    if (dump.readBytes(address, bytes, sizeof(bytes)) != sizeof(bytes))
+        return false;
+    *pValue = readUInt32(bytes);
+    return true;
+}
+
+static uint32_t decodePrel31(uint32_t value, uint32_t place)
+{
+    uint32_t offset = value & 0x7FFFFFFF;
+
+    if (offset & 0x40000000)
+        offset |= 0x80000000;
+    return place + offset;
+}
+
+static uint32_t countBits(uint32_t value)
+{
+    uint32_t count = 0;
+
+    while (value)
+    {
+        value &= value - 1;
+        count++;
+    }
+    return count;
+}
+
+static bool is32BitInstruction(uint16_t halfWord)
+{
+    return (halfWord & 0xE000) == 0xE000 && (halfWord & 0x1800) != 0;
+}
+
+static bool endsPrologue16(uint16_t instruction)
+{
+    return (instruction & 0xF000) == 0xD000 ||  /* B<cond>, UDF and SVC */
+           (instruction & 0xF800) == 0xE000 ||  /* B */
+           (instruction & 0xFF00) == 0x4700 ||  /* BX and BLX */
+           (instruction & 0xFF87) == 0x4687 ||  /* MOV PC, Rm */
+           (instruction & 0xFF87) == 0x4487 ||  /* ADD PC, Rm */
+           (instruction & 0xF500) == 0xB100 ||  /* CBZ and CBNZ */
+           (instruction & 0xFE00) == 0xBC00 ||  /* POP */
+           (instruction & 0xFF80) == 0xB000 ||  /* ADD SP, SP, #imm7 */
+           (instruction & 0xFF00) == 0xBE00;    /* BKPT */
+}
+
+static bool endsPrologue32(uint16_t halfWord1, uint16_t halfWord2)
+{
+    return ((halfWord1 & 0xF800) == 0xF000 && (halfWord2 & 0x8000)) ||         /* B.W, BL and other control */
+           halfWord1 == 0xE8BD ||                                              /* POP.W {registers} */
+           (halfWord1 == 0xF85D && (halfWord2 & 0x0FFF) == 0x0B04) ||          /* POP.W {Rt} */
+           ((halfWord1 & 0xFFF0) == 0xE8D0 && (halfWord2 & 0xFFE0) == 0xF000); /* TBB and TBH */
+}
+
+static uint32_t thumbExpandImmediate(uint32_t imm12)
+{
+    uint32_t imm8 = imm12 & 0xFF;
+    uint32_t unrotated;
+    uint32_t rotation;
+
+    if ((imm12 & 0xC00) == 0)
+    {
+        switch ((imm12 >> 8) & 3)
+        {
+        case 0:
+            return imm8;
+        case 1:
+            return imm8 | (imm8 << 16);
+        case 2:
+            return (imm8 << 8) | (imm8 << 24);
+        default:
+            return imm8 * 0x01010101;
+        }
+    }
+    unrotated = 0x80 | (imm12 & 0x7F);
+    rotation = imm12 >> 7;
+    return (unrotated >> rotation) | (unrotated << (32 - rotation));
+}
+
+
+const char* StackUnwinder::stopReasonString(StopReason stopReason)
+{
+    switch (stopReason)
+    {
+    case STOP_END_OF_STACK:
+        return "end of stack";
+    case STOP_MAX_FRAMES:
+        return "frame limit reached";
+    case STOP_NO_REGISTERS:
+        return "no registers in dump";
+    case STOP_NO_UNWIND_INFO:
+        return "no unwind information or symbol for PC";
+    case STOP_BAD_UNWIND_INFO:
+        return "unsupported unwind instructions";
+    case STOP_MISSING_STACK:
+        return "stack missing from dump";
+    case STOP_BAD_FRAME:
+        return "corrupt stack frame";
+    }
+    return "unknown stop reason";
+}
@@ -0,0 +1,107 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Host side unwinder which walks the stack saved in a dump to produce a backtrace, using the .ARM.exidx unwind tables
+   of the firmware's ELF file and falling back to analysing function prologues where there are no tables. */
+#ifndef _STACK_UNWINDER_H_
+#define _STACK_UNWINDER_H_
+
+#include <DumpReader.h>
+#include "ElfImage.h"
+#include "SymbolIndex.h"
+
+
+class StackUnwinder
+{
+public:
+    /* How the PC of each frame was found. */
+    enum FrameType
+    {
+        /* The PC from the registers in the dump. */
+        FRAME_CRASH = 0,
+        /* Return address found by running the .ARM.exidx unwind instructions of the function which was called. */
+        FRAME_EXIDX,
+        /* Return address found by analysing the prologue of the function which was called. */
+        FRAME_PROLOGUE,
+        /* Return address taken straight from LR since the code at the PC isn't known, which is what happens after a
+           call through a corrupt function pointer. */
+        FRAME_LINK_REGISTER,
+        /* PC of code interrupted by an exception, taken from the exception frame stacked by the processor. */
+        FRAME_EXCEPTION
+    };
+
+    enum StopReason
+    {
+        /* Reached the ELF's entry point, which is normally the reset handler, or a return address of 0 or
+           0xFFFFFFFF. */
+        STOP_END_OF_STACK = 0,
+        /* The frame array filled up. */
+        STOP_MAX_FRAMES,
+        /* The dump ended before its integer registers. */
+        STOP_NO_REGISTERS,
+        /* The PC isn't in a function which has unwind tables or a symbol to find its prologue with. */
+        STOP_NO_UNWIND_INFO,
+        /* The unwind tables for the PC use reserved instructions or a personality routine which isn't supported. */
+        STOP_BAD_UNWIND_INFO,
+        /* A saved register or exception frame is in a part of the stack which wasn't dumped. */
+        STOP_MISSING_STACK,
+        /* The caller's SP is below the callee's, its PC isn't in the ELF's code or LR was needed after it was
+           overwritten. */
+        STOP_BAD_FRAME
+    };
+
+    struct Frame
+    {
+        /* PC with the Thumb bit cleared.  Frames other than the first are return addresses, which point just past the
+           call, unless they are of type FRAME_EXCEPTION. */
+        uint32_t  pc;
+        uint32_t  sp;
+        FrameType type;
+    };
+
+    /* The ELF file and symbol index must stay open for as long as the unwinder is used.  Since unwind() doesn't
+       modify the unwinder, one unwinder can be shared by multiple threads. */
+    StackUnwinder(const ElfImage& elf, const SymbolIndex& symbols);
+
+    /* Unwinds the stack of a dump which has already been parsed by dump and fills in up to maxFrames frames, starting
+       at the crash.  Returns the number of frames filled in and why the unwind stopped. */
+    size_t             unwind(const DumpReader& dump, Frame* pFrames, size_t maxFrames, StopReason* pStopReason) const;
+    static const char* stopReasonString(StopReason stopReason);
+
+private:
+    struct State;
+    struct Prologue;
+
+    bool     step(const DumpReader& dump, State* pState, FrameType* pType, StopReason* pStopReason) const;
+    bool     findExidxEntry(uint32_t address, size_t* pIndex) const;
+    uint32_t exidxFunctionAddress(size_t index) const;
+    uint32_t exidxData(size_t index) const;
+    bool     unwindWithExidx(const DumpReader& dump, State* pState, size_t index, StopReason* pStopReason) const;
+    bool     fetchOpcodes(size_t index, uint8_t* pOpcodes, size_t* pOpcodeCount) const;
+    void     analysePrologue(const DumpReader& dump, uint32_t functionAddress, uint32_t pc, Prologue* pPrologue) const;
+    bool     unwindWithPrologue(const DumpReader& dump, State* pState, const Prologue* pPrologue,
+                                StopReason* pStopReason) const;
+    bool     unstackException(const DumpReader& dump, State* pState, uint32_t excReturn, StopReason* pStopReason) const;
+    bool     readCode(const DumpReader& dump, uint32_t address, uint16_t* pHalfWord) const;
+    static bool popRegisters(const DumpReader& dump, State* pState, uint32_t* pVsp, uint32_t registerMask,
+                             StopReason* pStopReason);
+
+    const ElfImage&          m_elf;
+    const SymbolIndex&       m_symbols;
+    const ElfImage::Section* m_pExidx;
+    size_t                   m_exidxCount;
+};
+
+
+#endif /* _STACK_UNWINDER_H_ */
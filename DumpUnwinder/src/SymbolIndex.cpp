@@ -0,0 +1,345 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Index file layout, with all fields little endian:
+     "cCSI" signature
+     uint32_t version
+     uint64_t fingerprint of the ELF file the index was built from, low word first
+     uint32_t symbolCount
+     uint32_t namesSize
+     symbolCount records of { uint32_t address, uint32_t size, uint32_t nameOffset }, sorted by address
+     namesSize bytes of NUL terminated names
+   The in memory index uses the same layout so that loading it is just a read and a validation pass. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "SymbolIndex.h"
+
+
+#define INDEX_VERSION           1
+#define HEADER_SIZE             24
+#define RECORD_SIZE             12
+#define VERSION_OFFSET          4
+#define FINGERPRINT_OFFSET      8
+#define SYMBOL_COUNT_OFFSET     16
+#define NAMES_SIZE_OFFSET       20
+
+/* ELF symbol table entry layout. */
+#define ELF_SYMBOL_SIZE         16
+#define ST_NAME                 0
+#define ST_VALUE                4
+#define ST_SIZE                 8
+#define ST_INFO                 12
+#define ST_SHNDX                14
+#define STT_FUNC                2
+#define STB_LOCAL               0
+#define SHN_UNDEF               0
+
+
+static const char g_signature[4] = { 'c', 'C', 'S', 'I' };
+
+
+/* A function symbol pulled out of the ELF symbol table before it is sorted. */
+struct ElfSymbol
+{
+    uint32_t    address;
+    uint32_t    size;
+    const char* pName;
+    bool        isLocal;
+    size_t      order;
+};
+
+
+static uint32_t readUInt32(const uint8_t* pSrc);
+static void     writeUInt32(uint8_t* pDest, uint32_t value);
+static int      compareElfSymbols(const void* pv1, const void* pv2);
+
+
+SymbolIndex::SymbolIndex()
+{
+    m_pIndex = NULL;
+    clear();
+}
+
+SymbolIndex::~SymbolIndex()
+{
+    clear();
+}
+
+SymbolIndex::Result SymbolIndex::build(const ElfImage& elf)
+{
+    const ElfImage::Section* pSymbols = elf.findSectionOfType(ElfImage::SHT_SYMTAB);
+    const ElfImage::Section* pNames = NULL;
+    ElfSymbol*               pElfSymbols = NULL;
+    size_t                   elfSymbolCount = 0;
+    size_t                   symbolCount = 0;
+    size_t                   namesSize = 0;
+    size_t                   i;
+    uint8_t*                 pRecord;
+    char*                    pName;
+
+    clear();
+    if (pSymbols)
+    {
+        if (pSymbols->link >= elf.sectionCount() || !pSymbols->pData)
+            return MALFORMED;
+        pNames = &elf.section(pSymbols->link);
+        if (!pNames->pData || pNames->size == 0 || pNames->pData[pNames->size - 1] != '\0')
+            return MALFORMED;
+        pElfSymbols = (ElfSymbol*)malloc((pSymbols->size / ELF_SYMBOL_SIZE + 1) * sizeof(*pElfSymbols));
+        if (!pElfSymbols)
+            return OUT_OF_MEMORY;
+        for (i = 0 ; i + ELF_SYMBOL_SIZE <= pSymbols->size ; i += ELF_SYMBOL_SIZE)
+        {
+            const uint8_t* pElfSymbol = pSymbols->pData + i;
+            uint32_t       nameOffset = readUInt32(&pElfSymbol[ST_NAME]);
+            uint8_t        info = pElfSymbol[ST_INFO];
+            ElfSymbol*     pSymbol = &pElfSymbols[elfSymbolCount];
+
+            if ((info & 0xF) != STT_FUNC || (pElfSymbol[ST_SHNDX] | (pElfSymbol[ST_SHNDX + 1] << 8)) == SHN_UNDEF)
+                continue;
+            if (nameOffset >= pNames->size)
+            {
+                free(pElfSymbols);
+                return MALFORMED;
+            }
+            pSymbol->address = readUInt32(&pElfSymbol[ST_VALUE]) & ~1;
+            pSymbol->size = readUInt32(&pElfSymbol[ST_SIZE]);
+            pSymbol->pName = (const char*)pNames->pData + nameOffset;
+            pSymbol->isLocal = (info >> 4) == STB_LOCAL;
+            pSymbol->order = elfSymbolCount;
+            elfSymbolCount++;
+        }
+    }
+
+    /* Aliases share an address so only the first of them is kept, preferring global names over static ones. */
+    qsort(pElfSymbols, elfSymbolCount, sizeof(*pElfSymbols), compareElfSymbols);
+    for (i = 0 ; i < elfSymbolCount ; i++)
+    {
+        if (i > 0 && pElfSymbols[i].address == pElfSymbols[symbolCount - 1].address)
+            continue;
+        pElfSymbols[symbolCount++] = pElfSymbols[i];
+        namesSize += strlen(pElfSymbols[symbolCount - 1].pName) + 1;
+    }
+
+    m_indexSize = HEADER_SIZE + symbolCount * RECORD_SIZE + namesSize;
+    m_pIndex = (uint8_t*)malloc(m_indexSize);
+    if (!m_pIndex)
+    {
+        free(pElfSymbols);
+        clear();
+        return OUT_OF_MEMORY;
+    }
+    memcpy(m_pIndex, g_signature, sizeof(g_signature));
+    writeUInt32(&m_pIndex[VERSION_OFFSET], INDEX_VERSION);
+    writeUInt32(&m_pIndex[FINGERPRINT_OFFSET], (uint32_t)elf.fingerprint());
+    writeUInt32(&m_pIndex[FINGERPRINT_OFFSET + 4], (uint32_t)(elf.fingerprint() >> 32));
+    writeUInt32(&m_pIndex[SYMBOL_COUNT_OFFSET], symbolCount);
+    writeUInt32(&m_pIndex[NAMES_SIZE_OFFSET], namesSize);
+    pRecord = &m_pIndex[HEADER_SIZE];
+    pName = (char*)pRecord + symbolCount * RECORD_SIZE;
+    for (i = 0 ; i < symbolCount ; i++, pRecord += RECORD_SIZE)
+    {
+        writeUInt32(&pRecord[0], pElfSymbols[i].address);
+        writeUInt32(&pRecord[4], pElfSymbols[i].size);
+        writeUInt32(&pRecord[8], pName - (char*)&m_pIndex[HEADER_SIZE + symbolCount * RECORD_SIZE]);
+        strcpy(pName, pElfSymbols[i].pName);
+        pName += strlen(pName) + 1;
+    }
+    free(pElfSymbols);
+    return validate();
+}
+
+static int compareElfSymbols(const void* pv1, const void* pv2)
+{
+    const ElfSymbol* pSymbol1 = (const ElfSymbol*)pv1;
+    const ElfSymbol* pSymbol2 = (const ElfSymbol*)pv2;
+
+    if (pSymbol1->address != pSymbol2->address)
+        return pSymbol1->address < pSymbol2->address ? -1 : 1;
+    if (pSymbol1->isLocal != pSymbol2->isLocal)
+        return pSymbol1->isLocal ? 1 : -1;
+    return pSymbol1->order < pSymbol2->order ? -1 : 1;
+}
+
+SymbolIndex::Result SymbolIndex::load(const char* pFilename, uint64_t expectedFingerprint)
+{
+    FILE*  pFile;
+    long   size;
+    Result result;
+
+    clear();
+    pFile = fopen(pFilename, "rb");
+    if (!pFile || fseek(pFile, 0, SEEK_END) != 0 || (size = ftell(pFile)) < 0 || fseek(pFile, 0, SEEK_SET) != 0)
+    {
+        if (pFile)
+            fclose(pFile);
+        return OPEN_FAILED;
+    }
+    m_pIndex = (uint8_t*)malloc(size ? size : 1);
+    if (!m_pIndex)
+    {
+        fclose(pFile);
+        return OUT_OF_MEMORY;
+    }
+    if (fread(m_pIndex, 1, size, pFile) != (size_t)size)
+    {
+        fclose(pFile);
+        clear();
+        return OPEN_FAILED;
+    }
+    fclose(pFile);
+    m_indexSize = size;
+
+    result = validate();
+    if (result == OK && m_fingerprint != expectedFingerprint)
+        result = STALE;
+    if (result != OK)
+        clear();
+    return result;
+}
+
+SymbolIndex::Result SymbolIndex::validate()
+{
+    uint32_t previousAddress = 0;
+    size_t   i;
+
+    if (m_indexSize < HEADER_SIZE || memcmp(m_pIndex, g_signature, sizeof(g_signature)) != 0 ||
+        readUInt32(&m_pIndex[VERSION_OFFSET]) != INDEX_VERSION)
+    {
+        return BAD_SIGNATURE;
+    }
+    m_fingerprint = readUInt32(&m_pIndex[FINGERPRINT_OFFSET]) |
+                    ((uint64_t)readUInt32(&m_pIndex[FINGERPRINT_OFFSET + 4]) << 32);
+    m_symbolCount = readUInt32(&m_pIndex[SYMBOL_COUNT_OFFSET]);
+    m_namesSize = readUInt32(&m_pIndex[NAMES_SIZE_OFFSET]);
+    if (m_symbolCount > (m_indexSize - HEADER_SIZE) / RECORD_SIZE ||
+        m_namesSize != m_indexSize - HEADER_SIZE - m_symbolCount * RECORD_SIZE ||
+        (m_namesSize > 0 && m_pIndex[m_indexSize - 1] != '\0'))
+    {
+        return MALFORMED;
+    }
+    m_pNames = (const char*)&m_pIndex[HEADER_SIZE + m_symbolCount * RECORD_SIZE];
+
+    /* findSymbol() relies on the addresses being in increasing order and every name being inside the name table. */
+    for (i = 0 ; i < m_symbolCount ; i++)
+    {
+        const uint8_t* pRecord = record(i);
+        uint32_t       address = readUInt32(&pRecord[0]);
+
+        if ((i > 0 && address <= previousAddress) || readUInt32(&pRecord[8]) >= m_namesSize)
+            return MALFORMED;
+        previousAddress = address;
+    }
+    return OK;
+}
+
+SymbolIndex::Result SymbolIndex::save(const char* pFilename) const
+{
+    FILE* pFile;
+    bool  isWritten;
+
+    /* An index which is only partly written by a failed save is the wrong size so load() will reject it. */
+    pFile = fopen(pFilename, "wb");
+    if (!pFile)
+        return OPEN_FAILED;
+    isWritten = fwrite(m_pIndex, 1, m_indexSize, pFile) == m_indexSize;
+    if (fclose(pFile) != 0 || !isWritten)
+        return OPEN_FAILED;
+    return OK;
+}
+
+SymbolIndex::Result SymbolIndex::loadOrBuild(const char* pFilename, const ElfImage& elf)
+{
+    Result result = load(pFilename, elf.fingerprint());
+
+    if (result == OK || result == OUT_OF_MEMORY)
+        return result;
+    result = build(elf);
+    if (result == OK)
+        save(pFilename);
+    return result;
+}
+
+void SymbolIndex::clear()
+{
+    free(m_pIndex);
+    m_pIndex = NULL;
+    m_indexSize = 0;
+    m_symbolCount = 0;
+    m_fingerprint = 0;
+    m_pNames = NULL;
+    m_namesSize = 0;
+}
+
+static uint32_t readUInt32(const uint8_t* pSrc)
+{
+    return pSrc[0] | (pSrc[1] << 8) | (pSrc[2] << 16) | ((uint32_t)pSrc[3] << 24);
+}
+
+static void writeUInt32(uint8_t* pDest, uint32_t value)
+{
+    pDest[0] = value & 0xFF;
+    pDest[1] = (value >> 8) & 0xFF;
+    pDest[2] = (value >> 16) & 0xFF;
+    pDest[3] = value >> 24;
+}
+
+
+uint64_t SymbolIndex::fingerprint() const
+{
+    return m_fingerprint;
+}
+
+size_t SymbolIndex::symbolCount() const
+{
+    return m_symbolCount;
+}
+
+SymbolIndex::Symbol SymbolIndex::symbol(size_t index) const
+{
+    const uint8_t* pRecord = record(index);
+    Symbol         symbol;
+
+    symbol.address = readUInt32(&pRecord[0]);
+    symbol.size = readUInt32(&pRecord[4]);
+    symbol.pName = m_pNames + readUInt32(&pRecord[8]);
+    return symbol;
+}
+
+bool SymbolIndex::findSymbol(uint32_t address, Symbol* pSymbol) const
+{
+    size_t low = 0;
+    size_t high = m_symbolCount;
+
+    /* Find the first symbol past address.  The one before it is the only one which can contain address. */
+    while (low < high)
+    {
+        size_t middle = low + (high - low) / 2;
+
+        if (readUInt32(record(middle)) <= address)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    if (low == 0)
+        return false;
+    *pSymbol = symbol(low - 1);
+    return pSymbol->size == 0 || address - pSymbol->address < pSymbol->size;
+}
+
+const uint8_t* SymbolIndex::record(size_t index) const
+{
+    return &m_pIndex[HEADER_SIZE + index * RECORD_SIZE];
+}
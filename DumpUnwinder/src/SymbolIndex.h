@@ -0,0 +1,92 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Table of the function symbols in a firmware image, sorted by address.  It is built from the ELF's symbol table once
+   and can then be saved to an index file next to the ELF so that later runs just load it instead of walking and
+   sorting the symbol table again. */
+#ifndef _SYMBOL_INDEX_H_
+#define _SYMBOL_INDEX_H_
+
+#include "ElfImage.h"
+
+
+class SymbolIndex
+{
+public:
+    enum Result
+    {
+        OK = 0,
+        /* The index file couldn't be opened, read or written. */
+        OPEN_FAILED,
+        /* The index file doesn't start with the expected signature and version. */
+        BAD_SIGNATURE,
+        /* The index file was built from a different ELF file than the one it is being loaded for. */
+        STALE,
+        /* The index file or ELF symbol table is the wrong size, unsorted or has names which run off its end. */
+        MALFORMED,
+        /* The index couldn't be allocated. */
+        OUT_OF_MEMORY
+    };
+
+    struct Symbol
+    {
+        /* Address of the function with the Thumb bit cleared. */
+        uint32_t    address;
+        /* Size of the function in bytes.  0 if the ELF didn't record it. */
+        uint32_t    size;
+        const char* pName;
+    };
+
+    SymbolIndex();
+    ~SymbolIndex();
+
+    /* Builds the index from the STT_FUNC symbols in the .symtab section of elf.  ELF files which have been stripped
+       give an empty index. */
+    Result build(const ElfImage& elf);
+    /* Loads an index file which was written by save().  Returns STALE if it wasn't built from an ELF file with the
+       given fingerprint. */
+    Result load(const char* pFilename, uint64_t expectedFingerprint);
+    Result save(const char* pFilename) const;
+    /* Loads the index file if it is up to date for elf.  Otherwise it is rebuilt from elf and saved back to the index
+       file.  Failing to save the index isn't an error since it will just be rebuilt again next time. */
+    Result loadOrBuild(const char* pFilename, const ElfImage& elf);
+    void   clear();
+
+    uint64_t fingerprint() const;
+    size_t   symbolCount() const;
+    Symbol   symbol(size_t index) const;
+    /* Finds the function which contains address.  Functions without a size are assumed to run up to the next
+       symbol.  Returns false if address is before the first function or past the end of the one before it. */
+    bool     findSymbol(uint32_t address, Symbol* pSymbol) const;
+
+private:
+    /* Copying would free the index twice. */
+    SymbolIndex(const SymbolIndex& other);
+    SymbolIndex& operator=(const SymbolIndex& other);
+
+    Result         validate();
+    const uint8_t* record(size_t index) const;
+
+    /* The index is kept in memory in the same little endian format as the index file. */
+    uint8_t*    m_pIndex;
+    size_t      m_indexSize;
+    size_t      m_symbolCount;
+    uint64_t    m_fingerprint;
+    /* Points to the name table at the end of m_pIndex. */
+    const char* m_pNames;
+    uint32_t    m_namesSize;
+};
+
+
+#endif /* _SYMBOL_INDEX_H_ */
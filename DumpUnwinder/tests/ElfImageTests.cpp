@@ -0,0 +1,216 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include <stdio.h>
+#include <string.h>
+
+// Include headers from modules under test.
+#include <ElfImage.h>
+#include "TestElf.h"
+
+// Include C++ headers for test harness.
+#include <CppUTest/TestHarness.h>
+
+
+static const char g_tempFilename[] = "ElfImageTests.elf";
+
+
+TEST_GROUP(ElfImage)
+{
+    TestElf  m_testElf;
+    ElfImage m_elf;
+    uint8_t  m_copy[32768];
+    size_t   m_size;
+
+    void setup()
+    {
+        m_size = 0;
+    }
+
+    void teardown()
+    {
+        m_elf.close();
+        remove(g_tempFilename);
+    }
+
+    // Builds the test ELF into m_copy so that tests can corrupt it.
+    void buildCopy()
+    {
+        const uint8_t* pElf = m_testElf.build(&m_size);
+
+        memcpy(m_copy, pElf, m_size);
+    }
+
+    ElfImage::Result parseCopy()
+    {
+        return m_elf.parse(m_copy, m_size);
+    }
+
+    void writeUInt32(size_t offset, uint32_t value)
+    {
+        m_copy[offset] = value & 0xFF;
+        m_copy[offset + 1] = (value >> 8) & 0xFF;
+        m_copy[offset + 2] = (value >> 16) & 0xFF;
+        m_copy[offset + 3] = value >> 24;
+    }
+
+    uint32_t readUInt32(size_t offset)
+    {
+        return m_copy[offset] | (m_copy[offset + 1] << 8) | (m_copy[offset + 2] << 16) |
+               ((uint32_t)m_copy[offset + 3] << 24);
+    }
+
+    size_t sectionHeaderOffset(size_t index)
+    {
+        return readUInt32(32) + index * 40;
+    }
+};
+
+
+TEST(ElfImage, EmptyFile_ShouldReturnBadHeader)
+{
+    CHECK_EQUAL(ElfImage::BAD_HEADER, m_elf.parse(m_copy, 0));
+    CHECK_EQUAL(0, m_elf.sectionCount());
+}
+
+TEST(ElfImage, NotElfOrNotArm32LittleEndian_ShouldReturnBadHeader)
+{
+    static const size_t offsets[] = { 0, 4, 5, 18 };
+
+    for (size_t i = 0 ; i < sizeof(offsets) / sizeof(offsets[0]) ; i++)
+    {
+        buildCopy();
+        m_copy[offsets[i]]++;
+        CHECK_EQUAL(ElfImage::BAD_HEADER, parseCopy());
+    }
+}
+
+TEST(ElfImage, ValidElf_ShouldFindSectionsByNameAndType)
+{
+    const ElfImage::Section* pText;
+    const ElfImage::Section* pExidx;
+
+    m_testElf.addExidxEntry(0x08000100, 1);
+    m_testElf.setEntryPoint(0x08000041);
+    buildCopy();
+    CHECK_EQUAL(ElfImage::OK, parseCopy());
+    CHECK_EQUAL(TEST_ELF_SECTION_COUNT, m_elf.sectionCount());
+    CHECK_EQUAL(0x08000041, m_elf.entryPoint());
+
+    pText = m_elf.findSection(".text");
+    CHECK_TRUE(pText != NULL);
+    POINTERS_EQUAL(&m_elf.section(TEST_ELF_TEXT_SECTION), pText);
+    CHECK_EQUAL(TEST_ELF_TEXT_ADDRESS, pText->address);
+    CHECK_EQUAL(TEST_ELF_TEXT_SIZE, pText->size);
+    CHECK_EQUAL(ElfImage::SHF_ALLOC | ElfImage::SHF_EXECINSTR, pText->flags);
+
+    pExidx = m_elf.findSectionOfType(ElfImage::SHT_ARM_EXIDX);
+    CHECK_TRUE(pExidx != NULL);
+    STRCMP_EQUAL(".ARM.exidx", pExidx->pName);
+    CHECK_EQUAL(8, pExidx->size);
+    POINTERS_EQUAL(NULL, m_elf.findSection(".data"));
+    POINTERS_EQUAL(NULL, m_elf.findSectionOfType(ElfImage::SHT_NOBITS));
+}
+
+TEST(ElfImage, FindBytes_ShouldOnlyReturnBytesFromOneAllocatedSection)
+{
+    static const uint16_t code[] = { 0xB510, 0xBD10 };
+    const uint8_t*        pBytes;
+
+    m_testElf.setCode(0x08000100, code, 2);
+    buildCopy();
+    CHECK_EQUAL(ElfImage::OK, parseCopy());
+    pBytes = m_elf.findBytes(0x08000100, 4);
+    CHECK_TRUE(pBytes != NULL);
+    CHECK_EQUAL(0x10, pBytes[0]);
+    CHECK_EQUAL(0xB5, pBytes[1]);
+    CHECK_EQUAL(0xBD, pBytes[3]);
+    CHECK_TRUE(m_elf.findBytes(TEST_ELF_TEXT_ADDRESS + TEST_ELF_TEXT_SIZE - 4, 4) != NULL);
+    POINTERS_EQUAL(NULL, m_elf.findBytes(TEST_ELF_TEXT_ADDRESS + TEST_ELF_TEXT_SIZE - 2, 4));
+    POINTERS_EQUAL(NULL, m_elf.findBytes(TEST_ELF_TEXT_ADDRESS - 2, 4));
+    // .symtab isn't loaded so its address of 0 doesn't count.
+    POINTERS_EQUAL(NULL, m_elf.findBytes(0x00000000, 4));
+}
+
+TEST(ElfImage, IsCodeAddress_ShouldOnlyBeTrueForExecutableSections)
+{
+    buildCopy();
+    CHECK_EQUAL(ElfImage::OK, parseCopy());
+    CHECK_TRUE(m_elf.isCodeAddress(TEST_ELF_TEXT_ADDRESS));
+    CHECK_TRUE(m_elf.isCodeAddress(TEST_ELF_TEXT_ADDRESS + TEST_ELF_TEXT_SIZE - 1));
+    CHECK_FALSE(m_elf.isCodeAddress(TEST_ELF_TEXT_ADDRESS + TEST_ELF_TEXT_SIZE));
+    CHECK_FALSE(m_elf.isCodeAddress(TEST_ELF_TEXT_ADDRESS - 1));
+    CHECK_FALSE(m_elf.isCodeAddress(TEST_ELF_EXIDX_ADDRESS));
+}
+
+TEST(ElfImage, SectionHeadersPastEndOfFile_ShouldReturnMalformed)
+{
+    buildCopy();
+    m_size -= 1;
+    CHECK_EQUAL(ElfImage::MALFORMED, parseCopy());
+}
+
+TEST(ElfImage, SectionDataPastEndOfFile_ShouldReturnMalformed)
+{
+    buildCopy();
+    writeUInt32(sectionHeaderOffset(TEST_ELF_TEXT_SECTION) + 20, m_size);
+    CHECK_EQUAL(ElfImage::MALFORMED, parseCopy());
+}
+
+TEST(ElfImage, SectionNamePastEndOfNameTable_ShouldReturnMalformed)
+{
+    buildCopy();
+    writeUInt32(sectionHeaderOffset(TEST_ELF_TEXT_SECTION), 0x1000);
+    CHECK_EQUAL(ElfImage::MALFORMED, parseCopy());
+}
+
+TEST(ElfImage, Fingerprint_ShouldChangeWithAnyByteOfFile)
+{
+    uint64_t fingerprint;
+
+    buildCopy();
+    CHECK_EQUAL(ElfImage::OK, parseCopy());
+    fingerprint = m_elf.fingerprint();
+    CHECK_TRUE(fingerprint != 0);
+    m_copy[0x100] ^= 1;
+    CHECK_EQUAL(ElfImage::OK, parseCopy());
+    CHECK_TRUE(fingerprint != m_elf.fingerprint());
+    m_copy[0x100] ^= 1;
+    CHECK_EQUAL(ElfImage::OK, parseCopy());
+    CHECK_TRUE(fingerprint == m_elf.fingerprint());
+}
+
+TEST(ElfImage, OpenFile_ShouldMatchParsingSameBytes)
+{
+    uint64_t fingerprint;
+    FILE*    pFile;
+
+    buildCopy();
+    CHECK_EQUAL(ElfImage::OK, parseCopy());
+    fingerprint = m_elf.fingerprint();
+    pFile = fopen(g_tempFilename, "wb");
+    CHECK_TRUE(pFile != NULL);
+    CHECK_EQUAL(m_size, fwrite(m_copy, 1, m_size, pFile));
+    fclose(pFile);
+
+    memset(m_copy, 0, sizeof(m_copy));
+    CHECK_EQUAL(ElfImage::OK, m_elf.open(g_tempFilename));
+    CHECK_TRUE(fingerprint == m_elf.fingerprint());
+    CHECK_TRUE(m_elf.findSection(".ARM.exidx") != NULL);
+}
+
+TEST(ElfImage, OpenMissingFile_ShouldReturnOpenFailed)
+{
+    CHECK_EQUAL(ElfImage::OPEN_FAILED, m_elf.open("ElfImageTestsMissing.elf"));
+}
@@ -0,0 +1,481 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include <string.h>
+
+// Include headers from modules under test.
+extern "C"
+{
+    #include <CrashCatcher.h>
+}
+#include <StackUnwinder.h>
+#include "TestElf.h"
+
+// Include C++ headers for test harness.
+#include <CppUTest/TestHarness.h>
+
+
+#define STACK_ADDRESS           0x20001000
+#define PROCESS_STACK_ADDRESS   0x20002000
+
+/* Functions in the test firmware.  Reset_Handler calls main, which calls func, which calls leaf. */
+#define RESET_HANDLER           0x08000000
+#define MAIN                    0x08000100
+#define FUNC                    0x08000200
+#define LEAF                    0x08000300
+#define ISR                     0x08000400
+#define BIG_FRAME               0x08000500
+#define FLOAT_FRAME             0x08000600
+#define PERSONALITY_ROUTINE     0x08000700
+
+/* Return addresses just past the BL in each caller, with the Thumb bit set. */
+#define RETURN_TO_RESET_HANDLER (RESET_HANDLER + 4 + 1)
+#define RETURN_TO_MAIN          (MAIN + 8 + 1)
+#define RETURN_TO_FUNC          (FUNC + 8 + 1)
+#define RETURN_TO_BIG_FRAME     (BIG_FRAME + 12 + 1)
+
+#define EXIDX_CANTUNWIND        1
+/* Inlined personality 0 instructions: vsp += 8, pop {r4-r7, lr} and finish. */
+#define FUNC_UNWIND_DATA        0x8001ABB0
+
+#define BL_HALFWORD1            0xF000
+#define BL_HALFWORD2            0xF800
+
+
+TEST_GROUP(StackUnwinder)
+{
+    TestElf                   m_testElf;
+    ElfImage                  m_elf;
+    SymbolIndex               m_symbols;
+    DumpReader                m_dump;
+    uint8_t                   m_dumpData[8192];
+    size_t                    m_dumpSize;
+    uint32_t                  m_registers[DumpReader::INTEGER_REGISTER_COUNT];
+    uint32_t                  m_stack[256];
+    size_t                    m_stackWordCount;
+    uint32_t                  m_processStack[64];
+    size_t                    m_processStackWordCount;
+    StackUnwinder::Frame      m_frames[16];
+    size_t                    m_frameCount;
+    StackUnwinder::StopReason m_stopReason;
+    DumpReader::Result        m_expectedParseResult;
+
+    void setup()
+    {
+        for (uint32_t i = 0 ; i < DumpReader::INTEGER_REGISTER_COUNT ; i++)
+            m_registers[i] = i;
+        m_registers[DumpReader::SP] = STACK_ADDRESS;
+        m_registers[DumpReader::XPSR] = 0x01000000;
+        m_registers[DumpReader::MSP] = STACK_ADDRESS;
+        m_registers[DumpReader::PSP] = PROCESS_STACK_ADDRESS;
+        m_stackWordCount = 0;
+        m_processStackWordCount = 0;
+        m_dumpSize = 0;
+        m_frameCount = 0;
+        m_expectedParseResult = DumpReader::OK;
+    }
+
+    void teardown()
+    {
+        m_dump.close();
+    }
+
+    // Adds Reset_Handler, main, func and leaf, with func's unwind instructions given by funcUnwindData.
+    void addProgram(uint32_t funcUnwindData = FUNC_UNWIND_DATA)
+    {
+        addProgramCode();
+        // The linker marks functions compiled without unwind tables as EXIDX_CANTUNWIND.
+        m_testElf.addExidxEntry(RESET_HANDLER, EXIDX_CANTUNWIND);
+        m_testElf.addExidxEntry(MAIN, EXIDX_CANTUNWIND);
+        m_testElf.addExidxEntry(FUNC, funcUnwindData);
+        m_testElf.addExidxEntry(LEAF, EXIDX_CANTUNWIND);
+    }
+
+    void addProgramCode()
+    {
+        // Reset_Handler: bl main
+        static const uint16_t resetHandler[] = { BL_HALFWORD1, BL_HALFWORD2 };
+        // main: push {r4, lr}; sub sp, #8; bl func
+        static const uint16_t main[] = { 0xB510, 0xB082, BL_HALFWORD1, BL_HALFWORD2 };
+        // func: push {r4-r7, lr}; sub sp, #8; bl leaf
+        static const uint16_t func[] = { 0xB5F0, 0xB082, BL_HALFWORD1, BL_HALFWORD2 };
+        // leaf: push {r4}; ldr r0, [r0]; pop {r4}; bx lr
+        static const uint16_t leaf[] = { 0xB410, 0x6800, 0xBC10, 0x4770 };
+
+        m_testElf.setCode(RESET_HANDLER, resetHandler, sizeof(resetHandler) / sizeof(resetHandler[0]));
+        m_testElf.setCode(MAIN, main, sizeof(main) / sizeof(main[0]));
+        m_testElf.setCode(FUNC, func, sizeof(func) / sizeof(func[0]));
+        m_testElf.setCode(LEAF, leaf, sizeof(leaf) / sizeof(leaf[0]));
+        m_testElf.addFunction("Reset_Handler", RESET_HANDLER, 0x10);
+        m_testElf.addFunction("main", MAIN, 0x20);
+        m_testElf.addFunction("func", FUNC, 0x20);
+        m_testElf.addFunction("leaf", LEAF, 0x10);
+        m_testElf.setEntryPoint(RESET_HANDLER | 1);
+    }
+
+    void pushStack(uint32_t word)
+    {
+        CHECK_TRUE(m_stackWordCount < sizeof(m_stack) / sizeof(m_stack[0]));
+        m_stack[m_stackWordCount++] = word;
+    }
+
+    void pushProcessStack(uint32_t word)
+    {
+        CHECK_TRUE(m_processStackWordCount < sizeof(m_processStack) / sizeof(m_processStack[0]));
+        m_processStack[m_processStackWordCount++] = word;
+    }
+
+    void pushWords(uint32_t* pStack, size_t* pWordCount, uint32_t word, size_t count)
+    {
+        for (size_t i = 0 ; i < count ; i++)
+            pStack[(*pWordCount)++] = word;
+    }
+
+    // Pushes the frames of leaf, func and main as they would be when leaf crashed.
+    void pushLeafFuncAndMainFrames(uint32_t* pStack, size_t* pWordCount)
+    {
+        // leaf: r4
+        pStack[(*pWordCount)++] = 0x44444444;
+        pushFuncAndMainFrames(pStack, pWordCount);
+    }
+
+    void pushFuncAndMainFrames(uint32_t* pStack, size_t* pWordCount)
+    {
+        // func: locals, r4-r7, lr
+        pushWords(pStack, pWordCount, 0xF00DF00D, 2);
+        pStack[(*pWordCount)++] = 0x4;
+        pStack[(*pWordCount)++] = 0x5;
+        pStack[(*pWordCount)++] = 0x6;
+        pStack[(*pWordCount)++] = 0x7;
+        pStack[(*pWordCount)++] = RETURN_TO_MAIN;
+        pushMainFrame(pStack, pWordCount);
+    }
+
+    void pushMainFrame(uint32_t* pStack, size_t* pWordCount)
+    {
+        // main: locals, r4, lr
+        pushWords(pStack, pWordCount, 0xBAADF00D, 2);
+        pStack[(*pWordCount)++] = 0x4;
+        pStack[(*pWordCount)++] = RETURN_TO_RESET_HANDLER;
+    }
+
+    void setCrash(uint32_t pc, uint32_t lr)
+    {
+        m_registers[DumpReader::PC] = pc;
+        m_registers[DumpReader::LR] = lr;
+    }
+
+    void appendByte(uint8_t byte)
+    {
+        CHECK_TRUE(m_dumpSize < sizeof(m_dumpData));
+        m_dumpData[m_dumpSize++] = byte;
+    }
+
+    void appendWord(uint32_t word)
+    {
+        appendByte(word & 0xFF);
+        appendByte((word >> 8) & 0xFF);
+        appendByte((word >> 16) & 0xFF);
+        appendByte(word >> 24);
+    }
+
+    void appendRegion(uint32_t address, const uint32_t* pWords, size_t wordCount)
+    {
+        appendWord(address);
+        appendWord(address + wordCount * sizeof(uint32_t));
+        for (size_t i = 0 ; i < wordCount ; i++)
+            appendWord(pWords[i]);
+    }
+
+    void buildDump()
+    {
+        m_dumpSize = 0;
+        appendByte(CRASH_CATCHER_SIGNATURE_BYTE0);
+        appendByte(CRASH_CATCHER_SIGNATURE_BYTE1);
+        appendByte(CRASH_CATCHER_VERSION_MAJOR);
+        appendByte(CRASH_CATCHER_VERSION_MINOR);
+        appendWord(0);
+        for (uint32_t i = 0 ; i < DumpReader::INTEGER_REGISTER_COUNT ; i++)
+            appendWord(m_registers[i]);
+        if (m_stackWordCount)
+            appendRegion(STACK_ADDRESS, m_stack, m_stackWordCount);
+        if (m_processStackWordCount)
+            appendRegion(PROCESS_STACK_ADDRESS, m_processStack, m_processStackWordCount);
+    }
+
+    void unwind(size_t maxFrames = sizeof(m_frames) / sizeof(m_frames[0]))
+    {
+        const uint8_t* pElf;
+        size_t         elfSize;
+
+        pElf = m_testElf.build(&elfSize);
+        CHECK_EQUAL(ElfImage::OK, m_elf.parse(pElf, elfSize));
+        CHECK_EQUAL(SymbolIndex::OK, m_symbols.build(m_elf));
+        if (m_dumpSize == 0)
+            buildDump();
+        CHECK_EQUAL(m_expectedParseResult, m_dump.parse(m_dumpData, m_dumpSize));
+
+        StackUnwinder unwinder(m_elf, m_symbols);
+        m_frameCount = unwinder.unwind(m_dump, m_frames, maxFrames, &m_stopReason);
+    }
+
+    void validateFrame(size_t index, uint32_t expectedPc, uint32_t expectedSp, StackUnwinder::FrameType expectedType)
+    {
+        CHECK_TRUE(index < m_frameCount);
+        CHECK_EQUAL(expectedPc, m_frames[index].pc);
+        CHECK_EQUAL(expectedSp, m_frames[index].sp);
+        CHECK_EQUAL(expectedType, m_frames[index].type);
+    }
+
+    // Validates the frames for main and Reset_Handler which end most of the tests.
+    void validateMainAndResetFrames(size_t index, uint32_t mainSp, StackUnwinder::FrameType mainType)
+    {
+        validateFrame(index, RETURN_TO_MAIN & ~1, mainSp, mainType);
+        validateFrame(index + 1, RETURN_TO_RESET_HANDLER & ~1, mainSp + 16, StackUnwinder::FRAME_PROLOGUE);
+        CHECK_EQUAL(index + 2, m_frameCount);
+        CHECK_EQUAL(StackUnwinder::STOP_END_OF_STACK, m_stopReason);
+    }
+};
+
+
+TEST(StackUnwinder, DumpWithoutRegisters_ShouldReturnNoFrames)
+{
+    addProgram();
+    buildDump();
+    m_dumpSize = 16;
+    m_expectedParseResult = DumpReader::TRUNCATED;
+    unwind();
+    CHECK_EQUAL(0, m_frameCount);
+    CHECK_EQUAL(StackUnwinder::STOP_NO_REGISTERS, m_stopReason);
+}
+
+TEST(StackUnwinder, CrashInLeaf_ShouldUnwindWithPrologueThenExidxBackToResetHandler)
+{
+    addProgram();
+    pushLeafFuncAndMainFrames(m_stack, &m_stackWordCount);
+    setCrash(LEAF + 2, RETURN_TO_FUNC);
+    unwind();
+    validateFrame(0, LEAF + 2, STACK_ADDRESS, StackUnwinder::FRAME_CRASH);
+    validateFrame(1, RETURN_TO_FUNC & ~1, STACK_ADDRESS + 4, StackUnwinder::FRAME_PROLOGUE);
+    validateMainAndResetFrames(2, STACK_ADDRESS + 0x20, StackUnwinder::FRAME_EXIDX);
+}
+
+TEST(StackUnwinder, FrameArrayFillsUp_ShouldStopWithMaxFrames)
+{
+    addProgram();
+    pushLeafFuncAndMainFrames(m_stack, &m_stackWordCount);
+    setCrash(LEAF + 2, RETURN_TO_FUNC);
+    unwind(2);
+    CHECK_EQUAL(2, m_frameCount);
+    CHECK_EQUAL(StackUnwinder::STOP_MAX_FRAMES, m_stopReason);
+    validateFrame(1, RETURN_TO_FUNC & ~1, STACK_ADDRESS + 4, StackUnwinder::FRAME_PROLOGUE);
+}
+
+TEST(StackUnwinder, StrippedElf_ShouldFindFunctionStartsFromExidx)
+{
+    addProgram();
+    m_testElf.strip();
+    pushLeafFuncAndMainFrames(m_stack, &m_stackWordCount);
+    setCrash(LEAF + 2, RETURN_TO_FUNC);
+    unwind();
+    validateFrame(1, RETURN_TO_FUNC & ~1, STACK_ADDRESS + 4, StackUnwinder::FRAME_PROLOGUE);
+    validateMainAndResetFrames(2, STACK_ADDRESS + 0x20, StackUnwinder::FRAME_EXIDX);
+}
+
+TEST(StackUnwinder, CrashPartWayThroughPrologue_ShouldSimulateItInsteadOfUsingExidx)
+{
+    addProgram();
+    // func has only pushed r4-r7 and lr so far.
+    pushStack(0x4);
+    pushStack(0x5);
+    pushStack(0x6);
+    pushStack(0x7);
+    pushStack(RETURN_TO_MAIN);
+    pushMainFrame(m_stack, &m_stackWordCount);
+    setCrash(FUNC + 2, 0xDEADBEEF);
+    unwind();
+    validateFrame(0, FUNC + 2, STACK_ADDRESS, StackUnwinder::FRAME_CRASH);
+    validateMainAndResetFrames(1, STACK_ADDRESS + 0x14, StackUnwinder::FRAME_PROLOGUE);
+}
+
+TEST(StackUnwinder, CallThroughNullFunctionPointer_ShouldReturnToLinkRegister)
+{
+    addProgram();
+    pushMainFrame(m_stack, &m_stackWordCount);
+    setCrash(0x00000000, RETURN_TO_MAIN);
+    unwind();
+    validateFrame(0, 0x00000000, STACK_ADDRESS, StackUnwinder::FRAME_CRASH);
+    validateMainAndResetFrames(1, STACK_ADDRESS, StackUnwinder::FRAME_LINK_REGISTER);
+}
+
+TEST(StackUnwinder, CrashInHandlerWhichInterruptedThread_ShouldContinueOnProcessStack)
+{
+    // ISR: push {r4, lr}; ldr r0, [r0]
+    static const uint16_t isr[] = { 0xB510, 0x6800 };
+
+    addProgram();
+    m_testElf.setCode(ISR, isr, sizeof(isr) / sizeof(isr[0]));
+    m_testElf.addFunction("ISR", ISR, 0x10);
+    pushStack(0x44444444);
+    pushStack(0xFFFFFFFD);
+    // Basic exception frame stacked when leaf was interrupted: r0-r3, r12, lr, pc and xPSR.
+    pushWords(m_processStack, &m_processStackWordCount, 0, 5);
+    pushProcessStack(RETURN_TO_FUNC);
+    pushProcessStack(LEAF + 2);
+    pushProcessStack(0x01000000);
+    pushLeafFuncAndMainFrames(m_processStack, &m_processStackWordCount);
+    setCrash(ISR + 2, 0xFFFFFFFD);
+    unwind();
+    validateFrame(0, ISR + 2, STACK_ADDRESS, StackUnwinder::FRAME_CRASH);
+    validateFrame(1, LEAF + 2, PROCESS_STACK_ADDRESS + 0x20, StackUnwinder::FRAME_EXCEPTION);
+    validateFrame(2, RETURN_TO_FUNC & ~1, PROCESS_STACK_ADDRESS + 0x24, StackUnwinder::FRAME_PROLOGUE);
+    validateMainAndResetFrames(3, PROCESS_STACK_ADDRESS + 0x40, StackUnwinder::FRAME_EXIDX);
+}
+
+TEST(StackUnwinder, ExtendedExceptionFrameWithAlignmentPadding_ShouldSkipFloatsAndPadding)
+{
+    static const uint16_t isr[] = { 0xB510, 0x6800 };
+
+    addProgram();
+    m_testElf.setCode(ISR, isr, sizeof(isr) / sizeof(isr[0]));
+    m_testElf.addFunction("ISR", ISR, 0x10);
+    pushStack(0x44444444);
+    pushStack(0xFFFFFFE9);
+    // main was interrupted just before its call to func, on the main stack.
+    pushWords(m_stack, &m_stackWordCount, 0, 5);
+    pushStack(RETURN_TO_RESET_HANDLER);
+    pushStack(MAIN + 4);
+    pushStack(0x01000200);
+    pushWords(m_stack, &m_stackWordCount, 0x3F800000, 18);
+    pushWords(m_stack, &m_stackWordCount, 0xFFFFFFFF, 1);
+    pushMainFrame(m_stack, &m_stackWordCount);
+    setCrash(ISR + 2, 0xFFFFFFE9);
+    unwind();
+    validateFrame(1, MAIN + 4, STACK_ADDRESS + 8 + 0x6C, StackUnwinder::FRAME_EXCEPTION);
+    validateFrame(2, RETURN_TO_RESET_HANDLER & ~1, STACK_ADDRESS + 8 + 0x6C + 16, StackUnwinder::FRAME_PROLOGUE);
+    CHECK_EQUAL(3, m_frameCount);
+    CHECK_EQUAL(StackUnwinder::STOP_END_OF_STACK, m_stopReason);
+}
+
+TEST(StackUnwinder, ExtabWithPersonality1_ShouldRunLongUnwindInstructions)
+{
+    // BIG_FRAME: push.w {r7, lr}; subw sp, sp, #0x208; bl leaf
+    static const uint16_t bigFrame[] = { 0xE92D, 0x4080, 0xF2AD, 0x2D08, BL_HALFWORD1, BL_HALFWORD2 };
+    // Personality 1 with 1 extra word: vsp += 0x204 + (1 << 2); pop {r7, lr}; finish.
+    static const uint32_t extab[] = { 0x8101B201, 0x8408B0B0 };
+
+    addProgram();
+    m_testElf.setCode(BIG_FRAME, bigFrame, sizeof(bigFrame) / sizeof(bigFrame[0]));
+    m_testElf.addFunction("bigFrame", BIG_FRAME, 0x20);
+    m_testElf.addExtabEntry(BIG_FRAME, extab, sizeof(extab) / sizeof(extab[0]));
+    pushStack(0x44444444);
+    pushWords(m_stack, &m_stackWordCount, 0, 0x208 / 4);
+    pushStack(0x7);
+    pushStack(RETURN_TO_MAIN);
+    pushMainFrame(m_stack, &m_stackWordCount);
+    setCrash(LEAF + 2, RETURN_TO_BIG_FRAME);
+    unwind();
+    validateFrame(1, RETURN_TO_BIG_FRAME & ~1, STACK_ADDRESS + 4, StackUnwinder::FRAME_PROLOGUE);
+    validateMainAndResetFrames(2, STACK_ADDRESS + 4 + 0x208 + 8, StackUnwinder::FRAME_EXIDX);
+}
+
+TEST(StackUnwinder, WideInstructionsWithoutExidx_ShouldFallBackToPrologueAnalysis)
+{
+    static const uint16_t bigFrame[] = { 0xE92D, 0x4080, 0xF2AD, 0x2D08, BL_HALFWORD1, BL_HALFWORD2 };
+
+    addProgram();
+    m_testElf.setCode(BIG_FRAME, bigFrame, sizeof(bigFrame) / sizeof(bigFrame[0]));
+    m_testElf.addFunction("bigFrame", BIG_FRAME, 0x20);
+    m_testElf.addExidxEntry(BIG_FRAME, EXIDX_CANTUNWIND);
+    pushStack(0x44444444);
+    pushWords(m_stack, &m_stackWordCount, 0, 0x208 / 4);
+    pushStack(0x7);
+    pushStack(RETURN_TO_MAIN);
+    pushMainFrame(m_stack, &m_stackWordCount);
+    setCrash(LEAF + 2, RETURN_TO_BIG_FRAME);
+    unwind();
+    validateMainAndResetFrames(2, STACK_ADDRESS + 4 + 0x208 + 8, StackUnwinder::FRAME_PROLOGUE);
+}
+
+TEST(StackUnwinder, CrashAfterVpushAndModifiedImmediateSub_ShouldAddUpWholeFrame)
+{
+    // FLOAT_FRAME: push {r4, lr}; vpush {d8-d9}; sub.w sp, sp, #0x100; ldr r0, [r0]
+    static const uint16_t floatFrame[] = { 0xB510, 0xED2D, 0x8B04, 0xF5AD, 0x7D80, 0x6800 };
+
+    addProgram();
+    m_testElf.setCode(FLOAT_FRAME, floatFrame, sizeof(floatFrame) / sizeof(floatFrame[0]));
+    m_testElf.addFunction("floatFrame", FLOAT_FRAME, 0x20);
+    pushWords(m_stack, &m_stackWordCount, 0, (0x100 + 16) / 4);
+    pushStack(0x4);
+    pushStack(RETURN_TO_MAIN);
+    pushMainFrame(m_stack, &m_stackWordCount);
+    setCrash(FLOAT_FRAME + 10, 0xDEADBEEF);
+    unwind();
+    validateMainAndResetFrames(1, STACK_ADDRESS + 0x118, StackUnwinder::FRAME_PROLOGUE);
+}
+
+TEST(StackUnwinder, GenericPersonalityRoutine_ShouldUseGccUnwindInstructions)
+{
+    // Pointer to the personality routine followed by no extra words and func's unwind instructions.
+    uint32_t extab[] = { (PERSONALITY_ROUTINE - TEST_ELF_EXTAB_ADDRESS) & 0x7FFFFFFF, 0x0001ABB0 };
+
+    addProgramCode();
+    m_testElf.addExidxEntry(RESET_HANDLER, EXIDX_CANTUNWIND);
+    m_testElf.addExidxEntry(MAIN, EXIDX_CANTUNWIND);
+    m_testElf.addExtabEntry(FUNC, extab, sizeof(extab) / sizeof(extab[0]));
+    m_testElf.addExidxEntry(LEAF, EXIDX_CANTUNWIND);
+    pushLeafFuncAndMainFrames(m_stack, &m_stackWordCount);
+    setCrash(LEAF + 2, RETURN_TO_FUNC);
+    unwind();
+    validateMainAndResetFrames(2, STACK_ADDRESS + 0x20, StackUnwinder::FRAME_EXIDX);
+}
+
+TEST(StackUnwinder, RefuseToUnwindInstruction_ShouldStopWithBadUnwindInfo)
+{
+    addProgram(0x808000B0);
+    pushLeafFuncAndMainFrames(m_stack, &m_stackWordCount);
+    setCrash(LEAF + 2, RETURN_TO_FUNC);
+    unwind();
+    CHECK_EQUAL(2, m_frameCount);
+    CHECK_EQUAL(StackUnwinder::STOP_BAD_UNWIND_INFO, m_stopReason);
+}
+
+TEST(StackUnwinder, StackCutShortInDump_ShouldStopWithMissingStack)
+{
+    addProgram();
+    pushLeafFuncAndMainFrames(m_stack, &m_stackWordCount);
+    m_stackWordCount = 4;
+    setCrash(LEAF + 2, RETURN_TO_FUNC);
+    unwind();
+    CHECK_EQUAL(2, m_frameCount);
+    CHECK_EQUAL(StackUnwinder::STOP_MISSING_STACK, m_stopReason);
+}
+
+TEST(StackUnwinder, ReturnAddressOutsideOfCode_ShouldStopWithBadFrame)
+{
+    addProgram();
+    pushLeafFuncAndMainFrames(m_stack, &m_stackWordCount);
+    m_stack[7] = 0x20000001;
+    setCrash(LEAF + 2, RETURN_TO_FUNC);
+    unwind();
+    CHECK_EQUAL(2, m_frameCount);
+    CHECK_EQUAL(StackUnwinder::STOP_BAD_FRAME, m_stopReason);
+}
+
+TEST(StackUnwinder, StopReasonString_ShouldDescribeEachReason)
+{
+    STRCMP_EQUAL("end of stack", StackUnwinder::stopReasonString(StackUnwinder::STOP_END_OF_STACK));
+    STRCMP_EQUAL("corrupt stack frame", StackUnwinder::stopReasonString(StackUnwinder::STOP_BAD_FRAME));
+    STRCMP_EQUAL("unknown stop reason", StackUnwinder::stopReasonString((StackUnwinder::StopReason)-1));
+}
@@ -0,0 +1,267 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include <stdio.h>
+#include <string.h>
+
+// Include headers from modules under test.
+#include <SymbolIndex.h>
+#include "TestElf.h"
+
+// Include C++ headers for test harness.
+#include <CppUTest/TestHarness.h>
+
+
+static const char g_tempFilename[] = "SymbolIndexTests.idx";
+
+
+TEST_GROUP(SymbolIndex)
+{
+    TestElf     m_testElf;
+    ElfImage    m_elf;
+    SymbolIndex m_index;
+
+    void setup()
+    {
+    }
+
+    void teardown()
+    {
+        m_index.clear();
+        m_elf.close();
+        remove(g_tempFilename);
+    }
+
+    void parseElf()
+    {
+        const uint8_t* pElf;
+        size_t         size;
+
+        pElf = m_testElf.build(&size);
+        CHECK_EQUAL(ElfImage::OK, m_elf.parse(pElf, size));
+    }
+
+    void addTestFunctions()
+    {
+        m_testElf.addFunction("main", 0x08000200, 0x40);
+        m_testElf.addFunction("Reset_Handler", 0x08000000, 0x10);
+        m_testElf.addFunction("sizeless", 0x08000300, 0);
+        m_testElf.addFunction("last", 0x08000400, 0x20);
+    }
+
+    void buildIndex()
+    {
+        parseElf();
+        CHECK_EQUAL(SymbolIndex::OK, m_index.build(m_elf));
+    }
+
+    void validateSymbol(size_t index, uint32_t expectedAddress, uint32_t expectedSize, const char* pExpectedName)
+    {
+        SymbolIndex::Symbol symbol;
+
+        CHECK_TRUE(index < m_index.symbolCount());
+        symbol = m_index.symbol(index);
+        CHECK_EQUAL(expectedAddress, symbol.address);
+        CHECK_EQUAL(expectedSize, symbol.size);
+        STRCMP_EQUAL(pExpectedName, symbol.pName);
+    }
+
+    void validateFind(uint32_t address, const char* pExpectedName)
+    {
+        SymbolIndex::Symbol symbol;
+
+        if (pExpectedName == NULL)
+        {
+            CHECK_FALSE(m_index.findSymbol(address, &symbol));
+            return;
+        }
+        CHECK_TRUE(m_index.findSymbol(address, &symbol));
+        STRCMP_EQUAL(pExpectedName, symbol.pName);
+    }
+
+    void writeFile(const void* pData, size_t size)
+    {
+        FILE* pFile = fopen(g_tempFilename, "wb");
+
+        CHECK_TRUE(pFile != NULL);
+        CHECK_EQUAL(size, fwrite(pData, 1, size, pFile));
+        fclose(pFile);
+    }
+
+    size_t readFile(void* pData, size_t size)
+    {
+        FILE*  pFile = fopen(g_tempFilename, "rb");
+        size_t bytesRead;
+
+        CHECK_TRUE(pFile != NULL);
+        bytesRead = fread(pData, 1, size, pFile);
+        fclose(pFile);
+        return bytesRead;
+    }
+};
+
+
+TEST(SymbolIndex, StrippedElf_ShouldBuildEmptyIndex)
+{
+    SymbolIndex::Symbol symbol;
+
+    addTestFunctions();
+    m_testElf.strip();
+    buildIndex();
+    CHECK_EQUAL(0, m_index.symbolCount());
+    CHECK_FALSE(m_index.findSymbol(0x08000200, &symbol));
+}
+
+TEST(SymbolIndex, Build_ShouldSortFunctionsByAddressAndClearThumbBit)
+{
+    addTestFunctions();
+    buildIndex();
+    CHECK_EQUAL(4, m_index.symbolCount());
+    validateSymbol(0, 0x08000000, 0x10, "Reset_Handler");
+    validateSymbol(1, 0x08000200, 0x40, "main");
+    validateSymbol(2, 0x08000300, 0, "sizeless");
+    validateSymbol(3, 0x08000400, 0x20, "last");
+    CHECK_TRUE(m_elf.fingerprint() == m_index.fingerprint());
+}
+
+TEST(SymbolIndex, Build_ShouldSkipObjectsAndUndefinedFunctions)
+{
+    m_testElf.addSymbol("g_buffer", 0x20000000, 0x100, STT_OBJECT, STB_GLOBAL, TEST_ELF_TEXT_SECTION);
+    m_testElf.addSymbol("externalFunction", 0, 0, STT_FUNC, STB_GLOBAL, 0);
+    m_testElf.addFunction("main", 0x08000200, 0x40);
+    buildIndex();
+    CHECK_EQUAL(1, m_index.symbolCount());
+    validateSymbol(0, 0x08000200, 0x40, "main");
+}
+
+TEST(SymbolIndex, Build_ShouldKeepOnlyOneAliasPreferringGlobalNames)
+{
+    m_testElf.addSymbol("localAlias", 0x08000201, 0x40, STT_FUNC, STB_LOCAL, TEST_ELF_TEXT_SECTION);
+    m_testElf.addFunction("globalName", 0x08000200, 0x40);
+    m_testElf.addFunction("secondGlobalName", 0x08000200, 0x40);
+    buildIndex();
+    CHECK_EQUAL(1, m_index.symbolCount());
+    validateSymbol(0, 0x08000200, 0x40, "globalName");
+}
+
+TEST(SymbolIndex, FindSymbol_ShouldUseSizeWhenKnownAndNextSymbolOtherwise)
+{
+    addTestFunctions();
+    buildIndex();
+    validateFind(0x07FFFFFE, NULL);
+    validateFind(0x08000000, "Reset_Handler");
+    validateFind(0x0800000F, "Reset_Handler");
+    validateFind(0x08000010, NULL);
+    validateFind(0x0800023E, "main");
+    validateFind(0x08000240, NULL);
+    validateFind(0x08000300, "sizeless");
+    validateFind(0x080003FE, "sizeless");
+    validateFind(0x0800041E, "last");
+    validateFind(0x08000420, NULL);
+}
+
+TEST(SymbolIndex, SaveAndLoad_ShouldRoundTripIndex)
+{
+    SymbolIndex loaded;
+
+    addTestFunctions();
+    buildIndex();
+    CHECK_EQUAL(SymbolIndex::OK, m_index.save(g_tempFilename));
+    CHECK_EQUAL(SymbolIndex::OK, loaded.load(g_tempFilename, m_elf.fingerprint()));
+    CHECK_EQUAL(m_index.symbolCount(), loaded.symbolCount());
+    CHECK_TRUE(m_index.fingerprint() == loaded.fingerprint());
+    for (size_t i = 0 ; i < m_index.symbolCount() ; i++)
+    {
+        CHECK_EQUAL(m_index.symbol(i).address, loaded.symbol(i).address);
+        CHECK_EQUAL(m_index.symbol(i).size, loaded.symbol(i).size);
+        STRCMP_EQUAL(m_index.symbol(i).pName, loaded.symbol(i).pName);
+    }
+}
+
+TEST(SymbolIndex, LoadWithDifferentFingerprint_ShouldReturnStale)
+{
+    addTestFunctions();
+    buildIndex();
+    CHECK_EQUAL(SymbolIndex::OK, m_index.save(g_tempFilename));
+    CHECK_EQUAL(SymbolIndex::STALE, m_index.load(g_tempFilename, m_elf.fingerprint() + 1));
+    CHECK_EQUAL(0, m_index.symbolCount());
+}
+
+TEST(SymbolIndex, LoadMissingFile_ShouldReturnOpenFailed)
+{
+    CHECK_EQUAL(SymbolIndex::OPEN_FAILED, m_index.load("SymbolIndexTestsMissing.idx", 0));
+}
+
+TEST(SymbolIndex, LoadCorruptFiles_ShouldReturnBadSignatureOrMalformed)
+{
+    uint8_t index[1024];
+    size_t  size;
+
+    addTestFunctions();
+    buildIndex();
+    CHECK_EQUAL(SymbolIndex::OK, m_index.save(g_tempFilename));
+    size = readFile(index, sizeof(index));
+
+    // Wrong signature and then wrong version.
+    index[0] = 'X';
+    writeFile(index, size);
+    CHECK_EQUAL(SymbolIndex::BAD_SIGNATURE, m_index.load(g_tempFilename, m_elf.fingerprint()));
+    index[0] = 'c';
+    index[4] = 2;
+    writeFile(index, size);
+    CHECK_EQUAL(SymbolIndex::BAD_SIGNATURE, m_index.load(g_tempFilename, m_elf.fingerprint()));
+    index[4] = 1;
+
+    // Partially written.
+    writeFile(index, size - 1);
+    CHECK_EQUAL(SymbolIndex::MALFORMED, m_index.load(g_tempFilename, m_elf.fingerprint()));
+
+    // Symbols out of order.
+    memcpy(&index[24], &index[36], 4);
+    writeFile(index, size);
+    CHECK_EQUAL(SymbolIndex::MALFORMED, m_index.load(g_tempFilename, m_elf.fingerprint()));
+}
+
+TEST(SymbolIndex, LoadOrBuildWithoutIndexFile_ShouldBuildAndSaveIt)
+{
+    SymbolIndex loaded;
+
+    addTestFunctions();
+    parseElf();
+    CHECK_EQUAL(SymbolIndex::OK, m_index.loadOrBuild(g_tempFilename, m_elf));
+    CHECK_EQUAL(4, m_index.symbolCount());
+    CHECK_EQUAL(SymbolIndex::OK, loaded.load(g_tempFilename, m_elf.fingerprint()));
+    CHECK_EQUAL(4, loaded.symbolCount());
+}
+
+TEST(SymbolIndex, LoadOrBuildWithStaleIndexFile_ShouldRebuildAndReplaceIt)
+{
+    TestElf        oldElf;
+    ElfImage       oldImage;
+    const uint8_t* pOldElf;
+    size_t         oldSize;
+
+    oldElf.addFunction("oldFunction", 0x08000100, 0x10);
+    pOldElf = oldElf.build(&oldSize);
+    CHECK_EQUAL(ElfImage::OK, oldImage.parse(pOldElf, oldSize));
+    CHECK_EQUAL(SymbolIndex::OK, m_index.loadOrBuild(g_tempFilename, oldImage));
+    validateSymbol(0, 0x08000100, 0x10, "oldFunction");
+
+    addTestFunctions();
+    parseElf();
+    CHECK_EQUAL(SymbolIndex::OK, m_index.loadOrBuild(g_tempFilename, m_elf));
+    CHECK_EQUAL(4, m_index.symbolCount());
+    CHECK_EQUAL(SymbolIndex::OK, m_index.load(g_tempFilename, m_elf.fingerprint()));
+    CHECK_EQUAL(4, m_index.symbolCount());
+}
@@ -0,0 +1,238 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include <string.h>
+#include "TestElf.h"
+
+
+#define SHT_PROGBITS        1
+#define SHT_SYMTAB          2
+#define SHT_STRTAB          3
+#define SHT_ARM_EXIDX       0x70000001
+#define SHF_ALLOC           0x2
+#define SHF_EXECINSTR       0x4
+#define SHF_LINK_ORDER      0x80
+
+
+static void writeUInt32(uint8_t* pDest, uint32_t value);
+static void writeUInt16(uint8_t* pDest, uint16_t value);
+static uint32_t encodePrel31(uint32_t target, uint32_t place);
+
+
+TestElf::TestElf()
+{
+    memset(m_text, 0, sizeof(m_text));
+    m_elfSize = 0;
+    m_extabCount = 0;
+    m_exidxCount = 0;
+    /* The first symbol is always the undefined symbol and the first name is always the empty string. */
+    memset(m_symbols, 0, 16);
+    m_symbolsSize = 16;
+    m_names[0] = '\0';
+    m_namesSize = 1;
+    m_entryPoint = TEST_ELF_TEXT_ADDRESS | 1;
+    m_isStripped = false;
+}
+
+void TestElf::setEntryPoint(uint32_t address)
+{
+    m_entryPoint = address;
+}
+
+void TestElf::setCode(uint32_t address, const uint16_t* pHalfWords, size_t count)
+{
+    uint8_t* pDest = &m_text[address - TEST_ELF_TEXT_ADDRESS];
+    size_t   i;
+
+    for (i = 0 ; i < count ; i++)
+        writeUInt16(pDest + i * 2, pHalfWords[i]);
+}
+
+void TestElf::addFunction(const char* pName, uint32_t address, uint32_t size)
+{
+    addSymbol(pName, address | 1, size, STT_FUNC, STB_GLOBAL, TEST_ELF_TEXT_SECTION);
+}
+
+void TestElf::addSymbol(const char* pName, uint32_t value, uint32_t size, uint8_t type, uint8_t binding,
+                        uint16_t sectionIndex)
+{
+    uint8_t* pSymbol = &m_symbols[m_symbolsSize];
+
+    writeUInt32(&pSymbol[0], addName(m_names, &m_namesSize, pName));
+    writeUInt32(&pSymbol[4], value);
+    writeUInt32(&pSymbol[8], size);
+    pSymbol[12] = (binding << 4) | type;
+    pSymbol[13] = 0;
+    writeUInt16(&pSymbol[14], sectionIndex);
+    m_symbolsSize += 16;
+}
+
+void TestElf::strip()
+{
+    m_isStripped = true;
+}
+
+void TestElf::addExidxEntry(uint32_t functionAddress, uint32_t data)
+{
+    uint32_t place = TEST_ELF_EXIDX_ADDRESS + m_exidxCount * sizeof(uint32_t);
+
+    m_exidx[m_exidxCount++] = encodePrel31(functionAddress, place);
+    m_exidx[m_exidxCount++] = data;
+}
+
+void TestElf::addExtabEntry(uint32_t functionAddress, const uint32_t* pWords, size_t wordCount)
+{
+    uint32_t extabAddress = TEST_ELF_EXTAB_ADDRESS + m_extabCount * sizeof(uint32_t);
+
+    memcpy(&m_extab[m_extabCount], pWords, wordCount * sizeof(uint32_t));
+    m_extabCount += wordCount;
+    addExidxEntry(functionAddress, 0);
+    m_exidx[m_exidxCount - 1] = encodePrel31(extabAddress, TEST_ELF_EXIDX_ADDRESS +
+                                                           (m_exidxCount - 1) * sizeof(uint32_t));
+}
+
+const uint8_t* TestElf::build(size_t* pSize)
+{
+    char   sectionNames[128];
+    size_t sectionNamesSize = 1;
+    size_t textOffset, extabOffset, exidxOffset, symbolsOffset, namesOffset, sectionNamesOffset, headersOffset;
+    size_t i;
+
+    sectionNames[0] = '\0';
+    m_elfSize = 0;
+    memset(m_elf, 0, sizeof(m_elf));
+    m_elfSize = 64;
+
+    textOffset = m_elfSize;
+    appendBytes(m_text, sizeof(m_text));
+    extabOffset = m_elfSize;
+    for (i = 0 ; i < m_extabCount ; i++)
+        appendWord(m_extab[i]);
+    exidxOffset = m_elfSize;
+    for (i = 0 ; i < m_exidxCount ; i++)
+        appendWord(m_exidx[i]);
+    symbolsOffset = m_elfSize;
+    appendBytes(m_symbols, m_symbolsSize);
+    namesOffset = m_elfSize;
+    appendBytes(m_names, m_namesSize);
+    sectionNamesOffset = m_elfSize;
+    addName(sectionNames, &sectionNamesSize, ".text");
+    addName(sectionNames, &sectionNamesSize, ".ARM.extab");
+    addName(sectionNames, &sectionNamesSize, ".ARM.exidx");
+    addName(sectionNames, &sectionNamesSize, ".symtab");
+    addName(sectionNames, &sectionNamesSize, ".strtab");
+    addName(sectionNames, &sectionNamesSize, ".shstrtab");
+    appendBytes(sectionNames, sectionNamesSize);
+    alignTo(4);
+
+    headersOffset = m_elfSize;
+    m_elfSize += 40;
+    writeSectionHeader(1, SHT_PROGBITS, SHF_ALLOC | SHF_EXECINSTR, TEST_ELF_TEXT_ADDRESS, textOffset,
+                       sizeof(m_text), 0, 0);
+    writeSectionHeader(7, SHT_PROGBITS, SHF_ALLOC, TEST_ELF_EXTAB_ADDRESS, extabOffset,
+                       m_extabCount * sizeof(uint32_t), 0, 0);
+    writeSectionHeader(18, SHT_ARM_EXIDX, SHF_ALLOC | SHF_LINK_ORDER, TEST_ELF_EXIDX_ADDRESS, exidxOffset,
+                       m_exidxCount * sizeof(uint32_t), TEST_ELF_TEXT_SECTION, 8);
+    if (m_isStripped)
+    {
+        writeSectionHeader(29, SHT_PROGBITS, 0, 0, symbolsOffset, 0, 0, 0);
+        writeSectionHeader(37, SHT_PROGBITS, 0, 0, namesOffset, 0, 0, 0);
+    }
+    else
+    {
+        writeSectionHeader(29, SHT_SYMTAB, 0, 0, symbolsOffset, m_symbolsSize, TEST_ELF_SYMTAB_SECTION + 1, 16);
+        writeSectionHeader(37, SHT_STRTAB, 0, 0, namesOffset, m_namesSize, 0, 0);
+    }
+    writeSectionHeader(45, SHT_STRTAB, 0, 0, sectionNamesOffset, sectionNamesSize, 0, 0);
+
+    memcpy(m_elf, "\x7F" "ELF", 4);
+    m_elf[4] = 1;
+    m_elf[5] = 1;
+    m_elf[6] = 1;
+    writeUInt16(&m_elf[16], 2);
+    writeUInt16(&m_elf[18], 40);
+    writeUInt32(&m_elf[20], 1);
+    writeUInt32(&m_elf[24], m_entryPoint);
+    writeUInt32(&m_elf[32], headersOffset);
+    writeUInt32(&m_elf[36], 0x05000200);
+    writeUInt16(&m_elf[40], 52);
+    writeUInt16(&m_elf[46], 40);
+    writeUInt16(&m_elf[48], TEST_ELF_SECTION_COUNT);
+    writeUInt16(&m_elf[50], TEST_ELF_SECTION_COUNT - 1);
+    *pSize = m_elfSize;
+    return m_elf;
+}
+
+void TestElf::appendBytes(const void* pData, size_t size)
+{
+    memcpy(&m_elf[m_elfSize], pData, size);
+    m_elfSize += size;
+}
+
+void TestElf::appendWord(uint32_t value)
+{
+    writeUInt32(&m_elf[m_elfSize], value);
+    m_elfSize += sizeof(value);
+}
+
+void TestElf::alignTo(size_t alignment)
+{
+    m_elfSize = (m_elfSize + alignment - 1) & ~(alignment - 1);
+}
+
+void TestElf::writeSectionHeader(uint32_t name, uint32_t type, uint32_t flags, uint32_t address, size_t offset,
+                                 size_t size, uint32_t link, uint32_t entrySize)
+{
+    uint8_t* pHeader = &m_elf[m_elfSize];
+
+    writeUInt32(&pHeader[0], name);
+    writeUInt32(&pHeader[4], type);
+    writeUInt32(&pHeader[8], flags);
+    writeUInt32(&pHeader[12], address);
+    writeUInt32(&pHeader[16], offset);
+    writeUInt32(&pHeader[20], size);
+    writeUInt32(&pHeader[24], link);
+    writeUInt32(&pHeader[28], 0);
+    writeUInt32(&pHeader[32], 4);
+    writeUInt32(&pHeader[36], entrySize);
+    m_elfSize += 40;
+}
+
+uint32_t TestElf::addName(char* pNames, size_t* pNamesSize, const char* pName)
+{
+    uint32_t offset = *pNamesSize;
+
+    strcpy(&pNames[offset], pName);
+    *pNamesSize += strlen(pName) + 1;
+    return offset;
+}
+
+static void writeUInt32(uint8_t* pDest, uint32_t value)
+{
+    pDest[0] = value & 0xFF;
+    pDest[1] = (value >> 8) & 0xFF;
+    pDest[2] = (value >> 16) & 0xFF;
+    pDest[3] = value >> 24;
+}
+
+static void writeUInt16(uint8_t* pDest, uint16_t value)
+{
+    pDest[0] = value & 0xFF;
+    pDest[1] = value >> 8;
+}
+
+static uint32_t encodePrel31(uint32_t target, uint32_t place)
+{
+    return (target - place) & 0x7FFFFFFF;
+}
@@ -0,0 +1,88 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Builds small ARM ELF files in memory for the DumpUnwinder tests.  They hold a .text section, .ARM.extab and
+   .ARM.exidx unwind tables and a symbol table, in the same format as arm-none-eabi-ld would output them. */
+#ifndef _TEST_ELF_H_
+#define _TEST_ELF_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+#define TEST_ELF_TEXT_ADDRESS   0x08000000
+#define TEST_ELF_TEXT_SIZE      0x1000
+#define TEST_ELF_EXTAB_ADDRESS  0x08001000
+#define TEST_ELF_EXIDX_ADDRESS  0x08002000
+/* Sections in the order they are placed in the section header table. */
+#define TEST_ELF_TEXT_SECTION   1
+#define TEST_ELF_EXTAB_SECTION  2
+#define TEST_ELF_EXIDX_SECTION  3
+#define TEST_ELF_SYMTAB_SECTION 4
+#define TEST_ELF_SECTION_COUNT  7
+
+#define STT_OBJECT              1
+#define STT_FUNC                2
+#define STB_LOCAL               0
+#define STB_GLOBAL              1
+
+
+class TestElf
+{
+public:
+    TestElf();
+
+    void setEntryPoint(uint32_t address);
+    /* Copies count Thumb halfwords into .text at address. */
+    void setCode(uint32_t address, const uint16_t* pHalfWords, size_t count);
+    /* Adds a global STT_FUNC symbol for the function at address, with the Thumb bit set like the compiler does. */
+    void addFunction(const char* pName, uint32_t address, uint32_t size);
+    void addSymbol(const char* pName, uint32_t value, uint32_t size, uint8_t type, uint8_t binding,
+                   uint16_t sectionIndex);
+    /* Leaves the .symtab and .strtab sections out like a stripped ELF file. */
+    void strip();
+    /* Adds an exidx entry whose second word is data, which is either EXIDX_CANTUNWIND (1) or inlined unwind
+       instructions for personality routine 0.  Entries must be added in address order. */
+    void addExidxEntry(uint32_t functionAddress, uint32_t data);
+    /* Adds an exidx entry which points to the given words, placed in .ARM.extab. */
+    void addExtabEntry(uint32_t functionAddress, const uint32_t* pWords, size_t wordCount);
+
+    /* Lays out the ELF file and returns a pointer to it.  The pointer stays valid until the next call. */
+    const uint8_t* build(size_t* pSize);
+
+private:
+    void     appendBytes(const void* pData, size_t size);
+    void     appendWord(uint32_t value);
+    void     alignTo(size_t alignment);
+    void     writeSectionHeader(uint32_t name, uint32_t type, uint32_t flags, uint32_t address, size_t offset,
+                                size_t size, uint32_t link, uint32_t entrySize);
+    uint32_t addName(char* pNames, size_t* pNamesSize, const char* pName);
+
+    uint8_t  m_elf[32768];
+    size_t   m_elfSize;
+    uint8_t  m_text[TEST_ELF_TEXT_SIZE];
+    uint32_t m_extab[256];
+    size_t   m_extabCount;
+    uint32_t m_exidx[256];
+    size_t   m_exidxCount;
+    uint8_t  m_symbols[256 * 16];
+    size_t   m_symbolsSize;
+    char     m_names[2048];
+    size_t   m_namesSize;
+    uint32_t m_entryPoint;
+    bool     m_isStripped;
+};
+
+
+#endif /* _TEST_ELF_H_ */
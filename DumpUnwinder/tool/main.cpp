@@ -0,0 +1,183 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Command line front end for StackUnwinder.
+   Usage: CrashCatcherUnwind [-i indexFile] [-n maxFrames] firmware.elf [dumpFile...]
+   The symbol index is kept in firmware.elf.symidx unless -i is used and is rebuilt whenever the ELF file changes.
+   Running without any dump files just builds the index so that it is ready for later runs. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <StackUnwinder.h>
+
+
+#define DEFAULT_MAX_FRAMES  64
+#define INDEX_EXTENSION     ".symidx"
+
+
+static const char* elfResultString(ElfImage::Result result);
+static const char* dumpResultString(DumpReader::Result result);
+static bool        unwindDump(const StackUnwinder& unwinder, const SymbolIndex& symbols, const char* pFilename,
+                              StackUnwinder::Frame* pFrames, size_t maxFrames);
+static void        printFrame(const SymbolIndex& symbols, size_t index, const StackUnwinder::Frame& frame);
+
+
+int main(int argc, char** argv)
+{
+    ElfImage              elf;
+    SymbolIndex           symbols;
+    StackUnwinder::Frame* pFrames;
+    const char*           pIndexFilename = NULL;
+    char*                 pDefaultIndexFilename = NULL;
+    size_t                maxFrames = DEFAULT_MAX_FRAMES;
+    bool                  isValid = true;
+    int                   argIndex = 1;
+    int                   failureCount = 0;
+    ElfImage::Result      elfResult;
+    SymbolIndex::Result   indexResult;
+
+    while (argIndex + 1 < argc && argv[argIndex][0] == '-')
+    {
+        const char* pOption = argv[argIndex];
+        const char* pValue = argv[argIndex + 1];
+
+        if (strcmp(pOption, "-i") == 0)
+            pIndexFilename = pValue;
+        else if (strcmp(pOption, "-n") == 0)
+            maxFrames = strtoul(pValue, NULL, 10);
+        else
+            isValid = false;
+        argIndex += 2;
+    }
+    if (argIndex >= argc || !isValid || maxFrames == 0)
+    {
+        fprintf(stderr, "Usage: %s [-i indexFile] [-n maxFrames] firmware.elf [dumpFile...]\n", argv[0]);
+        return 2;
+    }
+
+    elfResult = elf.open(argv[argIndex]);
+    if (elfResult != ElfImage::OK)
+    {
+        fprintf(stderr, "%s: %s\n", argv[argIndex], elfResultString(elfResult));
+        return 1;
+    }
+    if (!pIndexFilename)
+    {
+        pDefaultIndexFilename = (char*)malloc(strlen(argv[argIndex]) + sizeof(INDEX_EXTENSION));
+        if (!pDefaultIndexFilename)
+        {
+            fprintf(stderr, "%s: out of memory\n", argv[0]);
+            return 1;
+        }
+        sprintf(pDefaultIndexFilename, "%s" INDEX_EXTENSION, argv[argIndex]);
+        pIndexFilename = pDefaultIndexFilename;
+    }
+    indexResult = symbols.loadOrBuild(pIndexFilename, elf);
+    free(pDefaultIndexFilename);
+    pFrames = (StackUnwinder::Frame*)malloc(maxFrames * sizeof(*pFrames));
+    if (indexResult != SymbolIndex::OK || !pFrames)
+    {
+        fprintf(stderr, "%s: out of memory\n", argv[0]);
+        free(pFrames);
+        return 1;
+    }
+
+    StackUnwinder unwinder(elf, symbols);
+    for (argIndex++ ; argIndex < argc ; argIndex++)
+    {
+        if (!unwindDump(unwinder, symbols, argv[argIndex], pFrames, maxFrames))
+            failureCount++;
+    }
+    free(pFrames);
+    return failureCount > 0 ? 1 : 0;
+}
+
+static const char* elfResultString(ElfImage::Result result)
+{
+    switch (result)
+    {
+    case ElfImage::OK:
+        return "OK";
+    case ElfImage::OPEN_FAILED:
+        return "couldn't open ELF file";
+    case ElfImage::BAD_HEADER:
+        return "not a 32-bit little endian ARM ELF file";
+    case ElfImage::MALFORMED:
+        return "malformed ELF file";
+    case ElfImage::OUT_OF_MEMORY:
+        return "out of memory";
+    }
+    return "unknown result";
+}
+
+static const char* dumpResultString(DumpReader::Result result)
+{
+    switch (result)
+    {
+    case DumpReader::OK:
+        return "OK";
+    case DumpReader::OPEN_FAILED:
+        return "couldn't open dump";
+    case DumpReader::BAD_SIGNATURE:
+        return "not a CrashCatcher dump";
+    case DumpReader::TRUNCATED:
+        return "dump ended before its registers";
+    case DumpReader::MALFORMED:
+        return "malformed dump";
+    case DumpReader::OUT_OF_MEMORY:
+        return "out of memory";
+    }
+    return "unknown result";
+}
+
+static bool unwindDump(const StackUnwinder& unwinder, const SymbolIndex& symbols, const char* pFilename,
+                       StackUnwinder::Frame* pFrames, size_t maxFrames)
+{
+    DumpReader                dump;
+    DumpReader::Result        result;
+    StackUnwinder::StopReason stopReason;
+    size_t                    frameCount;
+    size_t                    i;
+
+    /* Dumps which were cut short after their registers, such as two tier dumps which only hold tier 1, can still be
+       unwound as far as their stack goes. */
+    result = dump.open(pFilename);
+    if (result != DumpReader::OK && !(result == DumpReader::TRUNCATED && dump.hasIntegerRegisters()))
+    {
+        fprintf(stderr, "%s: %s\n", pFilename, dumpResultString(result));
+        return false;
+    }
+    frameCount = unwinder.unwind(dump, pFrames, maxFrames, &stopReason);
+
+    printf("%s:\n", pFilename);
+    for (i = 0 ; i < frameCount ; i++)
+        printFrame(symbols, i, pFrames[i]);
+    if (stopReason != StackUnwinder::STOP_END_OF_STACK)
+        printf("   (unwind stopped: %s)\n", StackUnwinder::stopReasonString(stopReason));
+    printf("\n");
+    return frameCount > 0;
+}
+
+static void printFrame(const SymbolIndex& symbols, size_t index, const StackUnwinder::Frame& frame)
+{
+    SymbolIndex::Symbol symbol;
+
+    /* Exception frames are marked since everything below them ran in a different context to the frames above. */
+    if (frame.type == StackUnwinder::FRAME_EXCEPTION)
+        printf("   <exception frame>\n");
+    printf("#%-2u 0x%08X", (unsigned)index, frame.pc);
+    if (symbols.findSymbol(frame.pc, &symbol))
+        printf(" in %s+0x%X", symbol.pName, frame.pc - symbol.address);
+    printf("\n");
+}
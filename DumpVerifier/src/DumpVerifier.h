@@ -0,0 +1,77 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Host side checker for the CRC32 trailer appended to dumps which have CRASH_CATCHER_FLAGS_CRC32 set. */
+#ifndef _DUMP_VERIFIER_H_
+#define _DUMP_VERIFIER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+typedef enum
+{
+    /* All of the CRCs in the trailer matched. */
+    DUMP_VERIFIER_OK = 0,
+    /* The dump doesn't start with the "cC" signature or has an unsupported major version. */
+    DUMP_VERIFIER_BAD_SIGNATURE,
+    /* The dump doesn't have CRASH_CATCHER_FLAGS_CRC32 set so there is nothing to verify. */
+    DUMP_VERIFIER_NO_CRC,
+    /* The dump ended before the CRC32 trailer was found. */
+    DUMP_VERIFIER_TRUNCATED,
+    /* A region, segment or record header doesn't make sense. */
+    DUMP_VERIFIER_MALFORMED,
+    /* The CRC32 of one of the memory regions didn't match. */
+    DUMP_VERIFIER_BAD_REGION_CRC,
+    /* The memory regions were all fine but the CRC32 of the whole dump didn't match. */
+    DUMP_VERIFIER_BAD_DUMP_CRC,
+    /* A compressed dump couldn't be expanded since memory ran out. */
+    DUMP_VERIFIER_OUT_OF_MEMORY
+} DumpVerifierResult;
+
+typedef struct
+{
+    /* Number of memory regions found in the dump. */
+    uint32_t regionCount;
+    /* Number of memory regions which had a CRC in the trailer. */
+    uint32_t regionCrcCount;
+    /* Index and start address of the region which failed for DUMP_VERIFIER_BAD_REGION_CRC. */
+    uint32_t badRegionIndex;
+    uint32_t badRegionAddress;
+    /* CRC32 found in the trailer and the one actually calculated for DUMP_VERIFIER_BAD_*_CRC. */
+    uint32_t expectedCrc;
+    uint32_t actualCrc;
+    /* Set to non-zero if the stack overflow sentinel was found after the trailer. */
+    int      hasStackOverflowed;
+    /* Last tier whose CRASH_CATCHER_RECORD_TIER_END CRC matched every byte before it.  A dump which returns
+       DUMP_VERIFIER_TRUNCATED with this set to 1 still has an intact tier 1. */
+    uint32_t verifiedTier;
+} DumpVerifierDetails;
+
+
+/* Verifies the CRC32 trailer of the dumpSize byte dump at pDump.  pDetails can be NULL if the caller only cares about the
+   result.  Dumps with CRASH_CATCHER_FLAGS_COMPRESSED set are expanded into a temporary buffer first since their CRCs
+   cover the uncompressed bytes. */
+DumpVerifierResult DumpVerifier_Verify(const uint8_t* pDump, size_t dumpSize, DumpVerifierDetails* pDetails);
+
+/* Returns a short description of result. */
+const char*        DumpVerifier_ResultString(DumpVerifierResult result);
+
+/* Returns the CRC32 of size bytes at pvData, continuing on from a crc previously returned by this function.  Pass in 0
+   for the first call.  Calculates the same value as zlib's crc32() using slicing-by-8 so that it can keep up with
+   memory bandwidth on multi-megabyte dumps. */
+uint32_t           DumpVerifier_Crc32(uint32_t crc, const void* pvData, size_t size);
+
+
+#endif /* _DUMP_VERIFIER_H_ */
@@ -0,0 +1,514 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include <stdint.h>
+#include <string.h>
+
+// Include headers from C modules under test.
+extern "C"
+{
+    #include <CrashCatcher.h>
+    #include <DumpVerifier.h>
+}
+
+// Include C++ headers for test harness.
+#include <CppUTest/TestHarness.h>
+
+
+TEST_GROUP(DumpVerifier)
+{
+    // Dumps are built up in this buffer by the tests, in the same format as generated by the Core.
+    uint8_t             m_dump[2048];
+    size_t              m_size;
+    size_t              m_regionStart;
+    uint32_t            m_regionCrcs[8];
+    uint32_t            m_regionCrcCount;
+    DumpVerifierDetails m_details;
+
+    void setup()
+    {
+        memset(m_dump, 0, sizeof(m_dump));
+        memset(&m_details, 0xFF, sizeof(m_details));
+        m_size = 0;
+        m_regionStart = 0;
+        m_regionCrcCount = 0;
+    }
+
+    void teardown()
+    {
+    }
+
+    void appendByte(uint8_t byte)
+    {
+        CHECK_TRUE(m_size < sizeof(m_dump));
+        m_dump[m_size++] = byte;
+    }
+
+    void appendWord(uint32_t word)
+    {
+        appendByte(word & 0xFF);
+        appendByte((word >> 8) & 0xFF);
+        appendByte((word >> 16) & 0xFF);
+        appendByte(word >> 24);
+    }
+
+    void appendHeaderAndRegisters(uint32_t flags)
+    {
+        appendByte(CRASH_CATCHER_SIGNATURE_BYTE0);
+        appendByte(CRASH_CATCHER_SIGNATURE_BYTE1);
+        appendByte(CRASH_CATCHER_VERSION_MAJOR);
+        appendByte(CRASH_CATCHER_VERSION_MINOR);
+        appendWord(flags | CRASH_CATCHER_FLAGS_CRC32);
+        if (flags & CRASH_CATCHER_FLAGS_BACKTRACE)
+        {
+            appendWord(CRASH_CATCHER_RECORD_TAG(CRASH_CATCHER_RECORD_BACKTRACE));
+            appendWord(4 * sizeof(uint32_t));
+            for (uint32_t i = 0 ; i < 4 ; i++)
+                appendWord(0xB0000000 + i);
+        }
+        for (uint32_t i = 0 ; i < 20 ; i++)
+            appendWord(0x11111111 * (i & 0xF));
+        if (flags & CRASH_CATCHER_FLAGS_FLOATING_POINT)
+        {
+            for (uint32_t i = 0 ; i < 33 ; i++)
+                appendWord(0x3F800000 + i);
+        }
+    }
+
+    void startRegion(uint32_t startAddress, uint32_t endAddress)
+    {
+        m_regionStart = m_size;
+        appendWord(startAddress);
+        appendWord(endAddress);
+    }
+
+    void endRegion()
+    {
+        m_regionCrcs[m_regionCrcCount++] = DumpVerifier_Crc32(0, &m_dump[m_regionStart], m_size - m_regionStart);
+    }
+
+    void appendRegion(uint32_t startAddress, uint32_t size)
+    {
+        startRegion(startAddress, startAddress + size);
+        for (uint32_t i = 0 ; i < size ; i++)
+            appendByte((uint8_t)(startAddress + i));
+        endRegion();
+    }
+
+    void appendSegmentHeader(uint32_t type, uint32_t length)
+    {
+        appendWord((type << CRASH_CATCHER_SEGMENT_TYPE_SHIFT) | length);
+    }
+
+    void appendTierEnd(uint32_t tier)
+    {
+        appendWord(CRASH_CATCHER_RECORD_TAG(CRASH_CATCHER_RECORD_TIER_END));
+        appendWord(2 * sizeof(uint32_t));
+        appendWord(tier);
+        appendWord(DumpVerifier_Crc32(0, m_dump, m_size - 3 * sizeof(uint32_t)));
+    }
+
+    void appendTrailer(uint32_t regionCrcCount)
+    {
+        appendWord(CRASH_CATCHER_RECORD_TAG(CRASH_CATCHER_RECORD_CRC32));
+        appendWord((regionCrcCount + 2) * sizeof(uint32_t));
+        for (uint32_t i = 0 ; i < regionCrcCount ; i++)
+            appendWord(m_regionCrcs[i]);
+        appendWord(regionCrcCount);
+        appendWord(DumpVerifier_Crc32(0, m_dump, m_size));
+    }
+
+    void appendTrailer()
+    {
+        appendTrailer(m_regionCrcCount);
+    }
+
+    // Replaces everything after the first headerSize bytes with LZ4 blocks which only hold literals, the way that the
+    // Core sends dumps with CRASH_CATCHER_FLAGS_COMPRESSED set.  The CRCs cover the uncompressed bytes so this is
+    // called once the whole dump has been appended.
+    void compress(size_t headerSize)
+    {
+        uint8_t uncompressed[sizeof(m_dump)];
+        size_t  uncompressedSize = m_size - headerSize;
+
+        memcpy(uncompressed, &m_dump[headerSize], uncompressedSize);
+        m_size = headerSize;
+        for (size_t offset = 0 ; offset < uncompressedSize ; offset += 256)
+        {
+            size_t blockSize = uncompressedSize - offset < 256 ? uncompressedSize - offset : 256;
+            size_t compressedSize = blockSize >= 15 ? blockSize + 2 : blockSize + 1;
+
+            appendByte(compressedSize & 0xFF);
+            appendByte(compressedSize >> 8);
+            appendByte(blockSize & 0xFF);
+            appendByte(blockSize >> 8);
+            appendByte(blockSize >= 15 ? 0xF0 : blockSize << 4);
+            if (blockSize >= 15)
+                appendByte(blockSize - 15);
+            for (size_t i = 0 ; i < blockSize ; i++)
+                appendByte(uncompressed[offset + i]);
+        }
+    }
+
+    DumpVerifierResult verify()
+    {
+        return DumpVerifier_Verify(m_dump, m_size, &m_details);
+    }
+
+    static uint32_t bitwiseCrc32(const uint8_t* pData, size_t size)
+    {
+        uint32_t crc = 0xFFFFFFFF;
+
+        while (size-- > 0)
+        {
+            crc ^= *pData++;
+            for (int bit = 0 ; bit < 8 ; bit++)
+                crc = (crc >> 1) ^ ((crc & 1) ? 0xEDB88320 : 0);
+        }
+        return ~crc;
+    }
+};
+
+
+TEST(DumpVerifier, Crc32_CheckString_ShouldMatchStandardCheckValue)
+{
+    static const char checkString[] = "123456789";
+
+    CHECK_EQUAL(0xCBF43926, DumpVerifier_Crc32(0, checkString, strlen(checkString)));
+}
+
+TEST(DumpVerifier, Crc32_UnalignedOddSizedPieces_ShouldMatchBitwiseImplementation)
+{
+    uint32_t seed = 0x12345678;
+    for (size_t i = 0 ; i < sizeof(m_dump) ; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        m_dump[i] = seed >> 24;
+    }
+
+    uint32_t crc = DumpVerifier_Crc32(0, &m_dump[0], 3);
+    crc = DumpVerifier_Crc32(crc, &m_dump[3], 1021);
+    crc = DumpVerifier_Crc32(crc, &m_dump[1024], sizeof(m_dump) - 1024 - 1);
+    CHECK_EQUAL(bitwiseCrc32(m_dump, sizeof(m_dump) - 1), crc);
+}
+
+TEST(DumpVerifier, RegistersOnly_ShouldReturnOk)
+{
+    appendHeaderAndRegisters(0);
+    appendTrailer();
+    CHECK_EQUAL(DUMP_VERIFIER_OK, verify());
+    CHECK_EQUAL(0, m_details.regionCount);
+    CHECK_EQUAL(0, m_details.regionCrcCount);
+    CHECK_FALSE(m_details.hasStackOverflowed);
+}
+
+TEST(DumpVerifier, FloatingPointRegistersAndTwoRegions_ShouldReturnOk)
+{
+    appendHeaderAndRegisters(CRASH_CATCHER_FLAGS_FLOATING_POINT);
+    appendRegion(0x10000000, 16);
+    appendRegion(0x20000000, 3);
+    appendTrailer();
+    CHECK_EQUAL(DUMP_VERIFIER_OK, verify());
+    CHECK_EQUAL(2, m_details.regionCount);
+    CHECK_EQUAL(2, m_details.regionCrcCount);
+}
+
+TEST(DumpVerifier, BacktraceRecordBeforeRegisters_ShouldBeSkipped)
+{
+    appendHeaderAndRegisters(CRASH_CATCHER_FLAGS_BACKTRACE);
+    appendRegion(0x10000000, 16);
+    appendTrailer();
+    CHECK_EQUAL(DUMP_VERIFIER_OK, verify());
+    CHECK_EQUAL(1, m_details.regionCount);
+}
+
+TEST(DumpVerifier, BacktraceFlagWithoutRecord_ShouldReportMalformed)
+{
+    appendHeaderAndRegisters(0);
+    m_dump[4] |= CRASH_CATCHER_FLAGS_BACKTRACE;
+    appendTrailer();
+    CHECK_EQUAL(DUMP_VERIFIER_MALFORMED, verify());
+}
+
+TEST(DumpVerifier, NullDetails_ShouldStillVerify)
+{
+    appendHeaderAndRegisters(0);
+    appendRegion(0x10000000, 16);
+    appendTrailer();
+    CHECK_EQUAL(DUMP_VERIFIER_OK, DumpVerifier_Verify(m_dump, m_size, NULL));
+}
+
+TEST(DumpVerifier, CorruptSecondRegion_ShouldReportBadRegionCrc)
+{
+    appendHeaderAndRegisters(0);
+    appendRegion(0x10000000, 16);
+    appendRegion(0x20000000, 16);
+    appendTrailer();
+    // Flip a bit in the middle of the second region's data which is just before the 6 word trailer.
+    m_dump[m_size - 6 * sizeof(uint32_t) - 5] ^= 0x04;
+    CHECK_EQUAL(DUMP_VERIFIER_BAD_REGION_CRC, verify());
+    CHECK_EQUAL(1, m_details.badRegionIndex);
+    CHECK_EQUAL(0x20000000, m_details.badRegionAddress);
+    CHECK_EQUAL(m_regionCrcs[1], m_details.expectedCrc);
+    CHECK_TRUE(m_details.expectedCrc != m_details.actualCrc);
+}
+
+TEST(DumpVerifier, CorruptRegister_ShouldReportBadDumpCrc)
+{
+    appendHeaderAndRegisters(0);
+    appendRegion(0x10000000, 16);
+    appendTrailer();
+    m_dump[20] ^= 0x80;
+    CHECK_EQUAL(DUMP_VERIFIER_BAD_DUMP_CRC, verify());
+}
+
+TEST(DumpVerifier, BadSignature_ShouldReportBadSignature)
+{
+    appendHeaderAndRegisters(0);
+    appendTrailer();
+    m_dump[1] = 'c';
+    CHECK_EQUAL(DUMP_VERIFIER_BAD_SIGNATURE, verify());
+}
+
+TEST(DumpVerifier, CompressedDumpWithBacktrace_ShouldExpandBlocksAndReturnOk)
+{
+    appendHeaderAndRegisters(CRASH_CATCHER_FLAGS_COMPRESSED | CRASH_CATCHER_FLAGS_BACKTRACE);
+    appendRegion(0x10000000, 600);
+    appendRegion(0x20000000, 4);
+    appendTrailer();
+    compress(8 + 6 * sizeof(uint32_t));
+    CHECK_EQUAL(DUMP_VERIFIER_OK, verify());
+    CHECK_EQUAL(2, m_details.regionCount);
+    CHECK_EQUAL(2, m_details.regionCrcCount);
+}
+
+TEST(DumpVerifier, CompressedDumpWithCorruptRegion_ShouldReportBadRegionCrc)
+{
+    appendHeaderAndRegisters(CRASH_CATCHER_FLAGS_COMPRESSED);
+    appendRegion(0x10000000, 16);
+    appendRegion(0x20000000, 16);
+    appendTrailer();
+    compress(8);
+    // Registers, the first region and then the second region's header, all in the first block.
+    m_dump[8 + 4 + 2 + 80 + 8 + 16 + 8] ^= 0x01;
+    CHECK_EQUAL(DUMP_VERIFIER_BAD_REGION_CRC, verify());
+    CHECK_EQUAL(1, m_details.badRegionIndex);
+}
+
+TEST(DumpVerifier, CompressedDumpCutOffInLastBlock_ShouldReportTruncated)
+{
+    appendHeaderAndRegisters(CRASH_CATCHER_FLAGS_COMPRESSED);
+    appendRegion(0x10000000, 600);
+    appendTrailer();
+    compress(8);
+    m_size--;
+    CHECK_EQUAL(DUMP_VERIFIER_TRUNCATED, verify());
+}
+
+TEST(DumpVerifier, CompressedDumpWithCorruptBlock_ShouldReportMalformed)
+{
+    appendHeaderAndRegisters(CRASH_CATCHER_FLAGS_COMPRESSED);
+    appendRegion(0x10000000, 16);
+    appendTrailer();
+    compress(8);
+    // Claim that the block decodes to one byte more than it does.
+    m_dump[8 + 2]++;
+    CHECK_EQUAL(DUMP_VERIFIER_MALFORMED, verify());
+}
+
+TEST(DumpVerifier, Crc32FlagNotSet_ShouldReportNoCrc)
+{
+    appendHeaderAndRegisters(0);
+    m_dump[4] &= ~CRASH_CATCHER_FLAGS_CRC32;
+    CHECK_EQUAL(DUMP_VERIFIER_NO_CRC, verify());
+}
+
+TEST(DumpVerifier, MissingLastByte_ShouldReportTruncated)
+{
+    appendHeaderAndRegisters(0);
+    appendRegion(0x10000000, 16);
+    appendTrailer();
+    m_size--;
+    CHECK_EQUAL(DUMP_VERIFIER_TRUNCATED, verify());
+}
+
+TEST(DumpVerifier, MissingTrailer_ShouldReportTruncated)
+{
+    appendHeaderAndRegisters(0);
+    appendRegion(0x10000000, 16);
+    CHECK_EQUAL(DUMP_VERIFIER_TRUNCATED, verify());
+}
+
+TEST(DumpVerifier, TwoTierDump_ShouldVerifyBothTiers)
+{
+    appendHeaderAndRegisters(CRASH_CATCHER_FLAGS_TWO_TIER);
+    appendRegion(0x10000000, 16);
+    appendTierEnd(1);
+    appendRegion(0x20000000, 64);
+    appendTierEnd(2);
+    appendTrailer();
+    CHECK_EQUAL(DUMP_VERIFIER_OK, verify());
+    CHECK_EQUAL(2, m_details.regionCount);
+    CHECK_EQUAL(2, m_details.verifiedTier);
+}
+
+TEST(DumpVerifier, TwoTierDumpCutShortInTier2_ShouldReportTruncatedWithTier1Verified)
+{
+    appendHeaderAndRegisters(CRASH_CATCHER_FLAGS_TWO_TIER);
+    appendRegion(0x10000000, 16);
+    appendTierEnd(1);
+    appendRegion(0x20000000, 64);
+    m_size -= 32;
+    CHECK_EQUAL(DUMP_VERIFIER_TRUNCATED, verify());
+    CHECK_EQUAL(1, m_details.verifiedTier);
+}
+
+TEST(DumpVerifier, CorruptTier1_ShouldLeaveTierUnverifiedAndReportBadRegionCrc)
+{
+    appendHeaderAndRegisters(CRASH_CATCHER_FLAGS_TWO_TIER);
+    appendRegion(0x10000000, 16);
+    appendTierEnd(1);
+    appendTierEnd(2);
+    appendTrailer();
+    m_dump[100] ^= 0x01;
+    CHECK_EQUAL(DUMP_VERIFIER_BAD_REGION_CRC, verify());
+    CHECK_EQUAL(0, m_details.badRegionIndex);
+    CHECK_EQUAL(0, m_details.verifiedTier);
+}
+
+TEST(DumpVerifier, TierEndWithShortPayload_ShouldReportMalformed)
+{
+    appendHeaderAndRegisters(CRASH_CATCHER_FLAGS_TWO_TIER);
+    appendWord(CRASH_CATCHER_RECORD_TAG(CRASH_CATCHER_RECORD_TIER_END));
+    appendWord(sizeof(uint32_t));
+    appendWord(1);
+    appendTrailer();
+    CHECK_EQUAL(DUMP_VERIFIER_MALFORMED, verify());
+}
+
+TEST(DumpVerifier, RegionEndBeforeStart_ShouldReportMalformed)
+{
+    appendHeaderAndRegisters(0);
+    startRegion(0x10000010, 0x10000000);
+    appendTrailer();
+    CHECK_EQUAL(DUMP_VERIFIER_MALFORMED, verify());
+}
+
+TEST(DumpVerifier, StackSentinelAfterTrailer_ShouldReturnOkAndFlagStackOverflow)
+{
+    appendHeaderAndRegisters(0);
+    appendTrailer();
+    appendByte(0xAC);
+    appendByte(0xCE);
+    appendByte(0x55);
+    appendByte(0xED);
+    CHECK_EQUAL(DUMP_VERIFIER_OK, verify());
+    CHECK_TRUE(m_details.hasStackOverflowed);
+}
+
+TEST(DumpVerifier, GarbageAfterTrailer_ShouldReportMalformed)
+{
+    appendHeaderAndRegisters(0);
+    appendTrailer();
+    appendWord(0x12345678);
+    CHECK_EQUAL(DUMP_VERIFIER_MALFORMED, verify());
+}
+
+TEST(DumpVerifier, SegmentedRegionWithAllSegmentTypes_ShouldReturnOk)
+{
+    appendHeaderAndRegisters(CRASH_CATCHER_FLAGS_SEGMENTED);
+    startRegion(0x20000000, 0x20000000 + 4 + 64 + 32 + 128);
+    appendSegmentHeader(CRASH_CATCHER_SEGMENT_RAW, 4);
+    appendWord(0xDEADBEEF);
+    appendSegmentHeader(CRASH_CATCHER_SEGMENT_FILL, 64);
+    appendWord(0x00000000);
+    appendSegmentHeader(CRASH_CATCHER_SEGMENT_HOLE, 32);
+    appendSegmentHeader(CRASH_CATCHER_SEGMENT_LOAD_IMAGE, 128);
+    appendWord(0x00008000);
+    endRegion();
+    appendTrailer();
+    CHECK_EQUAL(DUMP_VERIFIER_OK, verify());
+    CHECK_EQUAL(1, m_details.regionCount);
+}
+
+TEST(DumpVerifier, SegmentLongerThanRegion_ShouldReportMalformed)
+{
+    appendHeaderAndRegisters(CRASH_CATCHER_FLAGS_SEGMENTED);
+    startRegion(0x20000000, 0x20000004);
+    appendSegmentHeader(CRASH_CATCHER_SEGMENT_HOLE, 8);
+    endRegion();
+    appendTrailer();
+    CHECK_EQUAL(DUMP_VERIFIER_MALFORMED, verify());
+}
+
+TEST(DumpVerifier, UnknownSegmentType_ShouldReportMalformed)
+{
+    appendHeaderAndRegisters(CRASH_CATCHER_FLAGS_SEGMENTED);
+    startRegion(0x20000000, 0x20000004);
+    appendSegmentHeader(0xF, 4);
+    endRegion();
+    appendTrailer();
+    CHECK_EQUAL(DUMP_VERIFIER_MALFORMED, verify());
+}
+
+TEST(DumpVerifier, UnknownRecordBeforeTrailer_ShouldBeSkipped)
+{
+    appendHeaderAndRegisters(0);
+    appendRegion(0x10000000, 16);
+    appendWord(CRASH_CATCHER_RECORD_TAG(0x7F));
+    appendWord(2 * sizeof(uint32_t));
+    appendWord(0x11111111);
+    appendWord(0x22222222);
+    appendRegion(0x20000000, 8);
+    appendTrailer();
+    CHECK_EQUAL(DUMP_VERIFIER_OK, verify());
+    CHECK_EQUAL(2, m_details.regionCount);
+}
+
+TEST(DumpVerifier, FewerRegionCrcsThanRegions_ShouldOnlyCheckFirstRegions)
+{
+    appendHeaderAndRegisters(0);
+    appendRegion(0x10000000, 16);
+    appendRegion(0x20000000, 16);
+    appendTrailer(1);
+    CHECK_EQUAL(DUMP_VERIFIER_OK, verify());
+    CHECK_EQUAL(2, m_details.regionCount);
+    CHECK_EQUAL(1, m_details.regionCrcCount);
+}
+
+TEST(DumpVerifier, MoreRegionCrcsThanRegions_ShouldReportMalformed)
+{
+    appendHeaderAndRegisters(0);
+    appendRegion(0x10000000, 16);
+    m_regionCrcs[m_regionCrcCount++] = 0;
+    appendTrailer();
+    CHECK_EQUAL(DUMP_VERIFIER_MALFORMED, verify());
+}
+
+TEST(DumpVerifier, TrailerCountDoesNotMatchPayloadLength_ShouldReportMalformed)
+{
+    appendHeaderAndRegisters(0);
+    appendRegion(0x10000000, 16);
+    appendTrailer();
+    m_dump[m_size - 8] = 2;
+    CHECK_EQUAL(DUMP_VERIFIER_MALFORMED, verify());
+}
+
+TEST(DumpVerifier, ResultString_ShouldDescribeEachResult)
+{
+    STRCMP_EQUAL("CRCs match", DumpVerifier_ResultString(DUMP_VERIFIER_OK));
+    STRCMP_EQUAL("memory region CRC mismatch", DumpVerifier_ResultString(DUMP_VERIFIER_BAD_REGION_CRC));
+    STRCMP_EQUAL("out of memory", DumpVerifier_ResultString(DUMP_VERIFIER_OUT_OF_MEMORY));
+    STRCMP_EQUAL("unknown result", DumpVerifier_ResultString((DumpVerifierResult)-1));
+}
@@ -0,0 +1,130 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Command line front end for DumpVerifier.  Usage: CrashCatcherVerify dumpFile... */
+#include <stdio.h>
+#include <DumpVerifier.h>
+#ifdef _WIN32
+    #include <stdlib.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+
+static int verifyFile(const char* pFilename);
+static int verifyDump(const char* pFilename, const uint8_t* pDump, size_t dumpSize);
+
+
+int main(int argc, char** argv)
+{
+    int failureCount = 0;
+    int i;
+
+    if (argc < 2)
+    {
+        fprintf(stderr, "Usage: %s dumpFile...\n", argv[0]);
+        return 2;
+    }
+    for (i = 1 ; i < argc ; i++)
+        failureCount += verifyFile(argv[i]);
+    return failureCount ? 1 : 0;
+}
+
+#ifdef _WIN32
+static int verifyFile(const char* pFilename)
+{
+    FILE*    pFile = fopen(pFilename, "rb");
+    uint8_t* pDump = NULL;
+    long     dumpSize;
+    int      result;
+
+    if (!pFile || fseek(pFile, 0, SEEK_END) != 0 || (dumpSize = ftell(pFile)) < 0 || fseek(pFile, 0, SEEK_SET) != 0)
+    {
+        perror(pFilename);
+        if (pFile)
+            fclose(pFile);
+        return 1;
+    }
+    pDump = malloc(dumpSize ? dumpSize : 1);
+    if (!pDump || fread(pDump, 1, dumpSize, pFile) != (size_t)dumpSize)
+    {
+        perror(pFilename);
+        free(pDump);
+        fclose(pFile);
+        return 1;
+    }
+    fclose(pFile);
+    result = verifyDump(pFilename, pDump, dumpSize);
+    free(pDump);
+    return result;
+}
+#else
+static int verifyFile(const char* pFilename)
+{
+    struct stat fileStat;
+    void*       pvDump;
+    int         file;
+    int         result;
+
+    /* Map the dump rather than reading it so that large dumps are checked at memory bandwidth. */
+    file = open(pFilename, O_RDONLY);
+    if (file < 0 || fstat(file, &fileStat) != 0)
+    {
+        perror(pFilename);
+        if (file >= 0)
+            close(file);
+        return 1;
+    }
+    if (fileStat.st_size == 0)
+    {
+        close(file);
+        return verifyDump(pFilename, NULL, 0);
+    }
+    pvDump = mmap(NULL, fileStat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+    if (pvDump == MAP_FAILED)
+    {
+        perror(pFilename);
+        return 1;
+    }
+    madvise(pvDump, fileStat.st_size, MADV_SEQUENTIAL);
+    result = verifyDump(pFilename, pvDump, fileStat.st_size);
+    munmap(pvDump, fileStat.st_size);
+    return result;
+}
+#endif
+
+static int verifyDump(const char* pFilename, const uint8_t* pDump, size_t dumpSize)
+{
+    DumpVerifierDetails details;
+    DumpVerifierResult  result = DumpVerifier_Verify(pDump, dumpSize, &details);
+
+    printf("%s: %s", pFilename, DumpVerifier_ResultString(result));
+    if (result == DUMP_VERIFIER_OK)
+        printf(" (%u of %u regions checked)", (unsigned)details.regionCrcCount, (unsigned)details.regionCount);
+    else if (result == DUMP_VERIFIER_BAD_REGION_CRC)
+        printf(" in region %u @ 0x%08X", (unsigned)details.badRegionIndex, (unsigned)details.badRegionAddress);
+    else if (result == DUMP_VERIFIER_TRUNCATED && details.verifiedTier > 0)
+        printf(" (tier %u intact)", (unsigned)details.verifiedTier);
+    if (result == DUMP_VERIFIER_BAD_REGION_CRC || result == DUMP_VERIFIER_BAD_DUMP_CRC)
+        printf(": expected 0x%08X but calculated 0x%08X", (unsigned)details.expectedCrc, (unsigned)details.actualCrc);
+    if (details.hasStackOverflowed)
+        printf(" [fault handler stack overflowed]");
+    printf("\n");
+
+    return result == DUMP_VERIFIER_OK ? 0 : 1;
+}
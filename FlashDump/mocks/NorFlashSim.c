@@ -0,0 +1,217 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include <NorFlashSim.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+#define ERASED_BYTE  0xFF
+#define NO_FAILURE   0xFFFFFFFF
+
+
+static CrashCatcherFlashArea        g_area;
+static const CrashCatcherFlashArea* g_pArea;
+static uint8_t*                     g_pData;
+static uint32_t*                    g_pEraseCounts;
+static uint32_t                     g_pageSize;
+static uint32_t                     g_eraseMicroseconds;
+static uint32_t                     g_programMicroseconds;
+static uint32_t                     g_programCount;
+static uint32_t                     g_errorCount;
+static uint32_t                     g_readByteCount;
+static uint32_t                     g_operationCount;
+static uint32_t                     g_failOperation;
+static uint64_t                     g_elapsedMicroseconds;
+
+
+static int isOperationToFail(void);
+static int isRangeValid(uint32_t address, uint32_t size, uint32_t alignment);
+
+
+void NorFlashSim_Init(uint32_t startAddress, uint32_t size, uint32_t sectorSize, uint32_t pageSize)
+{
+    g_area.startAddress = startAddress;
+    g_area.size = size;
+    g_area.sectorSize = sectorSize;
+    g_area.slotCount = 0;
+    g_pArea = &g_area;
+    g_pData = malloc(size);
+    memset(g_pData, ERASED_BYTE, size);
+    g_pEraseCounts = calloc(size / sectorSize, sizeof(*g_pEraseCounts));
+    g_pageSize = pageSize;
+    g_eraseMicroseconds = 0;
+    g_programMicroseconds = 0;
+    g_programCount = 0;
+    g_errorCount = 0;
+    g_readByteCount = 0;
+    g_operationCount = 0;
+    g_failOperation = NO_FAILURE;
+    g_elapsedMicroseconds = 0;
+}
+
+
+void NorFlashSim_Uninit(void)
+{
+    free(g_pData);
+    free(g_pEraseCounts);
+    g_pData = NULL;
+    g_pEraseCounts = NULL;
+}
+
+
+void NorFlashSim_SetTimings(uint32_t eraseMicroseconds, uint32_t programMicroseconds)
+{
+    g_eraseMicroseconds = eraseMicroseconds;
+    g_programMicroseconds = programMicroseconds;
+}
+
+
+void NorFlashSim_FailOperation(uint32_t operationIndex)
+{
+    g_failOperation = operationIndex;
+}
+
+
+void NorFlashSim_SetFlashArea(const CrashCatcherFlashArea* pArea)
+{
+    g_pArea = pArea;
+}
+
+
+void NorFlashSim_SetSlotCount(uint32_t slotCount)
+{
+    g_area.slotCount = slotCount;
+}
+
+
+void NorFlashSim_Fill(uint8_t value)
+{
+    memset(g_pData, value, g_area.size);
+}
+
+
+const uint8_t* NorFlashSim_GetData(void)
+{
+    return g_pData;
+}
+
+uint32_t NorFlashSim_GetEraseCount(uint32_t sectorIndex)
+{
+    return g_pEraseCounts[sectorIndex];
+}
+
+uint32_t NorFlashSim_GetTotalEraseCount(void)
+{
+    uint32_t total = 0;
+    uint32_t i;
+
+    for (i = 0 ; i < g_area.size / g_area.sectorSize ; i++)
+        total += g_pEraseCounts[i];
+    return total;
+}
+
+uint32_t NorFlashSim_GetProgramCount(void)
+{
+    return g_programCount;
+}
+
+uint32_t NorFlashSim_GetErrorCount(void)
+{
+    return g_errorCount;
+}
+
+uint32_t NorFlashSim_GetReadByteCount(void)
+{
+    return g_readByteCount;
+}
+
+uint64_t NorFlashSim_GetElapsedMicroseconds(void)
+{
+    return g_elapsedMicroseconds;
+}
+
+
+/* Simulated implementation of the FlashDump HAL. */
+const CrashCatcherFlashArea* CrashCatcher_GetFlashArea(void)
+{
+    return g_pArea;
+}
+
+
+int CrashCatcher_FlashErase(uint32_t address)
+{
+    uint32_t offset = address - g_area.startAddress;
+
+    if (isOperationToFail())
+        return -1;
+    if (!isRangeValid(address, g_area.sectorSize, g_area.sectorSize))
+        return -1;
+    memset(&g_pData[offset], ERASED_BYTE, g_area.sectorSize);
+    g_pEraseCounts[offset / g_area.sectorSize]++;
+    g_elapsedMicroseconds += g_eraseMicroseconds;
+    return 0;
+}
+
+
+int CrashCatcher_FlashProgram(uint32_t address, const void* pvData, size_t size)
+{
+    const uint8_t* pData = (const uint8_t*)pvData;
+    uint32_t       offset = address - g_area.startAddress;
+    uint32_t       i;
+
+    if (isOperationToFail())
+        return -1;
+    if (size != g_pageSize || !isRangeValid(address, size, g_pageSize))
+        return -1;
+    /* Programming can only clear bits so a page must be erased before it can be programmed. */
+    for (i = 0 ; i < size ; i++)
+    {
+        if (g_pData[offset + i] != ERASED_BYTE)
+        {
+            g_errorCount++;
+            return -1;
+        }
+    }
+    for (i = 0 ; i < size ; i++)
+        g_pData[offset + i] &= pData[i];
+    g_programCount++;
+    g_elapsedMicroseconds += g_programMicroseconds;
+    return 0;
+}
+
+int CrashCatcher_FlashRead(uint32_t address, void* pvBuffer, size_t size)
+{
+    if (!isRangeValid(address, size, 1))
+        return -1;
+    memcpy(pvBuffer, &g_pData[address - g_area.startAddress], size);
+    g_readByteCount += size;
+    return 0;
+}
+
+static int isOperationToFail(void)
+{
+    return g_operationCount++ == g_failOperation;
+}
+
+static int isRangeValid(uint32_t address, uint32_t size, uint32_t alignment)
+{
+    if (address < g_area.startAddress || address - g_area.startAddress > g_area.size - size ||
+        (address - g_area.startAddress) % alignment != 0)
+    {
+        g_errorCount++;
+        return 0;
+    }
+    return 1;
+}
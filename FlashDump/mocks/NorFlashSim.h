@@ -0,0 +1,44 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Host simulation of a NOR flash part which provides the CrashCatcher_GetFlashArea(), CrashCatcher_FlashErase(),
+   CrashCatcher_FlashProgram() and CrashCatcher_FlashRead() routines used by the FlashDump module.  Erases set a whole
+   sector to 0xFF and programs can only clear bits within a single erased page.  Each erase and program is counted and
+   charged a fixed time so that tests can check the wear and throughput of a dump. */
+#ifndef _NOR_FLASH_SIM_H_
+#define _NOR_FLASH_SIM_H_
+
+#include <CrashCatcher.h>
+#include <stdint.h>
+
+
+void NorFlashSim_Init(uint32_t startAddress, uint32_t size, uint32_t sectorSize, uint32_t pageSize);
+void NorFlashSim_Uninit(void);
+
+void NorFlashSim_SetTimings(uint32_t eraseMicroseconds, uint32_t programMicroseconds);
+void NorFlashSim_FailOperation(uint32_t operationIndex);
+void NorFlashSim_SetFlashArea(const CrashCatcherFlashArea* pArea);
+void NorFlashSim_SetSlotCount(uint32_t slotCount);
+void NorFlashSim_Fill(uint8_t value);
+
+const uint8_t* NorFlashSim_GetData(void);
+uint32_t       NorFlashSim_GetEraseCount(uint32_t sectorIndex);
+uint32_t       NorFlashSim_GetTotalEraseCount(void);
+uint32_t       NorFlashSim_GetProgramCount(void);
+uint32_t       NorFlashSim_GetErrorCount(void);
+uint32_t       NorFlashSim_GetReadByteCount(void);
+uint64_t       NorFlashSim_GetElapsedMicroseconds(void);
+
+
+#endif /* _NOR_FLASH_SIM_H_ */
@@ -0,0 +1,336 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Writes the dump into an area of internal flash reserved for it, so that it can be read back after the device has been
+   reset.  The dump bytes are gathered into a RAM buffer and only programmed once a whole page has been filled.  Sectors
+   are erased just before the first page within them is programmed, so a small dump only wears the sectors it uses.
+   The area can also be split into slots which are used round-robin so that the most recent dumps are kept. */
+#include <CrashCatcher.h>
+#include <string.h>
+#include "Crc32.h"
+
+
+/* Number of bytes programmed into the flash by each call to CrashCatcher_FlashProgram().  The buffer used to gather a
+   page is placed in RAM so it shouldn't be larger than needed. */
+#if !defined(CRASH_CATCHER_FLASH_DUMP_PAGE_SIZE)
+    #define CRASH_CATCHER_FLASH_DUMP_PAGE_SIZE 256
+#endif
+#if CRASH_CATCHER_FLASH_DUMP_PAGE_SIZE < 4 || CRASH_CATCHER_FLASH_DUMP_PAGE_SIZE > 4096
+    #error CRASH_CATCHER_FLASH_DUMP_PAGE_SIZE must be between 4 and 4096.
+#endif
+#if (CRASH_CATCHER_FLASH_DUMP_PAGE_SIZE & (CRASH_CATCHER_FLASH_DUMP_PAGE_SIZE - 1)) != 0
+    #error CRASH_CATCHER_FLASH_DUMP_PAGE_SIZE must be a power of 2.
+#endif
+
+/* Value of erased flash, used to pad out the last page of the dump. */
+#define ERASED_BYTE 0xFF
+
+/* Number of bytes at the start of each slot taken up by its header, rounded up to a whole number of pages. */
+#define SLOT_HEADER_SIZE (((sizeof(CrashCatcherFlashSlotHeader) + CRASH_CATCHER_FLASH_DUMP_PAGE_SIZE - 1) / \
+                           CRASH_CATCHER_FLASH_DUMP_PAGE_SIZE) * CRASH_CATCHER_FLASH_DUMP_PAGE_SIZE)
+
+
+/* Optional HAL routine for flash which isn't memory mapped. */
+int CrashCatcher_FlashRead(uint32_t address, void* pvBuffer, size_t size) __attribute__((weak));
+
+
+/* Dumping again would erase and program the sectors again so a crash waits forever unless the tests say otherwise. */
+CRASH_CATCHER_TEST_WRITEABLE CrashCatcherReturnCodes g_crashCatcherDumpEndReturn = CRASH_CATCHER_TRY_AGAIN;
+static                       CrashCatcherInfo        g_info;
+
+static uint8_t  g_page[CRASH_CATCHER_FLASH_DUMP_PAGE_SIZE];
+static size_t   g_pageLength;
+static uint32_t g_slotAddress;
+static uint32_t g_nextPageAddress;
+static uint32_t g_erasedEndAddress;
+static uint32_t g_endAddress;
+static uint32_t g_sectorSize;
+static uint32_t g_sequence;
+static uint32_t g_dataSize;
+static uint32_t g_dataCrc;
+static int      g_isSlot;
+static int      g_isAreaValid;
+static int      g_isStopped;
+
+
+static int      isFlashAreaValid(const CrashCatcherFlashArea* pArea);
+static uint32_t getSlotSize(const CrashCatcherFlashArea* pArea);
+static uint32_t findNextSlot(const CrashCatcherFlashArea* pArea, uint32_t* pSequence);
+static int      readSlotHeader(const CrashCatcherFlashArea* pArea, uint32_t slotIndex,
+                               CrashCatcherFlashSlotHeader* pHeader);
+static int      readFlash(uint32_t address, void* pvBuffer, size_t size);
+static void     appendElement(const uint8_t* pElement, CrashCatcherElementSizes elementSize);
+static void     appendBytes(const uint8_t* pBytes, size_t byteCount);
+static void     programPage(void);
+static int      eraseSectorContaining(uint32_t address);
+static void     programSlotHeader(void);
+static const CrashCatcherFlashArea* getValidSlotArea(uint32_t slotIndex);
+
+
+void CrashCatcher_DumpStart(const CrashCatcherInfo* pInfo)
+{
+    const CrashCatcherFlashArea* pArea = CrashCatcher_GetFlashArea();
+
+    g_info = *pInfo;
+    g_pageLength = 0;
+    g_dataSize = 0;
+    g_dataCrc = 0;
+    g_isAreaValid = isFlashAreaValid(pArea);
+    g_isStopped = !g_isAreaValid;
+    if (g_isStopped)
+        return;
+    g_isSlot = pArea->slotCount != 0;
+    g_slotAddress = pArea->startAddress;
+    g_endAddress = pArea->startAddress + pArea->size;
+    g_nextPageAddress = pArea->startAddress;
+    if (g_isSlot)
+    {
+        g_slotAddress += findNextSlot(pArea, &g_sequence) * getSlotSize(pArea);
+        g_endAddress = g_slotAddress + getSlotSize(pArea);
+        g_nextPageAddress = g_slotAddress + SLOT_HEADER_SIZE;
+    }
+    g_erasedEndAddress = g_slotAddress;
+    g_sectorSize = pArea->sectorSize;
+}
+
+static int isFlashAreaValid(const CrashCatcherFlashArea* pArea)
+{
+    if (!pArea || pArea->sectorSize == 0 || pArea->size == 0)
+        return 0;
+    if (pArea->slotCount != 0 &&
+        (pArea->size % (pArea->slotCount * pArea->sectorSize) != 0 || getSlotSize(pArea) <= SLOT_HEADER_SIZE))
+    {
+        return 0;
+    }
+    return pArea->sectorSize % CRASH_CATCHER_FLASH_DUMP_PAGE_SIZE == 0 &&
+           pArea->startAddress % pArea->sectorSize == 0 &&
+           pArea->size % pArea->sectorSize == 0;
+}
+
+static uint32_t getSlotSize(const CrashCatcherFlashArea* pArea)
+{
+    return pArea->size / pArea->slotCount;
+}
+
+static uint32_t findNextSlot(const CrashCatcherFlashArea* pArea, uint32_t* pSequence)
+{
+    CrashCatcherFlashSlotHeader header;
+    uint32_t                    newestSlot = pArea->slotCount - 1;
+    uint32_t                    newestSequence = 0;
+    uint32_t                    i;
+
+    /* Only the headers are read.  Slots which are empty or were interrupted by a reset before their header was
+       programmed are skipped over, so the slot after the newest dump is always the one reused. */
+    for (i = 0 ; i < pArea->slotCount ; i++)
+    {
+        if (readSlotHeader(pArea, i, &header) && header.sequence > newestSequence)
+        {
+            newestSlot = i;
+            newestSequence = header.sequence;
+        }
+    }
+    *pSequence = newestSequence + 1;
+    return (newestSlot + 1) % pArea->slotCount;
+}
+
+static int readSlotHeader(const CrashCatcherFlashArea* pArea, uint32_t slotIndex, CrashCatcherFlashSlotHeader* pHeader)
+{
+    uint32_t slotSize = getSlotSize(pArea);
+
+    if (!readFlash(pArea->startAddress + slotIndex * slotSize, pHeader, sizeof(*pHeader)))
+        return 0;
+    return pHeader->signature == CRASH_CATCHER_FLASH_SLOT_SIGNATURE && pHeader->size <= slotSize - SLOT_HEADER_SIZE;
+}
+
+static int readFlash(uint32_t address, void* pvBuffer, size_t size)
+{
+    if (CrashCatcher_FlashRead)
+        return CrashCatcher_FlashRead(address, pvBuffer, size) == 0;
+    memcpy(pvBuffer, (const void*)(unsigned long)address, size);
+    return 1;
+}
+
+
+void CrashCatcher_DumpMemory(const void* pvMemory, CrashCatcherElementSizes elementSize, size_t elementCount)
+{
+    const uint8_t* pMemory = (const uint8_t*)pvMemory;
+
+    if (elementSize == CRASH_CATCHER_BYTE)
+    {
+        appendBytes(pMemory, elementCount);
+        return;
+    }
+    while (elementCount-- > 0)
+    {
+        appendElement(pMemory, elementSize);
+        pMemory += elementSize;
+    }
+}
+
+static void appendElement(const uint8_t* pElement, CrashCatcherElementSizes elementSize)
+{
+    /* Read halfwords and words with a single access of that size since they are likely to be peripheral registers. */
+    if (elementSize == CRASH_CATCHER_HALFWORD)
+    {
+        uint16_t val = *(const uint16_t*)pElement;
+        appendBytes((const uint8_t*)&val, sizeof(val));
+    }
+    else
+    {
+        uint32_t val = *(const uint32_t*)pElement;
+        appendBytes((const uint8_t*)&val, sizeof(val));
+    }
+}
+
+static void appendBytes(const uint8_t* pBytes, size_t byteCount)
+{
+    while (byteCount > 0 && !g_isStopped)
+    {
+        size_t bytesLeft = CRASH_CATCHER_FLASH_DUMP_PAGE_SIZE - g_pageLength;
+        size_t bytesToCopy = byteCount < bytesLeft ? byteCount : bytesLeft;
+
+        memcpy(&g_page[g_pageLength], pBytes, bytesToCopy);
+        g_pageLength += bytesToCopy;
+        pBytes += bytesToCopy;
+        byteCount -= bytesToCopy;
+        if (g_pageLength == CRASH_CATCHER_FLASH_DUMP_PAGE_SIZE)
+            programPage();
+    }
+}
+
+static void programPage(void)
+{
+    /* The rest of the dump is dropped once the area is full or the flash reports an error.  The host can tell that the
+       dump is truncated since it is missing its end. */
+    if (g_nextPageAddress >= g_endAddress || !eraseSectorContaining(g_nextPageAddress))
+    {
+        g_isStopped = 1;
+        return;
+    }
+    if (CrashCatcher_FlashProgram(g_nextPageAddress, g_page, CRASH_CATCHER_FLASH_DUMP_PAGE_SIZE) != 0)
+    {
+        g_isStopped = 1;
+        return;
+    }
+    g_dataCrc = CrashCatcher_Crc32(g_dataCrc, g_page, g_pageLength);
+    g_dataSize += g_pageLength;
+    g_nextPageAddress += CRASH_CATCHER_FLASH_DUMP_PAGE_SIZE;
+    g_pageLength = 0;
+}
+
+static int eraseSectorContaining(uint32_t address)
+{
+    /* Sectors are erased in order but a page can be more than one sector past the last one erased when they are
+       the same size since the slot header page is skipped over before the first data page is programmed. */
+    while (address >= g_erasedEndAddress)
+    {
+        if (CrashCatcher_FlashErase(g_erasedEndAddress) != 0)
+            return 0;
+        g_erasedEndAddress += g_sectorSize;
+    }
+    return 1;
+}
+
+
+CrashCatcherReturnCodes CrashCatcher_DumpEnd(void)
+{
+    /* The last page is padded out to look like erased flash since partial pages are never programmed. */
+    if (g_pageLength > 0 && !g_isStopped)
+    {
+        memset(&g_page[g_pageLength], ERASED_BYTE, CRASH_CATCHER_FLASH_DUMP_PAGE_SIZE - g_pageLength);
+        programPage();
+    }
+    if (g_isSlot && g_isAreaValid)
+        programSlotHeader();
+    if (g_info.isBKPT || g_info.isRetained)
+        return CRASH_CATCHER_EXIT;
+    while (g_crashCatcherDumpEndReturn == CRASH_CATCHER_TRY_AGAIN)
+    {
+    }
+    return g_crashCatcherDumpEndReturn;
+}
+
+static void programSlotHeader(void)
+{
+    CrashCatcherFlashSlotHeader header;
+    const uint8_t*              pHeader = (const uint8_t*)&header;
+    uint32_t                    offset;
+
+    header.signature = CRASH_CATCHER_FLASH_SLOT_SIGNATURE;
+    header.sequence = g_sequence;
+    header.size = g_dataSize;
+    header.crc = g_dataCrc;
+    header.isTruncated = g_isStopped;
+    header.pc = g_info.pc;
+    header.lr = g_info.lr;
+    header.faultCause = g_info.faultCause;
+    /* A dump with no data still needs its first sector erased before the header can be programmed. */
+    if (!eraseSectorContaining(g_slotAddress))
+        return;
+    for (offset = 0 ; offset < SLOT_HEADER_SIZE ; offset += CRASH_CATCHER_FLASH_DUMP_PAGE_SIZE)
+    {
+        size_t bytesToCopy = sizeof(header) - offset;
+
+        if (bytesToCopy > CRASH_CATCHER_FLASH_DUMP_PAGE_SIZE)
+            bytesToCopy = CRASH_CATCHER_FLASH_DUMP_PAGE_SIZE;
+        memset(g_page, ERASED_BYTE, sizeof(g_page));
+        memcpy(g_page, pHeader + offset, bytesToCopy);
+        if (CrashCatcher_FlashProgram(g_slotAddress + offset, g_page, CRASH_CATCHER_FLASH_DUMP_PAGE_SIZE) != 0)
+            return;
+    }
+}
+
+
+uint32_t CrashCatcher_FlashDumpGetSlotCount(void)
+{
+    const CrashCatcherFlashArea* pArea = CrashCatcher_GetFlashArea();
+
+    if (!isFlashAreaValid(pArea))
+        return 0;
+    return pArea->slotCount;
+}
+
+int CrashCatcher_FlashDumpReadSlotHeader(uint32_t slotIndex, CrashCatcherFlashSlotHeader* pHeader)
+{
+    const CrashCatcherFlashArea* pArea = getValidSlotArea(slotIndex);
+
+    if (!pArea)
+        return 0;
+    return readSlotHeader(pArea, slotIndex, pHeader);
+}
+
+static const CrashCatcherFlashArea* getValidSlotArea(uint32_t slotIndex)
+{
+    const CrashCatcherFlashArea* pArea = CrashCatcher_GetFlashArea();
+
+    if (!isFlashAreaValid(pArea) || slotIndex >= pArea->slotCount)
+        return NULL;
+    return pArea;
+}
+
+size_t CrashCatcher_FlashDumpReadSlot(uint32_t slotIndex, uint32_t offset, void* pvBuffer, size_t size)
+{
+    const CrashCatcherFlashArea* pArea = getValidSlotArea(slotIndex);
+    CrashCatcherFlashSlotHeader  header;
+    uint32_t                     dataAddress;
+
+    if (!pArea || !readSlotHeader(pArea, slotIndex, &header) || offset >= header.size)
+        return 0;
+    if (size > header.size - offset)
+        size = header.size - offset;
+    dataAddress = pArea->startAddress + slotIndex * getSlotSize(pArea) + SLOT_HEADER_SIZE;
+    if (!readFlash(dataAddress + offset, pvBuffer, size))
+        return 0;
+    return size;
+}
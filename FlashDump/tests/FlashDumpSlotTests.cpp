@@ -0,0 +1,283 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include <stdint.h>
+#include <string.h>
+
+// Include headers from C modules under test.
+extern "C"
+{
+    #include <CrashCatcher.h>
+    #include <NorFlashSim.h>
+    #include <Crc32.h>
+
+    extern CrashCatcherReturnCodes g_crashCatcherDumpEndReturn;
+}
+
+// Include C++ headers for test harness.
+#include <CppUTest/TestHarness.h>
+
+
+#define PAGE_SIZE       256
+#define SECTOR_SIZE     2048
+#define SECTOR_COUNT    4
+#define AREA_SIZE       (SECTOR_COUNT * SECTOR_SIZE)
+#define AREA_START      0x08070000
+#define SLOT_COUNT      4
+#define SLOT_SIZE       (AREA_SIZE / SLOT_COUNT)
+#define HEADER_SIZE     PAGE_SIZE
+#define SLOT_CAPACITY   (SLOT_SIZE - HEADER_SIZE)
+
+
+TEST_GROUP(FlashDumpSlots)
+{
+    CrashCatcherInfo            m_info;
+    CrashCatcherFlashSlotHeader m_header;
+    uint8_t                     m_memory[AREA_SIZE];
+    uint8_t                     m_readBuffer[AREA_SIZE];
+
+    void setup()
+    {
+        NorFlashSim_Init(AREA_START, AREA_SIZE, SECTOR_SIZE, PAGE_SIZE);
+        NorFlashSim_SetSlotCount(SLOT_COUNT);
+        memset(&m_info, 0, sizeof(m_info));
+        memset(&m_header, 0, sizeof(m_header));
+        for (size_t i = 0 ; i < sizeof(m_memory) ; i++)
+            m_memory[i] = i * 7 + (i >> 8);
+        g_crashCatcherDumpEndReturn = CRASH_CATCHER_EXIT;
+    }
+
+    void teardown()
+    {
+        NorFlashSim_Uninit();
+    }
+
+    void dumpBytes(size_t byteCount, size_t startOffset = 0)
+    {
+        CrashCatcher_DumpStart(&m_info);
+        CrashCatcher_DumpMemory(m_memory + startOffset, CRASH_CATCHER_BYTE, byteCount);
+        CHECK_EQUAL(CRASH_CATCHER_EXIT, CrashCatcher_DumpEnd());
+    }
+
+    void validateSlot(uint32_t slotIndex, uint32_t sequence, size_t size, size_t startOffset = 0)
+    {
+        CHECK_TRUE(CrashCatcher_FlashDumpReadSlotHeader(slotIndex, &m_header));
+        CHECK_EQUAL(CRASH_CATCHER_FLASH_SLOT_SIGNATURE, m_header.signature);
+        CHECK_EQUAL(sequence, m_header.sequence);
+        CHECK_EQUAL(size, m_header.size);
+        CHECK_EQUAL(CrashCatcher_Crc32(0, m_memory + startOffset, size), m_header.crc);
+        CHECK_EQUAL(size, CrashCatcher_FlashDumpReadSlot(slotIndex, 0, m_readBuffer, sizeof(m_readBuffer)));
+        MEMCMP_EQUAL(m_memory + startOffset, m_readBuffer, size);
+    }
+
+    void validateSlotEmpty(uint32_t slotIndex)
+    {
+        CHECK_FALSE(CrashCatcher_FlashDumpReadSlotHeader(slotIndex, &m_header));
+        CHECK_EQUAL(0, CrashCatcher_FlashDumpReadSlot(slotIndex, 0, m_readBuffer, sizeof(m_readBuffer)));
+    }
+};
+
+
+TEST(FlashDumpSlots, GetSlotCount_ShouldReturnCountFromFlashArea)
+{
+    CHECK_EQUAL(SLOT_COUNT, CrashCatcher_FlashDumpGetSlotCount());
+}
+
+TEST(FlashDumpSlots, GetSlotCount_NoSlots_ShouldReturnZero)
+{
+    NorFlashSim_SetSlotCount(0);
+    CHECK_EQUAL(0, CrashCatcher_FlashDumpGetSlotCount());
+}
+
+TEST(FlashDumpSlots, ErasedArea_ShouldHaveNoDumps)
+{
+    for (uint32_t i = 0 ; i < SLOT_COUNT ; i++)
+        validateSlotEmpty(i);
+    validateSlotEmpty(SLOT_COUNT);
+}
+
+TEST(FlashDumpSlots, FirstDump_ShouldGoIntoFirstSlotAfterItsHeaderWithSequenceOne)
+{
+    dumpBytes(300);
+    validateSlot(0, 1, 300);
+    CHECK_FALSE(m_header.isTruncated);
+    MEMCMP_EQUAL(m_memory, NorFlashSim_GetData() + HEADER_SIZE, 300);
+    CHECK_EQUAL(1, NorFlashSim_GetEraseCount(0));
+    CHECK_EQUAL(3, NorFlashSim_GetProgramCount());
+    CHECK_EQUAL(0, NorFlashSim_GetErrorCount());
+    for (uint32_t i = 1 ; i < SLOT_COUNT ; i++)
+        validateSlotEmpty(i);
+}
+
+TEST(FlashDumpSlots, Dump_ShouldRecordFaultSignatureInHeader)
+{
+    m_info.pc = 0x08001234;
+    m_info.lr = 0x08005679;
+    m_info.faultCause = CRASH_CATCHER_FAULT_DATA_ACCESS;
+    dumpBytes(16);
+    CHECK_TRUE(CrashCatcher_FlashDumpReadSlotHeader(0, &m_header));
+    CHECK_EQUAL(0x08001234, m_header.pc);
+    CHECK_EQUAL(0x08005679, m_header.lr);
+    CHECK_EQUAL(CRASH_CATCHER_FAULT_DATA_ACCESS, m_header.faultCause);
+}
+
+TEST(FlashDumpSlots, EmptyDump_ShouldStillEraseAndProgramHeader)
+{
+    dumpBytes(0);
+    validateSlot(0, 1, 0);
+    CHECK_EQUAL(1, NorFlashSim_GetTotalEraseCount());
+    CHECK_EQUAL(1, NorFlashSim_GetProgramCount());
+}
+
+TEST(FlashDumpSlots, RepeatedDumps_ShouldUseSlotsRoundRobinAndKeepNewestDumps)
+{
+    for (size_t i = 0 ; i < SLOT_COUNT + 2 ; i++)
+        dumpBytes(100 + i, i);
+    validateSlot(0, 5, 104, 4);
+    validateSlot(1, 6, 105, 5);
+    validateSlot(2, 3, 102, 2);
+    validateSlot(3, 4, 103, 3);
+    CHECK_EQUAL(2, NorFlashSim_GetEraseCount(0));
+    CHECK_EQUAL(2, NorFlashSim_GetEraseCount(1));
+    CHECK_EQUAL(1, NorFlashSim_GetEraseCount(2));
+    CHECK_EQUAL(1, NorFlashSim_GetEraseCount(3));
+    CHECK_EQUAL(0, NorFlashSim_GetErrorCount());
+}
+
+TEST(FlashDumpSlots, DumpLargerThanSlot_ShouldStopAtEndOfSlotAndMarkTruncated)
+{
+    dumpBytes(SLOT_CAPACITY + 1);
+    validateSlot(0, 1, SLOT_CAPACITY);
+    CHECK_TRUE(m_header.isTruncated);
+    validateSlotEmpty(1);
+    CHECK_EQUAL(1, NorFlashSim_GetTotalEraseCount());
+    CHECK_EQUAL(0, NorFlashSim_GetErrorCount());
+}
+
+TEST(FlashDumpSlots, DumpFillingSlotExactly_ShouldNotBeTruncated)
+{
+    dumpBytes(SLOT_CAPACITY);
+    validateSlot(0, 1, SLOT_CAPACITY);
+    CHECK_FALSE(m_header.isTruncated);
+}
+
+TEST(FlashDumpSlots, MultiSectorSlots_ShouldEraseEachSectorOfSlotLazily)
+{
+    NorFlashSim_SetSlotCount(2);
+    dumpBytes(SECTOR_SIZE);
+    validateSlot(0, 1, SECTOR_SIZE);
+    CHECK_EQUAL(1, NorFlashSim_GetEraseCount(0));
+    CHECK_EQUAL(1, NorFlashSim_GetEraseCount(1));
+    CHECK_EQUAL(0, NorFlashSim_GetEraseCount(2));
+    dumpBytes(10);
+    validateSlot(1, 2, 10);
+    CHECK_EQUAL(1, NorFlashSim_GetEraseCount(2));
+    CHECK_EQUAL(0, NorFlashSim_GetEraseCount(3));
+}
+
+TEST(FlashDumpSlots, SectorSameSizeAsPage_ShouldEraseEverySectorBeforeProgrammingIt)
+{
+    // Start with stale data in every sector so that any page programmed without an erase is caught by the simulator.
+    NorFlashSim_Uninit();
+    NorFlashSim_Init(AREA_START, AREA_SIZE, PAGE_SIZE, PAGE_SIZE);
+    NorFlashSim_SetSlotCount(SLOT_COUNT);
+    NorFlashSim_Fill(0x00);
+    dumpBytes(PAGE_SIZE * 2 + 10);
+    validateSlot(0, 1, PAGE_SIZE * 2 + 10);
+    CHECK_FALSE(m_header.isTruncated);
+    MEMCMP_EQUAL(m_memory, NorFlashSim_GetData() + HEADER_SIZE, PAGE_SIZE * 2 + 10);
+    for (uint32_t i = 0 ; i < 4 ; i++)
+        CHECK_EQUAL(1, NorFlashSim_GetEraseCount(i));
+    CHECK_EQUAL(0, NorFlashSim_GetEraseCount(4));
+    CHECK_EQUAL(4, NorFlashSim_GetProgramCount());
+    CHECK_EQUAL(0, NorFlashSim_GetErrorCount());
+}
+
+TEST(FlashDumpSlots, ProgramFailure_ShouldKeepDataWrittenBeforeItAndMarkTruncated)
+{
+    // Operation 0 is the erase of the slot's sector and operation 2 is the program of its second data page.
+    NorFlashSim_FailOperation(2);
+    dumpBytes(PAGE_SIZE * 3);
+    validateSlot(0, 1, PAGE_SIZE);
+    CHECK_TRUE(m_header.isTruncated);
+}
+
+TEST(FlashDumpSlots, HeaderProgramFailure_ShouldLeaveSlotEmptyAndReuseItForNextDump)
+{
+    dumpBytes(10);
+    // Operations 0 to 2 wrote the first dump and operation 5 is the program of the second dump's header.
+    NorFlashSim_FailOperation(5);
+    dumpBytes(20);
+    validateSlotEmpty(1);
+    dumpBytes(30);
+    validateSlot(0, 1, 10);
+    validateSlot(1, 2, 30);
+    validateSlotEmpty(2);
+}
+
+TEST(FlashDumpSlots, DumpStart_ShouldOnlyReadSlotHeaders)
+{
+    for (size_t i = 0 ; i < SLOT_COUNT ; i++)
+        dumpBytes(SLOT_CAPACITY);
+    CHECK_EQUAL(SLOT_COUNT * SLOT_COUNT * sizeof(CrashCatcherFlashSlotHeader), NorFlashSim_GetReadByteCount());
+}
+
+TEST(FlashDumpSlots, SequenceNumbers_ShouldContinueFromNewestSlotWhenNotInSlotOrder)
+{
+    for (size_t i = 0 ; i < SLOT_COUNT + 1 ; i++)
+        dumpBytes(8);
+    dumpBytes(9);
+    validateSlot(1, 6, 9);
+    validateSlot(2, 3, 8);
+}
+
+TEST(FlashDumpSlots, ReadSlot_ShouldHonourOffsetAndSize)
+{
+    dumpBytes(300);
+    CHECK_EQUAL(50, CrashCatcher_FlashDumpReadSlot(0, 100, m_readBuffer, 50));
+    MEMCMP_EQUAL(m_memory + 100, m_readBuffer, 50);
+    CHECK_EQUAL(20, CrashCatcher_FlashDumpReadSlot(0, 280, m_readBuffer, 50));
+    MEMCMP_EQUAL(m_memory + 280, m_readBuffer, 20);
+    CHECK_EQUAL(0, CrashCatcher_FlashDumpReadSlot(0, 300, m_readBuffer, 50));
+}
+
+TEST(FlashDumpSlots, HeaderWithSizeLargerThanSlot_ShouldBeTreatedAsEmptySlot)
+{
+    // Write the header with two slots per area and then read it back as the first of four smaller slots.
+    NorFlashSim_SetSlotCount(2);
+    dumpBytes(SLOT_CAPACITY + 1);
+    CHECK_TRUE(CrashCatcher_FlashDumpReadSlotHeader(0, &m_header));
+    NorFlashSim_SetSlotCount(SLOT_COUNT);
+    validateSlotEmpty(0);
+}
+
+TEST(FlashDumpSlots, InvalidSlotLayouts_ShouldNotAccessFlash)
+{
+    static const CrashCatcherFlashArea partialSlots = { AREA_START, AREA_SIZE, SECTOR_SIZE, 3 };
+    static const CrashCatcherFlashArea tooManySlots = { AREA_START, AREA_SIZE, SECTOR_SIZE, 8 };
+    static const CrashCatcherFlashArea headerOnlySlots = { AREA_START, AREA_SIZE, PAGE_SIZE, AREA_SIZE / PAGE_SIZE };
+
+    NorFlashSim_SetFlashArea(&partialSlots);
+    dumpBytes(PAGE_SIZE);
+    CHECK_EQUAL(0, CrashCatcher_FlashDumpGetSlotCount());
+    NorFlashSim_SetFlashArea(&tooManySlots);
+    dumpBytes(PAGE_SIZE);
+    CHECK_EQUAL(0, CrashCatcher_FlashDumpGetSlotCount());
+    NorFlashSim_SetFlashArea(&headerOnlySlots);
+    dumpBytes(PAGE_SIZE);
+    CHECK_EQUAL(0, CrashCatcher_FlashDumpGetSlotCount());
+    CHECK_EQUAL(0, NorFlashSim_GetTotalEraseCount());
+    CHECK_EQUAL(0, NorFlashSim_GetProgramCount());
+    CHECK_EQUAL(0, NorFlashSim_GetReadByteCount());
+}
@@ -0,0 +1,254 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include <stdint.h>
+#include <string.h>
+
+// Include headers from C modules under test.
+extern "C"
+{
+    #include <CrashCatcher.h>
+    #include <NorFlashSim.h>
+
+    // The unit tests can set this to CRASH_CATCHER_EXIT so that FlashDump's CrashCatcher_DumpEnd() will return rather
+    // than wait forever.
+    extern CrashCatcherReturnCodes g_crashCatcherDumpEndReturn;
+}
+
+// Include C++ headers for test harness.
+#include <CppUTest/TestHarness.h>
+
+
+#define PAGE_SIZE       256
+#define SECTOR_SIZE     2048
+#define SECTOR_COUNT    4
+#define AREA_SIZE       (SECTOR_COUNT * SECTOR_SIZE)
+#define AREA_START      0x08070000
+#define ERASE_TIME      20000
+#define PROGRAM_TIME    1000
+
+
+TEST_GROUP(FlashDump)
+{
+    CrashCatcherInfo m_info;
+    uint8_t          m_memory[AREA_SIZE + 300];
+
+    void setup()
+    {
+        NorFlashSim_Init(AREA_START, AREA_SIZE, SECTOR_SIZE, PAGE_SIZE);
+        NorFlashSim_SetTimings(ERASE_TIME, PROGRAM_TIME);
+        memset(&m_info, 0, sizeof(m_info));
+        for (size_t i = 0 ; i < sizeof(m_memory) ; i++)
+            m_memory[i] = i * 7 + (i >> 8);
+        g_crashCatcherDumpEndReturn = CRASH_CATCHER_EXIT;
+    }
+
+    void teardown()
+    {
+        NorFlashSim_Uninit();
+    }
+
+    void dumpBytes(size_t byteCount)
+    {
+        CrashCatcher_DumpStart(&m_info);
+        CrashCatcher_DumpMemory(m_memory, CRASH_CATCHER_BYTE, byteCount);
+        CHECK_EQUAL(CRASH_CATCHER_EXIT, CrashCatcher_DumpEnd());
+    }
+
+    void validateFlash(const uint8_t* pExpected, size_t expectedSize)
+    {
+        const uint8_t* pFlash = NorFlashSim_GetData();
+
+        MEMCMP_EQUAL(pExpected, pFlash, expectedSize);
+        for (size_t i = expectedSize ; i < AREA_SIZE ; i++)
+            CHECK_EQUAL(0xFF, pFlash[i]);
+    }
+
+    void validateEraseCounts(uint32_t sector0, uint32_t sector1, uint32_t sector2, uint32_t sector3)
+    {
+        CHECK_EQUAL(sector0, NorFlashSim_GetEraseCount(0));
+        CHECK_EQUAL(sector1, NorFlashSim_GetEraseCount(1));
+        CHECK_EQUAL(sector2, NorFlashSim_GetEraseCount(2));
+        CHECK_EQUAL(sector3, NorFlashSim_GetEraseCount(3));
+    }
+
+    void validateNoFlashAccess()
+    {
+        CHECK_EQUAL(0, NorFlashSim_GetTotalEraseCount());
+        CHECK_EQUAL(0, NorFlashSim_GetProgramCount());
+        CHECK_EQUAL(0, NorFlashSim_GetErrorCount());
+    }
+};
+
+
+TEST(FlashDump, DumpNothing_ShouldNotEraseOrProgram)
+{
+    dumpBytes(0);
+    validateNoFlashAccess();
+}
+
+TEST(FlashDump, DumpOneByte_ShouldEraseFirstSectorAndProgramOnePaddedPage)
+{
+    dumpBytes(1);
+    validateFlash(m_memory, 1);
+    validateEraseCounts(1, 0, 0, 0);
+    CHECK_EQUAL(1, NorFlashSim_GetProgramCount());
+    CHECK_EQUAL(0, NorFlashSim_GetErrorCount());
+}
+
+TEST(FlashDump, DumpExactlyOnePage_ShouldProgramOnlyThatPage)
+{
+    dumpBytes(PAGE_SIZE);
+    validateFlash(m_memory, PAGE_SIZE);
+    CHECK_EQUAL(1, NorFlashSim_GetProgramCount());
+    CHECK_EQUAL(0, NorFlashSim_GetErrorCount());
+}
+
+TEST(FlashDump, DumpMemoryAcrossCalls_ShouldPackPagesFull)
+{
+    CrashCatcher_DumpStart(&m_info);
+    CrashCatcher_DumpMemory(m_memory, CRASH_CATCHER_BYTE, 100);
+    CrashCatcher_DumpMemory(m_memory + 100, CRASH_CATCHER_BYTE, 1);
+    CrashCatcher_DumpMemory(m_memory + 101, CRASH_CATCHER_BYTE, 199);
+    CrashCatcher_DumpEnd();
+    validateFlash(m_memory, 300);
+    CHECK_EQUAL(2, NorFlashSim_GetProgramCount());
+    CHECK_EQUAL(0, NorFlashSim_GetErrorCount());
+}
+
+TEST(FlashDump, DumpHalfwordsAndWords_ShouldWriteInMemoryByteOrder)
+{
+    static const uint16_t halfwords[] = { 0x0100, 0x0302 };
+    static const uint32_t words[] = { 0x07060504 };
+    static const uint8_t  expected[] = { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07 };
+
+    CrashCatcher_DumpStart(&m_info);
+    CrashCatcher_DumpMemory(halfwords, CRASH_CATCHER_HALFWORD, 2);
+    CrashCatcher_DumpMemory(words, CRASH_CATCHER_WORD, 1);
+    CrashCatcher_DumpEnd();
+    validateFlash(expected, sizeof(expected));
+}
+
+TEST(FlashDump, DumpIntoSecondSector_ShouldEraseEachUsedSectorOnceJustBeforeItsFirstPage)
+{
+    dumpBytes(SECTOR_SIZE + 1);
+    validateFlash(m_memory, SECTOR_SIZE + 1);
+    validateEraseCounts(1, 1, 0, 0);
+    CHECK_EQUAL(SECTOR_SIZE / PAGE_SIZE + 1, NorFlashSim_GetProgramCount());
+    CHECK_EQUAL(0, NorFlashSim_GetErrorCount());
+}
+
+TEST(FlashDump, DumpOverPreviousContents_ShouldEraseBeforeProgramming)
+{
+    NorFlashSim_Fill(0x00);
+    dumpBytes(PAGE_SIZE);
+    MEMCMP_EQUAL(m_memory, NorFlashSim_GetData(), PAGE_SIZE);
+    CHECK_EQUAL(0xFF, NorFlashSim_GetData()[PAGE_SIZE]);
+    CHECK_EQUAL(0x00, NorFlashSim_GetData()[SECTOR_SIZE]);
+    CHECK_EQUAL(0, NorFlashSim_GetErrorCount());
+}
+
+TEST(FlashDump, DumpFillingArea_ShouldTakeOneEraseForEachSectorAndOneProgramForEachPage)
+{
+    dumpBytes(AREA_SIZE);
+    validateFlash(m_memory, AREA_SIZE);
+    validateEraseCounts(1, 1, 1, 1);
+    CHECK_EQUAL(AREA_SIZE / PAGE_SIZE, NorFlashSim_GetProgramCount());
+    CHECK_EQUAL(SECTOR_COUNT * ERASE_TIME + (AREA_SIZE / PAGE_SIZE) * PROGRAM_TIME,
+                NorFlashSim_GetElapsedMicroseconds());
+}
+
+TEST(FlashDump, DumpSmallerThanArea_ShouldOnlySpendTimeOnSectorsAndPagesUsed)
+{
+    dumpBytes(3 * PAGE_SIZE + 10);
+    CHECK_EQUAL(ERASE_TIME + 4 * PROGRAM_TIME, NorFlashSim_GetElapsedMicroseconds());
+}
+
+TEST(FlashDump, DumpLargerThanArea_ShouldStopAtEndOfArea)
+{
+    dumpBytes(AREA_SIZE + 300);
+    validateFlash(m_memory, AREA_SIZE);
+    validateEraseCounts(1, 1, 1, 1);
+    CHECK_EQUAL(AREA_SIZE / PAGE_SIZE, NorFlashSim_GetProgramCount());
+    CHECK_EQUAL(0, NorFlashSim_GetErrorCount());
+}
+
+TEST(FlashDump, RepeatedSmallDumps_ShouldOnlyWearFirstSector)
+{
+    dumpBytes(100);
+    dumpBytes(PAGE_SIZE + 1);
+    dumpBytes(SECTOR_SIZE);
+    validateFlash(m_memory, SECTOR_SIZE);
+    validateEraseCounts(3, 0, 0, 0);
+    CHECK_EQUAL(0, NorFlashSim_GetErrorCount());
+}
+
+TEST(FlashDump, EraseFailure_ShouldStopWithoutProgramming)
+{
+    NorFlashSim_FailOperation(0);
+    dumpBytes(PAGE_SIZE * 2);
+    CHECK_EQUAL(0, NorFlashSim_GetTotalEraseCount());
+    CHECK_EQUAL(0, NorFlashSim_GetProgramCount());
+}
+
+TEST(FlashDump, ProgramFailure_ShouldStopWithoutFurtherFlashAccess)
+{
+    // Operation 0 is the erase of the first sector and operation 2 is the program of the second page.
+    NorFlashSim_FailOperation(2);
+    dumpBytes(PAGE_SIZE * 3 + 1);
+    validateFlash(m_memory, PAGE_SIZE);
+    CHECK_EQUAL(1, NorFlashSim_GetTotalEraseCount());
+    CHECK_EQUAL(1, NorFlashSim_GetProgramCount());
+}
+
+TEST(FlashDump, MissingFlashArea_ShouldNotAccessFlash)
+{
+    NorFlashSim_SetFlashArea(NULL);
+    dumpBytes(PAGE_SIZE);
+    validateNoFlashAccess();
+}
+
+TEST(FlashDump, MisalignedFlashAreas_ShouldNotAccessFlash)
+{
+    static const CrashCatcherFlashArea unalignedStart = { AREA_START + PAGE_SIZE, SECTOR_SIZE, SECTOR_SIZE, 0 };
+    static const CrashCatcherFlashArea partialSector = { AREA_START, SECTOR_SIZE + PAGE_SIZE, SECTOR_SIZE, 0 };
+    static const CrashCatcherFlashArea smallSector = { AREA_START, AREA_SIZE, PAGE_SIZE / 2, 0 };
+    static const CrashCatcherFlashArea emptyArea = { AREA_START, 0, SECTOR_SIZE, 0 };
+
+    NorFlashSim_SetFlashArea(&unalignedStart);
+    dumpBytes(PAGE_SIZE);
+    NorFlashSim_SetFlashArea(&partialSector);
+    dumpBytes(PAGE_SIZE);
+    NorFlashSim_SetFlashArea(&smallSector);
+    dumpBytes(PAGE_SIZE);
+    NorFlashSim_SetFlashArea(&emptyArea);
+    dumpBytes(PAGE_SIZE);
+    validateNoFlashAccess();
+}
+
+TEST(FlashDump, DumpEndForBreakpointWithTryAgain_ShouldExit)
+{
+    g_crashCatcherDumpEndReturn = CRASH_CATCHER_TRY_AGAIN;
+    m_info.isBKPT = 1;
+    dumpBytes(1);
+    validateFlash(m_memory, 1);
+}
+
+TEST(FlashDump, DumpEndForRetainedDumpWithTryAgain_ShouldExit)
+{
+    g_crashCatcherDumpEndReturn = CRASH_CATCHER_TRY_AGAIN;
+    m_info.isRetained = 1;
+    dumpBytes(1);
+    validateFlash(m_memory, 1);
+}
@@ -22,6 +22,7 @@ static const int*                      g_pGetCData;
 static char*                           g_pPutCDataStart;
 static char*                           g_pPutCDataCurr;
 static char*                           g_pPutCDataEnd;
+static uint32_t                        g_writeCallCount;
 
 void DumpMocks_Init(size_t putcBufferSize)
 {
@@ -30,6 +31,7 @@ void DumpMocks_Init(size_t putcBufferSize)
     g_pPutCDataStart = malloc(putcBufferSize + 1);
     g_pPutCDataCurr = g_pPutCDataStart;
     g_pPutCDataEnd = g_pPutCDataStart + putcBufferSize;
+    g_writeCallCount = 0;
 }
 
 
@@ -60,6 +62,17 @@ const char* DumpMocks_GetPutCData(void)
     return g_pPutCDataStart;
 }
 
+size_t DumpMocks_GetPutCDataSize(void)
+{
+    return g_pPutCDataCurr - g_pPutCDataStart;
+}
+
+
+uint32_t DumpMocks_GetWriteCallCount(void)
+{
+    return g_writeCallCount;
+}
+
 
 /* Mock implementation of CrashCatcher_Dump* routines. */
 const CrashCatcherMemoryRegion* CrashCatcher_GetMemoryRegions(void)
@@ -80,3 +93,12 @@ void CrashCatcher_putc(int c)
         return;
     *g_pPutCDataCurr++ = (char)c;
 }
+
+
+void CrashCatcher_write(const char* pBuffer, size_t length)
+{
+    /* Place the characters in the same buffer as CrashCatcher_putc() so that tests can check the output either way. */
+    g_writeCallCount++;
+    while (length-- > 0)
+        CrashCatcher_putc(*pBuffer++);
+}
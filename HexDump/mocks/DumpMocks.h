@@ -26,6 +26,8 @@ void DumpMocks_SetMemoryRegions(const CrashCatcherMemoryRegion* pRegions);
 
 void        DumpMocks_SetGetcData(const int* pData);
 const char* DumpMocks_GetPutCData(void);
+size_t      DumpMocks_GetPutCDataSize(void);
+uint32_t    DumpMocks_GetWriteCallCount(void);
 
 
 #endif /* _DUMP_MOCKS_H_ */
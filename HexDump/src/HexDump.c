@@ -12,33 +12,152 @@
    See the License for the specific language governing permissions and
    limitations under the License.
 */
-#include <assert.h>
 #include <CrashCatcher.h>
+#include <string.h>
+#include "Crc32.h"
+
+
+/* Number of dumped bytes to place on each line of hex output.  It must be a multiple of 4 so that halfwords and words
+   are never split across lines. */
+#if !defined(CRASH_CATCHER_HEX_DUMP_LINE_WIDTH)
+    #define CRASH_CATCHER_HEX_DUMP_LINE_WIDTH 16
+#endif
+#if CRASH_CATCHER_HEX_DUMP_LINE_WIDTH <= 0 || (CRASH_CATCHER_HEX_DUMP_LINE_WIDTH % 4) != 0
+    #error CRASH_CATCHER_HEX_DUMP_LINE_WIDTH must be a positive multiple of 4.
+#endif
+
+/* Text encodings which can be selected with CRASH_CATCHER_HEX_DUMP_ENCODING.  Base64 and Z85 send 4 characters for every
+   3 bytes and 5 characters for every 4 bytes respectively rather than the 2 characters per byte used by hex. */
+#define CRASH_CATCHER_HEX_DUMP_ENCODING_HEX     0
+#define CRASH_CATCHER_HEX_DUMP_ENCODING_BASE64  1
+#define CRASH_CATCHER_HEX_DUMP_ENCODING_Z85     2
+#if !defined(CRASH_CATCHER_HEX_DUMP_ENCODING)
+    #define CRASH_CATCHER_HEX_DUMP_ENCODING CRASH_CATCHER_HEX_DUMP_ENCODING_HEX
+#endif
+
+/* Number of dumped bytes to place on each line of Base64 or Z85 output.  It must be a multiple of 12 so that neither the
+   3 byte Base64 groups, the 4 byte Z85 groups nor any halfwords and words are split across lines.  The default of 48
+   bytes results in 64 character Base64 lines and 60 character Z85 lines. */
+#if !defined(CRASH_CATCHER_DENSE_DUMP_LINE_WIDTH)
+    #define CRASH_CATCHER_DENSE_DUMP_LINE_WIDTH 48
+#endif
+#if CRASH_CATCHER_DENSE_DUMP_LINE_WIDTH <= 0 || (CRASH_CATCHER_DENSE_DUMP_LINE_WIDTH % 12) != 0
+    #error CRASH_CATCHER_DENSE_DUMP_LINE_WIDTH must be a positive multiple of 12.
+#endif
+
+/* When non-zero, each line starts with its line number and ends with a checksum.  The host can then ask for lines
+   which were damaged in transit to be sent again once the dump has completed. */
+#if !defined(CRASH_CATCHER_HEX_DUMP_LINE_CHECKSUMS)
+    #define CRASH_CATCHER_HEX_DUMP_LINE_CHECKSUMS 0
+#endif
+
+/* Maximum number of line ranges that the host can ask to be sent again at the end of each dump. */
+#if !defined(CRASH_CATCHER_HEX_DUMP_MAX_RESEND_RANGES)
+    #define CRASH_CATCHER_HEX_DUMP_MAX_RESEND_RANGES 8
+#endif
+
+/* Lines with checksums are sent as "NNNNNN data CCCC" where NNNNNN is the 24-bit line number and CCCC is the lower 16
+   bits of the CRC32 of the little endian line number followed by the bytes on the line. */
+#define LINE_NUMBER_DIGITS      6
+#define LINE_NUMBER_MASK        0xFFFFFF
+#define LINE_CHECKSUM_DIGITS    4
+#define LINE_CHECKSUM_SIZE      (LINE_NUMBER_DIGITS + 1 + 1 + LINE_CHECKSUM_DIGITS)
+
+#define HEX_LINE_SIZE       (2 * CRASH_CATCHER_HEX_DUMP_LINE_WIDTH + 2)
+#define DENSE_LINE_SIZE     (4 * CRASH_CATCHER_DENSE_DUMP_LINE_WIDTH / 3 + 2)
 
 
 CRASH_CATCHER_TEST_WRITEABLE CrashCatcherReturnCodes g_crashCatcherDumpEndReturn = CRASH_CATCHER_TRY_AGAIN;
+CRASH_CATCHER_TEST_WRITEABLE int                     g_crashCatcherHexDumpEncoding = CRASH_CATCHER_HEX_DUMP_ENCODING;
+CRASH_CATCHER_TEST_WRITEABLE int                     g_crashCatcherHexDumpLineChecksums =
+                                                         CRASH_CATCHER_HEX_DUMP_LINE_CHECKSUMS;
 static                       CrashCatcherInfo        g_info;
 
-static void printString(const char* pString);
-static void waitForUserInput(void);
-static void dumpBytes(const uint8_t* pMemory, size_t elementCount);
-static void dumpByteAsHex(uint8_t byte);
-static void dumpHexDigit(uint8_t nibble);
-static void dumpHalfwords(const uint16_t* pMemory, size_t elementCount);
-static void dumpWords(const uint32_t* pMemory, size_t elementCount);
+/* Each line of output is built up in this buffer so that it can be sent with a single CrashCatcher_write() call. */
+static char     g_lineBuffer[(HEX_LINE_SIZE > DENSE_LINE_SIZE ? HEX_LINE_SIZE : DENSE_LINE_SIZE) + LINE_CHECKSUM_SIZE];
+static size_t   g_lineLength;
+static uint32_t g_lineNumber;
+static uint32_t g_lineCrc;
+
+/* Lines that the host asked to be sent again.  The Core is asked to dump again with just these lines being output so
+   that they are read straight from the faulted memory a second time. */
+typedef struct
+{
+    uint32_t first;
+    uint32_t last;
+} LineRange;
+
+static LineRange g_resendRanges[CRASH_CATCHER_HEX_DUMP_MAX_RESEND_RANGES];
+static size_t    g_resendRangeCount;
+static int       g_isResending;
+static int       g_lastChar;
+
+/* Bytes waiting to be encoded as the next Base64 or Z85 group. */
+static uint8_t g_group[4];
+static size_t  g_groupLength;
+
+/* The two hex digits for byte value N are located at offset 2 * N. */
+static const char g_byteToHex[] =
+    "000102030405060708090A0B0C0D0E0F101112131415161718191A1B1C1D1E1F"
+    "202122232425262728292A2B2C2D2E2F303132333435363738393A3B3C3D3E3F"
+    "404142434445464748494A4B4C4D4E4F505152535455565758595A5B5C5D5E5F"
+    "606162636465666768696A6B6C6D6E6F707172737475767778797A7B7C7D7E7F"
+    "808182838485868788898A8B8C8D8E8F909192939495969798999A9B9C9D9E9F"
+    "A0A1A2A3A4A5A6A7A8A9AAABACADAEAFB0B1B2B3B4B5B6B7B8B9BABBBCBDBEBF"
+    "C0C1C2C3C4C5C6C7C8C9CACBCCCDCECFD0D1D2D3D4D5D6D7D8D9DADBDCDDDEDF"
+    "E0E1E2E3E4E5E6E7E8E9EAEBECEDEEEFF0F1F2F3F4F5F6F7F8F9FAFBFCFDFEFF";
+
+static const char g_base64Digits[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+static const char g_z85Digits[] = "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ.-:+=^!/*?&<>()[]{}@%$#";
+
+/* Implementations only need to provide this routine if they can send more than one character at a time. */
+void CrashCatcher_write(const char* pBuffer, size_t length) __attribute__((weak));
+
+
+static void   printString(const char* pString);
+static void   writeChars(const char* pBuffer, size_t length);
+static void   waitForUserInput(void);
+static size_t bytesPerLine(void);
+static void   sendLine(const uint8_t* pMemory, CrashCatcherElementSizes elementSize, size_t elementCount);
+static int    isLineWanted(uint32_t lineNumber);
+static void   startLine(void);
+static void   appendElement(const uint8_t* pElement, CrashCatcherElementSizes elementSize);
+static void   appendBytes(const uint8_t* pBytes, size_t byteCount);
+static size_t bytesPerGroup(void);
+static void   flushGroup(void);
+static void   appendBase64Group(void);
+static void   appendZ85Group(void);
+static void   endLine(void);
+static char*  writeHexDigits(char* pDest, uint32_t value, size_t digitCount);
+static int    receiveResendRequests(void);
+static void   readRequest(char* pRequest, size_t requestSize);
+static int    parseRange(const char* pRequest, LineRange* pRange);
+static int    parseHexNumber(const char** ppCurr, uint32_t* pValue);
 
 
 void CrashCatcher_DumpStart(const CrashCatcherInfo* pInfo)
 {
     g_info = *pInfo;
-    
+    g_lineNumber = 0;
+    if (g_isResending)
+    {
+        printString("\r\nResending lines\r\n");
+        return;
+    }
+
     printString("\r\n\r\n");
     if (pInfo->isBKPT)
         printString("BREAKPOINT");
     else
         printString("CRASH");
-    printString(" ENCOUNTERED\r\n"
-                 "Enable logging and then press any key to start dump.\r\n");
+    printString(" ENCOUNTERED");
+    /* Hex is left unannounced so that its output matches what existing host tools expect. */
+    if (g_crashCatcherHexDumpEncoding == CRASH_CATCHER_HEX_DUMP_ENCODING_BASE64)
+        printString(" (Base64)");
+    else if (g_crashCatcherHexDumpEncoding == CRASH_CATCHER_HEX_DUMP_ENCODING_Z85)
+        printString(" (Z85)");
+    printString("\r\n"
+                "Enable logging and then press any key to start dump.\r\n");
     
     waitForUserInput();
     printString("\r\n");
@@ -46,8 +165,18 @@ void CrashCatcher_DumpStart(const CrashCatcherInfo* pInfo)
 
 static void printString(const char* pString)
 {
-    while (*pString)
-        CrashCatcher_putc(*pString++);
+    writeChars(pString, strlen(pString));
+}
+
+static void writeChars(const char* pBuffer, size_t length)
+{
+    if (CrashCatcher_write)
+    {
+        CrashCatcher_write(pBuffer, length);
+        return;
+    }
+    while (length-- > 0)
+        CrashCatcher_putc(*pBuffer++);
 }
 
 static void waitForUserInput(void)
@@ -57,79 +186,309 @@ static void waitForUserInput(void)
 
 void CrashCatcher_DumpMemory(const void* pvMemory, CrashCatcherElementSizes elementSize, size_t elementCount)
 {
+    const uint8_t* pMemory = (const uint8_t*)pvMemory;
+    size_t         elementsPerLine = bytesPerLine() / elementSize;
+
+    /* Even a call with no elements sends a line so that the line numbers match up when lines are sent again. */
+    do
+    {
+        size_t elementsOnLine = elementCount < elementsPerLine ? elementCount : elementsPerLine;
+
+        sendLine(pMemory, elementSize, elementsOnLine);
+        pMemory += elementsOnLine * elementSize;
+        elementCount -= elementsOnLine;
+    } while (elementCount > 0);
+}
+
+static size_t bytesPerLine(void)
+{
+    if (g_crashCatcherHexDumpEncoding == CRASH_CATCHER_HEX_DUMP_ENCODING_HEX)
+        return CRASH_CATCHER_HEX_DUMP_LINE_WIDTH;
+    return CRASH_CATCHER_DENSE_DUMP_LINE_WIDTH;
+}
+
+static void sendLine(const uint8_t* pMemory, CrashCatcherElementSizes elementSize, size_t elementCount)
+{
+    /* Lines which aren't being sent again aren't even read from memory. */
+    if (!isLineWanted(g_lineNumber))
+    {
+        g_lineNumber++;
+        return;
+    }
+    startLine();
+    while (elementCount-- > 0)
+    {
+        appendElement(pMemory, elementSize);
+        pMemory += elementSize;
+    }
+    endLine();
+}
+
+static int isLineWanted(uint32_t lineNumber)
+{
+    size_t i;
+
+    if (!g_isResending)
+        return 1;
+    lineNumber &= LINE_NUMBER_MASK;
+    for (i = 0 ; i < g_resendRangeCount ; i++)
+    {
+        if (lineNumber >= g_resendRanges[i].first && lineNumber <= g_resendRanges[i].last)
+            return 1;
+    }
+    return 0;
+}
+
+static void startLine(void)
+{
+    uint8_t lineNumber[4];
+
+    if (!g_crashCatcherHexDumpLineChecksums)
+        return;
+    lineNumber[0] = g_lineNumber & 0xFF;
+    lineNumber[1] = (g_lineNumber >> 8) & 0xFF;
+    lineNumber[2] = (g_lineNumber >> 16) & 0xFF;
+    lineNumber[3] = 0;
+    g_lineCrc = CrashCatcher_Crc32(0, lineNumber, sizeof(lineNumber));
+    writeHexDigits(g_lineBuffer, g_lineNumber, LINE_NUMBER_DIGITS);
+    g_lineBuffer[LINE_NUMBER_DIGITS] = ' ';
+    g_lineLength = LINE_NUMBER_DIGITS + 1;
+}
+
+static void appendElement(const uint8_t* pElement, CrashCatcherElementSizes elementSize)
+{
+    /* Read halfwords and words with a single access of that size since they are likely to be peripheral registers. */
     switch (elementSize)
     {
     case CRASH_CATCHER_BYTE:
-        dumpBytes(pvMemory, elementCount);
+        appendBytes(pElement, sizeof(uint8_t));
         break;
     case CRASH_CATCHER_HALFWORD:
-        dumpHalfwords(pvMemory, elementCount);
+    {
+        uint16_t val = *(const uint16_t*)pElement;
+        appendBytes((const uint8_t*)&val, sizeof(val));
         break;
+    }
     case CRASH_CATCHER_WORD:
-        dumpWords(pvMemory, elementCount);
+    {
+        uint32_t val = *(const uint32_t*)pElement;
+        appendBytes((const uint8_t*)&val, sizeof(val));
         break;
     }
-    printString("\r\n");
+    }
 }
 
-static void dumpBytes(const uint8_t* pMemory, size_t elementCount)
+static void appendBytes(const uint8_t* pBytes, size_t byteCount)
 {
-    size_t i;
-    for (i = 0 ; i < elementCount ; i++)
+    if (g_crashCatcherHexDumpLineChecksums)
+        g_lineCrc = CrashCatcher_Crc32(g_lineCrc, pBytes, byteCount);
+    if (g_crashCatcherHexDumpEncoding != CRASH_CATCHER_HEX_DUMP_ENCODING_HEX)
+    {
+        while (byteCount-- > 0)
+        {
+            g_group[g_groupLength++] = *pBytes++;
+            if (g_groupLength == bytesPerGroup())
+                flushGroup();
+        }
+        return;
+    }
+
+    while (byteCount-- > 0)
     {
-        /* Only dump 16 bytes to a single line before introducing a line break. */
-        if (i != 0 && (i & 0xF) == 0)
-            printString("\r\n");
-        dumpByteAsHex(*pMemory++);
+        const char* pHex = &g_byteToHex[2 * *pBytes++];
+
+        g_lineBuffer[g_lineLength++] = pHex[0];
+        g_lineBuffer[g_lineLength++] = pHex[1];
     }
 }
 
-static void dumpByteAsHex(uint8_t byte)
+static size_t bytesPerGroup(void)
 {
-    dumpHexDigit(byte >> 4);
-    dumpHexDigit(byte & 0xF);
+    if (g_crashCatcherHexDumpEncoding == CRASH_CATCHER_HEX_DUMP_ENCODING_BASE64)
+        return 3;
+    return 4;
 }
 
-static void dumpHexDigit(uint8_t nibble)
+static void flushGroup(void)
 {
-    static const char hexToASCII[] = "0123456789ABCDEF";
+    if (g_groupLength == 0)
+        return;
+    memset(&g_group[g_groupLength], 0, sizeof(g_group) - g_groupLength);
+    if (g_crashCatcherHexDumpEncoding == CRASH_CATCHER_HEX_DUMP_ENCODING_BASE64)
+        appendBase64Group();
+    else
+        appendZ85Group();
+    g_groupLength = 0;
+}
+
+static void appendBase64Group(void)
+{
+    uint32_t value = ((uint32_t)g_group[0] << 16) | ((uint32_t)g_group[1] << 8) | (uint32_t)g_group[2];
+    size_t   i;
 
-    assert( nibble < 16 );
-    CrashCatcher_putc(hexToASCII[nibble]);
+    /* A partial group at the end of a line is padded out to 4 characters with '=' as in RFC 4648. */
+    for (i = 0 ; i < 4 ; i++)
+    {
+        if (i <= g_groupLength)
+            g_lineBuffer[g_lineLength++] = g_base64Digits[(value >> (18 - 6 * i)) & 0x3F];
+        else
+            g_lineBuffer[g_lineLength++] = '=';
+    }
 }
 
-static void dumpHalfwords(const uint16_t* pMemory, size_t elementCount)
+static void appendZ85Group(void)
 {
-    size_t i;
-    for (i = 0 ; i < elementCount ; i++)
+    uint32_t value = ((uint32_t)g_group[0] << 24) | ((uint32_t)g_group[1] << 16) |
+                     ((uint32_t)g_group[2] << 8) | (uint32_t)g_group[3];
+    char     digits[5];
+    int      i;
+
+    for (i = 4 ; i >= 0 ; i--)
     {
-        uint16_t val = *pMemory++;
-        /* Only dump 8 halfwords to a single line before introducing a line break. */
-        if (i != 0 && (i & 0x7) == 0)
-            printString("\r\n");
-        dumpBytes((uint8_t*)&val, sizeof(val));
+        digits[i] = g_z85Digits[value % 85];
+        value /= 85;
     }
+    /* Like Ascii85, a partial group of N bytes is sent as just the first N+1 digits.  The host pads it back out with the
+       highest digit before decoding. */
+    memcpy(&g_lineBuffer[g_lineLength], digits, g_groupLength + 1);
+    g_lineLength += g_groupLength + 1;
 }
 
-static void dumpWords(const uint32_t* pMemory, size_t elementCount)
+static void endLine(void)
 {
-    size_t i;
-    for (i = 0 ; i < elementCount ; i++)
+    flushGroup();
+    if (g_crashCatcherHexDumpLineChecksums)
+    {
+        g_lineBuffer[g_lineLength++] = ' ';
+        writeHexDigits(&g_lineBuffer[g_lineLength], g_lineCrc, LINE_CHECKSUM_DIGITS);
+        g_lineLength += LINE_CHECKSUM_DIGITS;
+    }
+    g_lineBuffer[g_lineLength++] = '\r';
+    g_lineBuffer[g_lineLength++] = '\n';
+    writeChars(g_lineBuffer, g_lineLength);
+    g_lineLength = 0;
+    g_lineNumber++;
+}
+
+static char* writeHexDigits(char* pDest, uint32_t value, size_t digitCount)
+{
+    /* digitCount must be even since the digits are taken a byte at a time from the g_byteToHex table. */
+    while (digitCount > 0)
     {
-        uint32_t val = *pMemory++;
-        /* Only dump 4 words to a single line before introducing a line break. */
-        if (i != 0 && (i & 0x3) == 0)
-            printString("\r\n");
-        dumpBytes((uint8_t*)&val, sizeof(val));
+        const char* pHex = &g_byteToHex[2 * ((value >> (4 * (digitCount - 2))) & 0xFF)];
+
+        *pDest++ = pHex[0];
+        *pDest++ = pHex[1];
+        digitCount -= 2;
     }
+    return pDest;
 }
 
 
 CrashCatcherReturnCodes CrashCatcher_DumpEnd(void)
 {
     printString("\r\nEnd of dump\r\n");
-    if (g_crashCatcherDumpEndReturn == CRASH_CATCHER_TRY_AGAIN && g_info.isBKPT)
+    if (g_crashCatcherHexDumpLineChecksums && receiveResendRequests())
+        return CRASH_CATCHER_TRY_AGAIN;
+    if (g_crashCatcherDumpEndReturn == CRASH_CATCHER_TRY_AGAIN && (g_info.isBKPT || g_info.isRetained))
         return CRASH_CATCHER_EXIT;
     else
         return g_crashCatcherDumpEndReturn;
 }
+
+static int receiveResendRequests(void)
+{
+    char      lineCount[LINE_NUMBER_DIGITS + 1];
+    char      request[32];
+    LineRange range;
+
+    *writeHexDigits(lineCount, g_lineNumber, LINE_NUMBER_DIGITS) = '\0';
+    printString("Line count: ");
+    printString(lineCount);
+    printString("\r\nSend Rfirst-last to resend lines or just press Enter to finish.\r\n");
+
+    g_isResending = 0;
+    g_resendRangeCount = 0;
+    for (;;)
+    {
+        readRequest(request, sizeof(request));
+        if (request[0] == '\0')
+            break;
+        if (!parseRange(request, &range))
+        {
+            printString("?\r\n");
+        }
+        else if (g_resendRangeCount == CRASH_CATCHER_HEX_DUMP_MAX_RESEND_RANGES)
+        {
+            printString("FULL\r\n");
+        }
+        else
+        {
+            g_resendRanges[g_resendRangeCount++] = range;
+            printString("OK\r\n");
+        }
+    }
+    g_isResending = g_resendRangeCount > 0;
+    return g_isResending;
+}
+
+static void readRequest(char* pRequest, size_t requestSize)
+{
+    size_t length = 0;
+    int    c;
+
+    for (;;)
+    {
+        c = CrashCatcher_getc();
+        /* Treat a "\r\n" sequence as a single end of line. */
+        if (c == '\n' && g_lastChar == '\r')
+        {
+            g_lastChar = c;
+            continue;
+        }
+        g_lastChar = c;
+        if (c == '\r' || c == '\n')
+            break;
+        if (length < requestSize - 1)
+            pRequest[length++] = c;
+    }
+    pRequest[length] = '\0';
+}
+
+static int parseRange(const char* pRequest, LineRange* pRange)
+{
+    if (*pRequest != 'R' && *pRequest != 'r')
+        return 0;
+    pRequest++;
+    if (!parseHexNumber(&pRequest, &pRange->first) || *pRequest++ != '-')
+        return 0;
+    if (!parseHexNumber(&pRequest, &pRange->last) || *pRequest != '\0')
+        return 0;
+    return pRange->first <= pRange->last;
+}
+
+static int parseHexNumber(const char** ppCurr, uint32_t* pValue)
+{
+    const char* pCurr = *ppCurr;
+    uint32_t    value = 0;
+
+    while (pCurr - *ppCurr < LINE_NUMBER_DIGITS)
+    {
+        char c = *pCurr;
+
+        if (c >= '0' && c <= '9')
+            value = (value << 4) | (c - '0');
+        else if (c >= 'A' && c <= 'F')
+            value = (value << 4) | (c - 'A' + 10);
+        else if (c >= 'a' && c <= 'f')
+            value = (value << 4) | (c - 'a' + 10);
+        else
+            break;
+        pCurr++;
+    }
+    if (pCurr == *ppCurr)
+        return 0;
+    *ppCurr = pCurr;
+    *pValue = value;
+    return 1;
+}
@@ -34,6 +34,12 @@ extern "C"
     // to exit and not infinite loop.
     extern CrashCatcherReturnCodes g_crashCatcherDumpEndReturn;
 
+    // The unit tests can switch the HexDump module between its hex (0), Base64 (1) and Z85 (2) text encodings.
+    extern int g_crashCatcherHexDumpEncoding;
+
+    // The unit tests can enable the line numbers, checksums and resend requests of the HexDump module.
+    extern int g_crashCatcherHexDumpLineChecksums;
+
     // The unit tests can point the core to a fake location for the SCB->CPUID register.
     extern uint32_t* g_pCrashCatcherCpuId;
 
@@ -83,9 +89,37 @@ TEST_GROUP(CrashCatcher)
         if (sizeof(int*) == sizeof(uint64_t))
             g_crashCatcherTestBaseAddress = (uint64_t)&m_emulatedPSP & 0xFFFFFFFF00000000ULL;
         g_crashCatcherDumpEndReturn = CRASH_CATCHER_EXIT;
+        g_crashCatcherHexDumpEncoding = 0;
+        g_crashCatcherHexDumpLineChecksums = 0;
         m_expectedOutput[0] = '\0';
     }
 
+    // Starts a dump with line checksums enabled and then discards the banner so that tests only see the lines.
+    void startChecksumDump()
+    {
+        static const int keyPress = '\n';
+        CrashCatcherInfo info;
+
+        memset(&info, 0, sizeof(info));
+        g_crashCatcherHexDumpLineChecksums = 1;
+        DumpMocks_SetGetcData(&keyPress);
+        CrashCatcher_DumpStart(&info);
+        DumpMocks_Uninit();
+        DumpMocks_Init(1024);
+    }
+
+    // Runs through a resend pass with no further requests so that later tests don't start out resending.
+    void finishResend()
+    {
+        static const int finish[] = { '\r' };
+        CrashCatcherInfo info;
+
+        memset(&info, 0, sizeof(info));
+        CrashCatcher_DumpStart(&info);
+        DumpMocks_SetGetcData(finish);
+        CHECK_EQUAL(CRASH_CATCHER_EXIT, CrashCatcher_DumpEnd());
+    }
+
     void initExceptionRegisters()
     {
         m_exceptionRegisters.exceptionPSR = 0;
@@ -492,3 +526,238 @@ BKPT_TEST(CrashCatcher, DumpRegistersOnly_EmulateBreakpoint_WithTryAgainExitCode
     appendExpectedTrailerOutput();
     STRCMP_EQUAL(m_expectedOutput, DumpMocks_GetPutCData());
 }
+
+TEST(CrashCatcher, DumpMemory17Bytes_ShouldWriteEachLineWithSingleCall)
+{
+    CrashCatcher_DumpMemory(m_memory, CRASH_CATCHER_BYTE, 17);
+    CHECK_EQUAL(2, DumpMocks_GetWriteCallCount());
+    snprintf(m_expectedOutput, sizeof(m_expectedOutput),
+             "%02X%02X%02X%02X%02X%02X%02X%02X%02X%02X%02X%02X%02X%02X%02X%02X\r\n"
+             "%02X\r\n",
+             m_memory[0], m_memory[1], m_memory[2], m_memory[3],
+             m_memory[4], m_memory[5], m_memory[6], m_memory[7],
+             m_memory[8], m_memory[9], m_memory[10], m_memory[11],
+             m_memory[12], m_memory[13], m_memory[14], m_memory[15],
+             m_memory[16]);
+    STRCMP_EQUAL(m_expectedOutput, DumpMocks_GetPutCData());
+}
+
+TEST(CrashCatcher, DumpMemoryAllByteValues_ShouldEncodeEachByteAsTwoUppercaseHexDigits)
+{
+    uint8_t allBytes[256];
+
+    for (size_t i = 0 ; i < sizeof(allBytes) ; i++)
+    {
+        allBytes[i] = (uint8_t)i;
+        snprintf(&m_expectedOutput[i * 2 + (i / 16) * 2], 3, "%02X", (unsigned)i);
+        if ((i & 0xF) == 0xF)
+            memcpy(&m_expectedOutput[i * 2 + 2 + (i / 16) * 2], "\r\n", 3);
+    }
+    CrashCatcher_DumpMemory(allBytes, CRASH_CATCHER_BYTE, sizeof(allBytes));
+    CHECK_EQUAL(16, DumpMocks_GetWriteCallCount());
+    STRCMP_EQUAL(m_expectedOutput, DumpMocks_GetPutCData());
+}
+
+TEST(CrashCatcher, DumpMemoryNoElements_ShouldJustWriteLineEnding)
+{
+    CrashCatcher_DumpMemory(m_memory, CRASH_CATCHER_WORD, 0);
+    CHECK_EQUAL(1, DumpMocks_GetWriteCallCount());
+    STRCMP_EQUAL("\r\n", DumpMocks_GetPutCData());
+}
+
+TEST(CrashCatcher, Base64Encoding_ShouldAnnounceEncodingInBanner)
+{
+    static const CrashCatcherMemoryRegion regions[] = { {0xFFFFFFFF, 0xFFFFFFFF, CRASH_CATCHER_BYTE} };
+    static const int keyPress = '\n';
+    static const char expectedBanner[] = "\r\n\r\nCRASH ENCOUNTERED (Base64)\r\n"
+                                         "Enable logging and then press any key to start dump.\r\n"
+                                         "\r\n"
+                                         "Y0MDAA==\r\n";
+
+    g_crashCatcherHexDumpEncoding = 1;
+    DumpMocks_SetMemoryRegions(regions);
+    DumpMocks_SetGetcData(&keyPress);
+        CrashCatcher_Entry(&m_exceptionRegisters);
+    CHECK_EQUAL(0, strncmp(expectedBanner, DumpMocks_GetPutCData(), strlen(expectedBanner)));
+}
+
+TEST(CrashCatcher, Z85Encoding_ShouldAnnounceEncodingInBanner)
+{
+    static const CrashCatcherMemoryRegion regions[] = { {0xFFFFFFFF, 0xFFFFFFFF, CRASH_CATCHER_BYTE} };
+    static const int keyPress = '\n';
+    static const char expectedBanner[] = "\r\n\r\nBREAKPOINT ENCOUNTERED (Z85)\r\n";
+
+    g_crashCatcherHexDumpEncoding = 2;
+    emulateBKPT();
+    DumpMocks_SetMemoryRegions(regions);
+    DumpMocks_SetGetcData(&keyPress);
+        CrashCatcher_Entry(&m_exceptionRegisters);
+    CHECK_EQUAL(0, strncmp(expectedBanner, DumpMocks_GetPutCData(), strlen(expectedBanner)));
+}
+
+TEST(CrashCatcher, Base64DumpMemory17Bytes_ShouldFitOnOneLineWithPadding)
+{
+    g_crashCatcherHexDumpEncoding = 1;
+    CrashCatcher_DumpMemory(m_memory, CRASH_CATCHER_BYTE, 17);
+    CHECK_EQUAL(1, DumpMocks_GetWriteCallCount());
+    STRCMP_EQUAL("AAECAwQFBgcICQoLDA0ODxA=\r\n", DumpMocks_GetPutCData());
+}
+
+TEST(CrashCatcher, Base64DumpMemory49Bytes_ShouldSplitAcrossTwoLines)
+{
+    uint8_t memory[49];
+
+    for (size_t i = 0 ; i < sizeof(memory) ; i++)
+        memory[i] = i;
+    g_crashCatcherHexDumpEncoding = 1;
+    CrashCatcher_DumpMemory(memory, CRASH_CATCHER_BYTE, sizeof(memory));
+    CHECK_EQUAL(2, DumpMocks_GetWriteCallCount());
+    STRCMP_EQUAL("AAECAwQFBgcICQoLDA0ODxAREhMUFRYXGBkaGxwdHh8gISIjJCUmJygpKissLS4v\r\n"
+                 "MA==\r\n", DumpMocks_GetPutCData());
+}
+
+TEST(CrashCatcher, Base64DumpMemoryHalfwords_ShouldEncodeInMemoryByteOrder)
+{
+    static const uint16_t halfwords[] = { 0x0001, 0x0203 };
+
+    g_crashCatcherHexDumpEncoding = 1;
+    CrashCatcher_DumpMemory(halfwords, CRASH_CATCHER_HALFWORD, 2);
+    STRCMP_EQUAL("AQADAg==\r\n", DumpMocks_GetPutCData());
+}
+
+TEST(CrashCatcher, Z85DumpMemory_ShouldMatchSpecificationTestVector)
+{
+    static const uint8_t testVector[] = { 0x86, 0x4F, 0xD2, 0x6F, 0xB5, 0x59, 0xF7, 0x5B };
+
+    g_crashCatcherHexDumpEncoding = 2;
+    CrashCatcher_DumpMemory(testVector, CRASH_CATCHER_BYTE, sizeof(testVector));
+    STRCMP_EQUAL("HelloWorld\r\n", DumpMocks_GetPutCData());
+}
+
+TEST(CrashCatcher, Z85DumpMemory17Bytes_ShouldSendPartialGroupAsTwoDigits)
+{
+    g_crashCatcherHexDumpEncoding = 2;
+    CrashCatcher_DumpMemory(m_memory, CRASH_CATCHER_BYTE, 17);
+    STRCMP_EQUAL("009c61o!#m2NH?C3>iWS5c\r\n", DumpMocks_GetPutCData());
+}
+
+TEST(CrashCatcher, Z85DumpMemoryWords_ShouldEncodeInMemoryByteOrder)
+{
+    static const uint32_t words[] = { 0x6FD24F86, 0x5BF759B5 };
+
+    g_crashCatcherHexDumpEncoding = 2;
+    CrashCatcher_DumpMemory(words, CRASH_CATCHER_WORD, 2);
+    STRCMP_EQUAL("HelloWorld\r\n", DumpMocks_GetPutCData());
+}
+
+TEST(CrashCatcher, LineChecksumsDumpMemory17Bytes_ShouldNumberAndChecksumEachLine)
+{
+    startChecksumDump();
+    CrashCatcher_DumpMemory(m_memory, CRASH_CATCHER_BYTE, 17);
+    CHECK_EQUAL(2, DumpMocks_GetWriteCallCount());
+    STRCMP_EQUAL("000000 000102030405060708090A0B0C0D0E0F 3250\r\n"
+                 "000001 10 CEC9\r\n", DumpMocks_GetPutCData());
+}
+
+TEST(CrashCatcher, LineChecksumsDumpMemoryNoElements_ShouldStillSendNumberedLine)
+{
+    startChecksumDump();
+    CrashCatcher_DumpMemory(m_memory, CRASH_CATCHER_WORD, 0);
+    STRCMP_EQUAL("000000  DF1C\r\n", DumpMocks_GetPutCData());
+}
+
+TEST(CrashCatcher, LineChecksumsWithBase64_ShouldChecksumDecodedBytes)
+{
+    g_crashCatcherHexDumpEncoding = 1;
+    startChecksumDump();
+    CrashCatcher_DumpMemory(m_memory, CRASH_CATCHER_WORD, 1);
+    STRCMP_EQUAL("000000 AAECAw== 8666\r\n", DumpMocks_GetPutCData());
+}
+
+TEST(CrashCatcher, LineChecksumsDumpEndWithNoRequests_ShouldSendLineCountAndFinish)
+{
+    static const int request[] = { '\r' };
+
+    startChecksumDump();
+    CrashCatcher_DumpMemory(m_memory, CRASH_CATCHER_BYTE, 17);
+    DumpMocks_SetGetcData(request);
+    CHECK_EQUAL(CRASH_CATCHER_EXIT, CrashCatcher_DumpEnd());
+    STRCMP_EQUAL("000000 000102030405060708090A0B0C0D0E0F 3250\r\n"
+                 "000001 10 CEC9\r\n"
+                 "\r\nEnd of dump\r\n"
+                 "Line count: 000002\r\n"
+                 "Send Rfirst-last to resend lines or just press Enter to finish.\r\n", DumpMocks_GetPutCData());
+}
+
+TEST(CrashCatcher, LineChecksumsResendRequest_ShouldTryAgainAndOnlySendRequestedLines)
+{
+    static const int request[] = { 'R', '1', '-', '1', '\r', '\n', '\r', '\n' };
+    static const int finish[] = { '\r', '\n' };
+    CrashCatcherInfo info;
+
+    memset(&info, 0, sizeof(info));
+    startChecksumDump();
+    CrashCatcher_DumpMemory(m_memory, CRASH_CATCHER_BYTE, 17);
+    DumpMocks_SetGetcData(request);
+    CHECK_EQUAL(CRASH_CATCHER_TRY_AGAIN, CrashCatcher_DumpEnd());
+    CHECK_TRUE(strstr(DumpMocks_GetPutCData(), "finish.\r\nOK\r\n") != NULL);
+    DumpMocks_Uninit();
+    DumpMocks_Init(1024);
+
+    CrashCatcher_DumpStart(&info);
+    CrashCatcher_DumpMemory(m_memory, CRASH_CATCHER_BYTE, 17);
+    DumpMocks_SetGetcData(finish);
+    CHECK_EQUAL(CRASH_CATCHER_EXIT, CrashCatcher_DumpEnd());
+    STRCMP_EQUAL("\r\nResending lines\r\n"
+                 "000001 10 CEC9\r\n"
+                 "\r\nEnd of dump\r\n"
+                 "Line count: 000002\r\n"
+                 "Send Rfirst-last to resend lines or just press Enter to finish.\r\n", DumpMocks_GetPutCData());
+}
+
+TEST(CrashCatcher, LineChecksumsBadResendRequests_ShouldBeRejected)
+{
+    static const int request[] = { 'X', '\r', 'R', '2', '-', '1', '\r', 'R', '1', '\r', 'R', '1', '-', '2', 'Z', '\r',
+                                   'r', 'a', '-', 'F', '\r', '\r' };
+
+    startChecksumDump();
+    DumpMocks_SetGetcData(request);
+    CHECK_EQUAL(CRASH_CATCHER_TRY_AGAIN, CrashCatcher_DumpEnd());
+    CHECK_TRUE(strstr(DumpMocks_GetPutCData(), "finish.\r\n?\r\n?\r\n?\r\n?\r\nOK\r\n") != NULL);
+    finishResend();
+}
+
+TEST(CrashCatcher, LineChecksumsTooManyResendRequests_ShouldReplyFull)
+{
+    int request[9 * 5 + 1];
+    int i;
+
+    for (i = 0 ; i < 9 ; i++)
+    {
+        request[i * 5 + 0] = 'R';
+        request[i * 5 + 1] = '0' + i;
+        request[i * 5 + 2] = '-';
+        request[i * 5 + 3] = '0' + i;
+        request[i * 5 + 4] = '\r';
+    }
+    request[9 * 5] = '\r';
+    startChecksumDump();
+    DumpMocks_SetGetcData(request);
+    CHECK_EQUAL(CRASH_CATCHER_TRY_AGAIN, CrashCatcher_DumpEnd());
+    CHECK_TRUE(strstr(DumpMocks_GetPutCData(), "OK\r\nOK\r\nOK\r\nOK\r\nOK\r\nOK\r\nOK\r\nOK\r\nFULL\r\n") != NULL);
+    finishResend();
+}
+
+TEST(CrashCatcher, LineChecksumsResendThroughCore_ShouldDumpAgainWithJustRequestedLines)
+{
+    static const CrashCatcherMemoryRegion regions[] = { {0xFFFFFFFF, 0xFFFFFFFF, CRASH_CATCHER_BYTE} };
+    static const int input[] = { '\n', 'R', '0', '-', '0', '\r', '\r', '\r' };
+
+    g_crashCatcherHexDumpLineChecksums = 1;
+    DumpMocks_SetMemoryRegions(regions);
+    DumpMocks_SetGetcData(input);
+        CrashCatcher_Entry(&m_exceptionRegisters);
+    CHECK_TRUE(strstr(DumpMocks_GetPutCData(), "\r\nResending lines\r\n"
+                                               "000000 63430300 E7DE\r\n"
+                                               "\r\nEnd of dump\r\n") != NULL);
+}
@@ -0,0 +1,201 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Decodes the LZ4 blocks of compressed dumps.  Each block is independent of the others so they are simply decoded one
+   after the other. */
+#include <CrashCatcher.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Lz4Decoder.h"
+
+
+/* Compressed and uncompressed sizes of the block, as 16-bit little endian values. */
+#define BLOCK_HEADER_SIZE 4
+
+
+static int      readLength(const uint8_t** ppCurr, const uint8_t* pEnd, size_t* pLength);
+static size_t   findCompressedData(const uint8_t* pDump, size_t dumpSize);
+static uint32_t readUInt32(const uint8_t* pSrc);
+
+
+long Lz4Decoder_DecodeBlock(const uint8_t* pInput, size_t inputSize, uint8_t* pOutput, size_t outputSize)
+{
+    const uint8_t* pCurr = pInput;
+    const uint8_t* pEnd = pInput + inputSize;
+    size_t         outputCount = 0;
+    size_t         lastMatchStart = 0;
+    size_t         finalLiteralCount = 0;
+    int            sawMatch = 0;
+
+    while (pCurr < pEnd)
+    {
+        uint8_t token = *pCurr++;
+        size_t  literalCount = token >> 4;
+        size_t  matchLength = token & 0xF;
+        size_t  offset;
+        size_t  i;
+
+        if (literalCount == 15 && !readLength(&pCurr, pEnd, &literalCount))
+            return -1;
+        if (literalCount > (size_t)(pEnd - pCurr) || literalCount > outputSize - outputCount)
+            return -1;
+        memcpy(&pOutput[outputCount], pCurr, literalCount);
+        pCurr += literalCount;
+        outputCount += literalCount;
+
+        /* The last sequence is the only one which doesn't contain a match. */
+        finalLiteralCount = literalCount;
+        if (pCurr == pEnd)
+            break;
+        if (pEnd - pCurr < 2)
+            return -1;
+        offset = pCurr[0] | (pCurr[1] << 8);
+        pCurr += 2;
+        if (offset == 0 || offset > outputCount)
+            return -1;
+        if (matchLength == 15 && !readLength(&pCurr, pEnd, &matchLength))
+            return -1;
+        matchLength += 4;
+        if (matchLength > outputSize - outputCount)
+            return -1;
+        lastMatchStart = outputCount;
+        sawMatch = 1;
+        for (i = 0 ; i < matchLength ; i++, outputCount++)
+            pOutput[outputCount] = pOutput[outputCount - offset];
+        finalLiteralCount = 0;
+    }
+
+    /* The last match must start at least 12 bytes before the end of the block and the last 5 bytes must be literals. */
+    if (sawMatch && (lastMatchStart + 12 > outputCount || finalLiteralCount < 5))
+        return -1;
+    return (long)outputCount;
+}
+
+static int readLength(const uint8_t** ppCurr, const uint8_t* pEnd, size_t* pLength)
+{
+    const uint8_t* pCurr = *ppCurr;
+    uint8_t        byte;
+
+    do
+    {
+        if (pCurr >= pEnd)
+            return 0;
+        byte = *pCurr++;
+        *pLength += byte;
+    } while (byte == 255);
+    *ppCurr = pCurr;
+    return 1;
+}
+
+
+long Lz4Decoder_DecodeStream(const uint8_t* pInput, size_t inputSize, uint8_t* pOutput, size_t outputSize)
+{
+    size_t inputOffset = 0;
+    size_t outputCount = 0;
+
+    while (inputOffset < inputSize)
+    {
+        const uint8_t* pHeader = &pInput[inputOffset];
+        size_t         compressedSize;
+        size_t         uncompressedSize;
+        long           decodedSize;
+
+        if (inputSize - inputOffset < BLOCK_HEADER_SIZE)
+            return -1;
+        compressedSize = pHeader[0] | (pHeader[1] << 8);
+        uncompressedSize = pHeader[2] | (pHeader[3] << 8);
+        inputOffset += BLOCK_HEADER_SIZE;
+        if (compressedSize > inputSize - inputOffset || uncompressedSize > outputSize - outputCount)
+            return -1;
+        decodedSize = Lz4Decoder_DecodeBlock(&pInput[inputOffset], compressedSize,
+                                             &pOutput[outputCount], uncompressedSize);
+        if (decodedSize != (long)uncompressedSize)
+            return -1;
+        inputOffset += compressedSize;
+        outputCount += uncompressedSize;
+    }
+
+    return (long)outputCount;
+}
+
+size_t Lz4Decoder_StreamSize(const uint8_t* pInput, size_t inputSize, size_t* pCompleteSize)
+{
+    size_t inputOffset = 0;
+    size_t outputSize = 0;
+
+    while (inputSize - inputOffset >= BLOCK_HEADER_SIZE)
+    {
+        const uint8_t* pHeader = &pInput[inputOffset];
+        size_t         compressedSize = pHeader[0] | (pHeader[1] << 8);
+
+        if (compressedSize > inputSize - inputOffset - BLOCK_HEADER_SIZE)
+            break;
+        outputSize += pHeader[2] | (pHeader[3] << 8);
+        inputOffset += BLOCK_HEADER_SIZE + compressedSize;
+    }
+    *pCompleteSize = inputOffset;
+    return outputSize;
+}
+
+
+Lz4DecoderResult Lz4Decoder_ExpandDump(const uint8_t* pDump, size_t dumpSize,
+                                       uint8_t** ppExpanded, size_t* pExpandedSize)
+{
+    size_t   headerSize = findCompressedData(pDump, dumpSize);
+    size_t   completeSize;
+    size_t   streamSize = Lz4Decoder_StreamSize(pDump + headerSize, dumpSize - headerSize, &completeSize);
+    uint8_t* pExpanded;
+    long     decodedSize;
+
+    *ppExpanded = NULL;
+    *pExpandedSize = 0;
+    pExpanded = malloc(headerSize + streamSize > 0 ? headerSize + streamSize : 1);
+    if (!pExpanded)
+        return LZ4_DECODER_OUT_OF_MEMORY;
+    memcpy(pExpanded, pDump, headerSize);
+    *ppExpanded = pExpanded;
+    *pExpandedSize = headerSize;
+
+    decodedSize = Lz4Decoder_DecodeStream(pDump + headerSize, completeSize, pExpanded + headerSize, streamSize);
+    if (decodedSize != (long)streamSize)
+        return LZ4_DECODER_MALFORMED;
+    *pExpandedSize += streamSize;
+    return completeSize < dumpSize - headerSize ? LZ4_DECODER_TRUNCATED : LZ4_DECODER_OK;
+}
+
+static size_t findCompressedData(const uint8_t* pDump, size_t dumpSize)
+{
+    size_t   headerSize = 2 * sizeof(uint32_t);
+    uint32_t payloadSize;
+
+    /* The backtrace record is sent uncompressed, straight after the flags, so that it survives a lost compressed
+       block. */
+    if (dumpSize < headerSize)
+        return dumpSize;
+    if ((readUInt32(pDump + sizeof(uint32_t)) & CRASH_CATCHER_FLAGS_BACKTRACE) == 0)
+        return headerSize;
+    if (dumpSize - headerSize < 2 * sizeof(uint32_t))
+        return dumpSize;
+    payloadSize = readUInt32(pDump + headerSize + sizeof(uint32_t));
+    headerSize += 2 * sizeof(uint32_t);
+    if (payloadSize > dumpSize - headerSize)
+        return dumpSize;
+    return headerSize + payloadSize;
+}
+
+static uint32_t readUInt32(const uint8_t* pSrc)
+{
+    /* Dumps are always little endian no matter what the host is. */
+    return (uint32_t)pSrc[0] | ((uint32_t)pSrc[1] << 8) | ((uint32_t)pSrc[2] << 16) | ((uint32_t)pSrc[3] << 24);
+}
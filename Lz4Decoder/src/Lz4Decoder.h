@@ -0,0 +1,57 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Host side LZ4 block decoder used to expand dumps which have CRASH_CATCHER_FLAGS_COMPRESSED set. */
+#ifndef _LZ4_DECODER_H_
+#define _LZ4_DECODER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+typedef enum
+{
+    /* Every block was expanded. */
+    LZ4_DECODER_OK = 0,
+    /* The dump ended part way through a block.  The blocks before it were still expanded. */
+    LZ4_DECODER_TRUNCATED,
+    /* A block didn't decode to the size given in its header or broke the LZ4 block format rules. */
+    LZ4_DECODER_MALFORMED,
+    /* The expanded dump couldn't be allocated. */
+    LZ4_DECODER_OUT_OF_MEMORY
+} Lz4DecoderResult;
+
+
+/* Decodes a single LZ4 block.  Returns the number of bytes written to pOutput or -1 if the block is malformed or
+   doesn't follow the end of block restrictions in the LZ4 block format specification. */
+long Lz4Decoder_DecodeBlock(const uint8_t* pInput, size_t inputSize, uint8_t* pOutput, size_t outputSize);
+
+/* Decodes a series of blocks, each preceded by the 4-byte size header used for CRASH_CATCHER_FLAGS_COMPRESSED dumps.
+   Returns the total number of bytes written to pOutput or -1 on error. */
+long Lz4Decoder_DecodeStream(const uint8_t* pInput, size_t inputSize, uint8_t* pOutput, size_t outputSize);
+
+/* Walks the block headers of a stream and returns the number of bytes which its complete blocks decode to.  The number
+   of input bytes taken up by those blocks is returned in *pCompleteSize, which is less than inputSize if the stream
+   ends part way through a block. */
+size_t Lz4Decoder_StreamSize(const uint8_t* pInput, size_t inputSize, size_t* pCompleteSize);
+
+/* Expands the dumpSize byte dump at pDump, which must have CRASH_CATCHER_FLAGS_COMPRESSED set, into a buffer allocated
+   with malloc().  The signature, flags and any backtrace record are copied as is and the blocks which follow them are
+   decompressed in place.  The flags aren't changed so that the dump CRC in any CRC32 trailer still matches.  The caller
+   must free() *ppExpanded, which is set for every result other than LZ4_DECODER_OUT_OF_MEMORY. */
+Lz4DecoderResult Lz4Decoder_ExpandDump(const uint8_t* pDump, size_t dumpSize,
+                                       uint8_t** ppExpanded, size_t* pExpandedSize);
+
+
+#endif /* _LZ4_DECODER_H_ */
@@ -0,0 +1,250 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Include headers from C modules under test.
+extern "C"
+{
+    #include <CrashCatcher.h>
+    #include <Lz4Decoder.h>
+}
+
+// Include C++ headers for test harness.
+#include <CppUTest/TestHarness.h>
+
+
+// "ABCDABCDABCDABCDABCDABCDEFGHI": 4 literals, a 20 byte match at offset 4 and then the 5 literals which the LZ4 block
+// format requires at the end of every block.
+static const uint8_t g_matchBlock[] = { 0x4F, 'A', 'B', 'C', 'D', 0x04, 0x00, 0x01,
+                                        0x50, 'E', 'F', 'G', 'H', 'I' };
+static const char    g_matchText[] = "ABCDABCDABCDABCDABCDABCDEFGHI";
+
+
+TEST_GROUP(Lz4Decoder)
+{
+    // Dumps are built up in this buffer by the tests, in the same format as generated by the Core.
+    uint8_t  m_dump[1024];
+    size_t   m_size;
+    uint8_t  m_output[1024];
+    uint8_t* m_pExpanded;
+    size_t   m_expandedSize;
+
+    void setup()
+    {
+        memset(m_dump, 0, sizeof(m_dump));
+        memset(m_output, 0xFF, sizeof(m_output));
+        m_size = 0;
+        m_pExpanded = NULL;
+        m_expandedSize = 0;
+    }
+
+    void teardown()
+    {
+        free(m_pExpanded);
+    }
+
+    void appendByte(uint8_t byte)
+    {
+        CHECK_TRUE(m_size < sizeof(m_dump));
+        m_dump[m_size++] = byte;
+    }
+
+    void appendWord(uint32_t word)
+    {
+        appendByte(word & 0xFF);
+        appendByte((word >> 8) & 0xFF);
+        appendByte((word >> 16) & 0xFF);
+        appendByte(word >> 24);
+    }
+
+    void appendHeader(uint32_t flags)
+    {
+        appendByte(CRASH_CATCHER_SIGNATURE_BYTE0);
+        appendByte(CRASH_CATCHER_SIGNATURE_BYTE1);
+        appendByte(CRASH_CATCHER_VERSION_MAJOR);
+        appendByte(CRASH_CATCHER_VERSION_MINOR);
+        appendWord(flags);
+    }
+
+    void appendBlockHeader(size_t compressedSize, size_t uncompressedSize)
+    {
+        appendByte(compressedSize & 0xFF);
+        appendByte(compressedSize >> 8);
+        appendByte(uncompressedSize & 0xFF);
+        appendByte(uncompressedSize >> 8);
+    }
+
+    // Appends a block which holds the size bytes at pData as literals only.
+    void appendLiteralBlock(const void* pData, size_t size)
+    {
+        size_t extraLengthBytes = size >= 15 ? (size - 15) / 255 + 1 : 0;
+        size_t length = size - 15;
+
+        appendBlockHeader(1 + extraLengthBytes + size, size);
+        appendByte(size >= 15 ? 0xF0 : size << 4);
+        for (size_t i = 0 ; i < extraLengthBytes ; i++, length -= 255)
+            appendByte(length >= 255 ? 255 : length);
+        for (size_t i = 0 ; i < size ; i++)
+            appendByte(((const uint8_t*)pData)[i]);
+    }
+
+    void appendMatchBlock()
+    {
+        appendBlockHeader(sizeof(g_matchBlock), sizeof(g_matchText) - 1);
+        for (size_t i = 0 ; i < sizeof(g_matchBlock) ; i++)
+            appendByte(g_matchBlock[i]);
+    }
+
+    Lz4DecoderResult expand()
+    {
+        return Lz4Decoder_ExpandDump(m_dump, m_size, &m_pExpanded, &m_expandedSize);
+    }
+};
+
+
+TEST(Lz4Decoder, DecodeBlock_LiteralsOnly_ShouldCopyThem)
+{
+    static const uint8_t block[] = { 0x30, 'a', 'b', 'c' };
+
+    CHECK_EQUAL(3, Lz4Decoder_DecodeBlock(block, sizeof(block), m_output, sizeof(m_output)));
+    MEMCMP_EQUAL("abc", m_output, 3);
+}
+
+TEST(Lz4Decoder, DecodeBlock_OverlappingMatch_ShouldRepeatEarlierBytes)
+{
+    CHECK_EQUAL((long)sizeof(g_matchText) - 1, Lz4Decoder_DecodeBlock(g_matchBlock, sizeof(g_matchBlock),
+                                                                      m_output, sizeof(m_output)));
+    MEMCMP_EQUAL(g_matchText, m_output, sizeof(g_matchText) - 1);
+}
+
+TEST(Lz4Decoder, DecodeBlock_MatchOffsetBeforeStartOfBlock_ShouldFail)
+{
+    uint8_t block[sizeof(g_matchBlock)];
+
+    memcpy(block, g_matchBlock, sizeof(block));
+    block[5] = 0x05;
+    CHECK_EQUAL(-1, Lz4Decoder_DecodeBlock(block, sizeof(block), m_output, sizeof(m_output)));
+}
+
+TEST(Lz4Decoder, DecodeBlock_LessThanFiveLiteralsAfterLastMatch_ShouldFail)
+{
+    CHECK_EQUAL(-1, Lz4Decoder_DecodeBlock(g_matchBlock, sizeof(g_matchBlock) - 1, m_output, sizeof(m_output)));
+}
+
+TEST(Lz4Decoder, DecodeBlock_OutputTooSmall_ShouldFail)
+{
+    CHECK_EQUAL(-1, Lz4Decoder_DecodeBlock(g_matchBlock, sizeof(g_matchBlock), m_output, sizeof(g_matchText) - 2));
+}
+
+TEST(Lz4Decoder, DecodeStream_TwoBlocks_ShouldConcatenateThem)
+{
+    appendLiteralBlock("xyz", 3);
+    appendMatchBlock();
+    CHECK_EQUAL((long)(3 + sizeof(g_matchText) - 1),
+                Lz4Decoder_DecodeStream(m_dump, m_size, m_output, sizeof(m_output)));
+    MEMCMP_EQUAL("xyz", m_output, 3);
+    MEMCMP_EQUAL(g_matchText, m_output + 3, sizeof(g_matchText) - 1);
+}
+
+TEST(Lz4Decoder, DecodeStream_BlockDecodesToDifferentSizeThanItsHeader_ShouldFail)
+{
+    appendMatchBlock();
+    m_dump[2]++;
+    CHECK_EQUAL(-1, Lz4Decoder_DecodeStream(m_dump, m_size, m_output, sizeof(m_output)));
+}
+
+TEST(Lz4Decoder, StreamSize_CompleteBlocks_ShouldSumUncompressedSizes)
+{
+    size_t completeSize = 0;
+
+    appendLiteralBlock("xyz", 3);
+    appendMatchBlock();
+    CHECK_EQUAL(3 + sizeof(g_matchText) - 1, Lz4Decoder_StreamSize(m_dump, m_size, &completeSize));
+    CHECK_EQUAL(m_size, completeSize);
+}
+
+TEST(Lz4Decoder, StreamSize_LastBlockCutOff_ShouldOnlyCountCompleteBlocks)
+{
+    size_t completeSize = 0;
+    size_t firstBlockSize;
+
+    appendLiteralBlock("xyz", 3);
+    firstBlockSize = m_size;
+    appendMatchBlock();
+    CHECK_EQUAL(3, Lz4Decoder_StreamSize(m_dump, m_size - 1, &completeSize));
+    CHECK_EQUAL(firstBlockSize, completeSize);
+    CHECK_EQUAL(3, Lz4Decoder_StreamSize(m_dump, firstBlockSize + 2, &completeSize));
+    CHECK_EQUAL(firstBlockSize, completeSize);
+}
+
+TEST(Lz4Decoder, ExpandDump_ShouldKeepHeaderAndDecompressBlocks)
+{
+    uint8_t registers[300];
+
+    for (size_t i = 0 ; i < sizeof(registers) ; i++)
+        registers[i] = (uint8_t)i;
+    appendHeader(CRASH_CATCHER_FLAGS_COMPRESSED);
+    appendLiteralBlock(registers, sizeof(registers));
+    appendMatchBlock();
+    CHECK_EQUAL(LZ4_DECODER_OK, expand());
+    CHECK_EQUAL(8 + sizeof(registers) + sizeof(g_matchText) - 1, m_expandedSize);
+    MEMCMP_EQUAL(m_dump, m_pExpanded, 8);
+    MEMCMP_EQUAL(registers, m_pExpanded + 8, sizeof(registers));
+    MEMCMP_EQUAL(g_matchText, m_pExpanded + 8 + sizeof(registers), sizeof(g_matchText) - 1);
+}
+
+TEST(Lz4Decoder, ExpandDump_WithBacktrace_ShouldCopyBacktraceRecordUncompressed)
+{
+    appendHeader(CRASH_CATCHER_FLAGS_COMPRESSED | CRASH_CATCHER_FLAGS_BACKTRACE);
+    appendWord(CRASH_CATCHER_RECORD_TAG(CRASH_CATCHER_RECORD_BACKTRACE));
+    appendWord(2 * sizeof(uint32_t));
+    appendWord(0xFFFFFFF9);
+    appendWord(0x08000101);
+    appendMatchBlock();
+    CHECK_EQUAL(LZ4_DECODER_OK, expand());
+    CHECK_EQUAL(24 + sizeof(g_matchText) - 1, m_expandedSize);
+    MEMCMP_EQUAL(m_dump, m_pExpanded, 24);
+    MEMCMP_EQUAL(g_matchText, m_pExpanded + 24, sizeof(g_matchText) - 1);
+}
+
+TEST(Lz4Decoder, ExpandDump_CutOffInLastBlock_ShouldReturnTruncatedAndKeepEarlierBlocks)
+{
+    appendHeader(CRASH_CATCHER_FLAGS_COMPRESSED);
+    appendLiteralBlock("xyz", 3);
+    appendMatchBlock();
+    m_size -= 3;
+    CHECK_EQUAL(LZ4_DECODER_TRUNCATED, expand());
+    CHECK_EQUAL(8 + 3, m_expandedSize);
+    MEMCMP_EQUAL("xyz", m_pExpanded + 8, 3);
+}
+
+TEST(Lz4Decoder, ExpandDump_CorruptBlock_ShouldReturnMalformed)
+{
+    appendHeader(CRASH_CATCHER_FLAGS_COMPRESSED);
+    appendMatchBlock();
+    m_dump[8 + 4 + 5] = 0x40;
+    CHECK_EQUAL(LZ4_DECODER_MALFORMED, expand());
+    CHECK_EQUAL(8, m_expandedSize);
+}
+
+TEST(Lz4Decoder, ExpandDump_OnlyHeader_ShouldReturnEmptyExpansion)
+{
+    appendHeader(CRASH_CATCHER_FLAGS_COMPRESSED);
+    CHECK_EQUAL(LZ4_DECODER_OK, expand());
+    CHECK_EQUAL(8, m_expandedSize);
+    MEMCMP_EQUAL(m_dump, m_pExpanded, 8);
+}
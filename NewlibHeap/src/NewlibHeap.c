@@ -0,0 +1,122 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Implementation of CrashCatcher_GetNextFreeHeapSpan() which walks the free list of newlib-nano's malloc. */
+#include <CrashCatcher.h>
+#include "NewlibHeap.h"
+
+
+/* Where the previous call stopped walking the free list.  The Core asks for the next free span starting from the end
+   of the one just returned, so the walk carries on from the same chunk rather than starting again from the head of the
+   list, which would make dumping a region with many free chunks quadratic. */
+typedef struct
+{
+    const NewlibChunk* pFreeList;
+    const char*        pSbrkStart;
+    const NewlibChunk* pChunk;
+    uint32_t           previousChunkEnd;
+    uint32_t           chunkCount;
+    uint32_t           spanEnd;
+    uint32_t           endAddress;
+    int                isValid;
+} Cursor;
+
+static Cursor g_cursor;
+
+
+static int      canResumeWalk(uint32_t startAddress, uint32_t endAddress);
+static void     startWalk(void);
+static uint32_t pointerToUInt32Address(const void* p);
+static int      isWordAligned(uint32_t address);
+
+
+int CrashCatcher_GetNextFreeHeapSpan(uint32_t startAddress, uint32_t endAddress, CrashCatcherMemoryRegionInfo* pFreeSpan)
+{
+    if (!canResumeWalk(startAddress, endAddress))
+        startWalk();
+    g_cursor.isValid = 0;
+    g_cursor.endAddress = endAddress;
+
+    /* The heap might be the reason for the crash so validate each chunk before touching it.  The free list is sorted
+       by address and chunks never overlap so anything else means that the list is corrupted. */
+    while (g_cursor.pChunk && __malloc_sbrk_start && g_cursor.chunkCount < NEWLIB_HEAP_MAX_FREE_CHUNKS)
+    {
+        const NewlibChunk* pChunk = g_cursor.pChunk;
+        uint32_t           chunkStart = pointerToUInt32Address(pChunk);
+        uint32_t           chunkEnd;
+        uint32_t           freeStart;
+        uint32_t           freeEnd;
+
+        if (chunkStart >= endAddress)
+            return 0;
+        if (chunkStart < g_cursor.previousChunkEnd || !isWordAligned(chunkStart))
+            return 0;
+        if (pChunk->size < (long)sizeof(*pChunk) || !isWordAligned(pChunk->size))
+            return 0;
+        if ((uint32_t)pChunk->size > 0xFFFFFFFF - chunkStart)
+            return 0;
+
+        /* Keep the chunk header so that host tools can still walk the free list. */
+        chunkEnd = chunkStart + pChunk->size;
+        freeStart = chunkStart + sizeof(*pChunk);
+        freeEnd = chunkEnd;
+        if (freeStart < startAddress)
+            freeStart = startAddress;
+        if (freeEnd > endAddress)
+            freeEnd = endAddress;
+        if (freeStart < freeEnd)
+        {
+            /* The chunk is checked again on the next call in case its span was clipped to endAddress. */
+            pFreeSpan->startAddress = freeStart;
+            pFreeSpan->endAddress = freeEnd;
+            g_cursor.spanEnd = freeEnd;
+            g_cursor.isValid = 1;
+            return 1;
+        }
+
+        g_cursor.previousChunkEnd = chunkEnd;
+        g_cursor.pChunk = pChunk->next;
+        g_cursor.chunkCount++;
+    }
+    return 0;
+}
+
+static int canResumeWalk(uint32_t startAddress, uint32_t endAddress)
+{
+    /* Chunks already passed over all end before the span just returned so they can't hold anything after it. */
+    return g_cursor.isValid &&
+           g_cursor.pFreeList == __malloc_free_list &&
+           g_cursor.pSbrkStart == __malloc_sbrk_start &&
+           g_cursor.endAddress == endAddress &&
+           g_cursor.spanEnd == startAddress;
+}
+
+static void startWalk(void)
+{
+    g_cursor.pFreeList = __malloc_free_list;
+    g_cursor.pSbrkStart = __malloc_sbrk_start;
+    g_cursor.pChunk = __malloc_free_list;
+    g_cursor.previousChunkEnd = pointerToUInt32Address(__malloc_sbrk_start);
+    g_cursor.chunkCount = 0;
+}
+
+static uint32_t pointerToUInt32Address(const void* p)
+{
+    return (uint32_t)(unsigned long)p;
+}
+
+static int isWordAligned(uint32_t address)
+{
+    return (address & 3) == 0;
+}
@@ -0,0 +1,40 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Private header file shared with unit tests. */
+#ifndef _NEWLIB_HEAP_H_
+#define _NEWLIB_HEAP_H_
+
+
+/* The walker gives up after visiting this many free chunks in case the free list has been corrupted into a loop. */
+#if !defined(NEWLIB_HEAP_MAX_FREE_CHUNKS)
+    #define NEWLIB_HEAP_MAX_FREE_CHUNKS 1024
+#endif
+
+
+/* Layout of a chunk in newlib-nano's malloc implementation (newlib/libc/stdlib/nano-mallocr.c).  The size includes this
+   header and next is only valid for chunks which are on the free list.  The free list is kept sorted by address. */
+typedef struct NewlibChunk
+{
+    long                size;
+    struct NewlibChunk* next;
+} NewlibChunk;
+
+
+/* Globals maintained by newlib-nano's malloc.  The unit tests provide their own versions of these globals. */
+extern NewlibChunk* __malloc_free_list;
+extern char*        __malloc_sbrk_start;
+
+
+#endif /* _NEWLIB_HEAP_H_ */
@@ -0,0 +1,241 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include <stdint.h>
+#include <string.h>
+
+// Include headers from C modules under test.
+extern "C"
+{
+    #include <CrashCatcher.h>
+    #include <NewlibHeap.h>
+
+    // Fake versions of the globals which would normally be provided by newlib-nano's malloc.
+    NewlibChunk* __malloc_free_list;
+    char*        __malloc_sbrk_start;
+}
+
+// Include C++ headers for test harness.
+#include <CppUTest/TestHarness.h>
+
+
+TEST_GROUP(NewlibHeap)
+{
+    // Synthetic arena which has the same layout as a newlib-nano heap.
+    NewlibChunk                  m_arena[64];
+    uint32_t                     m_arenaStart;
+    uint32_t                     m_arenaEnd;
+    CrashCatcherMemoryRegionInfo m_freeSpan;
+
+    void setup()
+    {
+        memset(m_arena, 0, sizeof(m_arena));
+        memset(&m_freeSpan, 0xFF, sizeof(m_freeSpan));
+        m_arenaStart = (uint32_t)(unsigned long)m_arena;
+        m_arenaEnd = (uint32_t)(unsigned long)&m_arena[64];
+        __malloc_sbrk_start = (char*)m_arena;
+        __malloc_free_list = NULL;
+    }
+
+    void teardown()
+    {
+    }
+
+    NewlibChunk* createChunk(size_t index, size_t chunkCount, NewlibChunk* pNext)
+    {
+        NewlibChunk* pChunk = &m_arena[index];
+
+        pChunk->size = chunkCount * sizeof(NewlibChunk);
+        pChunk->next = pNext;
+        return pChunk;
+    }
+
+    uint32_t address(size_t index)
+    {
+        return (uint32_t)(unsigned long)&m_arena[index];
+    }
+
+    void validateFreeSpan(uint32_t expectedStart, uint32_t expectedEnd)
+    {
+        CHECK_EQUAL(expectedStart, m_freeSpan.startAddress);
+        CHECK_EQUAL(expectedEnd, m_freeSpan.endAddress);
+    }
+};
+
+
+TEST(NewlibHeap, EmptyFreeList_ShouldReturnNoFreeSpan)
+{
+    CHECK_FALSE(CrashCatcher_GetNextFreeHeapSpan(m_arenaStart, m_arenaEnd, &m_freeSpan));
+}
+
+TEST(NewlibHeap, MallocNeverCalled_ShouldReturnNoFreeSpan)
+{
+    __malloc_free_list = createChunk(0, 4, NULL);
+    __malloc_sbrk_start = NULL;
+    CHECK_FALSE(CrashCatcher_GetNextFreeHeapSpan(m_arenaStart, m_arenaEnd, &m_freeSpan));
+}
+
+TEST(NewlibHeap, OneFreeChunk_ShouldReturnFreeSpanAfterChunkHeader)
+{
+    __malloc_free_list = createChunk(4, 8, NULL);
+    CHECK_TRUE(CrashCatcher_GetNextFreeHeapSpan(m_arenaStart, m_arenaEnd, &m_freeSpan));
+    validateFreeSpan(address(5), address(12));
+}
+
+TEST(NewlibHeap, TwoFreeChunks_StartAfterFirstSpan_ShouldReturnSecondFreeSpan)
+{
+    NewlibChunk* pSecond = createChunk(20, 4, NULL);
+    __malloc_free_list = createChunk(4, 8, pSecond);
+    CHECK_TRUE(CrashCatcher_GetNextFreeHeapSpan(m_arenaStart, m_arenaEnd, &m_freeSpan));
+    validateFreeSpan(address(5), address(12));
+    CHECK_TRUE(CrashCatcher_GetNextFreeHeapSpan(m_freeSpan.endAddress, m_arenaEnd, &m_freeSpan));
+    validateFreeSpan(address(21), address(24));
+    CHECK_FALSE(CrashCatcher_GetNextFreeHeapSpan(m_freeSpan.endAddress, m_arenaEnd, &m_freeSpan));
+}
+
+TEST(NewlibHeap, FreeChunkStraddlesStartOfRange_ShouldClipFreeSpanToStart)
+{
+    __malloc_free_list = createChunk(4, 8, NULL);
+    CHECK_TRUE(CrashCatcher_GetNextFreeHeapSpan(address(8), m_arenaEnd, &m_freeSpan));
+    validateFreeSpan(address(8), address(12));
+}
+
+TEST(NewlibHeap, FreeChunkStraddlesEndOfRange_ShouldClipFreeSpanToEnd)
+{
+    __malloc_free_list = createChunk(4, 8, NULL);
+    CHECK_TRUE(CrashCatcher_GetNextFreeHeapSpan(m_arenaStart, address(8), &m_freeSpan));
+    validateFreeSpan(address(5), address(8));
+}
+
+TEST(NewlibHeap, FreeChunkHeaderAtEndOfRange_ShouldReturnNoFreeSpan)
+{
+    __malloc_free_list = createChunk(4, 8, NULL);
+    CHECK_FALSE(CrashCatcher_GetNextFreeHeapSpan(m_arenaStart, address(5), &m_freeSpan));
+}
+
+TEST(NewlibHeap, FreeChunkAfterEndOfRange_ShouldReturnNoFreeSpan)
+{
+    __malloc_free_list = createChunk(40, 8, NULL);
+    CHECK_FALSE(CrashCatcher_GetNextFreeHeapSpan(m_arenaStart, address(32), &m_freeSpan));
+}
+
+TEST(NewlibHeap, FreeChunkBeforeStartOfRange_ShouldSkipToNextChunk)
+{
+    NewlibChunk* pSecond = createChunk(40, 8, NULL);
+    __malloc_free_list = createChunk(4, 8, pSecond);
+    CHECK_TRUE(CrashCatcher_GetNextFreeHeapSpan(address(32), m_arenaEnd, &m_freeSpan));
+    validateFreeSpan(address(41), address(48));
+}
+
+TEST(NewlibHeap, FreeChunkBeforeStartOfHeap_ShouldTreatAsCorrupted)
+{
+    __malloc_free_list = createChunk(4, 8, NULL);
+    __malloc_sbrk_start = (char*)&m_arena[8];
+    CHECK_FALSE(CrashCatcher_GetNextFreeHeapSpan(m_arenaStart, m_arenaEnd, &m_freeSpan));
+}
+
+TEST(NewlibHeap, UnsortedFreeList_ShouldTreatAsCorrupted)
+{
+    NewlibChunk* pSecond = createChunk(4, 4, NULL);
+    __malloc_free_list = createChunk(20, 4, pSecond);
+    CHECK_FALSE(CrashCatcher_GetNextFreeHeapSpan(address(32), m_arenaEnd, &m_freeSpan));
+}
+
+TEST(NewlibHeap, OverlappingFreeChunks_ShouldTreatAsCorrupted)
+{
+    NewlibChunk* pSecond = createChunk(8, 4, NULL);
+    __malloc_free_list = createChunk(4, 8, pSecond);
+    CHECK_FALSE(CrashCatcher_GetNextFreeHeapSpan(address(12), m_arenaEnd, &m_freeSpan));
+}
+
+TEST(NewlibHeap, FreeListLoopsBackOnItself_ShouldTreatAsCorrupted)
+{
+    NewlibChunk* pFirst = createChunk(4, 4, NULL);
+    pFirst->next = pFirst;
+    __malloc_free_list = pFirst;
+    CHECK_FALSE(CrashCatcher_GetNextFreeHeapSpan(address(32), m_arenaEnd, &m_freeSpan));
+}
+
+TEST(NewlibHeap, MisalignedFreeChunk_ShouldTreatAsCorrupted)
+{
+    __malloc_free_list = (NewlibChunk*)((char*)&m_arena[4] + 2);
+    CHECK_FALSE(CrashCatcher_GetNextFreeHeapSpan(m_arenaStart, m_arenaEnd, &m_freeSpan));
+}
+
+TEST(NewlibHeap, FreeChunkSizeSmallerThanHeader_ShouldTreatAsCorrupted)
+{
+    __malloc_free_list = createChunk(4, 0, NULL);
+    CHECK_FALSE(CrashCatcher_GetNextFreeHeapSpan(m_arenaStart, m_arenaEnd, &m_freeSpan));
+}
+
+TEST(NewlibHeap, MisalignedFreeChunkSize_ShouldTreatAsCorrupted)
+{
+    __malloc_free_list = createChunk(4, 8, NULL);
+    __malloc_free_list->size += 1;
+    CHECK_FALSE(CrashCatcher_GetNextFreeHeapSpan(m_arenaStart, m_arenaEnd, &m_freeSpan));
+}
+
+TEST(NewlibHeap, FreeChunkEndWrapsAroundAddressSpace_ShouldTreatAsCorrupted)
+{
+    NewlibChunk* pSecond = createChunk(20, 4, NULL);
+    __malloc_free_list = createChunk(4, 8, pSecond);
+    __malloc_free_list->size = (long)(0x100000000ULL - address(4) + 4 * sizeof(NewlibChunk));
+    CHECK_FALSE(CrashCatcher_GetNextFreeHeapSpan(m_arenaStart, m_arenaEnd, &m_freeSpan));
+}
+
+TEST(NewlibHeap, NextSpanFromEndOfPreviousSpan_ShouldResumeWalkWithoutRevisitingEarlierChunks)
+{
+    NewlibChunk* pThird = createChunk(40, 4, NULL);
+    NewlibChunk* pSecond = createChunk(20, 4, pThird);
+    __malloc_free_list = createChunk(4, 8, pSecond);
+    CHECK_TRUE(CrashCatcher_GetNextFreeHeapSpan(m_arenaStart, m_arenaEnd, &m_freeSpan));
+    validateFreeSpan(address(5), address(12));
+    CHECK_TRUE(CrashCatcher_GetNextFreeHeapSpan(m_freeSpan.endAddress, m_arenaEnd, &m_freeSpan));
+    validateFreeSpan(address(21), address(24));
+    // Walking the list from its head again would now find the first chunk corrupted.
+    __malloc_free_list->size = 0;
+    CHECK_TRUE(CrashCatcher_GetNextFreeHeapSpan(m_freeSpan.endAddress, m_arenaEnd, &m_freeSpan));
+    validateFreeSpan(address(41), address(44));
+    CHECK_FALSE(CrashCatcher_GetNextFreeHeapSpan(m_freeSpan.endAddress, m_arenaEnd, &m_freeSpan));
+}
+
+TEST(NewlibHeap, SpanClippedToEndOfRange_ShouldResumeWithRestOfSameChunkInNextRange)
+{
+    __malloc_free_list = createChunk(4, 8, NULL);
+    CHECK_TRUE(CrashCatcher_GetNextFreeHeapSpan(m_arenaStart, address(8), &m_freeSpan));
+    validateFreeSpan(address(5), address(8));
+    CHECK_TRUE(CrashCatcher_GetNextFreeHeapSpan(address(8), m_arenaEnd, &m_freeSpan));
+    validateFreeSpan(address(8), address(12));
+}
+
+TEST(NewlibHeap, StartBeforeEndOfPreviousSpan_ShouldWalkListFromHeadAgain)
+{
+    NewlibChunk* pSecond = createChunk(20, 4, NULL);
+    __malloc_free_list = createChunk(4, 8, pSecond);
+    CHECK_TRUE(CrashCatcher_GetNextFreeHeapSpan(address(16), m_arenaEnd, &m_freeSpan));
+    validateFreeSpan(address(21), address(24));
+    CHECK_TRUE(CrashCatcher_GetNextFreeHeapSpan(m_arenaStart, m_arenaEnd, &m_freeSpan));
+    validateFreeSpan(address(5), address(12));
+}
+
+TEST(NewlibHeap, FreeListChangedBetweenCalls_ShouldWalkNewListFromHead)
+{
+    NewlibChunk* pSecond = createChunk(20, 4, NULL);
+    __malloc_free_list = createChunk(4, 8, pSecond);
+    CHECK_TRUE(CrashCatcher_GetNextFreeHeapSpan(m_arenaStart, m_arenaEnd, &m_freeSpan));
+    validateFreeSpan(address(5), address(12));
+    __malloc_free_list = createChunk(12, 4, pSecond);
+    CHECK_TRUE(CrashCatcher_GetNextFreeHeapSpan(m_freeSpan.endAddress, m_arenaEnd, &m_freeSpan));
+    validateFreeSpan(address(13), address(16));
+}
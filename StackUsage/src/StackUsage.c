@@ -0,0 +1,469 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Parses the VCG formatted call graphs which GCC writes to .ci files when given -fcallgraph-info=su and then walks
+   them depth first to find the chain of calls which needs the most stack.  Each node looks like:
+     node: { title: "file.c:staticFunc" label: "staticFunc\nfile.c:12:13\n16 bytes (static)" }
+   Nodes for functions which are only called from the file have "shape : ellipse" in place of the frame size and each
+   call is recorded as:
+     edge: { sourcename: "file.c:staticFunc" targetname: "globalFunc" label: "file.c:14:5" }
+*/
+#include <stdlib.h>
+#include <string.h>
+#include "StackUsage.h"
+
+
+#define NO_CALLEE   ((size_t)-1)
+
+typedef struct
+{
+    const char* pStart;
+    const char* pEnd;
+} Span;
+
+typedef enum
+{
+    UNVISITED = 0,
+    VISITING,
+    VISITED
+} VisitState;
+
+typedef struct
+{
+    const StackUsageGraph* pGraph;
+    StackUsageReport*      pReport;
+    uint8_t*               pStates;
+    uint32_t*              pDepths;
+    size_t*                pDeepestCallees;
+    size_t                 unresolvedAllocated;
+    int                    isOutOfMemory;
+} Analysis;
+
+
+static const char* skipString(const char* p, const char* pEnd);
+static const char* skipSpaces(const char* p, const char* pEnd);
+static int         isIdentifierChar(char c);
+static int         matchKeyword(const char* p, const char* pEnd, const char* pKeyword, const char** ppRecord);
+static const char* findRecordEnd(const char* p, const char* pEnd);
+static int         findAttribute(const char* pStart, const char* pEnd, const char* pKey, Span* pValue);
+static int         parseNode(StackUsageGraph* pGraph, const char* pStart, const char* pEnd);
+static int         parseEdge(StackUsageGraph* pGraph, const char* pStart, const char* pEnd);
+static void        parseFrameSize(StackUsageFunction* pFunction, const Span* pLabel);
+static const char* findString(const char* p, const char* pEnd, const char* pString);
+static int         findFunction(StackUsageGraph* pGraph, const Span* pName, size_t* pIndex);
+static int         addCallee(StackUsageFunction* pFunction, size_t calleeIndex);
+static size_t      lookupFunction(const StackUsageGraph* pGraph, const char* pName, size_t nameLength);
+static void        visit(Analysis* pAnalysis, size_t index);
+static void        addUnresolved(Analysis* pAnalysis, const char* pName);
+static void        buildPath(Analysis* pAnalysis, size_t rootIndex);
+
+
+int StackUsage_AddCallGraph(StackUsageGraph* pGraph, const char* pText, size_t textSize)
+{
+    const char* p = pText;
+    const char* pEnd = pText + textSize;
+
+    while (p < pEnd)
+    {
+        const char* pRecord;
+
+        if (*p == '"')
+        {
+            p = skipString(p, pEnd);
+        }
+        else if (matchKeyword(p, pEnd, "node", &pRecord))
+        {
+            p = findRecordEnd(pRecord, pEnd);
+            if (parseNode(pGraph, pRecord, p))
+                return -1;
+        }
+        else if (matchKeyword(p, pEnd, "edge", &pRecord))
+        {
+            p = findRecordEnd(pRecord, pEnd);
+            if (parseEdge(pGraph, pRecord, p))
+                return -1;
+        }
+        else
+        {
+            p++;
+        }
+    }
+    return 0;
+}
+
+static const char* skipString(const char* p, const char* pEnd)
+{
+    for (p++ ; p < pEnd && *p != '"' ; p++)
+    {
+        if (*p == '\\' && p + 1 < pEnd)
+            p++;
+    }
+    return p < pEnd ? p + 1 : pEnd;
+}
+
+static const char* skipSpaces(const char* p, const char* pEnd)
+{
+    while (p < pEnd && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n'))
+        p++;
+    return p;
+}
+
+static int isIdentifierChar(char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+}
+
+static int matchKeyword(const char* p, const char* pEnd, const char* pKeyword, const char** ppRecord)
+{
+    size_t keywordLength = strlen(pKeyword);
+
+    if ((size_t)(pEnd - p) < keywordLength || memcmp(p, pKeyword, keywordLength) != 0)
+        return 0;
+    p = skipSpaces(p + keywordLength, pEnd);
+    if (p >= pEnd || *p != ':')
+        return 0;
+    p = skipSpaces(p + 1, pEnd);
+    if (p >= pEnd || *p != '{')
+        return 0;
+    *ppRecord = p + 1;
+    return 1;
+}
+
+static const char* findRecordEnd(const char* p, const char* pEnd)
+{
+    while (p < pEnd && *p != '}')
+    {
+        if (*p == '"')
+            p = skipString(p, pEnd);
+        else
+            p++;
+    }
+    return p;
+}
+
+static int findAttribute(const char* pStart, const char* pEnd, const char* pKey, Span* pValue)
+{
+    size_t      keyLength = strlen(pKey);
+    const char* p = pStart;
+
+    while (p < pEnd)
+    {
+        const char* pValueStart;
+
+        if (*p == '"')
+        {
+            p = skipString(p, pEnd);
+            continue;
+        }
+        if ((size_t)(pEnd - p) <= keyLength || memcmp(p, pKey, keyLength) != 0 ||
+            (p > pStart && isIdentifierChar(p[-1])) || isIdentifierChar(p[keyLength]))
+        {
+            p++;
+            continue;
+        }
+        p = skipSpaces(p + keyLength, pEnd);
+        if (p >= pEnd || *p != ':')
+            continue;
+        pValueStart = skipSpaces(p + 1, pEnd);
+        if (pValueStart >= pEnd || *pValueStart != '"')
+            continue;
+        p = skipString(pValueStart, pEnd);
+        pValue->pStart = pValueStart + 1;
+        pValue->pEnd = p - 1;
+        return 1;
+    }
+    return 0;
+}
+
+static int parseNode(StackUsageGraph* pGraph, const char* pStart, const char* pEnd)
+{
+    Span   title;
+    Span   label;
+    size_t index;
+
+    if (!findAttribute(pStart, pEnd, "title", &title))
+        return 0;
+    if (findFunction(pGraph, &title, &index))
+        return -1;
+    if (findAttribute(pStart, pEnd, "label", &label))
+        parseFrameSize(&pGraph->pFunctions[index], &label);
+    return 0;
+}
+
+static int parseEdge(StackUsageGraph* pGraph, const char* pStart, const char* pEnd)
+{
+    Span   source;
+    Span   target;
+    size_t sourceIndex;
+    size_t targetIndex;
+
+    if (!findAttribute(pStart, pEnd, "sourcename", &source) || !findAttribute(pStart, pEnd, "targetname", &target))
+        return 0;
+    if (findFunction(pGraph, &source, &sourceIndex) || findFunction(pGraph, &target, &targetIndex))
+        return -1;
+    return addCallee(&pGraph->pFunctions[sourceIndex], targetIndex);
+}
+
+static void parseFrameSize(StackUsageFunction* pFunction, const Span* pLabel)
+{
+    /* The last line of the label is "N bytes (static)", "N bytes (dynamic)" or "N bytes (dynamic,bounded)".  A
+       bounded dynamic frame never grows past N so only unbounded ones are flagged. */
+    const char* pBytes = findString(pLabel->pStart, pLabel->pEnd, " bytes (");
+    const char* pDigits = pBytes;
+    const char* pQualifier;
+    uint32_t    frameSize = 0;
+
+    if (!pBytes)
+        return;
+    while (pDigits > pLabel->pStart && pDigits[-1] >= '0' && pDigits[-1] <= '9')
+        pDigits--;
+    if (pDigits == pBytes)
+        return;
+    for ( ; pDigits < pBytes ; pDigits++)
+        frameSize = frameSize * 10 + (*pDigits - '0');
+
+    pQualifier = pBytes + strlen(" bytes (");
+    if (findString(pQualifier, pLabel->pEnd, "dynamic") && !findString(pQualifier, pLabel->pEnd, "bounded"))
+        pFunction->isDynamic = 1;
+    if (!pFunction->isDefined || frameSize > pFunction->frameSize)
+        pFunction->frameSize = frameSize;
+    pFunction->isDefined = 1;
+}
+
+static const char* findString(const char* p, const char* pEnd, const char* pString)
+{
+    size_t length = strlen(pString);
+
+    for ( ; (size_t)(pEnd - p) >= length ; p++)
+    {
+        if (memcmp(p, pString, length) == 0)
+            return p;
+    }
+    return NULL;
+}
+
+static int findFunction(StackUsageGraph* pGraph, const Span* pName, size_t* pIndex)
+{
+    size_t              nameLength = pName->pEnd - pName->pStart;
+    size_t              index = lookupFunction(pGraph, pName->pStart, nameLength);
+    StackUsageFunction* pFunction;
+
+    if (index != NO_CALLEE)
+    {
+        *pIndex = index;
+        return 0;
+    }
+    if (pGraph->functionCount == pGraph->functionAllocated)
+    {
+        size_t              newAllocated = pGraph->functionAllocated ? 2 * pGraph->functionAllocated : 64;
+        StackUsageFunction* pNew = realloc(pGraph->pFunctions, newAllocated * sizeof(*pNew));
+
+        if (!pNew)
+            return -1;
+        pGraph->pFunctions = pNew;
+        pGraph->functionAllocated = newAllocated;
+    }
+    pFunction = &pGraph->pFunctions[pGraph->functionCount];
+    memset(pFunction, 0, sizeof(*pFunction));
+    pFunction->pName = malloc(nameLength + 1);
+    if (!pFunction->pName)
+        return -1;
+    memcpy(pFunction->pName, pName->pStart, nameLength);
+    pFunction->pName[nameLength] = '\0';
+    *pIndex = pGraph->functionCount++;
+    return 0;
+}
+
+static size_t lookupFunction(const StackUsageGraph* pGraph, const char* pName, size_t nameLength)
+{
+    size_t i;
+
+    for (i = 0 ; i < pGraph->functionCount ; i++)
+    {
+        const char* pCurr = pGraph->pFunctions[i].pName;
+
+        if (strncmp(pCurr, pName, nameLength) == 0 && pCurr[nameLength] == '\0')
+            return i;
+    }
+    return NO_CALLEE;
+}
+
+static int addCallee(StackUsageFunction* pFunction, size_t calleeIndex)
+{
+    size_t i;
+
+    for (i = 0 ; i < pFunction->calleeCount ; i++)
+    {
+        if (pFunction->pCallees[i] == calleeIndex)
+            return 0;
+    }
+    if (pFunction->calleeCount == pFunction->calleeAllocated)
+    {
+        size_t  newAllocated = pFunction->calleeAllocated ? 2 * pFunction->calleeAllocated : 4;
+        size_t* pNew = realloc(pFunction->pCallees, newAllocated * sizeof(*pNew));
+
+        if (!pNew)
+            return -1;
+        pFunction->pCallees = pNew;
+        pFunction->calleeAllocated = newAllocated;
+    }
+    pFunction->pCallees[pFunction->calleeCount++] = calleeIndex;
+    return 0;
+}
+
+
+StackUsageResult StackUsage_Analyze(const StackUsageGraph* pGraph, const char* pRootName, StackUsageReport* pReport)
+{
+    Analysis analysis;
+    size_t   rootIndex;
+    size_t   count = pGraph->functionCount ? pGraph->functionCount : 1;
+
+    memset(pReport, 0, sizeof(*pReport));
+    rootIndex = lookupFunction(pGraph, pRootName, strlen(pRootName));
+    if (rootIndex == NO_CALLEE)
+        return STACK_USAGE_NO_ROOT;
+
+    memset(&analysis, 0, sizeof(analysis));
+    analysis.pGraph = pGraph;
+    analysis.pReport = pReport;
+    analysis.pStates = calloc(count, sizeof(*analysis.pStates));
+    analysis.pDepths = calloc(count, sizeof(*analysis.pDepths));
+    analysis.pDeepestCallees = malloc(count * sizeof(*analysis.pDeepestCallees));
+    if (analysis.pStates && analysis.pDepths && analysis.pDeepestCallees)
+    {
+        visit(&analysis, rootIndex);
+        pReport->worstCaseBytes = analysis.pDepths[rootIndex];
+        buildPath(&analysis, rootIndex);
+    }
+    else
+    {
+        analysis.isOutOfMemory = 1;
+    }
+    free(analysis.pStates);
+    free(analysis.pDepths);
+    free(analysis.pDeepestCallees);
+    return analysis.isOutOfMemory ? STACK_USAGE_NO_MEMORY : STACK_USAGE_OK;
+}
+
+static void visit(Analysis* pAnalysis, size_t index)
+{
+    const StackUsageFunction* pFunction = &pAnalysis->pGraph->pFunctions[index];
+    uint32_t                  deepest = 0;
+    size_t                    deepestCallee = NO_CALLEE;
+    size_t                    i;
+
+    pAnalysis->pStates[index] = VISITING;
+    for (i = 0 ; i < pFunction->calleeCount ; i++)
+    {
+        size_t callee = pFunction->pCallees[i];
+
+        if (pAnalysis->pStates[callee] == VISITING)
+        {
+            pAnalysis->pReport->hasRecursion = 1;
+            continue;
+        }
+        if (pAnalysis->pStates[callee] == UNVISITED)
+            visit(pAnalysis, callee);
+        if (pAnalysis->pDepths[callee] > deepest)
+        {
+            deepest = pAnalysis->pDepths[callee];
+            deepestCallee = callee;
+        }
+    }
+    if (!pFunction->isDefined)
+        addUnresolved(pAnalysis, pFunction->pName);
+
+    pAnalysis->pDepths[index] = pFunction->frameSize + deepest;
+    pAnalysis->pDeepestCallees[index] = deepestCallee;
+    pAnalysis->pStates[index] = VISITED;
+}
+
+static void addUnresolved(Analysis* pAnalysis, const char* pName)
+{
+    StackUsageReport* pReport = pAnalysis->pReport;
+
+    if (pReport->unresolvedCount == pAnalysis->unresolvedAllocated)
+    {
+        size_t       newAllocated = pAnalysis->unresolvedAllocated ? 2 * pAnalysis->unresolvedAllocated : 16;
+        const char** ppNew = realloc(pReport->ppUnresolved, newAllocated * sizeof(*ppNew));
+
+        if (!ppNew)
+        {
+            pAnalysis->isOutOfMemory = 1;
+            return;
+        }
+        pReport->ppUnresolved = ppNew;
+        pAnalysis->unresolvedAllocated = newAllocated;
+    }
+    pReport->ppUnresolved[pReport->unresolvedCount++] = pName;
+}
+
+static void buildPath(Analysis* pAnalysis, size_t rootIndex)
+{
+    StackUsageReport* pReport = pAnalysis->pReport;
+    size_t            length = 0;
+    size_t            index;
+
+    for (index = rootIndex ; index != NO_CALLEE ; index = pAnalysis->pDeepestCallees[index])
+        length++;
+    pReport->ppPath = malloc(length * sizeof(*pReport->ppPath));
+    if (!pReport->ppPath)
+    {
+        pAnalysis->isOutOfMemory = 1;
+        return;
+    }
+    for (index = rootIndex ; index != NO_CALLEE ; index = pAnalysis->pDeepestCallees[index])
+    {
+        const StackUsageFunction* pFunction = &pAnalysis->pGraph->pFunctions[index];
+
+        pReport->ppPath[pReport->pathLength++] = pFunction;
+        if (pFunction->isDynamic)
+            pReport->hasDynamicFrames = 1;
+    }
+}
+
+
+const char* StackUsage_ResultString(StackUsageResult result)
+{
+    switch (result)
+    {
+    case STACK_USAGE_OK:
+        return "OK";
+    case STACK_USAGE_NO_ROOT:
+        return "root function not found in call graph";
+    case STACK_USAGE_NO_MEMORY:
+        return "out of memory";
+    }
+    return "unknown result";
+}
+
+void StackUsage_FreeGraph(StackUsageGraph* pGraph)
+{
+    size_t i;
+
+    for (i = 0 ; i < pGraph->functionCount ; i++)
+    {
+        free(pGraph->pFunctions[i].pName);
+        free(pGraph->pFunctions[i].pCallees);
+    }
+    free(pGraph->pFunctions);
+    memset(pGraph, 0, sizeof(*pGraph));
+}
+
+void StackUsage_FreeReport(StackUsageReport* pReport)
+{
+    free(pReport->ppPath);
+    free(pReport->ppUnresolved);
+    memset(pReport, 0, sizeof(*pReport));
+}
@@ -0,0 +1,95 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Host side worst case stack analysis of the call graphs written by GCC's -fcallgraph-info=su option. */
+#ifndef _STACK_USAGE_H_
+#define _STACK_USAGE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+typedef enum
+{
+    /* The worst case path from the root function was found. */
+    STACK_USAGE_OK = 0,
+    /* The root function doesn't show up in any of the call graphs. */
+    STACK_USAGE_NO_ROOT,
+    /* Memory ran out while analyzing the graph. */
+    STACK_USAGE_NO_MEMORY
+} StackUsageResult;
+
+typedef struct
+{
+    /* Node title from the .ci file.  GCC prefixes the names of static functions with their source filename. */
+    char*    pName;
+    /* Number of bytes used by the function's own stack frame.  Only valid if isDefined is set. */
+    uint32_t frameSize;
+    /* Set once a .ci file containing the function's body, and therefore its frame size, has been added. */
+    int      isDefined;
+    /* Set if GCC flagged the frame as dynamic (alloca or variable length arrays) so frameSize is only a lower bound. */
+    int      isDynamic;
+    /* Indices of the functions called directly from this one. */
+    size_t*  pCallees;
+    size_t   calleeCount;
+    size_t   calleeAllocated;
+} StackUsageFunction;
+
+typedef struct
+{
+    /* Every function seen so far, whether it was called or defined. */
+    StackUsageFunction* pFunctions;
+    size_t              functionCount;
+    size_t              functionAllocated;
+} StackUsageGraph;
+
+typedef struct
+{
+    /* Stack bytes used by the deepest chain of calls from the root function. */
+    uint32_t                   worstCaseBytes;
+    /* Functions in that chain, starting with the root.  They point into the graph's functions. */
+    const StackUsageFunction** ppPath;
+    size_t                     pathLength;
+    /* Names of the functions reachable from the root which weren't defined in any of the call graphs.  Their stack
+       use isn't included in worstCaseBytes.  Calls through function pointers show up here as "__indirect_call". */
+    const char**               ppUnresolved;
+    size_t                     unresolvedCount;
+    /* Set if a function reachable from the root can call itself.  Only a single trip around each cycle is counted. */
+    int                        hasRecursion;
+    /* Set if any function on the worst case path has a dynamic frame. */
+    int                        hasDynamicFrames;
+} StackUsageReport;
+
+
+/* Adds the functions and calls from the textSize bytes of a .ci file at pText to pGraph.  pGraph must be zero filled
+   before the first call.  Functions are matched up across files by node title so that a call to a global function in
+   one file picks up its frame size from the file which defines it.  Returns 0 on success or -1 if memory ran out.
+   StackUsage_FreeGraph() must be called to free pGraph either way. */
+int              StackUsage_AddCallGraph(StackUsageGraph* pGraph, const char* pText, size_t textSize);
+
+/* Finds the chain of calls from the function titled pRootName which uses the most stack.  StackUsage_FreeReport() must
+   be called to free pReport whatever the result. */
+StackUsageResult StackUsage_Analyze(const StackUsageGraph* pGraph, const char* pRootName, StackUsageReport* pReport);
+
+/* Returns a short description of result. */
+const char*      StackUsage_ResultString(StackUsageResult result);
+
+/* Frees the functions added by StackUsage_AddCallGraph(). */
+void             StackUsage_FreeGraph(StackUsageGraph* pGraph);
+
+/* Frees the arrays returned by StackUsage_Analyze(). */
+void             StackUsage_FreeReport(StackUsageReport* pReport);
+
+
+#endif /* _STACK_USAGE_H_ */
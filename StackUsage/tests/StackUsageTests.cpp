@@ -0,0 +1,216 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+#include <string.h>
+
+// Include headers from C modules under test.
+extern "C"
+{
+    #include <StackUsage.h>
+}
+
+// Include C++ headers for test harness.
+#include <CppUTest/TestHarness.h>
+
+
+TEST_GROUP(StackUsage)
+{
+    StackUsageGraph  m_graph;
+    StackUsageReport m_report;
+
+    void setup()
+    {
+        memset(&m_graph, 0, sizeof(m_graph));
+        memset(&m_report, 0, sizeof(m_report));
+    }
+
+    void teardown()
+    {
+        StackUsage_FreeReport(&m_report);
+        StackUsage_FreeGraph(&m_graph);
+    }
+
+    void addCallGraph(const char* pText)
+    {
+        CHECK_EQUAL(0, StackUsage_AddCallGraph(&m_graph, pText, strlen(pText)));
+    }
+
+    StackUsageResult analyze(const char* pRootName)
+    {
+        return StackUsage_Analyze(&m_graph, pRootName, &m_report);
+    }
+
+    void validatePath(const char** ppExpected, size_t expectedLength)
+    {
+        CHECK_EQUAL(expectedLength, m_report.pathLength);
+        for (size_t i = 0 ; i < expectedLength ; i++)
+            STRCMP_EQUAL(ppExpected[i], m_report.ppPath[i]->pName);
+    }
+};
+
+
+TEST(StackUsage, EmptyGraph_ShouldReturnNoRoot)
+{
+    addCallGraph("");
+    CHECK_EQUAL(STACK_USAGE_NO_ROOT, analyze("CrashCatcher_Entry"));
+    CHECK_EQUAL(0, m_report.worstCaseBytes);
+    CHECK_EQUAL(0, m_report.pathLength);
+}
+
+TEST(StackUsage, SingleLeafFunction_ShouldReturnItsFrameSize)
+{
+    static const char* path[] = { "root" };
+    addCallGraph("graph: { title: \"a.c\"\n"
+                 "node: { title: \"root\" label: \"root\\na.c:1:6\\n24 bytes (static)\" }\n"
+                 "}\n");
+    CHECK_EQUAL(STACK_USAGE_OK, analyze("root"));
+    CHECK_EQUAL(24, m_report.worstCaseBytes);
+    validatePath(path, 1);
+    CHECK_EQUAL(0, m_report.unresolvedCount);
+    CHECK_FALSE(m_report.hasRecursion);
+    CHECK_FALSE(m_report.hasDynamicFrames);
+}
+
+TEST(StackUsage, TwoCallees_ShouldFollowDeeperOne)
+{
+    static const char* path[] = { "root", "a.c:deep" };
+    addCallGraph("graph: { title: \"a.c\"\n"
+                 "node: { title: \"a.c:shallow\" label: \"shallow\\na.c:1:13\\n8 bytes (static)\" }\n"
+                 "node: { title: \"a.c:deep\" label: \"deep\\na.c:5:13\\n40 bytes (static)\" }\n"
+                 "node: { title: \"root\" label: \"root\\na.c:9:6\\n16 bytes (static)\" }\n"
+                 "edge: { sourcename: \"root\" targetname: \"a.c:shallow\" label: \"a.c:11:5\" }\n"
+                 "edge: { sourcename: \"root\" targetname: \"a.c:deep\" label: \"a.c:12:5\" }\n"
+                 "}\n");
+    CHECK_EQUAL(STACK_USAGE_OK, analyze("root"));
+    CHECK_EQUAL(56, m_report.worstCaseBytes);
+    validatePath(path, 2);
+}
+
+TEST(StackUsage, CallToGlobalInSecondFile_ShouldPickUpItsFrameSize)
+{
+    static const char* path[] = { "root", "backend" };
+    addCallGraph("graph: { title: \"a.c\"\n"
+                 "node: { title: \"root\" label: \"root\\na.c:9:6\\n16 bytes (static)\" }\n"
+                 "node: { title: \"backend\" label: \"backend\\nb.h:3:6\" shape : ellipse }\n"
+                 "edge: { sourcename: \"root\" targetname: \"backend\" label: \"a.c:11:5\" }\n"
+                 "}\n");
+    addCallGraph("graph: { title: \"b.c\"\n"
+                 "node: { title: \"backend\" label: \"backend\\nb.c:3:6\\n32 bytes (static)\" }\n"
+                 "}\n");
+    CHECK_EQUAL(STACK_USAGE_OK, analyze("root"));
+    CHECK_EQUAL(48, m_report.worstCaseBytes);
+    validatePath(path, 2);
+    CHECK_EQUAL(0, m_report.unresolvedCount);
+}
+
+TEST(StackUsage, CallsToUndefinedAndIndirectFunctions_ShouldBeReportedAsUnresolved)
+{
+    static const char* path[] = { "root" };
+    addCallGraph("graph: { title: \"a.c\"\n"
+                 "node: { title: \"root\" label: \"root\\na.c:9:6\\n16 bytes (static)\" }\n"
+                 "node: { title: \"memcpy\" label: \"memcpy\\nstring.h:3:6\" shape : ellipse }\n"
+                 "edge: { sourcename: \"root\" targetname: \"memcpy\" label: \"a.c:11:5\" }\n"
+                 "node: { title: \"__indirect_call\" label: \"Indirect Call Placeholder\" shape : ellipse }\n"
+                 "edge: { sourcename: \"root\" targetname: \"__indirect_call\" label: \"a.c:12:5\" }\n"
+                 "}\n");
+    CHECK_EQUAL(STACK_USAGE_OK, analyze("root"));
+    CHECK_EQUAL(16, m_report.worstCaseBytes);
+    validatePath(path, 1);
+    CHECK_EQUAL(2, m_report.unresolvedCount);
+    STRCMP_EQUAL("memcpy", m_report.ppUnresolved[0]);
+    STRCMP_EQUAL("__indirect_call", m_report.ppUnresolved[1]);
+}
+
+TEST(StackUsage, SharedCalleeReachedTwice_ShouldOnlyBeReportedOnceAsUnresolved)
+{
+    addCallGraph("graph: { title: \"a.c\"\n"
+                 "node: { title: \"root\" label: \"root\\na.c:9:6\\n16 bytes (static)\" }\n"
+                 "node: { title: \"a.c:helper\" label: \"helper\\na.c:1:13\\n8 bytes (static)\" }\n"
+                 "edge: { sourcename: \"root\" targetname: \"a.c:helper\" label: \"a.c:11:5\" }\n"
+                 "edge: { sourcename: \"root\" targetname: \"memcpy\" label: \"a.c:12:5\" }\n"
+                 "edge: { sourcename: \"a.c:helper\" targetname: \"memcpy\" label: \"a.c:2:5\" }\n"
+                 "edge: { sourcename: \"a.c:helper\" targetname: \"memcpy\" label: \"a.c:3:5\" }\n"
+                 "}\n");
+    CHECK_EQUAL(STACK_USAGE_OK, analyze("root"));
+    CHECK_EQUAL(24, m_report.worstCaseBytes);
+    CHECK_EQUAL(1, m_report.unresolvedCount);
+    STRCMP_EQUAL("memcpy", m_report.ppUnresolved[0]);
+}
+
+TEST(StackUsage, RecursiveCall_ShouldSetHasRecursionAndCountOneTripAroundCycle)
+{
+    static const char* path[] = { "root", "a.c:ping", "a.c:pong" };
+    addCallGraph("graph: { title: \"a.c\"\n"
+                 "node: { title: \"root\" label: \"root\\na.c:9:6\\n16 bytes (static)\" }\n"
+                 "node: { title: \"a.c:ping\" label: \"ping\\na.c:1:13\\n8 bytes (static)\" }\n"
+                 "node: { title: \"a.c:pong\" label: \"pong\\na.c:5:13\\n8 bytes (static)\" }\n"
+                 "edge: { sourcename: \"root\" targetname: \"a.c:ping\" label: \"a.c:11:5\" }\n"
+                 "edge: { sourcename: \"a.c:ping\" targetname: \"a.c:pong\" label: \"a.c:2:5\" }\n"
+                 "edge: { sourcename: \"a.c:pong\" targetname: \"a.c:ping\" label: \"a.c:6:5\" }\n"
+                 "}\n");
+    CHECK_EQUAL(STACK_USAGE_OK, analyze("root"));
+    CHECK_TRUE(m_report.hasRecursion);
+    CHECK_EQUAL(32, m_report.worstCaseBytes);
+    validatePath(path, 3);
+}
+
+TEST(StackUsage, DynamicFrameOnWorstPath_ShouldSetHasDynamicFrames)
+{
+    addCallGraph("graph: { title: \"a.c\"\n"
+                 "node: { title: \"root\" label: \"root\\na.c:9:6\\n16 bytes (dynamic)\" }\n"
+                 "}\n");
+    CHECK_EQUAL(STACK_USAGE_OK, analyze("root"));
+    CHECK_EQUAL(16, m_report.worstCaseBytes);
+    CHECK_TRUE(m_report.hasDynamicFrames);
+}
+
+TEST(StackUsage, BoundedDynamicFrame_ShouldNotSetHasDynamicFrames)
+{
+    addCallGraph("graph: { title: \"a.c\"\n"
+                 "node: { title: \"root\" label: \"root\\na.c:9:6\\n64 bytes (dynamic,bounded)\" }\n"
+                 "}\n");
+    CHECK_EQUAL(STACK_USAGE_OK, analyze("root"));
+    CHECK_EQUAL(64, m_report.worstCaseBytes);
+    CHECK_FALSE(m_report.hasDynamicFrames);
+}
+
+TEST(StackUsage, KeywordsInsideQuotedStrings_ShouldBeIgnored)
+{
+    static const char* path[] = { "root" };
+    addCallGraph("graph: { title: \"node: { title: \\\"bogus\\\" }\"\n"
+                 "node: { title: \"root\" label: \"root\\nedge: {title: \\\"x\\\"}\\n12 bytes (static)\" }\n"
+                 "}\n");
+    CHECK_EQUAL(STACK_USAGE_OK, analyze("root"));
+    CHECK_EQUAL(12, m_report.worstCaseBytes);
+    validatePath(path, 1);
+    CHECK_EQUAL(1, m_graph.functionCount);
+}
+
+TEST(StackUsage, TruncatedText_ShouldKeepWhatWasParsed)
+{
+    addCallGraph("graph: { title: \"a.c\"\n"
+                 "node: { title: \"root\" label: \"root\\na.c:9:6\\n16 bytes (static)\" }\n"
+                 "edge: { sourcename: \"root\" targetn");
+    CHECK_EQUAL(STACK_USAGE_OK, analyze("root"));
+    CHECK_EQUAL(16, m_report.worstCaseBytes);
+    CHECK_EQUAL(1, m_graph.functionCount);
+}
+
+TEST(StackUsage, ResultString_ShouldReturnDescriptions)
+{
+    STRCMP_EQUAL("OK", StackUsage_ResultString(STACK_USAGE_OK));
+    STRCMP_EQUAL("root function not found in call graph", StackUsage_ResultString(STACK_USAGE_NO_ROOT));
+    STRCMP_EQUAL("out of memory", StackUsage_ResultString(STACK_USAGE_NO_MEMORY));
+    STRCMP_EQUAL("unknown result", StackUsage_ResultString((StackUsageResult)-1));
+}
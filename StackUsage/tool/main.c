@@ -0,0 +1,118 @@
+/* Copyright (C) 2026  Adam Green (https://github.com/adamgreen)
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+       http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+/* Command line front end for StackUsage.  Usage: CrashCatcherStackUsage [-r rootFunction] ciFile... */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <StackUsage.h>
+
+
+/* HardFault_Handler pushes 12 words onto g_crashCatcherStack before it calls CrashCatcher_Entry. */
+#define HARDFAULT_HANDLER_BYTES (12 * 4)
+
+
+static int  addFile(StackUsageGraph* pGraph, const char* pFilename);
+static void printReport(const char* pRootName, const StackUsageReport* pReport);
+
+
+int main(int argc, char** argv)
+{
+    StackUsageGraph  graph;
+    StackUsageReport report;
+    StackUsageResult result;
+    const char*      pRootName = "CrashCatcher_Entry";
+    int              failureCount = 0;
+    int              i = 1;
+
+    if (argc >= 3 && strcmp(argv[1], "-r") == 0)
+    {
+        pRootName = argv[2];
+        i = 3;
+    }
+    if (i >= argc)
+    {
+        fprintf(stderr, "Usage: %s [-r rootFunction] ciFile...\n", argv[0]);
+        return 2;
+    }
+
+    memset(&graph, 0, sizeof(graph));
+    for ( ; i < argc ; i++)
+        failureCount += addFile(&graph, argv[i]);
+    result = StackUsage_Analyze(&graph, pRootName, &report);
+    if (result == STACK_USAGE_OK)
+        printReport(pRootName, &report);
+    else
+        fprintf(stderr, "%s: %s\n", pRootName, StackUsage_ResultString(result));
+    StackUsage_FreeReport(&report);
+    StackUsage_FreeGraph(&graph);
+
+    return (failureCount || result != STACK_USAGE_OK) ? 1 : 0;
+}
+
+static int addFile(StackUsageGraph* pGraph, const char* pFilename)
+{
+    FILE* pFile = fopen(pFilename, "rb");
+    char* pText = NULL;
+    long  textSize;
+    int   result;
+
+    if (!pFile || fseek(pFile, 0, SEEK_END) != 0 || (textSize = ftell(pFile)) < 0 || fseek(pFile, 0, SEEK_SET) != 0)
+    {
+        perror(pFilename);
+        if (pFile)
+            fclose(pFile);
+        return 1;
+    }
+    pText = malloc(textSize ? textSize : 1);
+    if (!pText || fread(pText, 1, textSize, pFile) != (size_t)textSize)
+    {
+        perror(pFilename);
+        free(pText);
+        fclose(pFile);
+        return 1;
+    }
+    fclose(pFile);
+    result = StackUsage_AddCallGraph(pGraph, pText, textSize);
+    free(pText);
+    if (result)
+    {
+        fprintf(stderr, "%s: out of memory\n", pFilename);
+        return 1;
+    }
+    return 0;
+}
+
+static void printReport(const char* pRootName, const StackUsageReport* pReport)
+{
+    uint32_t totalBytes = pReport->worstCaseBytes + HARDFAULT_HANDLER_BYTES;
+    size_t   i;
+
+    printf("Worst case stack use from %s: %u bytes\n", pRootName, (unsigned)pReport->worstCaseBytes);
+    for (i = 0 ; i < pReport->pathLength ; i++)
+        printf("%8u  %*s%s\n", (unsigned)pReport->ppPath[i]->frameSize, (int)(2 * i), "", pReport->ppPath[i]->pName);
+    if (pReport->hasRecursion)
+        printf("Warning: call graph contains recursion which was only counted once.\n");
+    if (pReport->hasDynamicFrames)
+        printf("Warning: worst case path contains dynamically sized frames.\n");
+    if (pReport->unresolvedCount)
+    {
+        printf("Not included (no call graph given for these):\n");
+        for (i = 0 ; i < pReport->unresolvedCount ; i++)
+            printf("    %s\n", pReport->ppUnresolved[i]);
+    }
+    printf("Adding %u bytes stacked by HardFault_Handler gives %u bytes.\n",
+           (unsigned)HARDFAULT_HANDLER_BYTES, (unsigned)totalBytes);
+    printf("Smallest safe setting: -DCRASH_CATCHER_STACK_WORD_COUNT=%u\n", (unsigned)((totalBytes + 3) / 4));
+}
@@ -30,6 +30,110 @@
 /* The second word of the dump contains flags.  These are the allowed flags. */
 /* Flag to indicate that 32 single-precision floating point registers and FPSCR will follow integer registers. */
 #define CRASH_CATCHER_FLAGS_FLOATING_POINT (1 << 0)
+/* Flag to indicate that everything after the flags word has been split into blocks of at most
+   CRASH_CATCHER_COMPRESSION_BLOCK_SIZE bytes and compressed. Each block starts with a 16-bit compressed size and a
+   16-bit uncompressed size (both little endian), followed by the compressed bytes in LZ4 block format. Blocks don't
+   reference each other so they can be decompressed independently and then concatenated to recover the rest of the
+   dump. */
+#define CRASH_CATCHER_FLAGS_COMPRESSED     (1 << 1)
+/* Flag to indicate that the data for each memory region is sent as a series of segments rather than as raw bytes.
+   The segment lengths for a region always add up to the size of that region. */
+#define CRASH_CATCHER_FLAGS_SEGMENTED      (1 << 2)
+/* Flag to indicate that this is a minidump which only contains the active stack, [SP, top of stack), as its single
+   memory region instead of the regions returned from CrashCatcher_GetMemoryRegions(). */
+#define CRASH_CATCHER_FLAGS_MINIDUMP       (1 << 3)
+/* Flag to indicate that a CRASH_CATCHER_RECORD_CRC32 record follows the memory regions so that host tools can detect
+   dumps which were corrupted in transit. */
+#define CRASH_CATCHER_FLAGS_CRC32          (1 << 4)
+/* Flag to indicate that a CRASH_CATCHER_RECORD_BACKTRACE record follows the flags word, ahead of the registers.  It is
+   never compressed so that the crash can still be identified from the start of a dump which was cut short. */
+#define CRASH_CATCHER_FLAGS_BACKTRACE      (1 << 5)
+/* Flag to indicate that the dump is split into two tiers which each end with a CRASH_CATCHER_RECORD_TIER_END record.
+   Tier 1 holds the registers, the fault status registers, a CRASH_CATCHER_RECORD_FAULT_CAUSE record and the top of
+   the active stack.  Tier 2 holds the remaining memory regions.  A dump which was cut short after the end of tier 1
+   can still be debugged. */
+#define CRASH_CATCHER_FLAGS_TWO_TIER       (1 << 6)
+/* Flag to indicate that a CRASH_CATCHER_RECORD_TIMING record follows the memory regions, ahead of any
+   CRASH_CATCHER_RECORD_CRC32 record, so that host tools can see where the time went while the dump was being sent. */
+#define CRASH_CATCHER_FLAGS_TIMING         (1 << 7)
+/* Flag to indicate that a CRASH_CATCHER_RECORD_STACK_USAGE record follows any CRASH_CATCHER_RECORD_TIMING record,
+   ahead of any CRASH_CATCHER_RECORD_CRC32 record, so that the size of g_crashCatcherStack can be tuned. */
+#define CRASH_CATCHER_FLAGS_STACK_USAGE    (1 << 8)
+
+/* Each segment starts with a 32-bit little endian header.  The upper 4 bits contain the segment type and the lower 28
+   bits contain the number of region bytes described by the segment. */
+#define CRASH_CATCHER_SEGMENT_TYPE_SHIFT   28
+#define CRASH_CATCHER_SEGMENT_LENGTH_MASK  0x0FFFFFFF
+/* The segment header is followed by length bytes of region data. */
+#define CRASH_CATCHER_SEGMENT_RAW          0
+/* The segment header is followed by a 32-bit fill word.  The region bytes covered by this segment are that fill word
+   repeated length / 4 times.  Fill segments are always word aligned and a multiple of 4 bytes in length. */
+#define CRASH_CATCHER_SEGMENT_FILL         1
+/* The segment has no payload.  The region bytes covered by this segment were free heap memory which wasn't dumped. */
+#define CRASH_CATCHER_SEGMENT_HOLE         2
+/* The segment header is followed by the 32-bit address in flash from which the region bytes covered by this segment
+   were initialized at startup.  These bytes haven't changed since then so host tools can recover them from the ELF. */
+#define CRASH_CATCHER_SEGMENT_LOAD_IMAGE   3
+
+/* Records can follow the memory regions, or the flags word for CRASH_CATCHER_RECORD_BACKTRACE.  Like a memory region, a
+   record starts with two 32-bit little endian words.  The first word is CRASH_CATCHER_RECORD_TAG(type) and the second
+   word is the number of payload bytes which follow.  Since the first word is always larger than the second, records
+   can't be confused with memory regions. */
+#define CRASH_CATCHER_RECORD_TAG(type)     (0xFFFFFF00 | (type))
+/* The payload contains the CRC32 of each memory region (its two address words and data), in the order that they were
+   dumped, followed by the number of region CRCs and then the CRC32 of every dump byte which came before it.  Only the
+   first CRASH_CATCHER_CRC32_MAX_REGIONS regions have a CRC.  The CRC32 is the same one used by zlib's crc32(). */
+#define CRASH_CATCHER_RECORD_CRC32         1
+/* The payload contains the EXC_RETURN value, CFSR, HFSR, MMFAR and BFAR (0 on ARMv6-M), the PC, LR and SP of the code
+   which faulted and the number of addresses found by scanning its stack, followed by a fixed number of address slots
+   with the unused ones set to 0.  Return addresses have the Thumb bit set.  When the scan passes through the exception
+   frame of a handler which was running at the time of the fault, the PC of the code it interrupted is added with the
+   Thumb bit clear, followed by that code's LR. */
+#define CRASH_CATCHER_RECORD_BACKTRACE     2
+/* The payload contains one of the CRASH_CATCHER_FAULT_* values decoded from the fault status registers, a word which is
+   1 if the next word holds the address of the faulting data access (MMFAR or BFAR) and 0 otherwise, and then that
+   address. */
+#define CRASH_CATCHER_RECORD_FAULT_CAUSE   3
+/* The payload contains the number of the tier which just ended (1 or 2) and the CRC32 of every dump byte which came
+   before the record when CRASH_CATCHER_FLAGS_CRC32 is set, or 0 otherwise. */
+#define CRASH_CATCHER_RECORD_TIER_END      4
+/* The payload contains the number of this attempt at sending the dump (1 for the first and one more each time
+   CrashCatcher_DumpEnd() returned CRASH_CATCHER_TRY_AGAIN) and then the number of DWT cycles spent capturing the
+   registers and fault state, in CrashCatcher_DumpStart(), in CrashCatcher_DumpEnd() for the previous attempt (0 for
+   the first) and sending the header and registers.  Next comes the number of uncompressed dump bytes which came before
+   the record, the number of region slots used and a fixed number of region slots with the unused ones set to 0.  Each
+   slot holds the cycles spent on a memory region and its uncompressed size, including its two address words, in the
+   order that they were dumped.  Only the first CRASH_CATCHER_TIMING_MAX_REGIONS regions have a slot. */
+#define CRASH_CATCHER_RECORD_TIMING        5
+/* The payload contains the size of g_crashCatcherStack in bytes and then the most bytes of it which had been used
+   when the record was sent.  The stack is only painted once per fault so the record sent after CrashCatcher_DumpEnd()
+   returned CRASH_CATCHER_TRY_AGAIN includes the stack used by the earlier attempts and their CrashCatcher_DumpEnd()
+   calls.  An overflowed stack is reported as completely used. */
+#define CRASH_CATCHER_RECORD_STACK_USAGE   6
+
+/* Causes reported in the CRASH_CATCHER_RECORD_FAULT_CAUSE record.  The fault status registers can have several bits
+   set so the cause closest to the root of the problem is reported.  ARMv6-M devices don't have these registers so only
+   CRASH_CATCHER_FAULT_BREAKPOINT or CRASH_CATCHER_FAULT_UNKNOWN are reported for them. */
+#define CRASH_CATCHER_FAULT_UNKNOWN                 0
+/* Hardcoded breakpoint or debug event. */
+#define CRASH_CATCHER_FAULT_BREAKPOINT              1
+/* Bus fault while reading the vector table during exception processing. */
+#define CRASH_CATCHER_FAULT_VECTOR_TABLE_READ       2
+/* Fault while stacking or unstacking registers on exception entry or return.  Often caused by stack overflow. */
+#define CRASH_CATCHER_FAULT_STACKING                3
+/* Instruction fetch from a protected, non-executable or non-existent address.  Often a corrupted function pointer. */
+#define CRASH_CATCHER_FAULT_INSTRUCTION_ACCESS      4
+/* Data access to a protected or non-existent address. */
+#define CRASH_CATCHER_FAULT_DATA_ACCESS             5
+/* Bus error on a buffered write which was only reported after the PC had moved on. */
+#define CRASH_CATCHER_FAULT_IMPRECISE_DATA_ACCESS   6
+#define CRASH_CATCHER_FAULT_UNDEFINED_INSTRUCTION   7
+/* Attempt to execute in ARM state or to return to an invalid EXC_RETURN value. */
+#define CRASH_CATCHER_FAULT_INVALID_STATE           8
+/* Floating point instruction executed while the FPU was disabled. */
+#define CRASH_CATCHER_FAULT_NO_COPROCESSOR          9
+#define CRASH_CATCHER_FAULT_UNALIGNED_ACCESS        10
+#define CRASH_CATCHER_FAULT_DIVIDE_BY_ZERO          11
 
 
 /* This magic value will be found as the last word in a crash dump if the fault handler overflowed the stack while
@@ -46,6 +150,14 @@ typedef struct
     int         isBKPT;
     /* If isBKPT is non-zero then this is the immediate value associated with that BKPT instruction. */
     uint8_t     bkptNumber;
+    /* Is this a retained dump being sent by CrashCatcher_EmitRetainedDump() after the device was reset, rather than from
+       the fault handler.  Implementations should return CRASH_CATCHER_EXIT from CrashCatcher_DumpEnd() for these. */
+    int         isRetained;
+    /* The PC and LR stacked on exception entry and one of the CRASH_CATCHER_FAULT_* values, which together identify
+       the crash without having to parse the dump. */
+    uint32_t    pc;
+    uint32_t    lr;
+    uint32_t    faultCause;
 } CrashCatcherInfo;
 
 
@@ -64,6 +176,15 @@ typedef enum
     CRASH_CATCHER_WORD = 4
 } CrashCatcherElementSizes;
 
+/* An array of these structures is passed to CrashCatcher_DumpMemoryVector() to describe several chunks of memory which
+   are to be dumped back to back.  The fields match the parameters of CrashCatcher_DumpMemory(). */
+typedef struct
+{
+    const void*              pvMemory;
+    CrashCatcherElementSizes elementSize;
+    size_t                   elementCount;
+} CrashCatcherMemoryVector;
+
 
 /* Codes to be returned from an implementation's CrashCathcer_DumpEnd() handler. */
 typedef enum
@@ -91,6 +212,63 @@ typedef struct
     CrashCatcherElementSizes elementSize;
 } CrashCatcherMemoryRegion;
 
+/* An array of these structures is returned from CrashCatcher_GetLoadImageRegions() to indicate which areas of RAM were
+   initialized from flash at startup (ie. .data).  The last entry should contain a starting address of 0xFFFFFFFF to
+   indicate that the end of the list has been encountered. */
+typedef struct
+{
+    /* The first address of the initialized data in RAM. */
+    /* The last region in the array returned from CrashCatcher_GetLoadImageRegions() must set this to 0xFFFFFFFF */
+    uint32_t startAddress;
+    /* The address just past the end of the initialized data in RAM. */
+    uint32_t endAddress;
+    /* The address in flash from which the byte at startAddress was copied. */
+    uint32_t loadAddress;
+} CrashCatcherLoadImageRegion;
+
+
+/* Returned from CrashCatcher_GetFlashArea() to describe the area of internal flash reserved for the FlashDump module.
+   The startAddress and size must both be multiples of sectorSize, which must be a multiple of the page size that the
+   FlashDump module was built with.  When slotCount is non-zero, size must also be a multiple of
+   slotCount * sectorSize. */
+typedef struct
+{
+    /* Address of the first byte of the reserved area. */
+    uint32_t startAddress;
+    /* Number of bytes in the reserved area. */
+    uint32_t size;
+    /* Size of the smallest block that the flash can erase. */
+    uint32_t sectorSize;
+    /* Number of equally sized slots that the area is split into so that the most recent dumps are kept, each one
+       starting with a CrashCatcherFlashSlotHeader.  Each dump is written into the slot after the one holding the newest
+       dump so that the slots wear evenly.  When 0, a single dump is written to the start of the area without a
+       header. */
+    uint32_t slotCount;
+} CrashCatcherFlashArea;
+
+/* Value found in CrashCatcherFlashSlotHeader::signature for a slot which holds a dump. */
+#define CRASH_CATCHER_FLASH_SLOT_SIGNATURE 0x4C534343
+
+/* Index header at the start of each FlashDump slot.  It is padded out to a whole number of pages and is only programmed
+   once the rest of the dump has been written, so a slot interrupted by a reset looks empty. */
+typedef struct
+{
+    /* CRASH_CATCHER_FLASH_SLOT_SIGNATURE if the slot holds a dump.  Erased slots hold 0xFFFFFFFF. */
+    uint32_t signature;
+    /* Starts at 1 and increases by one for each dump, so the slot with the highest value holds the newest dump. */
+    uint32_t sequence;
+    /* Number of dump bytes which follow the header. */
+    uint32_t size;
+    /* CRC32 (same as zlib's crc32()) of the size bytes of dump data. */
+    uint32_t crc;
+    /* Non-zero if the end of the dump was dropped because it didn't fit in the slot or the flash reported an error. */
+    uint32_t isTruncated;
+    /* Copied from the CrashCatcherInfo for the dump so that crashes can be told apart without reading the data. */
+    uint32_t pc;
+    uint32_t lr;
+    uint32_t faultCause;
+} CrashCatcherFlashSlotHeader;
+
 
 #ifdef __cplusplus
 extern "C"
@@ -119,6 +297,77 @@ void CrashCatcher_DumpMemory(const void* pvMemory, CrashCatcherElementSizes elem
    CrashCatcher should prepare to dump again incase user missed the first attempt. */
 CrashCatcherReturnCodes CrashCatcher_DumpEnd(void);
 
+/* Optionally provided by an implementation which uses the PSP for threads (ie. an RTOS) when CrashCatcher is built with
+   minidump support.  Called with the SP of the thread which crashed and should return the address just past the top of
+   that thread's stack or 0 if it isn't known.  When not provided, the stack is only dumped up to the top of the main
+   stack or CRASH_CATCHER_MINIDUMP_MAX_STACK_SIZE bytes, whichever comes first. */
+uint32_t CrashCatcher_GetThreadStackTop(uint32_t sp);
+
+/* Optionally provided by an implementation (ie. NewlibHeap) which knows where free chunks are located in the heap when
+   CrashCatcher is built with heap walking support.  Called with the range of a CRASH_CATCHER_BYTE memory region which
+   hasn't been dumped yet.  Should fill in pFreeSpan with the lowest addressed span of free memory within
+   [startAddress, endAddress) and return non-zero, or return 0 if there are no more free spans in that range.  Free spans
+   are marked as holes in the dump rather than having their contents dumped. */
+int CrashCatcher_GetNextFreeHeapSpan(uint32_t startAddress, uint32_t endAddress, CrashCatcherMemoryRegionInfo* pFreeSpan);
+
+/* Optionally provided by an implementation which wants unchanged initialized data left out of the dump when
+   CrashCatcher is built with load image support.  Should return an array of the areas of RAM which were copied from
+   flash at startup.  Where a CRASH_CATCHER_BYTE memory region overlaps one of them, only the blocks which no longer
+   match their load image are dumped.  The rest are sent as load image segments which host tools can fill back in from
+   the ELF. */
+const CrashCatcherLoadImageRegion* CrashCatcher_GetLoadImageRegions(void);
+
+/* Optionally provided by an implementation which wants to use a hardware CRC peripheral when CrashCatcher is built with
+   CRC32 support.  Should return the CRC32 (as calculated by zlib's crc32()) of size bytes at pvData, continuing on from
+   the crc value returned by the previous call.  The first call for each CRC passes in a crc of 0.  When not provided, a
+   small table driven software implementation is used instead. */
+uint32_t CrashCatcher_HardwareCrc32(uint32_t crc, const void* pvData, size_t size);
+
+/* Optionally provided by an implementation which can write several chunks of memory with a single I/O request (ie. one
+   semihost call or flash page program) when CrashCatcher is built with vectored dump support.  Called once at the start
+   of each dump with the vectorCount chunks making up the header, flags and registers.  They should be dumped in order,
+   exactly as if CrashCatcher_DumpMemory() had been called for each of them.  The rest of the dump is still sent through
+   CrashCatcher_DumpMemory(). */
+void CrashCatcher_DumpMemoryVector(const CrashCatcherMemoryVector* pVectors, size_t vectorCount);
+
+/* Optionally provided by an implementation which wants the dump captured into RAM and the device reset straight away
+   when CrashCatcher is built with retained dump support.  Should return a word aligned buffer, placed in a section
+   which isn't cleared at startup (ie. .noinit), and set *pSize to its size in bytes.  The registers and the memory
+   regions returned from CrashCatcher_GetMemoryRegions() are captured into it, so those regions should be limited to
+   the subset of RAM which is worth keeping.  Anything which doesn't fit is dropped. */
+void* CrashCatcher_GetRetainedBuffer(size_t* pSize);
+
+/* Optionally provided by an implementation which can send the dump in the background (ie. with DMA) when CrashCatcher
+   is built with pipeline support.  Called to start sending size bytes from pvBuffer, which should be sent just as if
+   they had been passed to CrashCatcher_DumpMemory() as CRASH_CATCHER_BYTE elements.  It is only called again once
+   CrashCatcher_IsTransferComplete() has returned non-zero and the buffer isn't touched until then.  Both routines must
+   be provided for the pipeline to be used, in which case CrashCatcher_DumpMemory() isn't called for that dump. */
+void CrashCatcher_StartTransfer(const void* pvBuffer, size_t size);
+
+/* Called for each part of the dump and repeatedly while waiting for a staging buffer to be sent.  Should return non-zero
+   once the last transfer has completed, or if no transfer has been started yet. */
+int  CrashCatcher_IsTransferComplete(void);
+
+/* Optionally provided by an implementation on a part with a data cache.  Called to clean (write back) the cache lines
+   covering size bytes at pvBuffer before they are passed to CrashCatcher_StartTransfer(). */
+void CrashCatcher_CleanDataCache(const void* pvBuffer, size_t size);
+
+
+/* The following functions can be called by the application, once it has restarted, to send the dump which was
+   captured into the buffer returned from CrashCatcher_GetRetainedBuffer() through the CrashCatcher_DumpStart(),
+   CrashCatcher_DumpMemory() and CrashCatcher_DumpEnd() routines of whichever dumping implementation it uses. */
+
+/* Returns non-zero if the retained buffer holds a complete dump with a valid CRC. */
+int  CrashCatcher_HasRetainedDump(void);
+
+/* Sends the retained dump, with CrashCatcherInfo::isRetained set, and returns non-zero.  The dump is sent again each
+   time that CrashCatcher_DumpEnd() returns CRASH_CATCHER_TRY_AGAIN.  Returns 0 without calling any of the dump routines
+   if there is no valid retained dump.  The dump is kept until CrashCatcher_DiscardRetainedDump() is called. */
+int  CrashCatcher_EmitRetainedDump(void);
+
+/* Marks the retained buffer as empty so that the same dump isn't sent again after the next reset. */
+void CrashCatcher_DiscardRetainedDump(void);
+
 
 /* The following functions must be provided by a hex dumping implementation. Such implementations will also have to
    implement the core CrashCatcher_GetMemoryRegions() API as well.  The HexDump version of CrashCatcher calls these
@@ -132,6 +381,48 @@ int CrashCatcher_getc(void);
 /* Called to send a character of hex dump data to the user. */
 void CrashCatcher_putc(int c);
 
+/* Optionally provided by a hex dumping implementation which can send more than one character at a time (ie. by filling
+   a UART FIFO or starting a DMA transfer).  Called to send length characters of hex dump data to the user, typically a
+   whole line at a time.  When not provided, CrashCatcher_putc() is called for each character instead. */
+void CrashCatcher_write(const char* pBuffer, size_t length);
+
+
+/* The following functions must be provided by an implementation using the FlashDump module, along with the core
+   CrashCatcher_GetMemoryRegions() API.  They form a small HAL through which the FlashDump version of CrashCatcher
+   erases and programs the dump into an area of internal flash which has been reserved for it. */
+
+/* Called once at the start of each dump to find the area of flash which the dump is to be written into. */
+const CrashCatcherFlashArea* CrashCatcher_GetFlashArea(void);
+
+/* Called to erase the sector starting at address.  Should block until the erase completes and return 0 on success. */
+int CrashCatcher_FlashErase(uint32_t address);
+
+/* Called to program size bytes from pvData into the erased flash at address.  The address is always page aligned and
+   size is always the page size which the FlashDump module was built with.  Should block until the program completes
+   and return 0 on success. */
+int CrashCatcher_FlashProgram(uint32_t address, const void* pvData, size_t size);
+
+/* Optionally provided by a FlashDump implementation whose flash isn't mapped into the address space.  Called to copy
+   size bytes from the flash at address into pvBuffer and should return 0 on success.  When not provided, the flash is
+   read directly from its address. */
+int CrashCatcher_FlashRead(uint32_t address, void* pvBuffer, size_t size);
+
+
+/* The following functions can be called by the application, once it has restarted, to fetch the dumps kept in the
+   slots of the FlashDump area.  Only the slot headers need to be read to find the dumps and their order. */
+
+/* Returns the number of slots in the area returned from CrashCatcher_GetFlashArea(), or 0 if it isn't split into
+   slots or isn't valid. */
+uint32_t CrashCatcher_FlashDumpGetSlotCount(void);
+
+/* Fills in *pHeader from the header of slot slotIndex and returns non-zero if that slot holds a dump.  Returns 0 for
+   empty slots. */
+int      CrashCatcher_FlashDumpReadSlotHeader(uint32_t slotIndex, CrashCatcherFlashSlotHeader* pHeader);
+
+/* Copies up to size bytes of the dump held in slot slotIndex, starting offset bytes into the dump, into pvBuffer.
+   Returns the number of bytes copied, which is 0 once offset reaches the end of the dump or if the slot is empty. */
+size_t   CrashCatcher_FlashDumpReadSlot(uint32_t slotIndex, uint32_t offset, void* pvBuffer, size_t size);
+
 #ifdef __cplusplus
 }
 #endif
@@ -26,6 +26,7 @@ int        semihost_write(FILEHANDLE fh, const unsigned char* buffer, unsigned i
 
 
 static FILEHANDLE g_coreDumpFile = -1;
+static int        g_isRetained;
 
 
 /* Forward Declarations */
@@ -36,7 +37,7 @@ static void infiniteLoop(void);
 
 void CrashCatcher_DumpStart(const CrashCatcherInfo* pInfo)
 {
-    (void)pInfo;
+    g_isRetained = pInfo->isRetained;
     g_coreDumpFile = semihost_open("crash.dmp", OPEN_W);
 }
 
@@ -82,11 +83,15 @@ static void dumpWords(const uint32_t* pMemory, size_t elementCount)
 
 CrashCatcherReturnCodes CrashCatcher_DumpEnd(void)
 {
-    if (g_coreDumpFile < 0)
-        infiniteLoop();
-
-    semihost_close(g_coreDumpFile);
-    g_coreDumpFile = -1;
+    if (g_coreDumpFile >= 0)
+    {
+        semihost_close(g_coreDumpFile);
+        g_coreDumpFile = -1;
+    }
+    /* A dump retained from before the last reset is sent from CrashCatcher_EmitRetainedDump() at startup so the
+       application must be allowed to carry on once it has been written out. */
+    if (g_isRetained)
+        return CRASH_CATCHER_EXIT;
     infiniteLoop();
     return CRASH_CATCHER_TRY_AGAIN;
 }